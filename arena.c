@@ -0,0 +1,129 @@
+#include "arena.h"
+
+/*** ARENA HANDLING SECTION ***/
+
+/*
+* ARENA_HEADER_SIZE
+* -----------------
+* the space taken by the header of a block rounded up so the first allocation is aligned
+*/
+#define ARENA_HEADER_SIZE ((sizeof(ArenaBlock) + ARENA_ALIGNMENT - 1) & ~(size_t)(ARENA_ALIGNMENT - 1))
+
+/*
+* initialize_arena
+* ----------------
+* this function prepares an empty arena that has no blocks yet
+*
+* parameters:
+*   arena: a pointer to the arena to be initialized
+*
+*/
+void initialize_arena(Arena *arena){
+	arena->blocks = NULL;
+}
+
+/*
+* arena_allocate
+* --------------
+* this function hands out size bytes from the newest block of the arena
+* a new block is allocated when the newest block is full and it is made large enough for requests bigger than ARENA_BLOCK_SIZE
+*
+* parameters:
+*   arena: a pointer to the arena
+*   size: the number of bytes to allocate
+*
+* returns:
+*   void*: an aligned pointer that stays valid until the arena is reset or freed or NULL if memory allocation failed
+*/
+void *arena_allocate(Arena *arena,size_t size){
+	ArenaBlock *block = arena->blocks;
+	size_t block_size;
+
+	size = (size + ARENA_ALIGNMENT - 1) & ~(size_t)(ARENA_ALIGNMENT - 1);/*keep the next allocation aligned*/
+	if(!block || block->size - block->used < size){/*check if the newest block is full*/
+		block_size = size > ARENA_BLOCK_SIZE ? size : ARENA_BLOCK_SIZE;
+		block = (ArenaBlock*)malloc(ARENA_HEADER_SIZE + block_size);
+		if(!block){
+			return NULL;
+		}
+		block->size = block_size;
+		block->used = 0;
+		block->next = arena->blocks;
+		arena->blocks = block;
+	}
+	block->used += size;
+	return (char*)block + ARENA_HEADER_SIZE + block->used - size;
+}
+
+/*
+* arena_copy_string
+* -----------------
+* this function copies a null terminated string into the arena
+*
+* parameters:
+*   arena: a pointer to the arena
+*   string: the string to copy
+*
+* returns:
+*   char*: the copy or NULL if memory allocation failed
+*/
+char *arena_copy_string(Arena *arena,const char *string){
+	size_t length = strlen(string) + 1;
+	char *copy = (char*)arena_allocate(arena, length);
+
+	if(copy){
+		memcpy(copy, string, length);
+	}
+	return copy;
+}
+
+/*
+* reset_arena
+* -----------
+* this function frees every allocation of the arena at once
+* the largest block is kept and emptied so an arena that is reused for many similar jobs stops calling malloc
+*
+* parameters:
+*   arena: a pointer to the arena
+*
+*/
+void reset_arena(Arena *arena){
+	ArenaBlock *block, *next, *kept = arena->blocks;
+
+	for(block=arena->blocks ; block ; block=block->next){/*find the largest block*/
+		if(block->size > kept->size){
+			kept = block;
+		}
+	}
+	for(block=arena->blocks ; block ; block=next){/*free every other block*/
+		next = block->next;
+		if(block != kept){
+			free(block);
+		}
+	}
+	if(kept){
+		kept->used = 0;
+		kept->next = NULL;
+	}
+	arena->blocks = kept;
+}
+
+/*
+* free_arena
+* ----------
+* this function frees every block of the arena and leaves it empty
+*
+* parameters:
+*   arena: a pointer to the arena
+*
+*/
+void free_arena(Arena *arena){
+	ArenaBlock *block = arena->blocks, *next;
+
+	while(block){
+		next = block->next;
+		free(block);
+		block = next;
+	}
+	arena->blocks = NULL;
+}
@@ -0,0 +1,32 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "definitions.h"
+
+#define ARENA_BLOCK_SIZE 16384/*default size of a block of an arena*/
+#define ARENA_ALIGNMENT 16/*every allocation of an arena starts at a multiple of this many bytes*/
+
+/*** STRUCTURE DEFINITIONS SECTION ***/
+
+typedef struct arena_block{/*a single block of memory an arena hands out allocations from*/
+	struct arena_block *next;/*the next block of the arena*/
+	size_t size;/*number of bytes the block can hold after its header*/
+	size_t used;/*number of bytes already handed out*/
+}ArenaBlock;
+
+typedef struct{/*memory that is handed out in pieces and freed all at once*/
+	ArenaBlock *blocks;/*the blocks of the arena the newest first*/
+}Arena;
+
+/*** FUNCTION PROTOTYPES SECTION ***/
+
+void initialize_arena(Arena *arena);/*function to prepare an empty arena*/
+void *arena_allocate(Arena *arena,size_t size);/*function to allocate memory that lives until the arena is reset or freed*/
+char *arena_copy_string(Arena *arena,const char *string);/*function to copy a string into an arena*/
+void reset_arena(Arena *arena);/*function to free every allocation while keeping one block for reuse*/
+void free_arena(Arena *arena);/*function to free every block of an arena*/
+
+#endif /*ARENA_H*/
@@ -1,149 +1,543 @@
-#include "preprocessor.h"
-#include "first_pass.h"
-#include "second_pass.h"
+#include "libassembler.h"
 #include "file_writer.h"
+#include "options.h"
+#include "batch_io.h"
+#include "work_pool.h"
+#include "server.h"
+#include "cache.h"
+#include "watch.h"
+#include "lsp.h"
+#include "manifest.h"
+#include "diagnostics.h"
+#include "stats.h"
+#include "trace.h"
 #include "definitions.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <stdbool.h>
+#include <errno.h>
+#include <unistd.h>
+#include <time.h>
+#include <sys/stat.h>
+
+/*** STRUCTURE DEFINITIONS SECTION ***/
+
+typedef struct{/*everything a file printed while it was assembled on a worker thread*/
+	char *messages;/*progress messages meant for stdout*/
+	size_t messages_size;/*length of the progress messages*/
+	char *errors;/*warnings and errors meant for stderr*/
+	size_t errors_size;/*length of the warnings and errors*/
+	bool success;/*true if the file was assembled*/
+	FileStats stats;/*the statistics of the file when they are measured*/
+}FileReport;
+
+typedef struct{/*a file of a batched run whose outputs may still be in flight*/
+	FileReport report;/*everything the file printed and whether it was assembled*/
+	int writes[SINK_OUTPUT_COUNT];/*number of the write request of every output or -1 for an output the file does not have*/
+}BatchedFile;
+
+typedef struct{/*the state shared by the tasks of a parallel run*/
+	char **files;/*the file arguments*/
+	char **outputs;/*base names of the output files of every file argument*/
+	const AssemblerOptions *options;/*the command line options*/
+	FileReport *reports;/*one report per file argument*/
+	bool measure;/*true if the statistics of every file are measured*/
+}ParallelRun;
 
 /*
-* delete_file
-* -----------
-* this function deletes a specified file from the filesystem
-* it attempts to remove the file and prints an error message if the operation fails
-* this function is useful for cleaning up temporary files or failed builds
+* assemble_file
+* -------------
+* this function assembles a single file argument reading and writing it with plain stdio
+* the outputs are written under temporary names and renamed once the file was assembled
+* with --check the file is only checked and nothing is written
 * 
 * parameters:
-*   filename: the name of the file to be deleted
+*   basename: the file argument (base name without the .as suffix)
+*   output: the base name of the output files
+*   options: the command line options
+*   stats: the statistics the file is measured into or NULL when it is not measured
 * 
+* returns:
+*   bool: true if the file was assembled false otherwise
 */
-void delete_file(const char *filename){
-	if(remove(filename) != 0){
-		perror("Error: couldn't delete file");/*print an error message if file deletion fails*/
+bool assemble_file(const char *basename, const char *output, const AssemblerOptions *options, FileStats *stats){
+	char *input_filename;/*the file name with .as suffix*/
+	FILE *file;/*declare a file pointer for the source*/
+	ObjectSink sink;/*declare the sink that writes the output files*/
+	bool success;
+
+	if(stats){
+		start_file_stats(stats, basename);
+	}
+	TRACE_FILE(basename);
+	input_filename = make_path(basename, ".as", NULL);/*create the input file name by adding the .as suffix to the argument*/
+	if(!input_filename){
+		print_system_error("malloc failed");
+		stop_file_stats(false);
+		TRACE_END();
+		return false;
+	}
+	TRACE_BEGIN("io", "open");
+	file = fopen(input_filename, "r");/*the source is opened once and handed to the passes*/
+	TRACE_END();
+	free(input_filename);
+	if(!file){
+		fprintf(error_output(), "Warning: file %s.as does not exist skipping it\n", basename);/*print warning if file doesn't have .as suffix*/
+		stop_file_stats(false);
+		TRACE_END();
+		return false;
+	}
+	if(options->check_only){/*nothing is encoded or written*/
+		success = check_file(basename, file, options);
+	}
+	else if(options->cache_directory){/*restore the outputs of an unchanged source from the cache*/
+		success = process_file_cached(basename, output, file, options);
 	}
+	else{
+		initialize_object_sink(&sink, output, false);/*write the outputs under temporary names and rename them on success*/
+		success = process_file(basename, file, &sink, options);/*call process_file for the valid file*/
+	}
+	fclose(file);
+	stop_file_stats(success);
+	TRACE_END();
+	return success;
 }
 
 /*
-* update_entry_lines
-* ------------------
-* this function updates the line numbers in the ExternEntryArray based on the LabelArray
-* it iterates through each entry and matches it with a corresponding label to set the correct line number
-* this function is crucial for resolving extern and entry references to the correct locations in the assembly process
+* assemble_files
+* --------------
+* this function assembles every file argument one after the other
 * 
 * parameters:
-*   label_array: a pointer to the LabelArray containing all labels
-*   ext_entry_array: a pointer to the ExternEntryArray containing all extern and entry entries
+*   files: the file arguments (base names without the .as suffix)
+*   outputs: the base names of the output files of every file argument
+*   file_count: the number of file arguments
+*   options: the command line options
+*   report: the report that receives the statistics of every file or NULL when they are not measured
 * 
+* returns:
+*   bool: true if every file was assembled false otherwise
 */
-void update_entry_lines(LabelArray *label_array, ExternEntryArray *ext_entry_array){
-	int i, j;
-	bool found;
-
-	/*iterate through each entry in the ExternEntryArray*/
-	for(i = 0; i < ext_entry_array->entry_count; i++) {
-		found = false;/*initialize the found flag to false*/
-
-		/*iterate through the LabelArray to find a matching label*/
-		for(j = 0; j < label_array->count; j++) {
-			if(strcmp(ext_entry_array->entries[i].name, label_array->labels[j].label) == 0) {
-				/*if a match is found update the line number of the entry*/
-				ext_entry_array->entries[i].line_number = label_array->labels[j].line_number;
-				found = true;/*set found flag to true*/
-				break;/*exit loop if a matching label is found*/
-			}
+bool assemble_files(char *files[], char *outputs[], int file_count, const AssemblerOptions *options, StatsReport *report){
+	FileStats stats;/*the statistics of the file being assembled*/
+	int i;/*declare a loop counter*/
+	bool success = true;
+
+	for(i=0 ; i<file_count ; i++){/*loop through each input file argument*/
+		success = assemble_file(files[i], outputs[i], options, report ? &stats : NULL) && success;
+		if(report){
+			add_file_stats(report, &stats);
 		}
+	}
+	return success;
+}
 
-		/*if no matching label is found print an error message and exit*/
-		if(!found) {
-			fprintf(stderr, "Error: Entry label '%s' not found in label array\n", ext_entry_array->entries[i].name);
-			exit(EXIT_FAILURE);/*terminate the program if the label is not found*/
+/*
+* assemble_file_stream
+* --------------------
+* this function assembles the files of the command line one after the other while the manifests are read
+* so a manifest of any length is assembled without holding its list in memory
+* 
+* parameters:
+*   files: the file arguments (base names or @manifests)
+*   file_count: the number of file arguments
+*   options: the command line options
+*   report: the report that receives the statistics of every file or NULL when they are not measured
+* 
+* returns:
+*   bool: true if every manifest was read and every file was assembled false otherwise
+*/
+bool assemble_file_stream(char *files[], int file_count, const AssemblerOptions *options, StatsReport *report){
+	FileStream stream;/*the files of the command line*/
+	FileStats stats;/*the statistics of the file being assembled*/
+	bool success = true;
+
+	open_file_stream(&stream, files, file_count, options->files_from);
+	while(next_file(&stream)){
+		success = assemble_file(stream.name, stream.output, options, report ? &stats : NULL) && success;
+		if(report){
+			add_file_stats(report, &stats);
 		}
 	}
+	return close_file_stream(&stream) && success;
 }
 
 /*
-* process_file
-* ------------
-* this function processes a single assembly file through preprocessing, first pass, and second pass
-* it manages the creation of intermediate files, handles errors, and generates the final output files
-* this function is the main driver for processing each file and is called for each input file in the main function
+* assemble_file_job
+* -----------------
+* this function is the task a worker of assemble_files_parallel runs for a single file
+* everything the file prints is collected in its FileReport so the main thread can print it in argv order
 * 
 * parameters:
-*   basename: the base name of the file to be processed (without extension)
+*   task: the index of the file argument
+*   context: the ParallelRun shared by all the tasks
 * 
 */
-void process_file(const char *basename) {
-	char input_file[MAX_FILENAME_LENGTH];/*declare a string to store the input filename*/
-	char preprocessed_file[MAX_FILENAME_LENGTH];/*declare a string to store the preprocessed filename*/
-	LabelArray label_array;/*declare a LabelArray to store labels encountered during the first pass*/
-	ExternEntryArray ext_entry_array;/*declare an ExternEntryArray to store extern and entry entries*/
-	ExternEntry *extern_printing_array = NULL;/*initialize a pointer to ExternEntry array to NULL*/
-	MachineWordsArray *code_img[CODE_ARR_IMG_LENGTH] = {0};/*initialize an array of MachineWordsArray pointers with NULL*/
-	long IC = IC_INIT_VALUE;/*initialize the instruction counter (IC) with the initial value*/
-	long DC = 0;/*initialize the data counter (DC) to 0*/
-	long data_img[CODE_ARR_IMG_LENGTH];/*declare an array to store data image*/
-	bool success;/*declare a boolean variable to store the success status of operations*/
+void assemble_file_job(int task, void *context){
+	ParallelRun *run = (ParallelRun*)context;
+	FileReport *report = &run->reports[task];
+	FILE *messages, *errors;/*streams collecting the output of the file*/
+
+	messages = open_memstream(&report->messages, &report->messages_size);
+	errors = open_memstream(&report->errors, &report->errors_size);
+	redirect_output(messages, errors);/*a stream that failed to open leaves the output on stdout or stderr*/
 
-	/*prepare filenames*/
-	sprintf(input_file, "%s.as", basename);/*format the input filename by appending ".as" to the basename*/
-	sprintf(preprocessed_file, "%s.am", basename);/*format the preprocessed filename by appending ".am" to the basename*/
+	report->success = assemble_file(run->files[task], run->outputs[task], run->options, run->measure ? &report->stats : NULL);
+
+	redirect_output(NULL, NULL);
+	if(messages){
+		fclose(messages);
+	}
+	if(errors){
+		fclose(errors);
+	}
+}
+
+/*
+* assemble_files_parallel
+* -----------------------
+* this function assembles the file arguments concurrently on a work stealing pool of options->jobs threads
+* the largest sources are scheduled first so a big file does not end up running alone at the end
+* the output of every file is printed in argv order as soon as it and all the files before it are done
+* so the console output is the same as when the files are assembled one after the other
+* 
+* parameters:
+*   files: the file arguments (base names without the .as suffix)
+*   outputs: the base names of the output files of every file argument
+*   file_count: the number of file arguments
+*   options: the command line options
+*   report: the report that receives the statistics of every file or NULL when they are not measured
+* 
+* returns:
+*   bool: true if every file was assembled false otherwise
+*/
+bool assemble_files_parallel(char *files[], char *outputs[], int file_count, const AssemblerOptions *options, StatsReport *report){
+	ParallelRun run;/*the state shared by the tasks*/
+	AssemblerOptions file_options;/*the options of a single file*/
+	WorkPool pool;/*the pool that runs the tasks*/
+	long *costs;/*size of every source*/
+	struct stat status;/*status of a source*/
+	char *input_filename;/*the file name with .as suffix*/
+	int i;/*declare a loop counter*/
+	bool success = true;
 
-	/*preprocess the file*/
-	success = preprocess_file(input_file);/*call the preprocess_file function to preprocess the input file*/
-	if(!success){/*check if preprocessing failed*/
-		fprintf(stderr, "Error: preprocessing failed for file %s\n", input_file);
-		delete_file(preprocessed_file);/*delete the .am file if preprocessing fails*/
-		return;
+	costs = (long*)calloc(file_count, sizeof(long));/*zeroed so no cost is ever read uninitialized*/
+	run.reports = (FileReport*)calloc(file_count, sizeof(FileReport));
+	if(costs == NULL || run.reports == NULL){
+		free(costs);
+		free(run.reports);
+		return assemble_files(files, outputs, file_count, options, report);/*assemble without the pool*/
 	}
+	run.files = files;
+	run.outputs = outputs;
+	run.measure = report != NULL;
+	file_options = *options;
+	file_options.chunked = false;/*the workers are already busy with the other files*/
+	run.options = &file_options;
 
-	/*initialize arrays*/
-	initialize_label_array(&label_array);/*initialize the label array to store labels*/
-	initialize_extern_entry_array(&ext_entry_array);/*initialize the extern entry array to store extern and entry entries*/
+	for(i=0 ; i<file_count ; i++){/*the size of a source estimates the time it takes*/
+		input_filename = make_path(files[i], ".as", NULL);
+		costs[i] = input_filename && stat(input_filename, &status) == 0 ? (long)status.st_size : 0;
+		free(input_filename);
+	}
 
-	/*first pass*/
-	if(first_pass(preprocessed_file, &label_array, &ext_entry_array) == NULL){/*perform the first pass and check if it failed*/
-		fprintf(stderr, "error: first pass failed for file %s\n", preprocessed_file);
-		delete_file(preprocessed_file);/*delete the .am file if the first pass fails*/
-		return;
+	if(!work_pool_start(&pool, options->jobs, file_count, costs, assemble_file_job, &run)){
+		free(costs);
+		free(run.reports);
+		return assemble_files(files, outputs, file_count, options, report);/*assemble without the pool*/
 	}
 
-	/*update entry lines*/
-	if(label_array.count > 0 && ext_entry_array.entry_count > 0) { /*check if there are labels and entries*/
-		update_entry_lines(&label_array, &ext_entry_array);/*update the entry lines with correct label references*/
+	for(i=0 ; i<file_count ; i++){/*print the output of the files in argv order*/
+		work_pool_wait(&pool, i);
+		if(run.reports[i].errors){
+			fwrite(run.reports[i].errors, 1, run.reports[i].errors_size, stderr);
+			fflush(stderr);
+		}
+		if(run.reports[i].messages){
+			fwrite(run.reports[i].messages, 1, run.reports[i].messages_size, stdout);
+			fflush(stdout);
+		}
+		free(run.reports[i].errors);
+		free(run.reports[i].messages);
+		if(report){
+			add_file_stats(report, &run.reports[i].stats);
+		}
+		success = run.reports[i].success && success;
 	}
 
-	/*second pass*/
-	success = second_pass(preprocessed_file, &label_array, &ext_entry_array, code_img, data_img, &IC, &DC, &extern_printing_array);/*perform the second pass*/
-	if(!success) { /*check if the second pass failed*/
-		fprintf(stderr, "error: second pass failed for file %s\n", preprocessed_file);/*print an error message*/
-		delete_file(preprocessed_file);/*delete the .am file if the second pass fails*/
-		return;/*exit the function*/
+	work_pool_join(&pool);
+	free(costs);
+	free(run.reports);
+	return success;
+}
+
+/*
+* queue_source_read
+* -----------------
+* this function queues the read of the source of a file argument
+* 
+* parameters:
+*   io: the batched I/O
+*   basename: the file argument (base name without the .as suffix)
+* 
+* returns:
+*   int: the number of the read request or -1 if memory ran out
+*/
+int queue_source_read(BatchIo *io, const char *basename){
+	char *filename = make_path(basename, ".as", NULL);/*the name of the source*/
+	int request;
+
+	if(filename == NULL){
+		perror("malloc failed");
+		return -1;
 	}
+	request = batch_io_read(io, filename);/*the request keeps its own copy of the name*/
+	free(filename);
+	return request;
+}
 
-	/*write output files*/
-	write_ob_file(code_img, data_img, IC, DC, basename);/*write the object file (.ob) with the generated code and data*/
+/*
+* finish_batched_file
+* -------------------
+* this function waits for the writes of a file of a batched run and prints what the file printed
+* the outputs were written under temporary names and get their final names only when every one of them was written
+* so a failed write leaves no output of the file behind and fails the file
+*
+* parameters:
+*   io: the batched I/O
+*   file: the file
+*   output: the base name of the output files of the file
+*   report: the report that receives the statistics of the file or NULL when they are not measured
+*
+* returns:
+*   bool: true if the file was assembled and every output was written false otherwise
+*/
+bool finish_batched_file(BatchIo *io, BatchedFile *file, const char *output, StatsReport *report){
+	char *temporary, *filename;/*the names an output is written under and renamed to*/
+	bool renamed[SINK_OUTPUT_COUNT];/*true for an output that got its final name*/
+	bool written = file->report.success;
+	int j;
 
-	/*conditionally write entry and extern files*/
-	if(ext_entry_array.entry_count > 0) { /*check if there are any entries*/
-		write_entries_to_file(basename, &ext_entry_array);/*write the entries to the .ent file*/
+	for(j=0 ; j<SINK_OUTPUT_COUNT ; j++){
+		if(file->writes[j] >= 0 && batch_io_wait(io, file->writes[j])->state != REQUEST_DONE){
+			written = false;
+		}
 	}
-	if(extern_printing_array != NULL) { /*check if there are any extern references*/
-		write_externs_to_file(basename, extern_printing_array);/*write the externs to the .ext file*/
+	for(j=0 ; j<SINK_OUTPUT_COUNT ; j++){
+		renamed[j] = false;
+		if(file->writes[j] < 0){
+			continue;
+		}
+		temporary = make_path(output, sink_extensions[j], ".tmp");
+		filename = make_path(output, sink_extensions[j], NULL);
+		if(written && temporary && filename && rename(temporary, filename) == 0){
+			renamed[j] = true;
+		}
+		else if(written){
+			print_system_error("Error: couldn't rename an output file");
+			written = false;
+		}
+		if(!renamed[j] && temporary){
+			remove(temporary);
+		}
+		free(temporary);
+		free(filename);
 	}
+	for(j=0 ; !written && j<SINK_OUTPUT_COUNT ; j++){/*an output renamed before a later one failed is removed too*/
+		if(renamed[j] && (filename = make_path(output, sink_extensions[j], NULL)) != NULL){
+			remove(filename);
+			free(filename);
+		}
+	}
+
+	if(file->report.errors){
+		fwrite(file->report.errors, 1, file->report.errors_size, stderr);
+	}
+	if(file->report.success && !written){
+		fprintf(stderr, "Error: failed writing the output files of %s\n", output);
+	}
+	else if(file->report.messages){/*the message that the file succeeded*/
+		fwrite(file->report.messages, 1, file->report.messages_size, stdout);
+	}
+	fflush(stderr);
+	fflush(stdout);
+	free(file->report.errors);
+	free(file->report.messages);
+	file->report.errors = file->report.messages = NULL;
+	if(report){
+		file->report.stats.success = written;
+		add_file_stats(report, &file->report.stats);
+	}
+	return written;
+}
+
+/*
+* assemble_files_batched
+* ----------------------
+* this function assembles every file argument with all the file reads and writes batched through batch_io
+* the sources are read BATCH_IO_READ_AHEAD files ahead of the file being assembled
+* and the outputs are assembled in memory and queued for writing under temporary names so the disk work overlaps with the assembling
+* a file is finished (its outputs renamed and its messages printed) once the next file was assembled
+* 
+* parameters:
+*   files: the file arguments (base names without the .as suffix)
+*   outputs: the base names of the output files of every file argument
+*   file_count: the number of file arguments
+*   options: the command line options
+*   report: the report that receives the statistics of every file or NULL when they are not measured
+* 
+* returns:
+*   bool: true if every file was assembled and every output was written false otherwise
+*/
+bool assemble_files_batched(char *files[], char *outputs[], int file_count, const AssemblerOptions *options, StatsReport *report){
+	BatchIo io;/*declare the batched I/O*/
+	int *reads;/*request number of the read of each source*/
+	IoRequest *request;/*the completed read*/
+	char *data;/*contents of the source*/
+	long length;/*length of the source*/
+	FILE *source;/*stream over the source*/
+	FILE *messages, *errors;/*streams collecting what the file prints*/
+	ObjectSink sink;/*declare the sink that holds the outputs in memory*/
+	char *filename;/*the temporary name of an output file*/
+	BatchedFile batched[2];/*the file being assembled and the file before it whose writes are in flight*/
+	BatchedFile *file;/*the file being assembled*/
+	bool all = true;/*the result of every file*/
+	int i, j;/*declare loop counters*/
+
+	reads = (int*)malloc(file_count*sizeof(int));
+	if(reads == NULL){
+		perror("malloc failed");
+		return false;
+	}
+	batch_io_open(&io, true);/*use io_uring when the kernel allows it*/
+
+	for(i=0 ; i<file_count && i<BATCH_IO_READ_AHEAD ; i++){/*queue the first reads*/
+		reads[i] = queue_source_read(&io, files[i]);
+	}
+
+	for(i=0 ; i<file_count ; i++){
+		file = &batched[i % 2];
+		memset(file, 0, sizeof(BatchedFile));
+		for(j=0 ; j<SINK_OUTPUT_COUNT ; j++){
+			file->writes[j] = -1;
+		}
+		messages = open_memstream(&file->report.messages, &file->report.messages_size);
+		errors = open_memstream(&file->report.errors, &file->report.errors_size);
+		redirect_output(messages, errors);/*printed when the file is finished (a stream that failed to open prints right away)*/
+		if(report){/*the wait for the read is part of the file*/
+			start_file_stats(&file->report.stats, files[i]);
+		}
+		TRACE_FILE(files[i]);
+		request = reads[i] >= 0 ? batch_io_wait(&io, reads[i]) : NULL;
+		data = request ? request->data : NULL;
+		length = request ? request->length : 0;
+		if(request && request->state == REQUEST_FAILED){
+			if(request->error == ENOENT){
+				fprintf(error_output(), "Warning: file %s.as does not exist skipping it\n", files[i]);
+			}
+			else{
+				fprintf(error_output(), "Error: couldn't read %s.as: %s\n", files[i], strerror(request->error));
+			}
+			data = NULL;
+		}
+		if(i + BATCH_IO_READ_AHEAD < file_count){/*keep the read ahead window full*/
+			reads[i + BATCH_IO_READ_AHEAD] = queue_source_read(&io, files[i + BATCH_IO_READ_AHEAD]);
+		}
+		source = data ? open_buffer(data, length) : NULL;
+		if(data && !source){
+			print_system_error("Error: couldn't read the source");
+		}
+		if(source){
+			initialize_object_sink(&sink, outputs[i], true);/*assemble the outputs into memory*/
+			file->report.success = process_file(files[i], source, &sink, options);
+		}
+		if(file->report.success){
+			for(j=0 ; j<SINK_OUTPUT_COUNT ; j++){/*hand every output over to the batched I/O*/
+				if(sink.outputs[j].opened){
+					filename = make_path(outputs[i], sink_extensions[j], ".tmp");
+					if(filename == NULL){
+						perror("malloc failed");
+						file->report.success = false;
+						continue;/*release_object_sink frees the buffer*/
+					}
+					file->writes[j] = batch_io_write(&io, filename, sink.outputs[j].buffer, (long)sink.outputs[j].size);
+					file->report.success = file->writes[j] >= 0 && file->report.success;
+					sink.outputs[j].buffer = NULL;
+					free(filename);
+				}
+			}
+			release_object_sink(&sink);
+		}
+		if(source){
+			fclose(source);
+		}
+		if(data){
+			batch_io_release(&io, reads[i]);/*the source is no longer needed*/
+		}
+		if(report){
+			stop_file_stats(file->report.success);
+		}
+		TRACE_END();
+		redirect_output(NULL, NULL);
+		if(messages){
+			fclose(messages);
+		}
+		if(errors){
+			fclose(errors);
+		}
+		if(i > 0){/*the writes of the file before had the time this file took to complete*/
+			all = finish_batched_file(&io, &batched[(i - 1) % 2], outputs[i - 1], report) && all;
+		}
+	}
+	if(file_count > 0){
+		all = finish_batched_file(&io, &batched[(file_count - 1) % 2], outputs[file_count - 1], report) && all;
+	}
+
+	free(reads);
+	return batch_io_close(&io) && all;/*wait for the last writes*/
+}
+/*
+* assemble_stdio
+* --------------
+* this function assembles the source read from stdin and writes its outputs to stdout as framed sections
+* the outputs are assembled into memory so nothing touches the disk and the messages go to stderr to keep stdout clean
+* 
+* parameters:
+*   options: the command line options
+* 
+* returns:
+*   int: 0 if the source was assembled and written 1 otherwise
+*/
+int assemble_stdio(const AssemblerOptions *options){
+	ObjectSink sink;/*declare the sink that holds the outputs in memory*/
+	bool success;
+	int i;/*declare a loop counter*/
+
+	redirect_output(stderr, stderr);/*stdout carries only the sections*/
+	initialize_object_sink(&sink, STREAM_SOURCE_NAME, true);
+	success = process_file(STREAM_SOURCE_NAME, stdin, &sink, options);
 	if(success){
-		printf("Assembler succeeded for file %s\n",basename);
+		for(i=0 ; i<SINK_OUTPUT_COUNT ; i++){/*write the outputs in the order of sink_output*/
+			if(sink.outputs[i].opened){
+				printf("%s %s %lu\n", STREAM_SECTION, sink_extensions[i], (unsigned long)sink.outputs[i].size);
+				fwrite(sink.outputs[i].buffer, 1, sink.outputs[i].size, stdout);
+			}
+		}
+		printf("%s\n", STREAM_END);
+		release_object_sink(&sink);
+	}
+	if(fflush(stdout) != 0 || ferror(stdout)){
+		print_system_error("Error: writing the outputs failed");
+		success = false;
 	}
-	/*delete the .am file*/
-	delete_file(preprocessed_file);/*delete the preprocessed file (.am) after processing is complete*/
+	return success ? 0 : 1;
 }
 
 /*
 * main
 * ----
 * this function is the entry point of the program
-* it processes command-line arguments and calls process_file for each input file
+* it processes command-line arguments and assembles each input file
 * 
 * parameters:
 *   argc: the number of command-line arguments
@@ -153,27 +547,112 @@ void process_file(const char *basename) {
 *   int: 0 if the program runs successfully or a non-zero value if an error occurs
 */
 int main(int argc, char *argv[]) {
-	int i;/*declare a loop counter*/
-	char input_filename[MAX_FILENAME_LENGTH];/*buffer to hold the file name with .as suffix*/
-	FILE *file;
+	int first_file;/*index of the first file argument*/
+	AssemblerOptions options;/*declare the command line options*/
+	FileList list;/*the files read from the manifests*/
+	char **files, **outputs;/*the files and the base names of their outputs*/
+	int file_count, done = 0;/*number of files and number of them the daemon handled*/
+	bool success = true;/*true while every file was assembled*/
+	StatsReport stats_report, *report = NULL;/*the statistics of every file when --stats measures them*/
+	struct timespec start, end;/*when the files started and finished*/
+	FILE *json;/*the stream the JSON statistics are written to*/
 
-	if(argc < 2) { /*check if at least one input file is provided*/
-		fprintf(stderr, "usage: %s <file1> <file2> ... <fileN>\n", argv[0]);/*print usage instructions*/
-		return false;
+	first_file = parse_options(argc, argv, &options);/*parse the options that precede the files*/
+	if(first_file < 0 || (first_file >= argc && !options.files_from && !options.serve_path && !options.cache_stats && !options.language_server && !options.stdio) || (first_file < argc && (options.language_server || options.stdio))) { /*check if the options are valid and at least one input file is provided*/
+		print_usage(argv[0]);/*print usage instructions*/
+		return 1;
+	}
+
+	if(options.jobs == 0){/*use every online processor*/
+		options.jobs = (int)sysconf(_SC_NPROCESSORS_ONLN);
+	}
+
+	if(options.cache_stats && first_file >= argc && !options.files_from){/*only print the cache counters*/
+		return print_cache_stats(&options) ? 0 : 1;
+	}
+	if(options.stdio){/*assemble from stdin to stdout*/
+		return assemble_stdio(&options);
+	}
+	if(options.language_server){/*serve an editor until it exits*/
+		return run_language_server(stdin, stdout, options.stats);
+	}
+	if(options.serve_path){/*run as a daemon until it is stopped*/
+		return run_server(options.serve_path, &options);
 	}
 
-	for(i=1 ; i<argc ; i++){/*loop through each input file argument*/
-		sprintf(input_filename, "%s.as", argv[i]);/*create the input file name by adding the .as suffix to the argument*/
+	if(options.trace_path && !start_trace()){
+		fprintf(stderr, "Error: couldn't allocate the trace\n");
+		options.trace_path = NULL;
+	}
+	memset(&stats_report, 0, sizeof(stats_report));
+	if(options.stats || options.stats_json){
+		report = &stats_report;
+		if(options.perf_counters){/*open the counters before the worker threads start*/
+			report->perf_available = start_perf_counters();
+		}
+	}
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	files = argv + first_file;/*the outputs of a file argument are named after it*/
+	outputs = files;
+	file_count = argc - first_file;
+	memset(&list, 0, sizeof(list));
+	if(uses_manifest(files, file_count, options.files_from)){
+		if(!options.watch && !options.connect_path && !options.batch_io && options.jobs <= 1){/*assemble while the manifests are read*/
+			success = assemble_file_stream(files, file_count, &options, report);
+			file_count = 0;
+		}
+		else{/*the other modes need every file up front*/
+			collect_files(&list, files, file_count, options.files_from);
+			files = list.names;
+			outputs = list.outputs;
+			file_count = list.count;
+		}
+	}
 
-		/*check if the file exists*/
-		file = fopen(input_filename, "r");
-		if(file){
-			fclose(file);/*close the file as it exists*/
-			process_file(argv[i]);/*call process_file for the valid file*/
+	if(options.watch){/*keep the outputs up to date until interrupted*/
+		return watch_files(files, outputs, file_count, &options);
+	}
+	if(options.connect_path){/*forward the files to a running daemon*/
+		done = assemble_files_remote(options.connect_path, files, outputs, file_count, &options);
+	}
+	files += done;/*assemble the files the daemon did not handle locally*/
+	outputs += done;
+	file_count -= done;
+
+	if(options.batch_io && file_count > 0){/*batch the reads and writes of all the files*/
+		success = assemble_files_batched(files, outputs, file_count, &options, report) && success;
+	}
+	else if(options.jobs > 1 && file_count > 1){/*assemble the files concurrently*/
+		success = assemble_files_parallel(files, outputs, file_count, &options, report) && success;
+	}
+	else{
+		success = assemble_files(files, outputs, file_count, &options, report) && success;
+	}
+	if(report){/*print the statistics after the output of the files*/
+		clock_gettime(CLOCK_MONOTONIC, &end);
+		report->wall = (end.tv_sec - start.tv_sec) * 1000.0 + (end.tv_nsec - start.tv_nsec) / 1000000.0;
+		fflush(stdout);
+		if(options.stats){
+			print_stats_text(stderr, report);
 		}
-		else{
-			fprintf(stderr, "Warning: file %s.as does not exist skipping it\n", argv[i]);/*print warning if file doesn't have .as suffix*/
+		json = !options.stats_json ? NULL : strcmp(options.stats_json, "-") == 0 ? stdout : fopen(options.stats_json, "w");
+		if(options.stats_json && !json){
+			fprintf(stderr, "Error: can't write the statistics to %s: %s\n", options.stats_json, strerror(errno));
 		}
+		else if(json){
+			print_stats_json(json, report);
+			if(json != stdout){
+				fclose(json);
+			}
+		}
+		free_stats_report(report);
+	}
+	if(options.cache_stats){/*print the counters after the files were assembled*/
+		print_cache_stats(&options);
+	}
+	if(options.trace_path){/*every worker was joined so every buffer is complete*/
+		stop_trace(options.trace_path);
 	}
-	return true;
+	free_file_list(&list);
+	return success ? 0 : 1;/*the exit status tells a script or a hook whether every file passed*/
 }
@@ -0,0 +1,760 @@
+#define _GNU_SOURCE/*syscall and the io_uring interface are not part of ansi c*/
+#include "batch_io.h"
+#include "trace.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#if defined(__linux__)
+#include <sys/syscall.h>
+#endif
+
+#if defined(__linux__) && defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter)
+#define HAVE_IO_URING 1
+#include <sys/mman.h>
+#include <linux/io_uring.h>
+#endif
+
+/*** REQUEST HANDLING SECTION ***/
+
+/*
+* add_request
+* -----------
+* this function adds a new request to the BatchIo
+* if the array is full it reallocates memory to accommodate more requests
+*
+* parameters:
+*   io: a pointer to the BatchIo structure
+*   path: the path of the file the request reads or writes
+*   is_write: true for a write false for a read
+*
+* returns:
+*   int: the number of the new request or -1 if memory ran out
+*/
+int add_request(BatchIo *io, const char *path, bool is_write){
+	IoRequest *request;
+	IoRequest *requests;/*the grown array*/
+	int capacity;/*the capacity of the grown array*/
+
+	if(io->count >= io->capacity){/*check if array is full*/
+		capacity = io->capacity ? io->capacity*2 : 64;/*double the capacity*/
+		requests = (IoRequest*)realloc(io->requests, capacity*sizeof(IoRequest));/*reallocate memory*/
+		if(requests == NULL){/*the old array still holds the queued requests*/
+			perror("realloc failed");
+			return -1;
+		}
+		io->requests = requests;
+		io->capacity = capacity;
+	}
+	request = &io->requests[io->count];
+	request->path = (char*)malloc(strlen(path) + 1);/*the path must outlive the caller's buffer*/
+	if(request->path == NULL){
+		perror("malloc failed");
+		return -1;
+	}
+	strcpy(request->path, path);
+	request->data = NULL;
+	request->length = 0;
+	request->capacity = 0;
+	request->transferred = 0;
+	request->is_write = is_write;
+	request->state = REQUEST_OPENING;
+	request->fd = -1;
+	request->error = 0;
+	return io->count++;
+}
+
+/*
+* grow_read_buffer
+* ----------------
+* this function makes sure a read request has room for more bytes by doubling its buffer
+*
+* parameters:
+*   request: the read request
+*
+* returns:
+*   bool: true if the buffer has room false if memory ran out
+*/
+bool grow_read_buffer(IoRequest *request){
+	char *data;
+
+	if(request->length < request->capacity){/*there is still room*/
+		return true;
+	}
+	data = (char*)realloc(request->data, request->capacity ? request->capacity*2 : BATCH_IO_INITIAL_READ_SIZE);
+	if(data == NULL){
+		request->error = ENOMEM;
+		return false;
+	}
+	request->data = data;
+	request->capacity = request->capacity ? request->capacity*2 : BATCH_IO_INITIAL_READ_SIZE;
+	return true;
+}
+
+/*
+* finish_write
+* ------------
+* this function accounts for a write request that completed or failed and frees its data
+*
+* parameters:
+*   io: a pointer to the BatchIo structure
+*   request: the write request
+*
+*/
+void finish_write(BatchIo *io, IoRequest *request){
+	if(request->state == REQUEST_FAILED){
+		fprintf(stderr, "Error: couldn't write %s: %s\n", request->path, strerror(request->error));
+		io->write_failed = true;
+	}
+	free(request->data);
+	request->data = NULL;
+	io->pending_writes--;
+}
+
+/*** SYSTEM CALL BACKEND SECTION ***/
+
+/*
+* perform_request
+* ---------------
+* this function performs a whole request with one blocking system call per operation
+* it is used when io_uring is not available and for requests the io_uring backend cannot take
+*
+* parameters:
+*   request: the request to perform
+*
+*/
+void perform_request(IoRequest *request){
+	long result;
+
+	request->fd = request->is_write ? open(request->path, O_WRONLY | O_CREAT | O_TRUNC, 0666) : open(request->path, O_RDONLY);
+	if(request->fd < 0){
+		request->error = errno;
+		request->state = REQUEST_FAILED;
+		return;
+	}
+
+	for(;;){/*transfer until the whole buffer was written or the end of the file was read*/
+		if(request->is_write){
+			if(request->transferred >= request->length){
+				break;
+			}
+			result = write(request->fd, request->data + request->transferred, request->length - request->transferred);
+		}
+		else{
+			if(!grow_read_buffer(request)){
+				break;
+			}
+			result = read(request->fd, request->data + request->length, request->capacity - request->length);
+		}
+		if(result < 0 && errno == EINTR){/*retry interrupted calls*/
+			continue;
+		}
+		if(result <= 0){
+			if(result < 0){
+				request->error = errno;
+			}
+			break;
+		}
+		if(request->is_write){
+			request->transferred += result;
+		}
+		else{
+			request->length += result;
+		}
+	}
+
+	if(close(request->fd) != 0 && request->error == 0){
+		request->error = errno;
+	}
+	request->fd = -1;
+	request->state = request->error ? REQUEST_FAILED : REQUEST_DONE;
+}
+
+/*** IO_URING BACKEND SECTION ***/
+
+#ifdef HAVE_IO_URING
+
+typedef struct{/*the rings shared with the kernel*/
+	int fd;/*descriptor of the io_uring*/
+	unsigned *sq_head;/*head of the submission queue*/
+	unsigned *sq_tail;/*tail of the submission queue*/
+	unsigned *sq_mask;/*mask of the submission queue indices*/
+	unsigned *sq_array;/*indices of the submitted entries*/
+	unsigned sq_entries;/*number of submission entries*/
+	struct io_uring_sqe *sqes;/*the submission entries*/
+	unsigned *cq_head;/*head of the completion queue*/
+	unsigned *cq_tail;/*tail of the completion queue*/
+	unsigned *cq_mask;/*mask of the completion queue indices*/
+	struct io_uring_cqe *cqes;/*the completion entries*/
+	void *sq_ring;/*mapping of the submission ring*/
+	size_t sq_ring_size;/*size of the submission ring mapping*/
+	void *cq_ring;/*mapping of the completion ring*/
+	size_t cq_ring_size;/*size of the completion ring mapping*/
+	size_t sqes_size;/*size of the submission entries mapping*/
+	unsigned to_submit;/*number of entries queued since the last submission*/
+}IoRing;
+
+/*
+* ring_setup
+* ----------
+* this function creates an io_uring and maps its rings
+* the ring is only used if the kernel supports opening reading writing and closing files through it
+*
+* parameters:
+*   ring: the ring to set up
+*
+* returns:
+*   bool: true if the ring is ready false if the plain system calls have to be used
+*/
+bool ring_setup(IoRing *ring){
+	struct io_uring_params params;
+	char *sq_ptr, *cq_ptr;
+
+	memset(&params, 0, sizeof(params));
+	ring->fd = (int)syscall(__NR_io_uring_setup, BATCH_IO_QUEUE_DEPTH, &params);
+	if(ring->fd < 0){
+		return false;/*io_uring is not available or not permitted*/
+	}
+	if(!(params.features & IORING_FEAT_RW_CUR_POS)){/*the kernel predates the file operations we need*/
+		close(ring->fd);
+		return false;
+	}
+
+	ring->sq_ring_size = params.sq_off.array + params.sq_entries*sizeof(unsigned);
+	ring->cq_ring_size = params.cq_off.cqes + params.cq_entries*sizeof(struct io_uring_cqe);
+	if(params.features & IORING_FEAT_SINGLE_MMAP){/*both rings share one mapping*/
+		if(ring->cq_ring_size > ring->sq_ring_size){
+			ring->sq_ring_size = ring->cq_ring_size;
+		}
+		ring->cq_ring_size = ring->sq_ring_size;
+	}
+
+	ring->sq_ring = mmap(NULL, ring->sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQ_RING);
+	if(ring->sq_ring == MAP_FAILED){
+		close(ring->fd);
+		return false;
+	}
+	if(params.features & IORING_FEAT_SINGLE_MMAP){
+		ring->cq_ring = ring->sq_ring;
+	}
+	else{
+		ring->cq_ring = mmap(NULL, ring->cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_CQ_RING);
+		if(ring->cq_ring == MAP_FAILED){
+			munmap(ring->sq_ring, ring->sq_ring_size);
+			close(ring->fd);
+			return false;
+		}
+	}
+	ring->sqes_size = params.sq_entries*sizeof(struct io_uring_sqe);
+	ring->sqes = (struct io_uring_sqe*)mmap(NULL, ring->sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQES);
+	if(ring->sqes == MAP_FAILED){
+		if(ring->cq_ring != ring->sq_ring){
+			munmap(ring->cq_ring, ring->cq_ring_size);
+		}
+		munmap(ring->sq_ring, ring->sq_ring_size);
+		close(ring->fd);
+		return false;
+	}
+
+	sq_ptr = (char*)ring->sq_ring;
+	cq_ptr = (char*)ring->cq_ring;
+	ring->sq_head = (unsigned*)(sq_ptr + params.sq_off.head);
+	ring->sq_tail = (unsigned*)(sq_ptr + params.sq_off.tail);
+	ring->sq_mask = (unsigned*)(sq_ptr + params.sq_off.ring_mask);
+	ring->sq_array = (unsigned*)(sq_ptr + params.sq_off.array);
+	ring->sq_entries = params.sq_entries;
+	ring->cq_head = (unsigned*)(cq_ptr + params.cq_off.head);
+	ring->cq_tail = (unsigned*)(cq_ptr + params.cq_off.tail);
+	ring->cq_mask = (unsigned*)(cq_ptr + params.cq_off.ring_mask);
+	ring->cqes = (struct io_uring_cqe*)(cq_ptr + params.cq_off.cqes);
+	ring->to_submit = 0;
+	return true;
+}
+
+/*
+* ring_teardown
+* -------------
+* this function unmaps the rings and closes the io_uring
+*
+* parameters:
+*   ring: the ring to tear down
+*
+*/
+void ring_teardown(IoRing *ring){
+	munmap(ring->sqes, ring->sqes_size);
+	if(ring->cq_ring != ring->sq_ring){
+		munmap(ring->cq_ring, ring->cq_ring_size);
+	}
+	munmap(ring->sq_ring, ring->sq_ring_size);
+	close(ring->fd);
+}
+
+/*
+* ring_enter
+* ----------
+* this function submits every queued entry and optionally waits for completions with a single system call
+*
+* parameters:
+*   ring: the ring
+*   min_complete: the number of completions to wait for
+*
+* returns:
+*   bool: true if the entries were submitted false if io_uring_enter failed (errno tells why)
+*/
+bool ring_enter(IoRing *ring, unsigned min_complete){
+	long result;
+
+	do{
+		result = syscall(__NR_io_uring_enter, ring->fd, ring->to_submit, min_complete, min_complete ? IORING_ENTER_GETEVENTS : 0, NULL, 0);
+	}while(result < 0 && errno == EINTR);
+	if(result < 0){
+		return false;
+	}
+	ring->to_submit -= (unsigned)result <= ring->to_submit ? (unsigned)result : ring->to_submit;
+	return true;
+}
+
+/*
+* fail_request
+* ------------
+* this function gives up a request the io_uring can no longer carry out
+* its file is closed and a write is accounted for like any write that failed
+*
+* parameters:
+*   io: a pointer to the BatchIo structure
+*   request: the request
+*   error: the errno the request fails with
+*
+*/
+void fail_request(BatchIo *io, IoRequest *request, int error){
+	if(request->fd >= 0){
+		close(request->fd);
+		request->fd = -1;
+	}
+	request->error = request->error ? request->error : error;
+	request->state = REQUEST_FAILED;
+	if(request->is_write){
+		finish_write(io, request);
+	}
+}
+
+/*
+* ring_abandon
+* ------------
+* this function stops using the io_uring after io_uring_enter failed
+* every request that did not complete fails since the kernel may never complete it
+* and the requests made from now on are performed with plain system calls
+*
+* parameters:
+*   io: a pointer to the BatchIo structure
+*   error: the errno io_uring_enter failed with
+*
+*/
+void ring_abandon(BatchIo *io, int error){
+	int i;
+
+	fprintf(stderr, "Warning: io_uring failed (%s) so the pending file operations failed and the rest use plain system calls\n", strerror(error));
+	ring_teardown((IoRing*)io->ring);
+	free(io->ring);
+	io->ring = NULL;
+	io->backend = SYSCALL_BACKEND;
+	io->in_flight = 0;
+	io->ring_error = 0;
+	for(i=0 ; i<io->count ; i++){
+		if(io->requests[i].state != REQUEST_DONE && io->requests[i].state != REQUEST_FAILED){
+			fail_request(io, &io->requests[i], error);
+		}
+	}
+}
+
+/*
+* ring_queue
+* ----------
+* this function queues the next operation of a request in the submission ring
+* the operation is submitted together with the others on the next ring_enter
+*
+* parameters:
+*   io: a pointer to the BatchIo structure
+*   index: the number of the request
+*
+*/
+void ring_queue(BatchIo *io, int index){
+	IoRing *ring = (IoRing*)io->ring;
+	IoRequest *request = &io->requests[index];
+	struct io_uring_sqe *sqe;
+	unsigned tail;
+
+	if(request->state == REQUEST_TRANSFERRING && !request->is_write && !grow_read_buffer(request)){
+		request->state = REQUEST_CLOSING;/*memory ran out so close the file and fail*/
+	}
+
+	tail = *ring->sq_tail;
+	if(tail - __atomic_load_n(ring->sq_head, __ATOMIC_ACQUIRE) >= ring->sq_entries && !ring_enter(ring, 0)){/*the submission ring is full*/
+		io->ring_error = errno;/*the caller abandons the ring once the completions were handled*/
+		fail_request(io, request, errno);
+		return;
+	}
+	sqe = &ring->sqes[tail & *ring->sq_mask];
+	memset(sqe, 0, sizeof(*sqe));
+	sqe->user_data = (unsigned long)index;
+
+	switch(request->state){
+		case REQUEST_OPENING:
+			sqe->opcode = IORING_OP_OPENAT;
+			sqe->fd = AT_FDCWD;
+			sqe->addr = (unsigned long)request->path;
+			sqe->len = 0666;
+			sqe->open_flags = request->is_write ? (O_WRONLY | O_CREAT | O_TRUNC) : O_RDONLY;
+			break;
+		case REQUEST_TRANSFERRING:
+			sqe->opcode = request->is_write ? IORING_OP_WRITE : IORING_OP_READ;
+			sqe->fd = request->fd;
+			if(request->is_write){
+				sqe->addr = (unsigned long)(request->data + request->transferred);
+				sqe->len = (unsigned)(request->length - request->transferred);
+				sqe->off = (unsigned long)request->transferred;
+			}
+			else{
+				sqe->addr = (unsigned long)(request->data + request->length);
+				sqe->len = (unsigned)(request->capacity - request->length);
+				sqe->off = (unsigned long)request->length;
+			}
+			break;
+		default:
+			sqe->opcode = IORING_OP_CLOSE;
+			sqe->fd = request->fd;
+			break;
+	}
+
+	ring->sq_array[tail & *ring->sq_mask] = tail & *ring->sq_mask;
+	__atomic_store_n(ring->sq_tail, tail + 1, __ATOMIC_RELEASE);
+	ring->to_submit++;
+	io->in_flight++;
+}
+
+/*
+* ring_complete
+* -------------
+* this function advances a request after one of its operations completed and queues its next operation
+*
+* parameters:
+*   io: a pointer to the BatchIo structure
+*   index: the number of the request
+*   result: the result of the completed operation
+*
+*/
+void ring_complete(BatchIo *io, int index, int result){
+	IoRequest *request = &io->requests[index];
+
+	io->in_flight--;
+	switch(request->state){
+		case REQUEST_OPENING:
+			if(result < 0){
+				request->error = -result;
+				request->state = REQUEST_FAILED;
+				break;
+			}
+			request->fd = result;
+			request->state = REQUEST_TRANSFERRING;
+			if(request->is_write && request->length == 0){
+				request->state = REQUEST_CLOSING;/*nothing to write*/
+			}
+			ring_queue(io, index);
+			return;
+		case REQUEST_TRANSFERRING:
+			if(result < 0){
+				request->error = -result;
+				request->state = REQUEST_CLOSING;
+			}
+			else if(request->is_write){
+				request->transferred += result;
+				if(result == 0 || request->transferred >= request->length){
+					request->error = result == 0 ? EIO : 0;
+					request->state = REQUEST_CLOSING;
+				}
+			}
+			else{
+				request->length += result;
+				if(result == 0){/*the end of the file was reached*/
+					request->state = REQUEST_CLOSING;
+				}
+			}
+			ring_queue(io, index);
+			return;
+		default:
+			if(result < 0 && request->error == 0){
+				request->error = -result;
+			}
+			request->fd = -1;
+			request->state = request->error ? REQUEST_FAILED : REQUEST_DONE;
+			break;
+	}
+
+	if(request->is_write){/*the write is over either way*/
+		finish_write(io, request);
+	}
+}
+
+/*
+* ring_reap
+* ---------
+* this function handles every completion waiting in the completion ring
+*
+* parameters:
+*   io: a pointer to the BatchIo structure
+*
+*/
+void ring_reap(BatchIo *io){
+	IoRing *ring = (IoRing*)io->ring;
+	unsigned head = *ring->cq_head;
+	struct io_uring_cqe *cqe;
+
+	while(head != __atomic_load_n(ring->cq_tail, __ATOMIC_ACQUIRE)){
+		cqe = &ring->cqes[head & *ring->cq_mask];
+		head++;
+		__atomic_store_n(ring->cq_head, head, __ATOMIC_RELEASE);/*free the entry before queueing follow up operations*/
+		ring_complete(io, (int)cqe->user_data, cqe->res);
+	}
+}
+
+/*
+* ring_wait
+* ---------
+* this function submits the queued entries waits for at least one completion and handles every completion that arrived
+* the io_uring is abandoned when io_uring_enter fails
+*
+* parameters:
+*   io: a pointer to the BatchIo structure
+*
+* returns:
+*   bool: true if the io_uring is still in use false if it was abandoned
+*/
+bool ring_wait(BatchIo *io){
+	if(!ring_enter((IoRing*)io->ring, 1)){
+		ring_abandon(io, errno);
+		return false;
+	}
+	ring_reap(io);
+	if(io->ring_error){/*a follow up operation could not be submitted*/
+		ring_abandon(io, io->ring_error);
+		return false;
+	}
+	return true;
+}
+
+/*
+* ring_make_room
+* --------------
+* this function waits for completions until another operation can be kept in flight
+* the caller must check the backend again since the io_uring is abandoned when it fails
+*
+* parameters:
+*   io: a pointer to the BatchIo structure
+*
+*/
+void ring_make_room(BatchIo *io){
+	while(io->in_flight >= BATCH_IO_QUEUE_DEPTH && ring_wait(io));
+}
+
+#endif
+
+/*** BATCHED I/O SECTION ***/
+
+/*
+* batch_io_open
+* -------------
+* this function prepares a BatchIo and chooses its backend
+* io_uring is used when it was requested and the kernel allows it otherwise every operation is a plain system call
+*
+* parameters:
+*   io: a pointer to the BatchIo structure to be prepared
+*   use_io_uring: true to try the io_uring backend
+*
+*/
+void batch_io_open(BatchIo *io, bool use_io_uring){
+	io->backend = SYSCALL_BACKEND;
+	io->requests = NULL;
+	io->count = 0;
+	io->capacity = 0;
+	io->in_flight = 0;
+	io->pending_writes = 0;
+	io->write_failed = false;
+	io->ring = NULL;
+	io->ring_error = 0;
+
+#ifdef HAVE_IO_URING
+	if(use_io_uring){
+		io->ring = malloc(sizeof(IoRing));
+		if(io->ring != NULL && ring_setup((IoRing*)io->ring)){
+			io->backend = IO_URING_BACKEND;
+		}
+		else{
+			free(io->ring);
+			io->ring = NULL;
+		}
+	}
+#endif
+}
+
+/*
+* batch_io_read
+* -------------
+* this function queues the read of a whole file
+* with io_uring the open read and close are submitted in batches together with the other queued operations
+*
+* parameters:
+*   io: a pointer to the BatchIo structure
+*   path: the path of the file to read
+*
+* returns:
+*   int: the number of the request to pass to batch_io_wait or -1 if memory ran out
+*/
+int batch_io_read(BatchIo *io, const char *path){
+	int index;
+
+#ifdef HAVE_IO_URING
+	if(io->backend == IO_URING_BACKEND){
+		ring_make_room(io);/*before the request is added so abandoning the ring does not fail it*/
+	}
+#endif
+	index = add_request(io, path, false);
+#ifdef HAVE_IO_URING
+	if(index >= 0 && io->backend == IO_URING_BACKEND){/*else the read is performed by batch_io_wait*/
+		ring_queue(io, index);
+	}
+#endif
+	return index;
+}
+
+/*
+* batch_io_wait
+* -------------
+* this function waits until a request completed
+* every queued operation is submitted on the way and completions of other requests are handled as they arrive
+*
+* parameters:
+*   io: a pointer to the BatchIo structure
+*   request: the number of the request
+*
+* returns:
+*   IoRequest*: the completed request which stays valid until the next request is queued
+*/
+IoRequest *batch_io_wait(BatchIo *io, int request){
+	TRACE_BEGIN("io", "io_wait");
+#ifdef HAVE_IO_URING
+	if(io->backend == IO_URING_BACKEND){
+		while(io->requests[request].state != REQUEST_DONE && io->requests[request].state != REQUEST_FAILED && ring_wait(io));
+		if(io->backend == IO_URING_BACKEND && !ring_enter((IoRing*)io->ring, 0)){/*submit the follow up operations so they progress while the caller works*/
+			ring_abandon(io, errno);
+		}
+	}
+#endif
+	if(io->backend == SYSCALL_BACKEND && io->requests[request].state == REQUEST_OPENING){
+		perform_request(&io->requests[request]);
+	}
+	TRACE_END();
+	return &io->requests[request];
+}
+
+/*
+* batch_io_write
+* --------------
+* this function queues the write of a buffer to a file
+* the BatchIo takes ownership of the buffer and frees it once it was written
+*
+* parameters:
+*   io: a pointer to the BatchIo structure
+*   path: the path of the file to write
+*   data: the buffer to write which must have been allocated with malloc
+*   length: the number of bytes to write
+*
+* returns:
+*   int: the number of the request to wait for or -1 if memory ran out and the buffer was freed
+*/
+int batch_io_write(BatchIo *io, const char *path, char *data, long length){
+	int index;
+	IoRequest *request;
+
+#ifdef HAVE_IO_URING
+	if(io->backend == IO_URING_BACKEND){
+		ring_make_room(io);/*before the request is added so abandoning the ring does not fail it*/
+	}
+#endif
+	index = add_request(io, path, true);
+	if(index < 0){
+		free(data);
+		io->write_failed = true;
+		return -1;
+	}
+	request = &io->requests[index];
+	request->data = data;
+	request->length = length;
+	io->pending_writes++;
+
+	if(io->backend == SYSCALL_BACKEND){
+		TRACE_BEGIN("io", "io_write");
+		perform_request(request);
+		finish_write(io, request);
+		TRACE_END();
+		return index;
+	}
+
+#ifdef HAVE_IO_URING
+	ring_queue(io, index);
+#endif
+	return index;
+}
+
+/*
+* batch_io_release
+* ----------------
+* this function frees the data of a completed read once the caller no longer needs it
+*
+* parameters:
+*   io: a pointer to the BatchIo structure
+*   request: the number of the request
+*
+*/
+void batch_io_release(BatchIo *io, int request){
+	free(io->requests[request].data);
+	io->requests[request].data = NULL;
+}
+
+/*
+* batch_io_close
+* --------------
+* this function waits for every queued write and frees everything the BatchIo holds
+*
+* parameters:
+*   io: a pointer to the BatchIo structure
+*
+* returns:
+*   bool: true if every write succeeded false otherwise
+*/
+bool batch_io_close(BatchIo *io){
+	int i;
+
+#ifdef HAVE_IO_URING
+	if(io->backend == IO_URING_BACKEND){
+		TRACE_BEGIN("io", "io_drain");
+		while(io->in_flight > 0 && ring_wait(io));/*finish every operation including reads nobody waited for*/
+		TRACE_END();
+	}
+	if(io->backend == IO_URING_BACKEND){
+		ring_teardown((IoRing*)io->ring);
+		free(io->ring);
+		io->ring = NULL;
+	}
+#endif
+
+	for(i=0 ; i<io->count ; i++){
+		free(io->requests[i].path);
+		free(io->requests[i].data);
+	}
+	free(io->requests);
+	io->requests = NULL;
+	io->count = 0;
+	return !io->write_failed;
+}
@@ -0,0 +1,65 @@
+#ifndef BATCH_IO_H
+#define BATCH_IO_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "definitions.h"
+
+#define BATCH_IO_QUEUE_DEPTH 64/*number of operations the io_uring backend keeps in flight*/
+#define BATCH_IO_READ_AHEAD 16/*number of source files read ahead of the file being assembled*/
+#define BATCH_IO_INITIAL_READ_SIZE 16384/*initial size of the buffer a source file is read into*/
+
+/*** STRUCTURE DEFINITIONS SECTION ***/
+
+/*backend that performs the batched operations*/
+typedef enum batch_io_backends{
+	/*one blocking system call per operation*/
+	SYSCALL_BACKEND = 0,
+	/*operations submitted and completed in batches through a Linux io_uring*/
+	IO_URING_BACKEND = 1
+}batch_io_backend;
+
+/*state of a single request*/
+typedef enum request_states{
+	REQUEST_OPENING,/*waiting for the file to be opened*/
+	REQUEST_TRANSFERRING,/*waiting for a read or a write*/
+	REQUEST_CLOSING,/*waiting for the file to be closed*/
+	REQUEST_DONE,/*the request completed successfully*/
+	REQUEST_FAILED/*the request failed and error holds the errno value*/
+}request_state;
+
+typedef struct{/*a read of a whole file or a write of a whole buffer*/
+	char *path;/*path of the file*/
+	char *data;/*contents read from or to be written to the file*/
+	long length;/*number of bytes of data*/
+	long capacity;/*size of the data buffer of a read*/
+	long transferred;/*number of bytes of a write already written*/
+	bool is_write;/*true for a write false for a read*/
+	request_state state;/*state of the request*/
+	int fd;/*descriptor of the open file*/
+	int error;/*errno value of a failed request*/
+}IoRequest;
+
+typedef struct{/*a set of file reads and writes performed in batches*/
+	batch_io_backend backend;/*backend in use*/
+	IoRequest *requests;/*all the requests made so far*/
+	int count;/*number of requests*/
+	int capacity;/*capacity for dynamic allocation*/
+	int in_flight;/*number of operations submitted and not yet completed*/
+	int pending_writes;/*number of writes that did not finish yet*/
+	bool write_failed;/*true if any write failed*/
+	void *ring;/*state of the io_uring backend*/
+	int ring_error;/*errno of an io_uring_enter that failed while completions were handled or 0*/
+}BatchIo;
+
+/*** FUNCTION PROTOTYPES SECTION ***/
+
+void batch_io_open(BatchIo *io, bool use_io_uring);/*function to prepare the batched I/O and choose its backend*/
+int batch_io_read(BatchIo *io, const char *path);/*function to queue the read of a whole file and return the request number*/
+IoRequest *batch_io_wait(BatchIo *io, int request);/*function to wait for a request to complete*/
+int batch_io_write(BatchIo *io, const char *path, char *data, long length);/*function to queue the write of a buffer to a file and return the request number*/
+void batch_io_release(BatchIo *io, int request);/*function to free the data of a completed read*/
+bool batch_io_close(BatchIo *io);/*function to finish every queued write and release the batched I/O*/
+
+#endif /*BATCH_IO_H*/
@@ -0,0 +1,75 @@
+#!/bin/sh
+#
+# bench.sh
+# --------
+# measures the throughput of an assembler over a generated corpus
+# the corpus is generated once per seed and size and checked before anything is measured
+# every configuration is run RUNS times over the whole corpus and the minimum and the median wall time are reported
+# as lines per second, megabytes of source per second and files per second
+# a last sequential run with --stats --perf-counters prints the cycles instructions misses and page faults of every phase
+# (only the counters the kernel and the processor permit, a warning names the others)
+#
+# usage: bench.sh ASSEMBLER GENERATOR DIR FILES RUNS SEED [assembler options]
+#   the corpus lives in DIR/corpus, any options after SEED are added to every run (for example --batch-io)
+#
+
+if [ $# -lt 6 ]; then
+	echo "usage: $0 ASSEMBLER GENERATOR DIR FILES RUNS SEED [assembler options]" >&2
+	exit 1
+fi
+ASSEMBLER=$1
+GENERATOR=$2
+DIR=$3
+FILES=$4
+RUNS=$5
+SEED=$6
+shift 6
+CORPUS=$DIR/corpus
+
+# generate the corpus again only when its seed or size changed
+if [ "$(cat "$CORPUS/seed" 2>/dev/null)" != "$SEED $FILES" ]; then
+	rm -rf "$CORPUS"
+	mkdir -p "$CORPUS" || exit 1
+	"$GENERATOR" -s "$SEED" -n "$FILES" -o "$CORPUS" || exit 1
+	ls "$CORPUS" | sed -n 's/\.as$//p' | sed "s|^|$CORPUS/|" > "$CORPUS/list"
+	echo "$SEED $FILES" > "$CORPUS/seed"
+fi
+if ! "$ASSEMBLER" --check -j 0 "@$CORPUS/list" > /dev/null; then
+	echo "bench: the corpus in $CORPUS does not assemble" >&2
+	exit 1
+fi
+
+LINES=$(cat "$CORPUS"/*.as | wc -l)
+BYTES=$(cat "$CORPUS"/*.as | wc -c)
+echo "corpus: $FILES files, $LINES lines, $BYTES bytes (seed $SEED), $RUNS runs per configuration"
+printf "%-20s %10s %10s %14s %14s %10s %10s %10s\n" "configuration" "min s" "median s" "lines/s" "lines/s med" "MB/s" "MB/s med" "files/s"
+
+# bench_configuration NAME OPTIONS...
+bench_configuration(){
+	NAME=$1
+	shift
+	TIMES=""
+	RUN=0
+	while [ $RUN -lt "$RUNS" ]; do
+		START=$(date +%s%N)
+		"$ASSEMBLER" "$@" "@$CORPUS/list" > /dev/null 2>&1
+		END=$(date +%s%N)
+		TIMES="$TIMES $((END - START))"
+		RUN=$((RUN + 1))
+	done
+	echo $TIMES | tr ' ' '\n' | sort -n | awk -v name="$NAME" -v lines="$LINES" -v bytes="$BYTES" -v files="$FILES" '
+		{ t[NR] = $1 / 1e9 }
+		END {
+			min = t[1]; med = NR % 2 ? t[(NR + 1) / 2] : (t[NR / 2] + t[NR / 2 + 1]) / 2
+			printf "%-20s %10.4f %10.4f %14.0f %14.0f %10.2f %10.2f %10.1f\n", name, min, med,
+				lines / min, lines / med, bytes / min / 1048576, bytes / med / 1048576, files / min
+		}'
+}
+
+bench_configuration "sequential" "$@"
+bench_configuration "-j 0" -j 0 "$@"
+bench_configuration "--check -j 0" --check -j 0 "$@"
+
+echo
+echo "counters of a sequential run (--stats --perf-counters):"
+"$ASSEMBLER" --stats --perf-counters "$@" "@$CORPUS/list" 2>&1 > /dev/null | sed -n -e '/^Warning: the hardware counters/p' -e '/^phase (all files)/,$p'
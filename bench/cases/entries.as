@@ -0,0 +1,16 @@
+; entries declared before and after their labels, on code and on data
+.entry START
+.entry VALUES
+
+START:	lea TEXT, r1
+	prn *r1
+	inc r1
+	cmp VALUES, #3
+	bne LAST
+	jsr LAST
+	stop
+.entry TEXT
+LAST:	rts
+VALUES:	.data 1, 2, 3
+TEXT:	.string "entries"
+.entry LAST
@@ -0,0 +1,11 @@
+; a file with errors in both passes is rejected with a message for each
+.extern OUT
+MAIN:	mov r1, UNDEFINED
+MAIN:	stop
+	foo r1
+	mov r1
+	prn #1, #2
+	lea #1, r2
+TEXT:	.string "open
+	.data 1,,2
+	jmp OUT
@@ -0,0 +1,6 @@
+; an extern that is defined in the file and an entry that is declared extern
+.extern X
+X:	stop
+.extern A
+.entry A
+MAIN:	jmp A
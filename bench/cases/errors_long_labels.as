@@ -0,0 +1,4 @@
+; an operand longer than 31 characters is not cut into a label
+A234567890123456789012345678901: stop
+      jmp A2345678901234567890123456789012
+A2345678901234567890123456789012X: stop
@@ -0,0 +1,14 @@
+; errors inside expanded macros are reported on the line of the call
+; and the lines of the definitions and comments are still counted
+
+macr load
+	mov r1, r9
+	inc COUNT
+endmacr
+; the first call
+START:	load
+	prn #1
+	load
+COUNT:	.data 1
+	.entry MISSING
+	jmp NOWHERE
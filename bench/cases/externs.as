@@ -0,0 +1,17 @@
+; every operand position that can reference an extern, and an extern referenced many times
+.extern GETC
+.extern PUTC
+.extern BUF
+
+MAIN:	jsr GETC
+	mov BUF, r1
+	cmp r1, BUF
+	lea BUF, r2
+	add #1, BUF
+	prn BUF
+	mov BUF, BUF
+	cmp BUF, #-1
+	jsr PUTC
+	bne MAIN
+	jmp PUTC
+	stop
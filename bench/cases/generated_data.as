@@ -0,0 +1,410 @@
+; generated program seed 5 words 1997
+.extern X0
+.extern X1
+.extern X2
+.extern X3
+.extern X4
+.extern X5
+.extern X6
+.extern X7
+.extern X8
+.extern X9
+macr m0
+	dec *r6
+	dec *r4
+endmacr
+macr m1
+	sub r2, *r5
+	sub #89, r7
+	mov #90, r6
+endmacr
+macr m2
+	sub r1, r2
+endmacr
+macr m3
+	rts
+endmacr
+macr m4
+	dec r0
+endmacr
+macr m5
+	inc *r4
+	mov r4, *r4
+	prn r1
+endmacr
+macr m6
+	sub *r2, *r3
+	add r5, r5
+	stop
+endmacr
+macr m7
+	bne *r4
+	red r4
+	cmp #77, *r6
+endmacr
+L0:	.string "g"
+	.string "yircmejjrptb"
+L1:	sub L101, *r5
+L2:	.data 241, 457, -379, -305, 212, -112, 339
+L3:	.string "krntnbpgevouqcpfdcos"
+
+	jsr *r6
+
+L4:	lea L66, *r3
+; comment line of the generated program
+L5:	.data -330, -72, -98, 265, -398, 418
+; comment line of the generated program
+L6:	sub r0, L59
+	.data 80, 391, -270, 133, 318, -13, 47, -20
+
+L7:	.data -350, 272, 256, 367, -64, 396
+L8:	.data 348, -397, 50, 192, 218, 51, -268
+L9:	red *r1
+	.data 366, -237, -364, -185, 273, 358, -103
+; comment line of the generated program
+L10:	.data 78, -102, -84
+L11:	.string "llegavdrbmcntwzzaixull"
+	m7
+L12:	.string "ayrpwdr"
+	.string "ljtrtcdxeuarif"
+L13:	stop
+L14:	.data -325, 365
+	m7
+; comment line of the generated program
+L15:	.data -309, -350, 186
+	m6
+	.data -241, -253, -475
+L16:	.string "egrweladnusgaopikbnxemt"
+L17:	add L139, r4
+
+L18:	.string "jaboek"
+	dec *r5
+	m5
+L19:	.data -300
+L20:	.string "pgodzkemsrpws"
+L21:	jmp L140
+	.string "gyjhohlpb"
+L22:	not *r3
+L23:	bne L175
+; comment line of the generated program
+L24:	.string "guw"
+; comment line of the generated program
+L25:	not L188
+; comment line of the generated program
+	.string "ecxzmqljmivchlk"
+L26:	.string "nc"
+L27:	.data -372, -363, 463, 27, 240, -7, -441
+L28:	rts
+	.string "vizvvcaoiugmmeesxhwsghs"
+L29:	add *r4, L127
+L30:	.data -429, 214
+L31:	cmp L113, #81
+	.data 427, -371, 315, -276, -4
+L32:	.string "cunrucohzksmpn"
+L33:	.data 341, -484
+L34:	inc *r2
+	.data -225, 284
+L35:	prn L88
+; comment line of the generated program
+	m6
+	m0
+L36:	.string "qiqzddrpf"
+L37:	.string "dzdiyd"
+	.data 13, 284, 129
+; comment line of the generated program
+L38:	.string "ugscorhb"
+L39:	.string "owfewcpuhl"
+L40:	bne L19
+	inc L70
+; comment line of the generated program
+L41:	jsr *r4
+L42:	.data -206, -190, 69
+L43:	clr L168
+	.data -24
+L44:	.string "yydslfpnopdjr"
+L45:	.string "vomrsxwntezlukv"
+L46:	.data 298
+
+	.data -394, 66, 372, 198, -237, -236
+L47:	.string "fbilcoyjdsnehvcpexygnhg"
+L48:	.data -297, -295, -231
+L49:	red *r4
+L50:	prn L97
+	.data -296, 198
+L51:	lea L150, r2
+L52:	.string "trzekwvhfgalmnvd"
+	m7
+
+	m3
+L53:	.data -421, 53, 413
+	.data 38, -482, 254
+L54:	prn L53
+; comment line of the generated program
+L55:	jsr *r1
+
+L56:	.string "ikovbpjqf"
+	.data -228, -487, 447, 300
+L57:	prn r0
+	m1
+L58:	sub L31, L110
+L59:	.data -326, -456, -131, -188, -392, 392, 9, 61
+	.data -174, 307, 256, -392, -294, -44
+L60:	.string "mefafxc"
+	m1
+L61:	.data 456, -452, -176
+L62:	.data 285, -330, 119
+	.string "cm"
+L63:	.string "qzdcqfuvf"
+L64:	.data 32, 413, 316, 71, 64
+L65:	.string "hteoclcausddjiyln"
+	.data -207, -142
+L66:	.string "zgqstqrwinfvwkzd"
+
+L67:	.string "grgtjhlugbs"
+L68:	.data 62, 424, -459, -463
+	add L85, L102
+	m3
+L69:	.data 246, 85, -259, -99, -1, -272
+L70:	.data 76, 166, -410, -374, -234, 127, 10
+L71:	.string "lppbmynffumzaoalssdita"
+	.string "ljdjlpxrepxjhwsgarxga"
+L72:	inc L2
+L73:	prn #44
+
+L74:	.string "rlfxylcedcbzp"
+
+L75:	rts
+	.data 362
+	m4
+L76:	.string "vpfr"
+L77:	mov #61, *r2
+L78:	inc r3
+
+	not r5
+L79:	.data -328, -343, 415, 232, -38
+L80:	.data -48, 350, 46, 360, -304, -207, -399
+	m2
+L81:	.data -79
+	.string "mhklzhirv"
+L82:	.data 34, -149, 352, 117, -398, -280, -247, 480
+
+L83:	.data -132, 225, -337
+L84:	.data -37, 41, 94, 476, 189
+	inc r7
+; comment line of the generated program
+L85:	rts
+L86:	.string "dmetf"
+L87:	.string "d"
+	.string "shou"
+L88:	.data 423, -304, -104, 243, -422
+L89:	dec *r6
+L90:	.data 163, -353
+	.string "vtkfwawvmtprsghyruey"
+L91:	.data 334, 419, 64, 151, -403, -264, -339, -114
+L92:	.data -274, -65
+L93:	.data 460, -329, -375, 297, -242
+	.data 391, 423, 306, -321, 159
+; comment line of the generated program
+	m3
+L94:	bne *r4
+L95:	.string "njk"
+L96:	.data -344, 402, 128
+	.data 100, -372, 255, 415, -17, -9, 286, -226
+L97:	.data -166
+	m7
+L98:	.string "vaqmmuqscbqwv"
+L99:	mov L159, *r6
+L100:	prn L46
+	.string "ydiki"
+; comment line of the generated program
+L101:	.string "lclwmalkppp"
+L102:	jsr *r1
+L103:	dec L131
+	.string "edcbectsgfphzgd"
+; comment line of the generated program
+	m5
+L104:	.data 236, 23, 264, 146, -296, -266, -298
+L105:	.string "xy"
+L106:	prn *r1
+; comment line of the generated program
+	.data -112, -364, 225, 133, -374, -499, -96
+L107:	.string "tbbdeoaifiovgvro"
+L108:	.string "mjqdgc"
+L109:	.string "dhimcp"
+
+	.data 472, -388
+
+	m3
+L110:	inc X5
+L111:	.string "qnau"
+L112:	.string "w"
+	.data -63, 218
+L113:	inc *r4
+L114:	prn L186
+	m1
+; comment line of the generated program
+L115:	.data 267, 173, -441, -221, 242, 479, 143, -72
+	rts
+L116:	.string "pzmthlrtvnveflkkrl"
+L117:	add #-74, L33
+; comment line of the generated program
+L118:	.string "clulbismeehlvrktsfrr"
+	.data 483, 207, -471, -400, -168, -321
+L119:	.string "tzxlibtgvommfvcqqlxefax"
+
+L120:	.data 99, -334, 235, -380, 377, 403
+L121:	.data 39, 11, 32
+; comment line of the generated program
+	.data 310, 411, -191, 146, -3
+L122:	.string ""
+L123:	.string "yjcghifxxdfcbtkuqpxdqo"
+L124:	.string "b"
+L125:	.data 174, -22, -26, -98, 208, 276, -474
+	add L155, r0
+L126:	.data 263, 109, 169, 192, 357, 110, -301
+; comment line of the generated program
+L127:	.data -195, -358
+L128:	.string "qq"
+	rts
+L129:	.string "nnojvthweelehklz"
+L130:	.data -277, -286, -134, 262, 114, -489
+L131:	.data 25, 340, -473, -254, -473, 391, -391
+	stop
+; comment line of the generated program
+L132:	.data -163
+L133:	.data 250
+L134:	.data 91, -73, 411, -445, 53, -243, 91
+	m5
+	m0
+; comment line of the generated program
+	.data -147, 264
+L135:	.string "jgkechvjtlvpgvjqzc"
+L136:	.data -413, 497, 249, -440, 208, -413, -70, -47
+L137:	.string "hwksjwikl"
+	.data 73, -188, 297, 488, -6, 317
+; comment line of the generated program
+	m3
+
+L138:	.string "glcxdvvfnrvczl"
+
+L139:	bne L53
+L140:	.string "jybcqvhba"
+	.data 488, -322, 424, -457, -407, 325, 150
+L141:	stop
+L142:	.string "ijajphjadobaqphbwbh"
+L143:	.string "utqvrsqxyubmxipswloejc"
+; comment line of the generated program
+	.data -197, -309, -62, 432, -381, -211, -256, -22
+L144:	.data -52
+; comment line of the generated program
+L145:	.string "znmoizzsdhitqescbps"
+; comment line of the generated program
+L146:	.string "xgnbifrphrljpgyoj"
+
+	.data 426, 3, -320
+L147:	rts
+L148:	.data 401, 236, -390, -274, 466
+L149:	jsr *r6
+L150:	.data 228, 144, 475, -116, 64, 99, 125, -260
+	.data 402, 383, 150
+; comment line of the generated program
+L151:	.data 285, -394, 419, 0, 163, -429
+	m0
+	m5
+L152:	dec L91
+L153:	.string "kuzjuebtfpqlntpxy"
+	.string "xrbkeuclvczz"
+L154:	.string "sjtznuggdcfxch"
+L155:	inc L133
+L156:	.data -27, 465, 215, -271, 307, -467
+; comment line of the generated program
+	.string "crzesbkcax"
+	m3
+
+L157:	rts
+L158:	dec *r3
+L159:	.data -94, 198, -330, 393
+	m3
+	mov r1, L147
+L160:	.string "fnkuihkfbvxyeloxjpynyli"
+; comment line of the generated program
+L161:	rts
+L162:	.data -37, 200, 465, -371, -140, 83, 376
+	.string "opopqmm"
+L163:	.string "zizyqyjplczdveboztrhb"
+L164:	.string "afzmhhsruvanhpobyyfojww"
+L165:	.string "muazmbjjubcresv"
+; comment line of the generated program
+	.string "tefpzwtgcgyxnlluipqzmd"
+	m1
+
+L166:	dec L119
+L167:	.data -474, -366, 12, 296
+L168:	.string "codlbjkucgavsgmmaebxyeh"
+	m6
+	.data 165, 38, 2, -439, -444
+L169:	.data -217, -404, 69, -427, 445
+L170:	.data 304
+L171:	jsr L175
+	m1
+
+	.string "wqgsjfmxlklwqxi"
+L172:	add #-89, *r3
+L173:	.data -264
+L174:	.data 196, 364, -457, -245, -228
+; comment line of the generated program
+L175:	.data 37, 282, -402, 241, 358, 120, -241, -46
+; comment line of the generated program
+	sub r6, r7
+L176:	.string "zylmyltrffmlz"
+
+L177:	.string "ylwzqlywtdfwaqpiohgycl"
+L178:	.data 367, -185
+	m6
+	.string "ejmmiadpdtcrmv"
+L179:	.string "ztfnvyigfedg"
+L180:	rts
+L181:	inc *r1
+	.data -19, -73, -56, 406, 118, -321, -435
+L182:	.data 298, 21
+L183:	red L169
+
+L184:	.data 37, -463, 85, 217, 338, -230, -171
+	.data 327, -330, 238, 384
+
+L185:	.string "agvnugfpgbunhckvfmuwgix"
+L186:	.string "blwcub"
+	m7
+; comment line of the generated program
+L187:	.string "kryknozkoyqvljuvtamsggz"
+; comment line of the generated program
+	.string "oc"
+L188:	.data 118, -496, -244, -478, 372
+L189:	.string "ykrgtvvmsxaolvwqmdrwb"
+
+L190:	lea L170, r5
+	.data 55, 347, -353, 232, 65, -69, -277, 207
+L191:	.string "hgxquraxkgvssayjcwagmi"
+L192:	.data -133, -229, -264
+L193:	.data -381, -225, 99, -444
+	.string "uxcjmdakfinwbeosqj"
+L194:	clr L191
+L195:	.string "dqpykoqekhie"
+L196:	.string ""
+	m3
+	sub #-90, r3
+L197:	.data -144, -149
+L198:	.data 467, -116, 56, -46, -146, 471, 342
+; comment line of the generated program
+L199:	.data -48, -320
+	m5
+.entry L0
+.entry L20
+.entry L40
+.entry L60
+.entry L80
+.entry L100
+.entry L120
+.entry L140
+.entry L160
+.entry L180
@@ -0,0 +1,1517 @@
+; generated program seed 2 words 3900
+.extern X0
+.extern X1
+.extern X2
+.extern X3
+.extern X4
+.extern X5
+.extern X6
+.extern X7
+.extern X8
+.extern X9
+macr m0
+	mov #-41, *r3
+endmacr
+macr m1
+	jsr *r2
+endmacr
+macr m2
+	jsr *r2
+	not *r5
+	inc *r1
+endmacr
+macr m3
+	stop
+endmacr
+macr m4
+	red *r6
+	dec r6
+endmacr
+macr m5
+	sub *r5, r2
+endmacr
+macr m6
+	red r7
+	add #-27, r2
+endmacr
+macr m7
+	inc *r5
+endmacr
+L0:	stop
+	.string "n"
+	add r0, r5
+; comment line of the generated program
+	rts
+
+	.string "pptaucmye"
+	clr r5
+L1:	.string "qhaffingyyx"
+	.data 434, -359
+	stop
+	red L108
+; comment line of the generated program
+	dec r5
+	.string "gmamwgwdixhwkccwfzaql"
+L2:	prn *r3
+	not r7
+	sub L55, *r2
+
+	m4
+	cmp #93, r0
+	.data 286, 404, -475
+L3:	jsr *r6
+	stop
+	m5
+	m6
+	.data -252, 205, -281, 246
+	mov L165, r3
+	.data 439, -38
+	.data -438, 39, 198, -233, -31
+L4:	.data 488, 383, -460, 446, 348
+	.data 214, 427, -339, -205, -364, 231, 342
+	sub *r0, *r0
+	m3
+
+	.data -302, -413, -228, 103, 451, 391
+	m4
+	jmp L150
+L5:	stop
+
+	cmp L128, #76
+	cmp #68, L197
+	not *r1
+	m1
+	prn *r3
+; comment line of the generated program
+	bne L107
+L6:	dec L129
+	.string "n"
+	sub #2, r1
+	.data -242
+	jsr L4
+L7:	.data 33, -158, -206
+
+	.data 285, -320, -56
+	m6
+	jmp *r4
+	stop
+	not *r4
+; comment line of the generated program
+	jsr L160
+L8:	stop
+; comment line of the generated program
+	rts
+; comment line of the generated program
+	.data 27, -350, -111, 238, -195, 353, 79
+; comment line of the generated program
+	rts
+	inc X2
+; comment line of the generated program
+L9:	sub r2, L191
+	m2
+; comment line of the generated program
+	prn #81
+	jmp L51
+	jsr *r0
+	.data -250, -243, 404, -321, -42, 24, -311
+	.data 328, 282, -484, -89
+L10:	red L14
+	red *r0
+	add #-66, L0
+	prn L6
+	rts
+L11:	not L74
+	red X8
+	m3
+	sub L132, L97
+; comment line of the generated program
+	not r1
+	stop
+; comment line of the generated program
+	lea L146, *r3
+L12:	mov L93, L120
+; comment line of the generated program
+	jsr *r0
+	m1
+	.data -53, 312, 290, -121
+	dec r0
+	sub *r4, r2
+	m3
+	m2
+; comment line of the generated program
+L13:	.string "ayinusmwghxpj"
+	.data -469, -127, -123, 373, -179
+	not r6
+	cmp *r1, *r1
+; comment line of the generated program
+	add *r2, r6
+; comment line of the generated program
+	m7
+	bne *r4
+L14:	prn #99
+
+	lea L58, L102
+	cmp #-26, L90
+; comment line of the generated program
+	sub L173, L133
+	dec *r3
+; comment line of the generated program
+L15:	mov *r3, L164
+	.string "ekwvitncttfvpcjthvp"
+	dec r2
+	inc r1
+
+	inc r0
+	.data -202, 257, -134
+L16:	.string "gfghan"
+	jsr *r4
+
+	.data -328, -26, -385, -489, 388, -237, -164
+	add r0, *r7
+	m2
+	red *r4
+; comment line of the generated program
+L17:	add L8, L63
+	add r7, L158
+	.data -33, 486, 34, -320, 440
+
+	bne *r1
+	prn #-60
+	prn #64
+L18:	.data -52, 398, -266, -417, 193, -318
+	dec r3
+	red L109
+	stop
+	lea L6, L32
+L19:	rts
+	bne L19
+	m6
+	cmp #49, *r7
+	cmp *r2, L105
+	sub L31, r5
+	jmp *r0
+
+L20:	.string "atsfqtobbgyllmev"
+	cmp *r1, r3
+	m6
+	.string "rihsdcfajwfwaitvatl"
+; comment line of the generated program
+	lea L142, L71
+	add #-100, r1
+	jmp *r0
+L21:	jsr *r4
+	prn *r6
+	bne L59
+	rts
+	cmp *r2, #78
+L22:	stop
+
+	cmp *r5, #22
+	cmp L100, r4
+
+	rts
+; comment line of the generated program
+	sub r1, *r7
+	m0
+	sub r4, L115
+
+L23:	mov #-8, *r6
+	m1
+; comment line of the generated program
+	clr r0
+	.data -36
+	prn #89
+	stop
+L24:	red r7
+	not *r2
+
+	.data -388
+
+	mov #46, *r4
+	.data 154, -446
+	sub #-37, *r0
+L25:	prn *r5
+	sub *r2, *r7
+	inc r5
+	prn r5
+	inc *r3
+L26:	bne *r7
+	.string ""
+
+	mov L6, r2
+	sub *r3, *r3
+	mov *r5, *r5
+	prn *r6
+L27:	bne *r5
+; comment line of the generated program
+	add *r7, *r6
+	sub #59, r4
+	add r3, L0
+; comment line of the generated program
+	m4
+	.data -447, -9, -226, -81
+; comment line of the generated program
+L28:	prn *r7
+	clr L2
+	.data 104, -176, -417
+	m6
+	.data -345, -440, 455, -465
+	inc r7
+	bne *r0
+L29:	lea L149, r3
+	lea L82, r0
+
+	inc r6
+; comment line of the generated program
+	.data 308, -26
+	.data -29
+	m1
+L30:	red *r4
+	cmp r5, r1
+	jmp *r3
+	sub r5, *r7
+	bne *r1
+	not *r6
+L31:	red r3
+	add X9, r1
+; comment line of the generated program
+	.string "wsqib"
+	stop
+; comment line of the generated program
+	clr *r2
+L32:	sub L144, r6
+	clr r3
+	inc r4
+	dec *r4
+	stop
+	bne L112
+
+	m2
+L33:	jsr L40
+	clr r5
+	jmp *r1
+	.data -94, -41, -79, 298
+	red L54
+L34:	stop
+	bne *r2
+	dec *r6
+; comment line of the generated program
+	m4
+	.data -379, 331, 370, 438
+	mov L172, *r5
+	clr L198
+L35:	inc *r0
+	jmp *r1
+	jsr L107
+	m7
+	sub r7, *r5
+	.data 96, 497, -450, 445
+L36:	red r4
+
+	add r4, *r7
+
+	sub *r3, r0
+	prn *r7
+
+	cmp L30, *r4
+	bne L127
+L37:	bne *r6
+	mov r5, *r6
+	sub L67, L62
+; comment line of the generated program
+	sub *r4, *r1
+	red r1
+L38:	lea L15, L155
+	not *r4
+	add r4, L52
+; comment line of the generated program
+	inc r3
+	inc r2
+	red *r4
+L39:	clr L198
+	m1
+	clr *r3
+	not *r5
+	.string "knvuyesve"
+
+	.data -40, 287, -298
+L40:	prn #-55
+	prn *r5
+	rts
+
+	stop
+	not L76
+	dec *r6
+
+L41:	.data -212
+
+	bne *r2
+; comment line of the generated program
+	clr L30
+	.string "nmjkggt"
+	add L58, L153
+	add *r7, r5
+L42:	.data 218, 338, 491, 312
+	cmp r1, r3
+	jmp *r7
+
+	dec r7
+	m0
+	m5
+	bne *r1
+	m5
+; comment line of the generated program
+	m0
+L43:	add #-78, L60
+	cmp L37, r1
+	bne *r3
+	bne *r1
+	add L105, *r0
+	lea L80, *r4
+L44:	rts
+	sub #2, L20
+	.data 344, 250, -83, 300, -122, -300, -330, 16
+	red r0
+	red L44
+L45:	rts
+	cmp r4, r2
+	mov r1, r6
+	inc *r2
+	m2
+	.string "miyipprg"
+	m6
+	rts
+
+L46:	bne *r3
+	red L193
+	prn L169
+; comment line of the generated program
+	inc *r2
+	m2
+	.data -268, 197, 303
+; comment line of the generated program
+L47:	dec *r0
+	stop
+	.data -297, 126
+; comment line of the generated program
+	m6
+; comment line of the generated program
+	mov L100, *r5
+; comment line of the generated program
+	clr r5
+	dec r1
+L48:	.data 18, -483, -296, 129, 126, 185, -390, 39
+	.data -79, -112, 226, 72
+	jmp *r2
+	not r1
+	clr *r5
+L49:	dec L95
+
+	jsr L15
+; comment line of the generated program
+	sub X1, *r3
+	.string "mecczlgpwpquqzq"
+	clr L46
+	.data -481, -181, -99, 338, -308
+L50:	cmp *r7, #87
+	jsr *r5
+	lea L148, r5
+; comment line of the generated program
+	clr *r4
+	sub r5, L125
+; comment line of the generated program
+L51:	inc *r6
+; comment line of the generated program
+	m0
+; comment line of the generated program
+	sub L143, *r5
+	cmp #-5, #-46
+	m3
+	.data -169, -294, 2, 255, -369, -453, 433, -265
+	prn L5
+	jsr *r7
+L52:	.data 234, 90, -124, -97, -110, 399
+	.data -270, 384, 47, -30
+; comment line of the generated program
+	inc *r2
+	jmp L177
+	jmp *r2
+	m1
+L53:	jsr *r7
+	jmp *r1
+	.string "cyncshyjoqxdpy"
+; comment line of the generated program
+	inc L150
+	lea L50, *r7
+	lea L102, r0
+L54:	add *r6, L190
+	sub L79, *r2
+	prn *r3
+	.data -75
+
+	prn *r2
+L55:	not *r6
+	add L11, r2
+	bne *r0
+	prn r6
+	not r4
+	not r5
+
+	m4
+
+L56:	bne L116
+	jsr L20
+	.string "orzfsvppwvmyjzd"
+	.data -491, 273, 94, -418, -52, -373, -315, 327
+	dec L178
+L57:	rts
+	cmp *r6, L72
+	.string "zguefknocew"
+	stop
+	sub *r0, L58
+	cmp r4, #78
+L58:	.data -341, -84
+	stop
+; comment line of the generated program
+	m3
+	stop
+	clr *r6
+	m2
+	m2
+; comment line of the generated program
+	not L117
+L59:	not r7
+	clr *r2
+; comment line of the generated program
+	lea L98, *r2
+
+	bne *r7
+	rts
+	clr L159
+L60:	red r1
+	jsr *r2
+	lea L134, *r3
+	jmp *r6
+	inc *r0
+
+	.data 59, 19, -184
+; comment line of the generated program
+L61:	add L20, *r1
+	add r3, *r6
+
+	cmp #77, r1
+; comment line of the generated program
+	.string "bodjknrfjupo"
+	inc *r7
+L62:	.data -204
+	stop
+
+	sub L114, r7
+	not r4
+	jsr *r2
+	.data 307, 33
+L63:	jmp *r2
+	jmp L176
+	red r3
+	sub *r5, *r6
+	.data -408, 476, 236, -325
+L64:	red *r1
+	.string "uv"
+	mov X8, L85
+	red *r3
+	sub r1, r1
+	clr *r0
+L65:	clr L80
+	stop
+	lea L1, L56
+; comment line of the generated program
+	add *r0, r7
+; comment line of the generated program
+	stop
+L66:	stop
+; comment line of the generated program
+	sub r2, *r5
+	not r4
+	.data 103
+	clr r7
+; comment line of the generated program
+	dec r0
+L67:	.string "yiipzkmkrkziobijl"
+	jsr *r6
+	lea L186, L41
+	.string "tlgjoitpbrojxanjstlwg"
+	m3
+	not *r5
+L68:	jmp *r7
+; comment line of the generated program
+	bne *r4
+	cmp r4, *r4
+	sub r5, r3
+	not *r5
+	bne *r5
+; comment line of the generated program
+L69:	stop
+	.data 29, -481, 251, 257, -5
+	inc L58
+	.data -53, -316, 202, -39
+; comment line of the generated program
+	clr L77
+; comment line of the generated program
+L70:	rts
+	.data -352, 69, 484, 360, -190, 115, -297
+	.string ""
+	add *r5, L121
+; comment line of the generated program
+	add *r1, L149
+	m2
+	not *r5
+L71:	not r2
+	add #51, r4
+; comment line of the generated program
+	bne *r5
+
+	lea L66, r6
+	rts
+L72:	cmp L126, *r1
+	mov *r5, L22
+; comment line of the generated program
+	clr *r5
+; comment line of the generated program
+	prn *r5
+	red r2
+	.data 251, 267, -116, 454, -444, 26
+L73:	.data 305, -479, 98, -493, -493, 318, 335
+	clr *r0
+	jsr *r5
+	prn L49
+	clr r4
+L74:	.data 273, -343, 100, 432, -481
+	.data -108
+	prn r1
+	bne L171
+	add L43, L190
+	bne *r3
+L75:	mov #16, L28
+	m1
+; comment line of the generated program
+	rts
+	m4
+	stop
+	lea L3, r6
+	jmp L177
+L76:	sub #53, L53
+	.data 189, -196, -113, -390, 133, -487
+
+	inc *r6
+	lea L28, r0
+	clr r3
+
+	jsr L135
+L77:	sub r3, *r0
+	prn L180
+	bne *r5
+	rts
+	.string "bpahuzaqwjk"
+
+L78:	.data -490, -266, -18, 478
+
+	.string "vnnjuniscumxxos"
+	dec L6
+
+	sub L29, r6
+	sub *r3, *r7
+	prn #58
+	m1
+L79:	jsr *r4
+	.string "gnzieh"
+	sub #52, r5
+	jmp *r7
+	add *r1, *r7
+	m7
+L80:	sub r5, *r7
+	not *r2
+	inc r7
+	jmp L84
+	sub r0, *r3
+	stop
+
+	m6
+
+L81:	sub *r5, X1
+	rts
+	add L148, *r0
+	jsr L125
+	prn L118
+	.string "ijwzrgbvnvjvgjpyfug"
+L82:	jmp *r3
+	jsr *r6
+	m4
+	rts
+	clr *r7
+	.data 28, -497, -232
+
+L83:	.string "lhpdihzjfomdldgh"
+	clr *r4
+	sub #48, X6
+; comment line of the generated program
+	dec L177
+	add *r0, *r2
+	.data -288, 322, -339, -122, -357, -208, -280, -79
+
+L84:	clr *r7
+	add r0, L88
+	sub L29, *r2
+; comment line of the generated program
+	.string "wkshfpya"
+	add r3, *r7
+L85:	.string "yfvvq"
+	bne L87
+	not *r5
+
+	red *r1
+	m3
+	m6
+	.data -8
+	.string "igmjqrthhjf"
+L86:	cmp r7, *r6
+	.data 185, 489, 436, -180, 361
+	.data -123, -75
+	jmp *r4
+	not *r3
+L87:	jmp L55
+	.data -370, -108, -23, 99, -3
+
+	jmp L182
+	dec r4
+	stop
+	cmp *r5, r0
+L88:	jsr *r2
+	add *r3, *r7
+	jsr L144
+	jsr *r1
+	jsr *r3
+L89:	mov r4, r0
+
+	.data 166, 304, 44, 454, -26, -483, 325
+	sub #44, L96
+	.data -413, -490, -5
+
+	not r7
+	not r7
+L90:	red X2
+; comment line of the generated program
+	m6
+; comment line of the generated program
+	m4
+
+	bne *r4
+	rts
+	add L17, *r0
+	sub L40, *r3
+L91:	jsr *r6
+
+	inc L122
+	prn *r4
+	red *r2
+	red L139
+	stop
+L92:	stop
+	bne *r2
+	m0
+; comment line of the generated program
+	bne *r1
+	rts
+	dec *r2
+L93:	stop
+	mov r2, *r3
+	jsr *r0
+	bne L23
+	lea L115, r7
+	bne *r2
+L94:	jmp *r7
+	dec r3
+	.data 112
+	clr r6
+	cmp #-66, #30
+L95:	red *r0
+	.data 423, -52, 131, 0, 240, -464, -55, -181
+; comment line of the generated program
+	dec *r1
+	inc *r2
+
+	mov X6, r5
+	prn *r6
+L96:	.data -144, -389, -128, 47, 228, -357, 328
+	clr L179
+	sub #84, r1
+	m0
+	rts
+	clr L52
+L97:	inc *r6
+	not *r6
+	jmp *r3
+	m5
+	dec r5
+	.data 187, -221, 128, -197, 434, -421
+	stop
+L98:	add L66, *r7
+; comment line of the generated program
+	stop
+	dec r1
+	jmp *r1
+	lea L55, *r3
+	m7
+L99:	sub #83, *r3
+	inc r4
+	.string "xlqzdn"
+; comment line of the generated program
+	prn r1
+	.data -373, -284, -326, 9, -123, -55, 192
+	inc X2
+L100:	.data -57, -269, 213, -66, 266, -361
+	dec r5
+
+	stop
+	jsr *r7
+; comment line of the generated program
+	mov L77, r7
+	lea L14, L157
+L101:	rts
+	sub L191, L91
+	m5
+	jmp *r3
+	add #22, r1
+	bne *r5
+L102:	.data 106
+	prn #25
+; comment line of the generated program
+	.data -479, -50, -220, 100, 448, -332, -61
+	m4
+	sub *r2, L171
+	rts
+	add #-41, *r4
+L103:	add L194, r6
+	m2
+	add *r6, L154
+	dec r1
+	.data -190, 292, 453
+	not L130
+; comment line of the generated program
+L104:	lea L189, r4
+	.data 387, -343, -256, 380, 482, 372
+	red r3
+	not *r1
+	cmp *r5, r5
+	cmp *r2, L100
+L105:	stop
+	cmp L105, *r4
+	mov *r3, L83
+; comment line of the generated program
+	m2
+	mov L131, r6
+; comment line of the generated program
+	sub X0, r1
+
+L106:	jsr *r0
+	sub #84, r1
+	.data 49, -389, -237, -119
+	bne *r4
+	bne *r6
+	sub r3, *r0
+L107:	jmp L143
+	lea L132, *r2
+; comment line of the generated program
+	jsr *r4
+	sub *r2, r3
+	not r2
+L108:	.data 383, 473, -278, 296, -83, -476, -315
+; comment line of the generated program
+	m6
+; comment line of the generated program
+	bne *r7
+	m7
+	red r7
+	dec r4
+	add L194, *r1
+	stop
+L109:	bne *r3
+	.data -73, -89, -424, 359
+	red *r7
+	stop
+	.string "witfxwwdjexzbljz"
+
+L110:	.data -11, -250, 169
+	.string "cfnmfhxjiephqmxrewrtx"
+	cmp L180, X3
+	.data -400, -394
+	m2
+	m2
+
+	lea L125, r6
+
+	m1
+	m4
+
+	.data -52
+L111:	add L100, *r4
+	m2
+	m5
+
+	red L125
+	clr L73
+	.string "sekuutoi"
+
+	.data -310
+L112:	jmp L17
+
+	rts
+	.data -396, -92, -19, -34, -417
+	inc L61
+	stop
+	m0
+	lea L175, X6
+L113:	.data -90, -448, 392, 151
+; comment line of the generated program
+	mov #-9, r0
+	mov *r3, *r1
+; comment line of the generated program
+	stop
+	not *r5
+L114:	mov r0, L61
+; comment line of the generated program
+	.string "zmhjwbyujiaikulif"
+	cmp L45, L63
+; comment line of the generated program
+	bne *r5
+	mov #-54, L75
+	m0
+	clr L142
+L115:	.data 455, -263, 392
+	clr *r0
+	mov *r4, L163
+	sub *r2, r1
+	red L174
+L116:	.data -473, 260
+	m2
+	dec L46
+	.data -392, -388, -265, 381, 296, 58, -367
+	m2
+
+	not r0
+	red r0
+	lea L88, *r0
+L117:	clr *r4
+	inc *r1
+	m6
+	stop
+
+	jmp *r2
+	.string "ncadirimaftaghwpli"
+; comment line of the generated program
+L118:	prn L78
+	jmp *r0
+; comment line of the generated program
+	lea L154, X4
+	.data 286, 171, 280
+; comment line of the generated program
+	dec *r7
+
+	m1
+	mov #2, *r5
+L119:	jsr *r5
+; comment line of the generated program
+	m7
+	mov r0, L199
+
+	inc r5
+	red X2
+	m2
+	.data 276, -338, 122, -122
+L120:	lea X2, L75
+	bne *r7
+	.string "tcwxfszhklgdhuqjtnitroo"
+	m1
+	not X8
+	.data 265, 251, 60, -211, -460, 137, 71, -195
+; comment line of the generated program
+	sub r2, *r7
+L121:	.string "burchwoluftwuvranqwcq"
+	cmp *r1, L182
+	jsr *r0
+	cmp L172, *r5
+	.data -90, 483
+	.string "jzchlouea"
+L122:	rts
+	lea L111, r3
+	sub #65, L69
+	prn #53
+	.data -438, 13, -180
+L123:	stop
+	bne *r5
+; comment line of the generated program
+	add r2, L137
+	bne *r6
+	cmp *r0, #-2
+; comment line of the generated program
+	bne *r6
+L124:	.data -390, 247, 390, 135, -67
+	not *r3
+	add *r5, *r2
+	cmp #-28, r2
+	stop
+L125:	prn r4
+	jsr *r2
+
+	mov r2, r4
+	cmp L18, *r0
+
+	mov r1, L95
+	m0
+
+	inc X9
+	m4
+L126:	prn #-88
+	rts
+	.data -116, -204, 326, 40, -412, -196
+	clr L143
+	rts
+L127:	.data 195, 11, 184, -125, 448
+	dec r1
+	clr *r4
+	not r1
+	stop
+
+	stop
+L128:	lea L53, *r2
+	dec L103
+	dec *r7
+	sub L124, r1
+	cmp L78, #66
+; comment line of the generated program
+L129:	add r3, r7
+	inc *r3
+
+	m1
+	inc r0
+	bne *r6
+	m5
+	m4
+	inc *r0
+	add *r5, r6
+L130:	stop
+	stop
+	.string "kgpkmr"
+	red *r4
+	prn #9
+; comment line of the generated program
+L131:	.data -42, 86, 309
+	inc r7
+	sub #14, L133
+	stop
+	add #-45, *r2
+	inc r2
+L132:	clr r7
+	.data -154, -146, 241, 323, -153, 180, 355
+
+	m3
+	.string "siwrnyewiksycxw"
+	jmp *r3
+	lea L9, *r4
+L133:	add #28, L80
+; comment line of the generated program
+	prn L108
+	jmp L80
+; comment line of the generated program
+	red *r4
+	.string "wvnf"
+; comment line of the generated program
+	inc L24
+; comment line of the generated program
+L134:	mov #67, L190
+	rts
+; comment line of the generated program
+	dec r2
+	jsr *r5
+; comment line of the generated program
+	dec r5
+
+L135:	.string "runtobfuvmii"
+	stop
+	cmp r6, *r5
+	mov #100, r0
+	.data -174, 32
+	inc *r1
+
+L136:	.string "salmsytljlkpr"
+	.string "ystzgjplqqpqinmgziahu"
+	.string "qcakzybcfpmgppfdujch"
+	jsr *r4
+
+	red r0
+L137:	.data -186, -76, -28, -58, 206
+	jsr *r2
+	not L100
+	red L102
+	stop
+	jsr *r3
+L138:	mov r3, *r2
+	.data 128, 338, -384, -239, -457
+	.data -26, -388, -331, -213, 495, -371, 274
+	stop
+	cmp r6, L128
+
+L139:	mov r6, r7
+	jsr L58
+	.data 110, -225, 377, 82, -42, -310, 172
+
+	prn r1
+
+	lea L171, *r0
+; comment line of the generated program
+	mov *r7, r1
+L140:	.string "zmqxfwrrdgdtnuiuafpz"
+	.string "jazlovesjtvf"
+	sub L180, *r5
+	rts
+	m7
+	stop
+	dec r2
+L141:	lea X2, *r3
+	.string "tugpdmltpyoffdmqbaf"
+	jmp X3
+	add *r2, *r2
+	sub #69, L173
+; comment line of the generated program
+L142:	.data 457, -465, -488, 235, -105, -420
+	dec r1
+	.data 451, 166, 237, -447, 182, -426, 136
+	m6
+	add #-7, L174
+	rts
+	red r4
+; comment line of the generated program
+L143:	not r7
+	prn r5
+	.data -194, 267, 290, -96, -308, 235, 298
+	.data -346, -67, -159
+	red *r3
+L144:	cmp #-42, L110
+	m4
+	m0
+	prn r0
+	dec L38
+	not *r1
+
+	not *r6
+
+	jmp L0
+	m5
+L145:	.data 53, -166, 434, 324, -136, -190, 465, 285
+	red X4
+	clr r2
+	jmp *r2
+	mov *r4, r2
+L146:	.string "fpsvsudndnywcakyaiiwzv"
+	not *r0
+
+	red r0
+	stop
+	.data 73, 43, 392
+; comment line of the generated program
+	stop
+L147:	not *r2
+	add *r7, L125
+	jsr L37
+
+	rts
+	m0
+
+	jsr *r7
+L148:	clr r0
+	cmp L42, r1
+	mov #79, L29
+	add *r4, *r6
+	m3
+	.string "k"
+	.data -449, -152, -141, 495, 269
+L149:	bne L160
+	.data -62, -401, 71, 450, 75, -472
+	inc L1
+
+	red L157
+
+	dec *r7
+	m7
+L150:	inc L1
+	m0
+	bne *r5
+	inc *r1
+	prn X4
+	cmp L132, #-66
+	not L174
+L151:	clr L160
+	lea L77, *r7
+	rts
+	clr L16
+	dec L161
+L152:	prn L118
+	sub r2, r2
+	mov *r2, r0
+	.data -304, -61, -185, 138, 234, 133
+	inc L155
+	jsr *r1
+L153:	clr r4
+
+	mov #-59, *r6
+	.string "cisaqi"
+
+	m2
+	.data 2, -180, -331, 341, 173, -4, 92, 460
+
+	jmp *r4
+L154:	lea L30, r0
+	cmp L90, L35
+	.string "fvhlbteja"
+	lea X4, *r6
+	add #-8, *r4
+
+	.data -412, -171, -132
+L155:	stop
+	prn L192
+	dec *r7
+	m3
+	m5
+
+	jsr *r4
+	rts
+L156:	bne L196
+	m5
+	jmp *r5
+	sub L42, *r1
+	inc *r5
+	not r3
+	.data 256, 334, -435
+L157:	rts
+	jmp *r7
+	stop
+	.string "ocdlbnigfx"
+	clr X9
+L158:	bne L60
+; comment line of the generated program
+	prn *r3
+	.string "jyxnemejqthkfvtc"
+	inc L18
+	red r1
+; comment line of the generated program
+	rts
+; comment line of the generated program
+L159:	stop
+	stop
+	inc r1
+	.data 128, 496, 236, 380, -421, 61, -283, -432
+	sub L158, r4
+L160:	add *r2, r5
+	stop
+	dec r6
+	lea L49, r4
+	add #26, r2
+	.data 41, -196
+L161:	prn #74
+	m7
+; comment line of the generated program
+	stop
+	sub L108, r6
+	jmp L23
+	bne *r6
+	m1
+	red r1
+L162:	add #30, L122
+	jsr *r6
+	.string "ttnrkekhplt"
+	.data 379, -222
+	prn *r6
+L163:	prn L113
+	cmp r5, #98
+	.data 157, -148
+; comment line of the generated program
+	inc r6
+	lea L144, *r5
+	m1
+	stop
+L164:	mov #26, r4
+	sub #-65, L137
+	.data 356, 21, 279, 77, 102
+
+	lea L73, r0
+	jsr *r2
+
+L165:	rts
+	stop
+; comment line of the generated program
+	.data -457, 466, 474, -496
+	clr *r4
+	.data 490, -490, 70, 328, -239, -470, 395
+	cmp r5, #60
+L166:	rts
+	jmp L36
+	rts
+	dec r1
+
+	prn #-9
+L167:	add X5, r4
+	cmp r7, *r5
+	red *r2
+; comment line of the generated program
+	lea L32, *r4
+; comment line of the generated program
+	sub L174, L94
+
+	red r0
+L168:	mov #-33, *r5
+	stop
+
+	clr L101
+	jsr *r7
+	dec r5
+	m6
+L169:	sub *r2, *r5
+	rts
+
+	m1
+	m2
+	rts
+	.string "uzrmfgryzzijpndlsp"
+	.data -498, -50, 205, 448, 151, 60, 294
+	.data -176, -98, -265, 127, 169
+L170:	.string "wkwfxsscblegv"
+
+	mov #-33, *r2
+	.data -297, -310, 75, -456, -161
+; comment line of the generated program
+	.string "vjuruacssf"
+	prn r6
+
+L171:	jsr *r3
+	.data 113, 383, 183, -349
+	inc *r4
+	jsr *r6
+	lea X0, L9
+	not L44
+
+L172:	jmp *r0
+	prn #58
+	prn #4
+
+	m5
+; comment line of the generated program
+	stop
+	inc r7
+L173:	jsr *r4
+	add r1, X0
+	inc L74
+	lea L46, *r5
+
+	m7
+	rts
+	rts
+L174:	sub #77, L66
+	inc *r4
+	prn #56
+; comment line of the generated program
+	.data 488, 489, -384, -174, -229
+	jsr *r7
+L175:	.data -396, 396, -348, 327
+; comment line of the generated program
+	m7
+	.data -296, 220, -180, 40, 273, -106, -65, -424
+	.string "pevngmlekegtnsplsgw"
+
+	stop
+	not r7
+	add #-46, L53
+; comment line of the generated program
+L176:	clr r7
+	bne *r5
+	.string "uzgwkxwvy"
+	.data 49, -331
+; comment line of the generated program
+	sub r7, L12
+L177:	.data 24, -307
+	.data 419, -10, 83, -251, 0, 373
+; comment line of the generated program
+	.data 207, 171, -172, -463
+	.string "ml"
+; comment line of the generated program
+	prn *r5
+; comment line of the generated program
+	.data 280, -367, 53, 1, -488, -210
+L178:	not L13
+	jsr L78
+	sub L57, L160
+
+	.string "mnhlhbssdev"
+	bne L130
+L179:	.data 235, -485, 173, -479, 329, 483, 96
+	red r5
+	jsr *r1
+	m7
+	m6
+	lea L186, r6
+
+	.data -442
+	.data -281, 40, 317, 492, -18, -50
+
+L180:	.data 67, 329, 206, -92, 347, -206, 377, 6
+; comment line of the generated program
+	cmp L65, r5
+	.data 118, 268, -434, -464, -40, -312
+	.data 422, 32
+; comment line of the generated program
+	bne *r1
+	dec *r1
+L181:	jsr *r4
+	m5
+	red L21
+	cmp #-7, #-42
+	add L97, L116
+	.string "g"
+	m5
+L182:	.data -171, -118, 294, 450, -424, -1, 297
+	red *r7
+	dec *r2
+	rts
+	lea L141, L153
+	dec L83
+L183:	.string "rpkvorobbqqywjog"
+	.string "sovylddeyowualfb"
+	jmp L156
+	not r0
+	dec r7
+L184:	jmp *r0
+	clr L80
+; comment line of the generated program
+	stop
+	not L10
+	bne *r2
+	bne *r1
+L185:	inc L171
+	lea X3, *r1
+	m7
+	add L96, r4
+; comment line of the generated program
+	not L192
+	lea L173, L11
+	m1
+L186:	rts
+	clr *r6
+
+	jmp X0
+	m4
+	m6
+	clr r2
+; comment line of the generated program
+	prn L68
+	m3
+	.data 227, 73, -342, -355, 329, 120
+L187:	.data -397, -130, -104, -53, 75
+; comment line of the generated program
+	inc L74
+	jsr *r0
+	red r0
+	stop
+L188:	bne *r5
+	cmp r7, #87
+	cmp r6, L108
+	.data 104
+	mov L111, r1
+	add #2, r1
+L189:	cmp *r5, #35
+
+	m4
+	not *r0
+	mov X5, *r3
+	m5
+	.data -275, -207, -236, 480, 446, -191, -369
+	inc r5
+L190:	bne *r5
+	bne *r5
+	prn #46
+; comment line of the generated program
+	mov #-92, *r3
+	clr r3
+	jsr L129
+	m2
+; comment line of the generated program
+L191:	not *r4
+; comment line of the generated program
+	not r4
+; comment line of the generated program
+	red *r0
+	sub *r0, *r7
+	.string "dmsqqmqgcw"
+L192:	.string "hxztmozpmqwul"
+	bne L130
+	.data -407, -52, -147, -279, -432, 358, 327
+	.data 152, -85, -466, -486, -74
+; comment line of the generated program
+	.data -422, -133, 68, 192
+	add r6, r0
+L193:	jmp *r4
+; comment line of the generated program
+	prn X6
+	prn r2
+	red *r5
+	sub #30, L190
+
+L194:	sub r2, r0
+
+	.data 450, -428, 388, -491, -465
+	.data 330, 155, 500
+; comment line of the generated program
+	stop
+	clr *r4
+	lea L93, *r4
+L195:	add *r4, r1
+	prn #29
+	.data -422, 313, -244, 327, 7
+	.data 284, 73
+	.string "asvfzrijeoypsseptvxqw"
+L196:	jsr X6
+
+	prn r3
+	.string "udnwdppbspfrgc"
+
+	mov r2, r5
+	prn L123
+	.string "kfpqlgqifuwmgbk"
+L197:	not L66
+
+	add r5, L120
+	.data 319, 388, -26, -403, -364, -343
+	clr r1
+	rts
+L198:	not *r7
+	.data -73, 112, 250, 296, 233, 373
+; comment line of the generated program
+	.string ""
+	bne *r3
+	prn r0
+	red r0
+L199:	sub L156, r5
+; comment line of the generated program
+	m5
+	jmp L130
+	jsr *r3
+
+	mov r7, L62
+	cmp #74, r4
+.entry L0
+.entry L20
+.entry L40
+.entry L60
+.entry L80
+.entry L100
+.entry L120
+.entry L140
+.entry L160
+.entry L180
@@ -0,0 +1,691 @@
+; generated program seed 3 words 1994
+.extern X0
+.extern X1
+.extern X2
+.extern X3
+.extern X4
+.extern X5
+.extern X6
+.extern X7
+.extern X8
+.extern X9
+macr m0
+	prn r2
+	dec *r7
+	cmp r4, #99
+endmacr
+macr m1
+	inc r0
+endmacr
+macr m2
+	red r3
+	jsr *r3
+endmacr
+macr m3
+	inc r4
+	not r4
+endmacr
+macr m4
+	dec r5
+	jsr *r7
+	dec *r1
+endmacr
+macr m5
+	mov *r1, *r1
+	mov r0, *r2
+endmacr
+macr m6
+	mov r7, r0
+endmacr
+macr m7
+	bne *r1
+	bne *r6
+	red r7
+endmacr
+macr m8
+	bne *r6
+endmacr
+macr m9
+	stop
+	sub #53, *r2
+	sub r6, *r2
+endmacr
+macr m10
+	mov *r2, r2
+endmacr
+macr m11
+	clr *r1
+	prn #-49
+endmacr
+macr m12
+	mov #-95, r2
+	jmp *r0
+endmacr
+macr m13
+	not *r0
+	bne *r4
+endmacr
+macr m14
+	not r3
+endmacr
+macr m15
+	not *r6
+	mov r0, *r7
+	jsr *r6
+endmacr
+macr m16
+	prn #-99
+	inc *r7
+	red *r7
+endmacr
+macr m17
+	bne *r1
+	clr r0
+endmacr
+macr m18
+	prn *r1
+	bne *r1
+endmacr
+macr m19
+	jsr *r7
+	dec r5
+	red *r4
+endmacr
+L0:	.string "maqtyzwswxzyqfjx"
+	bne *r7
+	m0
+L1:	mov r7, r2
+L2:	cmp *r7, r2
+	m5
+; comment line of the generated program
+	stop
+L3:	jsr *r2
+L4:	sub #34, r4
+	m8
+	sub *r3, L147
+L5:	.data 253, -33, -114, -117
+L6:	add *r3, r4
+	m7
+	m8
+; comment line of the generated program
+	m4
+; comment line of the generated program
+	jmp *r6
+L7:	add #30, r0
+	m8
+L8:	add #10, r0
+	rts
+L9:	rts
+L10:	bne *r0
+	jsr *r1
+	m6
+
+L11:	rts
+L12:	.string "lngq"
+	rts
+L13:	sub r6, L178
+	m12
+L14:	.string "xcxitayymssmhigyxtjj"
+	cmp *r7, L108
+	m6
+
+	m2
+L15:	jsr *r5
+L16:	inc r5
+	m9
+	m8
+	cmp L19, r3
+L17:	add r5, r5
+L18:	jmp L68
+	m16
+	.string "cpqfwwubdehjuexs"
+L19:	rts
+	m16
+; comment line of the generated program
+	m1
+	m9
+	m18
+L20:	.data 419, -259, -201, -73, 425
+
+	m3
+	bne *r7
+L21:	jmp *r6
+; comment line of the generated program
+L22:	jsr *r1
+	m18
+	m19
+	m17
+
+	prn r5
+L23:	.data 183, -299, 267, -408, -75, -274, -68, 73
+
+L24:	add #-33, *r3
+	m19
+L25:	.string "tecxonlb"
+	jmp *r4
+	m9
+L26:	.data 239, -250
+	m7
+L27:	.data -275, -386, -463, -438, -261, -393, -361, -20
+	m19
+	.string "rhopafofsjext"
+L28:	.data -420
+
+L29:	add r4, r2
+	m8
+	m4
+	.string ""
+	m7
+L30:	inc L110
+	m12
+L31:	.string "uhjwsyreotuvehayarqt"
+	m4
+	lea L66, r2
+	m15
+L32:	jmp *r4
+L33:	inc *r3
+	bne *r6
+L34:	.data 399, -180, -400
+
+	m19
+L35:	.data 409, -64, 453, -344, -453, -236
+	cmp L4, r7
+; comment line of the generated program
+L36:	prn *r3
+L37:	.data 468
+	.string "e"
+	m15
+	m10
+	m19
+; comment line of the generated program
+	m3
+	m16
+; comment line of the generated program
+L38:	not *r4
+L39:	add #-98, L163
+	add r2, L111
+; comment line of the generated program
+	m14
+L40:	mov *r6, *r1
+
+L41:	jsr *r5
+	.data 97, 274, 195, -336, 428
+L42:	clr r7
+L43:	lea X5, L84
+
+	jmp *r1
+	m12
+
+	m14
+L44:	jmp L5
+	m10
+; comment line of the generated program
+L45:	.string "iheqmy"
+	jsr *r2
+L46:	.data -115, 309
+	m13
+L47:	inc L164
+	.string "sbbvqkibdfqvp"
+
+L48:	cmp r6, r2
+	m11
+; comment line of the generated program
+	m11
+
+L49:	lea L64, r0
+
+L50:	bne *r2
+	m16
+	stop
+
+L51:	prn X5
+L52:	not r7
+	m11
+	m9
+	dec r3
+L53:	add *r2, r5
+L54:	jmp *r0
+	.string "bfqo"
+L55:	prn r3
+L56:	.data -32, -372, 345, -31
+; comment line of the generated program
+	.string "nktlojydatyf"
+L57:	bne *r5
+; comment line of the generated program
+L58:	sub #-73, r6
+	rts
+; comment line of the generated program
+L59:	cmp #-11, *r1
+	m9
+	m8
+	m8
+	m4
+; comment line of the generated program
+	m14
+L60:	sub #-22, r5
+	m7
+	jmp *r1
+L61:	cmp *r6, r6
+; comment line of the generated program
+L62:	.data -320, 153, -73, 158, -325, 111, 342, -218
+	dec L62
+	m2
+L63:	jsr *r5
+; comment line of the generated program
+	m18
+
+L64:	.string "rdxbwcvnuaupsgnt"
+	.string "pcpxwksuwdgptukr"
+L65:	prn #13
+	m4
+L66:	cmp #-76, L13
+	m12
+	red X5
+L67:	.data -455, 377, 474, 202, -306, -427, -235, 419
+L68:	not L18
+
+	dec L168
+
+L69:	not r6
+L70:	prn *r4
+; comment line of the generated program
+	bne *r7
+L71:	prn L124
+L72:	lea L124, *r5
+	red r2
+L73:	rts
+L74:	.string "otyajpkng"
+L75:	inc L149
+	not *r5
+L76:	.data 276, 151, -58, 383, 349, 3
+L77:	.data -261, 491, -401, 408, 279
+
+	m5
+	jsr L113
+L78:	.string "ntuywqtf"
+L79:	cmp L58, L109
+	m15
+
+	jmp L197
+	m5
+L80:	.data -59, 481, 279
+	m18
+	m17
+L81:	.string "honnboktdhxcl"
+; comment line of the generated program
+	m4
+	m17
+
+	.string "lfpmvighwknjgcsvuaavn"
+	m1
+	m19
+L82:	inc L120
+L83:	.data -127, 326, 60, 129, -474, 420, 22, 83
+
+	add *r5, r5
+L84:	.data -32, -481, 30, -234, -457, 16, 379
+
+L85:	red r6
+	m10
+	.data 140, -399, 399, 227, 405, 478, 277
+L86:	stop
+L87:	.data 187, -227
+	mov L158, r0
+L88:	.data 405, 170, 60, -217, 442, 445, 436
+; comment line of the generated program
+L89:	rts
+	stop
+L90:	rts
+
+L91:	red r0
+	red *r2
+L92:	inc L31
+
+L93:	rts
+	m9
+	dec L112
+	m0
+L94:	inc r6
+	m16
+L95:	cmp X1, r0
+; comment line of the generated program
+	m12
+	mov r0, L122
+L96:	.string "kjrbhcccjixddufb"
+L97:	mov L77, L44
+; comment line of the generated program
+	cmp *r5, r0
+; comment line of the generated program
+	m1
+	m3
+L98:	cmp L0, r7
+L99:	inc *r7
+	m15
+
+	m19
+L100:	sub r6, r6
+
+	m17
+	bne *r4
+
+L101:	bne *r3
+L102:	cmp *r2, #-46
+	.string "vraruihtx"
+
+	m3
+	m19
+	m8
+L103:	.data -242, -248, -246
+; comment line of the generated program
+L104:	.data 487, 262, 405, 304, 445, -103, 26
+	sub L126, *r6
+	m10
+	m0
+	m4
+	m17
+	m8
+L105:	.string "fnavbvqrigsayorgumh"
+	m8
+; comment line of the generated program
+L106:	stop
+	jmp *r6
+L107:	.string "wnycpmexitgnrqaixurvuoj"
+L108:	jsr *r1
+	not L37
+	m4
+
+	m19
+L109:	inc r7
+
+L110:	.data 427, 274
+	.data -460, -4, -47, -411, -103
+	m18
+
+L111:	cmp r7, *r1
+	m17
+; comment line of the generated program
+L112:	rts
+	prn L191
+	m0
+	m19
+	m3
+L113:	add #87, *r6
+	m15
+L114:	jsr *r7
+
+	m10
+	m6
+	m10
+	m10
+	m8
+
+	jsr L176
+	m14
+	m12
+	m14
+L115:	cmp #8, *r1
+	m2
+	m16
+L116:	.data -346
+	m2
+	.string "vkndygg"
+L117:	red r3
+
+L118:	prn r2
+	bne L16
+; comment line of the generated program
+L119:	bne L65
+L120:	stop
+	prn L86
+	m6
+L121:	jsr *r1
+L122:	sub #5, r2
+	m1
+; comment line of the generated program
+	m0
+	add r3, r7
+L123:	.string "tijdfdb"
+
+	m11
+	m13
+L124:	clr L7
+L125:	red r1
+	m15
+	.data 165, 78, 493
+; comment line of the generated program
+L126:	prn *r1
+; comment line of the generated program
+	m2
+; comment line of the generated program
+L127:	prn X3
+	m3
+	stop
+L128:	mov L105, *r6
+L129:	red *r5
+	jmp *r4
+L130:	lea L57, r1
+
+L131:	.data 121, 406
+	sub r1, L196
+
+	m0
+L132:	bne *r3
+	m9
+L133:	.string "qrvevcvussahjbllmifx"
+	add *r6, r2
+L134:	mov r6, *r1
+L135:	mov #20, L193
+	mov #-30, r2
+; comment line of the generated program
+L136:	clr r6
+
+L137:	sub L72, r0
+	m4
+	not L6
+L138:	prn *r1
+L139:	rts
+	m3
+
+	.string ""
+
+L140:	.string "zjkohloc"
+L141:	.data 482, 391, 250, -70, 463, 156
+
+	.data -47
+	m4
+
+L142:	not *r6
+	m17
+L143:	.string "hezwykvcahfrdxau"
+	.string "icjonfgtfiblev"
+	m15
+L144:	.string "pujtzweo"
+	m0
+	m11
+L145:	dec *r7
+; comment line of the generated program
+	lea L69, *r3
+L146:	.string "ud"
+; comment line of the generated program
+L147:	.string "vtgtoepum"
+	add r6, *r2
+L148:	stop
+; comment line of the generated program
+L149:	.string "xaotk"
+; comment line of the generated program
+	m10
+	m18
+
+L150:	jmp *r3
+	.data -330, 63
+L151:	red L191
+
+L152:	add r1, L39
+	m1
+	m1
+; comment line of the generated program
+	m3
+; comment line of the generated program
+	m14
+; comment line of the generated program
+	red r7
+L153:	mov L173, *r3
+; comment line of the generated program
+	m7
+L154:	add L10, L168
+	sub L33, r6
+L155:	prn L116
+	m9
+L156:	bne L183
+	sub *r3, L41
+
+L157:	.data 337, 411
+; comment line of the generated program
+L158:	add L139, *r4
+	inc r0
+L159:	.data 342, -348, -455, 138, 390, 458, -144
+L160:	prn #-82
+
+	sub L56, L111
+L161:	.string "ncpnimdx"
+; comment line of the generated program
+L162:	.data -81
+	inc X1
+L163:	prn #57
+	m2
+L164:	jmp L40
+	m0
+; comment line of the generated program
+	m17
+	dec r7
+; comment line of the generated program
+	m6
+	m10
+L165:	inc r0
+
+L166:	sub L64, *r4
+	m6
+	m18
+	m3
+
+	m0
+	m12
+; comment line of the generated program
+	.string "xueusy"
+	m11
+
+L167:	red r6
+L168:	clr r1
+; comment line of the generated program
+	m2
+; comment line of the generated program
+	m5
+	jsr L106
+L169:	.string "wmcgapfvcnpyqdinxiqvkbr"
+	m1
+L170:	rts
+	.data -232, -290, -24, -149, -359, -133, 410, -478
+L171:	.data 273, 375, 402, 370, -238, -417
+	m15
+L172:	jsr L22
+	m11
+	m11
+	m3
+	.data -490, 220
+
+	m0
+	m2
+L173:	lea L125, *r2
+
+	m10
+; comment line of the generated program
+	m9
+L174:	lea L58, r1
+L175:	prn r1
+	prn *r4
+
+	m10
+	m19
+	m2
+	m5
+	m2
+	m13
+	m3
+	m2
+L176:	.string "moukbzu"
+L177:	.data -52, 494, 88, 243, 430, 132, 383, -484
+; comment line of the generated program
+	.string "vpwlbxfgqnyffnumqfypyao"
+L178:	cmp L79, r3
+L179:	.string "bcbvnwcasxheqhrimpsb"
+	sub r7, L123
+L180:	bne *r5
+	m4
+
+	m11
+L181:	clr L11
+	m5
+	m15
+	stop
+
+	m9
+
+L182:	add L14, *r6
+L183:	stop
+	add #-53, *r7
+	m11
+
+L184:	.string "cllggdhlbcngnjrhzi"
+
+L185:	.data 352
+	m13
+	red L130
+L186:	.data 191
+L187:	.data 10, 102, -422, -489, -123, -199, 358, -234
+	m7
+	m3
+	not L45
+L188:	.string "gahpsinsdx"
+	m9
+; comment line of the generated program
+L189:	dec L121
+	m0
+	dec r7
+
+L190:	.data -230
+	m12
+L191:	.string "qtiglgkswxsdpzbieupfpx"
+	prn #26
+	m2
+L192:	mov L83, r5
+
+L193:	stop
+
+	dec L194
+	m1
+	m3
+; comment line of the generated program
+L194:	jsr *r1
+L195:	.data 374, 69, -475, 255, -199, 417
+	m4
+	lea L169, L48
+L196:	stop
+	m9
+L197:	.data 122
+
+	m7
+	m1
+	m17
+	.data -177, -445, 233, 199
+L198:	.data -70, -483, -266, -173, -175, -351, 315, -361
+L199:	not *r4
+.entry L0
+.entry L20
+.entry L40
+.entry L60
+.entry L80
+.entry L100
+.entry L120
+.entry L140
+.entry L160
+.entry L180
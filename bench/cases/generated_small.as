@@ -0,0 +1,386 @@
+; generated program seed 1 words 999
+.extern X0
+.extern X1
+.extern X2
+.extern X3
+.extern X4
+.extern X5
+.extern X6
+.extern X7
+.extern X8
+.extern X9
+macr m0
+	not r3
+	not *r4
+endmacr
+macr m1
+	red *r3
+endmacr
+macr m2
+	jsr *r4
+endmacr
+macr m3
+	prn #-39
+endmacr
+macr m4
+	not *r3
+	red r6
+endmacr
+macr m5
+	jsr *r0
+endmacr
+macr m6
+	not *r4
+endmacr
+macr m7
+	clr r2
+endmacr
+
+L0:	sub #55, *r3
+	m4
+	m0
+	clr L75
+; comment line of the generated program
+L1:	red r0
+L2:	inc r0
+L3:	inc *r7
+L4:	red *r0
+	.string "uckgqaun"
+L5:	clr r4
+	m0
+L6:	.data 500, -126, 432, 97, -101
+L7:	prn X3
+L8:	.data -262, 368
+	m5
+	clr L107
+	m2
+L9:	.data 479, -30, -467, -20, 253, 141
+L10:	.data -138, -59, 319, 284, 178
+L11:	add L88, *r2
+L12:	stop
+; comment line of the generated program
+	.string "gmme"
+	m0
+L13:	stop
+; comment line of the generated program
+L14:	.data 163, 357, -187, 385
+; comment line of the generated program
+L15:	rts
+L16:	.string "wbywzzrnitmxjqpfl"
+	m5
+	m0
+	inc r1
+L17:	jmp *r6
+L18:	.data -106, -168, 46, 192, 249, -98, -103
+
+L19:	stop
+L20:	clr r7
+
+	lea L48, r1
+L21:	bne *r2
+L22:	dec r1
+L23:	bne *r7
+L24:	dec *r4
+	m2
+
+L25:	bne *r6
+	m1
+	mov L107, L108
+L26:	red r5
+L27:	.string "rjgsckunkaehtviacz"
+; comment line of the generated program
+L28:	inc r7
+L29:	not r5
+	dec *r3
+L30:	inc r5
+L31:	.string "btstwpdfblqodtpsge"
+
+L32:	.string "wjuysqcvomtckgqzxuwklku"
+	m5
+L33:	.data -258, 80, -230, -46, -80, -222, 470, 351
+	.data 396, 112, 314, 207, -447, 449
+
+L34:	mov X7, L42
+L35:	.string ""
+	m4
+L36:	.string "cayatztxdo"
+L37:	sub L182, *r5
+; comment line of the generated program
+	add *r2, r0
+L38:	sub #-55, r4
+
+L39:	not L26
+L40:	.data 64
+
+L41:	cmp r1, r3
+	lea L30, *r3
+	m5
+L42:	rts
+	m2
+
+L43:	dec X6
+L44:	inc L188
+L45:	sub *r6, L176
+	rts
+L46:	red *r2
+L47:	.string "xtnainchgottpnvdotek"
+
+L48:	.string "oucviafidescfg"
+L49:	bne L61
+L50:	prn L47
+	add r3, *r2
+L51:	jmp *r1
+L52:	lea X6, L163
+L53:	mov r6, r2
+	m3
+L54:	stop
+	.data 320, -220, 43, 298, 345, -340
+L55:	jsr *r2
+L56:	inc r1
+	m7
+L57:	prn r3
+L58:	.data -237, 456, -483, 437, -145
+	.string "gifynpxhfri"
+L59:	jsr *r5
+L60:	.string "k"
+; comment line of the generated program
+L61:	jmp L130
+L62:	.data 164, 496, -405, -471, -58, -354
+	clr L151
+; comment line of the generated program
+L63:	bne *r7
+L64:	sub L133, L94
+
+L65:	clr r3
+	m4
+; comment line of the generated program
+L66:	stop
+	.string "vpqp"
+L67:	.data 246, 55, 217, 130
+; comment line of the generated program
+L68:	.data 398, 328, 476, -421, 37, 388
+L69:	not r2
+L70:	dec L45
+	mov *r2, *r3
+L71:	.data -459, -64
+	m5
+L72:	lea L74, L122
+L73:	.string "jymewyocolxqmbobtzhihp"
+L74:	lea L122, L80
+L75:	red r7
+; comment line of the generated program
+	clr X3
+L76:	lea L22, r5
+L77:	not *r3
+L78:	mov r0, L89
+L79:	.string "habyciwvfsshrkpyp"
+	clr L43
+
+L80:	jsr X1
+L81:	.data -480, 16
+
+L82:	.data -338, -82
+L83:	.data -488, 110, -60, 147, -151, -145, -302
+	m0
+	red r3
+L84:	bne L183
+L85:	not r1
+	m4
+L86:	not r2
+	m7
+L87:	stop
+	cmp L109, L129
+	m4
+L88:	sub #10, *r4
+L89:	add r0, r5
+L90:	.data 27, -253, 101
+L91:	prn r7
+	add #96, *r0
+L92:	stop
+L93:	clr *r1
+L94:	not r6
+L95:	cmp *r1, #63
+	lea L70, r4
+	m1
+L96:	jmp *r3
+L97:	dec *r2
+L98:	rts
+
+L99:	.data -435, -246, -281, 473
+	m1
+L100:	.data 376, 486
+	jmp L178
+L101:	not *r7
+L102:	add L57, r5
+	m2
+L103:	bne *r6
+L104:	stop
+	m7
+	jmp *r1
+L105:	mov L168, *r0
+L106:	.string "ytzhyhoknktxwoycudimgz"
+	m7
+L107:	rts
+L108:	prn r6
+	jmp *r0
+; comment line of the generated program
+L109:	.data 204, 464, -293, 161
+L110:	not L83
+L111:	prn r3
+	m6
+	m0
+; comment line of the generated program
+L112:	rts
+	prn #-90
+L113:	jmp *r6
+L114:	sub *r5, r6
+L115:	.data -44, 363, 482
+
+L116:	prn *r1
+; comment line of the generated program
+	mov r5, *r6
+L117:	inc *r7
+L118:	.string "yrozhzctysfpqvogzyxd"
+L119:	rts
+L120:	clr r6
+	rts
+L121:	mov #45, r0
+; comment line of the generated program
+L122:	.data -299, 172, 471, -454, 195, -395, -302, 139
+L123:	bne L57
+L124:	.data 360, -37, -21, -367, -466, 56, 260
+L125:	stop
+; comment line of the generated program
+	red r1
+L126:	sub #51, r5
+L127:	.data 372, 122
+	m4
+L128:	.data 265
+L129:	rts
+; comment line of the generated program
+	cmp L151, *r2
+L130:	stop
+L131:	inc r6
+
+	m4
+
+L132:	jsr *r2
+L133:	.string "yvhcpimvjwqz"
+	lea L142, r5
+; comment line of the generated program
+L134:	lea L132, *r1
+; comment line of the generated program
+L135:	stop
+; comment line of the generated program
+L136:	lea L19, r2
+L137:	cmp #-2, L195
+	red r3
+; comment line of the generated program
+L138:	.data 108
+L139:	inc L184
+L140:	prn X3
+
+L141:	.string "ipfzrysenecjgepkqzjddk"
+
+	red L165
+L142:	cmp L5, r2
+
+L143:	inc r7
+L144:	sub #-53, *r0
+; comment line of the generated program
+L145:	.data -106, 341, 496, 184, 219
+	rts
+L146:	.string "zk"
+
+L147:	.data -389, -336, 35, -94, 181, -403, -268, 449
+
+L148:	.data 102, 276
+L149:	add L182, L72
+; comment line of the generated program
+L150:	mov L33, r0
+
+	not r0
+L151:	not *r4
+L152:	rts
+; comment line of the generated program
+L153:	rts
+L154:	.string "kzozejavpitnethnied"
+	m3
+
+	dec L144
+
+	m3
+L155:	bne L100
+L156:	jmp *r0
+L157:	prn #63
+
+L158:	jsr *r3
+	bne L173
+L159:	rts
+L160:	add r2, L170
+L161:	sub X7, *r0
+L162:	.data -229, 422, 19, 154, -23
+	.data 466, 60, -428, -67, -436, 328, 68, 471
+L163:	inc r5
+L164:	inc L125
+L165:	sub #-23, L18
+L166:	.data 287
+	cmp r4, *r4
+L167:	dec L55
+L168:	clr L84
+L169:	.data -358
+L170:	.data 424, 496, -283, -331
+	.data 323, -484, -317, -188, 106, 138
+L171:	cmp L131, r4
+L172:	mov *r2, L5
+L173:	.data 383, -216, -428, -231, -296
+; comment line of the generated program
+L174:	lea L177, r7
+L175:	not L136
+	add *r7, r1
+L176:	.data 467, 108, -453
+L177:	not *r6
+L178:	jmp *r5
+L179:	cmp L164, L50
+	dec *r3
+L180:	stop
+L181:	.string "smhizwu"
+L182:	prn #-54
+L183:	.string "xldtkdivgay"
+	m5
+	clr *r3
+L184:	jsr *r4
+L185:	rts
+L186:	dec L171
+L187:	cmp *r5, L105
+; comment line of the generated program
+	jmp *r5
+L188:	jmp *r6
+	m7
+L189:	.data -13, -498, 102, -226, 40
+L190:	inc X3
+L191:	rts
+	add r0, L5
+L192:	.data -101, -396, -90, 88, -36, -409
+; comment line of the generated program
+L193:	lea L83, r4
+L194:	.string "opnegrbnvd"
+L195:	lea L21, r6
+	sub r1, *r7
+	m0
+L196:	jmp L64
+L197:	.data -49, 52
+L198:	sub *r4, *r2
+; comment line of the generated program
+	m3
+L199:	dec r6
+.entry L0
+.entry L20
+.entry L40
+.entry L60
+.entry L80
+.entry L100
+.entry L120
+.entry L140
+.entry L160
+.entry L180
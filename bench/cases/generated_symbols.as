@@ -0,0 +1,935 @@
+; generated program seed 4 words 1995
+.extern X0
+.extern X1
+.extern X2
+.extern X3
+.extern X4
+.extern X5
+.extern X6
+.extern X7
+.extern X8
+.extern X9
+.extern X10
+.extern X11
+.extern X12
+.extern X13
+.extern X14
+.extern X15
+.extern X16
+.extern X17
+.extern X18
+.extern X19
+.extern X20
+.extern X21
+.extern X22
+.extern X23
+.extern X24
+.extern X25
+.extern X26
+.extern X27
+.extern X28
+.extern X29
+.extern X30
+.extern X31
+.extern X32
+.extern X33
+.extern X34
+.extern X35
+.extern X36
+.extern X37
+.extern X38
+.extern X39
+.extern X40
+.extern X41
+.extern X42
+.extern X43
+.extern X44
+.extern X45
+.extern X46
+.extern X47
+.extern X48
+.extern X49
+.extern X50
+.extern X51
+.extern X52
+.extern X53
+.extern X54
+.extern X55
+.extern X56
+.extern X57
+.extern X58
+.extern X59
+macr m0
+	red r1
+endmacr
+macr m1
+	prn #-27
+	clr *r1
+endmacr
+macr m2
+	prn #-19
+	clr *r4
+endmacr
+macr m3
+	red *r4
+	mov #-87, r2
+	jmp *r0
+endmacr
+macr m4
+	jsr *r4
+endmacr
+macr m5
+	prn r2
+	not *r0
+endmacr
+macr m6
+	clr *r1
+	dec r6
+endmacr
+macr m7
+	add r2, r0
+	stop
+	prn #99
+endmacr
+L0:	inc r6
+	.data -274, 18, 401
+	bne L60
+; comment line of the generated program
+L1:	.data -356, -317, -24, 491, 347, 149
+	red L124
+
+	rts
+L2:	lea X6, X35
+	cmp L131, L93
+	clr X35
+L3:	jsr *r6
+	add r1, r3
+	.data 257, -447, 108, -67, 411
+L4:	rts
+	dec r6
+	stop
+	m6
+
+L5:	stop
+	m2
+	prn L102
+	add r0, *r0
+L6:	add *r0, L94
+	jmp *r6
+	.data -33, 280, 27, -210, -376, 93, 224
+L7:	.data 218
+
+	stop
+	m6
+; comment line of the generated program
+	bne *r5
+L8:	rts
+	red L95
+	stop
+L9:	.data -268, 389, 394, 168, -163
+	red *r6
+	sub r2, L37
+L10:	.data 215, -318, -291, -118, 198
+	jsr *r2
+; comment line of the generated program
+	bne X19
+L11:	cmp r1, X1
+	.data -492, 415, 491, -152, 493
+	clr r2
+L12:	rts
+	prn r7
+	jmp L164
+L13:	dec *r3
+	m6
+	prn #-15
+L14:	dec *r7
+	inc r1
+	not *r4
+L15:	lea L145, *r7
+
+	jsr X23
+	prn *r3
+; comment line of the generated program
+L16:	.data -35
+; comment line of the generated program
+	jmp L60
+	.data -61, 34, 285, -1, 263, -59
+
+L17:	.string "metnpfewwrv"
+	prn *r5
+; comment line of the generated program
+	rts
+L18:	lea L89, r7
+	rts
+; comment line of the generated program
+	not L167
+L19:	.data -174, 376, -499, -18, -289, -445, -21
+; comment line of the generated program
+	red *r4
+	rts
+; comment line of the generated program
+L20:	stop
+; comment line of the generated program
+	.data -485, 327, 107, -298, 274, 441, 243, -403
+	.data 79, 320, 22
+L21:	bne *r3
+
+	rts
+	bne *r5
+L22:	stop
+	.data -77, 279, 477, -449, -255, -195, -481, -500
+	.data 335, 37, -59, -365, 411, -133, 442
+L23:	mov *r2, *r5
+; comment line of the generated program
+	clr *r5
+	.data -416
+L24:	.string "uzae"
+; comment line of the generated program
+	inc *r3
+	dec r6
+L25:	.data -442, -446
+	m3
+	rts
+	jmp L185
+L26:	red r7
+	jsr *r1
+L27:	add X25, *r5
+	bne L60
+	stop
+L28:	dec *r0
+	bne X5
+; comment line of the generated program
+	stop
+L29:	prn *r0
+	jmp *r1
+
+	add r4, L99
+L30:	not r6
+	add L47, r4
+	m3
+	m7
+
+	m3
+	prn *r2
+L31:	cmp L88, L18
+	clr r4
+	inc X51
+L32:	not X36
+	jsr *r5
+	rts
+L33:	.data 297
+	add L158, L8
+
+	stop
+L34:	.data -75, -443, 72, 188, 427, 285, -450, -120
+	m4
+	.data -485, 36, -343, 119, 479, 42
+	m3
+
+	not L32
+; comment line of the generated program
+L35:	.data 341, -78, -280
+
+	.data 482, 29, 264
+
+	lea L101, X31
+L36:	stop
+	.string "jalzrwz"
+	clr *r7
+
+L37:	dec r5
+	prn #54
+	m0
+	inc X5
+L38:	inc L111
+	red *r1
+; comment line of the generated program
+	inc r7
+L39:	add L57, *r7
+	clr *r7
+L40:	jmp X43
+	cmp X10, *r4
+	add *r5, X56
+L41:	red *r0
+	clr r0
+	bne *r1
+L42:	jmp *r1
+	stop
+	jsr X59
+
+L43:	stop
+	m5
+	lea X22, *r0
+
+	.data -74, -205, 291, 475, -48, 63
+L44:	clr r1
+
+	m3
+	red r1
+	rts
+L45:	red X57
+	add r3, r0
+	rts
+L46:	inc *r1
+	add r6, *r7
+
+	.data -58, -144, 231, -482
+
+L47:	bne *r7
+	.string "xldhtgucjxj"
+	.data 41, 250, -57
+L48:	.string "jwrvkygt"
+	bne *r5
+	add #52, r5
+L49:	rts
+	.data -435, 188, 84, -173, 283, 498, 219, -175
+	add X58, X12
+	m2
+L50:	sub *r1, *r2
+	clr r5
+	add L182, r2
+L51:	bne X58
+; comment line of the generated program
+	.string "alnjaa"
+	rts
+L52:	mov *r5, *r5
+	prn #-78
+	mov #24, *r4
+L53:	stop
+	m2
+	jsr *r0
+L54:	dec r2
+	clr r6
+; comment line of the generated program
+	not X7
+L55:	bne *r4
+
+	.data 55, -475, -448, -67
+; comment line of the generated program
+	.data 435, -408, 467, -113, 62, -290, 330, -255
+L56:	mov *r3, *r0
+	rts
+	dec L170
+; comment line of the generated program
+L57:	.string "xqo"
+
+	inc *r0
+; comment line of the generated program
+	.data -149, -99, -157, 426, -435, -255, -166, 312
+L58:	not X19
+; comment line of the generated program
+	lea X7, *r2
+	add r4, *r1
+	m7
+L59:	inc L174
+; comment line of the generated program
+	stop
+	cmp *r0, *r5
+L60:	.data 85, 238, -475
+	.data -364, -281, -459, -3
+	mov #45, r1
+L61:	stop
+	red X35
+	.string "dwajhktxf"
+; comment line of the generated program
+L62:	not *r7
+	m4
+	m3
+; comment line of the generated program
+	m0
+	inc X7
+	bne *r6
+
+L63:	cmp r0, X19
+	cmp *r7, r6
+; comment line of the generated program
+	.data -204, 134, -366, -244, -345, 21
+L64:	.string "zfuwnbxvrraatwjaaitgmb"
+	bne *r5
+	jsr L158
+L65:	add X46, X54
+	red *r7
+	.data 122, 339, -447, -97, -358, -249, -486
+; comment line of the generated program
+L66:	jsr X48
+
+	clr r4
+L67:	prn L199
+	lea X48, r1
+	dec r7
+L68:	not r6
+	.data 352, -97, 432, -375, 464, -319, -348, -155
+	.data 127, 347, -146, 110
+L69:	inc r7
+	red *r5
+	.data 429
+L70:	jmp L112
+	prn r3
+	mov X58, *r0
+L71:	dec X39
+	.data -84, 448, 178, -161, 88
+; comment line of the generated program
+	.string "gpjpzdbunimlcgpaffb"
+
+L72:	prn r5
+; comment line of the generated program
+	cmp #-100, *r0
+	jmp X2
+	m5
+L73:	inc *r0
+	red L104
+	red X39
+L74:	clr r4
+
+	stop
+	red r3
+	m6
+
+L75:	red r3
+	bne X25
+
+	m3
+	lea L40, r3
+L76:	.data 100
+
+	.data -85, 212, -79, 113
+	m0
+
+	.data 400, -39, 331, -161, -63, 326, 101
+L77:	red *r7
+
+	stop
+	bne *r0
+L78:	add *r4, *r5
+	prn #-45
+	lea X9, *r7
+L79:	.string "ktncumftgilopvtzrte"
+; comment line of the generated program
+	.data 141, -230, -375, -308
+L80:	prn r4
+
+	jmp *r5
+	.data 28
+; comment line of the generated program
+L81:	.data 309, -133
+	red r3
+	lea L140, *r3
+L82:	prn *r0
+	red r3
+	.string "mxqzpgqotln"
+
+L83:	inc *r2
+	m0
+	cmp r0, #-90
+	clr *r2
+L84:	rts
+	lea L17, r1
+	m5
+	rts
+L85:	bne X32
+	dec r6
+
+	jmp *r0
+L86:	not *r5
+	.data -281
+; comment line of the generated program
+	add r5, *r7
+	m5
+; comment line of the generated program
+L87:	.string "apmymnxvimuxfxsopqetan"
+	mov r0, L99
+; comment line of the generated program
+	jsr *r1
+L88:	stop
+; comment line of the generated program
+	lea X9, *r2
+
+	sub *r6, r1
+; comment line of the generated program
+L89:	prn r4
+; comment line of the generated program
+	.data -373
+
+	sub L134, L41
+L90:	.data -260, -5, -278, 13, 428, -109, 491, 335
+	jsr *r1
+	bne *r3
+L91:	red L49
+	inc *r6
+	.string "ijm"
+L92:	lea X1, X46
+	.data -198, 141
+	bne X10
+L93:	.data -430, -23, 129
+	m5
+	not X39
+	m4
+L94:	rts
+	m7
+; comment line of the generated program
+	clr *r7
+; comment line of the generated program
+	sub L110, r0
+
+L95:	jsr *r6
+	m6
+	add L25, X12
+	m6
+	jsr X7
+
+L96:	.data -200, -191, 134, -386, 26
+	rts
+	clr *r7
+L97:	clr L27
+	bne X54
+	prn L96
+L98:	stop
+	stop
+	.string "zqa"
+; comment line of the generated program
+L99:	mov #36, r3
+	.data -295, -98
+	jsr X53
+L100:	.data -350, 293, -42, -55, -338, 219
+	lea X18, r6
+	not r7
+L101:	sub *r3, r2
+	m0
+	prn L25
+	.data 306, 145, -435
+L102:	inc r6
+	clr *r5
+	.data -404, 332, -26
+L103:	not *r4
+	mov L2, *r1
+	inc *r7
+; comment line of the generated program
+L104:	cmp X32, X8
+; comment line of the generated program
+	.data -216, -405, 314, -80, -283, 39, 322, -402
+	rts
+L105:	lea L122, *r3
+	bne *r7
+	clr r5
+; comment line of the generated program
+	m0
+L106:	clr r2
+	sub r4, r1
+L107:	not X43
+	sub r0, *r1
+	.string "bybal"
+L108:	.data 276, -338
+	clr r6
+	jmp *r4
+L109:	stop
+	rts
+
+	.data 86, 9
+; comment line of the generated program
+L110:	jmp L152
+	m2
+	jmp X33
+	jsr X52
+	m1
+L111:	stop
+	cmp #33, *r5
+	not X4
+L112:	clr L102
+	jsr L156
+	clr *r0
+	m7
+L113:	jmp *r3
+	m1
+	.string "owpvyxbsmbgexakwdrqxsm"
+	stop
+L114:	.data -326
+	.data 492
+	add X40, r6
+L115:	inc L8
+	sub *r6, r1
+	clr r5
+L116:	add r5, *r4
+	.data -332, -200, 317
+	.string "xzajbosmogmzarleslpzss"
+	m0
+L117:	.string "bl"
+	jmp L117
+	bne *r0
+; comment line of the generated program
+	m3
+L118:	jsr *r2
+; comment line of the generated program
+	m2
+	prn *r7
+	dec X10
+	m3
+L119:	bne X31
+	.data 153, -228
+; comment line of the generated program
+L120:	prn L60
+	mov #15, *r4
+; comment line of the generated program
+	jsr *r1
+; comment line of the generated program
+L121:	.data -210, -45, -473, -298, -453, -285, -435, -69
+	cmp r5, r6
+	cmp r7, #45
+L122:	jmp L62
+	lea X2, *r3
+	sub X38, *r1
+L123:	.data 312, 257, -424, 111, 143
+; comment line of the generated program
+	lea L73, *r1
+	jsr *r6
+
+L124:	clr X47
+	clr r1
+
+	dec *r0
+
+L125:	.string "h"
+	rts
+; comment line of the generated program
+	lea X36, *r0
+	m5
+L126:	sub r7, X15
+	inc *r1
+	cmp L80, #48
+L127:	.string ""
+	add *r2, *r4
+
+	mov *r6, r2
+
+L128:	prn #83
+	red r2
+	sub *r4, *r3
+; comment line of the generated program
+L129:	lea L146, *r4
+	m4
+; comment line of the generated program
+	jmp *r6
+	sub *r7, *r6
+L130:	dec *r0
+	.data -130, 20, 447, 374, -250
+	stop
+L131:	add *r0, r1
+	.string "rwtuquywws"
+	rts
+L132:	jmp *r2
+	add #10, r4
+
+	add X45, L147
+	m2
+L133:	mov r4, *r6
+	stop
+
+L134:	bne *r0
+	bne *r7
+	red *r2
+	m7
+
+L135:	sub #-70, X18
+	.data -2, -425, -27, 449, -34, 17, 446, -107
+	clr r4
+L136:	not *r3
+	red *r6
+	bne X4
+L137:	.data -53, 380, -492, -390
+	clr r5
+	.data -473, 68, -353, -136
+L138:	.data 36, -157
+	sub r5, L161
+
+	red X49
+L139:	inc r2
+	inc *r0
+	m4
+	m3
+
+	lea X40, r2
+L140:	jmp *r6
+	dec *r1
+	.data 171, 117, 2, -460, 167, 471
+L141:	stop
+	lea L160, X42
+
+	m6
+	jmp *r0
+; comment line of the generated program
+L142:	red *r7
+	.data 496, -248, 13, 465
+	not r5
+
+L143:	bne X0
+	m1
+	bne *r6
+	stop
+	m7
+L144:	add r1, L114
+	.data -196, 402, -70, 190, -226
+	.data -125, -253, 145, 281, 271, 116, -147, -216
+L145:	mov *r2, X31
+	jsr *r5
+	not L52
+	m4
+L146:	add r6, r4
+
+	stop
+	m7
+
+L147:	add #-51, *r7
+	rts
+	.data -248, -368, 381
+L148:	lea L42, r4
+
+	dec *r7
+	lea X52, *r7
+	m6
+L149:	add X22, X16
+; comment line of the generated program
+	dec *r7
+	m2
+	mov L13, *r6
+L150:	.data 333, -379
+	.data 24, -40, -226
+	jmp *r7
+L151:	bne *r7
+	.data -93, -80, 176
+	rts
+L152:	.data -412, -82, 181, -111, 125, 223, -263, -294
+	m5
+; comment line of the generated program
+	add #29, r2
+	.data -265, 230, 321, 121, 104, 164
+
+L153:	.data -31, -333
+	jsr X42
+	red L37
+L154:	rts
+	.data 395, -81, -465
+	prn r7
+	m1
+L155:	not *r4
+	rts
+	cmp r1, r6
+L156:	clr *r3
+	prn #30
+	.data -270, 134, 97, 279
+
+	m1
+L157:	.data -314, 46, -351
+	add r4, r0
+; comment line of the generated program
+	cmp *r5, X54
+; comment line of the generated program
+L158:	mov r6, *r1
+	bne *r1
+
+	cmp *r0, L120
+L159:	.data -195, -221, -15, 297, 212
+	.string "koistvnwzilpcttfynamogh"
+; comment line of the generated program
+L160:	jmp *r0
+	bne *r2
+	clr *r5
+L161:	mov X12, r7
+	red X45
+	m2
+	add *r1, r5
+L162:	cmp *r4, #88
+	.data -445
+	rts
+
+L163:	prn X37
+	.data -312
+; comment line of the generated program
+	inc *r6
+L164:	mov *r3, X42
+	stop
+	jsr *r6
+L165:	cmp r6, L29
+	rts
+; comment line of the generated program
+	.data 54, -49, -183, 228, 56, 137, -429
+L166:	lea X37, *r7
+	rts
+	.string "yusgdbqefuzspwjevmifgly"
+	m0
+L167:	clr r4
+	jmp *r3
+	.data 1, 211, 339, -290, -495
+L168:	red *r0
+	cmp X3, #22
+	jmp *r5
+
+L169:	inc L14
+	prn *r5
+	mov r2, r0
+L170:	cmp *r1, #45
+	sub *r3, r4
+	bne *r7
+L171:	.data -124, -8
+	prn L139
+	prn r7
+L172:	.string "fxxslysilefaraqhedpuef"
+
+	dec *r2
+	.string "wsbuktzofjvrzpajpchx"
+L173:	lea L152, r2
+	cmp X12, *r7
+L174:	jsr L82
+	mov *r6, *r6
+	lea X1, L46
+L175:	mov #57, r1
+	not X10
+; comment line of the generated program
+	m6
+	mov *r1, r6
+L176:	.data -201, 342, 41, 30, -177, -496
+	m7
+	not *r1
+
+	.string "rzxhfjswuzbnjz"
+L177:	.data -468, -184, -16, 113, 171, -287
+; comment line of the generated program
+	red *r1
+	clr r7
+L178:	.data -120, 330, -75, 275
+
+	add r3, r4
+	red r6
+L179:	.string ""
+	m0
+	jmp L34
+	inc *r5
+L180:	mov r6, *r5
+	sub r6, *r1
+	not r4
+L181:	.string "xulkl"
+
+	red *r0
+	dec r2
+L182:	cmp X54, r6
+; comment line of the generated program
+	lea L50, *r3
+	jsr *r6
+L183:	.data 265
+	not X32
+	cmp #-86, *r0
+L184:	.string "ygsiiuedefmkqfc"
+	bne X40
+	bne *r4
+L185:	cmp *r1, L197
+	not r0
+	add *r7, r7
+L186:	.data -363, 432, -89, -201, 406, 130
+	clr L102
+L187:	cmp r5, X46
+	jsr *r7
+
+	rts
+L188:	inc *r7
+
+	add X0, *r2
+; comment line of the generated program
+	not r3
+
+L189:	rts
+	stop
+	prn #-98
+; comment line of the generated program
+L190:	dec r1
+	jmp *r7
+	prn #59
+; comment line of the generated program
+L191:	not *r3
+	mov #17, r5
+	.data 250
+L192:	.data 201, -355
+; comment line of the generated program
+	sub r2, *r1
+	stop
+L193:	mov *r1, r1
+	add X58, X11
+	clr L1
+L194:	stop
+	add L9, L72
+	clr r2
+L195:	clr r4
+	.data 461, -400, -418, -406, -493, 499, 488
+	jmp *r4
+L196:	jsr *r5
+	prn #-43
+	m4
+	.data 283, -475
+L197:	.data 484, 470, 454, 359
+	jsr *r1
+	inc r1
+L198:	not r1
+	m6
+	add L53, *r3
+	lea X42, *r6
+
+L199:	jmp X23
+	lea L110, *r0
+	m3
+.entry L0
+.entry L3
+.entry L6
+.entry L10
+.entry L13
+.entry L16
+.entry L20
+.entry L23
+.entry L26
+.entry L30
+.entry L33
+.entry L36
+.entry L40
+.entry L43
+.entry L46
+.entry L50
+.entry L53
+.entry L56
+.entry L60
+.entry L63
+.entry L66
+.entry L70
+.entry L73
+.entry L76
+.entry L80
+.entry L83
+.entry L86
+.entry L90
+.entry L93
+.entry L96
+.entry L100
+.entry L103
+.entry L106
+.entry L110
+.entry L113
+.entry L116
+.entry L120
+.entry L123
+.entry L126
+.entry L130
+.entry L133
+.entry L136
+.entry L140
+.entry L143
+.entry L146
+.entry L150
+.entry L153
+.entry L156
+.entry L160
+.entry L163
+.entry L166
+.entry L170
+.entry L173
+.entry L176
+.entry L180
+.entry L183
+.entry L186
+.entry L190
+.entry L193
+.entry L196
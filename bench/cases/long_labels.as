@@ -0,0 +1,6 @@
+; labels of 31 characters that differ only in their last one
+.entry A23456789012345678901234567890X
+MAIN: jmp A23456789012345678901234567890X
+      lea A234567890123456789012345678901, r1
+A234567890123456789012345678901: .data 7
+A23456789012345678901234567890X: stop
@@ -0,0 +1,25 @@
+; macros expanded several times, back to back and between labels
+macr save
+	mov r1, r6
+	mov r2, r7
+endmacr
+macr restore
+	mov r6, r1
+	mov r7, r2
+endmacr
+macr twice
+	inc COUNT
+	inc COUNT
+endmacr
+
+MAIN:	save
+	twice
+	restore
+	save
+LOOP:	twice
+	dec COUNT
+	cmp COUNT, #0
+	bne LOOP
+	restore
+	stop
+COUNT:	.data 0
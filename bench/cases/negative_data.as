@@ -0,0 +1,13 @@
+; negative and signed data and immediates at the edges of their fields
+MAIN:	prn #-1
+	prn #-2048
+	prn #2047
+	mov #-5, r1
+	cmp #+7, #-7
+	add #-0, VALUES
+	stop
+VALUES:	.data -1, -2, +3, -0
+	.data -16384, 16383
+	.data 0,-100 , +100
+EMPTY:	.string ""
+TEXT:	.string "-1"
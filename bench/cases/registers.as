@@ -0,0 +1,29 @@
+; register pairs share a single word in every combination of direct and indirect registers
+MAIN:	mov r0, r7
+	mov r7, r0
+	mov *r1, r2
+	mov r3, *r4
+	mov *r5, *r6
+	cmp r0, r0
+	cmp *r7, r1
+	add r7, *r0
+	sub *r2, *r3
+	lea MAIN, r4
+	lea MAIN, *r5
+	clr r6
+	clr *r6
+	not r1
+	inc *r2
+	dec r3
+	jmp *r4
+	bne *r5
+	jsr *r6
+	red r7
+	red *r0
+	prn r1
+	prn *r2
+	mov #5, *r3
+	mov MAIN, r4
+	cmp r5, MAIN
+	rts
+	stop
@@ -0,0 +1,690 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../definitions.h"
+
+#define OPCODE_COUNT 16/*number of operations*/
+#define MODE_COUNT 4/*number of addressing modes*/
+#define MAX_PROGRAM_WORDS (CODE_ARR_IMG_LENGTH - IC_INIT_VALUE)/*most words a program that loads at IC_INIT_VALUE can hold*/
+#define MAX_MACRO_LINES 3/*most lines of a generated macro*/
+#define MAX_OPERAND_TEXT 32/*longest generated operand*/
+#define MAX_MACROS 256/*most macros of a generated program*/
+
+/*
+* generate
+* --------
+* a deterministic generator of valid assembly programs for the benchmark and for stress tests
+* the same seed and knobs always produce the same program on every platform (the generator has its own random numbers)
+* the knobs select the size of the program in words, the mix of operations and addressing modes, the number of labels
+* and how often operands reference them, the number of macros and how often they are expanded, the share of .data
+* and .string words, the number of externs and entries and the share of comment lines
+* with -n N -o DIR it writes a corpus of N programs DIR/gen0000.as ... whose sizes vary between half and all of the words
+*/
+
+/*** STRUCTURE DEFINITIONS SECTION ***/
+
+/*kinds of generated statements*/
+typedef enum statement_kinds{
+	CODE_STATEMENT = 0,/*an instruction*/
+	DATA_STATEMENT = 1,/*a .data directive*/
+	STRING_STATEMENT = 2,/*a .string directive*/
+	EXPAND_STATEMENT = 3/*a use of a macro*/
+}statement_kind;
+
+typedef struct{/*the knobs of the generator*/
+	unsigned long seed;/*seed of the random numbers*/
+	long words;/*words of code and data the program holds*/
+	int labels;/*labels the program defines*/
+	int refs;/*percent of the operands that reference a label*/
+	int extern_refs;/*percent of the label references that name an extern*/
+	int macros;/*macros the program defines*/
+	int expand;/*percent of the statements that expand a macro*/
+	int data;/*percent of the statements that are .data or .string*/
+	int strings;/*percent of the data statements that are .string*/
+	int externs;/*names declared .extern*/
+	int entries;/*labels declared .entry*/
+	int comments;/*percent of the statements preceded by a comment line*/
+	int mix[OPCODE_COUNT];/*weight of every operation*/
+	int modes[MODE_COUNT];/*weight of the immediate direct relative and register addressing modes (direct is set by refs)*/
+	int files;/*number of programs of a corpus or 0 for a single program on stdout*/
+	const char *output;/*directory of the corpus*/
+}GeneratorOptions;
+
+typedef struct{/*a statement chosen before the labels are placed*/
+	statement_kind kind;/*kind of the statement*/
+	int opcode;/*operation of an instruction or number of the expanded macro*/
+	int modes[2];/*addressing modes of the source and destination operands (-1 when absent)*/
+	int length;/*number of values of a .data or characters of a .string*/
+}Statement;
+
+/*** OPERATIONS SECTION ***/
+
+/*
+* operation_table
+* ---------------
+* the operations with their operand count and the addressing modes they accept as a bit mask
+* (1 immediate 2 direct 4 relative 8 register) matching operations_info of the first pass
+*/
+const struct{
+	const char *name;
+	int operands;
+	int source;
+	int destination;
+}operation_table[OPCODE_COUNT] = {
+	{"mov", 2, 15, 14}, {"cmp", 2, 15, 15}, {"add", 2, 15, 14}, {"sub", 2, 15, 14},
+	{"lea", 2, 2, 14}, {"clr", 1, 0, 14}, {"not", 1, 0, 14}, {"inc", 1, 0, 14},
+	{"dec", 1, 0, 14}, {"jmp", 1, 0, 6}, {"bne", 1, 0, 6}, {"red", 1, 0, 14},
+	{"prn", 1, 0, 15}, {"jsr", 1, 0, 6}, {"rts", 0, 0, 0}, {"stop", 0, 0, 0}
+};
+
+const char *mode_names[MODE_COUNT] = {"imm", "dir", "rel", "reg"};
+
+/*** RANDOM NUMBERS SECTION ***/
+
+/*
+* next_random
+* -----------
+* this function advances a xorshift generator kept in 32 bits so every platform draws the same numbers
+*
+* parameters:
+*   state: the state of the generator (never 0)
+*
+* returns:
+*   unsigned long: the next number between 0 and 2^32-1
+*/
+unsigned long next_random(unsigned long *state){
+	unsigned long x = *state;
+
+	x ^= (x << 13) & 0xFFFFFFFFUL;
+	x ^= x >> 17;
+	x ^= (x << 5) & 0xFFFFFFFFUL;
+	*state = x & 0xFFFFFFFFUL;
+	return *state;
+}
+
+/*
+* random_below
+* ------------
+* this function draws a number below a bound
+*
+* parameters:
+*   state: the state of the generator
+*   bound: the bound (at least 1)
+*
+* returns:
+*   int: a number between 0 and bound-1
+*/
+int random_below(unsigned long *state, int bound){
+	return (int)(next_random(state) % (unsigned long)bound);
+}
+
+/*
+* random_weighted
+* ---------------
+* this function draws an index with a probability proportional to its weight
+* only the indices whose bit is set in allowed take part
+*
+* parameters:
+*   state: the state of the generator
+*   weights: the weights
+*   count: the number of weights
+*   allowed: bit mask of the indices that take part
+*
+* returns:
+*   int: the index or -1 when every allowed weight is 0
+*/
+int random_weighted(unsigned long *state, const int *weights, int count, int allowed){
+	int i, total = 0, pick;
+
+	for(i=0 ; i<count ; i++){
+		total += (allowed >> i & 1) ? weights[i] : 0;
+	}
+	if(total <= 0){
+		return -1;
+	}
+	pick = random_below(state, total);
+	for(i=0 ; i<count ; i++){
+		if((allowed >> i & 1) && (pick -= weights[i]) < 0){
+			return i;
+		}
+	}
+	return -1;
+}
+
+/*** PROGRAM SECTION ***/
+
+/*
+* operand_modes
+* -------------
+* this function chooses the addressing mode of an operand among the ones the operation accepts
+* direct addressing gets refs percent of the draws when it is accepted and the other modes share the rest by weight
+* an operand whose other modes all weigh 0 falls back to direct addressing or to the first mode it accepts
+*
+* parameters:
+*   options: the knobs
+*   state: the state of the generator
+*   allowed: bit mask of the accepted modes
+*
+* returns:
+*   int: the mode (0 immediate 1 direct 2 relative 3 register)
+*/
+int operand_mode(const GeneratorOptions *options, unsigned long *state, int allowed){
+	int mode;
+
+	if((allowed & 2) && random_below(state, 100) < options->refs){
+		return 1;
+	}
+	mode = random_weighted(state, options->modes, MODE_COUNT, allowed & ~2);
+	if(mode < 0){
+		for(mode=0 ; mode<MODE_COUNT && !((allowed & ~2) >> mode & 1) ; mode++);
+		mode = (allowed & 2) || mode == MODE_COUNT ? 1 : mode;
+	}
+	return mode;
+}
+
+/*
+* code_words
+* ----------
+* this function counts the words an instruction takes
+* a relative or register source shares its word with a relative or register destination
+*
+* parameters:
+*   modes: the modes of the source and destination operands (-1 when absent)
+*
+* returns:
+*   int: the number of words
+*/
+int code_words(const int modes[2]){
+	int words = 1 + (modes[0] >= 0) + (modes[1] >= 0);
+
+	if(modes[0] >= 2 && modes[1] >= 2){
+		words--;
+	}
+	return words;
+}
+
+/*
+* choose_instruction
+* ------------------
+* this function chooses an operation and the modes of its operands
+*
+* parameters:
+*   options: the knobs
+*   state: the state of the generator
+*   statement: the statement that receives the instruction
+*   with_labels: false when the operands may not reference labels (the body of a macro)
+*
+*/
+void choose_instruction(const GeneratorOptions *options, unsigned long *state, Statement *statement, bool with_labels){
+	int source, destination;
+
+	statement->kind = CODE_STATEMENT;
+	statement->opcode = random_weighted(state, options->mix, OPCODE_COUNT, 0xFFFF);
+	source = operation_table[statement->opcode].source;
+	destination = operation_table[statement->opcode].destination;
+	if(!with_labels){
+		source = source == 2 ? 0 : source & ~2;/*lea takes only a label so the macro gets another operation*/
+		destination &= ~2;
+		if(operation_table[statement->opcode].operands == 2 && source == 0){
+			statement->opcode = 0;/*mov*/
+			source = 13;
+			destination = 12;
+		}
+		else if(operation_table[statement->opcode].operands >= 1 && destination == 0){
+			destination = 4;
+		}
+	}
+	statement->modes[0] = statement->modes[1] = -1;
+	if(operation_table[statement->opcode].operands == 2){
+		statement->modes[0] = operand_mode(options, state, source);
+		statement->modes[1] = operand_mode(options, state, destination);
+	}
+	else if(operation_table[statement->opcode].operands == 1){
+		statement->modes[1] = operand_mode(options, state, destination);
+	}
+}
+
+/*
+* operand_text
+* ------------
+* this function writes an operand in a given addressing mode
+*
+* parameters:
+*   options: the knobs
+*   state: the state of the generator
+*   mode: the addressing mode
+*   labels: the number of labels the program defines
+*   text: the buffer of MAX_OPERAND_TEXT characters
+*
+*/
+void operand_text(const GeneratorOptions *options, unsigned long *state, int mode, int labels, char *text){
+	switch(mode){
+		case 0:
+			sprintf(text, "#%d", random_below(state, 201) - 100);
+			break;
+		case 1:
+			if(options->externs > 0 && (labels == 0 || random_below(state, 100) < options->extern_refs)){
+				sprintf(text, "X%d", random_below(state, options->externs));
+			}
+			else{
+				sprintf(text, "L%d", random_below(state, labels));
+			}
+			break;
+		case 2:
+			sprintf(text, "*r%d", random_below(state, 8));
+			break;
+		default:
+			sprintf(text, "r%d", random_below(state, 8));
+	}
+}
+
+/*
+* write_instruction
+* -----------------
+* this function writes the operation and the operands of an instruction
+*
+* parameters:
+*   file: the program
+*   options: the knobs
+*   state: the state of the generator
+*   statement: the instruction
+*   labels: the number of labels the program defines
+*
+*/
+void write_instruction(FILE *file, const GeneratorOptions *options, unsigned long *state, const Statement *statement, int labels){
+	char source[MAX_OPERAND_TEXT], destination[MAX_OPERAND_TEXT];
+
+	fputs(operation_table[statement->opcode].name, file);
+	if(statement->modes[0] >= 0){
+		operand_text(options, state, statement->modes[0], labels, source);
+		operand_text(options, state, statement->modes[1], labels, destination);
+		fprintf(file, " %s, %s", source, destination);
+	}
+	else if(statement->modes[1] >= 0){
+		operand_text(options, state, statement->modes[1], labels, destination);
+		fprintf(file, " %s", destination);
+	}
+	fputc('\n', file);
+}
+
+/*
+* generate_program
+* ----------------
+* this function writes a single program
+* the statements are chosen first until the words run out so the labels can be spread evenly over them
+* every label is defined exactly once, every reference names a defined label or a declared extern
+* and the program always fits in memory at the default load address
+*
+* parameters:
+*   file: the stream the program is written to
+*   options: the knobs
+*   seed: the seed of this program
+*   words: the words of code and data of this program
+*
+* returns:
+*   bool: true if the program was written false if memory ran out
+*/
+bool generate_program(FILE *file, const GeneratorOptions *options, unsigned long seed, long words){
+	Statement *statements = NULL, *grown, bodies[MAX_MACROS][MAX_MACRO_LINES];
+	int macro_words[MAX_MACROS], macro_lines[MAX_MACROS];
+	unsigned long state = (seed * 2654435761UL + 0x9E3779B9UL) & 0xFFFFFFFFUL;
+	long used = 0, count = 0, capacity = 0, labelable = 0, labelable_index, next_label = 0, i;
+	int j, k, w, labels, macros = options->macros;
+	bool references = options->labels > 0 || options->externs > 0;/*false when a direct operand has nothing to name*/
+	Statement statement;
+
+	if(state == 0){
+		state = 1;
+	}
+	for(j=0 ; j<macros ; j++){/*the words of every macro are known before its uses are counted*/
+		macro_lines[j] = 1 + random_below(&state, MAX_MACRO_LINES);
+		macro_words[j] = 0;
+		for(k=0 ; k<macro_lines[j] ; k++){
+			choose_instruction(options, &state, &bodies[j][k], false);
+			macro_words[j] += code_words(bodies[j][k].modes);
+		}
+	}
+
+	/*choose the statements until the words run out*/
+	while(used < words){
+		k = random_below(&state, 100);
+		if(k < options->data){
+			statement.kind = random_below(&state, 100) < options->strings ? STRING_STATEMENT : DATA_STATEMENT;
+			statement.length = statement.kind == STRING_STATEMENT ? random_below(&state, 24) : 1 + random_below(&state, 8);
+			w = statement.kind == STRING_STATEMENT ? statement.length + 1 : statement.length;
+		}
+		else if(macros > 0 && k < options->data + options->expand){
+			statement.kind = EXPAND_STATEMENT;
+			statement.opcode = random_below(&state, macros);
+			w = macro_words[statement.opcode];
+		}
+		else{
+			choose_instruction(options, &state, &statement, references);
+			w = code_words(statement.modes);
+		}
+		if(used + w > words){
+			break;
+		}
+		if(count == capacity){
+			capacity = capacity ? capacity * 2 : 256;
+			grown = (Statement*)realloc(statements, capacity * sizeof(Statement));
+			if(!grown){
+				free(statements);
+				return false;
+			}
+			statements = grown;
+		}
+		statements[count++] = statement;
+		used += w;
+		labelable += statement.kind != EXPAND_STATEMENT;
+	}
+	labels = options->labels < labelable ? options->labels : (int)labelable;
+
+	/*write the program*/
+	fprintf(file, "; generated program seed %lu words %ld\n", seed, used);
+	for(j=0 ; j<options->externs ; j++){
+		fprintf(file, ".extern X%d\n", j);
+	}
+	for(j=0 ; j<macros ; j++){
+		fprintf(file, "macr m%d\n", j);
+		for(k=0 ; k<macro_lines[j] ; k++){
+			fputc('\t', file);
+			write_instruction(file, options, &state, &bodies[j][k], labels);
+		}
+		fputs("endmacr\n", file);
+	}
+	for(i=0, labelable_index=0 ; i<count ; i++){
+		if(random_below(&state, 100) < options->comments){
+			fputs(random_below(&state, 2) ? "; comment line of the generated program\n" : "\n", file);
+		}
+		if(statements[i].kind != EXPAND_STATEMENT && labelable_index++ * labels >= next_label * labelable && next_label < labels){/*spread the labels evenly*/
+			fprintf(file, "L%ld:\t", next_label++);
+		}
+		else{
+			fputc('\t', file);
+		}
+		switch(statements[i].kind){
+			case CODE_STATEMENT:
+				write_instruction(file, options, &state, &statements[i], labels);
+				break;
+			case DATA_STATEMENT:
+				fputs(".data ", file);
+				for(k=0 ; k<statements[i].length ; k++){
+					fprintf(file, k ? ", %d" : "%d", random_below(&state, 1001) - 500);
+				}
+				fputc('\n', file);
+				break;
+			case STRING_STATEMENT:
+				fputs(".string \"", file);
+				for(k=0 ; k<statements[i].length ; k++){
+					fputc('a' + random_below(&state, 26), file);
+				}
+				fputs("\"\n", file);
+				break;
+			default:
+				fprintf(file, "m%d\n", statements[i].opcode);
+		}
+	}
+	for(j=0 ; j<options->entries && j<labels ; j++){
+		fprintf(file, ".entry L%d\n", (int)((long)j * labels / (options->entries < labels ? options->entries : labels)));
+	}
+	free(statements);
+	return !ferror(file);
+}
+
+/*** OPTIONS SECTION ***/
+
+/*
+* parse_weights
+* -------------
+* this function reads a list of name=weight pairs separated by commas into an array of weights
+* the names that are not listed keep their weight
+*
+* parameters:
+*   text: the list
+*   names: the name of every weight
+*   name_at: the distance in bytes between two names (names are fields of a table)
+*   count: the number of weights
+*   weights: the weights
+*
+* returns:
+*   bool: true if the list was valid false otherwise
+*/
+bool parse_weights(const char *text, const char *const *names, size_t name_at, int count, int *weights){
+	char name[16];
+	int i, weight, used;
+
+	while(*text){
+		if(sscanf(text, "%15[a-z]=%d%n", name, &weight, &used) != 2 || weight < 0){
+			return false;
+		}
+		for(i=0 ; i<count && strcmp(*(const char *const*)((const char*)names + i * name_at), name) != 0 ; i++);
+		if(i == count){
+			return false;
+		}
+		weights[i] = weight;
+		text += used;
+		if(*text == ','){
+			text++;
+		}
+		else if(*text){
+			return false;
+		}
+	}
+	return true;
+}
+
+/*
+* parse_generator_options
+* -----------------------
+* this function reads the knobs of the generator from the command line
+*
+* parameters:
+*   argc: the number of arguments
+*   argv: the arguments
+*   options: the knobs to fill
+*
+* returns:
+*   bool: true if every argument was valid false otherwise
+*/
+bool parse_generator_options(int argc, char *argv[], GeneratorOptions *options){
+	int i, j, total;
+	long value;
+	char *end;
+
+	memset(options, 0, sizeof(GeneratorOptions));
+	options->seed = 1;
+	options->words = MAX_PROGRAM_WORDS - 96;
+	options->labels = 200;
+	options->refs = 30;
+	options->extern_refs = 10;
+	options->macros = 8;
+	options->expand = 10;
+	options->data = 20;
+	options->strings = 30;
+	options->externs = 10;
+	options->entries = 10;
+	options->comments = 20;
+	for(j=0 ; j<OPCODE_COUNT ; j++){
+		options->mix[j] = 1;
+	}
+	for(j=0 ; j<MODE_COUNT ; j++){
+		options->modes[j] = 1;
+	}
+
+	for(i=1 ; i<argc ; i++){
+		if(i + 1 >= argc){
+			fprintf(stderr, "Error: option '%s' requires a value\n", argv[i]);
+			return false;
+		}
+		if(strcmp(argv[i], "--mix") == 0){
+			if(!parse_weights(argv[++i], &operation_table[0].name, sizeof(operation_table[0]), OPCODE_COUNT, options->mix)){
+				fprintf(stderr, "Error: invalid value '%s' for option '--mix'\n", argv[i]);
+				return false;
+			}
+			continue;
+		}
+		if(strcmp(argv[i], "--modes") == 0){
+			if(!parse_weights(argv[++i], mode_names, sizeof(mode_names[0]), MODE_COUNT, options->modes)){
+				fprintf(stderr, "Error: invalid value '%s' for option '--modes'\n", argv[i]);
+				return false;
+			}
+			continue;
+		}
+		if(strcmp(argv[i], "-o") == 0 || strcmp(argv[i], "--output") == 0){
+			options->output = argv[++i];
+			continue;
+		}
+		value = strtol(argv[i + 1], &end, 10);
+		if(*argv[i + 1] == '\0' || *end != '\0' || value < 0){
+			fprintf(stderr, "Error: invalid value '%s' for option '%s'\n", argv[i + 1], argv[i]);
+			return false;
+		}
+		if(strcmp(argv[i], "-s") == 0 || strcmp(argv[i], "--seed") == 0){
+			options->seed = (unsigned long)value;
+		}
+		else if(strcmp(argv[i], "-w") == 0 || strcmp(argv[i], "--words") == 0){
+			options->words = value > MAX_PROGRAM_WORDS ? MAX_PROGRAM_WORDS : value;
+		}
+		else if(strcmp(argv[i], "-n") == 0 || strcmp(argv[i], "--files") == 0){
+			options->files = (int)value;
+		}
+		else if(strcmp(argv[i], "--labels") == 0){
+			options->labels = (int)value;
+		}
+		else if(strcmp(argv[i], "--refs") == 0){
+			options->refs = value > 100 ? 100 : (int)value;
+		}
+		else if(strcmp(argv[i], "--extern-refs") == 0){
+			options->extern_refs = value > 100 ? 100 : (int)value;
+		}
+		else if(strcmp(argv[i], "--macros") == 0){
+			options->macros = value > MAX_MACROS ? MAX_MACROS : (int)value;
+		}
+		else if(strcmp(argv[i], "--expand") == 0){
+			options->expand = value > 100 ? 100 : (int)value;
+		}
+		else if(strcmp(argv[i], "--data") == 0){
+			options->data = value > 100 ? 100 : (int)value;
+		}
+		else if(strcmp(argv[i], "--strings") == 0){
+			options->strings = value > 100 ? 100 : (int)value;
+		}
+		else if(strcmp(argv[i], "--externs") == 0){
+			options->externs = value > MAX_EXTERN_ENTRIES ? MAX_EXTERN_ENTRIES : (int)value;
+		}
+		else if(strcmp(argv[i], "--entries") == 0){
+			options->entries = value > MAX_EXTERN_ENTRIES ? MAX_EXTERN_ENTRIES : (int)value;
+		}
+		else if(strcmp(argv[i], "--comments") == 0){
+			options->comments = value > 100 ? 100 : (int)value;
+		}
+		else{
+			fprintf(stderr, "Error: unknown option '%s'\n", argv[i]);
+			return false;
+		}
+		i++;/*skip the value of the option*/
+	}
+	for(j=0, total=0 ; j<OPCODE_COUNT ; j++){
+		total += options->mix[j];
+	}
+	if(total == 0){
+		fprintf(stderr, "Error: option '--mix' must give some operation a weight\n");
+		return false;
+	}
+	if(options->files > 0 && !options->output){
+		fprintf(stderr, "Error: option '-n' requires '-o'\n");
+		return false;
+	}
+	return true;
+}
+
+/*
+* print_generator_usage
+* ---------------------
+* this function prints the knobs of the generator
+*
+* parameters:
+*   program_name: the name of the generator
+*
+*/
+void print_generator_usage(const char *program_name){
+	fprintf(stderr, "usage: %s [options] > program.as\n", program_name);
+	fprintf(stderr, "       %s -n FILES -o DIR [options]\n", program_name);
+	fprintf(stderr, "options (percentages are 0-100):\n");
+	fprintf(stderr, "  -s, --seed N        seed of the program or of the corpus (default 1)\n");
+	fprintf(stderr, "  -w, --words N       words of code and data of a program (default %d, at most %d)\n", MAX_PROGRAM_WORDS - 96, MAX_PROGRAM_WORDS);
+	fprintf(stderr, "  --mix OP=W,...      weight of the operations (every operation weighs 1 by default)\n");
+	fprintf(stderr, "  --modes M=W,...     weight of the imm rel and reg addressing modes (1 by default)\n");
+	fprintf(stderr, "  --refs P            percent of the operands that reference a label where allowed (default 30)\n");
+	fprintf(stderr, "  --extern-refs P     percent of the label references that name an extern (default 10)\n");
+	fprintf(stderr, "  --labels N          labels a program defines (default 200)\n");
+	fprintf(stderr, "  --macros N          macros a program defines (default 8, at most %d)\n", MAX_MACROS);
+	fprintf(stderr, "  --expand P          percent of the statements that expand a macro (default 10)\n");
+	fprintf(stderr, "  --data P            percent of the statements that are .data or .string (default 20)\n");
+	fprintf(stderr, "  --strings P         percent of the data statements that are .string (default 30)\n");
+	fprintf(stderr, "  --externs N         names declared .extern (default 10, at most %d)\n", MAX_EXTERN_ENTRIES);
+	fprintf(stderr, "  --entries N         labels declared .entry (default 10, at most %d)\n", MAX_EXTERN_ENTRIES);
+	fprintf(stderr, "  --comments P        percent of the statements preceded by a comment or blank line (default 20)\n");
+	fprintf(stderr, "  -n, --files N       write a corpus of N programs gen0000.as ... whose sizes vary between half and all of the words\n");
+	fprintf(stderr, "  -o, --output DIR    directory of the corpus\n");
+}
+
+/*** MAIN SECTION ***/
+
+/*
+* main
+* ----
+* this function writes a single program to stdout or a corpus of programs to a directory
+*
+* parameters:
+*   argc: the number of arguments
+*   argv: the arguments
+*
+* returns:
+*   int: 0 if every program was written 1 otherwise
+*/
+int main(int argc, char *argv[]){
+	GeneratorOptions options;
+	unsigned long state;
+	char *path;
+	FILE *file;
+	long words;
+	int i;
+	bool success = true;
+
+	if(!parse_generator_options(argc, argv, &options)){
+		print_generator_usage(argv[0]);
+		return 1;
+	}
+	if(options.files == 0){
+		return generate_program(stdout, &options, options.seed, options.words) && fflush(stdout) == 0 ? 0 : 1;
+	}
+
+	path = (char*)malloc(strlen(options.output) + 16);
+	if(!path){
+		perror("malloc failed");
+		return 1;
+	}
+	state = (options.seed ^ 0xA5A5A5A5UL) & 0xFFFFFFFFUL;
+	if(state == 0){
+		state = 1;
+	}
+	for(i=0 ; i<options.files && success ; i++){/*every program has its own seed and size*/
+		words = options.words / 2 + random_below(&state, (int)(options.words - options.words / 2) + 1);
+		sprintf(path, "%s/gen%04d.as", options.output, i);
+		file = fopen(path, "w");
+		if(!file){
+			perror(path);
+			success = false;
+			break;
+		}
+		success = generate_program(file, &options, options.seed * 1000003UL + (unsigned long)i, words);
+		success = fclose(file) == 0 && success;
+		if(!success){
+			fprintf(stderr, "Error: failed writing %s\n", path);
+		}
+	}
+	free(path);
+	return success ? 0 : 1;
+}
@@ -0,0 +1,155 @@
+#!/bin/sh
+#
+# regress.sh
+# ----------
+# assembles a corpus of programs and compares every output with the golden output kept next to the program
+# the corpus is every NAME.as of the case directories and every program is assembled four times, each run keeps its own goldens:
+#   -m                                       NAME.ob NAME.ent NAME.ext NAME.map and NAME.err (the error messages)
+#   -b --base 150                            NAME.obb
+#   -r --base 150 --report --report-json     NAME.rel NAME.report and NAME.report.json
+#   --check                                  NAME.check (everything --check prints)
+# an output the golden does not have, or a golden the run did not write, is a difference too
+# every program is then assembled REPEAT times in each of RUNS runs and its fastest assembly is kept,
+# the time is the total_ms of --stats-json less the write phase so the file system does not decide it
+# the time is compared with the median of the last 5 times HISTORY holds for the program and flagged when it is slower by more than
+# THRESHOLD (a fraction) and by more than 0.02 ms, the times are appended to HISTORY only when every output matched
+# with REGRESS_UPDATE=1 the outputs of the run become the new goldens instead of being compared
+#
+# usage: regress.sh ASSEMBLER DIR HISTORY REPEAT RUNS THRESHOLD CASEDIR...
+#   the programs are assembled in DIR/regress, the exit status is 1 when an output differs or a program got slower
+#
+# HISTORY holds a line per program per run: seconds since the epoch, the commit, the program and its time in milliseconds
+#
+
+if [ $# -lt 7 ]; then
+	echo "usage: $0 ASSEMBLER DIR HISTORY REPEAT RUNS THRESHOLD CASEDIR..." >&2
+	exit 1
+fi
+ASSEMBLER=$(cd "$(dirname "$1")" && pwd)/$(basename "$1")
+DIR=$2/regress
+HISTORY=$3
+REPEAT=$4
+RUNS=$5
+THRESHOLD=$6
+shift 6
+FAILED=0
+
+rm -rf "$DIR"
+mkdir -p "$DIR" || exit 1
+: > "$DIR/cases"
+for CASES in "$@"; do
+	for SOURCE in "$CASES"/*.as; do
+		NAME=$(basename "$SOURCE" .as)
+		if grep -qx "$NAME .*" "$DIR/cases"; then
+			echo "regress: $SOURCE has the same name as $(grep "^$NAME " "$DIR/cases" | cut -d' ' -f2)" >&2
+			exit 1
+		fi
+		cp "$SOURCE" "$DIR/" || exit 1
+		echo "$NAME $CASES" >> "$DIR/cases"
+	done
+done
+
+# check_outputs NAME CASES LOG OPTIONS SUFFIX...
+# assembles a program on its own with OPTIONS and compares (or with REGRESS_UPDATE=1 replaces) its goldens of every SUFFIX
+# LOG is the suffix of the golden of what the run prints: err keeps stderr, check keeps stdout and stderr and - keeps nothing
+check_outputs(){
+	NAME=$1
+	CASES=$2
+	LOG=$3
+	OPTIONS=$4
+	shift 4
+	rm -rf "$DIR/run" && mkdir "$DIR/run" && cp "$DIR/$NAME.as" "$DIR/run/" || exit 1
+	case $LOG in
+		err) (cd "$DIR/run" && "$ASSEMBLER" $OPTIONS "$NAME" > /dev/null 2> "$NAME.err") ;;
+		check) (cd "$DIR/run" && "$ASSEMBLER" $OPTIONS "$NAME" > "$NAME.check" 2>&1) ;;
+		*) (cd "$DIR/run" && "$ASSEMBLER" $OPTIONS "$NAME" > /dev/null 2>&1) ;;
+	esac
+	[ "$LOG" = - ] || [ -s "$DIR/run/$NAME.$LOG" ] || rm -f "$DIR/run/$NAME.$LOG"
+	for SUFFIX in "$@"; do
+		if [ "${REGRESS_UPDATE:-0}" = 1 ]; then
+			rm -f "$CASES/$NAME.$SUFFIX"
+			[ ! -f "$DIR/run/$NAME.$SUFFIX" ] || cp "$DIR/run/$NAME.$SUFFIX" "$CASES/$NAME.$SUFFIX"
+		elif [ -f "$DIR/run/$NAME.$SUFFIX" ] || [ -f "$CASES/$NAME.$SUFFIX" ]; then
+			if [ ! -f "$CASES/$NAME.$SUFFIX" ]; then
+				echo "regress: $NAME.$SUFFIX was written with '$OPTIONS' but $CASES has no golden of it" >&2
+				FAILED=1
+			elif [ ! -f "$DIR/run/$NAME.$SUFFIX" ]; then
+				echo "regress: $NAME.$SUFFIX was not written with '$OPTIONS' but $CASES has a golden of it" >&2
+				FAILED=1
+			elif ! cmp -s "$DIR/run/$NAME.$SUFFIX" "$CASES/$NAME.$SUFFIX"; then
+				echo "regress: $NAME.$SUFFIX written with '$OPTIONS' differs from $CASES/$NAME.$SUFFIX" >&2
+				diff "$CASES/$NAME.$SUFFIX" "$DIR/run/$NAME.$SUFFIX" | head -10 >&2
+				FAILED=1
+			fi
+		fi
+	done
+}
+
+while read -r NAME CASES; do
+	check_outputs "$NAME" "$CASES" err "-m" ob ent ext map err
+	check_outputs "$NAME" "$CASES" - "-b --base 150" obb
+	check_outputs "$NAME" "$CASES" - "-r --base 150 --report --report-json" rel report report.json
+	check_outputs "$NAME" "$CASES" check "--check" check
+done < "$DIR/cases"
+rm -rf "$DIR/run"
+if [ "${REGRESS_UPDATE:-0}" = 1 ]; then
+	echo "regress: updated the goldens of $(wc -l < "$DIR/cases") programs"
+	exit 0
+fi
+
+# measure
+# prints the fastest time of every program in milliseconds as NAME MS lines
+: > "$DIR/list"
+I=0
+while [ $I -lt "$REPEAT" ]; do
+	cut -d' ' -f1 "$DIR/cases" >> "$DIR/list"
+	I=$((I + 1))
+done
+: > "$DIR/times"
+RUN=0
+while [ $RUN -lt "$RUNS" ]; do
+	(cd "$DIR" && "$ASSEMBLER" --max-errors 0 --stats-json times.json @list > /dev/null 2>&1)
+	grep -o '"name":"[^"]*","success":[a-z]*,"total_ms":[0-9.]*,"phases_ms":{[^}]*}' "$DIR/times.json" |
+		sed 's/"name":"\([^"]*\)".*"total_ms":\([0-9.]*\).*"write":\([0-9.]*\)}/\1 \2 \3/' | awk '{ printf "%s %.3f\n", $1, $2 - $3 }' >> "$DIR/times"
+	RUN=$((RUN + 1))
+done
+sort -k1,1 -k2,2n "$DIR/times" | awk '$1 != last { print; last = $1 }' > "$DIR/fastest"
+if [ "$(wc -l < "$DIR/fastest")" -ne "$(wc -l < "$DIR/cases")" ]; then
+	echo "regress: no statistics for some programs (is the assembler built with STATS=0?)" >&2
+	exit 1
+fi
+
+# compare the times with the history
+touch "$HISTORY" || exit 1
+COMMIT=$(git rev-parse --short HEAD 2>/dev/null || echo unknown)
+NOW=$(date +%s)
+printf "%-24s %10s %10s %8s\n" "program" "ms" "median ms" "change"
+awk -v threshold="$THRESHOLD" -v history="$HISTORY" '
+	BEGIN {
+		while((getline line < history) > 0){
+			split(line, field, " ")
+			count[field[3]]++
+			times[field[3], count[field[3]]] = field[4]
+		}
+	}
+	{
+		n = count[$1] > 5 ? 5 : count[$1]
+		if(n == 0){
+			printf "%-24s %10.3f %10s %8s new\n", $1, $2, "-", "-"
+			next
+		}
+		for(i=1 ; i<=n ; i++) recent[i] = times[$1, count[$1] - n + i]
+		for(i=1 ; i<=n ; i++) for(j=i+1 ; j<=n ; j++) if(recent[j] < recent[i]){ t = recent[i]; recent[i] = recent[j]; recent[j] = t }
+		median = n % 2 ? recent[(n + 1) / 2] : (recent[n / 2] + recent[n / 2 + 1]) / 2
+		slower = $2 > median * (1 + threshold) && $2 - median > 0.02
+		printf "%-24s %10.3f %10.3f %+7.1f%% %s\n", $1, $2, median, (median > 0 ? ($2 / median - 1) * 100 : 0), (slower ? "SLOWER" : "ok")
+		failed = failed || slower
+	}
+	END { exit failed }' "$DIR/fastest" || SLOWER=1
+if [ $FAILED -eq 0 ]; then
+	sed "s/^/$NOW $COMMIT /" "$DIR/fastest" >> "$HISTORY"
+else
+	echo "regress: outputs differ so the times were not added to $HISTORY" >&2
+fi
+[ -z "$SLOWER" ] || FAILED=1
+exit $FAILED
@@ -0,0 +1,126 @@
+#!/bin/sh
+#
+# scaling.sh
+# ----------
+# checks that the time to assemble a file grows no faster than n log n along every axis of its size
+# for every axis a program is generated at the sizes n 2n 4n and 8n while everything else stays small
+# every program is assembled REPEAT times in each of RUNS runs and its fastest assembly is kept so a stall of the file system is not counted,
+# the time is the total_ms --stats-json reports for the file so starting the process is not counted either
+# the time of a program holding a single stop is the cost of a file of any size and is taken off every time
+# the growth exponent is the slope of a least squares fit of log(time) against log(n)
+# and an axis fails when its exponent exceeds the exponent n log n has over the same sizes by more than TOLERANCE
+#
+# usage: scaling.sh ASSEMBLER DIR REPEAT RUNS TOLERANCE
+#   the programs live in DIR/scaling, the exit status is 1 when any axis failed
+#
+# axes:
+#   labels      n labels each defined on a .data line
+#   references  n labels and an operation that references each of them
+#   macros      n macros each expanded once
+#   externs     n externs each referenced 26 times (an extern reference is logged for every one)
+#               12 to 96 is the whole range because a file may declare at most MAX_EXTERN_ENTRIES (100) externs
+#   line_length 64 lines of n characters (longer than a line may be, so the time to reject them is measured)
+#
+
+if [ $# -ne 5 ]; then
+	echo "usage: $0 ASSEMBLER DIR REPEAT RUNS TOLERANCE" >&2
+	exit 1
+fi
+ASSEMBLER=$1
+DIR=$2/scaling
+REPEAT=$3
+RUNS=$4
+TOLERANCE=$5
+FAILED=0
+
+rm -rf "$DIR"
+mkdir -p "$DIR" || exit 1
+
+# generate_program AXIS N
+# writes the program of an axis at a size to stdout
+generate_program(){
+	awk -v axis="$1" -v n="$2" 'BEGIN {
+		if(axis == "labels"){
+			for(i=0 ; i<n ; i++) printf "L%d: .data %d\n", i, i
+		}
+		else if(axis == "references"){
+			for(i=0 ; i<n ; i++) printf "L%d: .data %d\n", i, i
+			for(i=n-1 ; i>=0 ; i--) printf "jmp L%d\n", i
+		}
+		else if(axis == "macros"){
+			for(i=0 ; i<n ; i++) printf "macr M%d\nstop\nendmacr\n", i
+			for(i=n-1 ; i>=0 ; i--) printf "M%d\n", i
+		}
+		else if(axis == "externs"){
+			for(i=0 ; i<n ; i++) printf ".extern X%d\n", i
+			for(j=0 ; j<13 ; j++) for(i=0 ; i<n ; i++) printf "mov X%d, X%d\n", i, (i + j) % n
+		}
+		else if(axis == "empty"){
+			print "stop"
+		}
+		else if(axis == "line_length"){
+			for(j=0 ; j<64 ; j++){
+				printf ".data 1"
+				for(i=7 ; i<n ; i+=2) printf ",1"
+				printf "\n"
+			}
+		}
+	}'
+}
+
+# measure AXIS N
+# prints the fastest time in milliseconds to assemble the program of an axis once
+measure(){
+	NAME=$DIR/$1_$2
+	generate_program "$1" "$2" > "$NAME.as"
+	: > "$NAME.list"
+	I=0
+	while [ $I -lt "$REPEAT" ]; do
+		echo "$NAME" >> "$NAME.list"
+		I=$((I + 1))
+	done
+	: > "$NAME.times"
+	RUN=0
+	while [ $RUN -lt "$RUNS" ]; do
+		"$ASSEMBLER" --max-errors 0 --stats-json "$NAME.json" "@$NAME.list" > /dev/null 2>&1
+		if [ "$1" != "line_length" ] && ! grep -q "\"succeeded\":$REPEAT," "$NAME.json"; then
+			echo "scaling: $NAME.as does not assemble" >&2
+			exit 1
+		fi
+		grep -o '"total_ms":[0-9.]*' "$NAME.json" | sed '$d' >> "$NAME.times"
+		RUN=$((RUN + 1))
+	done
+	sed 's/.*://' "$NAME.times" | sort -n | sed -n 1p | grep . || { echo "scaling: no statistics for $NAME.as" >&2; exit 1; }
+}
+
+# check_axis AXIS N
+# measures an axis at n 2n 4n and 8n and fails it when it grows faster than n log n
+check_axis(){
+	SAMPLES=""
+	for SIZE in $2 $(($2 * 2)) $(($2 * 4)) $(($2 * 8)); do
+		SAMPLES="$SAMPLES $SIZE $(measure "$1" "$SIZE")" || exit 1
+	done
+	echo "$SAMPLES" | awk -v axis="$1" -v tolerance="$TOLERANCE" -v base="$BASE" '{
+		for(i=1 ; i<NF ; i+=2){
+			t = $(i + 1) - base > 0.0001 ? $(i + 1) - base : 0.0001
+			x = log($i); k++
+			sx += x; sxx += x * x
+			sy += log(t); sxy += x * log(t)
+			sr += log($i * log($i)); sxr += x * log($i * log($i))
+			times = times sprintf(" %6d:%7.3f", $i, t)
+		}
+		exponent = (k * sxy - sx * sy) / (k * sxx - sx * sx)
+		limit = (k * sxr - sx * sr) / (k * sxx - sx * sx) + tolerance
+		printf "%-12s%s  exponent %5.2f limit %5.2f %s\n", axis, times, exponent, limit, (exponent > limit ? "FAILED" : "ok")
+		exit (exponent > limit)
+	}'
+}
+
+BASE=$(measure empty 1) || exit 1
+echo "n:ms fastest of $REPEAT x $RUNS assemblies, less the $BASE ms of a file holding a single stop"
+check_axis labels 400 || FAILED=1
+check_axis references 160 || FAILED=1
+check_axis macros 400 || FAILED=1
+check_axis externs 12 || FAILED=1
+check_axis line_length 200 || FAILED=1
+exit $FAILED
@@ -0,0 +1,695 @@
+#include "cache.h"
+#include "diagnostics.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <dirent.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+/*** CACHE DIRECTORY SECTION ***/
+
+typedef struct{/*an entry found while the cache is scanned for eviction*/
+	char *path;/*path of the entry directory*/
+	time_t used;/*last time the entry was stored or restored*/
+	unsigned long size;/*total size of its files*/
+}CacheEntry;
+
+/*
+* cache_mutex
+* -----------
+* the lock file only excludes other processes so the threads of a -j run take this mutex first
+*/
+pthread_mutex_t cache_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+/*
+* entry_path
+* ----------
+* this function builds the path of the entry of a key inside the cache directory
+*
+* parameters:
+*   directory: the cache directory
+*   key: the key
+*   subdirectory_only: true to stop at the subdirectory that holds the entry
+*
+* returns:
+*   char*: the path (freed by the caller) or NULL if memory allocation failed
+*/
+char *entry_path(const char *directory, const char *key, bool subdirectory_only){
+	char *path = (char*)malloc(strlen(directory) + CACHE_KEY_LENGTH + 6);
+
+	if(path){
+		sprintf(path, "%s/%.2s", directory, key);
+		if(!subdirectory_only){
+			sprintf(path + strlen(path), "/%s", key);
+		}
+	}
+	return path;
+}
+
+/*
+* lock_cache
+* ----------
+* this function gives the calling thread exclusive access to the stats of the cache
+* the directory and its tmp subdirectory are created the first time the cache is used
+*
+* parameters:
+*   directory: the cache directory
+*
+* returns:
+*   int: the descriptor of the lock file to pass to unlock_cache or -1 if the cache can't be used
+*/
+int lock_cache(const char *directory){
+	struct flock lock;
+	char *path;
+	int fd;
+
+	pthread_mutex_lock(&cache_mutex);
+	mkdir(directory, 0777);/*the directories usually exist already*/
+	path = make_path(directory, "/tmp", NULL);
+	if(path){
+		mkdir(path, 0777);
+		free(path);
+	}
+	path = make_path(directory, "/lock", NULL);
+	fd = path ? open(path, O_RDWR | O_CREAT, 0666) : -1;
+	free(path);
+	if(fd < 0){
+		pthread_mutex_unlock(&cache_mutex);
+		return -1;
+	}
+	memset(&lock, 0, sizeof(lock));
+	lock.l_type = F_WRLCK;
+	lock.l_whence = SEEK_SET;
+	while(fcntl(fd, F_SETLKW, &lock) != 0 && errno == EINTR);
+	return fd;
+}
+
+/*
+* unlock_cache
+* ------------
+* this function releases the lock taken by lock_cache
+*
+* parameters:
+*   fd: the descriptor returned by lock_cache
+*
+*/
+void unlock_cache(int fd){
+	close(fd);/*closing the descriptor releases the record lock*/
+	pthread_mutex_unlock(&cache_mutex);
+}
+
+/*
+* read_stats
+* ----------
+* this function reads the counters of the cache (all zero when the stats file does not exist yet)
+*
+* parameters:
+*   directory: the cache directory
+*   stats: the counters to fill
+*
+*/
+void read_stats(const char *directory, CacheStats *stats){
+	char *path = make_path(directory, "/stats", NULL);
+	FILE *file = path ? fopen(path, "r") : NULL;
+	char name[32];
+	unsigned long value;
+
+	memset(stats, 0, sizeof(CacheStats));
+	while(file && fscanf(file, "%31s %lu", name, &value) == 2){
+		if(strcmp(name, "hits") == 0){
+			stats->hits = value;
+		}
+		else if(strcmp(name, "misses") == 0){
+			stats->misses = value;
+		}
+		else if(strcmp(name, "stores") == 0){
+			stats->stores = value;
+		}
+		else if(strcmp(name, "evictions") == 0){
+			stats->evictions = value;
+		}
+		else if(strcmp(name, "size") == 0){
+			stats->size = value;
+		}
+		else if(strcmp(name, "entries") == 0){
+			stats->entries = value;
+		}
+	}
+	if(file){
+		fclose(file);
+	}
+	free(path);
+}
+
+/*
+* write_stats
+* -----------
+* this function replaces the stats file of the cache
+*
+* parameters:
+*   directory: the cache directory
+*   stats: the counters to write
+*
+*/
+void write_stats(const char *directory, const CacheStats *stats){
+	char *path = make_path(directory, "/stats", NULL);
+	char *temporary = make_path(directory, "/stats.tmp", NULL);
+	FILE *file = path && temporary ? fopen(temporary, "w") : NULL;
+
+	if(file){
+		fprintf(file, "version %d\nhits %lu\nmisses %lu\nstores %lu\nevictions %lu\nsize %lu\nentries %lu\n", CACHE_FORMAT_VERSION, stats->hits, stats->misses, stats->stores, stats->evictions, stats->size, stats->entries);
+		if(fclose(file) == 0){
+			rename(temporary, path);
+		}
+	}
+	free(path);
+	free(temporary);
+}
+
+/*
+* remove_entry
+* ------------
+* this function removes an entry directory and the output files it holds
+*
+* parameters:
+*   path: the path of the entry directory
+*
+*/
+void remove_entry(const char *path){
+	char *file;
+	int i;
+
+	for(i=0 ; i<SINK_OUTPUT_COUNT ; i++){
+		file = make_path(path, "/", sink_extensions[i] + 1);
+		if(file){
+			unlink(file);
+			free(file);
+		}
+	}
+	rmdir(path);
+}
+
+/*
+* discard_entry
+* -------------
+* this function moves an entry out of the way with a single rename and then removes it
+* a restore that runs at the same time finds either the whole entry or nothing
+*
+* parameters:
+*   directory: the cache directory
+*   path: the path of the entry directory
+*
+*/
+void discard_entry(const char *directory, const char *path){
+	char *temporary = make_path(directory, "/tmp/evict-XXXXXX", NULL);
+
+	if(temporary && mkdtemp(temporary) && rename(path, temporary) == 0){/*an empty directory can be replaced*/
+		remove_entry(temporary);
+	}
+	else{
+		if(temporary){
+			rmdir(temporary);
+		}
+		remove_entry(path);
+	}
+	free(temporary);
+}
+
+/*
+* entry_size
+* ----------
+* this function adds up the size of the files of an entry
+*
+* parameters:
+*   path: the path of the entry directory
+*
+* returns:
+*   unsigned long: the size in bytes
+*/
+unsigned long entry_size(const char *path){
+	struct stat status;
+	unsigned long size = 0;
+	char *file;
+	int i;
+
+	for(i=0 ; i<SINK_OUTPUT_COUNT ; i++){
+		file = make_path(path, "/", sink_extensions[i] + 1);
+		if(file && stat(file, &status) == 0){
+			size += (unsigned long)status.st_size;
+		}
+		free(file);
+	}
+	return size;
+}
+
+/*
+* compare_entries
+* ---------------
+* this function orders the entries of a scan from the least recently used
+*
+* parameters:
+*   first: the first CacheEntry
+*   second: the second CacheEntry
+*
+* returns:
+*   int: a negative number a zero or a positive number like strcmp
+*/
+int compare_entries(const void *first, const void *second){
+	const CacheEntry *a = (const CacheEntry*)first, *b = (const CacheEntry*)second;
+
+	return a->used < b->used ? -1 : a->used > b->used;
+}
+
+/*
+* evict_entries
+* -------------
+* this function removes the least recently used entries until the cache is below CACHE_EVICTION_TARGET percent of its limit
+* the whole cache is scanned so the size and the number of entries in the stats are also corrected
+* it is called with the cache locked and only when the size passed the limit
+*
+* parameters:
+*   directory: the cache directory
+*   limit: the size limit in bytes
+*   stats: the counters to update
+*
+*/
+void evict_entries(const char *directory, unsigned long limit, CacheStats *stats){
+	CacheEntry *entries = NULL, *grown;
+	size_t count = 0, capacity = 0, i;
+	char subdirectory[3];
+	char *subdirectory_path, *path;
+	struct dirent *found;
+	struct stat status;
+	DIR *scan;
+	int first, second;
+	const char *digits = "0123456789abcdef";
+	unsigned long total = 0, target = limit / 100 * CACHE_EVICTION_TARGET;
+
+	for(first=0 ; first<16 ; first++){/*scan every subdirectory*/
+		for(second=0 ; second<16 ; second++){
+			sprintf(subdirectory, "%c%c", digits[first], digits[second]);
+			subdirectory_path = make_path(directory, "/", subdirectory);
+			scan = subdirectory_path ? opendir(subdirectory_path) : NULL;
+			while(scan && (found = readdir(scan)) != NULL){
+				if(strlen(found->d_name) != CACHE_KEY_LENGTH){/*skip . and ..*/
+					continue;
+				}
+				path = make_path(subdirectory_path, "/", found->d_name);
+				if(!path || stat(path, &status) != 0){
+					free(path);
+					continue;
+				}
+				if(count == capacity){
+					capacity = capacity ? capacity * 2 : 256;
+					grown = (CacheEntry*)realloc(entries, capacity * sizeof(CacheEntry));
+					if(!grown){
+						free(path);
+						break;
+					}
+					entries = grown;
+				}
+				entries[count].path = path;
+				entries[count].used = status.st_mtime;
+				entries[count].size = entry_size(path);
+				total += entries[count].size;
+				count++;
+			}
+			if(scan){
+				closedir(scan);
+			}
+			free(subdirectory_path);
+		}
+	}
+
+	if(count > 0){
+		qsort(entries, count, sizeof(CacheEntry), compare_entries);
+	}
+	stats->entries = count;
+	for(i=0 ; i<count ; i++){
+		if(total > target){/*remove the oldest entries first*/
+			discard_entry(directory, entries[i].path);
+			total -= entries[i].size;
+			stats->entries--;
+			stats->evictions++;
+		}
+		free(entries[i].path);
+	}
+	free(entries);
+	stats->size = total;
+}
+
+/*
+* update_stats
+* ------------
+* this function adds to the counters of the cache and evicts entries when the size limit is passed
+*
+* parameters:
+*   options: the options that hold the cache directory and its size limit
+*   hits: number of hits to add
+*   misses: number of misses to add
+*   stored: the size of an entry that was added or 0
+*
+*/
+void update_stats(const AssemblerOptions *options, unsigned long hits, unsigned long misses, unsigned long stored){
+	CacheStats stats;
+	int lock = lock_cache(options->cache_directory);
+
+	if(lock < 0){
+		return;
+	}
+	read_stats(options->cache_directory, &stats);
+	stats.hits += hits;
+	stats.misses += misses;
+	if(stored > 0){
+		stats.stores++;
+		stats.entries++;
+		stats.size += stored;
+	}
+	if(stats.size > (unsigned long)options->cache_size){
+		evict_entries(options->cache_directory, (unsigned long)options->cache_size, &stats);
+	}
+	write_stats(options->cache_directory, &stats);
+	unlock_cache(lock);
+}
+
+/*** STORING AND RESTORING SECTION ***/
+
+/*
+* copy_file
+* ---------
+* this function copies a file and gives the copy the requested permissions
+*
+* parameters:
+*   source: the path of the file to copy
+*   destination: the path of the copy
+*   mode: the permissions of the copy
+*
+* returns:
+*   bool: true if the file was copied false otherwise
+*/
+bool copy_file(const char *source, const char *destination, int mode){
+	char buffer[16384];
+	size_t count;
+	FILE *input, *output;
+	bool success = true;
+	int fd;
+
+	input = fopen(source, "rb");
+	if(!input){
+		return false;
+	}
+	fd = open(destination, O_WRONLY | O_CREAT | O_TRUNC, mode);
+	output = fd >= 0 ? fdopen(fd, "wb") : NULL;
+	if(!output){
+		if(fd >= 0){
+			close(fd);
+		}
+		fclose(input);
+		return false;
+	}
+	while((count = fread(buffer, 1, sizeof(buffer), input)) > 0){
+		success = success && fwrite(buffer, 1, count, output) == count;
+	}
+	success = success && !ferror(input);
+	fclose(input);
+	success = fclose(output) == 0 && success;
+	if(!success){
+		unlink(destination);
+	}
+	return success;
+}
+
+/*
+* cache_key
+* ---------
+* this function computes the key of a preprocessed source
+* the key covers the version of the assembler the options that change the outputs and the preprocessed source
+* and with -m the line map too since the .map file depends on lines the preprocessed source no longer has
+* and with --report or --report-json the cost table
+* and with any of them the name of the source since the .map file and the reports name it
+*
+* parameters:
+*   name: the base name of the source as the outputs name it
+*   preprocessed: the preprocessed source
+*   size: the length of the preprocessed source
+*   map: the source line of every preprocessed line for the error messages and the .map file or NULL
+*   options: the command line options
+*   key: the buffer that receives the key as hexadecimal digits
+*
+*/
+void cache_key(const char *name, const char *preprocessed, size_t size, const LineMap *map, const AssemblerOptions *options, char key[CACHE_KEY_LENGTH + 1]){
+	unsigned char digest[SHA256_DIGEST_LENGTH];
+	char settings[128];
+	Sha256 hash;
+	int i;
+
+	sprintf(settings, "assembler %s cache %d format %d base %ld reloc %d map %d report %d %d\n", ASSEMBLER_VERSION, CACHE_FORMAT_VERSION, (int)options->format, options->load_base,
+		(int)options->write_relocations, map != NULL, (int)options->write_report, (int)options->write_report_json);
+	sha256_start(&hash);
+	sha256_update(&hash, settings, strlen(settings) + 1);/*the null terminator separates the settings from the source*/
+	if(options->write_report || options->write_report_json){
+		sha256_update(&hash, &options->cost_table, sizeof(CostTable));/*the cycles change the reports*/
+	}
+	sha256_update(&hash, preprocessed, size);
+	if(map || options->write_report || options->write_report_json){
+		sha256_update(&hash, name, strlen(name) + 1);/*the .map file and the reports name their source*/
+	}
+	if(map){
+		sha256_update(&hash, map->lines, map->count * sizeof(int));
+		if(map->origins){
+			sha256_update(&hash, map->origins, map->count * sizeof(LineOrigin));
+		}
+		for(i=0 ; i<map->macro_count ; i++){
+			sha256_update(&hash, map->macro_names[i], strlen(map->macro_names[i]) + 1);
+		}
+	}
+	sha256_finish(&hash, digest);
+	sha256_hex(digest, key);
+}
+
+/*
+* cache_restore
+* -------------
+* this function restores the outputs of a key next to the source file
+* every output is copied from the cache under a temporary name and renamed only once all of them are in place
+* the outputs are copied rather than hard linked so they get the usual mode and editing or rebuilding one never touches the entry
+*
+* parameters:
+*   options: the options that hold the cache directory
+*   key: the key of the preprocessed source
+*   basename: the base name of the output files
+*
+* returns:
+*   bool: true on a hit false if the key is not in the cache or its outputs couldn't be restored
+*/
+bool cache_restore(const AssemblerOptions *options, const char *key, const char *basename){
+	char *entry, *cached[SINK_OUTPUT_COUNT] = {0}, *temporary[SINK_OUTPUT_COUNT] = {0}, *final;
+	struct stat status;
+	bool success, found = false;
+	int i;
+
+	entry = entry_path(options->cache_directory, key, false);
+	success = entry != NULL && stat(entry, &status) == 0;
+	for(i=0 ; success && i<SINK_OUTPUT_COUNT ; i++){
+		cached[i] = make_path(entry, "/", sink_extensions[i] + 1);
+		success = cached[i] != NULL;
+		if(!success || stat(cached[i], &status) != 0){/*this output was not written*/
+			continue;
+		}
+		temporary[i] = make_path(basename, sink_extensions[i], ".tmp");
+		success = temporary[i] != NULL;
+		if(success){
+			unlink(temporary[i]);
+			success = copy_file(cached[i], temporary[i], 0666);
+			found = true;
+		}
+	}
+	success = success && found;
+	for(i=0 ; i<SINK_OUTPUT_COUNT ; i++){/*give the outputs their final names or remove them*/
+		if(temporary[i]){
+			final = success ? make_path(basename, sink_extensions[i], NULL) : NULL;
+			if(!final || rename(temporary[i], final) != 0){
+				unlink(temporary[i]);
+				success = false;
+			}
+			free(final);
+		}
+		free(cached[i]);
+		free(temporary[i]);
+	}
+	if(success){
+		utimensat(AT_FDCWD, entry, NULL, 0);/*mark the entry as recently used*/
+	}
+	free(entry);
+	return success;
+}
+
+/*
+* cache_store
+* -----------
+* this function copies the committed outputs of a sink into a new entry of the cache
+* the copies are read only so nothing edits an entry in place by accident
+* the entry is built in DIR/tmp and moved to its place with a single rename
+*
+* parameters:
+*   options: the options that hold the cache directory
+*   key: the key of the preprocessed source
+*   basename: the base name of the output files
+*   sink: the committed disk sink that wrote the outputs
+*
+*/
+void cache_store(const AssemblerOptions *options, const char *key, const char *basename, const ObjectSink *sink){
+	char *staging, *entry, *subdirectory, *output, *cached;
+	unsigned long size = 0;
+	struct stat status;
+	bool success;
+	int i, lock;
+
+	lock = lock_cache(options->cache_directory);/*create the cache directories*/
+	if(lock < 0){
+		return;
+	}
+	unlock_cache(lock);
+	staging = make_path(options->cache_directory, "/tmp/entry-XXXXXX", NULL);
+	success = staging != NULL && mkdtemp(staging) != NULL;
+	for(i=0 ; success && i<SINK_OUTPUT_COUNT ; i++){
+		if(!sink->outputs[i].opened){
+			continue;
+		}
+		output = make_path(basename, sink_extensions[i], NULL);
+		cached = make_path(staging, "/", sink_extensions[i] + 1);
+		success = output && cached && copy_file(output, cached, 0444);
+		if(success && stat(cached, &status) == 0){
+			size += (unsigned long)status.st_size;
+		}
+		free(output);
+		free(cached);
+	}
+
+	entry = entry_path(options->cache_directory, key, false);
+	subdirectory = entry_path(options->cache_directory, key, true);
+	if(success && entry && subdirectory){
+		mkdir(subdirectory, 0777);
+		success = rename(staging, entry) == 0;/*fails when another run stored the same key first*/
+	}
+	else{
+		success = false;
+	}
+	if(success){
+		update_stats(options, 0, 0, size);
+	}
+	else if(staging){
+		remove_entry(staging);/*also removes a staging directory that was never filled*/
+	}
+	free(staging);
+	free(entry);
+	free(subdirectory);
+}
+
+/*
+* process_file_cached
+* -------------------
+* this function is process_file with the output cache in front of the two passes
+* the source is preprocessed and hashed and on a hit the outputs are restored without running either pass
+* on a miss the file is assembled as usual and its outputs are stored
+*
+* parameters:
+*   basename: the base name of the file to be processed (without extension)
+*   output: the base name of the output files
+*   source: the stream holding the assembly source
+*   options: the command line options including the cache directory
+*
+* returns:
+*   bool: true if the file was restored or assembled false otherwise
+*/
+bool process_file_cached(const char *basename, const char *output, FILE *source, const AssemblerOptions *options){
+	char key[CACHE_KEY_LENGTH + 1];
+	char *preprocessed;
+	size_t preprocessed_size;
+	LineMap map;
+	bool success;
+
+	initialize_line_map(&map, options->write_map);
+	preprocessed = preprocess_source(basename, source, &preprocessed_size, &map);
+	if(!preprocessed){
+		free_line_map(&map);
+		return false;
+	}
+	cache_key(basename, preprocessed, preprocessed_size, options->write_map ? &map : NULL, options, key);/*the lines only change the outputs through the .map file*/
+	success = process_preprocessed_cached(basename, output, preprocessed, preprocessed_size, &map, key, options);
+	free_line_map(&map);
+	free(preprocessed);
+	return success;
+}
+
+/*
+* process_preprocessed_cached
+* ---------------------------
+* this function restores the outputs of a preprocessed source from the cache or assembles and stores them
+*
+* parameters:
+*   basename: the base name of the file to be processed (without extension)
+*   output: the base name of the output files
+*   preprocessed: the preprocessed source
+*   size: the length of the preprocessed source
+*   map: the source line of every preprocessed line for the error messages and the .map file or NULL
+*   key: the key computed by cache_key
+*   options: the command line options including the cache directory
+*
+* returns:
+*   bool: true if the file was restored or assembled false otherwise
+*/
+bool process_preprocessed_cached(const char *basename, const char *output, const char *preprocessed, size_t size, const LineMap *map, const char *key, const AssemblerOptions *options){
+	ObjectSink sink;
+	bool success;
+
+	if(cache_restore(options, key, output)){/*a hit skips both passes*/
+		update_stats(options, 1, 0, 0);
+		fprintf(message_output(), "Assembler succeeded for file %s\n", basename);
+		return true;
+	}
+	update_stats(options, 0, 1, 0);
+
+	initialize_object_sink(&sink, output, false);
+	sink.line_map = map;
+	success = process_preprocessed(basename, preprocessed, size, &sink, options);
+	if(success){
+		cache_store(options, key, output, &sink);
+	}
+	return success;
+}
+
+/*
+* print_cache_stats
+* -----------------
+* this function prints the counters of the cache
+*
+* parameters:
+*   options: the options that hold the cache directory and its size limit
+*
+* returns:
+*   bool: true if the stats were printed false if the cache can't be used
+*/
+bool print_cache_stats(const AssemblerOptions *options){
+	CacheStats stats;
+	unsigned long lookups;
+	int lock = lock_cache(options->cache_directory);
+
+	if(lock < 0){
+		fprintf(stderr, "Error: can't use the cache directory %s\n", options->cache_directory);
+		return false;
+	}
+	read_stats(options->cache_directory, &stats);
+	unlock_cache(lock);
+	lookups = stats.hits + stats.misses;
+	printf("cache directory  %s\n", options->cache_directory);
+	printf("hits             %lu\n", stats.hits);
+	printf("misses           %lu\n", stats.misses);
+	printf("hit rate         %.1f%%\n", lookups ? 100.0 * stats.hits / lookups : 0.0);
+	printf("entries          %lu\n", stats.entries);
+	printf("stores           %lu\n", stats.stores);
+	printf("evictions        %lu\n", stats.evictions);
+	printf("size             %.1f MB of %.1f MB\n", stats.size / 1048576.0, options->cache_size / 1048576.0);
+	return true;
+}
@@ -0,0 +1,52 @@
+#ifndef CACHE_H
+#define CACHE_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "definitions.h"
+#include "options.h"
+#include "file_writer.h"
+#include "libassembler.h"
+#include "sha256.h"
+
+#define CACHE_KEY_LENGTH (2*SHA256_DIGEST_LENGTH)/*number of hexadecimal digits of a key*/
+#define CACHE_FORMAT_VERSION 1/*version of the layout of the cache directory*/
+#define CACHE_DEFAULT_SIZE 256/*default size limit of the cache in megabytes*/
+#define CACHE_EVICTION_TARGET 90/*percent of the size limit left after an eviction*/
+
+/*
+* cache layout
+* ------------
+* DIR/stats        hit miss store and eviction counters with the size and the number of entries
+* DIR/lock         locked while the stats are updated or entries are evicted
+* DIR/tmp/         entries being stored or evicted
+* DIR/ab/abcd...   one directory per key (the first two digits of the key pick the subdirectory)
+*                  holding a read only file per output named after its extension (ob ent ext rel obb)
+*
+* the key is the SHA-256 of ASSEMBLER_VERSION the options that change the outputs and the preprocessed source
+* so editing a macro or a comment that survives preprocessing changes the key while the file name does not matter
+* an entry appears and disappears with a single rename so a concurrent restore sees all of it or none of it
+*/
+
+/*** STRUCTURE DEFINITIONS SECTION ***/
+
+typedef struct{/*the counters kept in DIR/stats*/
+	unsigned long hits;/*files restored from the cache*/
+	unsigned long misses;/*files that were assembled because they were not in the cache*/
+	unsigned long stores;/*entries added*/
+	unsigned long evictions;/*entries removed to respect the size limit*/
+	unsigned long size;/*total size of the entries in bytes*/
+	unsigned long entries;/*number of entries*/
+}CacheStats;
+
+/*** FUNCTION PROTOTYPES SECTION ***/
+
+void cache_key(const char *name,const char *preprocessed,size_t size,const LineMap *map,const AssemblerOptions *options,char key[CACHE_KEY_LENGTH + 1]);/*function to compute the key of a preprocessed source*/
+bool cache_restore(const AssemblerOptions *options,const char *key,const char *basename);/*function to restore the outputs of a key*/
+void cache_store(const AssemblerOptions *options,const char *key,const char *basename,const ObjectSink *sink);/*function to add the committed outputs of a sink to the cache*/
+bool process_file_cached(const char *basename,const char *output,FILE *source,const AssemblerOptions *options);/*function to restore the outputs of a file or assemble and cache them*/
+bool process_preprocessed_cached(const char *basename,const char *output,const char *preprocessed,size_t size,const LineMap *map,const char *key,const AssemblerOptions *options);/*function to restore the outputs of a preprocessed source or assemble and cache them*/
+bool print_cache_stats(const AssemblerOptions *options);/*function to print the counters of the cache*/
+
+#endif /*CACHE_H*/
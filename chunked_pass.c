@@ -0,0 +1,424 @@
+#include "chunked_pass.h"
+#include "stats.h"
+#include "diagnostics.h"
+#include "source_map.h"
+#include "cost_report.h"
+
+/*** CHUNK SECTION ***/
+
+/*
+* split_chunks
+* ------------
+* this function splits a preprocessed source into chunks of about the same size that end after a newline
+* a line is never cut so every chunk can be read by the passes like a whole source
+*
+* parameters:
+*   preprocessed: the preprocessed source
+*   size: the length of the preprocessed source
+*   jobs: the number of threads the chunks are run on
+*   chunks: a pointer that receives the chunks (freed by the caller)
+*
+* returns:
+*   int: the number of chunks (0 if the source is too small to split or memory ran out)
+*/
+int split_chunks(const char *preprocessed, size_t size, int jobs, SourceChunk **chunks){
+	const char *position = preprocessed, *end = preprocessed + size, *cut;
+	int count = jobs * CHUNKS_PER_JOB, i = 0;
+
+	*chunks = NULL;
+	if((size_t)count > size / CHUNK_MIN_SIZE){/*a chunk is never smaller than CHUNK_MIN_SIZE*/
+		count = (int)(size / CHUNK_MIN_SIZE);
+	}
+	if(count < 2){
+		return 0;
+	}
+	*chunks = (SourceChunk*)calloc(count, sizeof(SourceChunk));
+	if(!*chunks){
+		return 0;
+	}
+	while(position < end && i < count){
+		cut = i == count - 1 ? end : position + (end - position) / (count - i);/*share what is left among the chunks left*/
+		cut = cut < end ? (const char*)memchr(cut, '\n', end - cut) : NULL;
+		cut = cut ? cut + 1 : end;/*end the chunk after the newline*/
+		(*chunks)[i].start = position;
+		(*chunks)[i].length = cut - position;
+		initialize_extern_entry_array(&(*chunks)[i].directives);
+		position = cut;
+		i++;
+	}
+	return i;
+}
+
+/*
+* capture_chunk_output
+* --------------------
+* this function sends everything the calling worker prints to a buffer
+* a chunk must not print because its line numbers and addresses are local to it
+*
+* parameters:
+*   text: a pointer that receives the buffer
+*   size: a pointer that receives the length of the buffer
+*
+* returns:
+*   FILE*: the stream the messages are collected in or NULL if it could not be opened
+*/
+FILE *capture_chunk_output(char **text, size_t *size){
+	FILE *capture;
+
+	*text = NULL;
+	*size = 0;
+	capture = open_memstream(text, size);
+	if(capture){
+		redirect_output(capture, capture);
+	}
+	return capture;
+}
+
+/*
+* release_chunk_output
+* --------------------
+* this function gives the calling worker its output back and drops what the chunk printed
+*
+* parameters:
+*   capture: the stream opened by capture_chunk_output
+*   text: the buffer of the stream
+*   size: the length of the buffer
+*
+* returns:
+*   bool: true if the chunk printed nothing false otherwise
+*/
+bool release_chunk_output(FILE *capture, char **text, size_t *size){
+	bool silent;
+
+	redirect_output(NULL, NULL);
+	fclose(capture);
+	silent = *size == 0;
+	free(*text);
+	return silent;
+}
+
+/*
+* size_chunk
+* ----------
+* this function is the task that runs the first pass over a single chunk
+* the addresses of the chunk start at IC_INIT_VALUE and are moved by merge_chunks once every chunk was sized
+* the first error is enough to send the source back to the sequential passes so a chunk stops there
+*
+* parameters:
+*   task: the index of the chunk
+*   context: the ChunkedRun shared by all the tasks
+*
+*/
+void size_chunk(int task, void *context){
+	SourceChunk *chunk = &((ChunkedRun*)context)->chunks[task];
+	DiagnosticCounter counter;/*stops the chunk at its first error*/
+	FILE *capture, *file;
+	char *text;
+	size_t text_size;
+	int line_counter = IC_INIT_VALUE;
+
+	chunk->failed = true;
+	capture = capture_chunk_output(&text, &text_size);
+	if(!capture){
+		return;
+	}
+	file = open_buffer(chunk->start, chunk->length);
+	if(file && initialize_label_array(&chunk->labels)){
+		start_diagnostics(&counter, 1);
+		chunk->failed = !first_pass_lines(file, &line_counter, &chunk->labels, &chunk->directives, &chunk->code_length, &chunk->data_length);
+		stop_diagnostics();
+	}
+	if(file){
+		fclose(file);
+	}
+	chunk->address_length = line_counter - IC_INIT_VALUE;
+	chunk->failed = !release_chunk_output(capture, &text, &text_size) || chunk->failed;
+}
+
+/*
+* encode_chunk
+* ------------
+* this function is the task that runs the second pass over a single chunk
+* the instruction and data counters start at the slice of the images merge_chunks gave the chunk
+* so the chunks write to different words and need no lock
+*
+* parameters:
+*   task: the index of the chunk
+*   context: the ChunkedRun shared by all the tasks
+*
+*/
+void encode_chunk(int task, void *context){
+	ChunkedRun *run = (ChunkedRun*)context;
+	SourceChunk *chunk = &run->chunks[task];
+	AssemblyState *state = run->state;
+	DiagnosticCounter counter;/*stops the chunk at its first error*/
+	FILE *capture, *file;
+	char *text;
+	size_t text_size;
+	long ic = IC_INIT_VALUE + chunk->code_base, dc = chunk->data_base;
+
+	chunk->failed = true;
+	capture = capture_chunk_output(&text, &text_size);
+	if(!capture){
+		return;
+	}
+	file = open_buffer(chunk->start, chunk->length);
+	if(file){
+		start_diagnostics(&counter, 1);
+		chunk->failed = !second_pass_stream(file, &state->label_array, &state->ext_entry_array, state->code_img, state->data_img, &ic, &dc, &chunk->extern_references, NULL);
+		stop_diagnostics();
+		fclose(file);
+	}
+	if(ic != IC_INIT_VALUE + chunk->code_base + chunk->code_length || dc != chunk->data_base + chunk->data_length){/*the passes disagree on the size of the chunk*/
+		chunk->failed = true;
+	}
+	chunk->failed = !release_chunk_output(capture, &text, &text_size) || chunk->failed;
+}
+
+/*
+* run_chunks
+* ----------
+* this function runs a task over every chunk on a work pool and waits for all of them
+*
+* parameters:
+*   run: the chunks
+*   jobs: the number of worker threads
+*   task: the task to run over every chunk
+*
+* returns:
+*   bool: true if every chunk succeeded false otherwise
+*/
+bool run_chunks(ChunkedRun *run, int jobs, work_function task){
+	WorkPool pool;
+	long *costs;
+	bool success = true;
+	int i;
+
+	costs = (long*)malloc(run->count * sizeof(long));
+	if(!costs){
+		return false;
+	}
+	for(i=0 ; i<run->count ; i++){/*the length of a chunk estimates the time it takes*/
+		costs[i] = (long)run->chunks[i].length;
+	}
+	if(!work_pool_start(&pool, jobs, run->count, costs, task, run)){
+		free(costs);
+		return false;
+	}
+	work_pool_join(&pool);
+	free(costs);
+	for(i=0 ; i<run->count ; i++){
+		success = success && !run->chunks[i].failed;
+	}
+	return success;
+}
+
+/*** MERGE SECTION ***/
+
+/*
+* merge_chunks
+* ------------
+* this function turns the sizes of the chunks into their start addresses with a prefix sum
+* and merges their labels externs and entries into the state at those addresses in source order
+* a label defined by two chunks or too many externs or entries are errors only the sequential passes report
+*
+* parameters:
+*   run: the sized chunks and the state they are merged into
+*
+* returns:
+*   bool: true if the chunks were merged false if the source has to go through the sequential passes
+*/
+bool merge_chunks(ChunkedRun *run){
+	AssemblyState *state = run->state;
+	ExternEntryArray *merged = &state->ext_entry_array;
+	SourceChunk *chunk;
+	long address = 0, code = 0, data = 0;/*the running sums*/
+	int i, j;
+
+	for(i=0 ; i<run->count ; i++){
+		chunk = &run->chunks[i];
+		chunk->address_base = address;
+		chunk->code_base = code;
+		chunk->data_base = data;
+		for(j=0 ; j<chunk->labels.count ; j++){
+			if(!is_unique_label(&state->label_array, chunk->labels.labels[j].label) ||
+					!add_label(&state->label_array, chunk->labels.labels[j].label, chunk->labels.labels[j].line_number + (int)address)){
+				return false;
+			}
+		}
+		if(merged->extern_count + chunk->directives.extern_count > MAX_EXTERN_ENTRIES ||
+				merged->entry_count + chunk->directives.entry_count > MAX_EXTERN_ENTRIES){
+			return false;
+		}
+		for(j=0 ; j<chunk->directives.extern_count ; j++){
+			merged->externs[merged->extern_count] = chunk->directives.externs[j];
+			merged->externs[merged->extern_count].line_number += (int)address;
+			index_extern(merged, merged->extern_count++);
+		}
+		for(j=0 ; j<chunk->directives.entry_count ; j++){
+			merged->entries[merged->entry_count] = chunk->directives.entries[j];
+			merged->entries[merged->entry_count++].line_number += (int)address;
+		}
+		address += chunk->address_length;
+		code += chunk->code_length;
+		data += chunk->data_length;
+	}
+	state->code_length = code;
+	state->data_length = data;
+	return IC_INIT_VALUE + address <= CODE_ARR_IMG_LENGTH;/*the sequential first pass reports the overflow*/
+}
+
+/*
+* collect_extern_references
+* -------------------------
+* this function joins the extern references of the chunks in source order
+* into the terminated array the sequential second pass builds
+*
+* parameters:
+*   run: the encoded chunks and the state that receives the references
+*
+* returns:
+*   bool: true if the references were joined false if memory ran out
+*/
+bool collect_extern_references(ChunkedRun *run){
+	ExternEntry *references;
+	int i, j, count = 0;
+
+	for(i=0 ; i<run->count ; i++){
+		for(j=0 ; run->chunks[i].extern_references && run->chunks[i].extern_references[j].name[0] != '\0' ; j++){
+			count++;
+		}
+	}
+	if(count == 0){/*the sequential pass leaves the array NULL without a reference*/
+		return true;
+	}
+	references = (ExternEntry*)STATS_MALLOC(MEMORY_OTHER, (count + 1) * sizeof(ExternEntry));
+	if(!references){
+		return false;
+	}
+	for(i=0, count=0 ; i<run->count ; i++){
+		for(j=0 ; run->chunks[i].extern_references && run->chunks[i].extern_references[j].name[0] != '\0' ; j++){
+			references[count++] = run->chunks[i].extern_references[j];
+		}
+	}
+	references[count].name[0] = '\0';/*null terminate the array*/
+	run->state->extern_printing_array = references;
+	return true;
+}
+
+/*
+* discard_chunks
+* --------------
+* this function frees the tables of the chunks and when the source goes back to the sequential passes
+* also empties the state of everything the chunks put in it
+*
+* parameters:
+*   run: the chunks
+*   reset: true to empty the state
+*
+*/
+void discard_chunks(ChunkedRun *run, bool reset){
+	AssemblyState *state = run->state;
+	long i;
+
+	for(i=0 ; i<run->count ; i++){
+		free_label_array(&run->chunks[i].labels);
+		STATS_FREE(run->chunks[i].extern_references);
+	}
+	free(run->chunks);
+	if(!reset){
+		return;
+	}
+	for(i=0 ; i<CODE_ARR_IMG_LENGTH ; i++){/*free the words of the chunks that were encoded*/
+		if(state->code_img[i]){
+			free_machine_word(state->code_img[i]);
+			state->code_img[i] = NULL;
+		}
+	}
+	STATS_FREE(state->extern_printing_array);
+	state->extern_printing_array = NULL;
+	empty_label_array(&state->label_array);
+	initialize_extern_entry_array(&state->ext_entry_array);
+	state->IC = IC_INIT_VALUE;
+	state->DC = 0;
+	state->code_length = 0;
+	state->data_length = 0;
+}
+
+/*** CHUNKED PASSES SECTION ***/
+
+/*
+* assemble_chunked
+* ----------------
+* this function runs both passes over the chunks of a large source on options->jobs threads
+* it is tried by assemble_preprocessed before the sequential passes and does nothing without --chunked and -j or for a source too small to split
+* the outputs are streamed to the sink only after every chunk was encoded so a source that falls back has nothing to undo
+*
+* parameters:
+*   name: the name of the source used in the error messages
+*   preprocessed: the preprocessed source
+*   size: the length of the preprocessed source
+*   options: the options that select the number of threads the load address and the relocation table
+*   sink: a sink prepared by initialize_object_sink or NULL to keep the images in the state
+*   state: a state made by create_assembly_state that receives the images and tables
+*
+* returns:
+*   chunked_result: whether the source was assembled or has to go through the sequential passes
+*/
+chunked_result assemble_chunked(const char *name, const char *preprocessed, size_t size, const AssemblerOptions *options, ObjectSink *sink, AssemblyState *state){
+	ChunkedRun run;
+	FILE *capture;/*collects the messages of the entry checks*/
+	char *text;
+	size_t text_size;
+	bool success;
+
+	if(!options->chunked || options->jobs < 2){
+		return CHUNKED_SEQUENTIAL;
+	}
+	run.state = state;
+	run.count = split_chunks(preprocessed, size, options->jobs, &run.chunks);
+	if(run.count < 2){
+		free(run.chunks);
+		return CHUNKED_SEQUENTIAL;
+	}
+
+	STATS_ENTER(PHASE_FIRST_PASS);
+	success = run_chunks(&run, options->jobs, size_chunk) && merge_chunks(&run);/*first pass*/
+	success = success && options->load_base + state->code_length + state->data_length <= CODE_ARR_IMG_LENGTH;
+	STATS_LEAVE();
+	STATS_ENTER(PHASE_ENTRIES);
+	if(success){/*the line numbers of the merged directives are local to their chunks so any message sends the source back*/
+		capture = capture_chunk_output(&text, &text_size);
+		success = capture && check_extern_labels(&state->label_array, &state->ext_entry_array);
+		success = success && update_entry_lines(&state->label_array, &state->ext_entry_array);
+		success = capture && release_chunk_output(capture, &text, &text_size) && success;
+	}
+	STATS_LEAVE();
+	STATS_ENTER(PHASE_SECOND_PASS);
+	success = success && run_chunks(&run, options->jobs, encode_chunk) && collect_extern_references(&run);/*second pass*/
+	STATS_LEAVE();
+	if(!success){
+		discard_chunks(&run, true);
+		return CHUNKED_SEQUENTIAL;
+	}
+	discard_chunks(&run, false);
+	state->IC = IC_INIT_VALUE + state->code_length;
+	state->DC = state->data_length;
+
+	if(sink){/*stream the images exactly like the sequential second pass*/
+		STATS_ENTER(PHASE_WRITE);
+		success = open_object_sink(sink, state->code_length, state->data_length, options->load_base, options->write_relocations) && sink_entries(sink, &state->ext_entry_array)
+			&& (!options->write_map || sink_source_map(sink, name, preprocessed, size, options->load_base, state->code_length))
+			&& sink_cost_report(sink, name, preprocessed, size, options);
+		success = success && sink_code_words(sink, state->code_img, state->IC, state->extern_printing_array);
+		success = success ? close_object_sink(sink, state->data_img, state->DC) : (abort_object_sink(sink), false);
+		STATS_LEAVE();
+		if(!success){
+			fprintf(error_output(), "error: second pass failed for file %s.am\n", name);
+		}
+	}
+	if(success){
+		STATS_TABLES(&state->label_array, &state->ext_entry_array, state->extern_printing_array, state->code_length, state->data_length);
+	}
+	return success ? CHUNKED_ASSEMBLED : CHUNKED_FAILED;
+}
@@ -0,0 +1,66 @@
+#ifndef CHUNKED_PASS_H
+#define CHUNKED_PASS_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "definitions.h"
+#include "libassembler.h"
+#include "work_pool.h"
+
+#define CHUNK_MIN_SIZE (4L << 10)/*smallest chunk a source is split into*/
+#define CHUNKS_PER_JOB 4/*chunks per worker so the pool can balance uneven chunks*/
+
+/*
+* chunked passes
+* --------------
+* with --chunked and -j a single source is assembled on several threads:
+*   1. the preprocessed source is split into line aligned chunks
+*   2. every chunk is sized by the first pass on its own with addresses that start at IC_INIT_VALUE
+*   3. prefix sums over the sizes of the chunks give the address the code index and the data index every chunk starts at
+*   4. the labels the externs and the entries of the chunks are moved to their global addresses and merged in source order
+*   5. every chunk is encoded by the second pass into its own slice of the code and data images
+*   6. the images are streamed to the sink in order exactly like the sequential second pass streams them
+* a chunk that prints anything (an error or a duplicate label between chunks) sends the whole source back to the sequential
+* passes so the messages and the outputs are always the ones a sequential run produces
+* the engine is off by default: a program that fits the 4096 words of memory is a few hundred KB of source at most
+* and is assembled in a few milliseconds, so the threads rarely win back what splitting and merging cost
+*/
+
+/*** STRUCTURE DEFINITIONS SECTION ***/
+
+/*outcome of the chunked passes*/
+typedef enum chunked_results{
+	CHUNKED_FAILED = 0,/*the source was sized and encoded but its outputs could not be written*/
+	CHUNKED_ASSEMBLED = 1,/*the source was assembled and its outputs were written*/
+	CHUNKED_SEQUENTIAL = 2/*the source must be assembled by the sequential passes (nothing was written)*/
+}chunked_result;
+
+typedef struct{/*a line aligned slice of the preprocessed source*/
+	const char *start;/*first byte of the chunk*/
+	size_t length;/*length of the chunk*/
+	LabelArray labels;/*labels the chunk defines at addresses that start at IC_INIT_VALUE*/
+	ExternEntryArray directives;/*extern and entry directives of the chunk*/
+	long address_length;/*amount the chunk advances the address counter*/
+	long code_length;/*number of code words of the chunk*/
+	long data_length;/*number of data words of the chunk*/
+	long address_base;/*distance of the first address of the chunk from IC_INIT_VALUE*/
+	long code_base;/*index of the first code word of the chunk*/
+	long data_base;/*index of the first data word of the chunk*/
+	ExternEntry *extern_references;/*extern references the chunk encoded*/
+	bool failed;/*true if the chunk failed or printed anything*/
+}SourceChunk;
+
+typedef struct{/*the state shared by the tasks of the chunked passes*/
+	SourceChunk *chunks;/*the chunks in source order*/
+	int count;/*number of chunks*/
+	AssemblyState *state;/*the merged tables and the images the chunks are encoded into*/
+}ChunkedRun;
+
+/*** FUNCTION PROTOTYPES SECTION ***/
+
+int split_chunks(const char *preprocessed,size_t size,int jobs,SourceChunk **chunks);/*function to split a preprocessed source into line aligned chunks*/
+bool merge_chunks(ChunkedRun *run);/*function to place the chunks at their addresses and merge their tables*/
+chunked_result assemble_chunked(const char *name,const char *preprocessed,size_t size,const AssemblerOptions *options,ObjectSink *sink,AssemblyState *state);/*function to run both passes over the chunks of a large source concurrently*/
+
+#endif /*CHUNKED_PASS_H*/
@@ -0,0 +1,439 @@
+#include "cost_report.h"
+#include "utils.h"
+#include "diagnostics.h"
+#include <errno.h>
+
+/*** COST TABLE SECTION ***/
+
+/*
+* addressing_mode_names
+* ---------------------
+* the name of every addressing mode in the cost table and the reports indexed like the mode_cycles of a CostTable
+*/
+const char *const addressing_mode_names[ADDRESSING_MODE_COUNT] = {"immediate", "direct", "relative", "register"};
+
+/*
+* initialize_cost_table
+* ---------------------
+* this function fills a cost table with the default cycles described in cost_report.h
+*
+* parameters:
+*   table: the table to fill
+*
+*/
+void initialize_cost_table(CostTable *table){
+	int i;
+
+	for(i=0 ; i<OPERATION_COUNT ; i++){
+		table->operation_cycles[i] = 1;
+	}
+	table->operation_cycles[JSR_OP] = 2;/*the return address goes through the stack*/
+	table->operation_cycles[RTS_OP] = 2;
+	table->mode_cycles[0] = 1;/*the immediate word is fetched*/
+	table->mode_cycles[1] = 2;/*the address word is fetched and then the memory it names*/
+	table->mode_cycles[2] = 1;/*the memory the register points to is read*/
+	table->mode_cycles[3] = 0;
+}
+
+/*
+* read_cost_table
+* ---------------
+* this function reads a cost table file and replaces the cycles of every operation and addressing mode it names
+* every line holds a name and its cycles and everything from a ; to the end of the line is a comment
+*
+* parameters:
+*   path: the path of the cost table file
+*   table: the table whose cycles are replaced
+*
+* returns:
+*   bool: true if the file was read false if it couldn't be opened or a line is invalid (an error was printed)
+*/
+bool read_cost_table(const char *path, CostTable *table){
+	char line[MAX_LINE_LENGTH + 2];
+	char *name, *cycles, *end, *save;
+	FILE *file;
+	long value;
+	int line_number = 0, i;
+	bool success = true;
+
+	file = fopen(path, "r");
+	if(!file){
+		fprintf(stderr, "Error: can't read the cost table %s: %s\n", path, strerror(errno));
+		return false;
+	}
+	while(success && fgets(line, sizeof(line), file)){
+		line_number++;
+		if(strchr(line, ';')){
+			*strchr(line, ';') = '\0';/*drop the comment*/
+		}
+		name = strtok_r(line, " \t\r\n", &save);
+		if(!name){
+			continue;
+		}
+		cycles = strtok_r(NULL, " \t\r\n", &save);
+		value = cycles ? strtol(cycles, &end, 10) : -1;
+		if(!cycles || *end != '\0' || value < 0 || value > 1000000 || strtok_r(NULL, " \t\r\n", &save)){
+			fprintf(stderr, "Error: %s: %d: expected a name and a whole number of cycles\n", path, line_number);
+			success = false;
+			break;
+		}
+		for(i=0 ; i<OPERATION_COUNT && strcmp(name, operations[i]) != 0 ; i++);
+		if(i < OPERATION_COUNT){
+			table->operation_cycles[i] = (int)value;
+			continue;
+		}
+		for(i=0 ; i<ADDRESSING_MODE_COUNT && strcmp(name, addressing_mode_names[i]) != 0 ; i++);
+		if(i < ADDRESSING_MODE_COUNT){
+			table->mode_cycles[i] = (int)value;
+			continue;
+		}
+		fprintf(stderr, "Error: %s: %d: '%s' is neither an operation nor an addressing mode\n", path, line_number, name);
+		success = false;
+	}
+	fclose(file);
+	return success;
+}
+
+/*** REGIONS SECTION ***/
+
+/*
+* addressing_mode_index
+* ---------------------
+* this function converts an addressing type to its position in the mode_cycles of a CostTable
+*
+* parameters:
+*   type: the addressing type of an operand
+*
+* returns:
+*   int: the position of the mode or -1 for NONE_ADDR
+*/
+int addressing_mode_index(addressing_type type){
+	switch(type){
+		case IMMEDIATE_ADDR:
+			return 0;
+		case DIRECT_ADDR:
+			return 1;
+		case RELATIVE_ADDR:
+			return 2;
+		case REGISTER_ADDR:
+			return 3;
+		default:
+			return -1;
+	}
+}
+
+/*
+* add_region
+* ----------
+* this function appends an empty region to the regions of a report
+*
+* parameters:
+*   regions: the regions (reallocated)
+*   count: the number of regions (incremented)
+*   capacity: the capacity of the regions array
+*   name: the label that starts the region
+*
+* returns:
+*   CostRegion*: the new region or NULL when memory ran out
+*/
+CostRegion *add_region(CostRegion **regions, int *count, int *capacity, const char *name){
+	CostRegion *grown;
+
+	if(*count == *capacity){
+		grown = (CostRegion*)realloc(*regions, (*capacity ? *capacity * 2 : 16) * sizeof(CostRegion));
+		if(!grown){
+			return NULL;
+		}
+		*regions = grown;
+		*capacity = *capacity ? *capacity * 2 : 16;
+	}
+	memset(&(*regions)[*count], 0, sizeof(CostRegion));
+	strncpy((*regions)[*count].name, name, MAX_LABEL_LENGTH);
+	return &(*regions)[(*count)++];
+}
+
+/*
+* add_line_cost
+* -------------
+* this function adds the cost of a line of the preprocessed source to the current region
+* the words are sized by count_line_words and the instruction by calculate_instruction_lines like the first pass sizes them
+*
+* parameters:
+*   region: the region the line belongs to
+*   line: the line without its label and newline (modified by the function)
+*   table: the cycles of the operations and addressing modes
+*
+*/
+void add_line_cost(CostRegion *region, char *line, const CostTable *table){
+	char sized[MAX_LINE_LENGTH + 2];/*copy of the line count_line_words splits*/
+	char *token, *save;
+	int code_words, data_words, operation, mode;
+
+	strcpy(sized, line);
+	count_line_words(sized, &code_words, &data_words);
+	region->code_words += code_words;
+	region->data_words += data_words;
+	token = strtok_r(line, " \t", &save);
+	if(!token || code_words == 0){
+		return;
+	}
+	for(operation=0 ; operation<OPERATION_COUNT && strcmp(token, operations[operation]) != 0 ; operation++);
+	if(operation == OPERATION_COUNT){
+		return;
+	}
+	region->instructions++;
+	region->operations[operation]++;
+	region->cycles += table->operation_cycles[operation];
+	for(token = strtok_r(NULL, " ,\t", &save) ; token ; token = strtok_r(NULL, " ,\t", &save)){
+		mode = addressing_mode_index(get_addressing_type(token));
+		if(mode >= 0){
+			region->modes[mode]++;
+			region->cycles += table->mode_cycles[mode];
+		}
+	}
+}
+
+/*
+* collect_regions
+* ---------------
+* this function splits a preprocessed source into regions at its labels and adds up the cost of each
+* the first region holds the lines before the first label and the last one holds the total of every region
+*
+* parameters:
+*   preprocessed: the preprocessed source the first pass accepted
+*   size: the length of the preprocessed source
+*   table: the cycles of the operations and addressing modes
+*   count: receives the number of regions without the total
+*
+* returns:
+*   CostRegion*: the regions followed by the total (freed by the caller) or NULL when memory ran out
+*/
+CostRegion *collect_regions(const char *preprocessed, size_t size, const CostTable *table, int *count){
+	char line[MAX_LINE_LENGTH + 2];
+	const char *start = preprocessed, *end;
+	char *body, *colon;
+	CostRegion *regions = NULL, *region, *total;
+	int capacity = 0, i, j;
+	size_t length;
+
+	*count = 0;
+	region = add_region(&regions, count, &capacity, REGION_START_NAME);
+	while(region && start < preprocessed + size){
+		end = (const char*)memchr(start, '\n', preprocessed + size - start);
+		end = end ? end : preprocessed + size;
+		length = (size_t)(end - start) < sizeof(line) - 1 ? (size_t)(end - start) : sizeof(line) - 1;/*a longer line was rejected by the first pass*/
+		memcpy(line, start, length);
+		line[length] = '\0';
+		body = line + strspn(line, " \t");
+		colon = strchr(body, ':');
+		if(colon && colon < body + strcspn(body, " \t")){/*the first token is a label*/
+			*colon = '\0';
+			region = add_region(&regions, count, &capacity, body);
+			body = colon + 1;
+		}
+		if(region){
+			add_line_cost(region, body, table);
+		}
+		start = end + 1;
+	}
+	total = region ? add_region(&regions, count, &capacity, "total") : NULL;
+	if(!total){
+		free(regions);
+		return NULL;
+	}
+	(*count)--;/*the total is not a region*/
+	for(i=0 ; i<*count ; i++){
+		total->instructions += regions[i].instructions;
+		total->code_words += regions[i].code_words;
+		total->data_words += regions[i].data_words;
+		total->cycles += regions[i].cycles;
+		for(j=0 ; j<OPERATION_COUNT ; j++){
+			total->operations[j] += regions[i].operations[j];
+		}
+		for(j=0 ; j<ADDRESSING_MODE_COUNT ; j++){
+			total->modes[j] += regions[i].modes[j];
+		}
+	}
+	return regions;
+}
+
+/*** OUTPUT SECTION ***/
+
+/*
+* is_empty_start
+* --------------
+* this function checks if a region is the region before the first label and has nothing in it
+* such a region is left out of the reports
+*
+* parameters:
+*   regions: the regions
+*   index: the position of the region
+*
+* returns:
+*   bool: true if the region is left out false otherwise
+*/
+bool is_empty_start(const CostRegion *regions, int index){
+	return index == 0 && regions[0].code_words == 0 && regions[0].data_words == 0;
+}
+
+/*
+* write_report_text
+* -----------------
+* this function writes the regions as a table of their sizes and cycles followed by a table of their operations and of their modes
+*
+* parameters:
+*   file: the stream to write to
+*   name: the name of the source
+*   regions: the regions followed by the total
+*   count: the number of regions without the total
+*
+*/
+void write_report_text(FILE *file, const char *name, const CostRegion *regions, int count){
+	int i, j;
+
+	fprintf(file, "%s.as\n%-32s %12s %10s %10s %10s\n", name, "region", "instructions", "code words", "data words", "cycles");
+	for(i=0 ; i<=count ; i++){
+		if(!is_empty_start(regions, i)){
+			fprintf(file, "%-32s %12ld %10ld %10ld %10ld\n", regions[i].name, regions[i].instructions, regions[i].code_words, regions[i].data_words, regions[i].cycles);
+		}
+	}
+
+	fprintf(file, "\n%-32s", "operations");
+	for(j=0 ; j<OPERATION_COUNT ; j++){
+		fprintf(file, " %5s", operations[j]);
+	}
+	fputc('\n', file);
+	for(i=0 ; i<=count ; i++){
+		if(!is_empty_start(regions, i)){
+			fprintf(file, "%-32s", regions[i].name);
+			for(j=0 ; j<OPERATION_COUNT ; j++){
+				fprintf(file, " %5ld", regions[i].operations[j]);
+			}
+			fputc('\n', file);
+		}
+	}
+
+	fprintf(file, "\n%-32s", "modes");
+	for(j=0 ; j<ADDRESSING_MODE_COUNT ; j++){
+		fprintf(file, " %9s", addressing_mode_names[j]);
+	}
+	fputc('\n', file);
+	for(i=0 ; i<=count ; i++){
+		if(!is_empty_start(regions, i)){
+			fprintf(file, "%-32s", regions[i].name);
+			for(j=0 ; j<ADDRESSING_MODE_COUNT ; j++){
+				fprintf(file, " %9ld", regions[i].modes[j]);
+			}
+			fputc('\n', file);
+		}
+	}
+}
+
+/*
+* write_region_json
+* -----------------
+* this function writes the members of a region or of the total as JSON
+*
+* parameters:
+*   file: the stream to write to
+*   region: the region
+*
+*/
+void write_region_json(FILE *file, const CostRegion *region){
+	int j;
+
+	fprintf(file, "\"instructions\":%ld,\"code_words\":%ld,\"data_words\":%ld,\"cycles\":%ld,\"operations\":{",
+		region->instructions, region->code_words, region->data_words, region->cycles);
+	for(j=0 ; j<OPERATION_COUNT ; j++){
+		fprintf(file, "%s\"%s\":%ld", j ? "," : "", operations[j], region->operations[j]);
+	}
+	fputs("},\"modes\":{", file);
+	for(j=0 ; j<ADDRESSING_MODE_COUNT ; j++){
+		fprintf(file, "%s\"%s\":%ld", j ? "," : "", addressing_mode_names[j], region->modes[j]);
+	}
+	fputc('}', file);
+}
+
+/*
+* write_report_json
+* -----------------
+* this function writes the regions as the single JSON object described in cost_report.h
+*
+* parameters:
+*   file: the stream to write to
+*   name: the name of the source
+*   regions: the regions followed by the total
+*   count: the number of regions without the total
+*
+*/
+void write_report_json(FILE *file, const char *name, const CostRegion *regions, int count){
+	char *source = make_path(name, ".as", NULL);
+	bool first = true;
+	int i;
+
+	fputs("{\"source\":", file);
+	json_write_string(file, source ? source : name, strlen(source ? source : name));
+	free(source);
+	fputs(",\"regions\":[", file);
+	for(i=0 ; i<count ; i++){
+		if(!is_empty_start(regions, i)){
+			fputs(first ? "{\"name\":" : ",{\"name\":", file);
+			json_write_string(file, regions[i].name, strlen(regions[i].name));
+			fputc(',', file);
+			write_region_json(file, &regions[i]);
+			fputc('}', file);
+			first = false;
+		}
+	}
+	fputs("],\"total\":{", file);
+	write_region_json(file, &regions[count]);
+	fputs("}}\n", file);
+}
+
+/*
+* sink_cost_report
+* ----------------
+* this function writes the .report and .report.json files of the sink when the options ask for them
+* the preprocessed source is split into regions at its labels and sized again line by line the way the first pass sized it
+*
+* parameters:
+*   sink: the sink that writes the files
+*   name: the name of the source the reports name
+*   preprocessed: the preprocessed source the first pass accepted
+*   size: the length of the preprocessed source
+*   options: the options that ask for the reports and hold the cost table
+*
+* returns:
+*   bool: true if the reports were written or none was asked for false otherwise
+*/
+bool sink_cost_report(ObjectSink *sink, const char *name, const char *preprocessed, size_t size, const AssemblerOptions *options){
+	CostRegion *regions;
+	FILE *file;
+	int count;
+	bool success = true;
+
+	if(!options->write_report && !options->write_report_json){
+		return true;
+	}
+	regions = collect_regions(preprocessed, size, &options->cost_table, &count);
+	if(!regions){
+		fprintf(error_output(), "Error: memory allocation failed for the cost report of %s\n", name);
+		return false;
+	}
+	if(options->write_report){
+		file = open_sink_output(sink, SINK_REPORT);
+		if(file){
+			write_report_text(file, name, regions, count);
+		}
+		success = file != NULL;
+	}
+	if(success && options->write_report_json){
+		file = open_sink_output(sink, SINK_REPORT_JSON);
+		if(file){
+			write_report_json(file, name, regions, count);
+		}
+		success = file != NULL;
+	}
+	free(regions);
+	return success;
+}
@@ -0,0 +1,53 @@
+#ifndef COST_REPORT_H
+#define COST_REPORT_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "definitions.h"
+#include "options.h"
+#include "first_pass.h"
+#include "file_writer.h"
+
+#define REGION_START_NAME "(start)"/*name of the region before the first label*/
+
+/*
+* cost report
+* -----------
+* --report writes NAME.report and --report-json writes NAME.report.json with the static cost of every region of the program
+* a region starts at a label and runs until the next label (the lines before the first label are the region (start))
+* and holds the number of instructions the code and data words they are encoded into (sized like the first pass sizes them)
+* how often every operation and every addressing mode is used and the cycles the instructions are estimated to take
+* an instruction takes the cycles of its operation plus the cycles of the addressing mode of every operand
+* the default table charges 1 cycle to every operation but jsr and rts that charge 2
+* and 1 cycle to an immediate operand 2 to a direct one 1 to a relative one and none to a register
+* --cost-table FILE replaces any of them: every line of FILE is an operation or a mode (immediate direct relative register)
+* followed by its cycles and a ; starts a comment
+* NAME.report holds a table of the regions and tables of their operations and modes
+* NAME.report.json holds {"source":..., "regions":[{"name":..., "instructions":N, "code_words":N, "data_words":N, "cycles":N,
+* "operations":{"mov":N, ...}, "modes":{"immediate":N, ...}}, ...], "total":{...}} on a single line
+*/
+
+/*** STRUCTURE DEFINITIONS SECTION ***/
+
+typedef struct{/*the cost of a region of the program*/
+	char name[MAX_LABEL_LENGTH + 1];/*the label that starts the region*/
+	long instructions;/*number of instructions*/
+	long code_words;/*words of the code image*/
+	long data_words;/*words of the data image*/
+	long cycles;/*estimated cycles of the instructions*/
+	long operations[OPERATION_COUNT];/*uses of every operation indexed by its opcode*/
+	long modes[ADDRESSING_MODE_COUNT];/*operands of every addressing mode (immediate direct relative register)*/
+}CostRegion;
+
+/*** EXTERNAL DECLARATIONS SECTION ***/
+
+extern const char *const addressing_mode_names[ADDRESSING_MODE_COUNT];
+
+/*** FUNCTION PROTOTYPES SECTION ***/
+
+void initialize_cost_table(CostTable *table);/*function to fill a cost table with the default cycles*/
+bool read_cost_table(const char *path,CostTable *table);/*function to replace the cycles a cost table file names*/
+bool sink_cost_report(ObjectSink *sink,const char *name,const char *preprocessed,size_t size,const AssemblerOptions *options);/*function to write the .report and .report.json files of a preprocessed source*/
+
+#endif /*COST_REPORT_H*/
@@ -12,8 +12,14 @@
 /*initial IC value*/
 #define IC_INIT_VALUE 100
 
-/*fixed length for the name of the file*/
-#define MAX_FILENAME_LENGTH 50
+/*number of operations (the opcodes 0 to STOP_OP)*/
+#define OPERATION_COUNT (STOP_OP + 1)
+
+/*number of addressing modes (immediate direct relative register)*/
+#define ADDRESSING_MODE_COUNT 4
+
+/*version of the assembler (part of the key of every cached output)*/
+#define ASSEMBLER_VERSION "1.4"
 
 
 
@@ -0,0 +1,424 @@
+#include "diagnostics.h"
+#include <pthread.h>
+#include <stdarg.h>
+
+/*** OUTPUT STREAMS SECTION ***/
+
+/*
+* output_keys
+* -----------
+* every thread can send its messages to its own streams so files assembled in parallel do not mix their output
+* a thread that never called redirect_output writes to stdout and stderr
+*/
+pthread_key_t message_key, error_key, counter_key, list_key;
+pthread_once_t output_keys_once = PTHREAD_ONCE_INIT;
+
+/* 
+* create_output_keys
+* ------------------
+* this function creates the thread specific keys that hold the streams of each thread
+* it runs exactly once through pthread_once
+* 
+*/
+void create_output_keys(void){
+	pthread_key_create(&message_key, NULL);
+	pthread_key_create(&error_key, NULL);
+	pthread_key_create(&counter_key, NULL);
+	pthread_key_create(&list_key, NULL);
+}
+
+/* 
+* error_output
+* ------------
+* this function returns the stream that receives the error messages of the calling thread
+* 
+* returns:
+*   FILE*: the stream set by redirect_output or stderr
+*/
+FILE *error_output(void){
+	FILE *stream;
+
+	pthread_once(&output_keys_once, create_output_keys);
+	stream = (FILE*)pthread_getspecific(error_key);
+	return stream ? stream : stderr;
+}
+
+/* 
+* message_output
+* --------------
+* this function returns the stream that receives the progress messages of the calling thread
+* 
+* returns:
+*   FILE*: the stream set by redirect_output or stdout
+*/
+FILE *message_output(void){
+	FILE *stream;
+
+	pthread_once(&output_keys_once, create_output_keys);
+	stream = (FILE*)pthread_getspecific(message_key);
+	return stream ? stream : stdout;
+}
+
+/* 
+* redirect_output
+* ---------------
+* this function sends the messages of the calling thread to other streams
+* passing NULL restores stdout or stderr
+* 
+* parameters:
+*   messages: the stream for the progress messages
+*   errors: the stream for the error messages
+* 
+*/
+void redirect_output(FILE *messages,FILE *errors){
+	pthread_once(&output_keys_once, create_output_keys);
+	pthread_setspecific(message_key, messages);
+	pthread_setspecific(error_key, errors);
+}
+
+/* 
+* print_system_error
+* ------------------
+* this function prints a message followed by the description of errno to the error stream of the calling thread
+* it replaces perror which always writes to stderr
+* 
+* parameters:
+*   message: the message to print before the description
+* 
+*/
+void print_system_error(const char *message){
+	int error = errno;/*keep errno before anything else can change it*/
+
+	report_error("%s: %s\n", message, strerror(error));
+}
+
+/*** ERROR COUNTING SECTION ***/
+
+/*
+* start_diagnostics
+* -----------------
+* this function starts counting the errors the calling thread reports for the file it assembles
+* the passes go on after a line with an error so a single run reports every error of a file
+* until the count reaches the limit
+*
+* parameters:
+*   counter: the counter of the file which must stay valid until stop_diagnostics
+*   limit: the number of errors after which the file is abandoned (0 for no limit)
+*
+*/
+void start_diagnostics(DiagnosticCounter *counter, int limit){
+	counter->errors = 0;
+	counter->limit = limit;
+	counter->line = 0;
+	counter->source_lines = NULL;
+	counter->source_line_count = 0;
+	counter->muted = false;
+	pthread_once(&output_keys_once, create_output_keys);
+	pthread_setspecific(counter_key, counter);
+}
+
+/*
+* stop_diagnostics
+* ----------------
+* this function stops counting the errors of the calling thread
+*
+*/
+void stop_diagnostics(void){
+	pthread_once(&output_keys_once, create_output_keys);
+	pthread_setspecific(counter_key, NULL);
+}
+
+/*
+* set_diagnostic_line
+* -------------------
+* this function names the line of the preprocessed source the passes of the calling thread are reading
+* the passes call it before every line and with 0 once they are done with the lines
+*
+* parameters:
+*   line: the line number starting from 1 or 0 when no line is being read
+*
+*/
+void set_diagnostic_line(int line){
+	DiagnosticCounter *counter;
+
+	pthread_once(&output_keys_once, create_output_keys);
+	counter = (DiagnosticCounter*)pthread_getspecific(counter_key);
+	if(counter){
+		counter->line = line;
+	}
+}
+
+/*
+* mute_diagnostics
+* ----------------
+* this function stops or resumes reporting the errors of the calling thread
+* a pass mutes them to run a check whose errors an earlier pass already reported
+*
+* parameters:
+*   muted: true to drop the errors false to report them again
+*
+*/
+void mute_diagnostics(bool muted){
+	DiagnosticCounter *counter;
+
+	pthread_once(&output_keys_once, create_output_keys);
+	counter = (DiagnosticCounter*)pthread_getspecific(counter_key);
+	if(counter){
+		counter->muted = muted;
+	}
+}
+
+/*
+* report_diagnostic
+* -----------------
+* this function prints an error or a warning to the error stream of the calling thread and records it in the list of the thread
+* while a pass reads a line the message ends with " on line N" so every error names the line of the source it was found on
+* the line is taken from the source lines of the counter when they are given so an error names the line of the .as file
+*
+* parameters:
+*   severity: the severity of the message (only errors are counted)
+*   format: the printf format of the message ending with a newline
+*   values: the values of the format
+*
+*/
+void report_diagnostic(diagnostic_severity severity, const char *format, va_list values){
+	DiagnosticCounter *counter;
+	DiagnosticList *list;
+	FILE *stream;/*stream that formats the message*/
+	char *message = NULL;/*the formatted message*/
+	size_t length = 0;/*length of the message*/
+	int line = 0;/*line of the source the message is about*/
+
+	pthread_once(&output_keys_once, create_output_keys);
+	counter = (DiagnosticCounter*)pthread_getspecific(counter_key);
+	list = (DiagnosticList*)pthread_getspecific(list_key);
+	if(counter && counter->muted){
+		return;
+	}
+	if(counter && severity == DIAGNOSTIC_ERROR){
+		counter->errors++;
+	}
+	if(counter && counter->line > 0){
+		line = counter->source_lines && counter->line <= counter->source_line_count ? counter->source_lines[counter->line - 1] : counter->line;
+	}
+	stream = open_memstream(&message, &length);
+	if(!stream){/*print the message as it is without memory to format it*/
+		vfprintf(error_output(), format, values);
+		if(list){
+			list->failed = true;
+		}
+		return;
+	}
+	vfprintf(stream, format, values);
+	fclose(stream);
+	if(!message){
+		if(list){
+			list->failed = true;
+		}
+		return;
+	}
+	if(length > 0 && message[length - 1] == '\n'){
+		message[--length] = '\0';/*the line goes before the newline*/
+	}
+	if(line > 0){
+		fprintf(error_output(), "%s on line %d\n", message, line);
+	}
+	else{
+		fprintf(error_output(), "%s\n", message);
+	}
+	if(!list || !record_diagnostic(list, severity, line, message)){
+		free(message);
+	}
+}
+
+/*
+* report_error
+* ------------
+* this function prints an error message to the error stream of the calling thread and counts it for the file it assembles
+*
+* parameters:
+*   format: the printf format of the message ending with a newline
+*   ...: the values of the format
+*
+*/
+void report_error(const char *format, ...){
+	va_list values;
+
+	va_start(values, format);
+	report_diagnostic(DIAGNOSTIC_ERROR, format, values);
+	va_end(values);
+}
+
+/*
+* report_warning
+* --------------
+* this function prints a warning message to the error stream of the calling thread
+* a warning names its line like an error but it is not counted so the source is still assembled
+*
+* parameters:
+*   format: the printf format of the message ending with a newline
+*   ...: the values of the format
+*
+*/
+void report_warning(const char *format, ...){
+	va_list values;
+
+	va_start(values, format);
+	report_diagnostic(DIAGNOSTIC_WARNING, format, values);
+	va_end(values);
+}
+
+/*
+* error_limit_reached
+* -------------------
+* this function checks if the file the calling thread assembles has reached its error limit
+*
+* returns:
+*   bool: true if the passes should stop reading the file false otherwise
+*/
+bool error_limit_reached(void){
+	DiagnosticCounter *counter;
+
+	pthread_once(&output_keys_once, create_output_keys);
+	counter = (DiagnosticCounter*)pthread_getspecific(counter_key);
+	return counter && counter->limit > 0 && counter->errors >= counter->limit;
+}
+
+/*** RECORDING SECTION ***/
+
+/*
+* start_recording
+* ---------------
+* this function records every error and warning the calling thread reports from now on in a list besides printing it
+* the columns of the records are found in the text of the source
+*
+* parameters:
+*   list: the list which must stay valid until stop_recording
+*   source: the text of the source
+*   size: the length of the source
+*
+*/
+void start_recording(DiagnosticList *list, const char *source, size_t size){
+	memset(list, 0, sizeof(DiagnosticList));
+	list->source = source;
+	list->size = size;
+	list->cursor_line = 1;
+	pthread_once(&output_keys_once, create_output_keys);
+	pthread_setspecific(list_key, list);
+}
+
+/*
+* stop_recording
+* --------------
+* this function stops recording the diagnostics of the calling thread
+*
+*/
+void stop_recording(void){
+	pthread_once(&output_keys_once, create_output_keys);
+	pthread_setspecific(list_key, NULL);
+}
+
+/*
+* free_diagnostic_list
+* --------------------
+* this function frees the records of a list and their messages
+*
+* parameters:
+*   list: the list
+*
+*/
+void free_diagnostic_list(DiagnosticList *list){
+	int i;
+
+	for(i=0 ; i<list->count ; i++){
+		free(list->records[i].message);
+	}
+	free(list->records);
+	list->records = NULL;
+	list->count = 0;
+	list->capacity = 0;
+}
+
+/*
+* find_column
+* -----------
+* this function finds the column of the first name a message quotes in a line of the source
+* the lines are found from a cursor that only moves back when a pass reads the source again so the search stays linear
+*
+* parameters:
+*   list: the list that holds the source
+*   line: the 1 based line of the source
+*   message: the message that quotes the name between single quotes
+*
+* returns:
+*   int: the 1 based column of the name in the line or 0 if the message quotes no name or the line does not hold it
+*/
+int find_column(DiagnosticList *list, int line, const char *message){
+	const char *quote, *end, *start, *line_end;
+	size_t name_length;
+
+	quote = strchr(message, '\'');
+	end = quote ? strchr(quote + 1, '\'') : NULL;
+	if(!end || end == quote + 1 || line <= 0){
+		return 0;
+	}
+	name_length = end - quote - 1;
+	if(line < list->cursor_line){/*the pass started over*/
+		list->cursor_line = 1;
+		list->cursor = 0;
+	}
+	while(list->cursor_line < line && list->cursor < list->size){
+		if(list->source[list->cursor++] == '\n'){
+			list->cursor_line++;
+		}
+	}
+	if(list->cursor_line != line){
+		return 0;
+	}
+	line_end = memchr(list->source + list->cursor, '\n', list->size - list->cursor);
+	if(!line_end){
+		line_end = list->source + list->size;
+	}
+	for(start = list->source + list->cursor ; start + name_length <= line_end ; start++){
+		if(memcmp(start, quote + 1, name_length) == 0){
+			return (int)(start - (list->source + list->cursor)) + 1;
+		}
+	}
+	return 0;
+}
+
+/*
+* record_diagnostic
+* -----------------
+* this function appends a diagnostic to a list
+*
+* parameters:
+*   list: the list
+*   severity: the severity of the message
+*   line: the 1 based line of the source or 0
+*   message: the message without its newline which the list owns from now on
+*
+* returns:
+*   bool: true if the diagnostic was recorded false if memory allocation failed (the message is not taken then)
+*/
+bool record_diagnostic(DiagnosticList *list, diagnostic_severity severity, int line, char *message){
+	DiagnosticRecord *records;
+	int capacity;
+
+	if(list->count == list->capacity){
+		capacity = list->capacity ? list->capacity * 2 : 8;
+		records = (DiagnosticRecord*)realloc(list->records, capacity * sizeof(DiagnosticRecord));
+		if(!records){
+			list->failed = true;
+			return false;
+		}
+		list->records = records;
+		list->capacity = capacity;
+	}
+	list->records[list->count].severity = severity;
+	list->records[list->count].line = line;
+	list->records[list->count].column = find_column(list, line, message);
+	list->records[list->count].message = message;
+	list->count++;
+	return true;
+}
@@ -0,0 +1,66 @@
+#ifndef DIAGNOSTICS_H
+#define DIAGNOSTICS_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include "definitions.h"
+
+#define DEFAULT_MAX_ERRORS 100/*errors after which a file is abandoned unless --max-errors says otherwise*/
+
+/*** STRUCTURE DEFINITIONS SECTION ***/
+
+/*severity of a diagnostic*/
+typedef enum diagnostic_severities{
+	DIAGNOSTIC_ERROR = 0,/*the source can't be assembled*/
+	DIAGNOSTIC_WARNING = 1/*the source was assembled but something looks wrong*/
+}diagnostic_severity;
+
+typedef struct{/*the error state of the file a thread is assembling*/
+	int errors;/*number of errors reported for the file*/
+	int limit;/*number of errors after which the file is abandoned (0 for no limit)*/
+	int line;/*line of the preprocessed source the passes are reading or 0 between the lines*/
+	const int *source_lines;/*source line of every preprocessed line or NULL to name the preprocessed lines*/
+	int source_line_count;/*number of lines in source_lines*/
+	bool muted;/*true while the errors are neither printed nor counted*/
+}DiagnosticCounter;
+
+typedef struct{/*a single error or warning recorded for a source*/
+	diagnostic_severity severity;/*severity of the message*/
+	int line;/*1 based line of the source the message is about or 0 when it is not about a line*/
+	int column;/*1 based column of the name the message quotes in that line or 0 when it is not found there*/
+	char *message;/*text of the message without the line and the trailing newline*/
+}DiagnosticRecord;
+
+typedef struct{/*the diagnostics a thread records for a source besides printing them*/
+	const char *source;/*the text of the source the columns are found in*/
+	size_t size;/*length of the source*/
+	DiagnosticRecord *records;/*the diagnostics in the order they were reported*/
+	int count;/*number of records*/
+	int capacity;/*capacity of the records array*/
+	bool failed;/*true if a diagnostic could not be recorded for lack of memory*/
+	int cursor_line;/*1 based line that starts at cursor (the search for the next line starts there)*/
+	size_t cursor;/*offset of the start of cursor_line in the source*/
+}DiagnosticList;
+
+/*** FUNCTION PROTOTYPES SECTION ***/
+
+FILE *error_output(void);/*function to return the stream that receives the error messages of the calling thread*/
+FILE *message_output(void);/*function to return the stream that receives the progress messages of the calling thread*/
+void redirect_output(FILE *messages,FILE *errors);/*function to send the messages of the calling thread to other streams*/
+void print_system_error(const char *message);/*function to print a message followed by the description of errno like perror*/
+void start_diagnostics(DiagnosticCounter *counter,int limit);/*function to count the errors the calling thread reports for a file*/
+void stop_diagnostics(void);/*function to stop counting the errors of the calling thread*/
+void set_diagnostic_line(int line);/*function to name the line the errors of the calling thread are reported on*/
+void mute_diagnostics(bool muted);/*function to stop or resume reporting the errors of the calling thread*/
+void report_error(const char *format,...);/*function to print an error message and count it for the file of the calling thread*/
+void report_warning(const char *format,...);/*function to print a warning message for the file of the calling thread*/
+void start_recording(DiagnosticList *list,const char *source,size_t size);/*function to record the diagnostics of the calling thread in a list*/
+void stop_recording(void);/*function to stop recording the diagnostics of the calling thread*/
+void free_diagnostic_list(DiagnosticList *list);/*function to free the records of a list*/
+int find_column(DiagnosticList *list,int line,const char *message);/*function to find the column of the name a message quotes in a line of the source*/
+bool record_diagnostic(DiagnosticList *list,diagnostic_severity severity,int line,char *message);/*function to append a diagnostic to a list*/
+bool error_limit_reached(void);/*function to check if the file of the calling thread has too many errors to go on*/
+
+#endif /*DIAGNOSTICS_H*/
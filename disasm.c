@@ -0,0 +1,1050 @@
+#include "first_pass.h"
+#include "object_format.h"
+#include "definitions.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/*
+* disasm
+* ------
+* decodes the object files of the assembler back into annotated listings and verifies every word on the way
+* a .ob is mapped together with its .ent and .ext when they exist, a .obb holds all three in its sections
+* the first word of every instruction is decoded with a single lookup of its opcode and addressing mode fields
+* in a table built from operations_info so the disassembler accepts exactly what the assembler encodes
+*
+* usage: disasm [-q] FILE...
+*   FILE is NAME NAME.ob or NAME.obb (NAME alone tries NAME.ob and then NAME.obb)
+*   -q only verifies the files and prints nothing but the errors, the exit status is 1 when any file has an error
+*/
+
+#define FIRST_WORD_FIELDS 4096/*number of values of the opcode and the two addressing mode fields (bits 3-14)*/
+#define REGISTER_WORD_MODES (REGISTER_ADDR | RELATIVE_ADDR)/*the addressing modes whose operands share a single word*/
+#define ARE_ABSOLUTE 4/*ARE of the first word immediate and register words*/
+#define ARE_RELOCATABLE 2/*ARE of the address of an internal label*/
+#define ARE_EXTERNAL 1/*ARE of the reference to an extern*/
+#define OUTPUT_BUFFER_SIZE (1 << 16)/*size of the buffer of the listings*/
+#define MAX_OPERAND_TEXT (MAX_LABEL_LENGTH + 16)/*longest text of a decoded operand*/
+
+/*** STRUCTURE DEFINITIONS SECTION ***/
+
+typedef struct{/*a file mapped into memory*/
+	const char *bytes;/*the contents or NULL when the file is empty*/
+	size_t size;/*length of the contents*/
+}MappedFile;
+
+typedef struct{/*an entry or an extern reference of an object file*/
+	char name[OBJECT_SYMBOL_NAME_LENGTH];/*null terminated name*/
+	long address;/*address of the entry or of the word that references the extern*/
+}ImageSymbol;
+
+typedef struct{/*the words and symbols of an object file*/
+	const char *name;/*the file in the messages*/
+	long base;/*address of the first code word*/
+	long code_length;/*number of code words*/
+	long data_length;/*number of data words*/
+	unsigned short *words;/*the code words followed by the data words*/
+	ImageSymbol *entries;/*the entries*/
+	int entry_count;/*number of entries*/
+	ImageSymbol *externs;/*the extern references*/
+	int extern_count;/*number of extern references*/
+	bool externs_known;/*true when a .ext or a .obb lists the extern references so every E word must be one of them*/
+	int *entry_of;/*the entry of every address of the image plus one (0 when it has none)*/
+	int *extern_of;/*the extern reference of every code word plus one (0 when it has none)*/
+	int label_width;/*width of the label column of the listing*/
+	int errors;/*number of errors reported so far*/
+}ObjectImage;
+
+/*** DECODING TABLES SECTION ***/
+
+/*
+* first_word_length
+* -----------------
+* the number of words of the instruction a first word starts indexed by its bits 3-14 (opcode source and destination modes)
+* 0 marks an opcode and modes the assembler never encodes (a mode that is not one hot or not allowed for the operation)
+*/
+signed char first_word_length[FIRST_WORD_FIELDS];
+
+/*
+* allowed_modes
+* -------------
+* the mask of the source and destination addressing modes of every opcode and the number of its operands
+*/
+unsigned char allowed_source_modes[OPERATION_COUNT];
+unsigned char allowed_destination_modes[OPERATION_COUNT];
+unsigned char operand_counts[OPERATION_COUNT];
+
+/*
+* build_decoding_tables
+* ---------------------
+* this function fills the decoding tables from operations_info which the first pass validates operands with
+*
+*/
+void build_decoding_tables(void){
+	int op, src, dest, i;
+
+	for(op=0 ; op<OPERATION_COUNT ; op++){
+		for(i=0 ; i<5 ; i++){
+			if(operations_info[op].valid_src_types[i] > 0){
+				allowed_source_modes[op] |= (unsigned char)operations_info[op].valid_src_types[i];
+			}
+			if(operations_info[op].valid_dest_types[i] > 0){
+				allowed_destination_modes[op] |= (unsigned char)operations_info[op].valid_dest_types[i];
+			}
+		}
+		operand_counts[op] = (unsigned char)((allowed_source_modes[op] != 0) + (allowed_destination_modes[op] != 0));
+		for(src=0 ; src<16 ; src++){
+			for(dest=0 ; dest<16 ; dest++){
+				signed char length = 0;
+
+				if(operand_counts[op] == 0 && src == 0 && dest == 0){
+					length = 1;
+				}
+				else if(operand_counts[op] == 1 && src == 0 && (dest & (dest - 1)) == 0 && (dest & allowed_destination_modes[op])){
+					length = 2;
+				}
+				else if(operand_counts[op] == 2 && (src & (src - 1)) == 0 && (src & allowed_source_modes[op]) &&
+					(dest & (dest - 1)) == 0 && (dest & allowed_destination_modes[op])){
+					length = (src & REGISTER_WORD_MODES) && (dest & REGISTER_WORD_MODES) ? 2 : 3;
+				}
+				first_word_length[(op << 8) | (src << 4) | dest] = length;
+			}
+		}
+	}
+}
+
+/*** MESSAGES SECTION ***/
+
+/*
+* report_word_error
+* -----------------
+* this function reports an error at a word of an image to stderr
+*
+* parameters:
+*   image: the image
+*   address: the address of the word or -1 for an error of the whole file
+*   format: printf style format of the message followed by its arguments
+*
+*/
+void report_word_error(ObjectImage *image, long address, const char *format, ...){
+	va_list arguments;
+
+	va_start(arguments, format);
+	if(address >= 0){
+		fprintf(stderr, "disasm: %s: %04ld: ", image->name, address);
+	}
+	else{
+		fprintf(stderr, "disasm: %s: ", image->name);
+	}
+	vfprintf(stderr, format, arguments);
+	fputc('\n', stderr);
+	va_end(arguments);
+	image->errors++;
+}
+
+/*
+* describe_mode
+* -------------
+* this function names the addressing mode of a mode field
+*
+* parameters:
+*   mode: the 4 bits of the field
+*
+* returns:
+*   const char*: the name of the mode
+*/
+const char *describe_mode(int mode){
+	switch(mode){
+		case 0:
+			return "no operand";
+		case IMMEDIATE_ADDR:
+			return "immediate";
+		case DIRECT_ADDR:
+			return "direct";
+		case RELATIVE_ADDR:
+			return "relative";
+		case REGISTER_ADDR:
+			return "register";
+		default:
+			return "an invalid mode";
+	}
+}
+
+/*
+* report_first_word
+* -----------------
+* this function explains why a first word does not start an instruction the assembler encodes
+* it only runs for a word the table rejected so the common path never takes it
+*
+* parameters:
+*   image: the image
+*   address: the address of the word
+*   word: the word
+*
+*/
+void report_first_word(ObjectImage *image, long address, unsigned int word){
+	int op = (word >> 11) & 0xF, src = (word >> 7) & 0xF, dest = (word >> 3) & 0xF;
+
+	if((word & 7) != ARE_ABSOLUTE){
+		report_word_error(image, address, "the first word of %s has ARE %d instead of %d", operations[op], word & 7, ARE_ABSOLUTE);
+	}
+	else if(operand_counts[op] < 2 && src){
+		report_word_error(image, address, "%s takes no source operand but its source is %s", operations[op], describe_mode(src));
+	}
+	else if(operand_counts[op] == 0 && dest){
+		report_word_error(image, address, "%s takes no operand but its destination is %s", operations[op], describe_mode(dest));
+	}
+	else if(operand_counts[op] == 2 && !(src && (src & (src - 1)) == 0 && (src & allowed_source_modes[op]))){
+		report_word_error(image, address, "the source of %s cannot be %s", operations[op], describe_mode(src));
+	}
+	else{
+		report_word_error(image, address, "the destination of %s cannot be %s", operations[op], describe_mode(dest));
+	}
+}
+
+/*** LOADING SECTION ***/
+
+/*
+* map_file
+* --------
+* this function maps a whole file into memory for reading
+*
+* parameters:
+*   path: the file
+*   file: receives the mapping
+*
+* returns:
+*   bool: true if the file was mapped false if it could not be opened (errno tells why)
+*/
+bool map_file(const char *path, MappedFile *file){
+	struct stat status;
+	int descriptor = open(path, O_RDONLY);
+	int error;
+
+	file->bytes = NULL;
+	file->size = 0;
+	if(descriptor < 0){
+		return false;
+	}
+	if(fstat(descriptor, &status) < 0){
+		error = errno;
+		close(descriptor);
+		errno = error;
+		return false;
+	}
+	file->size = (size_t)status.st_size;
+	if(file->size > 0){
+		file->bytes = (const char*)mmap(NULL, file->size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+		if(file->bytes == (const char*)MAP_FAILED){
+			error = errno;
+			file->bytes = NULL;
+			close(descriptor);
+			errno = error;
+			return false;
+		}
+	}
+	close(descriptor);
+	return true;
+}
+
+/*
+* unmap_file
+* ----------
+* this function releases the mapping of a file
+*
+* parameters:
+*   file: the mapping
+*
+*/
+void unmap_file(MappedFile *file){
+	if(file->bytes){
+		munmap((void*)file->bytes, file->size);
+	}
+	file->bytes = NULL;
+	file->size = 0;
+}
+
+/*
+* read_text_number
+* ----------------
+* this function reads a number of a text object file after the blanks that precede it
+*
+* parameters:
+*   position: the position in the text which is moved past the number
+*   end: the end of the text
+*   radix: 10 or 8
+*   value: receives the number
+*
+* returns:
+*   bool: true if a number was read false if the text has no digit there
+*/
+bool read_text_number(const char **position, const char *end, int radix, long *value){
+	const char *p = *position;
+	bool negative = false;
+
+	while(p < end && (*p == ' ' || *p == '\t')){
+		p++;
+	}
+	if(p < end && *p == '-'){
+		negative = true;
+		p++;
+	}
+	if(p >= end || *p < '0' || *p >= '0' + radix){
+		return false;
+	}
+	for(*value=0 ; p<end && *p>='0' && *p<'0'+radix && *value<=0xFFFFFFL ; p++){
+		*value = *value * radix + (*p - '0');
+	}
+	*value = negative ? -*value : *value;
+	*position = p;
+	return true;
+}
+
+/*
+* end_text_line
+* -------------
+* this function moves past the end of a line of a text object file
+*
+* parameters:
+*   position: the position in the text
+*   end: the end of the text
+*
+* returns:
+*   bool: true if only blanks were left on the line false otherwise
+*/
+bool end_text_line(const char **position, const char *end){
+	const char *p = *position;
+
+	while(p < end && (*p == ' ' || *p == '\t' || *p == '\r')){
+		p++;
+	}
+	if(p < end && *p != '\n'){
+		return false;
+	}
+	*position = p < end ? p + 1 : p;
+	return true;
+}
+
+/*
+* allocate_image
+* --------------
+* this function allocates the words and the symbol lookups of an image once its lengths are known
+*
+* parameters:
+*   image: the image with its lengths set
+*
+* returns:
+*   bool: true if the memory was allocated false otherwise
+*/
+bool allocate_image(ObjectImage *image){
+	long total = image->code_length + image->data_length;
+
+	image->words = (unsigned short*)malloc((total > 0 ? total : 1) * sizeof(unsigned short));
+	image->entry_of = (int*)calloc(total > 0 ? total : 1, sizeof(int));
+	image->extern_of = (int*)calloc(image->code_length > 0 ? image->code_length : 1, sizeof(int));
+	if(!image->words || !image->entry_of || !image->extern_of){
+		report_word_error(image, -1, "out of memory");
+		return false;
+	}
+	return true;
+}
+
+/*
+* parse_text_object
+* -----------------
+* this function reads the words of a text .ob (a line of the code and data lengths then a line of address and octal word per word)
+*
+* parameters:
+*   image: the image to fill
+*   file: the mapped .ob
+*
+* returns:
+*   bool: true if the file was read false if it is malformed
+*/
+bool parse_text_object(ObjectImage *image, const MappedFile *file){
+	const char *p = file->bytes, *end = file->bytes + file->size;
+	long i, address, word;
+
+	if(!read_text_number(&p, end, 10, &image->code_length) || !read_text_number(&p, end, 10, &image->data_length) ||
+		!end_text_line(&p, end) || image->code_length < 0 || image->data_length < 0 || image->code_length + image->data_length > CODE_ARR_IMG_LENGTH){
+		report_word_error(image, -1, "the first line is not the code and data lengths");
+		return false;
+	}
+	if(!allocate_image(image)){
+		return false;
+	}
+	image->base = IC_INIT_VALUE;
+	for(i=0 ; i<image->code_length+image->data_length ; i++){
+		if(!read_text_number(&p, end, 10, &address) || !read_text_number(&p, end, 8, &word) || !end_text_line(&p, end)){
+			report_word_error(image, -1, "line %ld is not an address and an octal word", i + 2);
+			return false;
+		}
+		if(i == 0){
+			image->base = address;
+		}
+		if(address != image->base + i){
+			report_word_error(image, address, "the word should be at address %04ld", image->base + i);
+			return false;
+		}
+		if(word > 077777){
+			report_word_error(image, address, "%lo is wider than 15 bits", word);
+			return false;
+		}
+		image->words[i] = (unsigned short)word;
+	}
+	if(p < end){
+		report_word_error(image, -1, "the file goes on after the %ld words its first line counts", i);
+		return false;
+	}
+	return true;
+}
+
+/*
+* parse_text_symbols
+* ------------------
+* this function reads a .ent or .ext (a line of name and address per symbol)
+*
+* parameters:
+*   image: the image the symbols belong to (for the messages)
+*   file: the mapped file
+*   extension: the extension of the file in the messages
+*   symbols: receives the allocated symbols
+*   count: receives the number of symbols
+*
+* returns:
+*   bool: true if the file was read false if it is malformed
+*/
+bool parse_text_symbols(ObjectImage *image, const MappedFile *file, const char *extension, ImageSymbol **symbols, int *count){
+	const char *p = file->bytes, *end = file->bytes + file->size, *start;
+	int lines = 0, capacity;
+
+	for(start=p ; start<end ; start++){
+		lines += *start == '\n';
+	}
+	capacity = lines + 1;
+	*symbols = (ImageSymbol*)malloc(capacity * sizeof(ImageSymbol));
+	*count = 0;
+	if(!*symbols){
+		report_word_error(image, -1, "out of memory");
+		return false;
+	}
+	while(p < end && *count < capacity){
+		ImageSymbol *symbol = &(*symbols)[*count];
+
+		for(start=p ; p<end && *p!=' ' && *p!='\t' && *p!='\n' ; p++);
+		if(p == start || p - start >= OBJECT_SYMBOL_NAME_LENGTH){
+			report_word_error(image, -1, "line %d of the %s does not start with a name", *count + 1, extension);
+			return false;
+		}
+		memcpy(symbol->name, start, p - start);
+		symbol->name[p - start] = '\0';
+		if(!read_text_number(&p, end, 10, &symbol->address) || !end_text_line(&p, end)){
+			report_word_error(image, -1, "line %d of the %s is not a name and an address", *count + 1, extension);
+			return false;
+		}
+		(*count)++;
+	}
+	return true;
+}
+
+/*
+* read_little_endian
+* ------------------
+* this function reads an unsigned little endian field of a binary object file
+*
+* parameters:
+*   bytes: the first byte of the field
+*   size: the number of bytes of the field (2 or 4)
+*
+* returns:
+*   unsigned long: the value of the field
+*/
+unsigned long read_little_endian(const char *bytes, int size){
+	unsigned long value = 0;
+	int i;
+
+	for(i=size-1 ; i>=0 ; i--){
+		value = (value << 8) | (unsigned char)bytes[i];
+	}
+	return value;
+}
+
+/*
+* section_fits
+* ------------
+* this function checks that a section of a binary object file lies inside the file
+*
+* parameters:
+*   file: the mapped file
+*   offset: the offset of the section
+*   count: the number of records of the section
+*   record_size: the size of a record
+*
+* returns:
+*   bool: true if the section is inside the file false otherwise
+*/
+bool section_fits(const MappedFile *file, unsigned long offset, unsigned long count, unsigned long record_size){
+	return offset <= file->size && count <= (file->size - offset) / record_size;
+}
+
+/*
+* parse_binary_symbols
+* --------------------
+* this function copies the entry or extern reference table of a binary object file
+*
+* parameters:
+*   image: the image the symbols belong to (for the messages)
+*   records: the first record of the table
+*   count: the number of records
+*   symbols: receives the allocated symbols
+*
+* returns:
+*   bool: true if the table was copied false if memory ran out or a name is not terminated
+*/
+bool parse_binary_symbols(ObjectImage *image, const char *records, int count, ImageSymbol **symbols){
+	int i;
+
+	*symbols = (ImageSymbol*)malloc((count > 0 ? count : 1) * sizeof(ImageSymbol));
+	if(!*symbols){
+		report_word_error(image, -1, "out of memory");
+		return false;
+	}
+	for(i=0 ; i<count ; i++, records+=sizeof(ObjectSymbol)){
+		if(!memchr(records, '\0', OBJECT_SYMBOL_NAME_LENGTH)){
+			report_word_error(image, -1, "the name of symbol %d is not terminated", i);
+			return false;
+		}
+		strcpy((*symbols)[i].name, records);
+		(*symbols)[i].address = (long)read_little_endian(records + OBJECT_SYMBOL_NAME_LENGTH, 4);
+	}
+	return true;
+}
+
+/*
+* parse_binary_object
+* -------------------
+* this function reads the words entries and extern references of a .obb (object_format.h)
+*
+* parameters:
+*   image: the image to fill
+*   file: the mapped .obb
+*
+* returns:
+*   bool: true if the file was read false if its header or a section is malformed
+*/
+bool parse_binary_object(ObjectImage *image, const MappedFile *file){
+	const char *header = file->bytes;
+	unsigned long code_offset, data_offset, entry_count, extern_count;
+	long i;
+
+	if(file->size < sizeof(ObjectHeader) || read_little_endian(header + 4, 2) != OBJECT_VERSION ||
+		read_little_endian(header + 6, 2) < sizeof(ObjectHeader) || read_little_endian(header + 52, 4) != file->size){
+		report_word_error(image, -1, "the header is not a version %d header of a file this size", OBJECT_VERSION);
+		return false;
+	}
+	image->base = (long)read_little_endian(header + 8, 4);
+	image->code_length = (long)read_little_endian(header + 12, 4);
+	image->data_length = (long)read_little_endian(header + 16, 4);
+	entry_count = read_little_endian(header + 20, 4);
+	extern_count = read_little_endian(header + 24, 4);
+	code_offset = read_little_endian(header + 28, 4);
+	data_offset = read_little_endian(header + 32, 4);
+	if(image->code_length + image->data_length > CODE_ARR_IMG_LENGTH || entry_count > CODE_ARR_IMG_LENGTH || extern_count > CODE_ARR_IMG_LENGTH ||
+		!section_fits(file, code_offset, image->code_length, 2) || !section_fits(file, data_offset, image->data_length, 2) ||
+		!section_fits(file, read_little_endian(header + 36, 4), entry_count, sizeof(ObjectSymbol)) ||
+		!section_fits(file, read_little_endian(header + 40, 4), extern_count, sizeof(ObjectSymbol))){
+		report_word_error(image, -1, "a section lies outside the file");
+		return false;
+	}
+	if(!allocate_image(image)){
+		return false;
+	}
+	for(i=0 ; i<image->code_length ; i++){
+		image->words[i] = (unsigned short)read_little_endian(file->bytes + code_offset + 2 * i, 2);
+	}
+	for(i=0 ; i<image->data_length ; i++){
+		image->words[image->code_length + i] = (unsigned short)read_little_endian(file->bytes + data_offset + 2 * i, 2);
+	}
+	for(i=0 ; i<image->code_length+image->data_length ; i++){
+		if(image->words[i] > 077777){
+			report_word_error(image, image->base + i, "%o is wider than 15 bits", image->words[i]);
+			return false;
+		}
+	}
+	image->entry_count = (int)entry_count;
+	image->extern_count = (int)extern_count;
+	image->externs_known = true;
+	return parse_binary_symbols(image, file->bytes + read_little_endian(header + 36, 4), image->entry_count, &image->entries) &&
+		parse_binary_symbols(image, file->bytes + read_little_endian(header + 40, 4), image->extern_count, &image->externs);
+}
+
+/*
+* load_text_symbols
+* -----------------
+* this function reads the .ent or .ext next to a .ob when it exists
+*
+* parameters:
+*   image: the image the symbols belong to
+*   stem: the path of the .ob without its extension
+*   extension: ".ent" or ".ext"
+*   symbols: receives the allocated symbols (NULL when the file does not exist)
+*   count: receives the number of symbols
+*
+* returns:
+*   int: 1 if the file was read 0 if it does not exist and -1 if it could not be read
+*/
+int load_text_symbols(ObjectImage *image, const char *stem, const char *extension, ImageSymbol **symbols, int *count){
+	MappedFile file;
+	char *path = make_path(stem, extension, NULL);
+	int result;
+
+	*symbols = NULL;
+	*count = 0;
+	if(!path){
+		report_word_error(image, -1, "out of memory");
+		return -1;
+	}
+	if(!map_file(path, &file)){
+		result = errno == ENOENT ? 0 : -1;
+		if(result < 0){
+			report_word_error(image, -1, "cannot read %s: %s", path, strerror(errno));
+		}
+		free(path);
+		return result;
+	}
+	result = parse_text_symbols(image, &file, extension, symbols, count) ? 1 : -1;
+	unmap_file(&file);
+	free(path);
+	return result;
+}
+
+/*
+* link_symbols
+* ------------
+* this function indexes the entries by address and the extern references by word and checks that they lie inside the image
+*
+* parameters:
+*   image: the loaded image
+*
+* returns:
+*   bool: true if every symbol lies inside the image false otherwise
+*/
+bool link_symbols(ObjectImage *image){
+	long total = image->code_length + image->data_length, offset;
+	int i, length;
+
+	for(i=0 ; i<image->entry_count ; i++){
+		offset = image->entries[i].address - image->base;
+		if(offset < 0 || offset >= total){
+			report_word_error(image, image->entries[i].address, "the entry %s lies outside the image", image->entries[i].name);
+			continue;
+		}
+		image->entry_of[offset] = i + 1;
+		length = (int)strlen(image->entries[i].name) + 2;
+		image->label_width = length > image->label_width ? length : image->label_width;
+	}
+	for(i=0 ; i<image->extern_count ; i++){
+		offset = image->externs[i].address - image->base;
+		if(offset < 0 || offset >= image->code_length){
+			report_word_error(image, image->externs[i].address, "the reference to %s lies outside the code image", image->externs[i].name);
+		}
+		else if(image->extern_of[offset]){
+			report_word_error(image, image->externs[i].address, "the word references both %s and %s", image->externs[image->extern_of[offset] - 1].name, image->externs[i].name);
+		}
+		else{
+			image->extern_of[offset] = i + 1;
+		}
+	}
+	return image->errors == 0;
+}
+
+/*
+* free_image
+* ----------
+* this function releases everything an image allocated
+*
+* parameters:
+*   image: the image
+*
+*/
+void free_image(ObjectImage *image){
+	free(image->words);
+	free(image->entries);
+	free(image->externs);
+	free(image->entry_of);
+	free(image->extern_of);
+}
+
+/*
+* load_image
+* ----------
+* this function loads an object file given as NAME NAME.ob or NAME.obb
+*
+* parameters:
+*   argument: the file as given on the command line
+*   image: the image to fill (freed with free_image even when loading failed)
+*
+* returns:
+*   bool: true if the image was loaded false otherwise
+*/
+bool load_image(const char *argument, ObjectImage *image){
+	size_t length = strlen(argument);
+	bool binary = length > 4 && strcmp(argument + length - 4, ".obb") == 0;
+	char *stem, *path;
+	MappedFile file;
+	bool loaded;
+
+	memset(image, 0, sizeof(ObjectImage));
+	image->name = argument;
+	stem = make_path(argument, NULL, NULL);
+	if(!stem){
+		report_word_error(image, -1, "out of memory");
+		return false;
+	}
+	if(binary || (length > 3 && strcmp(argument + length - 3, ".ob") == 0)){
+		stem[length - (binary ? 4 : 3)] = '\0';
+		path = make_path(argument, NULL, NULL);
+	}
+	else{
+		path = make_path(argument, ".ob", NULL);
+		if(path && access(path, F_OK) < 0){
+			char *binary_path = make_path(argument, ".obb", NULL);
+
+			if(binary_path && access(binary_path, F_OK) == 0){
+				free(path);
+				path = binary_path;
+				binary = true;
+			}
+			else{
+				free(binary_path);
+			}
+		}
+	}
+	if(!path){
+		report_word_error(image, -1, "out of memory");
+		free(stem);
+		return false;
+	}
+	if(!map_file(path, &file)){
+		report_word_error(image, -1, "cannot read %s: %s", path, strerror(errno));
+		free(stem);
+		free(path);
+		return false;
+	}
+	if(binary && (file.size < OBJECT_MAGIC_LENGTH || memcmp(file.bytes, OBJECT_MAGIC, OBJECT_MAGIC_LENGTH) != 0)){
+		report_word_error(image, -1, "%s is not a binary object file", path);
+		loaded = false;
+	}
+	else if(binary){
+		loaded = parse_binary_object(image, &file);
+	}
+	else{
+		loaded = parse_text_object(image, &file) && load_text_symbols(image, stem, ".ent", &image->entries, &image->entry_count) >= 0;
+		if(loaded){
+			switch(load_text_symbols(image, stem, ".ext", &image->externs, &image->extern_count)){
+				case 1:
+					image->externs_known = true;
+					break;
+				case -1:
+					loaded = false;
+					break;
+			}
+		}
+	}
+	unmap_file(&file);
+	free(stem);
+	free(path);
+	return loaded && link_symbols(image);
+}
+
+/*** DECODING SECTION ***/
+
+/*
+* decode_operand
+* --------------
+* this function decodes the word of a direct or immediate operand
+*
+* parameters:
+*   image: the image
+*   index: the index of the word in the image
+*   mode: the addressing mode of the operand
+*   text: receives the operand as the source would write it followed by its ARE or NULL when only verifying
+*
+*/
+void decode_operand(ObjectImage *image, long index, int mode, char *text){
+	unsigned int word = image->words[index], are = word & 7;
+	long value = (long)((word >> 3) & 0xFFF);
+	int entry, reference;
+
+	if(mode == IMMEDIATE_ADDR){
+		if(text){
+			sprintf(text, "#%ld", value & 0x800 ? value - 0x1000 : value);
+		}
+		if(are != ARE_ABSOLUTE){
+			report_word_error(image, image->base + index, "an immediate operand has ARE %u instead of %d", are, ARE_ABSOLUTE);
+		}
+	}
+	else if(are == ARE_RELOCATABLE){
+		entry = value >= image->base && value < image->base + image->code_length + image->data_length ? image->entry_of[value - image->base] : 0;
+		if(text && entry){
+			sprintf(text, "%s (R %04ld)", image->entries[entry - 1].name, value);
+		}
+		else if(text){
+			sprintf(text, "%04ld (R)", value);
+		}
+		if(value < image->base || value >= image->base + image->code_length + image->data_length){
+			report_word_error(image, image->base + index, "the address %04ld lies outside the image", value);
+		}
+		if(image->extern_of[index]){
+			report_word_error(image, image->base + index, "the .ext lists a reference to %s at a relocatable word", image->externs[image->extern_of[index] - 1].name);
+		}
+	}
+	else if(are == ARE_EXTERNAL){
+		reference = image->extern_of[index];
+		if(text){
+			sprintf(text, "%s (E)", reference ? image->externs[reference - 1].name : "?");
+		}
+		if(value){
+			report_word_error(image, image->base + index, "an extern reference holds %ld instead of 0", value);
+		}
+		if(!reference && image->externs_known){
+			report_word_error(image, image->base + index, "the word references an extern the extern references do not list");
+		}
+	}
+	else{
+		if(text){
+			sprintf(text, "%04ld (?)", value);
+		}
+		report_word_error(image, image->base + index, "a direct operand has ARE %u instead of %d or %d", are, ARE_RELOCATABLE, ARE_EXTERNAL);
+	}
+}
+
+/*
+* decode_registers
+* ----------------
+* this function decodes the word of a register or relative operand (or the word both operands share)
+*
+* parameters:
+*   image: the image
+*   index: the index of the word in the image
+*   src_mode: the addressing mode of the source register or 0 when the word holds no source
+*   dest_mode: the addressing mode of the destination register or 0 when the word holds no destination
+*   src_text: receives the source register or NULL when only verifying
+*   dest_text: receives the destination register or NULL when only verifying
+*
+*/
+void decode_registers(ObjectImage *image, long index, int src_mode, int dest_mode, char *src_text, char *dest_text){
+	unsigned int word = image->words[index];
+
+	if(src_text){
+		sprintf(src_text, "%sr%u", src_mode == RELATIVE_ADDR ? "*" : "", (word >> 6) & 7);
+	}
+	if(dest_text){
+		sprintf(dest_text, "%sr%u", dest_mode == RELATIVE_ADDR ? "*" : "", (word >> 3) & 7);
+	}
+	if((word & 7) != ARE_ABSOLUTE){
+		report_word_error(image, image->base + index, "a register word has ARE %u instead of %d", word & 7, ARE_ABSOLUTE);
+	}
+	if((word >> 9) || (!src_mode && ((word >> 6) & 7)) || (!dest_mode && ((word >> 3) & 7))){
+		report_word_error(image, image->base + index, "a register word sets bits no register of its instruction uses");
+	}
+	if(image->extern_of[index]){
+		report_word_error(image, image->base + index, "the extern references list %s at a register word", image->externs[image->extern_of[index] - 1].name);
+	}
+}
+
+/*
+* print_word
+* ----------
+* this function prints a line of the listing
+*
+* parameters:
+*   output: the listing or NULL when only verifying
+*   image: the image
+*   index: the index of the word in the image
+*   text: the decoded word
+*
+*/
+void print_word(FILE *output, const ObjectImage *image, long index, const char *text){
+	int entry = image->entry_of[index];
+
+	if(output){
+		fprintf(output, "%04ld %05o  %s%s%-*s%s\n", image->base + index, image->words[index],
+			entry ? image->entries[entry - 1].name : "", entry ? ":" : "", image->label_width - (entry ? (int)strlen(image->entries[entry - 1].name) + 1 : 0), "", text);
+	}
+}
+
+/*
+* disassemble_instruction
+* -----------------------
+* this function decodes an instruction and the operand words that follow its first word
+*
+* parameters:
+*   output: the listing or NULL when only verifying
+*   image: the image
+*   index: the index of the first word in the image
+*
+* returns:
+*   long: the number of words of the instruction or 0 when it is not an instruction the assembler encodes
+*/
+long disassemble_instruction(FILE *output, ObjectImage *image, long index){
+	unsigned int word = image->words[index];
+	int op = (word >> 11) & 0xF, src = (word >> 7) & 0xF, dest = (word >> 3) & 0xF;
+	long length = (word & 7) == ARE_ABSOLUTE ? first_word_length[word >> 3] : 0;
+	char src_buffer[MAX_OPERAND_TEXT], dest_buffer[MAX_OPERAND_TEXT], line[3 * MAX_OPERAND_TEXT];
+	char *src_text = output ? src_buffer : NULL, *dest_text = output ? dest_buffer : NULL;/*the operands are only formatted for a listing*/
+
+	if(!length){
+		report_first_word(image, image->base + index, word);
+		print_word(output, image, index, "?");
+		return 0;
+	}
+	if(index + length > image->code_length){
+		report_word_error(image, image->base + index, "%s needs %ld words but the code image ends after %ld", operations[op], length, image->code_length - index);
+		print_word(output, image, index, operations[op]);
+		return 0;
+	}
+	if(length == 2 && operand_counts[op] == 2){/*both operands share the register word*/
+		decode_registers(image, index + 1, src, dest, src_text, dest_text);
+	}
+	else if(operand_counts[op] == 2){
+		if(src & REGISTER_WORD_MODES){
+			decode_registers(image, index + 1, src, 0, src_text, NULL);
+		}
+		else{
+			decode_operand(image, index + 1, src, src_text);
+		}
+		if(dest & REGISTER_WORD_MODES){
+			decode_registers(image, index + 2, 0, dest, NULL, dest_text);
+		}
+		else{
+			decode_operand(image, index + 2, dest, dest_text);
+		}
+	}
+	else if(operand_counts[op] == 1){
+		if(dest & REGISTER_WORD_MODES){
+			decode_registers(image, index + 1, 0, dest, NULL, dest_text);
+		}
+		else{
+			decode_operand(image, index + 1, dest, dest_text);
+		}
+	}
+	if(!output){
+		return length;
+	}
+	if(operand_counts[op] == 0){
+		print_word(output, image, index, operations[op]);
+	}
+	else if(operand_counts[op] == 1){
+		sprintf(line, "%s %s", operations[op], dest_text);
+		print_word(output, image, index, line);
+		sprintf(line, "  dest %s", dest_text);
+		print_word(output, image, index + 1, line);
+	}
+	else if(length == 2){
+		sprintf(line, "%s %s, %s", operations[op], src_text, dest_text);
+		print_word(output, image, index, line);
+		sprintf(line, "  src %s dest %s", src_text, dest_text);
+		print_word(output, image, index + 1, line);
+	}
+	else{
+		sprintf(line, "%s %s, %s", operations[op], src_text, dest_text);
+		print_word(output, image, index, line);
+		sprintf(line, "  src %s", src_text);
+		print_word(output, image, index + 1, line);
+		sprintf(line, "  dest %s", dest_text);
+		print_word(output, image, index + 2, line);
+	}
+	return length;
+}
+
+/*
+* disassemble_image
+* -----------------
+* this function decodes every word of an image and prints its listing
+* an instruction that cannot be decoded is reported and the decoding goes on at the next word
+*
+* parameters:
+*   output: the listing or NULL when only verifying
+*   image: the loaded image
+*
+* returns:
+*   bool: true if every word was decoded without an error false otherwise
+*/
+bool disassemble_image(FILE *output, ObjectImage *image){
+	long index, length, value;
+	char line[MAX_OPERAND_TEXT];
+	int references = 0;
+
+	if(output){
+		fprintf(output, "; %s: base %04ld, %ld code words, %ld data words, %d entries, %d extern references\n",
+			image->name, image->base, image->code_length, image->data_length, image->entry_count, image->extern_count);
+	}
+	for(index=0 ; index<image->code_length ; index+=length > 0 ? length : 1){
+		length = disassemble_instruction(output, image, index);
+	}
+	for(index=0 ; index<image->code_length ; index++){
+		references += image->extern_of[index] && (image->words[index] & 7) == ARE_EXTERNAL;
+	}
+	if(references != image->extern_count){
+		report_word_error(image, -1, "%d of the %d extern references are not at extern words", image->extern_count - references, image->extern_count);
+	}
+	for(index=image->code_length ; index<image->code_length+image->data_length && output ; index++){
+		value = image->words[index] & 0x4000 ? (long)image->words[index] - 0x8000 : (long)image->words[index];
+		if(value >= ' ' && value <= '~'){
+			sprintf(line, ".data %ld '%c'", value, (int)value);
+		}
+		else{
+			sprintf(line, ".data %ld", value);
+		}
+		print_word(output, image, index, line);
+	}
+	return image->errors == 0;
+}
+
+/*** MAIN SECTION ***/
+
+/*
+* main
+* ----
+* this function disassembles or verifies every object file named on the command line
+*
+* parameters:
+*   argc: the number of arguments
+*   argv: the arguments
+*
+* returns:
+*   int: 0 if every file was decoded without an error 1 otherwise
+*/
+int main(int argc, char *argv[]){
+	ObjectImage image;
+	FILE *output = stdout;
+	bool success = true;
+	int i, first_file = 1;
+
+	if(argc > 1 && strcmp(argv[1], "-q") == 0){
+		output = NULL;
+		first_file = 2;
+	}
+	if(first_file >= argc || argv[first_file][0] == '-'){
+		fprintf(stderr, "usage: %s [-q] <file1> <file2> ... <fileN>\n", argv[0]);
+		fprintf(stderr, "  a file is NAME NAME.ob or NAME.obb, the .ent and .ext next to a .ob are read when they exist\n");
+		fprintf(stderr, "  -q             only verify the files and print nothing but the errors\n");
+		return 1;
+	}
+	setvbuf(stdout, NULL, _IOFBF, OUTPUT_BUFFER_SIZE);
+	build_decoding_tables();
+	for(i=first_file ; i<argc ; i++){
+		if(!load_image(argv[i], &image) || !disassemble_image(output, &image)){
+			success = false;
+		}
+		free_image(&image);
+	}
+	return success ? 0 : 1;
+}
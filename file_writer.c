@@ -1,4 +1,6 @@
 #include"file_writer.h"
+#include "stats.h"
+#include "trace.h"
 
 /* 
  * convert_code_word_to_binary
@@ -94,142 +96,574 @@ unsigned int convert_binary_to_octal(unsigned int binary_value){/*convert a bina
 }
 
 /* 
- * write_ob_file
- * -------------
- * this function writes the machine code (both code and data segments) to an output file in the specified format
- * it converts each word in the code and data segments to its binary representation then to octal and writes them to the file
+ * write_relocations
+ * -----------------
+ * this function writes the address of every relocated word to a stream one address per line
  * 
  * parameters:
- *   code_img: array of pointers to machinewordsarray structures representing the code segment
- *   data_img: array of long integers representing the data segment
- *   icf: the final value of the instruction counter after the first pass
- *   dcf: the final value of the data counter after the first pass
- *   filename: the base name of the file to which the output will be written
+ *   file: the stream that receives the addresses
+ *   relocations: the relocation table of the code image
+ *   load_base: the address of the first code word
  */
-void write_ob_file(MachineWordsArray**code_img,long*data_img,long icf,long dcf,const char*filename){/*write the converted words to a file*/
-	FILE *file;/*declare a file pointer*/
+void write_relocations(FILE *file, RelocationArray *relocations, long load_base){
+	int i;/*declare a loop counter*/
+
+	for(i=0 ; i<relocations->count ; i++){/*write the address of each relocated word*/
+		fprintf(file, "%04ld\n", relocations->indices[i] + load_base);
+	}
+}
+
+/*** BINARY OBJECT SECTION ***/
+
+/* 
+ * write_little_endian
+ * -------------------
+ * this function writes an unsigned value to a file as a sequence of bytes starting from the least significant one
+ * writing byte by byte keeps the binary object identical on every host regardless of its own byte order
+ * 
+ * parameters:
+ *   file: the file to write to
+ *   value: the value to be written
+ *   size: the number of bytes to write
+ */
+void write_little_endian(FILE *file, unsigned long value, int size){
+	int i;/*declare a loop counter*/
+
+	for(i=0 ; i<size ; i++){/*write the bytes from the least significant to the most significant*/
+		fputc((int)((value >> (8*i)) & 0xFF), file);
+	}
+}
+
+/* 
+ * write_binary_symbol
+ * -------------------
+ * this function writes a single record of the entry or extern reference table of the binary object
+ * the name is padded with null bytes up to its fixed length
+ * 
+ * parameters:
+ *   file: the file to write to
+ *   name: the symbol name
+ *   address: the address stored in the record
+ */
+void write_binary_symbol(FILE *file, const char *name, long address){
 	int i;/*declare a loop counter*/
-	unsigned int binary_value, octal_value;/*declare variables for binary and octal values*/
-	char output_filename[MAX_FILENAME_LENGTH + 5];/*declare a string to hold the output filename with .ob suffix*/
+	int name_length = strlen(name);/*length of the symbol name*/
 
-	/*construct the output filename with .ob suffix*/
-	sprintf(output_filename, "%s.ob", filename);
+	for(i=0 ; i<OBJECT_SYMBOL_NAME_LENGTH ; i++){/*write the name padded with null bytes*/
+		fputc((i < name_length && i < OBJECT_SYMBOL_NAME_LENGTH - 1) ? name[i] : '\0', file);
+	}
+	write_little_endian(file, (unsigned long)address, 4);/*write the address*/
+}
+
+/* 
+ * count_extern_references
+ * -----------------------
+ * this function counts the extern references recorded in the null terminated extern printing array
+ * 
+ * parameters:
+ *   extern_printing_array: array of externentry structures terminated by an empty name or NULL if there are no references
+ * 
+ * returns:
+ *   the number of extern references
+ */
+int count_extern_references(ExternEntry *extern_printing_array){
+	int count = 0;/*initialize the counter*/
 
-	file = fopen(output_filename, "w");/*open the file for writing*/
-	if(!file){/*check if the file failed to open*/
-		perror("error opening file for writing");/*print an error message*/
-		exit(EXIT_FAILURE);/*exit the program with failure status*/
+	while(extern_printing_array != NULL && extern_printing_array[count].name[0] != '\0'){
+		count++;
 	}
+	return count;/*return the number of references*/
+}
 
-	/*write header with ic and dc values*/
-	fprintf(file, "%ld %ld\n", icf - IC_INIT_VALUE, dcf);
+/* 
+ * write_entries_binary
+ * --------------------
+ * this function is the binary counterpart of the .ent file
+ * it writes the entry table of the binary object in the same order the .ent file lists the entries
+ * 
+ * parameters:
+ *   file: the binary object file positioned at the entry table
+ *   ext_entry_array: array of externentry structures containing the entries to be written
+ */
+void write_entries_binary(FILE *file, ExternEntryArray *ext_entry_array){
+	int i;/*declare a loop counter*/
 
-	/*process code image*/
-	for(i=0 ; i<icf-IC_INIT_VALUE ; i++){
+	for(i=ext_entry_array->entry_count-1 ; i>=0 ; i--){/*write each entry in reverse order like the .ent file*/
+		write_binary_symbol(file, ext_entry_array->entries[i].name, ext_entry_array->entries[i].line_number);
+	}
+}
+
+/* 
+ * write_externs_binary
+ * --------------------
+ * this function is the binary counterpart of the .ext file
+ * it writes the extern reference table of the binary object one record per referencing word
+ * 
+ * parameters:
+ *   file: the binary object file positioned at the extern reference table
+ *   extern_printing_array: array of externentry structures terminated by an empty name or NULL if there are no references
+ */
+void write_externs_binary(FILE *file, ExternEntry *extern_printing_array){
+	int i;/*declare a loop counter*/
+
+	for(i=0 ; extern_printing_array != NULL && extern_printing_array[i].name[0] != '\0' ; i++){/*write each extern reference*/
+		write_binary_symbol(file, extern_printing_array[i].name, extern_printing_array[i].line_number);
+	}
+}
+
+/* 
+ * write_relocations_binary
+ * ------------------------
+ * this function writes the relocation table of the binary object as 32-bit code image indices
+ * 
+ * parameters:
+ *   file: the binary object file positioned at the relocation table
+ *   relocations: the relocation table of the code image
+ */
+void write_relocations_binary(FILE *file, RelocationArray *relocations){
+	int i;/*declare a loop counter*/
+
+	for(i=0 ; i<relocations->count ; i++){/*write each relocated index*/
+		write_little_endian(file, relocations->indices[i], 4);
+	}
+}
+
+/* 
+ * write_object_binary
+ * -------------------
+ * this function writes the header the code image the data image and the entry extern and relocation tables of a binary object
+ * the layout is described in object_format.h
+ * 
+ * parameters:
+ *   file: the stream that receives the binary object
+ *   code_img: array of pointers to machinewordsarray structures representing the code segment
+ *   data_img: array of long integers representing the data segment
+ *   icf: the final value of the instruction counter after the second pass
+ *   dcf: the final value of the data counter after the second pass
+ *   ext_entry_array: array of externentry structures containing the entries to be written
+ *   extern_printing_array: array of externentry structures containing the extern references to be written
+ *   relocations: the relocation table of the code image
+ *   load_base: the address of the first code word
+ */
+void write_object_binary(FILE *file, MachineWordsArray **code_img, long *data_img, long icf, long dcf, ExternEntryArray *ext_entry_array, ExternEntry *extern_printing_array, RelocationArray *relocations, long load_base){
+	int i;/*declare a loop counter*/
+	unsigned int binary_value;/*declare a variable for the binary value of a word*/
+	unsigned long code_length = icf - IC_INIT_VALUE;/*number of words in the code image*/
+	unsigned long extern_count = count_extern_references(extern_printing_array);/*number of extern references*/
+	unsigned long data_offset, entry_offset, extern_offset, relocation_offset, file_size;/*offsets of the sections*/
+
+	/*compute the offsets of the sections*/
+	data_offset = sizeof(ObjectHeader) + 2*code_length;
+	entry_offset = (data_offset + 2*dcf + 3) & ~3UL;/*align the symbol tables to 4 bytes*/
+	extern_offset = entry_offset + sizeof(ObjectSymbol)*ext_entry_array->entry_count;
+	relocation_offset = extern_offset + sizeof(ObjectSymbol)*extern_count;
+	file_size = relocation_offset + 4*relocations->count;
+
+	/*write the header*/
+	fwrite(OBJECT_MAGIC, 1, OBJECT_MAGIC_LENGTH, file);
+	write_little_endian(file, OBJECT_VERSION, 2);
+	write_little_endian(file, sizeof(ObjectHeader), 2);
+	write_little_endian(file, load_base, 4);
+	write_little_endian(file, code_length, 4);
+	write_little_endian(file, dcf, 4);
+	write_little_endian(file, ext_entry_array->entry_count, 4);
+	write_little_endian(file, extern_count, 4);
+	write_little_endian(file, sizeof(ObjectHeader), 4);
+	write_little_endian(file, data_offset, 4);
+	write_little_endian(file, entry_offset, 4);
+	write_little_endian(file, extern_offset, 4);
+	write_little_endian(file, relocations->count, 4);
+	write_little_endian(file, relocation_offset, 4);
+	write_little_endian(file, file_size, 4);
+
+	/*write the code image*/
+	for(i=0 ; i<code_length ; i++){
 		if(code_img[i]->length > 0){/*check if the code word is present*/
 			binary_value = convert_code_word_to_binary(code_img[i]->word.code);/*convert code word to binary*/
 		}
 		else{/*if data word is present*/
 			binary_value = convert_data_word_to_binary(code_img[i]->word.data);/*convert data word to binary*/
 		}
+		write_little_endian(file, binary_value, 2);
+	}
 
-		octal_value = convert_binary_to_octal(binary_value);/*convert binary value directly to octal*/
+	/*write the data image*/
+	for(i=0 ; i<dcf ; i++){
+		write_little_endian(file, handle_data_value(data_img[i]), 2);
+	}
 
-		/*write to file using correct format specifiers*/
-		fprintf(file, "%.4d %.5d\n", i + 100, octal_value);
+	/*pad up to the symbol tables*/
+	for(i=data_offset + 2*dcf ; i<entry_offset ; i++){
+		fputc('\0', file);
 	}
 
-	/*process data image*/
-	for(i=0 ; i<dcf ; i++){
-		binary_value=handle_data_value(data_img[i]);/*convert data value directly to a 15-bit binary number*/
+	write_entries_binary(file, ext_entry_array);/*write the entry table*/
+	write_externs_binary(file, extern_printing_array);/*write the extern reference table*/
+	write_relocations_binary(file, relocations);/*write the relocation table*/
+}
 
-		octal_value=convert_binary_to_octal(binary_value);/*convert binary value directly to octal*/
+/*** STREAMING OUTPUT SECTION ***/
 
-		/*write to file using correct format specifiers*/
-		fprintf(file,"%.4d %.5d\n",(int)(i+100+icf-IC_INIT_VALUE),octal_value);
+/*
+ * sink_extensions
+ * ---------------
+ * the extension of every output a sink can hold indexed by sink_output
+ */
+const char *sink_extensions[] = {".ob", ".ent", ".ext", ".rel", ".obb", ".map", ".report", ".report.json"};
+
+/* 
+ * convert_machine_word_to_binary
+ * ------------------------------
+ * this function converts a single word of the code image to its 15-bit binary representation
+ * 
+ * parameters:
+ *   machine_word: the word of the code image
+ * 
+ * returns:
+ *   the 15-bit binary representation of the word
+ */
+unsigned int convert_machine_word_to_binary(MachineWordsArray *machine_word){
+	if(machine_word->length > 0){/*check if the code word is present*/
+		return convert_code_word_to_binary(machine_word->word.code);/*convert code word to binary*/
 	}
+	return convert_data_word_to_binary(machine_word->word.data);/*convert data word to binary*/
+}
 
-	fclose(file);/*close the file*/
+/* 
+ * free_machine_word
+ * -----------------
+ * this function frees a single word of the code image together with the code or data word it holds
+ * 
+ * parameters:
+ *   machine_word: the word of the code image to be freed
+ */
+void free_machine_word(MachineWordsArray *machine_word){
+	if(machine_word->length > 0){/*check if the code word is present*/
+		STATS_FREE(machine_word->word.code);
+	}
+	else{
+		STATS_FREE(machine_word->word.data);
+	}
+	STATS_FREE(machine_word);
 }
 
 /* 
- * write_entries_to_file
- * ---------------------
- * this function writes the entry labels and their line numbers to an output file in reverse order
- * the entries are written only if they exist otherwise the function does nothing
+ * initialize_object_sink
+ * ----------------------
+ * this function prepares a sink that holds the output files of a single source file
+ * on disk every output is written under a temporary name and renamed when the sink is committed
+ * in memory every output is written to a buffer that the caller takes from the outputs array once the sink is committed
  * 
  * parameters:
- *   filename: the base name of the file to which the entries will be written
- *   ext_entry_array: array of externentry structures containing the entries to be written
+ *   sink: the sink to be initialized
+ *   basename: the base name of the output files
+ *   in_memory: true to write the outputs to memory buffers instead of files
  */
-void write_entries_to_file(const char*filename,ExternEntryArray*ext_entry_array){/*write the entry labels and their line numbers to a file*/
-	FILE *file;/*declare a file pointer*/
+void initialize_object_sink(ObjectSink *sink, const char *basename, bool in_memory){
 	int i;/*declare a loop counter*/
-	bool has_entries = false;/*flag to check if there are any entries*/
-	char output_filename[MAX_FILENAME_LENGTH + 5];/*declare a string to hold the output filename with .ent suffix*/
 
-	for(i=0 ; i<ext_entry_array->entry_count ; i++){/*check if there are any entries*/
-		has_entries = true;/*set the flag to true if an entry is found*/
-		break;/*break the loop after finding the first entry*/
+	sink->basename = basename;
+	sink->in_memory = in_memory;
+	sink->code_length = 0;
+	sink->data_length = 0;
+	sink->load_base = IC_INIT_VALUE;
+	sink->written_code = 0;
+	sink->written_externs = 0;
+	sink->write_relocations = false;
+	sink->line_map = NULL;
+	initialize_relocation_array(&sink->relocations);
+	for(i=0 ; i<SINK_OUTPUT_COUNT ; i++){
+		sink->outputs[i].file = NULL;
+		sink->outputs[i].filename = NULL;
+		sink->outputs[i].buffer = NULL;
+		sink->outputs[i].size = 0;
+		sink->outputs[i].opened = false;
 	}
+}
+
+/* 
+ * open_sink_output
+ * ----------------
+ * this function opens one of the outputs of the sink
+ * 
+ * parameters:
+ *   sink: the sink the output belongs to
+ *   output: the output to open
+ * 
+ * returns:
+ *   FILE*: the opened stream or NULL if it couldn't be opened
+ */
+FILE *open_sink_output(ObjectSink *sink, sink_output output){
+	SinkOutput *sink_output = &sink->outputs[output];
 
-	if(!has_entries){/*if no entries are found*/
-		return;/*do not create a file and return*/
+	if(sink->in_memory){
+		sink_output->file = open_memstream(&sink_output->buffer, &sink_output->size);/*write to a growing buffer*/
 	}
+	else{
+		free(sink_output->filename);
+		sink_output->filename = make_path(sink->basename, sink_extensions[output], ".tmp");/*construct the temporary filename*/
+		sink_output->file = sink_output->filename ? fopen(sink_output->filename, "wb") : NULL;/*open the file for writing*/
+	}
+	if(!sink_output->file){/*check if the output failed to open*/
+		print_system_error("Error: couldn't open an output for writing");/*print an error message*/
+		return NULL;
+	}
+	sink_output->opened = true;
+	return sink_output->file;
+}
 
-	sprintf(output_filename, "%s.ent", filename);/*construct the output filename with .ent suffix*/
+/* 
+ * commit_object_sink
+ * ------------------
+ * this function closes every output of the sink and makes it final
+ * files get their final names and memory buffers become available in the outputs array
+ * 
+ * parameters:
+ *   sink: the sink to be committed
+ * 
+ * returns:
+ *   bool: true if every output was written false otherwise in which case nothing is left on disk
+ */
+bool commit_object_sink(ObjectSink *sink){
+	int i;/*declare a loop counter*/
+	bool success = true;/*success flag*/
+	char *output_filename;/*declare a string to hold the final output filename*/
 
-	file=fopen(output_filename,"w");/*open the file for writing*/
-	if(!file){/*check if the file failed to open*/
-		perror("error opening file for writing");/*print an error message*/
-		exit(EXIT_FAILURE);/*exit the program with failure status*/
+	for(i=0 ; i<SINK_OUTPUT_COUNT ; i++){/*check every output for write errors*/
+		if(sink->outputs[i].file && ferror(sink->outputs[i].file)){
+			success = false;
+		}
+	}
+	if(!success){
+		fprintf(error_output(), "Error: failed writing the output files of %s\n", sink->basename);
+		abort_object_sink(sink);
+		return false;
 	}
 
-	for(i=ext_entry_array->entry_count-1 ; i>=0 ; i--){/*write each entry label and its line number in reverse order*/
-		fprintf(file,"%s %04d\n",ext_entry_array->entries[i].name, ext_entry_array->entries[i].line_number);/*write the label and line number*/
+	TRACE_BEGIN("io", "commit");
+	for(i=0 ; i<SINK_OUTPUT_COUNT ; i++){/*close every output*/
+		if(sink->outputs[i].file){
+			STATS_COUNT(COUNTER_BYTES_WRITTEN, ftell(sink->outputs[i].file));
+			fclose(sink->outputs[i].file);
+			sink->outputs[i].file = NULL;
+		}
 	}
+	for(i=0 ; i<SINK_OUTPUT_COUNT && !sink->in_memory ; i++){/*give the files their final names*/
+		if(sink->outputs[i].opened){
+			output_filename = make_path(sink->basename, sink_extensions[i], NULL);
+			if(!output_filename || rename(sink->outputs[i].filename, output_filename) != 0){
+				print_system_error("Error: couldn't rename an output file");
+				remove(sink->outputs[i].filename);
+				success = false;
+			}
+			free(output_filename);
+		}
+		free(sink->outputs[i].filename);
+		sink->outputs[i].filename = NULL;
+	}
+	free_relocation_array(&sink->relocations);
+	TRACE_END();
+	return success;
+}
+
+/* 
+ * abort_object_sink
+ * -----------------
+ * this function closes a sink after a failure and removes everything it wrote
+ * 
+ * parameters:
+ *   sink: the sink to be aborted
+ */
+void abort_object_sink(ObjectSink *sink){
+	int i;/*declare a loop counter*/
 
-	fclose(file);/*close the file*/
+	for(i=0 ; i<SINK_OUTPUT_COUNT ; i++){
+		if(sink->outputs[i].file){
+			fclose(sink->outputs[i].file);
+			sink->outputs[i].file = NULL;
+		}
+		if(sink->outputs[i].opened && !sink->in_memory){
+			remove(sink->outputs[i].filename);
+		}
+		sink->outputs[i].opened = false;
+	}
+	release_object_sink(sink);
 }
 
 /* 
- * write_externs_to_file
- * ---------------------
- * this function writes the extern labels and their line numbers to an output file
- * the externs are written only if they exist otherwise the function does nothing
+ * release_object_sink
+ * -------------------
+ * this function frees the memory buffers the caller did not take from a committed sink and the temporary file names
  * 
  * parameters:
- *   filename: the base name of the file to which the externs will be written
- *   extern_printing_array: array of externentry structures containing the externs to be written
+ *   sink: the sink to be released
  */
-void write_externs_to_file(const char*filename,ExternEntry*extern_printing_array){/*write the extern labels and their line numbers to a file*/
-	FILE*file;/*declare a file pointer*/
-	int i = 0;/*declare a loop counter*/
-	bool has_externs = false;/*flag to check if there are any externs*/
-	char output_filename[MAX_FILENAME_LENGTH + 5];/*declare a string to hold the output filename with .ext suffix*/
+void release_object_sink(ObjectSink *sink){
+	int i;/*declare a loop counter*/
 
-	while(extern_printing_array[i].name[0] != '\0'){/*check if there are any externs*/
-		has_externs = true;/*set the flag to true if an extern is found*/
-		break;/*break the loop after finding the first extern*/
+	for(i=0 ; i<SINK_OUTPUT_COUNT ; i++){
+		free(sink->outputs[i].buffer);
+		sink->outputs[i].buffer = NULL;
+		sink->outputs[i].size = 0;
+		free(sink->outputs[i].filename);
+		sink->outputs[i].filename = NULL;
 	}
+	free_relocation_array(&sink->relocations);
+}
+
+/* 
+ * open_object_sink
+ * ----------------
+ * this function starts streaming the text .ob .ent and .ext files while the second pass encodes
+ * the header of the .ob file is written right away since the first pass already knows the length of both images
+ * 
+ * parameters:
+ *   sink: a sink prepared by initialize_object_sink
+ *   code_length: the number of code words found by the first pass
+ *   data_length: the number of data words found by the first pass
+ *   load_base: the address of the first code word
+ *   write_relocations: true if the relocated addresses should be written to a .rel file
+ * 
+ * returns:
+ *   bool: true if the sink was opened false otherwise
+ */
+bool open_object_sink(ObjectSink *sink, long code_length, long data_length, long load_base, bool write_relocations){
+	FILE *file;/*declare a file pointer*/
 
-	if(!has_externs){/*if no externs are found*/
-		return;/*do not create a file and return*/
+	sink->code_length = code_length;
+	sink->data_length = data_length;
+	sink->load_base = load_base;
+	sink->write_relocations = write_relocations;
+
+	file = open_sink_output(sink, SINK_OB);
+	if(!file){
+		return false;
 	}
+	fprintf(file, "%ld %ld\n", code_length, data_length);/*write header with ic and dc values*/
+	return true;
+}
 
-	sprintf(output_filename, "%s.ext", filename);/*construct the output filename with .ext suffix*/
+/* 
+ * sink_entries
+ * ------------
+ * this function writes the .ent file of the sink
+ * the entry addresses are final once update_entry_lines ran so the file is complete before the second pass starts
+ * 
+ * parameters:
+ *   sink: the sink that writes the file
+ *   ext_entry_array: array of externentry structures containing the entries to be written
+ * 
+ * returns:
+ *   bool: true if the entries were written false otherwise
+ */
+bool sink_entries(ObjectSink *sink, ExternEntryArray *ext_entry_array){
+	FILE *file;/*declare a file pointer*/
+	int i;/*declare a loop counter*/
 
-	file = fopen(output_filename, "w");/*open the file for writing*/
-	if(!file){/*check if the file failed to open*/
-		perror("error opening file for writing");/*print an error message*/
-		exit(EXIT_FAILURE);/*exit the program with failure status*/
+	if(ext_entry_array->entry_count == 0){/*if no entries are found*/
+		return true;/*do not create a file*/
 	}
 
-	while(extern_printing_array[i].name[0] != '\0'){/*write each extern label and its line number*/
-		fprintf(file,"%s %04d\n", extern_printing_array[i].name, extern_printing_array[i].line_number);/*write the label and line number*/
-		i++;/*move to the next extern*/
+	file = open_sink_output(sink, SINK_ENT);
+	if(!file){
+		return false;
 	}
+	for(i=ext_entry_array->entry_count-1 ; i>=0 ; i--){/*write each entry label and its line number in reverse order*/
+		fprintf(file, "%s %04ld\n", ext_entry_array->entries[i].name, ext_entry_array->entries[i].line_number + sink->load_base - IC_INIT_VALUE);
+	}
+	return true;
+}
 
-	fclose(file);/*close the file*/
+/* 
+ * sink_code_words
+ * ---------------
+ * this function streams the code words that the second pass finished encoding since the previous call
+ * each streamed word is moved to the load address when it holds an internal label address and is then freed
+ * the extern references recorded meanwhile are appended to the .ext file which is opened on the first reference
+ * 
+ * parameters:
+ *   sink: the sink that writes the files
+ *   code_img: the array where the generated machine words are stored
+ *   ic: the current value of the instruction counter
+ *   extern_printing_array: array of externentry structures terminated by an empty name or NULL if there are no references
+ * 
+ * returns:
+ *   bool: true if the words were written false otherwise
+ */
+bool sink_code_words(ObjectSink *sink, MachineWordsArray **code_img, long ic, ExternEntry *extern_printing_array){
+	MachineWordsArray *machine_word;/*pointer to the streamed word*/
+	FILE *ob_file = sink->outputs[SINK_OB].file;/*the .ob stream*/
+	FILE *ext_file = sink->outputs[SINK_EXT].file;/*the .ext stream or NULL until the first extern reference*/
+	long delta = sink->load_base - IC_INIT_VALUE;/*distance between the assembled and the load address*/
+
+	if(ic - IC_INIT_VALUE > sink->code_length){/*check that the second pass agrees with the first pass*/
+		fprintf(error_output(), "Error: code image is longer than the %ld words sized by the first pass\n", sink->code_length);
+		return false;
+	}
+
+	while(sink->written_code < ic - IC_INIT_VALUE){/*stream every finished word*/
+		machine_word = code_img[sink->written_code];
+		if(machine_word->length == 0 && machine_word->word.data->ARE == 2){/*if the word holds a relocatable address*/
+			machine_word->word.data->data = (unsigned long)((long)machine_word->word.data->data + delta);/*move it to the load address*/
+			if(sink->write_relocations){
+				if(!add_relocation(&sink->relocations, sink->written_code)){/*remember the word for the .rel file*/
+					return false;
+				}
+			}
+		}
+		fprintf(ob_file, "%.4d %.5d\n", (int)(sink->written_code + sink->load_base), convert_binary_to_octal(convert_machine_word_to_binary(machine_word)));
+		free_machine_word(machine_word);/*the word is no longer needed once it was written*/
+		code_img[sink->written_code] = NULL;
+		sink->written_code++;
+	}
+
+	while(extern_printing_array != NULL && extern_printing_array[sink->written_externs].name[0] != '\0'){/*stream every new extern reference*/
+		if(!ext_file){/*open the .ext file on the first reference*/
+			ext_file = open_sink_output(sink, SINK_EXT);
+			if(!ext_file){
+				return false;
+			}
+		}
+		fprintf(ext_file, "%s %04ld\n", extern_printing_array[sink->written_externs].name, extern_printing_array[sink->written_externs].line_number + delta);
+		sink->written_externs++;
+	}
+	return true;
 }
 
+/* 
+ * close_object_sink
+ * -----------------
+ * this function appends the data image to the .ob file writes the .rel file if requested and commits the sink
+ * 
+ * parameters:
+ *   sink: the sink to be closed
+ *   data_img: array of long integers representing the data segment
+ *   dcf: the final value of the data counter after the second pass
+ * 
+ * returns:
+ *   bool: true if every output was written false otherwise in which case nothing is left on disk
+ */
+bool close_object_sink(ObjectSink *sink, long *data_img, long dcf){
+	int i;/*declare a loop counter*/
+	FILE *file;/*declare a file pointer*/
+
+	if(sink->written_code != sink->code_length || dcf != sink->data_length){/*check that the second pass agrees with the first pass*/
+		fprintf(error_output(), "Error: second pass produced %ld code and %ld data words but the first pass sized %ld and %ld\n", sink->written_code, dcf, sink->code_length, sink->data_length);
+		abort_object_sink(sink);
+		return false;
+	}
+
+	for(i=0 ; i<dcf ; i++){/*append the data image*/
+		fprintf(sink->outputs[SINK_OB].file, "%.4d %.5d\n", (int)(i + sink->load_base + sink->code_length), convert_binary_to_octal(handle_data_value(data_img[i])));
+	}
+
+	if(sink->write_relocations && sink->relocations.count > 0){/*write the relocated addresses to the .rel file*/
+		file = open_sink_output(sink, SINK_REL);
+		if(!file){
+			abort_object_sink(sink);
+			return false;
+		}
+		write_relocations(file, &sink->relocations, sink->load_base);
+	}
+	return commit_object_sink(sink);
+}
@@ -7,13 +7,75 @@
 #include"definitions.h"
 #include"first_pass.h"
 #include"second_pass.h"
+#include"object_format.h"
+#include"preprocessor.h"
 
 
+/*** STRUCTURE DEFINITIONS SECTION ***/
+
+/*outputs that a sink can hold*/
+typedef enum sink_outputs{
+	SINK_OB = 0,/*the text object file*/
+	SINK_ENT = 1,/*the entries file*/
+	SINK_EXT = 2,/*the extern references file*/
+	SINK_REL = 3,/*the relocations file*/
+	SINK_OBB = 4,/*the binary object file*/
+	SINK_MAP = 5,/*the map from the addresses back to the source lines*/
+	SINK_REPORT = 6,/*the cost report as a table*/
+	SINK_REPORT_JSON = 7,/*the cost report as JSON*/
+	SINK_OUTPUT_COUNT = 8
+}sink_output;
+
+typedef struct{/*a single output of a sink*/
+	FILE *file;/*the stream while it is being written*/
+	char *filename;/*temporary name of the file when writing to disk or NULL*/
+	char *buffer;/*contents of the output when writing to memory*/
+	size_t size;/*size of the buffer*/
+	bool opened;/*true once the output was opened*/
+}SinkOutput;
+
+struct object_sink{/*collects the output files of a single source file and commits them all at once*/
+	const char *basename;/*base name of the output files*/
+	bool in_memory;/*write the outputs to memory buffers instead of files*/
+	long code_length;/*number of code words sized by the first pass*/
+	long data_length;/*number of data words sized by the first pass*/
+	long load_base;/*address of the first code word*/
+	long written_code;/*number of code words already written*/
+	int written_externs;/*number of extern references already written*/
+	bool write_relocations;/*write the relocated addresses to a .rel file*/
+	RelocationArray relocations;/*indices of the relocated words*/
+	const LineMap *line_map;/*source line of every preprocessed line for the error messages and the .map file or NULL*/
+	SinkOutput outputs[SINK_OUTPUT_COUNT];/*the outputs indexed by sink_output*/
+};
+
+/*** EXTERNAL DECLARATIONS SECTION ***/
+
+/*extension of every output a sink can hold*/
+extern const char *sink_extensions[];
+
 /*** WRITING FILES FUCNTIONS ***/
-void write_entries_to_file(const char *filename, ExternEntryArray *ext_entry_array);/*function to write entries to the specified file*/
-void write_externs_to_file(const char *filename, ExternEntry *extern_printing_array);/*function to write externs to the specified file*/
-void write_ob_file(MachineWordsArray **code_img, long *data_img, long icf, long dcf, const char *filename);/*function to write the object file with the final machine code and data*/
+void write_relocations(FILE *file, RelocationArray *relocations, long load_base);/*function to write the relocated addresses to a stream*/
+
+/*** WRITING BINARY OBJECT FUNCTIONS ***/
+void write_entries_binary(FILE *file, ExternEntryArray *ext_entry_array);/*function to write the entry table of the binary object*/
+void write_externs_binary(FILE *file, ExternEntry *extern_printing_array);/*function to write the extern reference table of the binary object*/
+void write_relocations_binary(FILE *file, RelocationArray *relocations);/*function to write the relocation table of the binary object*/
+void write_object_binary(FILE *file, MachineWordsArray **code_img, long *data_img, long icf, long dcf, ExternEntryArray *ext_entry_array, ExternEntry *extern_printing_array, RelocationArray *relocations, long load_base);/*function to write a binary object to a stream*/
+
 
 
+/*** STREAMING OUTPUT FUNCTIONS ***/
+unsigned int convert_machine_word_to_binary(MachineWordsArray *machine_word);/*function to convert a word of the code image to binary*/
+unsigned int handle_data_value(int data_value);/*function to convert a word of the data image to binary*/
+void free_machine_word(MachineWordsArray *machine_word);/*function to free a word of the code image*/
+void initialize_object_sink(ObjectSink *sink, const char *basename, bool in_memory);/*function to prepare a sink for the outputs of a source file*/
+FILE *open_sink_output(ObjectSink *sink, sink_output output);/*function to open one of the outputs of a sink*/
+bool commit_object_sink(ObjectSink *sink);/*function to close every output and make it final*/
+void abort_object_sink(ObjectSink *sink);/*function to remove everything the sink wrote*/
+void release_object_sink(ObjectSink *sink);/*function to free the memory buffers left in a sink*/
+bool open_object_sink(ObjectSink *sink, long code_length, long data_length, long load_base, bool write_relocations);/*function to start streaming and write the .ob header*/
+bool sink_entries(ObjectSink *sink, ExternEntryArray *ext_entry_array);/*function to write the .ent file before the second pass*/
+bool sink_code_words(ObjectSink *sink, MachineWordsArray **code_img, long ic, ExternEntry *extern_printing_array);/*function to stream the newly encoded words and extern references*/
+bool close_object_sink(ObjectSink *sink, long *data_img, long dcf);/*function to append the data image and commit the output files*/
 
 #endif /* FILE_WRITER_H */
@@ -1,4 +1,5 @@
 #include "first_pass.h"
+#include "stats.h"
 
 /*** ARRAYS SECTION ***/
 
@@ -9,7 +10,7 @@
 * it is used to validate and identify operations in the source code during the first pass
 * having these operations in an array allows for easy lookup and comparison
 */
-const char *operations[] = {
+const char *const operations[] = {
 	"mov", "cmp", "add", "sub", "lea", "clr", "not", "inc", "dec", "jmp", "bne", "red", "prn", "jsr", "rts", "stop"
 };
 
@@ -20,7 +21,7 @@ const char *operations[] = {
 * it is used to validate the types of operands passed to each operation ensuring they adhere to the assembly language rules
 * each entry corresponds to an operation and specifies which addressing modes are allowed for the source and destination
 */
-operation_info operations_info[] = {
+const operation_info operations_info[] = {
 	{"mov", {IMMEDIATE_ADDR, DIRECT_ADDR, RELATIVE_ADDR, REGISTER_ADDR, -1}, {DIRECT_ADDR, RELATIVE_ADDR, REGISTER_ADDR, -1}},
 	{"cmp", {IMMEDIATE_ADDR, DIRECT_ADDR, RELATIVE_ADDR, REGISTER_ADDR, -1}, {IMMEDIATE_ADDR, DIRECT_ADDR, RELATIVE_ADDR, REGISTER_ADDR, -1}},
 	{"add", {IMMEDIATE_ADDR, DIRECT_ADDR, RELATIVE_ADDR, REGISTER_ADDR, -1}, {DIRECT_ADDR, RELATIVE_ADDR, REGISTER_ADDR, -1}},
@@ -110,7 +111,7 @@ int get_operand_count(const char *operation) {
 * returns:
 *   int: true if the type is valid false otherwise
 */
-int is_valid_operand_type(int type,int *valid_types){
+int is_valid_operand_type(int type,const int *valid_types){
 	int i;
 	for(i=0 ; valid_types[i]!=-1 ; i++){
 		if(type == valid_types[i]){
@@ -131,9 +132,9 @@ int is_valid_operand_type(int type,int *valid_types){
 *   operation: the name of the operation
 * 
 * returns:
-*   operation_info*: a pointer to the operation_info structure or NULL if the operation is not found
+*   const operation_info*: a pointer to the operation_info structure or NULL if the operation is not found
 */
-operation_info *get_operation_info(const char *operation){
+const operation_info *get_operation_info(const char *operation){
 	int i;
 	for(i=0 ; i<NUM_OPERATIONS ; i++){
 		if(strcmp(operation,operations_info[i].operation) == 0){
@@ -155,24 +156,25 @@ operation_info *get_operation_info(const char *operation){
 *   operands: the string containing the operands for the operation
 * 
 * returns:
-*   int: the total number of lines needed for the operation and its operands
+*   int: the total number of lines needed for the operation and its operands or -1 if the operands are invalid
 */
 int calculate_instruction_lines(char *operation,char *operands){
 	char *token;
+	char *save;/*position of strtok_r in the operands*/
 	addressing_type src_type = NONE_ADDR;
 	addressing_type dest_type = NONE_ADDR;
 	int num_of_lines = 1;/*initialize with 1 for the instruction itself*/
 	int operand_count = 0;/*initialize operand count*/
 	int expected_operand_count;
-	operation_info *op_info;
+	const operation_info *op_info;
 
 	op_info = get_operation_info(operation);/*get the operation info*/
 	if(!op_info){
-		fprintf(stderr,"Error: Unknown operation '%s'\n",operation);
-		exit(EXIT_FAILURE);
+		report_error("Error: Unknown operation '%s'\n",operation);
+		return -1;
 	}
 
-	token = strtok(operands," ,\t");/*get the first operand*/
+	token = operands ? strtok_r(operands," ,\t",&save) : NULL;/*get the first operand*/
 	while(token){
 		operand_count++;
 		if(operand_count == 1){
@@ -182,42 +184,42 @@ int calculate_instruction_lines(char *operation,char *operands){
 			dest_type = get_addressing_type(token);/*determine the addressing type of the second operand*/
 		}
 		else{
-			fprintf(stderr,"Error: Too many operands for operation '%s'\n",operation);
-			exit(EXIT_FAILURE);
+			report_error("Error: Too many operands for operation '%s'\n",operation);
+			return -1;
 		}
 		if(!is_valid_operand(token)){
-			fprintf(stderr,"Error: Invalid operand '%s' for operation '%s'\n",token,operation);
-			exit(EXIT_FAILURE);
+			report_error("Error: Invalid operand '%s' for operation '%s'\n",token,operation);
+			return -1;
 		}
-		token = strtok(NULL," ,\t");/*get the next operand*/
+		token = strtok_r(NULL," ,\t",&save);/*get the next operand*/
 	}
 
 	expected_operand_count = get_operand_count(operation);/*get the expected operand count for the operation*/
 	if(expected_operand_count != operand_count){
 		if(operand_count < expected_operand_count){
-			fprintf(stderr,"Error: Missing operands for operation '%s'\n",operation);
+			report_error("Error: Missing operands for operation '%s'\n",operation);
 		}
 		else{
-			fprintf(stderr,"Error: Too many operands for operation '%s'\n",operation);
+			report_error("Error: Too many operands for operation '%s'\n",operation);
 		}
-		exit(EXIT_FAILURE);
+		return -1;
 	}
 
 	/*validate operand types*/
 	if(operand_count == 1){
 		if(!is_valid_operand_type(src_type,op_info->valid_dest_types)){
-			fprintf(stderr,"Error: Invalid operand type for operation '%s'\n",operation);
-			exit(EXIT_FAILURE);
+			report_error("Error: Invalid operand type for operation '%s'\n",operation);
+			return -1;
 		}
 	}
 	else{
 		if(operand_count >= 1 && !is_valid_operand_type(src_type,op_info->valid_src_types)){
-			fprintf(stderr,"Error: Invalid source operand type for operation '%s'\n",operation);
-			exit(EXIT_FAILURE);
+			report_error("Error: Invalid source operand type for operation '%s'\n",operation);
+			return -1;
 		}
 		if(operand_count == 2 && !is_valid_operand_type(dest_type,op_info->valid_dest_types)){
-			fprintf(stderr,"Error: Invalid destination operand type for operation '%s'\n",operation);
-			exit(EXIT_FAILURE);
+			report_error("Error: Invalid destination operand type for operation '%s'\n",operation);
+			return -1;
 		}
 	}
 
@@ -237,21 +239,119 @@ int calculate_instruction_lines(char *operation,char *operands){
 * initialize_label_array
 * ----------------------
 * this function initializes a LabelArray structure to store labels encountered during the first pass
-* it allocates memory for the initial array of labels and sets the initial count and capacity
+* it allocates memory for the initial array of labels and its index and sets the initial count and capacity
 * this function is necessary to ensure labels are correctly stored and managed during the assembly process
 * 
 * parameters:
 *   array: a pointer to the LabelArray structure to be initialized
 * 
+* returns:
+*   bool: true if the array was allocated false otherwise
 */
-void initialize_label_array(LabelArray *array){
+bool initialize_label_array(LabelArray *array){
 	array->count = 0;/*initialize count*/
 	array->capacity = 10;/*initial capacity*/
-	array->labels = (Label*)malloc(array->capacity * sizeof(Label));/*allocate memory for labels*/
-	if(array->labels == NULL){
-		fprintf(stderr,"Error: Memory allocation failed for label array\n");
-		exit(EXIT_FAILURE);
+	array->labels = (Label*)STATS_MALLOC(MEMORY_LABELS, array->capacity * sizeof(Label));/*allocate memory for labels*/
+	array->index_size = INITIAL_LABEL_INDEX_SIZE;
+	array->index = (int*)STATS_CALLOC(MEMORY_LABELS, array->index_size, sizeof(int));/*every slot starts free*/
+	if(array->labels == NULL || array->index == NULL){
+		report_error("Error: Memory allocation failed for label array\n");
+		STATS_FREE(array->labels);
+		STATS_FREE(array->index);
+		array->labels = NULL;
+		array->index = NULL;
+		return false;
+	}
+	return true;
+}
+
+/* 
+* empty_label_array
+* -----------------
+* this function removes every label from a LabelArray and keeps its memory for the labels that follow
+* 
+* parameters:
+*   array: a pointer to the LabelArray structure to empty
+* 
+*/
+void empty_label_array(LabelArray *array){
+	array->count = 0;
+	if(array->index){
+		memset(array->index, 0, array->index_size * sizeof(int));
+	}
+}
+
+/* 
+* free_label_array
+* ----------------
+* this function frees the labels and the index of a LabelArray
+* 
+* parameters:
+*   array: a pointer to the LabelArray structure to free
+* 
+*/
+void free_label_array(LabelArray *array){
+	STATS_FREE(array->labels);
+	STATS_FREE(array->index);
+	array->labels = NULL;
+	array->index = NULL;
+	array->count = 0;
+	array->capacity = 0;
+	array->index_size = 0;
+}
+
+/* 
+* find_label
+* ----------
+* this function looks a label up by its name
+* the index is probed from the slot the hash of the name points to until the label or a free slot is found
+* so a lookup takes the same time however many labels the array holds
+* an array without an index (a few labels put together by the caller) is searched one label after the other
+* 
+* parameters:
+*   array: a pointer to the LabelArray structure containing all labels
+*   label: the name of the label to look up
+* 
+* returns:
+*   Label*: the label or NULL if the array does not hold it
+*/
+Label *find_label(const LabelArray *array,const char *label){
+	unsigned long slot;
+	int i;
+
+	if(array->index == NULL){
+		for(i=0 ; i<array->count ; i++){
+			if(strcmp(array->labels[i].label,label) == 0){
+				return &array->labels[i];
+			}
+		}
+		return NULL;
+	}
+	for(slot = hash_label(label) & (array->index_size - 1) ; array->index[slot] ; slot = (slot + 1) & (array->index_size - 1)){
+		if(strcmp(array->labels[array->index[slot] - 1].label,label) == 0){
+			return &array->labels[array->index[slot] - 1];
+		}
 	}
+	return NULL;
+}
+
+/* 
+* index_label
+* -----------
+* this function puts the position of a label in the first free slot the hash of its name leads to
+* 
+* parameters:
+*   index: the index
+*   index_size: the number of slots of the index (a power of two)
+*   label: the name of the label
+*   position: the position of the label in the array
+* 
+*/
+void index_label(int *index,int index_size,const char *label,int position){
+	unsigned long slot;
+
+	for(slot = hash_label(label) & (index_size - 1) ; index[slot] ; slot = (slot + 1) & (index_size - 1));
+	index[slot] = position + 1;
 }
 
 /* 
@@ -269,13 +369,7 @@ void initialize_label_array(LabelArray *array){
 *   bool: true if the label is unique, false otherwise
 */
 bool is_unique_label(LabelArray *array,const char *label){
-	int i;
-	for(i=0 ; i<array->count ; i++){
-		if(strcmp(array->labels[i].label,label) == 0){
-			return false;/*label already exists*/
-		}
-	}
-	return true;/*label is unique*/
+	return find_label(array,label) == NULL;
 }
 
 /* 
@@ -283,6 +377,7 @@ bool is_unique_label(LabelArray *array,const char *label){
 * ---------
 * this function adds a new label to the LabelArray after ensuring it is unique
 * if the array is full it reallocates memory to accommodate more labels
+* and once the index is half full it doubles the index and puts every label in it again
 * this function is essential for recording label definitions along with their line numbers
 * 
 * parameters:
@@ -290,31 +385,55 @@ bool is_unique_label(LabelArray *array,const char *label){
 *   label: the name of the label to add
 *   line_number: the line number where the label was found in the source code
 * 
+* returns:
+*   bool: true if the label was added false if it is a duplicate or memory ran out
 */
-void add_label(LabelArray *array,const char *label,int line_number){
+bool add_label(LabelArray *array,const char *label,int line_number){
+	Label *labels;
+	int *index;
+	int i;
+
 	if(!is_unique_label(array,label)){/*check if the label is unique*/
-		fprintf(stderr,"Error: Duplicate label '%s' found on line %d\n",label,line_number);
-		exit(EXIT_FAILURE);
+		report_error("Error: Duplicate label '%s'\n",label);
+		return false;
 	}
 	if(array->count >= array->capacity){/*check if array is full*/
+		labels = (Label*)STATS_REALLOC(MEMORY_LABELS,array->labels,array->capacity * 2 * sizeof(Label));/*reallocate memory*/
+		if(labels == NULL){
+			report_error("Error: Memory reallocation failed for label array\n");
+			return false;
+		}
+		array->labels = labels;
 		array->capacity *= 2;/*double the capacity*/
-		array->labels = (Label*)realloc(array->labels,array->capacity * sizeof(Label));/*reallocate memory*/
-		if(array->labels == NULL){
-			fprintf(stderr,"Error: Memory reallocation failed for label array\n");
-			exit(EXIT_FAILURE);
+	}
+	if(array->index && (array->count + 1) * 2 > array->index_size){/*keep the probes short*/
+		index = (int*)STATS_CALLOC(MEMORY_LABELS, array->index_size * 2, sizeof(int));
+		if(index == NULL){
+			report_error("Error: Memory reallocation failed for label array\n");
+			return false;
 		}
+		for(i=0 ; i<array->count ; i++){
+			index_label(index,array->index_size * 2,array->labels[i].label,i);
+		}
+		STATS_FREE(array->index);
+		array->index = index;
+		array->index_size *= 2;
 	}
 	strncpy(array->labels[array->count].label,label,MAX_LABEL_LENGTH);/*copy label to the label array*/
 	array->labels[array->count].label[MAX_LABEL_LENGTH] = '\0';/*ensure null termination*/
 	array->labels[array->count].line_number = line_number;/*store the line number where the label was found*/
+	if(array->index){
+		index_label(array->index,array->index_size,array->labels[array->count].label,array->count);
+	}
 	array->count++;/*increment the label count*/
+	return true;
 }
 
 /* 
 * is_valid_label
 * --------------
 * this function checks if a given label is valid according to assembly language rules
-* it ensures that the label starts with a letter and is alphanumeric
+* it ensures that the label starts with a letter, is alphanumeric and is at most MAX_LABEL_LENGTH characters long
 * this function is critical for validating label names to prevent errors in the assembly process
 * 
 * parameters:
@@ -327,7 +446,7 @@ bool is_valid_label(const char *label){
 	int i;
 	if(!is_alpha(label[0]))return false;/*label must start with a letter*/
 	for(i=1 ; label[i]!='\0' ; i++){
-		if(!is_alnum(label[i]))return false;/*label must be alphanumeric*/
+		if(!is_alnum(label[i]) || i >= MAX_LABEL_LENGTH)return false;/*label must be alphanumeric and fit MAX_LABEL_LENGTH*/
 	}
 	return true;/*label is valid*/
 }
@@ -348,6 +467,8 @@ bool is_valid_label(const char *label){
 void initialize_extern_entry_array(ExternEntryArray *array){
 	array->extern_count = 0;/*initialize extern count*/
 	array->entry_count = 0;/*initialize entry count*/
+	memset(array->extern_index, 0, sizeof(array->extern_index));/*every slot starts free*/
+	array->extern_indexed = true;
 }
 
 /* 
@@ -361,16 +482,72 @@ void initialize_extern_entry_array(ExternEntryArray *array){
 *   array: a pointer to the ExternEntryArray structure where the extern will be added
 *   name: the name of the extern to add
 *   line_number: the line number where the extern was found
+*   source_line: the line of the preprocessed source that declared the extern
 * 
+* returns:
+*   bool: true if the extern was added false if the array is full
 */
-void add_extern(ExternEntryArray *array,const char *name,int line_number){
+bool add_extern(ExternEntryArray *array,const char *name,int line_number,int source_line){
 	if(array->extern_count >= MAX_EXTERN_ENTRIES){/*check if array is full*/
-		fprintf(stderr,"Error: Extern array is full\n");
-		exit(EXIT_FAILURE);
+		report_error("Error: Extern array is full\n");
+		return false;
 	}
 	strncpy(array->externs[array->extern_count].name,name,MAX_LABEL_LENGTH);/*copy extern name*/
+	array->externs[array->extern_count].name[MAX_LABEL_LENGTH] = '\0';/*ensure null termination*/
 	array->externs[array->extern_count].line_number = line_number;/*store the line number where the extern was found*/
+	array->externs[array->extern_count].source_line = source_line;
+	index_extern(array,array->extern_count);
 	array->extern_count++;/*increment the extern count*/
+	return true;
+}
+
+/* 
+* index_extern
+* ------------
+* this function puts an extern of the ExternEntryArray in the index
+* an extern declared twice is found at its first declaration because that one sits earlier on the probe path
+* 
+* parameters:
+*   array: a pointer to the ExternEntryArray structure holding the extern
+*   position: the position of the extern in the externs
+* 
+*/
+void index_extern(ExternEntryArray *array,int position){
+	if(array->extern_indexed){
+		index_label(array->extern_index,EXTERN_INDEX_SIZE,array->externs[position].name,position);
+	}
+}
+
+/* 
+* find_extern
+* -----------
+* this function looks an extern up by its name the way find_label looks a label up
+* 
+* parameters:
+*   array: a pointer to the ExternEntryArray structure containing the externs
+*   name: the name of the extern to look up
+* 
+* returns:
+*   ExternEntry*: the first extern with that name or NULL if there is none
+*/
+ExternEntry *find_extern(const ExternEntryArray *array,const char *name){
+	unsigned long slot;
+	int i;
+
+	if(!array->extern_indexed){
+		for(i=0 ; i<array->extern_count ; i++){
+			if(strcmp(array->externs[i].name,name) == 0){
+				return (ExternEntry*)&array->externs[i];
+			}
+		}
+		return NULL;
+	}
+	for(slot = hash_label(name) & (EXTERN_INDEX_SIZE - 1) ; array->extern_index[slot] ; slot = (slot + 1) & (EXTERN_INDEX_SIZE - 1)){
+		if(strcmp(array->externs[array->extern_index[slot] - 1].name,name) == 0){
+			return (ExternEntry*)&array->externs[array->extern_index[slot] - 1];
+		}
+	}
+	return NULL;
 }
 
 /* 
@@ -384,16 +561,22 @@ void add_extern(ExternEntryArray *array,const char *name,int line_number){
 *   array: a pointer to the ExternEntryArray structure where the entry will be added
 *   name: the name of the entry to add
 *   line_number: the line number where the entry was found
+*   source_line: the line of the preprocessed source that declared the entry
 * 
+* returns:
+*   bool: true if the entry was added false if the array is full
 */
-void add_entry(ExternEntryArray *array,const char *name,int line_number){
+bool add_entry(ExternEntryArray *array,const char *name,int line_number,int source_line){
 	if(array->entry_count >= MAX_EXTERN_ENTRIES){/*check if array is full*/
-		fprintf(stderr,"Error: Entry array is full\n");
-		exit(EXIT_FAILURE);
+		report_error("Error: Entry array is full\n");
+		return false;
 	}
 	strncpy(array->entries[array->entry_count].name,name,MAX_LABEL_LENGTH);/*copy entry name*/
+	array->entries[array->entry_count].name[MAX_LABEL_LENGTH] = '\0';/*ensure null termination*/
 	array->entries[array->entry_count].line_number = line_number;/*store the line number where the entry was found*/
+	array->entries[array->entry_count].source_line = source_line;
 	array->entry_count++;/*increment the entry count*/
+	return true;
 }
 
 /* 
@@ -405,23 +588,30 @@ void add_entry(ExternEntryArray *array,const char *name,int line_number){
 * 
 * parameters:
 *   directive: the directive (.extern or .entry) being processed
-*   line: the line of code containing the directive
+*   names: the rest of the line after the directive or NULL if there is none
 *   ext_entry_array: a pointer to the ExternEntryArray structure where externs and entries will be stored
 *   line_number: the line number where the directive was found
+*   source_line: the line of the preprocessed source that holds the directive
 * 
+* returns:
+*   bool: true if every name was added false otherwise
 */
-void handle_extern_entry_directive(char *directive,char *line,ExternEntryArray *ext_entry_array,int line_number){
+bool handle_extern_entry_directive(char *directive,char *names,ExternEntryArray *ext_entry_array,int line_number,int source_line){
 	char *token;
-	token = strtok(NULL," \t");/*get the first token after .extern or .entry*/
-	while(token){
+	char *save;/*position of strtok_r in the names*/
+	bool added = true;
+
+	token = names ? strtok_r(names," \t",&save) : NULL;/*get the first token after .extern or .entry*/
+	while(token && added){
 		if(strcmp(directive,".extern") == 0){
-			add_extern(ext_entry_array,token,line_number);/*add the extern to the extern array*/
+			added = add_extern(ext_entry_array,token,line_number,source_line);/*add the extern to the extern array*/
 		}
 		else if(strcmp(directive,".entry") == 0){
-			add_entry(ext_entry_array,token,line_number);/*add the entry to the entry array*/
+			added = add_entry(ext_entry_array,token,line_number,source_line);/*add the entry to the entry array*/
 		}
-		token = strtok(NULL," \t");/*get the next token*/
+		token = strtok_r(NULL," \t",&save);/*get the next token*/
 	}
+	return added;
 }
 
 /*** DIRECTIVE HANDLING SECTION ***/
@@ -437,41 +627,45 @@ void handle_extern_entry_directive(char *directive,char *line,ExternEntryArray *
 *   line: the line of code containing the .data directive
 *   line_counter: a pointer to the line counter that tracks the current position in the source code
 * 
+* returns:
+*   bool: true if every value is a valid number false otherwise
 */
-void handle_data_directive(char *line,int *line_counter){
+bool handle_data_directive(char *line,int *line_counter){
 	char *token;
+	char *save;/*position of strtok_r in the line*/
 	char *endptr;
-	char *original_line = (char*)malloc(strlen(line) + 1);/*store original line for error messages*/
+	char *original_line = (char*)STATS_MALLOC(MEMORY_DATA_COPIES, strlen(line) + 1);/*store original line for error messages*/
 	char *line_copy;
 
 	if(original_line == NULL){
-		fprintf(stderr,"Error: Memory allocation failed for line copy\n");
-		exit(EXIT_FAILURE);
+		report_error("Error: Memory allocation failed for line copy\n");
+		return false;
 	}
 
 	strcpy(original_line,line);/*copy the original line*/
 	line_copy = original_line;/*duplicate the line*/
 
 	if(!validate_commas(line_copy,*line_counter,true)){/* Validate commas in the .data directive */
-		free(original_line);
-		exit(EXIT_FAILURE);/*exit if commas are invalid*/
+		STATS_FREE(original_line);
+		return false;/*fail if commas are invalid*/
 	}
 
-	token = strtok(line_copy," \t,");/*get the first token after .data*/
+	token = strtok_r(line_copy," \t,",&save);/*get the first token after .data*/
 	while(token){
 		strtol(token,&endptr,10);/*convert token to integer*/
 		if(*endptr != '\0'){
-			fprintf(stderr,"Error: Invalid number '%s' in .data directive on line %d\n",token,*line_counter);
-			free(original_line);
-			exit(EXIT_FAILURE);
+			report_error("Error: Invalid number '%s' in .data directive\n",token);
+			STATS_FREE(original_line);
+			return false;
 		}
 		else{
 			(*line_counter)++;/*increase line counter for each data value*/
 		}
-		token = strtok(NULL," \t,");/*get the next token ignoring spaces tabs commas*/
+		token = strtok_r(NULL," \t,",&save);/*get the next token ignoring spaces tabs commas*/
 	}
 
-	free(original_line);/*free the duplicated line memory*/
+	STATS_FREE(original_line);/*free the duplicated line memory*/
+	return true;
 }
 
 /* 
@@ -485,8 +679,10 @@ void handle_data_directive(char *line,int *line_counter){
 *   line: the line of code containing the .string directive
 *   line_counter: a pointer to the line counter that tracks the current position in the source code
 * 
+* returns:
+*   bool: true if the string is properly quoted false otherwise
 */
-void handle_string_directive(char *line, int *line_counter){
+bool handle_string_directive(char *line, int *line_counter){
 	char *start;
 	char *end;
 	char *last_quote = NULL; /*to store the position of the last quote*/
@@ -498,8 +694,8 @@ void handle_string_directive(char *line, int *line_counter){
 
 	/*check for the opening quote*/
 	if(*line != '"'){
-		fprintf(stderr, "Error: Expected opening quote for string directive on line %d\n", *line_counter);
-		exit(EXIT_FAILURE);
+		report_error("Error: Expected opening quote for string directive\n");
+		return false;
 	}
 
 	start = line + 1; /*move past the opening quote*/
@@ -511,8 +707,8 @@ void handle_string_directive(char *line, int *line_counter){
 	}
 
 	if(*end != '"'){
-		fprintf(stderr, "Error: Missing closing quote or extraneous characters after string directive on line %d\n", *line_counter);
-		exit(EXIT_FAILURE);
+		report_error("Error: Missing closing quote or extraneous characters after string directive\n");
+		return false;
 	}
 
 	last_quote = end; /*set last_quote to the found quote*/
@@ -525,6 +721,29 @@ void handle_string_directive(char *line, int *line_counter){
 	}
 
 	(*line_counter)++; /*increase line counter for the null terminator*/
+	return true;
+}
+
+/* 
+* get_stored_string_length
+* ------------------------
+* this function returns the number of data words the second pass stores for a .string directive
+* the second pass stores the characters up to the first closing quote followed by a null terminator
+* which can be fewer words than the line counter advances by when the string itself contains a quote
+* 
+* parameters:
+*   line: the part of the .string directive that starts with the opening quote
+* 
+* returns:
+*   int: the number of data words stored for the string
+*/
+int get_stored_string_length(const char *line){
+	const char *end;
+
+	if(*line != '"' || (end = strchr(line + 1, '"')) == NULL){
+		return 0;/*the directive is rejected before anything is stored*/
+	}
+	return (int)(end - line);/*the characters between the quotes and the null terminator*/
 }
 
 /*** COMMA VALIDATION SECTION ***/
@@ -555,7 +774,7 @@ bool validate_commas(const char *line,int line_counter,bool is_data){
 		if(is_data){
 			if(current_char == ','){
 				if(expecting_number_or_operand || prev_char == ','){
-					fprintf(stderr,"Error: Invalid comma placement in .data directive on line %d. Line: %s\n",line_counter,line);
+					report_error("Error: Invalid comma placement in .data directive '%s'\n",line);
 					return false;
 				}
 				expecting_number_or_operand = 1;/*after a comma expect a number*/
@@ -567,7 +786,7 @@ bool validate_commas(const char *line,int line_counter,bool is_data){
 		else{
 			if(current_char == ',' && !in_string){
 				if(expecting_number_or_operand || prev_char == ','){
-					fprintf(stderr,"Error: Invalid comma placement on line %d. Line: %s\n",line_counter,line);
+					report_error("Error: Invalid comma placement in '%s'\n",line);
 					return false;
 				}
 				expecting_number_or_operand = 1;/*after a comma expect an operand*/
@@ -583,7 +802,7 @@ bool validate_commas(const char *line,int line_counter,bool is_data){
 	}
 
 	if(prev_char == ','){
-		fprintf(stderr,"Error: Cannot have a trailing comma on line %d. Line: %s\n",line_counter,line);
+		report_error("Error: Cannot have a trailing comma in '%s'\n",line);
 		return false;
 	}
 
@@ -596,123 +815,289 @@ bool validate_commas(const char *line,int line_counter,bool is_data){
 * first_pass
 * ----------
 * this function performs the first pass over the input file
-* it processes labels operations and directives collecting labels and preparing data for the second pass
-* this function is critical as it sets up the necessary information needed to generate the final machine code during the second pass
+* it opens the file and leaves the processing itself to first_pass_stream
 * 
 * parameters:
 *   filename: the name of the source file to process
 *   label_array: a pointer to the LabelArray structure to store labels found during the first pass
 *   ext_entry_array: a pointer to the ExternEntryArray structure to store externs and entries found during the first pass
+*   code_length: a pointer to where the number of code words the second pass will encode is stored
+*   data_length: a pointer to where the number of data words the second pass will store is stored
 * 
 * returns:
 *   LabelArray*: a pointer to the LabelArray containing all labels found during the first pass or NULL if an error occurs
 */
-LabelArray *first_pass(const char *filename, LabelArray *label_array, ExternEntryArray *ext_entry_array){
+LabelArray *first_pass(const char *filename, LabelArray *label_array, ExternEntryArray *ext_entry_array, long *code_length, long *data_length){
 	FILE *file;
-	char line[MAX_LINE_LENGTH + 1];
-	int line_counter = IC_INIT_VALUE;/*initialize line counter with initial IC value*/
-	char *token;
-	int user_line_counter = 1;/*initialize user-friendly line counter*/
-	char *colon;
-	char *string_directive;
+	LabelArray *result;
 
 	file = fopen(filename, "r");/*open the input file*/
 	if(!file){
-		perror("Error opening file");
+		print_system_error("Error opening file");
 		return NULL;
 	}
 
-	while(fgets(line, sizeof(line), file)){/*read a line from the input file*/
-		if(strlen(line) > MAX_LINE_LENGTH){
-			fprintf(stderr, "Error: Line %d exceeds maximum length of %d characters\n", user_line_counter, MAX_LINE_LENGTH);
-			exit(EXIT_FAILURE);
-		}
+	result = first_pass_stream(file, label_array, ext_entry_array, code_length, data_length);
 
-		line[strcspn(line, "\r\n")] = 0;/*remove newline characters*/
-		/*skip empty lines or lines with only whitespace*/
-		if (strlen(line) == 0 || strspn(line, " \t") == strlen(line)) {
-			user_line_counter++; /*increase the user line counter*/
-			continue;
-		}
-		/*check for various comma related errors*/
-		if(strstr(line, ".data") != NULL){
-			if(!validate_commas(line, line_counter, true)){/*validate .data directive commas*/
-				exit(EXIT_FAILURE);
-			}
+	fclose(file);
+	return result;
+}
+
+/* 
+* first_pass_line
+* ---------------
+* this function runs the first pass over a single line of the preprocessed source
+* a line with an error leaves the counters as they were before it so the pass can go on with the next line
+* 
+* parameters:
+*   line: the line without its newline (modified by the function)
+*   user_line_counter: the 1 based number of the line used in the error messages
+*   line_counter: a pointer to the address counter of the first pass
+*   label_array: a pointer to the LabelArray structure to store labels found during the first pass
+*   ext_entry_array: a pointer to the ExternEntryArray structure to store externs and entries found during the first pass
+*   code_length: a pointer to the number of code words the second pass will encode
+*   data_length: a pointer to the number of data words the second pass will store
+* 
+* returns:
+*   bool: true if the line is valid false otherwise
+*/
+bool first_pass_line(char *line, int user_line_counter, int *line_counter, LabelArray *label_array, ExternEntryArray *ext_entry_array, long *code_length, long *data_length){
+	char *token;
+	char *save;/*position of strtok_r in the line*/
+	char *colon;
+	char *string_directive;
+	char *label = NULL;/*the label of the line or NULL*/
+	int data_start;/*line counter before a data directive*/
+
+	/*skip empty lines or lines with only whitespace*/
+	if (strlen(line) == 0 || strspn(line, " \t") == strlen(line)) {
+		return true;
+	}
+	/*check for various comma related errors*/
+	if(strstr(line, ".data") != NULL){
+		if(!validate_commas(line, *line_counter, true)){/*validate .data directive commas*/
+			return false;
 		}
-		else{
-			if(!validate_commas(line, line_counter, false)){/*validate general operand commas*/
-				exit(EXIT_FAILURE);
-			}
+	}
+	else{
+		if(!validate_commas(line, *line_counter, false)){/*validate general operand commas*/
+			return false;
 		}
+	}
 
-		/*check for labels*/
-		token = strtok(line, " \t");
-		if(token && strchr(token, ':')){
-			colon = strchr(token, ':');
-			*colon = '\0';/*remove the colon*/
-			if(is_valid_label(token)){
-				add_label(label_array, token, line_counter);/*add the label to the label array*/
-			}
-			else{
-				fprintf(stderr, "Error: Invalid label '%s' on line %d\n", token, user_line_counter);
-				exit(EXIT_FAILURE);
-			}
-			token = strtok(NULL, " \t");/*get the next token after the label*/
+	/*check for labels*/
+	token = strtok_r(line, " \t", &save);
+	if(token && strchr(token, ':')){
+		colon = strchr(token, ':');
+		*colon = '\0';/*remove the colon*/
+		if(!is_valid_label(token)){
+			report_error("Error: Invalid label '%s'\n", token);
+			return false;
 		}
-
-		/*handle the remaining part of the line*/
-		if(token == NULL){
-			user_line_counter++;
-			line_counter++;/*if there is no more token after label, increase line counter for lines that only have labels*/
-			continue;
+		if(!add_label(label_array, token, *line_counter)){/*add the label to the label array*/
+			return false;
 		}
+		label = token;
+		token = strtok_r(NULL, " \t", &save);/*get the next token after the label*/
+	}
 
-		if(is_operation(token)){
-			int num_of_lines;/*declare variable at the start*/
-			char *operands = strtok(NULL, "\n");/*get the remaining part of the line as operands*/
-			num_of_lines = calculate_instruction_lines(token, operands);/*calculate the number of lines needed for the operation*/
-			line_counter += num_of_lines;/*add the required lines to the line counter*/
+	/*handle the remaining part of the line*/
+	if(token == NULL){
+		(*line_counter)++;/*if there is no more token after label, increase line counter for lines that only have labels*/
+		return true;
+	}
+
+	if(is_operation(token)){
+		int num_of_lines;/*declare variable at the start*/
+		char *operands = strtok_r(NULL, "\n", &save);/*get the remaining part of the line as operands*/
+		num_of_lines = calculate_instruction_lines(token, operands);/*calculate the number of lines needed for the operation*/
+		if(num_of_lines < 0){
+			return false;
 		}
-		else if(strcmp(token, ".data") == 0){
-			char *data_part = strtok(NULL, "\n");/*get the remaining part of the line after .data*/
-			if(data_part != NULL){
-				handle_data_directive(data_part, &line_counter);/*handle the .data directive*/
-			}
-			else{
-				fprintf(stderr, "Error: Invalid .data directive on line %d\n", user_line_counter);
-				exit(EXIT_FAILURE);
-			}
+		*line_counter += num_of_lines;/*add the required lines to the line counter*/
+		*code_length += num_of_lines;/*the second pass will encode the same number of code words*/
+	}
+	else if(strcmp(token, ".data") == 0){
+		char *data_part = strtok_r(NULL, "\n", &save);/*get the remaining part of the line after .data*/
+		if(data_part == NULL){
+			report_error("Error: Invalid .data directive\n");
+			return false;
 		}
-		else if(strcmp(token, ".string") == 0){
-			string_directive = strtok(NULL, "\n");/*get the rest of the line after .string*/
-			if(string_directive != NULL){
-				while(*string_directive == ' ' || *string_directive == '\t'){
-					string_directive++;/*skip any leading whitespace*/
-				}
-				handle_string_directive(string_directive, &line_counter);/*handle the .string directive*/
-			}
-			else{
-				fprintf(stderr, "Error: Invalid string directive on line %d\n", user_line_counter);
-				exit(EXIT_FAILURE);
-			}
+		data_start = *line_counter;
+		if(!handle_data_directive(data_part, line_counter)){/*handle the .data directive*/
+			*line_counter = data_start;
+			return false;
 		}
-		else if(strcmp(token, ".extern") == 0 || strcmp(token, ".entry") == 0){
-			handle_extern_entry_directive(token, line, ext_entry_array, line_counter);/*handle .extern and .entry directives*/
+		*data_length += *line_counter - data_start;/*count the data words of the directive*/
+	}
+	else if(strcmp(token, ".string") == 0){
+		string_directive = strtok_r(NULL, "\n", &save);/*get the rest of the line after .string*/
+		if(string_directive == NULL){
+			report_error("Error: Invalid string directive\n");
+			return false;
 		}
-		else{
-			fprintf(stderr, "Error: Unknown directive or operation '%s' on line %d\n", token, user_line_counter);
-			exit(EXIT_FAILURE);
+		while(*string_directive == ' ' || *string_directive == '\t'){
+			string_directive++;/*skip any leading whitespace*/
+		}
+		data_start = *line_counter;
+		if(!handle_string_directive(string_directive, line_counter)){/*handle the .string directive*/
+			*line_counter = data_start;
+			return false;
+		}
+		*data_length += get_stored_string_length(string_directive);/*count the data words the second pass will store*/
+	}
+	else if(strcmp(token, ".extern") == 0 || strcmp(token, ".entry") == 0){
+		if(label){/*the label is kept but it names whatever word comes next*/
+			report_warning("Warning: Label '%s' of a %s directive labels the word after it\n", label, token);
+		}
+		if(!handle_extern_entry_directive(token, strtok_r(NULL, "\n", &save), ext_entry_array, *line_counter, user_line_counter)){/*handle .extern and .entry directives*/
+			return false;
+		}
+	}
+	else{
+		report_error("Error: Unknown directive or operation '%s'\n", token);
+		return false;
+	}
+	return true;
+}
+
+/* 
+* count_line_words
+* ----------------
+* this function finds the number of code words and data words a line adds to the images
+* it sizes the line the way first_pass_line does so it is only meant for lines of a source the first pass accepted
+* 
+* parameters:
+*   line: the line without its newline (modified by the function)
+*   code_words: receives the number of code words of an operation
+*   data_words: receives the number of data words of a .data or .string directive
+* 
+*/
+void count_line_words(char *line, int *code_words, int *data_words){
+	char *token;
+	char *save;/*position of strtok_r in the line*/
+	char *rest;
+
+	*code_words = 0;
+	*data_words = 0;
+	token = strtok_r(line, " \t", &save);
+	if(token && strchr(token, ':')){
+		token = strtok_r(NULL, " \t", &save);/*skip the label*/
+	}
+	if(token == NULL){
+		return;
+	}
+	rest = strtok_r(NULL, "\n", &save);
+	if(is_operation(token)){
+		*code_words = calculate_instruction_lines(token, rest);
+		*code_words = *code_words < 0 ? 0 : *code_words;
+	}
+	else if(strcmp(token, ".data") == 0 && rest){
+		for(token = strtok_r(rest, " \t,", &save) ; token ; token = strtok_r(NULL, " \t,", &save)){
+			(*data_words)++;/*a word for every value*/
+		}
+	}
+	else if(strcmp(token, ".string") == 0 && rest){
+		while(*rest == ' ' || *rest == '\t'){
+			rest++;
+		}
+		*data_words = get_stored_string_length(rest);
+	}
+}
+
+/* 
+* skip_rest_of_line
+* -----------------
+* this function reads the rest of a line that did not fit in the line buffer
+* 
+* parameters:
+*   file: the stream holding the preprocessed source
+* 
+* returns:
+*   bool: true if characters other than the newline were skipped false if only the newline was left
+*/
+bool skip_rest_of_line(FILE *file){
+	int c = fgetc(file);
+	bool skipped = false;
+
+	while(c != EOF && c != '\n'){
+		skipped = true;
+		c = fgetc(file);
+	}
+	return skipped;
+}
+
+/* 
+* first_pass_lines
+* ----------------
+* this function runs the first pass over every line of a stream starting from the given address
+* a line with an error is reported and the pass goes on with the next line so every error of the file is reported in a single run
+* until the error limit of the file is reached
+* the address counter is left after the last line so a stream holding a slice of a source can be sized on its own
+* 
+* parameters:
+*   file: the stream holding the preprocessed lines
+*   line_counter: a pointer to the address counter which is advanced by every line
+*   label_array: a pointer to the LabelArray structure to store labels found during the first pass
+*   ext_entry_array: a pointer to the ExternEntryArray structure to store externs and entries found during the first pass
+*   code_length: a pointer to the number of code words which is advanced by every operation
+*   data_length: a pointer to the number of data words which is advanced by every directive
+* 
+* returns:
+*   bool: true if every line passed false otherwise
+*/
+bool first_pass_lines(FILE *file, int *line_counter, LabelArray *label_array, ExternEntryArray *ext_entry_array, long *code_length, long *data_length){
+	char line[MAX_LINE_LENGTH + 1];
+	int user_line_counter = 1;/*initialize user-friendly line counter*/
+	bool failed = false;/*true once a line had an error*/
+
+	while(!(failed && error_limit_reached()) && fgets(line, sizeof(line), file)){/*read a line from the input file*/
+		set_diagnostic_line(user_line_counter);
+		if(strchr(line, '\n') == NULL && !feof(file) && skip_rest_of_line(file)){/*the line did not fit in the buffer*/
+			report_error("Error: Line exceeds maximum length of %d characters\n", MAX_LINE_LENGTH);
+			failed = true;
+			user_line_counter++;
+			continue;
+		}
+		line[strcspn(line, "\r\n")] = 0;/*remove newline characters*/
+		if(!first_pass_line(line, user_line_counter, line_counter, label_array, ext_entry_array, code_length, data_length)){
+			failed = true;/*resynchronize at the next line*/
 		}
 		/* ccheck for RAM overflow*/
-		if(line_counter > CODE_ARR_IMG_LENGTH) {
-			fprintf(stderr, "Error: RAM overflow\n");
-			exit(EXIT_FAILURE);
+		if(*line_counter > CODE_ARR_IMG_LENGTH) {
+			report_error("Error: RAM overflow\n");
+			set_diagnostic_line(0);
+			return false;/*every following line would overflow as well*/
 		}
 		user_line_counter++; /* Increase the user line counter */
 	}
+	set_diagnostic_line(0);
 
-	fclose(file);
-	return label_array;/*return the pointer to the label array*/
+	return !failed;
 }
 
+/* 
+* first_pass_stream
+* -----------------
+* this function performs the first pass over a stream holding the preprocessed source
+* it processes labels operations and directives collecting labels and preparing data for the second pass
+* this function is critical as it sets up the necessary information needed to generate the final machine code during the second pass
+* the lines themselves are handled by first_pass_lines
+* 
+* parameters:
+*   file: the stream holding the preprocessed source, which may be a file or a buffer in memory
+*   label_array: a pointer to the LabelArray structure to store labels found during the first pass
+*   ext_entry_array: a pointer to the ExternEntryArray structure to store externs and entries found during the first pass
+*   code_length: a pointer to where the number of code words the second pass will encode is stored
+*   data_length: a pointer to where the number of data words the second pass will store is stored
+* 
+* returns:
+*   LabelArray*: a pointer to the LabelArray containing all labels found during the first pass or NULL if an error occurs
+*/
+LabelArray *first_pass_stream(FILE *file, LabelArray *label_array, ExternEntryArray *ext_entry_array, long *code_length, long *data_length){
+	int line_counter = IC_INIT_VALUE;/*initialize line counter with initial IC value*/
+
+	*code_length = 0;/*no code words were sized yet*/
+	*data_length = 0;/*no data words were sized yet*/
+	return first_pass_lines(file, &line_counter, label_array, ext_entry_array, code_length, data_length) ? label_array : NULL;/*return the pointer to the label array*/
+}
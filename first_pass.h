@@ -3,17 +3,20 @@
 
 #include "definitions.h"/*include definitions header file*/
 #include "utils.h"/*include utils header file*/
+#include "diagnostics.h"/*include diagnostics header file*/
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
 #define NUM_OPERATIONS (sizeof(operations)/sizeof(operations[0]))/*calculate the number of operations*/
 #define MAX_LABEL_LENGTH 31/*maximum length for a label*/
+#define INITIAL_LABEL_INDEX_SIZE 32/*initial number of slots of the index of a LabelArray*/
+#define EXTERN_INDEX_SIZE 256/*number of slots of the index of the externs (a power of two at least twice MAX_EXTERN_ENTRIES)*/
 
 /*** STRUCTURE DEFINITIONS SECTION ***/
 
 typedef struct{/*label struct that has a string of the label name and its line*/ 
-	char label[MAX_LABEL_LENGTH];/*label name*/ 
+	char label[MAX_LABEL_LENGTH + 1];/*label name*/ 
 	int line_number;/*line number*/ 
 }Label;
 
@@ -21,11 +24,14 @@ typedef struct{/*array that stores the labels with the number of labels and the
 	Label *labels;/*pointer to the array of labels*/ 
 	int count;/*number of labels*/ 
 	int capacity;/*capacity for dynamic allocation*/ 
+	int *index;/*open addressing table of the position of every label plus one (0 is a free slot) or NULL to look the labels up one by one*/
+	int index_size;/*number of slots of the index (a power of two at least twice the count)*/
 }LabelArray;
 
 typedef struct{/*structure to store extern or entry data (name and line number)*/ 
-	char name[MAX_LABEL_LENGTH];/*extern/entry name*/ 
+	char name[MAX_LABEL_LENGTH + 1];/*extern/entry name*/ 
 	int line_number;/*line number*/ 
+	int source_line;/*line of the preprocessed source that declared it (the errors about it are reported there)*/
 }ExternEntry;
 
 typedef struct{/*array that stores the extern and entry with the number of extern and entry variables and the capacity of how much it can hold for the dynamic allocation*/ 
@@ -33,6 +39,8 @@ typedef struct{/*array that stores the extern and entry with the number of exter
 	ExternEntry entries[MAX_EXTERN_ENTRIES];/*array of entries*/ 
 	int extern_count;/*count of externs*/ 
 	int entry_count;/*count of entries*/ 
+	int extern_index[EXTERN_INDEX_SIZE];/*open addressing table of the position of every extern plus one (0 is a free slot)*/
+	bool extern_indexed;/*false when the caller put a few externs together without the index so they are looked up one by one*/
 }ExternEntryArray;
 
 typedef struct{/*structure to hold information about an operation and its valid addressing types*/ 
@@ -41,34 +49,51 @@ typedef struct{/*structure to hold information about an operation and its valid
 	int valid_dest_types[5];/*valid destination addressing types*/ 
 }operation_info;
 
+/*** EXTERNAL DECLARATIONS SECTION ***/
+
+extern const char *const operations[];/*the name of every operation indexed by its opcode*/
+extern const operation_info operations_info[];/*the addressing types every operation accepts indexed by its opcode*/
+
 /*** OPERATION HANDLING SECTION ***/
 
 bool is_operation(const char *token);/*function to check if the token is a valid operation*/
 int get_operand_count(const char *operation);/*function to return the number of operands that the operation takes*/
+int calculate_instruction_lines(char *operation,char *operands);/*function to return the number of words an operation is encoded into*/
 
 /*** LABEL HANDLING SECTION ***/
 
 bool is_unique_label(LabelArray *array,const char *label);/*function to check if the label is not already initialized*/
-void initialize_label_array(LabelArray *array);/*function to initialize the LabelArray structure*/
-void add_label(LabelArray *array,const char *label,int line_number);/*function to add a label to the LabelArray*/
+bool initialize_label_array(LabelArray *array);/*function to initialize the LabelArray structure*/
+void empty_label_array(LabelArray *array);/*function to remove every label from the LabelArray*/
+void free_label_array(LabelArray *array);/*function to free the labels and the index of the LabelArray*/
+Label *find_label(const LabelArray *array,const char *label);/*function to look a label up by its name*/
+bool add_label(LabelArray *array,const char *label,int line_number);/*function to add a label to the LabelArray*/
 bool is_valid_label(const char *label);/*function to check if a string is a valid label*/
 
 /*** EXTERN AND ENTRY HANDLING SECTION ***/
 
 void initialize_extern_entry_array(ExternEntryArray *array);/*function to initialize the ExternEntryArray structure*/
-void add_extern(ExternEntryArray *array,const char *name,int line_number);/*function to add an extern variable*/
-void add_entry(ExternEntryArray *array,const char *name,int line_number);/*function to add an entry variable*/
-void handle_extern_entry_directive(char *directive,char *line,ExternEntryArray *ext_entry_array,int line_number);/*function to handle .extern and .entry directives*/
+bool add_extern(ExternEntryArray *array,const char *name,int line_number,int source_line);/*function to add an extern variable*/
+void index_extern(ExternEntryArray *array,int position);/*function to put an extern the caller added in the index*/
+ExternEntry *find_extern(const ExternEntryArray *array,const char *name);/*function to look an extern up by its name*/
+bool add_entry(ExternEntryArray *array,const char *name,int line_number,int source_line);/*function to add an entry variable*/
+bool handle_extern_entry_directive(char *directive,char *names,ExternEntryArray *ext_entry_array,int line_number,int source_line);/*function to handle .extern and .entry directives*/
 
 /*** DIRECTIVE HANDLING SECTION ***/
 
-void handle_data_directive(char *line,int *line_counter);/*function to handle .data directive*/
-void handle_string_directive(char *line,int *line_counter);/*function to handle .string directive*/
+bool handle_data_directive(char *line,int *line_counter);/*function to handle .data directive*/
+bool handle_string_directive(char *line,int *line_counter);/*function to handle .string directive*/
+int get_stored_string_length(const char *line);/*function to return the number of data words stored for a .string directive*/
 
 /*** FIRST PASS MAIN FUNCTION ***/
 
-LabelArray* first_pass(const char *filename, LabelArray *label_array, ExternEntryArray *ext_entry_array);/*main function for the first pass*/
+LabelArray* first_pass(const char *filename, LabelArray *label_array, ExternEntryArray *ext_entry_array, long *code_length, long *data_length);/*main function for the first pass*/
+bool first_pass_line(char *line,int user_line_counter,int *line_counter,LabelArray *label_array,ExternEntryArray *ext_entry_array,long *code_length,long *data_length);/*function to run the first pass over a single line*/
+void count_line_words(char *line,int *code_words,int *data_words);/*function to find the number of code and data words a line adds to the images*/
+bool first_pass_lines(FILE *file,int *line_counter,LabelArray *label_array,ExternEntryArray *ext_entry_array,long *code_length,long *data_length);/*function to run the first pass over every line of a stream from a given address*/
+LabelArray* first_pass_stream(FILE *file, LabelArray *label_array, ExternEntryArray *ext_entry_array, long *code_length, long *data_length);/*function to run the first pass over a stream*/
 bool validate_commas(const char *line,int line_counter,bool is_data);/*function to validate commas in the line*/
+bool skip_rest_of_line(FILE *file);/*function to read the rest of a line that did not fit in the line buffer*/
 
 #endif/*_FIRST_PASS_H*/
 
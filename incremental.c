@@ -0,0 +1,1283 @@
+#include "incremental.h"
+#include "diagnostics.h"
+#include "stats.h"
+
+/*** SYMBOL TABLE SECTION ***/
+
+/*
+* find_symbol
+* -----------
+* this function looks up a label that the document defines or declares external
+*
+* parameters:
+*   document: the document
+*   name: the name of the label
+*
+* returns:
+*   Symbol*: the symbol of the label or NULL if the document does not know it
+*/
+Symbol *find_symbol(IncrementalDocument *document, const char *name){
+	Symbol *symbol;
+
+	for(symbol = document->buckets[hash_label(name) & (document->bucket_count - 1)] ; symbol ; symbol = symbol->next){
+		if(strcmp(symbol->name, name) == 0){
+			return symbol;
+		}
+	}
+	return NULL;
+}
+
+/*
+* add_symbol
+* ----------
+* this function returns the symbol of a label creating it when the document does not know the label yet
+* the table doubles its buckets once it holds more symbols than buckets
+*
+* parameters:
+*   document: the document
+*   name: the name of the label
+*
+* returns:
+*   Symbol*: the symbol of the label or NULL if memory ran out
+*/
+Symbol *add_symbol(IncrementalDocument *document, const char *name){
+	Symbol *symbol = find_symbol(document, name), *next, **buckets;
+	int i, bucket_count;
+
+	if(symbol){
+		return symbol;
+	}
+	if(document->symbol_count >= document->bucket_count){/*keep the chains short*/
+		bucket_count = document->bucket_count * 2;
+		buckets = (Symbol**)calloc(bucket_count, sizeof(Symbol*));
+		if(!buckets){
+			print_system_error("calloc failed");
+			return NULL;
+		}
+		for(i=0 ; i<document->bucket_count ; i++){
+			for(symbol = document->buckets[i] ; symbol ; symbol = next){
+				next = symbol->next;
+				symbol->next = buckets[hash_label(symbol->name) & (bucket_count - 1)];
+				buckets[hash_label(symbol->name) & (bucket_count - 1)] = symbol;
+			}
+		}
+		free(document->buckets);
+		document->buckets = buckets;
+		document->bucket_count = bucket_count;
+	}
+
+	symbol = (Symbol*)calloc(1, sizeof(Symbol));
+	if(!symbol){
+		print_system_error("calloc failed");
+		return NULL;
+	}
+	strcpy(symbol->name, name);
+	symbol->next = document->buckets[hash_label(name) & (document->bucket_count - 1)];
+	document->buckets[hash_label(name) & (document->bucket_count - 1)] = symbol;
+	document->symbol_count++;
+	return symbol;
+}
+
+/*
+* release_symbol
+* --------------
+* this function removes a symbol that no line defines or declares external any more
+*
+* parameters:
+*   document: the document
+*   symbol: the symbol
+*
+*/
+void release_symbol(IncrementalDocument *document, Symbol *symbol){
+	Symbol **link;
+
+	if(symbol->definitions > 0 || symbol->externs > 0){
+		return;
+	}
+	for(link = &document->buckets[hash_label(symbol->name) & (document->bucket_count - 1)] ; *link ; link = &(*link)->next){
+		if(*link == symbol){
+			*link = symbol->next;
+			free(symbol);
+			document->symbol_count--;
+			return;
+		}
+	}
+}
+
+/*
+* register_line
+* -------------
+* this function adds the label a line defines and the names it declares external to the symbol table
+* when a label is defined more than once the first line that defines it is its definition
+*
+* parameters:
+*   document: the document
+*   line: the line (its index is final)
+*
+* returns:
+*   bool: true if the line was registered false if memory ran out
+*/
+bool register_line(IncrementalDocument *document, IncrementalLine *line){
+	Symbol *symbol;
+	int i;
+
+	if(line->label[0]){
+		symbol = add_symbol(document, line->label);
+		if(!symbol){
+			return false;
+		}
+		symbol->definitions++;
+		if(!symbol->definition || line->index < symbol->definition->index){
+			symbol->definition = line;
+		}
+	}
+	for(i=0 ; line->kind == LINE_EXTERN && i<line->target_count ; i++){
+		if(line->targets[i].name[0]){
+			symbol = add_symbol(document, line->targets[i].name);
+			if(!symbol){
+				return false;
+			}
+			symbol->externs++;
+		}
+	}
+	return true;
+}
+
+/*
+* unregister_line
+* ---------------
+* this function removes what register_line added for a line that left the document
+* when the line was the definition of a label that is defined again further on that line becomes the definition
+*
+* parameters:
+*   document: the document
+*   line: the line (no longer in the lines of the document)
+*
+*/
+void unregister_line(IncrementalDocument *document, IncrementalLine *line){
+	Symbol *symbol;
+	int i;
+
+	if(line->label[0] && (symbol = find_symbol(document, line->label)) != NULL){
+		symbol->definitions--;
+		if(symbol->definition == line){
+			symbol->definition = NULL;
+			for(i=0 ; symbol->definitions > 0 && i<document->count ; i++){/*find the next definition*/
+				if(strcmp(document->lines[i]->label, line->label) == 0){
+					symbol->definition = document->lines[i];
+					break;
+				}
+			}
+		}
+		release_symbol(document, symbol);
+	}
+	for(i=0 ; line->kind == LINE_EXTERN && i<line->target_count ; i++){
+		if(line->targets[i].name[0] && (symbol = find_symbol(document, line->targets[i].name)) != NULL){
+			symbol->externs--;
+			release_symbol(document, symbol);
+		}
+	}
+}
+
+/*
+* resolve_target
+* --------------
+* this function finds the value a target of a line is encoded with
+* an operand that names an extern is external even when a label has the same name like in the second pass
+* an .entry that names an extern is external too so encode_line reports it like update_entry_lines
+* while an .extern only looks at the labels so encode_line reports a definition like check_extern_labels
+*
+* parameters:
+*   document: the document
+*   kind: the kind of the line the target belongs to
+*   name: the name of the target
+*
+* returns:
+*   long: the address of the label INCREMENTAL_EXTERN or INCREMENTAL_UNDEFINED
+*/
+long resolve_target(IncrementalDocument *document, line_kind kind, const char *name){
+	Symbol *symbol = name[0] ? find_symbol(document, name) : NULL;
+
+	if(!symbol){
+		return INCREMENTAL_UNDEFINED;
+	}
+	if((kind == LINE_CODE || kind == LINE_ENTRY) && symbol->externs > 0){
+		return INCREMENTAL_EXTERN;
+	}
+	return symbol->definition ? symbol->definition->address : INCREMENTAL_UNDEFINED;
+}
+
+/*** ERROR CAPTURE SECTION ***/
+
+/*
+* start_capture
+* -------------
+* this function sends the messages of the calling thread to a memory stream for the duration of an update
+* so the errors the passes print for a line can be attached to the line
+*
+* parameters:
+*   document: the document being updated
+*
+* returns:
+*   bool: true if the messages are captured false otherwise
+*/
+bool start_capture(IncrementalDocument *document){
+	document->capture_buffer = NULL;
+	document->capture_size = 0;
+	document->capture = open_memstream(&document->capture_buffer, &document->capture_size);
+	if(!document->capture){
+		print_system_error("Error: couldn't capture the messages");
+		return false;
+	}
+	document->saved_messages = message_output();
+	document->saved_errors = error_output();
+	redirect_output(document->capture, document->capture);
+	return true;
+}
+
+/*
+* take_capture
+* ------------
+* this function returns the messages printed since a position of the capture stream
+*
+* parameters:
+*   document: the document being updated
+*   start: the position of the capture stream before the messages were printed
+*
+* returns:
+*   char*: the messages without the last newline (freed by the caller) or NULL if nothing was printed
+*/
+char *take_capture(IncrementalDocument *document, long start){
+	char *messages;
+	size_t length;
+
+	fflush(document->capture);
+	if(document->capture_size <= (size_t)start){
+		return NULL;
+	}
+	length = document->capture_size - start;
+	while(length > 0 && document->capture_buffer[start + length - 1] == '\n'){
+		length--;
+	}
+	messages = (char*)malloc(length + 1);
+	if(messages){
+		memcpy(messages, document->capture_buffer + start, length);
+		messages[length] = '\0';
+	}
+	return messages;
+}
+
+/*
+* stop_capture
+* ------------
+* this function gives the calling thread its message streams back
+*
+* parameters:
+*   document: the document being updated
+*
+*/
+void stop_capture(IncrementalDocument *document){
+	redirect_output(document->saved_messages, document->saved_errors);
+	fclose(document->capture);
+	free(document->capture_buffer);
+	document->capture = NULL;
+	document->capture_buffer = NULL;
+}
+
+/*** LINE SECTION ***/
+
+/*
+* create_incremental_line
+* -----------------------
+* this function creates the representation of a preprocessed line before it is sized
+*
+* parameters:
+*   text: the preprocessed line
+*   length: the length of the line without its newline
+*   source_line: the 1 based source line that produced it
+*
+* returns:
+*   IncrementalLine*: the new line or NULL if memory ran out
+*/
+IncrementalLine *create_incremental_line(const char *text, size_t length, int source_line){
+	IncrementalLine *line = (IncrementalLine*)calloc(1, sizeof(IncrementalLine));
+
+	if(!line || !(line->text = (char*)malloc(length + 1))){
+		print_system_error("malloc failed");
+		free(line);
+		return NULL;
+	}
+	memcpy(line->text, text, length);
+	line->text[length] = '\0';
+	line->source_line = source_line;
+	line->kind = LINE_BLANK;
+	return line;
+}
+
+/*
+* free_incremental_line
+* ---------------------
+* this function frees a line together with everything it holds
+*
+* parameters:
+*   line: the line or NULL
+*
+*/
+void free_incremental_line(IncrementalLine *line){
+	if(line){
+		free(line->text);
+		free(line->targets);
+		free(line->words);
+		free(line->error);
+		free(line);
+	}
+}
+
+/*
+* add_target
+* ----------
+* this function adds a label to the targets of a line
+* a name too long to be a label is kept empty so it never resolves
+*
+* parameters:
+*   line: the line
+*   name: the name of the label
+*
+* returns:
+*   bool: true if the target was added false if memory ran out
+*/
+bool add_target(IncrementalLine *line, const char *name){
+	LineTarget *targets = (LineTarget*)realloc(line->targets, (line->target_count + 1) * sizeof(LineTarget));
+
+	if(!targets){
+		print_system_error("realloc failed");
+		return false;
+	}
+	line->targets = targets;
+	targets[line->target_count].name[0] = '\0';
+	if(strlen(name) <= MAX_LABEL_LENGTH){
+		strcpy(targets[line->target_count].name, name);
+	}
+	targets[line->target_count].value = INCREMENTAL_UNDEFINED;
+	line->target_count++;
+	return true;
+}
+
+/*
+* size_line
+* ---------
+* this function does for a single line what the first pass does for every line
+* it finds the kind of the line the label it defines and how much it adds to the address counter
+* and remembers the labels its operands refer to so the line is encoded again when one of them moves
+* the messages name the source line instead of the address counter since they are shown next to the source
+*
+* parameters:
+*   line: the line
+*
+* returns:
+*   bool: true if the line was sized (even when it is invalid) false if memory ran out
+*/
+bool size_line(IncrementalLine *line){
+	char buffer[MAX_LINE_LENGTH + 1];/*the line split by strtok_r*/
+	char operands[MAX_LINE_LENGTH + 1];/*copy of the operands for the targets*/
+	char *token, *save, *rest;
+	int counter = line->source_line;/*counter handed to the directive handlers*/
+	int size;
+
+	line->kind = LINE_INVALID;
+	line->label[0] = '\0';
+	line->size = line->code_size = line->data_size = 0;
+	free(line->targets);
+	line->targets = NULL;
+	line->target_count = 0;
+	if(strlen(line->text) > MAX_LINE_LENGTH){
+		fprintf(error_output(), "Error: Line exceeds maximum length of %d characters\n", MAX_LINE_LENGTH);
+		return true;
+	}
+	strcpy(buffer, line->text);
+	if(strspn(buffer, " \t") == strlen(buffer)){/*empty lines or lines with only whitespace*/
+		line->kind = LINE_BLANK;
+		return true;
+	}
+	if(!validate_commas(buffer, line->source_line, strstr(buffer, ".data") != NULL)){
+		return true;
+	}
+
+	token = strtok_r(buffer, " \t", &save);
+	if(token && strchr(token, ':')){
+		*strchr(token, ':') = '\0';
+		if(!is_valid_label(token)){
+			fprintf(error_output(), "Error: Invalid label '%s'\n", token);
+			return true;
+		}
+		strncpy(line->label, token, MAX_LABEL_LENGTH);
+		line->label[MAX_LABEL_LENGTH] = '\0';
+		token = strtok_r(NULL, " \t", &save);
+	}
+	if(token == NULL){/*a label alone on its line takes a word of the address counter*/
+		line->kind = LINE_LABEL;
+		line->size = 1;
+		return true;
+	}
+
+	rest = strtok_r(NULL, "\n", &save);
+	if(is_operation(token)){
+		strcpy(operands, rest ? rest : "");
+		size = calculate_instruction_lines(token, rest);
+		if(size < 0){
+			return true;
+		}
+		line->kind = LINE_CODE;
+		line->size = line->code_size = size;
+		for(token = strtok_r(operands, ", \t", &save) ; token && line->target_count < 2 ; token = strtok_r(NULL, ", \t", &save)){
+			if(get_addressing_type(token) == DIRECT_ADDR && !add_target(line, token)){
+				return false;
+			}
+		}
+	}
+	else if(strcmp(token, ".data") == 0){
+		if(rest == NULL){
+			fprintf(error_output(), "Error: Invalid .data directive\n");
+			return true;
+		}
+		if(!handle_data_directive(rest, &counter)){
+			return true;
+		}
+		line->kind = LINE_DATA;
+		line->size = line->data_size = counter - line->source_line;
+	}
+	else if(strcmp(token, ".string") == 0){
+		if(rest == NULL){
+			fprintf(error_output(), "Error: Invalid string directive\n");
+			return true;
+		}
+		while(*rest == ' ' || *rest == '\t'){
+			rest++;
+		}
+		if(!handle_string_directive(rest, &counter)){
+			return true;
+		}
+		line->kind = LINE_DATA;
+		line->size = counter - line->source_line;
+		line->data_size = get_stored_string_length(rest);/*the words the second pass stores*/
+	}
+	else if(strcmp(token, ".extern") == 0 || strcmp(token, ".entry") == 0){
+		line->kind = strcmp(token, ".extern") == 0 ? LINE_EXTERN : LINE_ENTRY;
+		for(token = rest ? strtok_r(rest, " \t", &save) : NULL ; token ; token = strtok_r(NULL, " \t", &save)){
+			if(!add_target(line, token)){
+				return false;
+			}
+		}
+	}
+	else{
+		fprintf(error_output(), "Error: Unknown directive or operation '%s'\n", token);
+	}
+	return true;
+}
+
+/*
+* encode_line
+* -----------
+* this function does for a single line what the second pass does for every line
+* an operation is encoded by process_code with a label table and an extern table that hold only its own targets
+* so it gets the same words as in the second pass without the cost of searching every label of the document
+*
+* parameters:
+*   document: the document
+*   line: the line (sized and placed at its address)
+*
+* returns:
+*   bool: true if the line was encoded (even when it has an error) false if memory ran out
+*/
+bool encode_line(IncrementalDocument *document, IncrementalLine *line){
+	MachineWordsArray *code_img[INCREMENTAL_MAX_CODE_WORDS];/*the words process_code creates*/
+	long data_img[MAX_LINE_LENGTH + 1];/*the values of a directive*/
+	Label labels[2];/*the label targets of an operation*/
+	LabelArray label_array;
+	ExternEntry *extern_printing_array = NULL;/*the extern references process_code records*/
+	ExternLogSize log_size = {0, 0};
+	char buffer[MAX_LINE_LENGTH + 1];
+	char *operation, *remaining, *save;
+	long ic = IC_INIT_VALUE, dc = 0;
+	long start = ftell(document->capture);
+	bool encoded = false;
+	int i;
+
+	free(line->error);
+	free(line->words);
+	line->error = NULL;
+	line->words = NULL;
+	document->encoded_lines++;
+	for(i=0 ; i<line->target_count ; i++){
+		line->targets[i].value = resolve_target(document, line->kind, line->targets[i].name);
+	}
+
+	if(line->kind == LINE_ENTRY || line->kind == LINE_EXTERN){
+		if(line->label[0]){/*the messages of the sizing are replaced so the warning of the label is printed here (the label names whatever word comes next)*/
+			fprintf(error_output(), "Warning: Label '%s' of a %s directive labels the word after it\n", line->label, line->kind == LINE_ENTRY ? ".entry" : ".extern");
+		}
+		for(i=0 ; i<line->target_count ; i++){
+			if(line->kind == LINE_EXTERN && line->targets[i].value != INCREMENTAL_UNDEFINED){
+				fprintf(error_output(), "Error: Extern label '%s' is also defined in the file\n", line->targets[i].name);
+			}
+			else if(line->kind == LINE_ENTRY && line->targets[i].value == INCREMENTAL_EXTERN){
+				fprintf(error_output(), "Error: Entry label '%s' is also declared as extern\n", line->targets[i].name);
+			}
+			else if(line->kind == LINE_ENTRY && line->targets[i].value == INCREMENTAL_UNDEFINED){
+				fprintf(error_output(), "Error: Entry label '%s' not found in label array\n", line->targets[i].name);
+			}
+		}
+	}
+	else if(line->kind == LINE_CODE || line->kind == LINE_DATA){
+		strcpy(buffer, line->text);
+		operation = strtok_r(buffer, " \t", &save);
+		if(operation && strchr(operation, ':')){
+			operation = strtok_r(NULL, " \t", &save);
+		}
+		remaining = strtok_r(NULL, "", &save);
+		if(remaining == NULL){
+			remaining = "";
+		}
+
+		if(line->kind == LINE_CODE){
+			label_array.labels = labels;
+			label_array.count = 0;
+			label_array.capacity = 2;
+			label_array.index = NULL;/*two labels are looked up one by one*/
+			label_array.index_size = 0;
+			document->externs.extern_count = 0;
+			document->externs.entry_count = 0;
+			document->externs.extern_indexed = false;/*two externs are looked up one by one*/
+			for(i=0 ; i<line->target_count ; i++){
+				if(line->targets[i].value == INCREMENTAL_EXTERN){
+					strcpy(document->externs.externs[document->externs.extern_count++].name, line->targets[i].name);
+				}
+				else if(line->targets[i].value != INCREMENTAL_UNDEFINED){
+					strcpy(labels[label_array.count].label, line->targets[i].name);
+					labels[label_array.count++].line_number = (int)line->targets[i].value;
+				}
+			}
+			memset(code_img, 0, sizeof(code_img));
+			encoded = process_code(operation, remaining, &ic, code_img, &label_array, &document->externs, &extern_printing_array, &log_size) && ic - IC_INIT_VALUE == line->code_size;
+			if(encoded && (line->words = (unsigned int*)malloc(line->code_size * sizeof(unsigned int))) != NULL){
+				for(i=0 ; i<line->code_size ; i++){
+					line->words[i] = convert_machine_word_to_binary(code_img[i]);
+				}
+			}
+			for(i=0 ; i<INCREMENTAL_MAX_CODE_WORDS ; i++){
+				if(code_img[i]){
+					free_machine_word(code_img[i]);
+				}
+			}
+			STATS_FREE(extern_printing_array);
+		}
+		else{
+			if(strcmp(operation, ".data") == 0){
+				encoded = handle_data_directive_SP(remaining, data_img, &dc);
+			}
+			else{
+				encoded = handle_string_directive_SP(remaining, data_img, &dc);
+			}
+			encoded = encoded && dc == line->data_size;
+			if(encoded && dc > 0 && (line->words = (unsigned int*)malloc(dc * sizeof(unsigned int))) != NULL){
+				for(i=0 ; i<dc ; i++){
+					line->words[i] = handle_data_value((int)data_img[i]);
+				}
+			}
+		}
+		if(encoded && !line->words && line->code_size + line->data_size > 0){
+			print_system_error("malloc failed");
+			return false;
+		}
+	}
+	line->error = take_capture(document, start);
+	return true;
+}
+
+/*** DOCUMENT SECTION ***/
+
+/*
+* initialize_incremental_document
+* -------------------------------
+* this function prepares a document that holds an empty source
+*
+* parameters:
+*   document: the document
+*
+* returns:
+*   bool: true if the document was prepared false if memory ran out
+*/
+bool initialize_incremental_document(IncrementalDocument *document){
+	memset(document, 0, sizeof(IncrementalDocument));
+	document->overflow_line = -1;
+	document->bucket_count = INITIAL_SYMBOL_BUCKETS;
+	document->buckets = (Symbol**)calloc(document->bucket_count, sizeof(Symbol*));
+	if(!document->buckets){
+		print_system_error("calloc failed");
+		return false;
+	}
+	initialize_extern_entry_array(&document->externs);
+	return true;
+}
+
+/*
+* clear_lines
+* -----------
+* this function removes every line and symbol of a document
+*
+* parameters:
+*   document: the document
+*
+*/
+void clear_lines(IncrementalDocument *document){
+	Symbol *symbol, *next;
+	int i;
+
+	for(i=0 ; i<document->count ; i++){
+		free_incremental_line(document->lines[i]);
+	}
+	document->count = 0;
+	for(i=0 ; i<document->bucket_count ; i++){
+		for(symbol = document->buckets[i] ; symbol ; symbol = next){
+			next = symbol->next;
+			free(symbol);
+		}
+		document->buckets[i] = NULL;
+	}
+	document->symbol_count = 0;
+	document->code_length = 0;
+	document->data_length = 0;
+	document->overflow_line = -1;
+}
+
+/*
+* free_incremental_document
+* -------------------------
+* this function frees everything a document holds
+*
+* parameters:
+*   document: the document
+*
+*/
+void free_incremental_document(IncrementalDocument *document){
+	clear_lines(document);
+	free(document->lines);
+	free(document->buckets);
+	free(document->source);
+	free(document->source_starts);
+	free(document->error);
+	memset(document, 0, sizeof(IncrementalDocument));
+}
+
+/*
+* split_source
+* ------------
+* this function finds where every line of a source starts and counts the lines that define macros
+* a last line without a newline is a line while the empty rest after a last newline is not
+*
+* parameters:
+*   source: the source
+*   length: the length of the source
+*   starts: a pointer that receives the offsets of the lines (freed by the caller)
+*   count: a pointer that receives the number of lines
+*   macro_lines: a pointer that receives the number of lines that start or end a macro definition
+*
+* returns:
+*   bool: true if the source was split false if memory ran out
+*/
+bool split_source(const char *source, size_t length, size_t **starts, int *count, int *macro_lines){
+	size_t position, capacity = 64;
+	size_t *offsets, *expanded;
+	const char *text;
+
+	*count = 0;
+	*macro_lines = 0;
+	offsets = (size_t*)malloc(capacity * sizeof(size_t));
+	if(!offsets){
+		print_system_error("malloc failed");
+		return false;
+	}
+	for(position = 0 ; position < length ; position++){
+		if(position == 0 || source[position - 1] == '\n'){/*a line starts here*/
+			if((size_t)*count >= capacity){
+				expanded = (size_t*)realloc(offsets, capacity * 2 * sizeof(size_t));
+				if(!expanded){
+					print_system_error("realloc failed");
+					free(offsets);
+					return false;
+				}
+				offsets = expanded;
+				capacity *= 2;
+			}
+			offsets[(*count)++] = position;
+			for(text = source + position ; text < source + length && (*text == ' ' || *text == '\t') ; text++);
+			if((length - (text - source) >= 5 && strncmp(text, "macr ", 5) == 0) || (length - (text - source) >= 7 && strncmp(text, "endmacr", 7) == 0)){
+				(*macro_lines)++;/*the preprocessor needs the whole source to expand the calls*/
+			}
+		}
+	}
+	*starts = offsets;
+	return true;
+}
+
+/*
+* source_line_length
+* ------------------
+* this function returns the length of a line of a split source including its newline
+*
+* parameters:
+*   starts: the offsets of the lines
+*   count: the number of lines
+*   length: the length of the source
+*   line: the 0 based line
+*
+* returns:
+*   size_t: the length of the line
+*/
+size_t source_line_length(const size_t *starts, int count, size_t length, int line){
+	return (line + 1 < count ? starts[line + 1] : length) - starts[line];
+}
+
+/*
+* first_line_from
+* ---------------
+* this function finds the first line of the document produced by a source line or by a source line after it
+*
+* parameters:
+*   document: the document
+*   source_line: the 1 based source line
+*
+* returns:
+*   int: the index of the line (the number of lines when no line qualifies)
+*/
+int first_line_from(IncrementalDocument *document, int source_line){
+	int low = 0, high = document->count, middle;
+
+	while(low < high){/*the lines are in the order of the source*/
+		middle = low + (high - low) / 2;
+		if(document->lines[middle]->source_line < source_line){
+			low = middle + 1;
+		}
+		else{
+			high = middle;
+		}
+	}
+	return low;
+}
+
+/*
+* preprocess_slice
+* ----------------
+* this function expands the macros of a piece of the source into memory and maps its lines back to the source
+*
+* parameters:
+*   text: the piece of the source (made of whole lines)
+*   length: the length of the piece
+*   preprocessed: a pointer that receives the preprocessed piece (freed by the caller)
+*   size: a pointer that receives the length of the preprocessed piece
+*   map: the map that receives the source line of every preprocessed line (relative to the piece)
+*
+* returns:
+*   bool: true if the piece was preprocessed false if the preprocessor failed
+*/
+bool preprocess_slice(const char *text, size_t length, char **preprocessed, size_t *size, LineMap *map){
+	FILE *input, *output;
+	bool success;
+
+	*preprocessed = NULL;
+	*size = 0;
+	map->count = 0;
+	map->source_line = 0;
+	if(length == 0){/*nothing to preprocess (fmemopen rejects an empty buffer)*/
+		return true;
+	}
+	input = fmemopen((void*)text, length, "r");
+	output = open_memstream(preprocessed, size);
+	if(!input || !output){
+		print_system_error("Error: couldn't preprocess the source");
+		if(input){
+			fclose(input);
+		}
+		if(output){
+			fclose(output);
+		}
+		return false;
+	}
+	success = preprocess_stream_mapped(input, output, map);
+	fclose(input);
+	fclose(output);
+	return success;
+}
+
+/*
+* replace_lines
+* -------------
+* this function replaces a range of the lines of a document by new lines
+*
+* parameters:
+*   document: the document
+*   position: the index of the first replaced line
+*   removed: the number of lines removed (their pointers are copied to removed_lines)
+*   removed_lines: receives the removed lines
+*   inserted: the new lines
+*   inserted_count: the number of new lines
+*
+* returns:
+*   bool: true if the lines were replaced false if memory ran out
+*/
+bool replace_lines(IncrementalDocument *document, int position, int removed, IncrementalLine **removed_lines, IncrementalLine **inserted, int inserted_count){
+	IncrementalLine **lines;
+	int capacity;
+
+	if(document->count - removed + inserted_count > document->capacity){
+		capacity = document->capacity ? document->capacity : 64;
+		while(capacity < document->count - removed + inserted_count){
+			capacity *= 2;
+		}
+		lines = (IncrementalLine**)realloc(document->lines, capacity * sizeof(IncrementalLine*));
+		if(!lines){
+			print_system_error("realloc failed");
+			return false;
+		}
+		document->lines = lines;
+		document->capacity = capacity;
+	}
+	if(document->count > 0){
+		memcpy(removed_lines, document->lines + position, removed * sizeof(IncrementalLine*));
+		memmove(document->lines + position + inserted_count, document->lines + position + removed, (document->count - position - removed) * sizeof(IncrementalLine*));
+	}
+	if(inserted_count > 0){
+		memcpy(document->lines + position, inserted, inserted_count * sizeof(IncrementalLine*));
+	}
+	document->count += inserted_count - removed;
+	return true;
+}
+
+/*
+* place_lines
+* -----------
+* this function gives the lines from an index on their index and addresses
+* the address counter of the first pass is IC_INIT_VALUE plus the sizes of the lines before
+* while the code and data offsets count only the code and data words
+*
+* parameters:
+*   document: the document
+*   position: the index of the first line to place
+*
+* returns:
+*   bool: true if the address of a line that defines a label changed
+*/
+bool place_lines(IncrementalDocument *document, int position){
+	IncrementalLine *line, *previous = position > 0 ? document->lines[position - 1] : NULL;
+	long address = previous ? previous->address + previous->size : IC_INIT_VALUE;
+	long code_offset = previous ? previous->code_offset + previous->code_size : 0;
+	long data_offset = previous ? previous->data_offset + previous->data_size : 0;
+	bool moved = false;
+	int i;
+
+	if(document->overflow_line >= position){/*the lines before did not overflow*/
+		document->overflow_line = -1;
+	}
+	for(i=position ; i<document->count ; i++){
+		line = document->lines[i];
+		if(line->label[0] && line->address != address){
+			moved = true;
+		}
+		line->index = i;
+		line->address = address;
+		line->code_offset = code_offset;
+		line->data_offset = data_offset;
+		address += line->size;
+		code_offset += line->code_size;
+		data_offset += line->data_size;
+		if(address > CODE_ARR_IMG_LENGTH && document->overflow_line < 0){
+			document->overflow_line = i;
+		}
+	}
+	document->code_length = code_offset;
+	document->data_length = data_offset;
+	return moved;
+}
+
+/*
+* same_source_line
+* ----------------
+* this function checks if a line of the new source is the same as a line of the source of the document
+*
+* parameters:
+*   document: the document
+*   line: the 0 based line of the document source
+*   source: the new source
+*   length: the length of the new source
+*   starts: the offsets of the lines of the new source
+*   count: the number of lines of the new source
+*   new_line: the 0 based line of the new source
+*
+* returns:
+*   bool: true if both lines hold the same text
+*/
+bool same_source_line(IncrementalDocument *document, int line, const char *source, size_t length, const size_t *starts, int count, int new_line){
+	size_t old_length = source_line_length(document->source_starts, document->source_count, document->source_length, line);
+
+	return old_length == source_line_length(starts, count, length, new_line) && memcmp(document->source + document->source_starts[line], source + starts[new_line], old_length) == 0;
+}
+
+/*
+* split_preprocessed
+* ------------------
+* this function creates a line for every line of a preprocessed piece of the source
+*
+* parameters:
+*   preprocessed: the preprocessed piece or NULL when it is empty
+*   size: the length of the preprocessed piece
+*   map: the source line of every preprocessed line relative to the piece
+*   prefix: the number of source lines before the piece
+*   count: a pointer that receives the number of lines
+*
+* returns:
+*   IncrementalLine**: the lines (freed by the caller) or NULL if memory ran out
+*/
+IncrementalLine **split_preprocessed(const char *preprocessed, size_t size, const LineMap *map, int prefix, int *count){
+	IncrementalLine **lines = (IncrementalLine**)calloc(map->count + 1, sizeof(IncrementalLine*));
+	const char *text, *newline;
+	int i;
+
+	*count = 0;
+	if(!lines){
+		print_system_error("calloc failed");
+		return NULL;
+	}
+	for(text = preprocessed ; text && text < preprocessed + size && *count < map->count ; text = newline + 1){
+		newline = memchr(text, '\n', preprocessed + size - text);
+		if(!newline){
+			newline = preprocessed + size;/*the last line has no newline*/
+		}
+		lines[*count] = create_incremental_line(text, strcspn(text, "\r\n"), prefix + map->lines[*count]);
+		if(!lines[*count]){
+			for(i=0 ; i<*count ; i++){
+				free_incremental_line(lines[i]);
+			}
+			free(lines);
+			return NULL;
+		}
+		(*count)++;
+	}
+	return lines;
+}
+
+/*
+* size_lines
+* ----------
+* this function sizes new lines attaching the errors printed for each of them
+*
+* parameters:
+*   document: the document being updated
+*   lines: the new lines
+*   count: the number of new lines
+*
+* returns:
+*   bool: true if the lines were sized false if memory ran out
+*/
+bool size_lines(IncrementalDocument *document, IncrementalLine **lines, int count){
+	long start;
+	int i;
+
+	for(i=0 ; i<count ; i++){
+		start = ftell(document->capture);
+		if(!size_line(lines[i])){
+			return false;
+		}
+		lines[i]->error = take_capture(document, start);
+		document->sized_lines++;
+	}
+	return true;
+}
+
+/*
+* move_line
+* ---------
+* this function gives a line that did not change the source line it now comes from
+* its messages do not name the line so they stay as they are
+*
+* parameters:
+*   line: the line
+*   source_line: the 1 based source line
+*
+*/
+void move_line(IncrementalLine *line, int source_line){
+	line->source_line = source_line;
+}
+
+/*
+* encode_changes
+* --------------
+* this function updates the symbol table after lines were replaced and encodes what the edit changed
+* the new lines are encoded and when a label was added removed or moved
+* every line whose targets now resolve to another value is encoded again
+*
+* parameters:
+*   document: the document being updated
+*   removed: the lines that left the document (freed by the function)
+*   removed_count: the number of removed lines
+*   position: the index of the first new line
+*   inserted_count: the number of new lines
+*   moved: true if a line that defines a label changed its address
+*
+* returns:
+*   bool: true if the lines were encoded false if memory ran out
+*/
+bool encode_changes(IncrementalDocument *document, IncrementalLine **removed, int removed_count, int position, int inserted_count, bool moved){
+	IncrementalLine *line;
+	bool success = true;
+	int i, j;
+
+	for(i=0 ; i<removed_count ; i++){
+		moved = moved || removed[i]->label[0] || removed[i]->kind == LINE_EXTERN;
+		unregister_line(document, removed[i]);
+		free_incremental_line(removed[i]);
+	}
+	for(i=position ; success && i<position + inserted_count ; i++){
+		moved = moved || document->lines[i]->label[0] || document->lines[i]->kind == LINE_EXTERN;
+		success = register_line(document, document->lines[i]);
+	}
+
+	for(i=position ; success && i<position + inserted_count ; i++){
+		if(document->lines[i]->kind == LINE_CODE || document->lines[i]->kind == LINE_DATA || document->lines[i]->kind == LINE_ENTRY || document->lines[i]->kind == LINE_EXTERN){
+			success = encode_line(document, document->lines[i]);
+		}
+	}
+	for(i=0 ; success && moved && i<document->count ; i++){
+		line = document->lines[i];
+		for(j=0 ; (line->kind == LINE_CODE || line->kind == LINE_ENTRY || line->kind == LINE_EXTERN) && j<line->target_count ; j++){
+			if(line->targets[j].value != resolve_target(document, line->kind, line->targets[j].name)){
+				success = encode_line(document, line);
+				break;
+			}
+		}
+	}
+	return success;
+}
+
+/*
+* apply_edit
+* ----------
+* this function replaces the lines produced by the edited source lines with the lines of their new preprocessed text
+* the preprocessed lines that did not change are kept with their words so an edit of a macro only changes its calls
+*
+* parameters:
+*   document: the document being updated
+*   prefix: the number of source lines before the edit
+*   suffix: the number of source lines after the edit
+*   count: the number of lines of the new source
+*   preprocessed: the preprocessed edited lines or NULL when there are none
+*   size: the length of the preprocessed edited lines
+*   map: the source line of every preprocessed line relative to the edit
+*
+* returns:
+*   bool: true if the edit was applied false if memory ran out
+*/
+bool apply_edit(IncrementalDocument *document, int prefix, int suffix, int count, const char *preprocessed, size_t size, const LineMap *map){
+	IncrementalLine **inserted, **removed;
+	int first = first_line_from(document, prefix + 1);
+	int last = first_line_from(document, document->source_count - suffix + 1);
+	int same = 0, tail = 0, new_count = 0, inserted_count, removed_count, i;
+	bool success;
+
+	inserted = split_preprocessed(preprocessed, size, map, prefix, &new_count);
+	removed = (IncrementalLine**)malloc((last - first + 1) * sizeof(IncrementalLine*));
+	if(!inserted || !removed){
+		for(i=0 ; inserted && i<new_count ; i++){
+			free_incremental_line(inserted[i]);
+		}
+		free(inserted);
+		free(removed);
+		return false;
+	}
+
+	/*keep the lines at both ends that did not change*/
+	while(same < last - first && same < new_count && strcmp(document->lines[first + same]->text, inserted[same]->text) == 0){
+		same++;
+	}
+	while(tail < last - first - same && tail < new_count - same && strcmp(document->lines[last - 1 - tail]->text, inserted[new_count - 1 - tail]->text) == 0){
+		tail++;
+	}
+	for(i=0 ; i<same ; i++){
+		move_line(document->lines[first + i], inserted[i]->source_line);
+	}
+	for(i=0 ; i<tail ; i++){
+		move_line(document->lines[last - 1 - i], inserted[new_count - 1 - i]->source_line);
+	}
+	for(i=last ; i<document->count ; i++){/*the source lines after the edit moved*/
+		move_line(document->lines[i], document->lines[i]->source_line + count - document->source_count);
+	}
+	inserted_count = new_count - same - tail;
+	removed_count = last - first - same - tail;
+
+	success = size_lines(document, inserted + same, inserted_count) && replace_lines(document, first + same, removed_count, removed, inserted + same, inserted_count);
+	for(i=0 ; i<new_count ; i++){
+		if(!success || i < same || i >= same + inserted_count){/*the new lines belong to the document once they replaced the old ones*/
+			free_incremental_line(inserted[i]);
+		}
+	}
+	free(inserted);
+	if(success){
+		success = encode_changes(document, removed, removed_count, first + same, inserted_count, place_lines(document, first + same));
+	}
+	free(removed);
+	return success;
+}
+
+/*
+* update_incremental_document
+* ---------------------------
+* this function brings a document up to date with a new version of its source
+* the source lines before and after the edit are kept and only the edited lines are preprocessed
+* unless the source defines macros in which case the whole source is preprocessed since a macro can be called anywhere
+* then only the new lines are sized the lines after them are shifted and the new lines
+* and the lines whose targets now resolve to another value are encoded
+* the errors the passes print are attached to the lines instead of stopping the update
+*
+* parameters:
+*   document: the document
+*   source: the new source
+*   length: the length of the source
+*
+* returns:
+*   bool: true if the document is up to date false if memory ran out (the document is then empty until the next update)
+*/
+bool update_incremental_document(IncrementalDocument *document, const char *source, size_t length){
+	size_t *starts;/*offsets of the lines of the new source*/
+	int count, macro_lines;/*number of lines and macro lines of the new source*/
+	int prefix = 0, suffix = 0;/*source lines that did not change at the start and at the end*/
+	size_t begin, end;/*the edited lines of the new source*/
+	char *preprocessed, *copy;
+	size_t preprocessed_size;
+	LineMap map;
+	long start;
+	bool success = true;
+
+	initialize_line_map(&map, false);
+	document->sized_lines = 0;
+	document->encoded_lines = 0;
+	copy = (char*)malloc(length + 1);
+	if(!copy || !split_source(source, length, &starts, &count, &macro_lines)){
+		free(copy);
+		return false;
+	}
+	memcpy(copy, source, length);
+	copy[length] = '\0';
+	if(!start_capture(document)){
+		free(copy);
+		free(starts);
+		return false;
+	}
+
+	if(!document->rebuild && document->macro_lines == 0 && macro_lines == 0){/*find the edited source lines*/
+		while(prefix < count && prefix < document->source_count && same_source_line(document, prefix, source, length, starts, count, prefix)){
+			prefix++;
+		}
+		while(suffix < count - prefix && suffix < document->source_count - prefix && same_source_line(document, document->source_count - 1 - suffix, source, length, starts, count, count - 1 - suffix)){
+			suffix++;
+		}
+	}
+	else if(document->rebuild){
+		clear_lines(document);
+	}
+	begin = prefix < count ? starts[prefix] : length;
+	end = suffix > 0 ? starts[count - suffix] : length;
+
+	start = ftell(document->capture);
+	free(document->error);
+	document->error = NULL;
+	if(!preprocess_slice(source + begin, end - begin, &preprocessed, &preprocessed_size, &map)){
+		document->error = take_capture(document, start);
+		document->error_line = prefix + (map.source_line > 0 ? map.source_line : 1);
+		clear_lines(document);/*the lines no longer match the source*/
+	}
+	else if(!apply_edit(document, prefix, suffix, count, preprocessed, preprocessed_size, &map)){
+		clear_lines(document);
+		success = false;
+	}
+	document->rebuild = !success || document->error != NULL;
+	stop_capture(document);
+
+	free(preprocessed);
+	free_line_map(&map);
+	free(document->source);
+	free(document->source_starts);
+	document->source = copy;
+	document->source_length = length;
+	document->source_starts = starts;
+	document->source_count = count;
+	document->macro_lines = macro_lines;
+	return success;
+}
+
+/*
+* find_declaration
+* ----------------
+* this function finds the line that defines a label or the .extern line that declares it
+*
+* parameters:
+*   document: the document
+*   name: the name of the label
+*
+* returns:
+*   IncrementalLine*: the line or NULL if the document does not know the label
+*/
+IncrementalLine *find_declaration(IncrementalDocument *document, const char *name){
+	Symbol *symbol = find_symbol(document, name);
+	int i, j;
+
+	if(!symbol){
+		return NULL;
+	}
+	if(symbol->definition){
+		return symbol->definition;
+	}
+	for(i=0 ; i<document->count ; i++){
+		for(j=0 ; document->lines[i]->kind == LINE_EXTERN && j<document->lines[i]->target_count ; j++){
+			if(strcmp(document->lines[i]->targets[j].name, name) == 0){
+				return document->lines[i];
+			}
+		}
+	}
+	return NULL;
+}
+
+/*
+* visit_diagnostics
+* -----------------
+* this function hands every diagnostic of a document to a visitor in the order of the lines
+* besides the errors printed while the lines were sized and encoded it reports
+* labels defined more than once and the line where the program overflows the memory
+*
+* parameters:
+*   document: the document
+*   visit: the function that receives the source line and the messages of every diagnostic
+*   context: the value handed to the visitor
+*
+*/
+void visit_diagnostics(IncrementalDocument *document, diagnostic_visitor visit, void *context){
+	char message[MAX_LINE_LENGTH + 2*MAX_LABEL_LENGTH];
+	IncrementalLine *line;
+	Symbol *symbol;
+	int i;
+
+	if(document->error){
+		visit(context, document->error_line, document->error);
+	}
+	for(i=0 ; i<document->count ; i++){
+		line = document->lines[i];
+		if(line->error){
+			visit(context, line->source_line, line->error);
+		}
+		if(line->label[0] && (symbol = find_symbol(document, line->label)) != NULL && symbol->definition != line){
+			sprintf(message, "Error: Duplicate label '%s'", line->label);
+			visit(context, line->source_line, message);
+		}
+		if(i == document->overflow_line){
+			visit(context, line->source_line, "Error: RAM overflow");
+		}
+	}
+}
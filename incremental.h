@@ -0,0 +1,114 @@
+#ifndef INCREMENTAL_H
+#define INCREMENTAL_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "definitions.h"
+#include "first_pass.h"
+#include "second_pass.h"
+#include "preprocessor.h"
+#include "file_writer.h"
+
+#define INCREMENTAL_MAX_CODE_WORDS 3/*most code words a single operation is encoded into*/
+#define INCREMENTAL_EXTERN (-1L)/*value of a target that is an extern*/
+#define INCREMENTAL_UNDEFINED (-2L)/*value of a target that is not defined*/
+#define INITIAL_SYMBOL_BUCKETS 64/*initial number of buckets of the symbol table*/
+
+/*
+* incremental reassembly
+* ----------------------
+* a document keeps the source it was last updated with and one IncrementalLine for every preprocessed line
+* each line holds what the first pass learns from it (its size and the label it defines) and what the second pass
+* makes of it (its encoded words) so an edit only has to:
+*   1. find the source lines that changed and preprocess only them (the whole source when it defines macros)
+*   2. size the preprocessed lines that changed
+*   3. shift the addresses of the lines that follow them
+*   4. encode the changed lines and the lines whose label targets moved
+* the words of a line are the words the command line assembler writes for it at the default load address
+*/
+
+/*** STRUCTURE DEFINITIONS SECTION ***/
+
+typedef void (*diagnostic_visitor)(void *context,int line,const char *message);/*function that receives a diagnostic of a document (its 1 based source line and its messages)*/
+
+/*kind of a preprocessed line*/
+typedef enum line_kinds{
+	LINE_BLANK = 0,/*an empty line*/
+	LINE_LABEL = 1,/*a label alone on its line*/
+	LINE_CODE = 2,/*an operation*/
+	LINE_DATA = 3,/*a .data or .string directive*/
+	LINE_EXTERN = 4,/*an .extern directive*/
+	LINE_ENTRY = 5,/*an .entry directive*/
+	LINE_INVALID = 6/*a line the first pass rejects*/
+}line_kind;
+
+typedef struct{/*a label a line refers to (or declares on an .extern line)*/
+	char name[MAX_LABEL_LENGTH + 1];/*name of the label*/
+	long value;/*address the line was encoded with INCREMENTAL_EXTERN or INCREMENTAL_UNDEFINED*/
+}LineTarget;
+
+typedef struct{/*the intermediate representation of a single preprocessed line*/
+	char *text;/*the preprocessed line without its newline*/
+	int index;/*position of the line in the document*/
+	int source_line;/*1 based line of the source that produced it*/
+	line_kind kind;/*kind of the line*/
+	char label[MAX_LABEL_LENGTH + 1];/*label the line defines or an empty string*/
+	LineTarget *targets;/*labels the operands or the directive name*/
+	int target_count;/*number of targets*/
+	int size;/*amount the line adds to the address counter of the first pass*/
+	int code_size;/*number of code words*/
+	int data_size;/*number of data words*/
+	long address;/*address counter at the start of the line (the address of its label)*/
+	long code_offset;/*index of the first code word of the line in the code image*/
+	long data_offset;/*index of the first data word of the line in the data image*/
+	unsigned int *words;/*the code words followed by the data words of the line*/
+	char *error;/*the error messages of the line or NULL*/
+}IncrementalLine;
+
+typedef struct symbol{/*a label defined or declared external by the document*/
+	char name[MAX_LABEL_LENGTH + 1];/*name of the label*/
+	IncrementalLine *definition;/*first line that defines the label or NULL*/
+	int definitions;/*number of lines that define the label*/
+	int externs;/*number of names on .extern lines that declare it*/
+	struct symbol *next;/*next symbol of the same bucket*/
+}Symbol;
+
+typedef struct{/*a source kept assembled across edits*/
+	char *source;/*the source the document was last updated with*/
+	size_t source_length;/*length of the source*/
+	size_t *source_starts;/*offset of every source line*/
+	int source_count;/*number of source lines*/
+	int macro_lines;/*source lines that define macros*/
+	bool rebuild;/*true when the next update must preprocess the whole source*/
+	IncrementalLine **lines;/*the preprocessed lines*/
+	int count;/*number of lines*/
+	int capacity;/*capacity of the lines array*/
+	Symbol **buckets;/*the symbol table*/
+	int bucket_count;/*number of buckets (a power of two)*/
+	int symbol_count;/*number of symbols*/
+	long code_length;/*number of code words*/
+	long data_length;/*number of data words*/
+	int overflow_line;/*index of the line that overflows the memory or -1*/
+	char *error;/*error of the preprocessor or NULL*/
+	int error_line;/*1 based source line of the preprocessor error*/
+	int sized_lines;/*lines sized by the last update*/
+	int encoded_lines;/*lines encoded by the last update*/
+	ExternEntryArray externs;/*the externs handed to process_code*/
+	FILE *capture;/*stream collecting the error messages during an update*/
+	char *capture_buffer;/*contents of the capture stream*/
+	size_t capture_size;/*size of the capture stream*/
+	FILE *saved_messages;/*message stream of the thread before the update*/
+	FILE *saved_errors;/*error stream of the thread before the update*/
+}IncrementalDocument;
+
+/*** FUNCTION PROTOTYPES SECTION ***/
+
+bool initialize_incremental_document(IncrementalDocument *document);/*function to prepare an empty document*/
+void free_incremental_document(IncrementalDocument *document);/*function to free everything a document holds*/
+bool update_incremental_document(IncrementalDocument *document,const char *source,size_t length);/*function to bring a document up to date with a new version of its source*/
+Symbol *find_symbol(IncrementalDocument *document,const char *name);/*function to look up a label of a document*/
+IncrementalLine *find_declaration(IncrementalDocument *document,const char *name);/*function to find the line that defines a label or declares it external*/
+void visit_diagnostics(IncrementalDocument *document,diagnostic_visitor visit,void *context);/*function to hand every diagnostic of a document to a visitor*/
+
+#endif /*INCREMENTAL_H*/
@@ -0,0 +1,745 @@
+#include "libassembler.h"
+#include "chunked_pass.h"
+#include "stats.h"
+#include "source_map.h"
+#include "cost_report.h"
+
+/*** ASSEMBLY STATE SECTION ***/
+
+/*
+* create_assembly_state
+* ---------------------
+* this function allocates the images and tables of a single source on the heap
+* the state is too large for the stack of a worker thread so it is never declared as a local variable
+*
+* returns:
+*   AssemblyState*: the new state with empty images or NULL if memory allocation failed
+*/
+AssemblyState *create_assembly_state(void){
+	AssemblyState *state = (AssemblyState*)calloc(1, sizeof(AssemblyState));/*every code word pointer starts as NULL*/
+
+	if(!state){
+		return NULL;
+	}
+	if(!initialize_label_array(&state->label_array)){/*initialize the label array to store labels*/
+		free(state);
+		return NULL;
+	}
+	initialize_extern_entry_array(&state->ext_entry_array);/*initialize the extern entry array to store extern and entry entries*/
+	state->extern_printing_array = NULL;
+	state->IC = IC_INIT_VALUE;/*initialize the instruction counter (IC) with the initial value*/
+	state->DC = 0;/*initialize the data counter (DC) to 0*/
+	return state;
+}
+
+/*
+* free_assembly_state
+* -------------------
+* this function frees the state of a single source together with the words a sink did not write
+*
+* parameters:
+*   state: the state to free or NULL
+*
+*/
+void free_assembly_state(AssemblyState *state){
+	long i;
+
+	if(!state){
+		return;
+	}
+	for(i=0 ; i<state->IC-IC_INIT_VALUE ; i++){/*free the words the sink did not write*/
+		if(state->code_img[i]){
+			free_machine_word(state->code_img[i]);
+		}
+	}
+	free_label_array(&state->label_array);/*free the labels and their index*/
+	STATS_FREE(state->extern_printing_array);/*free the extern references*/
+	free(state);
+}
+
+/*** PIPELINE SECTION ***/
+
+/*
+* update_entry_lines
+* ------------------
+* this function updates the line numbers in the ExternEntryArray based on the LabelArray
+* it iterates through each entry and matches it with a corresponding label to set the correct line number
+* an entry that is also declared as extern is an error since the file can't both export and import the label
+* this function is crucial for resolving extern and entry references to the correct locations in the assembly process
+*
+* parameters:
+*   label_array: a pointer to the LabelArray containing all labels
+*   ext_entry_array: a pointer to the ExternEntryArray containing all extern and entry entries
+*
+* returns:
+*   bool: true if every entry was matched with a label false otherwise
+*/
+bool update_entry_lines(LabelArray *label_array, ExternEntryArray *ext_entry_array){
+	Label *label;
+	int i;
+	bool success = true;
+
+	/*iterate through each entry in the ExternEntryArray*/
+	for(i = 0; i < ext_entry_array->entry_count; i++) {
+		label = find_label(label_array, ext_entry_array->entries[i].name);/*look the label of the entry up*/
+		set_diagnostic_line(ext_entry_array->entries[i].source_line);/*the errors name the line of the .entry*/
+		if(find_extern(ext_entry_array, ext_entry_array->entries[i].name)) {/*an extern has no address in this file*/
+			report_error("Error: Entry label '%s' is also declared as extern\n", ext_entry_array->entries[i].name);
+			success = false;
+		}
+		else if(label) {
+			ext_entry_array->entries[i].line_number = label->line_number;/*update the line number of the entry*/
+		}
+		else {/*if no matching label is found print an error message and fail the file*/
+			report_error("Error: Entry label '%s' not found in label array\n", ext_entry_array->entries[i].name);
+			success = false;/*the file can't be assembled but the other entries are still checked*/
+		}
+	}
+	set_diagnostic_line(0);
+	return success;
+}
+
+/*
+* check_extern_labels
+* -------------------
+* this function checks that no label declared as extern is also defined in the file
+* the second pass would encode the operands of such a label as external and silently ignore the definition
+*
+* parameters:
+*   label_array: a pointer to the LabelArray containing all labels
+*   ext_entry_array: a pointer to the ExternEntryArray containing all extern and entry entries
+*
+* returns:
+*   bool: true if no extern is defined in the file false otherwise
+*/
+bool check_extern_labels(LabelArray *label_array, ExternEntryArray *ext_entry_array){
+	int i;
+	bool success = true;
+
+	for(i = 0; i < ext_entry_array->extern_count; i++) {
+		if(find_label(label_array, ext_entry_array->externs[i].name)) {
+			set_diagnostic_line(ext_entry_array->externs[i].source_line);/*the error names the line of the .extern*/
+			report_error("Error: Extern label '%s' is also defined in the file\n", ext_entry_array->externs[i].name);
+			success = false;/*the other externs are still checked*/
+		}
+	}
+	set_diagnostic_line(0);
+	return success;
+}
+
+/*
+* preprocess_source
+* -----------------
+* this function expands the macros of a single assembly source into memory
+* the preprocessed source is what both passes read and what the output cache hashes
+*
+* parameters:
+*   name: the name of the source used in the error messages
+*   source: the stream holding the assembly source
+*   size: a pointer that receives the length of the preprocessed source
+*   map: a map prepared by initialize_line_map that receives the source line of every preprocessed line or NULL
+*
+* returns:
+*   char*: the preprocessed source (freed by the caller) or NULL if preprocessing failed
+*/
+char *preprocess_source(const char *name, FILE *source, size_t *size, LineMap *map){
+	char *preprocessed = NULL;/*buffer holding the preprocessed source*/
+	FILE *preprocessed_file;/*stream that writes the preprocessed source*/
+	bool success;
+
+	*size = 0;
+	preprocessed_file = open_memstream(&preprocessed, size);
+	if(!preprocessed_file){
+		print_system_error("Error: couldn't allocate the preprocessed source");
+		return NULL;
+	}
+	STATS_ENTER(PHASE_PREPROCESS);
+	success = preprocess_stream_mapped(source, preprocessed_file, map);/*expand the macros of the input file*/
+	fclose(preprocessed_file);/*close the stream so the buffer holds the whole preprocessed source*/
+	STATS_LEAVE();
+	if(!success){/*check if preprocessing failed*/
+		fprintf(error_output(), "Error: preprocessing failed for file %s.as\n", name);
+		free(preprocessed);
+		return NULL;
+	}
+	return preprocessed;
+}
+
+/*
+* assemble_source
+* ---------------
+* this function runs the preprocessor the first pass and the second pass over a single assembly source
+* the preprocessed source is kept in memory between the passes so nothing is read or written on disk
+* the sink and the state are used like in assemble_preprocessed
+*
+* parameters:
+*   name: the name of the source used in the error messages
+*   source: the stream holding the assembly source
+*   options: the options that select the load address and the relocation table
+*   sink: a sink prepared by initialize_object_sink or NULL to keep the images in the state
+*   state: a state made by create_assembly_state that receives the images and tables
+*
+* returns:
+*   bool: true if the source was assembled false otherwise
+*/
+bool assemble_source(const char *name, FILE *source, const AssemblerOptions *options, ObjectSink *sink, AssemblyState *state){
+	char *preprocessed;/*buffer holding the preprocessed source*/
+	size_t preprocessed_size;/*size of the preprocessed source*/
+	LineMap map;/*source line of every preprocessed line for the error messages*/
+	bool success;
+
+	initialize_line_map(&map, false);
+	preprocessed = preprocess_source(name, source, &preprocessed_size, &map);
+	if(!preprocessed){
+		free_line_map(&map);
+		if(sink){
+			abort_object_sink(sink);
+		}
+		return false;
+	}
+	state->line_map = &map;
+	success = assemble_preprocessed(name, preprocessed, preprocessed_size, options, sink, state);
+	state->line_map = NULL;/*the map does not outlive this call*/
+	free_line_map(&map);
+	free(preprocessed);/*free the preprocessed source*/
+	return success;
+}
+
+/*
+* assemble_preprocessed
+* ---------------------
+* this function runs the first pass and the second pass over a preprocessed source held in memory
+* when a sink is given the text outputs are streamed into it while the second pass encodes and it is committed on success and aborted on failure
+* without a sink the whole code image is kept in the state for the caller
+* with --chunked and -j the source is first tried on several threads by assemble_chunked
+*
+* parameters:
+*   name: the name of the source used in the error messages
+*   preprocessed: the preprocessed source
+*   size: the length of the preprocessed source
+*   options: the options that select the load address and the relocation table
+*   sink: a sink prepared by initialize_object_sink or NULL to keep the images in the state
+*   state: a state made by create_assembly_state that receives the images and tables
+*
+* returns:
+*   bool: true if the source was assembled false otherwise
+*/
+bool assemble_preprocessed(const char *name, const char *preprocessed, size_t size, const AssemblerOptions *options, ObjectSink *sink, AssemblyState *state){
+	FILE *preprocessed_file;/*stream over the preprocessed source*/
+	bool success;/*declare a boolean variable to store the success status of operations*/
+	DiagnosticCounter counter;/*the errors of the file*/
+	bool entries_found;/*false when an .entry names a label the file does not define or an extern is defined*/
+	chunked_result chunked;/*outcome of the chunked passes*/
+
+	chunked = assemble_chunked(name, preprocessed, size, options, sink, state);
+	if(chunked != CHUNKED_SEQUENTIAL){
+		return chunked == CHUNKED_ASSEMBLED;
+	}
+	preprocessed_file = open_buffer(preprocessed, size);/*both passes read the preprocessed source from memory*/
+	if(!preprocessed_file){
+		print_system_error("Error: couldn't read the preprocessed source");
+		if(sink){
+			abort_object_sink(sink);
+		}
+		return false;
+	}
+
+	/*first pass*/
+	start_diagnostics(&counter, options->max_errors);/*the passes go on after an error until the limit*/
+	if(state->line_map){/*name the lines of the source rather than of the expanded source*/
+		counter.source_lines = state->line_map->lines;
+		counter.source_line_count = state->line_map->count;
+	}
+	STATS_ENTER(PHASE_FIRST_PASS);
+	success = first_pass_stream(preprocessed_file, &state->label_array, &state->ext_entry_array, &state->code_length, &state->data_length) != NULL;/*perform the first pass*/
+	STATS_LEAVE();
+	if(!success){/*check if the first pass failed*/
+		fprintf(error_output(), "error: first pass failed for file %s.am\n", name);
+	}
+
+	/*check that the program fits in memory at its load address*/
+	if(success && options->load_base + state->code_length + state->data_length > CODE_ARR_IMG_LENGTH){
+		fprintf(error_output(), "error: program does not fit in memory at base address %ld for file %s\n", options->load_base, name);
+		success = false;
+	}
+
+	/*update entry lines*/
+	entries_found = true;
+	STATS_ENTER(PHASE_ENTRIES);
+	if(success) { /*an entry without any label in the file is an error too*/
+		entries_found = check_extern_labels(&state->label_array, &state->ext_entry_array);
+		entries_found = update_entry_lines(&state->label_array, &state->ext_entry_array) && entries_found;/*update the entry lines with correct label references*/
+	}
+	STATS_LEAVE();
+
+	/*second pass*/
+	rewind(preprocessed_file);/*the second pass reads the preprocessed source again*/
+	STATS_ENTER(PHASE_SECOND_PASS);
+	if(success && !entries_found){/*encode without outputs only to report the errors of the second pass too*/
+		second_pass_stream(preprocessed_file, &state->label_array, &state->ext_entry_array, state->code_img, state->data_img, &state->IC, &state->DC, &state->extern_printing_array, NULL);
+		fprintf(error_output(), "error: second pass failed for file %s.am\n", name);
+		success = false;
+		if(sink){
+			abort_object_sink(sink);/*nothing was written yet*/
+		}
+	}
+	else if(success && sink){/*the text files are streamed while the second pass encodes*/
+		STATS_ENTER(PHASE_WRITE);
+		success = open_object_sink(sink, state->code_length, state->data_length, options->load_base, options->write_relocations) && sink_entries(sink, &state->ext_entry_array)
+			&& (!options->write_map || sink_source_map(sink, name, preprocessed, size, options->load_base, state->code_length))
+			&& sink_cost_report(sink, name, preprocessed, size, options);/*write the .ob header the .ent file the .map file and the reports*/
+		STATS_LEAVE();
+		success = success && second_pass_stream(preprocessed_file, &state->label_array, &state->ext_entry_array, state->code_img, state->data_img, &state->IC, &state->DC, &state->extern_printing_array, sink);/*perform the second pass streaming every instruction*/
+		STATS_ENTER(PHASE_WRITE);
+		success = success ? close_object_sink(sink, state->data_img, state->DC) : (abort_object_sink(sink), false);/*append the data image or remove the partial output*/
+		STATS_LEAVE();
+		if(!success) { /*check if the second pass failed*/
+			fprintf(error_output(), "error: second pass failed for file %s.am\n", name);/*print an error message*/
+		}
+	}
+	else if(success){/*keep the whole image for the caller*/
+		success = second_pass_stream(preprocessed_file, &state->label_array, &state->ext_entry_array, state->code_img, state->data_img, &state->IC, &state->DC, &state->extern_printing_array, NULL);/*perform the second pass*/
+		if(!success) { /*check if the second pass failed*/
+			fprintf(error_output(), "error: second pass failed for file %s.am\n", name);/*print an error message*/
+		}
+	}
+	else{
+		if(!error_limit_reached()){/*report the undefined labels of the lines the first pass read too*/
+			check_references_stream(preprocessed_file, &state->label_array, &state->ext_entry_array);
+		}
+		if(sink){
+			abort_object_sink(sink);/*nothing was written yet*/
+		}
+	}
+	STATS_LEAVE();
+	if(success){
+		STATS_TABLES(&state->label_array, &state->ext_entry_array, state->extern_printing_array, state->code_length, state->data_length);
+	}
+
+	if(error_limit_reached()){
+		fprintf(error_output(), "error: stopped after %d errors in file %s\n", counter.errors, name);
+	}
+	stop_diagnostics();
+	fclose(preprocessed_file);/*close the stream over the preprocessed source*/
+	return success;
+}
+
+/*
+* process_file
+* ------------
+* this function processes a single assembly source through preprocessing, first pass, and second pass
+* the preprocessed source is kept in memory between the passes so no .am file is written
+* the output files are written through the sink which is committed on success and aborted on failure
+* this function is the main driver for processing each file and is called for each input file in the main function
+* 
+* parameters:
+*   basename: the base name of the file to be processed (without extension)
+*   source: the stream holding the assembly source
+*   sink: a sink prepared by initialize_object_sink that receives the output files
+*   options: the command line options that select the output format
+* 
+* returns:
+*   bool: true if the file was assembled and its outputs were written false otherwise
+*/
+bool process_file(const char *basename, FILE *source, ObjectSink *sink, const AssemblerOptions *options) {
+	char *preprocessed;/*buffer holding the preprocessed source*/
+	size_t preprocessed_size;/*size of the preprocessed source*/
+	LineMap map;/*source line of every preprocessed line for the error messages and the .map file*/
+	bool success;
+
+	initialize_line_map(&map, options->write_map);
+	preprocessed = preprocess_source(basename, source, &preprocessed_size, &map);
+	if(!preprocessed){
+		free_line_map(&map);
+		abort_object_sink(sink);
+		return false;
+	}
+	sink->line_map = &map;
+	success = process_preprocessed(basename, preprocessed, preprocessed_size, sink, options);
+	sink->line_map = NULL;/*the map does not outlive this call*/
+	free_line_map(&map);
+	free(preprocessed);/*free the preprocessed source*/
+	return success;
+}
+
+/*
+* process_preprocessed
+* --------------------
+* this function assembles a preprocessed source and writes its outputs through the sink in the selected format
+* 
+* parameters:
+*   basename: the base name of the file to be processed (without extension)
+*   preprocessed: the preprocessed source
+*   size: the length of the preprocessed source
+*   sink: a sink prepared by initialize_object_sink that receives the output files
+*   options: the command line options that select the output format
+* 
+* returns:
+*   bool: true if the file was assembled and its outputs were written false otherwise
+*/
+bool process_preprocessed(const char *basename, const char *preprocessed, size_t size, ObjectSink *sink, const AssemblerOptions *options) {
+	AssemblyState *state;/*the images and tables of the file*/
+	bool success;/*declare a boolean variable to store the success status of operations*/
+	RelocationArray relocations;/*declare a RelocationArray to store the indices of the relocatable words*/
+	FILE *file;/*declare a file pointer for the binary object*/
+
+	state = create_assembly_state();
+	if(!state){
+		fprintf(error_output(), "Error: memory allocation failed for file %s\n", basename);
+		abort_object_sink(sink);
+		return false;
+	}
+	state->line_map = sink->line_map;
+	if(options->format == TEXT_OBJECT){/*the text files are streamed while the second pass encodes*/
+		success = assemble_preprocessed(basename, preprocessed, size, options, sink, state);
+	}
+	else{/*the binary object needs the whole image to place its tables*/
+		success = assemble_preprocessed(basename, preprocessed, size, options, NULL, state);
+		if(success){
+			/*collect the relocatable words and move the program to its load address*/
+			initialize_relocation_array(&relocations);/*initialize the relocation array*/
+			success = build_relocation_table(state->code_img, state->IC, &relocations);/*collect the words that hold internal addresses*/
+			if(success && options->load_base != IC_INIT_VALUE){/*check if the program is loaded at another address*/
+				relocate_program(state->code_img, &relocations, &state->ext_entry_array, state->extern_printing_array, options->load_base - IC_INIT_VALUE);/*move only the relocated words*/
+			}
+			STATS_ENTER(PHASE_WRITE);
+			file = success ? open_sink_output(sink, SINK_OBB) : NULL;/*open the binary object file (.obb)*/
+			if(file){
+				write_object_binary(file, state->code_img, state->data_img, state->IC, state->DC, &state->ext_entry_array, state->extern_printing_array, &relocations, options->load_base);/*write the code data entries externs and relocations*/
+				success = (!options->write_map || sink_source_map(sink, basename, preprocessed, size, options->load_base, state->code_length)) && sink_cost_report(sink, basename, preprocessed, size, options) ?
+					commit_object_sink(sink) : (abort_object_sink(sink), false);
+			}
+			else{
+				abort_object_sink(sink);
+				success = false;
+			}
+			STATS_LEAVE();
+			free_relocation_array(&relocations);/*free the relocation table*/
+		}
+		else{
+			abort_object_sink(sink);/*nothing was written yet*/
+		}
+	}
+
+	free_assembly_state(state);/*free the words the sink did not write and the tables*/
+	if(success){
+		fprintf(message_output(), "Assembler succeeded for file %s\n",basename);
+	}
+	return success;
+}
+
+/*** CHECK SECTION ***/
+
+/*
+* check_preprocessed
+* ------------------
+* this function checks a preprocessed source without assembling it
+* the first pass sizes the program and collects its labels and the entries and every operand label is resolved
+* so the source gets the errors the full pipeline would report but no machine word is encoded and nothing is written
+*
+* parameters:
+*   basename: the base name of the file to be checked (without extension)
+*   preprocessed: the preprocessed source
+*   size: the length of the preprocessed source
+*   map: the source line of every preprocessed line the errors are reported on or NULL
+*   options: the command line options that select the load address and the error limit
+*
+* returns:
+*   bool: true if the source would be assembled false otherwise
+*/
+bool check_preprocessed(const char *basename, const char *preprocessed, size_t size, const LineMap *map, const AssemblerOptions *options){
+	FILE *preprocessed_file;/*stream over the preprocessed source*/
+	AssemblyState *state;/*the tables of the file (its images are never filled)*/
+	DiagnosticCounter counter;/*the errors of the file*/
+	bool success, entries_found = true;
+
+	state = create_assembly_state();
+	preprocessed_file = state ? open_buffer(preprocessed, size) : NULL;
+	if(!preprocessed_file){
+		fprintf(error_output(), "Error: memory allocation failed for file %s\n", basename);
+		free_assembly_state(state);
+		return false;
+	}
+
+	start_diagnostics(&counter, options->max_errors);
+	if(map){
+		counter.source_lines = map->lines;
+		counter.source_line_count = map->count;
+	}
+	STATS_ENTER(PHASE_FIRST_PASS);
+	success = first_pass_stream(preprocessed_file, &state->label_array, &state->ext_entry_array, &state->code_length, &state->data_length) != NULL;
+	STATS_LEAVE();
+	if(!success){
+		fprintf(error_output(), "error: first pass failed for file %s.am\n", basename);
+	}
+	if(success && options->load_base + state->code_length + state->data_length > CODE_ARR_IMG_LENGTH){
+		fprintf(error_output(), "error: program does not fit in memory at base address %ld for file %s\n", options->load_base, basename);
+		success = false;
+	}
+	STATS_ENTER(PHASE_ENTRIES);
+	if(success){/*every entry must name a label of the file and no extern may be defined in it*/
+		entries_found = check_extern_labels(&state->label_array, &state->ext_entry_array);
+		entries_found = update_entry_lines(&state->label_array, &state->ext_entry_array) && entries_found;
+	}
+	STATS_LEAVE();
+	if(success){
+		rewind(preprocessed_file);
+		STATS_ENTER(PHASE_SECOND_PASS);
+		success = check_pass_stream(preprocessed_file, &state->label_array, &state->ext_entry_array) && entries_found;/*resolve every operand label*/
+		STATS_LEAVE();
+		if(!success){
+			fprintf(error_output(), "error: second pass failed for file %s.am\n", basename);
+		}
+	}
+	else if(!error_limit_reached()){/*report the undefined labels of the lines the first pass read too*/
+		rewind(preprocessed_file);
+		check_references_stream(preprocessed_file, &state->label_array, &state->ext_entry_array);
+	}
+	if(error_limit_reached()){
+		fprintf(error_output(), "error: stopped after %d errors in file %s\n", counter.errors, basename);
+	}
+	stop_diagnostics();
+	fclose(preprocessed_file);
+	if(success){
+		STATS_TABLES(&state->label_array, &state->ext_entry_array, NULL, state->code_length, state->data_length);
+	}
+	free_assembly_state(state);
+	if(success){
+		fprintf(message_output(), "Check succeeded for file %s\n", basename);
+	}
+	return success;
+}
+
+/*
+* check_file
+* ----------
+* this function preprocesses a single assembly source in memory and checks it with check_preprocessed
+*
+* parameters:
+*   basename: the base name of the file to be checked (without extension)
+*   source: the stream holding the assembly source
+*   options: the command line options
+*
+* returns:
+*   bool: true if the source would be assembled false otherwise
+*/
+bool check_file(const char *basename, FILE *source, const AssemblerOptions *options){
+	char *preprocessed;/*buffer holding the preprocessed source*/
+	size_t preprocessed_size;/*size of the preprocessed source*/
+	LineMap map;/*source line of every preprocessed line for the error messages*/
+	bool success;
+
+	initialize_line_map(&map, false);
+	preprocessed = preprocess_source(basename, source, &preprocessed_size, &map);
+	if(!preprocessed){
+		free_line_map(&map);
+		return false;
+	}
+	success = check_preprocessed(basename, preprocessed, preprocessed_size, &map, options);
+	free_line_map(&map);
+	free(preprocessed);
+	return success;
+}
+
+/*** IN MEMORY ASSEMBLY SECTION ***/
+
+/*
+* initialize_assembly_result
+* --------------------------
+* this function prepares an empty result for assemble_buffer
+* a result can be passed to assemble_buffer any number of times and its arena is reused every time
+*
+* parameters:
+*   result: a pointer to the result to be initialized
+*
+*/
+void initialize_assembly_result(AssemblyResult *result){
+	memset(result, 0, sizeof(AssemblyResult));
+	initialize_arena(&result->arena);
+}
+
+/*
+* free_assembly_result
+* --------------------
+* this function frees every array and string a result holds and leaves it empty
+*
+* parameters:
+*   result: a pointer to the result
+*
+*/
+void free_assembly_result(AssemblyResult *result){
+	free_arena(&result->arena);
+	initialize_assembly_result(result);
+}
+
+/*
+* collect_diagnostics
+* -------------------
+* this function copies the diagnostics recorded while a source was assembled into the arena of the result
+*
+* parameters:
+*   name: the name of the source the diagnostics are about
+*   list: the diagnostics recorded by report_error and report_warning
+*   result: the result that receives the diagnostics
+*
+* returns:
+*   bool: true if the diagnostics were collected false if memory allocation failed
+*/
+bool collect_diagnostics(const char *name, const DiagnosticList *list, AssemblyResult *result){
+	const char *file;/*the name every diagnostic shares*/
+	int i;
+
+	if(list->count == 0){
+		return !list->failed;
+	}
+	file = arena_copy_string(&result->arena, name);
+	result->diagnostics = (AssemblyDiagnostic*)arena_allocate(&result->arena, list->count * sizeof(AssemblyDiagnostic));
+	if(!file || !result->diagnostics){
+		return false;
+	}
+	for(i=0 ; i<list->count ; i++){
+		result->diagnostics[i].severity = list->records[i].severity;
+		result->diagnostics[i].file = file;
+		result->diagnostics[i].line = list->records[i].line;
+		result->diagnostics[i].column = list->records[i].column;
+		result->diagnostics[i].message = arena_copy_string(&result->arena, list->records[i].message);
+		if(!result->diagnostics[i].message){
+			return false;
+		}
+		result->diagnostic_count++;
+	}
+	return !list->failed;
+}
+
+/*
+* collect_images
+* --------------
+* this function copies the images and tables of an assembled source into the arena of the result
+* the code image is moved to the load address through its relocation table like the binary object
+*
+* parameters:
+*   state: the state filled by assemble_source without a sink
+*   load_base: the address of the first code word
+*   result: the result that receives the images and tables
+*
+* returns:
+*   bool: true if everything was copied false if memory allocation failed
+*/
+bool collect_images(AssemblyState *state, long load_base, AssemblyResult *result){
+	RelocationArray relocations;/*indices of the relocatable words*/
+	bool success;
+	long i;
+	int j;
+
+	initialize_relocation_array(&relocations);
+	success = build_relocation_table(state->code_img, state->IC, &relocations);/*collect the words that hold internal addresses*/
+	if(success && load_base != IC_INIT_VALUE){/*check if the program is loaded at another address*/
+		relocate_program(state->code_img, &relocations, &state->ext_entry_array, state->extern_printing_array, load_base - IC_INIT_VALUE);/*move only the relocated words*/
+	}
+
+	/*count the extern references*/
+	for(j=0 ; state->extern_printing_array != NULL && state->extern_printing_array[j].name[0] != '\0' ; j++);
+	result->extern_count = j;
+	result->entry_count = state->ext_entry_array.entry_count;
+	result->code_length = state->IC - IC_INIT_VALUE;
+	result->data_length = state->DC;
+	result->relocation_count = success ? relocations.count : 0;
+
+	/*allocate every array of the result at once*/
+	result->code = (unsigned short*)arena_allocate(&result->arena, (result->code_length + 1) * sizeof(unsigned short));
+	result->data = (unsigned short*)arena_allocate(&result->arena, (result->data_length + 1) * sizeof(unsigned short));
+	result->entries = (AssemblySymbol*)arena_allocate(&result->arena, (result->entry_count + 1) * sizeof(AssemblySymbol));
+	result->externs = (AssemblySymbol*)arena_allocate(&result->arena, (result->extern_count + 1) * sizeof(AssemblySymbol));
+	result->relocations = (long*)arena_allocate(&result->arena, (result->relocation_count + 1) * sizeof(long));
+	success = success && result->code && result->data && result->entries && result->externs && result->relocations;
+
+	for(i=0 ; success && i<result->code_length ; i++){
+		result->code[i] = (unsigned short)convert_machine_word_to_binary(state->code_img[i]);
+	}
+	for(i=0 ; success && i<result->data_length ; i++){
+		result->data[i] = (unsigned short)handle_data_value(state->data_img[i]);
+	}
+	for(j=0 ; success && j<result->entry_count ; j++){/*list the entries in reverse order like the .ent file*/
+		result->entries[j].name = arena_copy_string(&result->arena, state->ext_entry_array.entries[result->entry_count - 1 - j].name);
+		result->entries[j].address = state->ext_entry_array.entries[result->entry_count - 1 - j].line_number;
+		success = result->entries[j].name != NULL;
+	}
+	for(j=0 ; success && j<result->extern_count ; j++){
+		result->externs[j].name = arena_copy_string(&result->arena, state->extern_printing_array[j].name);
+		result->externs[j].address = state->extern_printing_array[j].line_number;
+		success = result->externs[j].name != NULL;
+	}
+	for(j=0 ; success && j<result->relocation_count ; j++){
+		result->relocations[j] = relocations.indices[j];
+	}
+	free_relocation_array(&relocations);
+	return success;
+}
+
+/*
+* assemble_buffer
+* ---------------
+* this function assembles a source held in memory without touching the filesystem or the process state
+* it can be called from any number of threads at once and any number of times with the same result
+* the images tables and diagnostics are stored in the arena of the result and stay valid until the next call or free_assembly_result
+* the errors and warnings the passes report are recorded as diagnostics with their line and column instead of being printed
+*
+* parameters:
+*   name: the name of the source used in the diagnostics
+*   source: the assembly source
+*   length: the length of the source
+*   options: the options that select the load address (the output format options are ignored)
+*   result: a result prepared by initialize_assembly_result
+*
+* returns:
+*   bool: true if the source was assembled false otherwise (result->diagnostics says why)
+*/
+bool assemble_buffer(const char *name, const char *source, size_t length, const AssemblerOptions *options, AssemblyResult *result){
+	FILE *source_file, *discard_file;/*streams over the source and the printed messages*/
+	FILE *messages = message_output(), *errors = error_output();/*the streams of the caller*/
+	char *discarded = NULL;/*the printed messages which the records replace*/
+	size_t discarded_size = 0;/*length of the printed messages*/
+	DiagnosticList list;/*the errors and warnings of the source*/
+	AssemblyState *state;
+	bool success;
+
+	/*start from an empty result reusing its arena*/
+	reset_arena(&result->arena);
+	memset(result, 0, (char*)&result->arena - (char*)result);
+	result->load_base = options->load_base;
+
+	discard_file = open_memstream(&discarded, &discarded_size);
+	if(!discard_file){
+		return false;
+	}
+	redirect_output(discard_file, discard_file);/*nothing is printed for the caller*/
+	start_recording(&list, source, length);
+
+	source_file = open_buffer(source, length);/*the passes read the source straight from the buffer of the caller*/
+	state = source_file ? create_assembly_state() : NULL;
+	if(!state){
+		print_system_error("Error: couldn't prepare the source");
+	}
+	success = state && assemble_source(name, source_file, options, NULL, state);
+	if(success){
+		success = collect_images(state, options->load_base, result);
+		if(!success){
+			report_error("Error: couldn't allocate the result of file %s\n", name);
+		}
+	}
+	free_assembly_state(state);
+	if(source_file){
+		fclose(source_file);
+	}
+
+	stop_recording();
+	redirect_output(messages, errors);/*give the caller its streams back*/
+	fclose(discard_file);
+	free(discarded);
+	if(!collect_diagnostics(name, &list, result)){
+		success = false;
+	}
+	free_diagnostic_list(&list);
+	result->success = success;
+	return success;
+}
@@ -0,0 +1,80 @@
+#ifndef LIBASSEMBLER_H
+#define LIBASSEMBLER_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "definitions.h"
+#include "preprocessor.h"
+#include "first_pass.h"
+#include "second_pass.h"
+#include "file_writer.h"
+#include "options.h"
+#include "diagnostics.h"
+#include "arena.h"
+
+/*** STRUCTURE DEFINITIONS SECTION ***/
+
+typedef struct{/*a single error or warning found while a source was assembled*/
+	diagnostic_severity severity;/*severity of the message*/
+	const char *file;/*name of the source the message is about*/
+	int line;/*1 based line of the source or 0 when the message is not about a line*/
+	int column;/*1 based column of the name the message quotes or 0 when it is not found in the line*/
+	const char *message;/*text of the message without the line and the trailing newline*/
+}AssemblyDiagnostic;
+
+typedef struct{/*an entry or an extern reference of an assembled program*/
+	const char *name;/*name of the label*/
+	long address;/*address of the entry or of the word that references the extern*/
+}AssemblySymbol;
+
+typedef struct{/*everything assemble_buffer produces for a single source all owned by the arena*/
+	bool success;/*true if the source was assembled*/
+	long load_base;/*address of the first code word*/
+	unsigned short *code;/*the code image one 15-bit word per element*/
+	long code_length;/*number of words in the code image*/
+	unsigned short *data;/*the data image one 15-bit word per element*/
+	long data_length;/*number of words in the data image*/
+	AssemblySymbol *entries;/*the entries in the order the .ent file lists them*/
+	int entry_count;/*number of entries*/
+	AssemblySymbol *externs;/*the extern references in the order the .ext file lists them*/
+	int extern_count;/*number of extern references*/
+	long *relocations;/*code image indices of the words that hold an internal address*/
+	int relocation_count;/*number of relocated words*/
+	AssemblyDiagnostic *diagnostics;/*the errors and warnings in the order they were found*/
+	int diagnostic_count;/*number of diagnostics*/
+	Arena arena;/*memory that holds every array and string of the result*/
+}AssemblyResult;
+
+typedef struct{/*the images and tables of a single source while it is assembled*/
+	LabelArray label_array;/*the labels found by the first pass*/
+	ExternEntryArray ext_entry_array;/*the extern and entry directives*/
+	ExternEntry *extern_printing_array;/*the extern references found by the second pass*/
+	MachineWordsArray *code_img[CODE_ARR_IMG_LENGTH];/*the code image*/
+	long data_img[CODE_ARR_IMG_LENGTH];/*the data image*/
+	long IC;/*the instruction counter*/
+	long DC;/*the data counter*/
+	long code_length;/*number of code words found by the first pass*/
+	long data_length;/*number of data words found by the first pass*/
+	const LineMap *line_map;/*source line of every preprocessed line the errors are reported on or NULL*/
+}AssemblyState;
+
+/*** FUNCTION PROTOTYPES SECTION ***/
+
+AssemblyState *create_assembly_state(void);/*function to allocate the state of a single source*/
+void free_assembly_state(AssemblyState *state);/*function to free the state of a single source and every word left in it*/
+bool update_entry_lines(LabelArray *label_array,ExternEntryArray *ext_entry_array);/*function to give every entry the address of its label*/
+bool check_extern_labels(LabelArray *label_array,ExternEntryArray *ext_entry_array);/*function to check that no extern is defined in the file*/
+char *preprocess_source(const char *name,FILE *source,size_t *size,LineMap *map);/*function to expand the macros of a source into memory*/
+bool assemble_source(const char *name,FILE *source,const AssemblerOptions *options,ObjectSink *sink,AssemblyState *state);/*function to run the preprocessor and both passes over a stream*/
+bool assemble_preprocessed(const char *name,const char *preprocessed,size_t size,const AssemblerOptions *options,ObjectSink *sink,AssemblyState *state);/*function to run both passes over a preprocessed source*/
+bool process_file(const char *basename,FILE *source,ObjectSink *sink,const AssemblerOptions *options);/*function to assemble a stream and write its outputs through a sink*/
+bool process_preprocessed(const char *basename,const char *preprocessed,size_t size,ObjectSink *sink,const AssemblerOptions *options);/*function to assemble a preprocessed source and write its outputs through a sink*/
+bool check_preprocessed(const char *basename,const char *preprocessed,size_t size,const LineMap *map,const AssemblerOptions *options);/*function to check a preprocessed source without encoding or writing it*/
+bool check_file(const char *basename,FILE *source,const AssemblerOptions *options);/*function to check a stream without encoding or writing it*/
+
+void initialize_assembly_result(AssemblyResult *result);/*function to prepare an empty result*/
+bool assemble_buffer(const char *name,const char *source,size_t length,const AssemblerOptions *options,AssemblyResult *result);/*function to assemble a source held in memory*/
+void free_assembly_result(AssemblyResult *result);/*function to free everything a result holds*/
+
+#endif /*LIBASSEMBLER_H*/
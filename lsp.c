@@ -0,0 +1,827 @@
+#include "lsp.h"
+#include "diagnostics.h"
+#include "watch.h"
+#include <time.h>
+
+/*** JSON SECTION ***/
+
+/*
+* json_skip_space
+* ---------------
+* this function skips the whitespace before a JSON token
+*
+* parameters:
+*   text: the position in the JSON text
+*
+* returns:
+*   const char*: the first character that is not whitespace
+*/
+const char *json_skip_space(const char *text){
+	while(*text == ' ' || *text == '\t' || *text == '\r' || *text == '\n'){
+		text++;
+	}
+	return text;
+}
+
+/*
+* json_skip_value
+* ---------------
+* this function skips a whole JSON value (a string a number a literal an object or an array)
+*
+* parameters:
+*   text: the position of the value
+*
+* returns:
+*   const char*: the position after the value or NULL if the value is malformed
+*/
+const char *json_skip_value(const char *text){
+	const char *start;
+	char close;
+
+	text = json_skip_space(text);
+	if(*text == '"'){
+		for(text++ ; *text && *text != '"' ; text++){
+			if(*text == '\\' && text[1]){/*skip the escaped character*/
+				text++;
+			}
+		}
+		return *text ? text + 1 : NULL;
+	}
+	if(*text == '{' || *text == '['){
+		close = *text == '{' ? '}' : ']';
+		text = json_skip_space(text + 1);
+		if(*text == close){
+			return text + 1;
+		}
+		for(;;){
+			if(close == '}'){/*an object member starts with its name*/
+				text = json_skip_value(text);
+				if(!text || *(text = json_skip_space(text)) != ':'){
+					return NULL;
+				}
+				text++;
+			}
+			text = json_skip_value(text);
+			if(!text){
+				return NULL;
+			}
+			text = json_skip_space(text);
+			if(*text == close){
+				return text + 1;
+			}
+			if(*text != ','){
+				return NULL;
+			}
+			text++;
+		}
+	}
+	for(start = text ; *text && strchr(",:}] \t\r\n", *text) == NULL ; text++);/*a number or a literal*/
+	return text > start ? text : NULL;
+}
+
+/*
+* json_member
+* -----------
+* this function finds the value of a member of a JSON object
+*
+* parameters:
+*   object: the position of the object
+*   name: the name of the member (without escapes)
+*
+* returns:
+*   const char*: the position of the value or NULL if the object has no such member
+*/
+const char *json_member(const char *object, const char *name){
+	const char *text, *end, *value;
+	size_t length = strlen(name);
+
+	if(!object || *(text = json_skip_space(object)) != '{'){
+		return NULL;
+	}
+	text = json_skip_space(text + 1);
+	while(*text == '"'){
+		end = json_skip_value(text);
+		if(!end || *(end = json_skip_space(end)) != ':'){
+			return NULL;
+		}
+		value = json_skip_space(end + 1);
+		if(end - text - 2 == (long)length && strncmp(text + 1, name, length) == 0){
+			return value;
+		}
+		text = json_skip_value(value);
+		if(!text || *(text = json_skip_space(text)) != ','){
+			return NULL;
+		}
+		text = json_skip_space(text + 1);
+	}
+	return NULL;
+}
+
+/*
+* json_path
+* ---------
+* this function follows a dotted path of member names through nested JSON objects
+*
+* parameters:
+*   object: the position of the outer object
+*   path: the member names separated by dots (for example "params.textDocument.uri")
+*
+* returns:
+*   const char*: the position of the value or NULL if a member is missing
+*/
+const char *json_path(const char *object, const char *path){
+	char name[LSP_HEADER_LENGTH];
+	const char *dot;
+	size_t length;
+
+	while(object && *path){
+		dot = strchr(path, '.');
+		length = dot ? (size_t)(dot - path) : strlen(path);
+		if(length >= sizeof(name)){
+			return NULL;
+		}
+		memcpy(name, path, length);
+		name[length] = '\0';
+		object = json_member(object, name);
+		path += length + (dot != NULL);
+	}
+	return object;
+}
+
+/*
+* json_element
+* ------------
+* this function finds an element of a JSON array
+*
+* parameters:
+*   array: the position of the array
+*   index: the 0 based index of the element
+*
+* returns:
+*   const char*: the position of the element or NULL if the array is shorter
+*/
+const char *json_element(const char *array, int index){
+	const char *text;
+
+	if(!array || *(text = json_skip_space(array)) != '['){
+		return NULL;
+	}
+	text = json_skip_space(text + 1);
+	if(*text == ']'){
+		return NULL;
+	}
+	for( ; index > 0 ; index--){
+		text = json_skip_value(text);
+		if(!text || *(text = json_skip_space(text)) != ','){
+			return NULL;
+		}
+		text = json_skip_space(text + 1);
+	}
+	return text;
+}
+
+/*
+* json_string
+* -----------
+* this function decodes a JSON string
+* a \u escape is written as UTF-8
+*
+* parameters:
+*   value: the position of the string
+*
+* returns:
+*   char*: the decoded string (freed by the caller) or NULL if the value is not a string
+*/
+char *json_string(const char *value){
+	const char *end;
+	char *string, *out;
+	char digits[5];/*the digits of a \u escape*/
+	unsigned long code;
+
+	if(!value || *(value = json_skip_space(value)) != '"' || !(end = json_skip_value(value))){
+		return NULL;
+	}
+	string = (char*)malloc(end - value);/*the decoded string is never longer than the escaped one*/
+	if(!string){
+		print_system_error("malloc failed");
+		return NULL;
+	}
+	for(out = string, value++ ; value < end - 1 ; value++){
+		if(*value != '\\'){
+			*out++ = *value;
+			continue;
+		}
+		value++;
+		if(*value == 'u' && end - 1 - value > 4){
+			memcpy(digits, value + 1, 4);
+			digits[4] = '\0';
+			code = strtoul(digits, NULL, 16);
+			value += 4;
+			if(code < 0x80){
+				*out++ = (char)code;
+			}
+			else if(code < 0x800){
+				*out++ = (char)(0xC0 | (code >> 6));
+				*out++ = (char)(0x80 | (code & 0x3F));
+			}
+			else{
+				*out++ = (char)(0xE0 | (code >> 12));
+				*out++ = (char)(0x80 | ((code >> 6) & 0x3F));
+				*out++ = (char)(0x80 | (code & 0x3F));
+			}
+		}
+		else{
+			*out++ = *value == 'n' ? '\n' : *value == 'r' ? '\r' : *value == 't' ? '\t' : *value == 'b' ? '\b' : *value == 'f' ? '\f' : *value;
+		}
+	}
+	*out = '\0';
+	return string;
+}
+
+/*
+* json_number
+* -----------
+* this function reads a JSON number as a long
+*
+* parameters:
+*   value: the position of the number or NULL
+*   fallback: the value returned when there is no number
+*
+* returns:
+*   long: the number or fallback
+*/
+long json_number(const char *value, long fallback){
+	char *end;
+	long number;
+
+	if(!value){
+		return fallback;
+	}
+	number = strtol(json_skip_space(value), &end, 10);
+	return end == json_skip_space(value) ? fallback : number;
+}
+
+/*** MESSAGE SECTION ***/
+
+/*
+* read_message
+* ------------
+* this function reads the next message from the client
+*
+* parameters:
+*   input: the stream of the client
+*
+* returns:
+*   char*: the null terminated body of the message (freed by the caller) or NULL at the end of the input
+*/
+char *read_message(FILE *input){
+	char header[LSP_HEADER_LENGTH];
+	long length = -1;/*the Content-Length header*/
+	char *body;
+
+	while(fgets(header, sizeof(header), input)){
+		if(strcmp(header, "\r\n") == 0 || strcmp(header, "\n") == 0){/*the headers end with an empty line*/
+			if(length >= 0){
+				break;
+			}
+			continue;
+		}
+		if(strncmp(header, "Content-Length:", 15) == 0){
+			length = strtol(header + 15, NULL, 10);
+		}
+	}
+	if(length < 0 || length > LSP_MAX_MESSAGE || feof(input)){
+		return NULL;
+	}
+	body = (char*)malloc(length + 1);
+	if(!body){
+		print_system_error("malloc failed");
+		return NULL;
+	}
+	if(fread(body, 1, length, input) != (size_t)length){
+		free(body);
+		return NULL;
+	}
+	body[length] = '\0';
+	return body;
+}
+
+/*
+* send_message
+* ------------
+* this function sends a message to the client with its Content-Length header
+*
+* parameters:
+*   server: the language server
+*   body: the JSON body of the message
+*   length: the length of the body
+*
+*/
+void send_message(LanguageServer *server, const char *body, size_t length){
+	fprintf(server->output, "Content-Length: %lu\r\n\r\n", (unsigned long)length);
+	fwrite(body, 1, length, server->output);
+	fflush(server->output);
+}
+
+/*
+* send_response
+* -------------
+* this function answers a request with a result or with an error
+*
+* parameters:
+*   server: the language server
+*   id: the id of the request as it appeared in the request
+*   id_length: the length of the id
+*   result: the JSON result or NULL to send an error
+*   code: the error code when result is NULL
+*   message: the error message when result is NULL
+*
+*/
+void send_response(LanguageServer *server, const char *id, size_t id_length, const char *result, int code, const char *message){
+	char *body = NULL;
+	size_t length = 0;
+	FILE *file = open_memstream(&body, &length);
+
+	if(!file){
+		print_system_error("Error: couldn't build the response");
+		return;
+	}
+	fprintf(file, "{\"jsonrpc\":\"2.0\",\"id\":%.*s,", (int)id_length, id);
+	if(result){
+		fprintf(file, "\"result\":%s}", result);
+	}
+	else{
+		fprintf(file, "\"error\":{\"code\":%d,\"message\":", code);
+		json_write_string(file, message, strlen(message));
+		fputs("}}", file);
+	}
+	fclose(file);
+	send_message(server, body, length);
+	free(body);
+}
+
+/*** DOCUMENTS SECTION ***/
+
+/*
+* find_document
+* -------------
+* this function finds an open source by its uri
+*
+* parameters:
+*   server: the language server
+*   uri: the uri of the source
+*
+* returns:
+*   int: the index of the source or -1 if it is not open
+*/
+int find_document(LanguageServer *server, const char *uri){
+	int i;
+
+	for(i=0 ; uri && i<server->count ; i++){
+		if(strcmp(server->documents[i]->uri, uri) == 0){
+			return i;
+		}
+	}
+	return -1;
+}
+
+/*
+* close_document
+* --------------
+* this function forgets an open source
+*
+* parameters:
+*   server: the language server
+*   index: the index of the source
+*
+*/
+void close_document(LanguageServer *server, int index){
+	OpenDocument *open = server->documents[index];
+
+	free_incremental_document(&open->document);
+	free(open->uri);
+	free(open->text);
+	free(open);
+	server->documents[index] = server->documents[--server->count];
+}
+
+/*
+* text_offset
+* -----------
+* this function converts a position of the protocol to an offset in the text of a source
+* a position past the end of its line is the end of the line
+*
+* parameters:
+*   open: the source
+*   position: the position object (line and character)
+*
+* returns:
+*   size_t: the offset
+*/
+size_t text_offset(OpenDocument *open, const char *position){
+	long line = json_number(json_member(position, "line"), 0);
+	long character = json_number(json_member(position, "character"), 0);
+	size_t offset = 0;
+
+	for( ; line > 0 && offset < open->length ; offset++){
+		if(open->text[offset] == '\n'){
+			line--;
+		}
+	}
+	for( ; character > 0 && offset < open->length && open->text[offset] != '\n' ; character--){
+		offset++;
+	}
+	return offset;
+}
+
+/*
+* apply_change
+* ------------
+* this function applies a change sent by the editor to the text of a source
+* a change with a range replaces the range and a change without one replaces the whole text
+*
+* parameters:
+*   open: the source
+*   change: the change object
+*
+* returns:
+*   bool: true if the change was applied false otherwise
+*/
+bool apply_change(OpenDocument *open, const char *change){
+	const char *range = json_member(change, "range");
+	char *replacement = json_string(json_member(change, "text"));
+	char *text;
+	size_t start = 0, end = open->length, length;
+
+	if(!replacement){
+		return false;
+	}
+	if(range){
+		start = text_offset(open, json_member(range, "start"));
+		end = text_offset(open, json_member(range, "end"));
+		if(end < start){
+			end = start;
+		}
+	}
+	length = strlen(replacement);
+	text = (char*)malloc(open->length - (end - start) + length + 1);
+	if(!text){
+		print_system_error("malloc failed");
+		free(replacement);
+		return false;
+	}
+	memcpy(text, open->text, start);
+	memcpy(text + start, replacement, length);
+	memcpy(text + start + length, open->text + end, open->length - end);
+	open->length = open->length - (end - start) + length;
+	text[open->length] = '\0';
+	free(open->text);
+	free(replacement);
+	open->text = text;
+	return true;
+}
+
+/*** DIAGNOSTICS SECTION ***/
+
+/*
+* source_line_text
+* ----------------
+* this function finds a line of the source a document was last updated with
+*
+* parameters:
+*   document: the document
+*   line: the 1 based source line
+*   length: a pointer that receives the length of the line without its line ending
+*
+* returns:
+*   const char*: the start of the line (an empty line when it is past the end)
+*/
+const char *source_line_text(IncrementalDocument *document, int line, size_t *length){
+	const char *text;
+
+	if(line < 1 || line > document->source_count){
+		*length = 0;
+		return "";
+	}
+	text = document->source + document->source_starts[line - 1];
+	*length = strcspn(text, "\r\n");
+	return text;
+}
+
+typedef struct{/*the state of publish_diagnostics while the diagnostics of a document are written*/
+	FILE *file;/*the stream the diagnostics are written to*/
+	IncrementalDocument *document;/*the document*/
+	int count;/*number of diagnostics written*/
+}DiagnosticWriter;
+
+/*
+* write_diagnostic
+* ----------------
+* this function writes a single diagnostic that covers a whole source line
+* a diagnostic whose messages start with a warning is sent as a warning
+*
+* parameters:
+*   context: the DiagnosticWriter
+*   line: the 1 based source line
+*   message: the message
+*
+*/
+void write_diagnostic(void *context, int line, const char *message){
+	DiagnosticWriter *writer = (DiagnosticWriter*)context;
+	size_t length;
+
+	source_line_text(writer->document, line, &length);
+	fprintf(writer->file, "%s{\"range\":{\"start\":{\"line\":%d,\"character\":0},\"end\":{\"line\":%d,\"character\":%lu}},\"severity\":%d,\"source\":\"assembler\",\"message\":",
+		writer->count++ ? "," : "", line > 0 ? line - 1 : 0, line > 0 ? line - 1 : 0, (unsigned long)length, strncmp(message, "Warning", 7) == 0 ? 2 : 1);
+	json_write_string(writer->file, message, strlen(message));
+	fputc('}', writer->file);
+}
+
+/*
+* publish_diagnostics
+* -------------------
+* this function sends the errors of every line of a source to the editor
+* the diagnostics are the ones visit_diagnostics finds
+*
+* parameters:
+*   server: the language server
+*   uri: the uri of the source
+*   document: the document or NULL to clear the diagnostics of a closed source
+*
+*/
+void publish_diagnostics(LanguageServer *server, const char *uri, IncrementalDocument *document){
+	char *body = NULL;
+	size_t length = 0;
+	DiagnosticWriter writer;
+
+	writer.file = open_memstream(&body, &length);
+	writer.document = document;
+	writer.count = 0;
+	if(!writer.file){
+		print_system_error("Error: couldn't build the diagnostics");
+		return;
+	}
+	fputs("{\"jsonrpc\":\"2.0\",\"method\":\"textDocument/publishDiagnostics\",\"params\":{\"uri\":", writer.file);
+	json_write_string(writer.file, uri, strlen(uri));
+	fputs(",\"diagnostics\":[", writer.file);
+	if(document){
+		visit_diagnostics(document, write_diagnostic, &writer);
+	}
+	fputs("]}}", writer.file);
+	fclose(writer.file);
+	send_message(server, body, length);
+	free(body);
+}
+
+/*** REQUESTS SECTION ***/
+
+/*
+* update_document
+* ---------------
+* this function brings the assembled lines of a source up to date with its text and publishes the diagnostics
+*
+* parameters:
+*   server: the language server
+*   open: the source
+*
+*/
+void update_document(LanguageServer *server, OpenDocument *open){
+	struct timespec start;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	if(!update_incremental_document(&open->document, open->text, open->length)){
+		fprintf(stderr, "lsp: couldn't update %s\n", open->uri);
+	}
+	if(server->timings){
+		fprintf(stderr, "lsp: updated %s in %.3f ms (%d line%s sized %d encoded)\n", open->uri, elapsed_milliseconds(&start),
+			open->document.sized_lines, open->document.sized_lines == 1 ? "" : "s", open->document.encoded_lines);
+	}
+	publish_diagnostics(server, open->uri, &open->document);
+}
+
+/*
+* open_document
+* -------------
+* this function handles textDocument/didOpen
+*
+* parameters:
+*   server: the language server
+*   params: the params of the notification
+*
+*/
+void open_document(LanguageServer *server, const char *params){
+	OpenDocument *open, **documents;
+	char *uri = json_string(json_path(params, "textDocument.uri"));
+	char *text = json_string(json_path(params, "textDocument.text"));
+	int index = find_document(server, uri);
+
+	if(!uri || !text){
+		free(uri);
+		free(text);
+		return;
+	}
+	if(index >= 0){/*an editor that opens a source twice gets the new text*/
+		close_document(server, index);
+	}
+	if(server->count >= server->capacity){
+		documents = (OpenDocument**)realloc(server->documents, (server->capacity ? server->capacity * 2 : 8) * sizeof(OpenDocument*));
+		if(!documents){
+			print_system_error("realloc failed");
+			free(uri);
+			free(text);
+			return;
+		}
+		server->documents = documents;
+		server->capacity = server->capacity ? server->capacity * 2 : 8;
+	}
+	open = (OpenDocument*)malloc(sizeof(OpenDocument));
+	if(!open || !initialize_incremental_document(&open->document)){
+		free(open);
+		free(uri);
+		free(text);
+		return;
+	}
+	open->uri = uri;
+	open->text = text;
+	open->length = strlen(text);
+	server->documents[server->count++] = open;
+	update_document(server, open);
+}
+
+/*
+* change_document
+* ---------------
+* this function handles textDocument/didChange
+*
+* parameters:
+*   server: the language server
+*   params: the params of the notification
+*
+*/
+void change_document(LanguageServer *server, const char *params){
+	char *uri = json_string(json_path(params, "textDocument.uri"));
+	const char *changes = json_member(params, "contentChanges"), *change;
+	int index = find_document(server, uri), i;
+
+	free(uri);
+	if(index < 0){
+		return;
+	}
+	for(i=0 ; (change = json_element(changes, i)) != NULL ; i++){/*the changes apply one after the other*/
+		apply_change(server->documents[index], change);
+	}
+	update_document(server, server->documents[index]);
+}
+
+/*
+* find_definition
+* ---------------
+* this function handles textDocument/definition
+* the label under the cursor leads to the line that defines it or to the .extern line that declares it
+*
+* parameters:
+*   server: the language server
+*   params: the params of the request
+*   id: the id of the request
+*   id_length: the length of the id
+*
+*/
+void find_definition(LanguageServer *server, const char *params, const char *id, size_t id_length){
+	char name[MAX_LABEL_LENGTH + 1];
+	char *uri = json_string(json_path(params, "textDocument.uri"));
+	int index = find_document(server, uri);
+	long line = json_number(json_path(params, "position.line"), -1);
+	long character = json_number(json_path(params, "position.character"), -1);
+	IncrementalDocument *document;
+	IncrementalLine *declaration = NULL;
+	const char *text, *found;
+	size_t length, start, end;
+	char *result = NULL;
+	size_t result_length = 0;
+	FILE *file;
+
+	if(index >= 0 && line >= 0 && character >= 0){
+		document = &server->documents[index]->document;
+		text = source_line_text(document, (int)line + 1, &length);
+		for(start = (size_t)character < length ? (size_t)character : length ; start > 0 && is_alnum(text[start - 1]) ; start--);/*the word under the cursor*/
+		for(end = start ; end < length && is_alnum(text[end]) ; end++);
+		if(end > start && end - start <= MAX_LABEL_LENGTH){
+			memcpy(name, text + start, end - start);
+			name[end - start] = '\0';
+			declaration = find_declaration(document, name);
+		}
+	}
+	if(!declaration || !(file = open_memstream(&result, &result_length))){
+		send_response(server, id, id_length, "null", 0, NULL);
+		free(uri);
+		return;
+	}
+	text = source_line_text(document, declaration->source_line, &length);
+	for(found = text ; found + strlen(name) <= text + length && strncmp(found, name, strlen(name)) != 0 ; found++);
+	start = found + strlen(name) <= text + length ? (size_t)(found - text) : 0;/*a label made by a macro is not in the source line*/
+	fputs("{\"uri\":", file);
+	json_write_string(file, uri, strlen(uri));
+	fprintf(file, ",\"range\":{\"start\":{\"line\":%d,\"character\":%lu},\"end\":{\"line\":%d,\"character\":%lu}}}",
+		declaration->source_line - 1, (unsigned long)start, declaration->source_line - 1, (unsigned long)(start + strlen(name)));
+	fclose(file);
+	send_response(server, id, id_length, result, 0, NULL);
+	free(result);
+	free(uri);
+}
+
+/*
+* handle_message
+* --------------
+* this function handles a single message of the client
+*
+* parameters:
+*   server: the language server
+*   message: the body of the message
+*
+* returns:
+*   bool: true to read the next message false once the client sent exit
+*/
+bool handle_message(LanguageServer *server, const char *message){
+	char *method = json_string(json_member(message, "method"));
+	const char *id = json_member(message, "id");
+	const char *params = json_member(message, "params");
+	size_t id_length = id ? (size_t)(json_skip_value(id) ? json_skip_value(id) - id : 0) : 0;
+	bool running = true;
+
+	if(!method){/*a response to a request of the server*/
+		return true;
+	}
+	if(strcmp(method, "exit") == 0){
+		running = false;
+	}
+	else if(id && server->shutdown){
+		send_response(server, id, id_length, NULL, LSP_INVALID_REQUEST, "the server is shutting down");
+	}
+	else if(strcmp(method, "initialize") == 0 && id){
+		send_response(server, id, id_length, "{\"capabilities\":{\"textDocumentSync\":{\"openClose\":true,\"change\":2},\"definitionProvider\":true},"
+			"\"serverInfo\":{\"name\":\"assembler\",\"version\":\"" ASSEMBLER_VERSION "\"}}", 0, NULL);
+	}
+	else if(strcmp(method, "shutdown") == 0 && id){
+		server->shutdown = true;
+		send_response(server, id, id_length, "null", 0, NULL);
+	}
+	else if(strcmp(method, "textDocument/didOpen") == 0){
+		open_document(server, params);
+	}
+	else if(strcmp(method, "textDocument/didChange") == 0){
+		change_document(server, params);
+	}
+	else if(strcmp(method, "textDocument/didClose") == 0){
+		char *uri = json_string(json_path(params, "textDocument.uri"));
+		int index = find_document(server, uri);
+
+		if(index >= 0){
+			close_document(server, index);
+			publish_diagnostics(server, uri, NULL);
+		}
+		free(uri);
+	}
+	else if(strcmp(method, "textDocument/definition") == 0 && id){
+		find_definition(server, params, id, id_length);
+	}
+	else if(id){/*notifications the server does not implement are ignored*/
+		send_response(server, id, id_length, NULL, LSP_METHOD_NOT_FOUND, "method not supported");
+	}
+	free(method);
+	return running;
+}
+
+/*
+* run_language_server
+* -------------------
+* this function serves the language server protocol until the client sends exit or closes the input
+* the messages of the passes never reach the output since every update collects them for the diagnostics
+*
+* parameters:
+*   input: the stream the client writes to
+*   output: the stream the client reads
+*   timings: true to print the time every update took to stderr
+*
+* returns:
+*   int: 0 if the client shut the server down before exit 1 otherwise
+*/
+int run_language_server(FILE *input, FILE *output, bool timings){
+	LanguageServer server;
+	char *message;
+	bool running = true;
+
+	memset(&server, 0, sizeof(server));
+	server.input = input;
+	server.output = output;
+	server.timings = timings;
+	redirect_output(stderr, stderr);/*nothing but messages may be written to the output*/
+	while(running && (message = read_message(input)) != NULL){
+		running = handle_message(&server, message);
+		free(message);
+	}
+	while(server.count > 0){
+		close_document(&server, server.count - 1);
+	}
+	free(server.documents);
+	return server.shutdown ? 0 : 1;
+}
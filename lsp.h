@@ -0,0 +1,55 @@
+#ifndef LSP_H
+#define LSP_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "definitions.h"
+#include "incremental.h"
+
+#define LSP_HEADER_LENGTH 256/*longest header line of a message*/
+#define LSP_MAX_MESSAGE 0x10000000L/*longest message body accepted*/
+#define LSP_METHOD_NOT_FOUND (-32601)/*error code of a request the server does not implement*/
+#define LSP_INVALID_REQUEST (-32600)/*error code of a request that arrives after shutdown*/
+
+/*
+* language server
+* ---------------
+* --lsp speaks the language server protocol on stdin and stdout
+* every message is a JSON-RPC object preceded by a Content-Length header
+* the server keeps an IncrementalDocument for every open source and supports:
+*   initialize shutdown exit
+*   textDocument/didOpen didChange (whole or ranged changes) and didClose
+*   textDocument/publishDiagnostics sent after every change with the errors of every line
+*   textDocument/definition which jumps from a label to the line that defines it (or declares it .extern)
+* positions count bytes instead of UTF-16 units which is the same for the ASCII sources the assembler accepts
+*/
+
+/*** STRUCTURE DEFINITIONS SECTION ***/
+
+typedef struct{/*a source opened by the editor*/
+	char *uri;/*the uri the editor names the source by*/
+	char *text;/*the current text of the source*/
+	size_t length;/*length of the text*/
+	IncrementalDocument document;/*the source kept assembled*/
+}OpenDocument;
+
+typedef struct{/*the state of the language server*/
+	FILE *input;/*stream the messages are read from*/
+	FILE *output;/*stream the messages are written to*/
+	OpenDocument **documents;/*the open sources*/
+	int count;/*number of open sources*/
+	int capacity;/*capacity of the documents array*/
+	bool shutdown;/*true once the client asked the server to shut down*/
+	bool timings;/*print the time every update took to stderr (--stats)*/
+}LanguageServer;
+
+/*** FUNCTION PROTOTYPES SECTION ***/
+
+bool apply_change(OpenDocument *open,const char *change);/*function to apply a whole or ranged change of the editor to the text of a source*/
+const char *json_member(const char *object,const char *name);/*function to find the value of a member of a JSON object*/
+const char *json_path(const char *object,const char *path);/*function to find a value through a dotted path of member names*/
+char *json_string(const char *value);/*function to decode a JSON string*/
+int run_language_server(FILE *input,FILE *output,bool timings);/*function to serve the language server protocol until the client exits*/
+
+#endif /*LSP_H*/
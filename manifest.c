@@ -0,0 +1,325 @@
+#include "manifest.h"
+#include "utils.h"
+#include "diagnostics.h"
+#include <errno.h>
+
+/*** FILE STREAM SECTION ***/
+
+/*
+* uses_manifest
+* -------------
+* this function checks if any file comes from a manifest instead of the command line
+*
+* parameters:
+*   arguments: the file arguments of the command line
+*   argument_count: the number of file arguments
+*   files_from: the manifest given to --files-from or NULL
+*
+* returns:
+*   bool: true if a manifest has to be read false if the files are exactly the arguments
+*/
+bool uses_manifest(char *arguments[], int argument_count, const char *files_from){
+	int i;
+
+	for(i=0 ; i<argument_count ; i++){
+		if(arguments[i][0] == MANIFEST_PREFIX){
+			return true;
+		}
+	}
+	return files_from != NULL;
+}
+
+/*
+* open_file_stream
+* ----------------
+* this function starts reading the files of the command line
+* the file arguments come first in their order with every @manifest replaced by its lines then the --files-from manifest
+*
+* parameters:
+*   stream: the FileStream to prepare
+*   arguments: the file arguments of the command line
+*   argument_count: the number of file arguments
+*   files_from: the manifest given to --files-from or NULL
+*
+*/
+void open_file_stream(FileStream *stream, char *arguments[], int argument_count, const char *files_from){
+	memset(stream, 0, sizeof(FileStream));
+	stream->arguments = arguments;
+	stream->argument_count = argument_count;
+	stream->files_from = files_from;
+}
+
+/*
+* open_manifest
+* -------------
+* this function starts reading a manifest
+*
+* parameters:
+*   stream: the FileStream
+*   name: the name of the manifest (MANIFEST_STDIN for stdin)
+*
+* returns:
+*   bool: true if the manifest was opened false otherwise
+*/
+bool open_manifest(FileStream *stream, const char *name){
+	stream->manifest_name = name;
+	stream->manifest = strcmp(name, MANIFEST_STDIN) == 0 ? stdin : fopen(name, "r");
+	if(!stream->manifest){
+		fprintf(stderr, "Error: can't read the file list %s: %s\n", name, strerror(errno));
+		stream->failed = true;
+		return false;
+	}
+	return true;
+}
+
+/*
+* close_manifest
+* --------------
+* this function stops reading the current manifest
+*
+* parameters:
+*   stream: the FileStream
+*
+*/
+void close_manifest(FileStream *stream){
+	if(ferror(stream->manifest)){
+		fprintf(stderr, "Error: reading the file list %s failed\n", stream->manifest_name);
+		stream->failed = true;
+	}
+	if(stream->manifest != stdin){
+		fclose(stream->manifest);
+	}
+	stream->manifest = NULL;
+}
+
+/*
+* set_current_file
+* ----------------
+* this function makes a line of a manifest the current file
+* the outputs of a line with an output directory are named after the last component of the file inside that directory
+*
+* parameters:
+*   stream: the FileStream
+*   line: the line without its line ending
+*
+* returns:
+*   bool: true if the line names a file false if it is blank or memory ran out
+*/
+bool set_current_file(FileStream *stream, char *line){
+	char *separator = strchr(line, MANIFEST_SEPARATOR), *slash;
+	const char *directory = NULL, *component;
+
+	if(separator){
+		*separator = '\0';
+		directory = separator + 1;
+	}
+	if(line[0] == '\0'){
+		return false;
+	}
+	stream->name = make_path(line, NULL, NULL);
+	if(stream->name && directory && directory[0]){
+		slash = strrchr(stream->name, '/');
+		component = slash ? slash + 1 : stream->name;
+		stream->output = make_path(directory, directory[strlen(directory) - 1] == '/' ? "" : "/", component);
+	}
+	else{
+		stream->output = stream->name;
+	}
+	if(!stream->name || !stream->output){
+		print_system_error("malloc failed");
+		stream->failed = true;
+		free(stream->name);
+		stream->name = NULL;
+		stream->output = NULL;
+		return false;
+	}
+	stream->owned = true;
+	return true;
+}
+
+/*
+* release_current_file
+* --------------------
+* this function frees the names of the current file
+*
+* parameters:
+*   stream: the FileStream
+*
+*/
+void release_current_file(FileStream *stream){
+	if(stream->owned){
+		if(stream->output != stream->name){
+			free(stream->output);
+		}
+		free(stream->name);
+	}
+	stream->owned = false;
+	stream->name = NULL;
+	stream->output = NULL;
+}
+
+/*
+* next_file
+* ---------
+* this function advances to the next file of the command line
+* the names of the file stay valid until the next call
+*
+* parameters:
+*   stream: the FileStream
+*
+* returns:
+*   bool: true if name and output hold the next file false once every file was read
+*/
+bool next_file(FileStream *stream){
+	ssize_t length;
+	char *argument;
+
+	release_current_file(stream);
+	for(;;){
+		if(stream->manifest){
+			length = getline(&stream->line, &stream->line_capacity, stream->manifest);
+			if(length < 0){
+				close_manifest(stream);
+				continue;
+			}
+			while(length > 0 && (stream->line[length - 1] == '\n' || stream->line[length - 1] == '\r')){
+				stream->line[--length] = '\0';
+			}
+			if(set_current_file(stream, stream->line)){
+				return true;
+			}
+			continue;
+		}
+		if(stream->next_argument < stream->argument_count){
+			argument = stream->arguments[stream->next_argument++];
+			if(argument[0] == MANIFEST_PREFIX){
+				open_manifest(stream, argument + 1);
+				continue;
+			}
+			stream->name = argument;/*a file argument is used as it is*/
+			stream->output = argument;
+			return true;
+		}
+		if(stream->files_from){
+			open_manifest(stream, stream->files_from);
+			stream->files_from = NULL;
+			continue;
+		}
+		return false;
+	}
+}
+
+/*
+* close_file_stream
+* -----------------
+* this function frees everything a file stream holds
+*
+* parameters:
+*   stream: the FileStream
+*
+* returns:
+*   bool: true if every manifest was read false if one of them couldn't be read
+*/
+bool close_file_stream(FileStream *stream){
+	release_current_file(stream);
+	if(stream->manifest){
+		close_manifest(stream);
+	}
+	free(stream->line);
+	stream->line = NULL;
+	return !stream->failed;
+}
+
+/*** FILE LIST SECTION ***/
+
+/*
+* add_file
+* --------
+* this function appends the current file of a stream to a list
+* the list takes over the names allocated for a line of a manifest
+*
+* parameters:
+*   list: the FileList
+*   stream: the FileStream
+*
+* returns:
+*   bool: true if the file was added false if memory ran out
+*/
+bool add_file(FileList *list, FileStream *stream){
+	char **names, **outputs;
+	int capacity;
+
+	if(list->count >= list->capacity){
+		capacity = list->capacity ? list->capacity * 2 : 64;
+		names = (char**)realloc(list->names, capacity * sizeof(char*));
+		if(names){
+			list->names = names;
+		}
+		outputs = names ? (char**)realloc(list->outputs, capacity * sizeof(char*)) : NULL;
+		if(!outputs){
+			print_system_error("realloc failed");
+			return false;
+		}
+		list->outputs = outputs;
+		list->capacity = capacity;
+	}
+	list->names[list->count] = stream->owned ? stream->name : make_path(stream->name, NULL, NULL);
+	list->outputs[list->count] = stream->output == stream->name ? list->names[list->count] : stream->owned ? stream->output : make_path(stream->output, NULL, NULL);
+	if(!list->names[list->count] || !list->outputs[list->count]){
+		print_system_error("malloc failed");
+		return false;
+	}
+	list->count++;
+	stream->owned = false;/*the list frees the names*/
+	return true;
+}
+
+/*
+* collect_files
+* -------------
+* this function reads every file of the command line into a list
+* the modes that need every file up front (-j --batch-io --connect and --watch) assemble from the list
+*
+* parameters:
+*   list: the FileList to fill
+*   arguments: the file arguments of the command line
+*   argument_count: the number of file arguments
+*   files_from: the manifest given to --files-from or NULL
+*
+* returns:
+*   bool: true if every file was read false otherwise
+*/
+bool collect_files(FileList *list, char *arguments[], int argument_count, const char *files_from){
+	FileStream stream;
+	bool success = true;
+
+	memset(list, 0, sizeof(FileList));
+	open_file_stream(&stream, arguments, argument_count, files_from);
+	while(success && next_file(&stream)){
+		success = add_file(list, &stream);
+	}
+	return close_file_stream(&stream) && success;
+}
+
+/*
+* free_file_list
+* --------------
+* this function frees a list of files
+*
+* parameters:
+*   list: the FileList
+*
+*/
+void free_file_list(FileList *list){
+	int i;
+
+	for(i=0 ; i<list->count ; i++){
+		if(list->outputs[i] != list->names[i]){
+			free(list->outputs[i]);
+		}
+		free(list->names[i]);
+	}
+	free(list->names);
+	free(list->outputs);
+	memset(list, 0, sizeof(FileList));
+}
@@ -0,0 +1,56 @@
+#ifndef MANIFEST_H
+#define MANIFEST_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "definitions.h"
+
+#define MANIFEST_PREFIX '@'/*first character of a file argument that names a manifest*/
+#define MANIFEST_STDIN "-"/*manifest name that reads the file list from stdin*/
+#define MANIFEST_SEPARATOR '\t'/*separates a file name from its output directory*/
+
+/*
+* manifests
+* ---------
+* a manifest lists file arguments one per line so a batch is not limited by the size of argv
+* a line is the base name of a source (without the .as suffix) optionally followed by a tab and the directory the outputs of that source are written to
+* blank lines are skipped and a line may end with \r\n
+* a manifest is named by a file argument that starts with @ (@- reads stdin) or by --files-from
+* the lines are read one at a time so a manifest of any length is never held in memory as a whole
+*/
+
+/*** STRUCTURE DEFINITIONS SECTION ***/
+
+typedef struct{/*the file arguments of the command line followed by the files listed in the manifests*/
+	char **arguments;/*the file arguments of the command line*/
+	int argument_count;/*number of file arguments*/
+	int next_argument;/*index of the next file argument*/
+	const char *files_from;/*manifest given to --files-from or NULL*/
+	FILE *manifest;/*the manifest being read or NULL*/
+	const char *manifest_name;/*name of the manifest being read*/
+	char *line;/*the line read from the manifest*/
+	size_t line_capacity;/*capacity of the line buffer*/
+	char *name;/*base name of the current file*/
+	char *output;/*base name of the outputs of the current file*/
+	bool owned;/*true when name and output were allocated for a line of a manifest*/
+	bool failed;/*true once a manifest couldn't be read*/
+}FileStream;
+
+typedef struct{/*every file of a FileStream collected in memory*/
+	char **names;/*base names of the files*/
+	char **outputs;/*base names of their outputs*/
+	int count;/*number of files*/
+	int capacity;/*capacity of the arrays*/
+}FileList;
+
+/*** FUNCTION PROTOTYPES SECTION ***/
+
+bool uses_manifest(char *arguments[],int argument_count,const char *files_from);/*function to check if any file comes from a manifest*/
+void open_file_stream(FileStream *stream,char *arguments[],int argument_count,const char *files_from);/*function to start reading the file arguments and manifests*/
+bool next_file(FileStream *stream);/*function to advance to the next file*/
+bool close_file_stream(FileStream *stream);/*function to free a file stream*/
+bool collect_files(FileList *list,char *arguments[],int argument_count,const char *files_from);/*function to read every file into a list*/
+void free_file_list(FileList *list);/*function to free a file list*/
+
+#endif /*MANIFEST_H*/
@@ -0,0 +1,91 @@
+#ifndef OBJECT_FORMAT_H
+#define OBJECT_FORMAT_H
+
+/*
+* binary object format (.obb)
+* ---------------------------
+* a compact alternative to the text .ob .ent and .ext files that a loader can mmap and use without parsing
+* every field is stored little endian and every section starts at an offset recorded in the header
+*
+*   ObjectHeader            fixed size header at offset 0
+*   code image              code_length words of 16 bits at code_offset
+*   data image              data_length words of 16 bits at data_offset
+*   entry table             entry_count ObjectSymbol records at entry_offset
+*   extern reference table  extern_count ObjectSymbol records at extern_offset
+*   relocation table        relocation_count code image indices of 32 bits at relocation_offset
+*
+* each word holds the same 15-bit value that the text .ob prints in octal
+* the symbol tables are 4-byte aligned so a little endian loader can cast the mapped bytes directly to the structures below
+*
+* the relocation table lists the code image indices of the words that hold the address of an internal label (ARE=2)
+* the addresses in the file are valid for load_base so placing the program at another base only needs
+* OBJECT_REBASE_WORD with delta = new base - load_base applied to the listed words
+* and the same delta added to the entry and extern addresses
+*/
+
+/*first four bytes of every binary object file*/
+#define OBJECT_MAGIC "ASOB"
+
+/*length of the magic*/
+#define OBJECT_MAGIC_LENGTH 4
+
+/*version of the layout described in this file*/
+#define OBJECT_VERSION 2
+
+/*fixed length of a symbol name including the null terminator*/
+#define OBJECT_SYMBOL_NAME_LENGTH 32
+
+/*structure representing the header of a binary object file*/
+typedef struct{
+	char magic[OBJECT_MAGIC_LENGTH];/*always OBJECT_MAGIC*/
+	unsigned short version;/*always OBJECT_VERSION*/
+	unsigned short header_size;/*size of this header in bytes*/
+	unsigned int load_base;/*address of the first code word*/
+	unsigned int code_length;/*number of words in the code image*/
+	unsigned int data_length;/*number of words in the data image*/
+	unsigned int entry_count;/*number of records in the entry table*/
+	unsigned int extern_count;/*number of records in the extern reference table*/
+	unsigned int code_offset;/*file offset of the code image*/
+	unsigned int data_offset;/*file offset of the data image*/
+	unsigned int entry_offset;/*file offset of the entry table*/
+	unsigned int extern_offset;/*file offset of the extern reference table*/
+	unsigned int relocation_count;/*number of records in the relocation table*/
+	unsigned int relocation_offset;/*file offset of the relocation table*/
+	unsigned int file_size;/*total size of the file in bytes*/
+}ObjectHeader;
+
+/*structure representing a single record of the entry or extern reference table*/
+typedef struct{
+	char name[OBJECT_SYMBOL_NAME_LENGTH];/*null terminated symbol name*/
+	unsigned int address;/*address of the entry or of the word that references the extern*/
+}ObjectSymbol;
+
+/*moves the 12-bit address stored in a relocated word by delta keeping its ARE bits*/
+#define OBJECT_REBASE_WORD(word, delta) ((unsigned short)((((((word) >> 3) + (delta)) & 0xFFF) << 3) | ((word) & 0x7)))
+
+/*
+* streamed outputs (--stdio)
+* --------------------------
+* --stdio reads the source from stdin and writes all its outputs to stdout as framed sections
+*
+*   section EXTENSION LENGTH\n   a header line followed by exactly LENGTH bytes of the output with that extension
+*   end\n                        written after the last section
+*
+* the sections come in the order .ob .ent .ext .rel .obb .map .report .report.json and only the outputs the source has are present
+* the end line tells a complete stream from a truncated one and nothing at all is written when the source fails to assemble
+*/
+
+/*first word of the header line of a section*/
+#define STREAM_SECTION "section"
+
+/*the line that closes a stream*/
+#define STREAM_END "end"
+
+/*name of the source in the messages of --stdio*/
+#define STREAM_SOURCE_NAME "stdin"
+
+/*compile time checks that the structures match the on disk layout*/
+typedef char object_header_size_check[(sizeof(ObjectHeader) == 56) ? 1 : -1];
+typedef char object_symbol_size_check[(sizeof(ObjectSymbol) == 36) ? 1 : -1];
+
+#endif /*OBJECT_FORMAT_H*/
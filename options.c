@@ -0,0 +1,341 @@
+#include "options.h"
+#include "cache.h"
+#include "diagnostics.h"
+#include "cost_report.h"
+#include <limits.h>
+
+/*** OPTIONS HANDLING SECTION ***/
+
+/*
+* initialize_options
+* ------------------
+* this function sets every option in the AssemblerOptions structure to its default value
+* the defaults reproduce the classic behavior of the assembler so running it without options changes nothing
+*
+* parameters:
+*   options: a pointer to the AssemblerOptions structure to be initialized
+*
+*/
+void initialize_options(AssemblerOptions *options){
+	options->format = TEXT_OBJECT;/*write the text .ob .ent and .ext files by default*/
+	options->load_base = IC_INIT_VALUE;/*load the program at the classic initial IC value*/
+	options->write_relocations = false;/*do not write a .rel file by default*/
+	options->write_map = false;/*do not write a .map file by default*/
+	options->write_report = false;/*do not write a .report file by default*/
+	options->write_report_json = false;/*do not write a .report.json file by default*/
+	initialize_cost_table(&options->cost_table);/*charge the default cycles*/
+	options->batch_io = false;/*read and write every file with plain stdio by default*/
+	options->jobs = 1;/*assemble one file at a time by default*/
+	options->chunked = false;/*run both passes of a source on one thread by default*/
+	options->serve_path = NULL;/*run as a normal command by default*/
+	options->connect_path = NULL;/*assemble the files in this process by default*/
+	options->cache_directory = NULL;/*do not cache the outputs by default*/
+	options->cache_size = CACHE_DEFAULT_SIZE * 1048576L;/*default size limit of the cache*/
+	options->cache_stats = false;/*do not print the cache counters by default*/
+	options->watch = false;/*exit once the files were assembled by default*/
+	options->language_server = false;/*assemble the file arguments by default*/
+	options->files_from = NULL;/*only the file arguments are assembled by default*/
+	options->stdio = false;/*read and write files by default*/
+	options->max_errors = DEFAULT_MAX_ERRORS;/*report up to DEFAULT_MAX_ERRORS errors of every file by default*/
+	options->check_only = false;/*write the outputs of every file by default*/
+	options->stats = false;/*measure nothing by default*/
+	options->stats_json = NULL;
+	options->perf_counters = false;/*read no counters of the processor by default*/
+	options->trace_path = NULL;/*record no trace by default*/
+}
+
+/*
+* parse_number_argument
+* ---------------------
+* this function converts the value of a numeric option and checks that it is a whole non negative number
+*
+* parameters:
+*   option: the name of the option used in the error message
+*   text: the text of the value
+*   value: a pointer to where the converted value will be stored
+*
+* returns:
+*   bool: true if the value is valid false otherwise
+*/
+bool parse_number_argument(const char *option,const char *text,long *value){
+	char *endptr;
+
+	if(text == NULL || *text == '\0'){
+		fprintf(stderr, "Error: option '%s' requires a value\n", option);
+		return false;
+	}
+	*value = strtol(text, &endptr, 0);/*accept decimal octal and hexadecimal values*/
+	if(*endptr != '\0' || *value < 0){
+		fprintf(stderr, "Error: invalid value '%s' for option '%s'\n", text, option);
+		return false;
+	}
+	return true;
+}
+
+/*
+* print_usage
+* -----------
+* this function prints the usage instructions of the assembler including all the supported options
+*
+* parameters:
+*   program_name: the name the program was invoked with
+*
+*/
+void print_usage(const char *program_name){
+	fprintf(stderr, "usage: %s [options] <file1> <file2> ... <fileN>\n", program_name);
+	fprintf(stderr, "options:\n");
+	fprintf(stderr, "  -b, --binary   write a single binary object file (.obb) instead of .ob .ent and .ext\n");
+	fprintf(stderr, "  --base N       load the program at address N instead of %d\n", IC_INIT_VALUE);
+	fprintf(stderr, "  -r, --reloc    write the relocation table to a .rel file\n");
+	fprintf(stderr, "  -m, --map      write the source line and macro of every address range to a .map file\n");
+	fprintf(stderr, "  --report       write the instructions words operations modes and estimated cycles of every label to a .report file\n");
+	fprintf(stderr, "  --report-json  write the same report to a .report.json file\n");
+	fprintf(stderr, "  --cost-table F read the cycles of the operations and addressing modes of the report from F\n");
+	fprintf(stderr, "  --batch-io     read all the sources and write all the outputs in batches (io_uring when available)\n");
+	fprintf(stderr, "  -j, --jobs N   assemble N files at a time (0 for one per processor)\n");
+	fprintf(stderr, "  --chunked      with -j split a single file into chunks that both passes run on the N threads\n");
+	fprintf(stderr, "  --serve PATH   run as a daemon that assembles the files sent to the socket PATH\n");
+	fprintf(stderr, "  --connect PATH forward the files to the daemon at PATH when it is running\n");
+	fprintf(stderr, "  --cache DIR    restore unchanged files from the output cache in DIR\n");
+	fprintf(stderr, "  --cache-size N limit the output cache to N megabytes (default %d)\n", CACHE_DEFAULT_SIZE);
+	fprintf(stderr, "  --cache-stats  print the counters of the output cache\n");
+	fprintf(stderr, "  --watch        stay running and reassemble every file when it is saved\n");
+	fprintf(stderr, "  --lsp          speak the language server protocol on stdin and stdout\n");
+	fprintf(stderr, "  --files-from F also assemble the files listed in F one per line (- for stdin)\n");
+	fprintf(stderr, "  @F             a file argument that names a list of files like --files-from\n");
+	fprintf(stderr, "  --max-errors N stop reading a file after N errors (0 for no limit, default %d)\n", DEFAULT_MAX_ERRORS);
+	fprintf(stderr, "  --stdio        assemble the source on stdin and write its outputs to stdout as framed sections\n");
+	fprintf(stderr, "  --check        only check the files for errors without encoding them or writing any file\n");
+	fprintf(stderr, "  --stats        print the time of every phase and the counters of every file to stderr (of every update with --lsp)\n");
+	fprintf(stderr, "  --stats-json F write the statistics to F as JSON (- for stdout)\n");
+	fprintf(stderr, "  --perf-counters add the cycles instructions branch and cache misses and page faults of every phase to the statistics (linux)\n");
+	fprintf(stderr, "  --trace F      write a timeline of the files phases I/O waits and worker tasks to F in the Chrome trace format\n");
+}
+
+/*
+* parse_options
+* -------------
+* this function parses the options that precede the file arguments on the command line
+* parsing stops at the first argument that does not start with a dash or after a "--" argument
+*
+* parameters:
+*   argc: the number of command-line arguments
+*   argv: an array of strings representing the command-line arguments
+*   options: a pointer to the AssemblerOptions structure that will receive the parsed options
+*
+* returns:
+*   int: the index of the first file argument or -1 if an option is not recognized
+*/
+int parse_options(int argc,char *argv[],AssemblerOptions *options){
+	int i;
+	long value;/*value of a numeric option*/
+
+	initialize_options(options);/*start from the default options*/
+
+	for(i=1 ; i<argc && argv[i][0] == '-' ; i++){/*loop through the leading options*/
+		if(strcmp(argv[i], "--") == 0){/*explicit end of the options*/
+			return i + 1;
+		}
+		else if(strcmp(argv[i], "-b") == 0 || strcmp(argv[i], "--binary") == 0){
+			options->format = BINARY_OBJECT;/*select the binary object format*/
+		}
+		else if(strcmp(argv[i], "--base") == 0){
+			if(!parse_number_argument(argv[i], i + 1 < argc ? argv[i + 1] : NULL, &options->load_base)){
+				return -1;
+			}
+			i++;/*skip the value of the option*/
+		}
+		else if(strncmp(argv[i], "--base=", 7) == 0){
+			if(!parse_number_argument("--base", argv[i] + 7, &options->load_base)){
+				return -1;
+			}
+		}
+		else if(strcmp(argv[i], "-r") == 0 || strcmp(argv[i], "--reloc") == 0){
+			options->write_relocations = true;/*write the .rel file*/
+		}
+		else if(strcmp(argv[i], "-m") == 0 || strcmp(argv[i], "--map") == 0){
+			options->write_map = true;/*write the .map file*/
+		}
+		else if(strcmp(argv[i], "--report") == 0){
+			options->write_report = true;/*write the .report file*/
+		}
+		else if(strcmp(argv[i], "--report-json") == 0){
+			options->write_report_json = true;/*write the .report.json file*/
+		}
+		else if(strcmp(argv[i], "--cost-table") == 0){
+			if(i + 1 >= argc){
+				fprintf(stderr, "Error: option '%s' requires a value\n", argv[i]);
+				return -1;
+			}
+			if(!read_cost_table(argv[++i], &options->cost_table)){/*replace the cycles and skip the value of the option*/
+				return -1;
+			}
+		}
+		else if(strcmp(argv[i], "--batch-io") == 0){
+			options->batch_io = true;/*batch the file reads and writes*/
+		}
+		else if(strcmp(argv[i], "-j") == 0 || strcmp(argv[i], "--jobs") == 0){
+			if(!parse_number_argument(argv[i], i + 1 < argc ? argv[i + 1] : NULL, &value)){
+				return -1;
+			}
+			options->jobs = (int)value;
+			i++;/*skip the value of the option*/
+		}
+		else if(strncmp(argv[i], "-j", 2) == 0 || strncmp(argv[i], "--jobs=", 7) == 0){
+			if(!parse_number_argument("--jobs", argv[i] + (argv[i][1] == 'j' ? 2 : 7), &value)){
+				return -1;
+			}
+			options->jobs = (int)value;
+		}
+		else if(strcmp(argv[i], "--chunked") == 0){
+			options->chunked = true;/*split a single source over the threads of -j*/
+		}
+		else if(strcmp(argv[i], "--serve") == 0){
+			if(i + 1 >= argc){
+				fprintf(stderr, "Error: option '%s' requires a value\n", argv[i]);
+				return -1;
+			}
+			options->serve_path = argv[++i];/*listen on the socket and skip the value of the option*/
+		}
+		else if(strcmp(argv[i], "--connect") == 0){
+			if(i + 1 >= argc){
+				fprintf(stderr, "Error: option '%s' requires a value\n", argv[i]);
+				return -1;
+			}
+			options->connect_path = argv[++i];/*forward the files to the socket and skip the value of the option*/
+		}
+		else if(strcmp(argv[i], "--cache") == 0){
+			if(i + 1 >= argc){
+				fprintf(stderr, "Error: option '%s' requires a value\n", argv[i]);
+				return -1;
+			}
+			options->cache_directory = argv[++i];/*use the cache and skip the value of the option*/
+		}
+		else if(strcmp(argv[i], "--cache-size") == 0){
+			if(!parse_number_argument(argv[i], i + 1 < argc ? argv[i + 1] : NULL, &value)){
+				return -1;
+			}
+			options->cache_size = value * 1048576L;/*the limit is given in megabytes*/
+			i++;/*skip the value of the option*/
+		}
+		else if(strcmp(argv[i], "--max-errors") == 0){
+			if(!parse_number_argument(argv[i], i + 1 < argc ? argv[i + 1] : NULL, &value)){
+				return -1;
+			}
+			options->max_errors = value > INT_MAX ? 0 : (int)value;/*a limit beyond INT_MAX is no limit*/
+			i++;/*skip the value of the option*/
+		}
+		else if(strcmp(argv[i], "--cache-stats") == 0){
+			options->cache_stats = true;/*print the cache counters*/
+		}
+		else if(strcmp(argv[i], "--watch") == 0){
+			options->watch = true;/*keep the outputs up to date*/
+		}
+		else if(strcmp(argv[i], "--files-from") == 0){
+			if(i + 1 >= argc){
+				fprintf(stderr, "Error: option '%s' requires a value\n", argv[i]);
+				return -1;
+			}
+			options->files_from = argv[++i];/*read the list of files and skip the value of the option*/
+		}
+		else if(strcmp(argv[i], "--stdio") == 0){
+			options->stdio = true;/*use the standard streams instead of files*/
+		}
+		else if(strcmp(argv[i], "--check") == 0){
+			options->check_only = true;/*check the files without writing outputs*/
+		}
+		else if(strcmp(argv[i], "--stats") == 0){
+			options->stats = true;/*measure the files*/
+		}
+		else if(strcmp(argv[i], "--stats-json") == 0){
+			if(i + 1 >= argc){
+				fprintf(stderr, "Error: option '%s' requires a value\n", argv[i]);
+				return -1;
+			}
+			options->stats_json = argv[++i];/*write the statistics as JSON and skip the value of the option*/
+		}
+		else if(strcmp(argv[i], "--perf-counters") == 0){
+			options->perf_counters = true;/*read the counters of the processor*/
+		}
+		else if(strcmp(argv[i], "--trace") == 0){
+			if(i + 1 >= argc){
+				fprintf(stderr, "Error: option '%s' requires a value\n", argv[i]);
+				return -1;
+			}
+			options->trace_path = argv[++i];/*record the trace and skip the value of the option*/
+		}
+		else if(strncmp(argv[i], "--trace=", 8) == 0 && argv[i][8] != '\0'){
+			options->trace_path = argv[i] + 8;/*the value may also follow an equals sign*/
+		}
+		else if(strcmp(argv[i], "--lsp") == 0){
+			options->language_server = true;/*serve an editor instead of assembling files*/
+		}
+		else{
+			fprintf(stderr, "Error: unknown option '%s'\n", argv[i]);
+			return -1;/*the option is not recognized*/
+		}
+	}
+	if(options->batch_io && options->jobs != 1){/*the batched I/O runs on a single thread*/
+		fprintf(stderr, "Error: option '--batch-io' can't be combined with '-j'\n");
+		return -1;
+	}
+	if(options->chunked && options->jobs == 1){/*the chunks run on the threads of -j*/
+		fprintf(stderr, "Error: option '--chunked' requires '-j'\n");
+		return -1;
+	}
+	if(options->cache_stats && !options->cache_directory){/*the counters belong to a cache directory*/
+		fprintf(stderr, "Error: option '--cache-stats' requires '--cache'\n");
+		return -1;
+	}
+	if(options->cache_directory && options->batch_io){/*the batched writes never reach the disk sink the cache copies from*/
+		fprintf(stderr, "Error: option '--cache' can't be combined with '--batch-io'\n");
+		return -1;
+	}
+	if(options->watch && (options->batch_io || options->serve_path || options->connect_path)){/*the watched files are assembled in this process*/
+		fprintf(stderr, "Error: option '--watch' can't be combined with '--batch-io' '--serve' or '--connect'\n");
+		return -1;
+	}
+	if(options->language_server && (options->batch_io || options->serve_path || options->connect_path || options->cache_directory || options->watch)){/*the server writes no outputs*/
+		fprintf(stderr, "Error: option '--lsp' can't be combined with '--batch-io' '--serve' '--connect' '--cache' or '--watch'\n");
+		return -1;
+	}
+	if(options->files_from && (options->serve_path || options->language_server)){/*neither mode takes files*/
+		fprintf(stderr, "Error: option '--files-from' can't be combined with '--serve' or '--lsp'\n");
+		return -1;
+	}
+	if(options->stdio && (options->files_from || options->batch_io || options->serve_path || options->connect_path || options->cache_directory || options->watch || options->language_server)){/*a single source goes through memory*/
+		fprintf(stderr, "Error: option '--stdio' can't be combined with '--files-from' '--batch-io' '--serve' '--connect' '--cache' '--watch' or '--lsp'\n");
+		return -1;
+	}
+	if(options->check_only && (options->batch_io || options->serve_path || options->connect_path || options->cache_directory || options->watch || options->language_server || options->stdio)){/*the checks run in this process and write nothing*/
+		fprintf(stderr, "Error: option '--check' can't be combined with '--batch-io' '--serve' '--connect' '--cache' '--watch' '--lsp' or '--stdio'\n");
+		return -1;
+	}
+#ifdef NO_STATS
+	if(options->stats || options->stats_json || options->perf_counters || options->trace_path){/*the passes were built without their instrumentation*/
+		fprintf(stderr, "Error: options '--stats' '--perf-counters' and '--trace' are not available in this build (built with STATS=0)\n");
+		return -1;
+	}
+#endif
+	if((options->stats || options->stats_json) && (options->serve_path || options->connect_path || options->watch || options->stdio)){/*the files must be assembled by this run*/
+		fprintf(stderr, "Error: option '--stats' can't be combined with '--serve' '--connect' '--watch' or '--stdio'\n");
+		return -1;
+	}
+	if((options->stats_json || options->perf_counters) && options->language_server){/*--lsp --stats only prints the time of every update*/
+		fprintf(stderr, "Error: options '--stats-json' and '--perf-counters' can't be combined with '--lsp'\n");
+		return -1;
+	}
+	if(options->perf_counters && !options->stats && !options->stats_json){/*the counters are part of the statistics*/
+		fprintf(stderr, "Error: option '--perf-counters' requires '--stats' or '--stats-json'\n");
+		return -1;
+	}
+	if(options->trace_path && (options->serve_path || options->connect_path || options->watch || options->language_server || options->stdio)){/*the trace is written when the files are done*/
+		fprintf(stderr, "Error: option '--trace' can't be combined with '--serve' '--connect' '--watch' '--lsp' or '--stdio'\n");
+		return -1;
+	}
+	if(options->serve_path && options->connect_path){/*a daemon does not forward to another daemon*/
+		fprintf(stderr, "Error: option '--serve' can't be combined with '--connect'\n");
+		return -1;
+	}
+	return i;/*return the index of the first file argument*/
+}
@@ -0,0 +1,61 @@
+#ifndef OPTIONS_H
+#define OPTIONS_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "definitions.h"
+
+/*** STRUCTURE DEFINITIONS SECTION ***/
+
+/*format of the object output*/
+typedef enum object_formats{
+	/*the classic text .ob .ent and .ext files*/
+	TEXT_OBJECT = 0,
+	/*a single binary .obb file that a loader can map directly*/
+	BINARY_OBJECT = 1
+}object_format;
+
+/*typedef for the cycles the cost report charges (see cost_report.h)*/
+typedef struct{
+	int operation_cycles[OPERATION_COUNT];/*cycles of every operation indexed by its opcode*/
+	int mode_cycles[ADDRESSING_MODE_COUNT];/*cycles every operand adds indexed by its addressing mode (immediate direct relative register)*/
+}CostTable;
+
+/*typedef for the command line options of the assembler*/
+typedef struct{
+	object_format format;/*format of the object output*/
+	long load_base;/*address the program is placed at (IC_INIT_VALUE by default)*/
+	bool write_relocations;/*write the relocation table to a text .rel file*/
+	bool write_map;/*write the map from the addresses back to the source lines to a .map file*/
+	bool write_report;/*write the cost of every region of the program to a .report file*/
+	bool write_report_json;/*write the cost of every region of the program to a .report.json file*/
+	CostTable cost_table;/*the cycles the cost report charges*/
+	bool batch_io;/*read the sources and write the outputs through batched I/O*/
+	int jobs;/*number of files assembled concurrently (0 for one per processor)*/
+	bool chunked;/*split a single source into chunks that both passes run on the jobs threads*/
+	const char *serve_path;/*socket the daemon listens on or NULL when not serving*/
+	const char *connect_path;/*socket of a daemon the files are forwarded to or NULL*/
+	const char *cache_directory;/*directory of the output cache or NULL to always assemble*/
+	long cache_size;/*size limit of the output cache in bytes*/
+	bool cache_stats;/*print the counters of the output cache*/
+	bool watch;/*stay resident and reassemble the files whenever they are saved*/
+	bool language_server;/*speak the language server protocol on stdin and stdout*/
+	const char *files_from;/*manifest the files are read from after the file arguments or NULL*/
+	bool stdio;/*read a single source from stdin and write its outputs to stdout as framed sections*/
+	int max_errors;/*errors after which a file is abandoned (0 for no limit)*/
+	bool check_only;/*only check the files without encoding them or writing any output*/
+	bool stats;/*measure the phases and the counters of every file and print them at the end*/
+	const char *stats_json;/*file the statistics are written to as JSON ("-" for stdout) or NULL*/
+	bool perf_counters;/*add the counters of the processor of every phase to the statistics*/
+	const char *trace_path;/*file the Chrome trace of the run is written to or NULL*/
+}AssemblerOptions;
+
+/*** FUNCTION PROTOTYPES SECTION ***/
+
+void initialize_options(AssemblerOptions *options);/*function to set every option to its default value*/
+int parse_options(int argc,char *argv[],AssemblerOptions *options);/*function to parse the leading options and return the index of the first file argument*/
+void print_usage(const char *program_name);/*function to print the usage instructions*/
+bool parse_number_argument(const char *option,const char *text,long *value);/*function to convert the value of a numeric option*/
+
+#endif /*OPTIONS_H*/
@@ -0,0 +1,262 @@
+#define _GNU_SOURCE/*syscall and perf_event_open are not part of ansi c*/
+#include "perf_counters.h"
+#include <errno.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#if defined(__linux__)
+#include <sys/syscall.h>
+#endif
+
+#if defined(__linux__) && defined(__NR_perf_event_open)
+#define HAVE_PERF_EVENTS 1
+#include <linux/perf_event.h>
+#endif
+
+/*** NAMES SECTION ***/
+
+/*
+* perf_counter_names
+* ------------------
+* the name of every counter in the reports indexed by perf_counter
+*/
+const char *perf_counter_names[PERF_COUNTER_COUNT] = {"cycles", "instructions", "branch_misses", "l1d_misses", "llc_misses", "page_faults"};
+
+#ifdef HAVE_PERF_EVENTS
+
+/*** COUNTER GROUP SECTION ***/
+
+/*
+* perf_state
+* ----------
+* perf_available is the mask of the counters start_perf_counters could open and is only changed before the threads start
+* every thread that reads counters opens its own group of them once and finds it through perf_key
+*/
+unsigned int perf_available = 0;
+pthread_key_t perf_key;
+pthread_once_t perf_key_once = PTHREAD_ONCE_INIT;
+
+typedef struct{/*the counters of a single thread*/
+	int leader;/*descriptor of the first counter of the group (the group is read through it) or -1*/
+	int descriptors[PERF_COUNTER_COUNT];/*descriptor of every counter or -1*/
+	int order[PERF_COUNTER_COUNT];/*the counter of every value a read of the group returns*/
+	int count;/*number of counters in the group*/
+	int error;/*errno of the first counter that could not be opened or 0*/
+}PerfGroup;
+
+/*
+* close_perf_group
+* ----------------
+* this function closes the counters of a thread when it exits
+*
+* parameters:
+*   group: the PerfGroup of the thread
+*
+*/
+void close_perf_group(void *group){
+	int i;
+
+	for(i=0 ; i<PERF_COUNTER_COUNT ; i++){
+		if(((PerfGroup*)group)->descriptors[i] >= 0){
+			close(((PerfGroup*)group)->descriptors[i]);
+		}
+	}
+	free(group);
+}
+
+/*
+* create_perf_key
+* ---------------
+* this function creates the thread specific key that holds the counters of each thread
+* it runs exactly once through pthread_once
+*
+*/
+void create_perf_key(void){
+	pthread_key_create(&perf_key, close_perf_group);
+}
+
+/*
+* open_perf_counter
+* -----------------
+* this function opens a counter of the user space of the calling thread that counts from now on
+*
+* parameters:
+*   counter: the counter
+*   leader: the descriptor of the group the counter joins or -1 to start a group
+*
+* returns:
+*   int: the descriptor or -1 when the counter is not available (errno tells why)
+*/
+int open_perf_counter(perf_counter counter, int leader){
+	struct perf_event_attr attributes;
+
+	memset(&attributes, 0, sizeof(attributes));
+	attributes.size = sizeof(attributes);
+	attributes.type = PERF_TYPE_HARDWARE;
+	attributes.exclude_kernel = 1;/*a paranoid kernel only lets a process count its own user space*/
+	attributes.exclude_hv = 1;
+	attributes.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+	switch(counter){
+		case PERF_CYCLES:
+			attributes.config = PERF_COUNT_HW_CPU_CYCLES;
+			break;
+		case PERF_INSTRUCTIONS:
+			attributes.config = PERF_COUNT_HW_INSTRUCTIONS;
+			break;
+		case PERF_BRANCH_MISSES:
+			attributes.config = PERF_COUNT_HW_BRANCH_MISSES;
+			break;
+		case PERF_L1D_MISSES:
+			attributes.type = PERF_TYPE_HW_CACHE;
+			attributes.config = PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+			break;
+		case PERF_LLC_MISSES:
+			attributes.type = PERF_TYPE_HW_CACHE;
+			attributes.config = PERF_COUNT_HW_CACHE_LL | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+			break;
+		default:
+			attributes.type = PERF_TYPE_SOFTWARE;
+			attributes.config = PERF_COUNT_SW_PAGE_FAULTS;
+			break;
+	}
+	return (int)syscall(__NR_perf_event_open, &attributes, 0, -1, leader, 0);
+}
+
+/*
+* thread_perf_group
+* -----------------
+* this function returns the counters of the calling thread and opens them the first time the thread reads them
+* only the counters in the mask are opened and every one joins the group of the first so they are read at once
+*
+* parameters:
+*   mask: the counters to open
+*
+* returns:
+*   PerfGroup*: the counters of the thread or NULL when memory ran out
+*/
+PerfGroup *thread_perf_group(unsigned int mask){
+	PerfGroup *group;
+	int i;
+
+	pthread_once(&perf_key_once, create_perf_key);
+	group = (PerfGroup*)pthread_getspecific(perf_key);
+	if(group){
+		return group;
+	}
+	group = (PerfGroup*)calloc(1, sizeof(PerfGroup));
+	if(!group){
+		return NULL;
+	}
+	group->leader = -1;
+	for(i=0 ; i<PERF_COUNTER_COUNT ; i++){
+		group->descriptors[i] = (mask & (1u << i)) ? open_perf_counter((perf_counter)i, group->leader) : -1;
+		if(group->descriptors[i] >= 0){
+			group->leader = group->leader < 0 ? group->descriptors[i] : group->leader;
+			group->order[group->count++] = i;
+		}
+		else if((mask & (1u << i)) && !group->error){
+			group->error = errno;
+		}
+	}
+	pthread_setspecific(perf_key, group);
+	return group;
+}
+
+/*
+* start_perf_counters
+* -------------------
+* this function opens the counters on the calling thread to learn which of them are available
+* and prints a single warning naming the counters that are not
+* it must be called before the threads that read counters are started
+*
+* returns:
+*   unsigned int: the mask of the available counters (bit i for perf_counter i) or 0 when none is
+*/
+unsigned int start_perf_counters(void){
+	PerfGroup *group = thread_perf_group((1u << PERF_COUNTER_COUNT) - 1);
+	int i;
+
+	if(!group){
+		fprintf(stderr, "Warning: the hardware counters are not available: out of memory\n");
+		return 0;
+	}
+	for(i=0 ; i<group->count ; i++){
+		perf_available |= 1u << group->order[i];
+	}
+	if(group->count < PERF_COUNTER_COUNT){
+		fprintf(stderr, "Warning: the hardware counters");
+		for(i=0 ; i<PERF_COUNTER_COUNT ; i++){
+			if(!(perf_available & (1u << i))){
+				fprintf(stderr, " %s", perf_counter_names[i]);
+			}
+		}
+		fprintf(stderr, " are not available (perf_event_open: %s)\n", strerror(group->error));
+	}
+	return perf_available;
+}
+
+/*
+* read_perf_counters
+* ------------------
+* this function reads the counters of the calling thread
+* a counter the kernel could only count for part of the time (too many counters for the processor) is scaled to the whole time
+*
+* parameters:
+*   values: receives the value of every counter (the counters that are not available read 0)
+*
+* returns:
+*   bool: true if the counters were read false when none is available
+*/
+bool read_perf_counters(unsigned long *values){
+	PerfGroup *group;
+	__u64 buffer[3 + PERF_COUNTER_COUNT];/*number of values, time enabled, time running and the values*/
+	int i;
+
+	if(!perf_available || !(group = thread_perf_group(perf_available)) || group->leader < 0){
+		return false;
+	}
+	if(read(group->leader, buffer, sizeof(buffer)) < (ssize_t)(3 * sizeof(__u64))){
+		return false;
+	}
+	memset(values, 0, PERF_COUNTER_COUNT * sizeof(unsigned long));
+	for(i=0 ; i<group->count && i<(int)buffer[0] ; i++){
+		values[group->order[i]] = (unsigned long)(buffer[2] > 0 && buffer[2] < buffer[1] ?
+			(double)buffer[3 + i] * ((double)buffer[1] / (double)buffer[2]) : (double)buffer[3 + i]);
+	}
+	return true;
+}
+
+#else
+
+/*** COUNTER GROUP SECTION ***/
+
+/*
+* start_perf_counters
+* -------------------
+* this function reports that the counters of the processor are only read on linux
+*
+* returns:
+*   unsigned int: 0 since no counter is available
+*/
+unsigned int start_perf_counters(void){
+	fprintf(stderr, "Warning: the hardware counters are only available on linux\n");
+	return 0;
+}
+
+/*
+* read_perf_counters
+* ------------------
+* this function reads nothing since the counters of the processor are only read on linux
+*
+* parameters:
+*   values: unused
+*
+* returns:
+*   bool: false
+*/
+bool read_perf_counters(unsigned long *values){
+	(void)values;
+	return false;
+}
+
+#endif
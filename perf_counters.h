@@ -0,0 +1,42 @@
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "definitions.h"
+
+/*
+* hardware counters
+* -----------------
+* --perf-counters adds counters of the processor to --stats: cycles instructions branch misses
+* misses of the L1 data cache and of the last level cache and page faults
+* they are read through perf_event_open on linux without any external tool and count the user space of the calling thread
+* so like the times they are charged to the phase the thread is in and the files of -j are counted separately
+* a counter the kernel does not permit (perf_event_paranoid) or the processor does not have (most virtual machines)
+* is left out after a single warning and the statistics are printed without it
+*/
+
+/*** STRUCTURE DEFINITIONS SECTION ***/
+
+/*counters of the processor*/
+typedef enum perf_counters{
+	PERF_CYCLES = 0,/*processor cycles*/
+	PERF_INSTRUCTIONS = 1,/*instructions retired*/
+	PERF_BRANCH_MISSES = 2,/*mispredicted branches*/
+	PERF_L1D_MISSES = 3,/*reads that missed the L1 data cache*/
+	PERF_LLC_MISSES = 4,/*reads that missed the last level cache*/
+	PERF_PAGE_FAULTS = 5,/*page faults*/
+	PERF_COUNTER_COUNT = 6/*number of counters*/
+}perf_counter;
+
+/*** EXTERNAL DECLARATIONS SECTION ***/
+
+extern const char *perf_counter_names[PERF_COUNTER_COUNT];
+
+/*** FUNCTION PROTOTYPES SECTION ***/
+
+unsigned int start_perf_counters(void);/*function to open the counters on the calling thread and return the mask of the available ones*/
+bool read_perf_counters(unsigned long *values);/*function to read the counters of the calling thread*/
+
+#endif /*PERF_COUNTERS_H*/
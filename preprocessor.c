@@ -1,4 +1,7 @@
 #include "preprocessor.h"
+#include "utils.h"
+#include "stats.h"
+#include <ctype.h>
 
 /*** INVALID NAMES SECTION ***/
 
@@ -9,7 +12,7 @@
 * this array includes the names of operations and registers that cannot be used as macro names
 * by storing these in a central array it allows for easy checking when validating macro names
 */
-const char *invalid_names[] = {
+const char *const invalid_names[] = {
 	"mov","cmp","add","sub","lea","clr","not","inc",
 	"dec","jmp","bne","red","prn","jsr","rts","stop",
 	"r0","r1","r2","r3","r4","r5","r6","r7"
@@ -20,18 +23,48 @@ const char *invalid_names[] = {
 /* 
 * initialize_macro_array
 * ----------------------
-* this function initializes a MacroArray by allocating memory for the initial array of macros
+* this function initializes a MacroArray by allocating memory for the initial array of macros and its index
 * it also sets the initial count and capacity of the array
 * initializing the macro array is necessary before any macros can be added to it
 * 
 * parameters:
 *   array: a pointer to the MacroArray structure that will be initialized
 * 
+* returns:
+*   bool: true if the array was allocated false otherwise
 */
-void initialize_macro_array(MacroArray *array){
-	array->macros=(Macro*)malloc(sizeof(Macro)*INITIAL_MACRO_COUNT);/*allocate initial memory for the macros array*/
+bool initialize_macro_array(MacroArray *array){
+	array->macros=(Macro*)STATS_MALLOC(MEMORY_MACROS, sizeof(Macro)*INITIAL_MACRO_COUNT);/*allocate initial memory for the macros array*/
+	array->index=(int*)STATS_CALLOC(MEMORY_MACROS, INITIAL_MACRO_INDEX_SIZE, sizeof(int));/*every slot of the index starts free*/
 	array->count=0;/*initialize macro count to 0*/
 	array->capacity=INITIAL_MACRO_COUNT;/*set the initial capacity*/
+	array->index_size=INITIAL_MACRO_INDEX_SIZE;
+	if(array->macros==NULL || array->index==NULL){/*ensure malloc succeeded*/
+		print_system_error("malloc failed");
+		STATS_FREE(array->macros);
+		STATS_FREE(array->index);
+		return false;
+	}
+	return true;
+}
+
+/* 
+* index_macro
+* -----------
+* this function puts the position of a macro in the first free slot the hash of its name leads to
+* 
+* parameters:
+*   index: the index
+*   index_size: the number of slots of the index (a power of two)
+*   name: the name of the macro
+*   position: the position of the macro in the array
+* 
+*/
+void index_macro(int *index,int index_size,const char *name,int position){
+	unsigned long slot;
+
+	for(slot=hash_label(name)&(index_size-1) ; index[slot] ; slot=(slot+1)&(index_size-1));
+	index[slot]=position+1;
 }
 
 /* 
@@ -39,6 +72,7 @@ void initialize_macro_array(MacroArray *array){
 * ---------
 * this function adds a new macro to the MacroArray
 * if the array has reached its capacity it reallocates memory to accommodate more macros
+* and once the index is half full it doubles the index and puts every macro in it again
 * it then stores the macros name content and the number of lines it contains in the array
 * this function ensures that macros are stored dynamically as the array expands
 * 
@@ -46,22 +80,77 @@ void initialize_macro_array(MacroArray *array){
 *   array: a pointer to the MacroArray structure where the macro will be added
 *   name: the name of the macro which must be unique and valid
 *   content: an array of strings representing the lines of code within the macro
+*   lines: the source line of every line of the content or NULL
 *   line_count: the number of lines in the macro content array
 * 
+* returns:
+*   bool: true if the macro was added and the array took ownership of its content and lines false otherwise
 */
-void add_macro(MacroArray *array,const char *name,char **content,int line_count){
+bool add_macro(MacroArray *array,const char *name,char **content,int *lines,int line_count){
+	Macro *macros;/*pointer to the expanded array*/
+	char *macro_name;/*copy of the macro name*/
+	int *index;/*pointer to the expanded index*/
+	int i;
+
 	if(array->count>=array->capacity){/*if capacity is too low, double it and reallocate memory*/
+		macros=(Macro*)STATS_REALLOC(MEMORY_MACROS, array->macros, sizeof(Macro)*array->capacity*2);/*reallocate memory for the expanded array*/
+		if(macros==NULL){/*ensure realloc succeeded*/
+			print_system_error("realloc failed");
+			return false;
+		}
+		array->macros=macros;
 		array->capacity*=2;/*double the capacity*/
-		array->macros=(Macro*)realloc(array->macros,sizeof(Macro)*array->capacity);/*reallocate memory for the expanded array*/
-		if(array->macros==NULL){/*ensure realloc succeeded*/
-			perror("realloc failed");
-			exit(EXIT_FAILURE);
+	}
+	if((array->count+1)*2>array->index_size){/*keep the probes of the index short*/
+		index=(int*)STATS_CALLOC(MEMORY_MACROS, array->index_size*2, sizeof(int));
+		if(index==NULL){
+			print_system_error("calloc failed");
+			return false;
+		}
+		for(i=0 ; i<array->count ; i++){
+			index_macro(index, array->index_size*2, array->macros[i].name, i);
 		}
+		STATS_FREE(array->index);
+		array->index=index;
+		array->index_size*=2;
 	}
-	array->macros[array->count].name=allocate_and_copy_string(name);/*store the macro name*/
+	macro_name=allocate_and_copy_string(name);
+	if(macro_name==NULL){
+		return false;
+	}
+	array->macros[array->count].name=macro_name;/*store the macro name*/
 	array->macros[array->count].content=content;/*store the macro content*/
+	array->macros[array->count].lines=lines;/*store the source lines of the content*/
 	array->macros[array->count].line_count=line_count;/*store the number of lines in the macro*/
+	index_macro(array->index, array->index_size, macro_name, array->count);
 	array->count++;/*increment the count of macros in the array*/
+	return true;
+}
+
+/* 
+* find_macro
+* ----------
+* this function looks a macro up by its name in the MacroArray
+* the name is looked up in the index so the time it takes does not grow with the number of macros
+* 
+* parameters:
+*   array: a pointer to the MacroArray structure that contains all macros
+*   name: the name of the macro to find
+* 
+* returns:
+*   Macro*: the macro or NULL if no macro has the name
+*/
+Macro *find_macro(MacroArray *array, const char *name){
+	unsigned long slot;
+	Macro *macro;
+
+	for(slot = hash_label(name) & (array->index_size - 1) ; array->index[slot] ; slot = (slot + 1) & (array->index_size - 1)){
+		macro = &array->macros[array->index[slot] - 1];
+		if(strcmp(macro->name, name) == 0){
+			return macro;
+		}
+	}
+	return NULL;
 }
 
 /* 
@@ -69,7 +158,6 @@ void add_macro(MacroArray *array,const char *name,char **content,int line_count)
 * -----------------
 * this function retrieves the content of a macro by its name from the MacroArray
 * it also provides the number of lines in the macros content
-* this function is used during preprocessing to expand macros into their full content in the output file
 * 
 * parameters:
 *   array: a pointer to the MacroArray structure that contains all macros
@@ -80,14 +168,13 @@ void add_macro(MacroArray *array,const char *name,char **content,int line_count)
 *   char**: a pointer to the array of strings representing the macro's content or NULL if the macro is not found
 */
 char **get_macro_content(MacroArray *array, const char *name, int *line_count) {
-    int i;
-    for (i = 0; i < array->count; i++) {
-        if (strcmp(array->macros[i].name, name) == 0) { /* Correctly compare strings */
-            *line_count = array->macros[i].line_count; /* set the line count to the macro's line count */
-            return array->macros[i].content; /* return the content of the macro */
-        }
-    }
-    return NULL; /* return NULL if no matching macro is found */
+	Macro *macro = find_macro(array, name);
+
+	if(macro == NULL){
+		return NULL;
+	}
+	*line_count = macro->line_count;/*set the line count to the macro's line count*/
+	return macro->content;/*return the content of the macro*/
 }
 
 
@@ -105,13 +192,35 @@ char **get_macro_content(MacroArray *array, const char *name, int *line_count) {
 void free_macro_array(MacroArray *array){
 	int i,j;
 	for(i=0 ; i<array->count ; i++){/*iterate through all the macros in the array*/
-		free(array->macros[i].name);/*free the memory allocated for the macro name*/
+		STATS_FREE(array->macros[i].name);/*free the memory allocated for the macro name*/
 		for(j=0;j<array->macros[i].line_count;j++){/*iterate through the macro's content*/
-			free(array->macros[i].content[j]);/*free each line of the macro's content*/
+			STATS_FREE(array->macros[i].content[j]);/*free each line of the macro's content*/
 		}
-		free(array->macros[i].content);/*free the macro content pointer*/
+		STATS_FREE(array->macros[i].content);/*free the macro content pointer*/
+		STATS_FREE(array->macros[i].lines);/*free the source lines of the content*/
+	}
+	STATS_FREE(array->macros);/*free the macro array itself*/
+	STATS_FREE(array->index);/*free the index of the names*/
+}
+
+/* 
+* free_macro_content
+* ------------------
+* this function frees the lines of a macro definition that was not added to a MacroArray
+* 
+* parameters:
+*   content: the array of lines of the macro or NULL
+*   lines: the source line of every line of the macro or NULL
+*   line_count: the number of lines in the array
+* 
+*/
+void free_macro_content(char **content,int *lines,int line_count){
+	int i;
+	for(i=0 ; content!=NULL && i<line_count ; i++){/*iterate through the macro's content*/
+		STATS_FREE(content[i]);/*free each line of the macro's content*/
 	}
-	free(array->macros);/*free the macro array itself*/
+	STATS_FREE(content);/*free the macro content pointer*/
+	STATS_FREE(lines);/*free the source lines of the content*/
 }
 
 /*** MACRO NAME VALIDATION SECTION ***/
@@ -150,13 +259,14 @@ bool is_valid_macro_name(const char *name){
 *   s: the string to be copied
 * 
 * returns:
-*   char*: a pointer to the newly allocated and copied string
+*   char*: a pointer to the newly allocated and copied string or NULL if memory ran out
 */
 char *allocate_and_copy_string(const char *s){
-	char *d=malloc(strlen(s)+1);/*allocate memory for the string*/
+	char *d=STATS_MALLOC(MEMORY_MACROS, strlen(s)+1);/*allocate memory for the string*/
+
 	if(d==NULL){/*ensure malloc succeeds*/
-		perror("malloc failed");
-		exit(EXIT_FAILURE);
+		print_system_error("malloc failed");
+		return NULL;
 	}
 	strcpy(d,s);/*copy the string into the allocated memory*/
 	return d;/*return the pointer to the copied string*/
@@ -168,9 +278,7 @@ char *allocate_and_copy_string(const char *s){
 * preprocess_file
 * ---------------
 * this function preprocesses an assembly source file by expanding macros and writing the result to a new file with a .am extension
-* it reads the input file line by line checking for macro definitions and expanding any macros that are called
-* the function handles the creation and management of macros including their storage retrieval and expansion
-* it also manages the input and output files ensuring that the preprocessed file is correctly generated
+* it manages the input and output files and leaves the expansion itself to preprocess_stream
 * 
 * parameters:
 *   input_filename: the name of the assembly source file to preprocess
@@ -181,51 +289,255 @@ char *allocate_and_copy_string(const char *s){
 bool preprocess_file(const char *input_filename){
 	FILE *input_file;
 	FILE *output_file;
-
-	MacroArray macros;/*declare a MacroArray to store all macros*/
-	char line[MAX_LINE_LENGTH];/*buffer to hold each line of the input file*/
-	int in_macro = false;/*flag to indicate if we are inside a macro definition*/
-	char macro_name[MAX_LINE_LENGTH];/*buffer to hold the name of the macro being defined*/
-	char **macro_content = NULL;/*pointer to hold the content of the macro being defined*/
-	int macro_lines = 0;/*number of lines in the macro*/
-	int macro_capacity = 0;/*capacity of the macro content array*/
-	char output_line[MAX_LINE_LENGTH];/*buffer for the line to be written to the output file*/
-	char word[MAX_LINE_LENGTH];/*buffer to hold a word extracted from the line*/
-	int word_len;/*length of the extracted word*/
-	int macro_line_count;/*number of lines in the macro being retrieved*/
-	char **macro_def;/*pointer to the content of the retrieved macro*/
-	int i;/*loop variable*/
-	char *start;/*initialize pointer*/
-	char *colon;/*pointer to locate the colon in the label*/
-	char output_filename[MAX_FILENAME_LENGTH];/*buffer to store the output filename*/
+	bool success;
+	char *output_filename;/*the output filename*/
 	char *dot = strrchr(input_filename, '.');/*find the last occurrence of a dot in the input filename*/
 
 	/*check if the file has a .as extension*/
 	if(dot != NULL && strcmp(dot, ".as") == false){
-		strncpy(output_filename, input_filename, dot - input_filename);/*copy the input filename up to the dot into the output filename buffer*/
-		output_filename[dot - input_filename] = '\0';/*terminate the string in the output filename buffer*/
-		strcat(output_filename, ".am");/*append the .am extension to the output filename*/
+		output_filename = make_path(input_filename, NULL, NULL);/*copy the input filename*/
+		if(!output_filename){
+			print_system_error("malloc failed");
+			return false;
+		}
+		strcpy(output_filename + (dot - input_filename), ".am");/*replace the .as extension with .am*/
 	}
 	else{
-		fprintf(stderr, "Invalid input file extension. Expected .as\n");
+		fprintf(error_output(), "Invalid input file extension. Expected .as\n");
 		return false;/*return false if the input file doesn't have a .as extension*/
 	}
 
 	input_file = fopen(input_filename, "r");
-	output_file = fopen(output_filename, "w");
 	if(!input_file){
-		perror("Error opening input file");
+		print_system_error("Error opening input file");
+		free(output_filename);
 		return false;
 	}
+	output_file = fopen(output_filename, "w");
+	free(output_filename);
 	if(!output_file){
-		perror("Error opening output file");
+		print_system_error("Error opening output file");
 		fclose(input_file);
 		return false;
 	}
 
-	initialize_macro_array(&macros);/*initialize the macro array*/
+	success = preprocess_stream(input_file, output_file);/*expand the macros into the .am file*/
+
+	fclose(input_file);/*close the input file*/
+	fclose(output_file);/*close the output file*/
+	return success;
+}
+
+/* 
+* preprocess_stream
+* -----------------
+* this function preprocesses assembly source read from a stream by expanding macros and writing the result to another stream
+* it reads the input line by line checking for macro definitions and expanding any macros that are called
+* the function handles the creation and management of macros including their storage retrieval and expansion
+* the streams may be files on disk or buffers in memory so the preprocessed source never has to touch the disk
+* 
+* parameters:
+*   input_file: the stream holding the assembly source
+*   output_file: the stream that receives the preprocessed source
+* 
+* returns:
+*   bool: true if the preprocessing was successful and false if an error occurred
+*/
+bool preprocess_stream(FILE *input_file, FILE *output_file){
+	return preprocess_stream_mapped(input_file, output_file, NULL);
+}
+
+/* 
+* map_output_lines
+* ----------------
+* this function records the source line of every line that starts in a piece of preprocessed output
+* a line of the output starts with its first character so a source line that was read in several pieces is mapped once
+* 
+* parameters:
+*   map: the map that receives the source lines
+*   output: the piece of output written for the source line
+*   source_line: the 1 based source line that produced the output
+*   origin: the macro line the output was expanded from (recorded when the map tracks origins)
+*   at_line_start: true when the output written so far ends with a newline (updated by the function)
+* 
+* returns:
+*   bool: true if the lines were recorded false if memory ran out
+*/
+bool map_output_lines(LineMap *map, const char *output, int source_line, const LineOrigin *origin, bool *at_line_start){
+	int *lines;/*pointer to the expanded array*/
+	LineOrigin *origins;/*pointer to the expanded origins*/
+	int capacity;/*the expanded capacity*/
+
+	for( ; *output ; output++){
+		if(*at_line_start){/*a new line of output starts here*/
+			if(map->count >= map->capacity){
+				capacity = map->capacity ? map->capacity * 2 : 64;
+				lines = (int*)STATS_REALLOC(MEMORY_OTHER, map->lines, sizeof(int) * capacity);
+				if(lines == NULL){
+					print_system_error("realloc failed");
+					return false;
+				}
+				map->lines = lines;
+				if(map->track_origins){
+					origins = (LineOrigin*)STATS_REALLOC(MEMORY_OTHER, map->origins, sizeof(LineOrigin) * capacity);
+					if(origins == NULL){
+						print_system_error("realloc failed");
+						return false;
+					}
+					map->origins = origins;
+				}
+				map->capacity = capacity;
+			}
+			if(map->track_origins){
+				map->origins[map->count] = *origin;
+			}
+			map->lines[map->count++] = source_line;
+		}
+		*at_line_start = (*output == '\n');
+	}
+	return true;
+}
+
+/* 
+* initialize_line_map
+* -------------------
+* this function prepares an empty LineMap
+* 
+* parameters:
+*   map: the map to prepare
+*   track_origins: true to also record the macro line every preprocessed line was expanded from and the names of the macros
+* 
+*/
+void initialize_line_map(LineMap *map, bool track_origins){
+	memset(map, 0, sizeof(LineMap));
+	map->track_origins = track_origins;
+}
+
+/* 
+* free_macro_names
+* ----------------
+* this function frees the names of the macros a LineMap took from the preprocessor
+* 
+* parameters:
+*   map: the map
+* 
+*/
+void free_macro_names(LineMap *map){
+	int i;
+
+	for(i=0 ; i<map->macro_count ; i++){
+		STATS_FREE(map->macro_names[i]);
+	}
+	STATS_FREE(map->macro_names);
+	map->macro_names = NULL;
+	map->macro_count = 0;
+}
+
+/* 
+* free_line_map
+* -------------
+* this function frees everything a LineMap holds and leaves it empty
+* 
+* parameters:
+*   map: the map
+* 
+*/
+void free_line_map(LineMap *map){
+	free_macro_names(map);
+	STATS_FREE(map->lines);
+	STATS_FREE(map->origins);
+	initialize_line_map(map, map->track_origins);
+}
+
+/* 
+* take_macro_names
+* ----------------
+* this function moves the names of the macros of a source into a LineMap that tracks origins
+* the position of a name is the position of the macro in the MacroArray which the origins refer to
+* 
+* parameters:
+*   map: the map
+*   macros: the macros (their names are left NULL)
+* 
+* returns:
+*   bool: true if the names were moved false if memory ran out
+*/
+bool take_macro_names(LineMap *map, MacroArray *macros){
+	int i;
+
+	if(macros->count == 0){
+		return true;
+	}
+	map->macro_names = (char**)STATS_MALLOC(MEMORY_OTHER, sizeof(char*) * macros->count);
+	if(map->macro_names == NULL){
+		print_system_error("malloc failed");
+		return false;
+	}
+	for(i=0 ; i<macros->count ; i++){
+		map->macro_names[i] = macros->macros[i].name;
+		macros->macros[i].name = NULL;
+	}
+	map->macro_count = macros->count;
+	return true;
+}
+
+/* 
+* preprocess_stream_mapped
+* ------------------------
+* this function expands the macros of a source stream like preprocess_stream
+* and records in a map which source line produced every line of the output
+* macro definitions and comments produce no line while a macro call produces one line for each line of the macro
+* a map that tracks origins also gets the line of the definition and the macro every expanded line came from
+* 
+* parameters:
+*   input_file: the stream holding the assembly source
+*   output_file: the stream that receives the preprocessed source
+*   map: the map that receives the source lines (its lines start empty) or NULL
+* 
+* returns:
+*   bool: true if the preprocessing was successful and false if an error occurred
+*/
+bool preprocess_stream_mapped(FILE *input_file, FILE *output_file, LineMap *map){
+	MacroArray macros;/*declare a MacroArray to store all macros*/
+	char line[MAX_LINE_LENGTH];/*buffer to hold each line of the input file*/
+	int in_macro = false;/*flag to indicate if we are inside a macro definition*/
+	char macro_name[MAX_LINE_LENGTH];/*buffer to hold the name of the macro being defined*/
+	char **macro_content = NULL;/*pointer to hold the content of the macro being defined*/
+	int *macro_content_lines = NULL;/*source line of every line of the macro being defined when there is a map*/
+	int *expanded_lines;/*pointer to the expanded source lines of the macro*/
+	int macro_lines = 0;/*number of lines in the macro*/
+	int macro_capacity = 0;/*capacity of the macro content array*/
+	char output_line[MAX_LINE_LENGTH];/*buffer for the line to be written to the output file*/
+	char word[MAX_LINE_LENGTH];/*buffer to hold a word extracted from the line*/
+	int word_len;/*length of the extracted word*/
+	char *word_start;/*first character of the word*/
+	int output_length;/*length of the output line*/
+	Macro *macro;/*the macro a word names*/
+	LineOrigin origin = {0, -1};/*the origin of a line that was not expanded from a macro*/
+	LineOrigin macro_origin;/*the origin of a line of an expanded macro*/
+	int i;/*loop variable*/
+	char *start;/*initialize pointer*/
+	char *colon;/*pointer to locate the colon in the label*/
+	char **expanded_content;/*pointer to the expanded macro content*/
+	bool line_read = true;/*true when the previous read ended the source line*/
+	bool output_line_start = true;/*true when the output written so far ends with a newline*/
+
+	if(map){
+		map->count = 0;
+		map->source_line = 0;
+		free_macro_names(map);
+	}
+	if(!initialize_macro_array(&macros)){/*initialize the macro array*/
+		return false;
+	}
 
 	while(fgets(line, sizeof(line), input_file)){/*read a line from the input file*/
+		STATS_COUNT(COUNTER_BYTES_READ, strlen(line));
+		STATS_COUNT(COUNTER_LINES, strchr(line, '\n') != NULL || feof(input_file));/*count a long line once*/
+		if(map){/*a line longer than the buffer is read in several pieces*/
+			map->source_line += line_read;
+			line_read = (strchr(line, '\n') != NULL);
+		}
 		if(line[0] == ';'){/*skip comment lines*/
 			continue;
 		}
@@ -242,41 +554,77 @@ bool preprocess_file(const char *input_filename){
 			sscanf(macro_def_check, "%s", macro_name);/*read the macro name*/
 
 			if(!is_valid_macro_name(macro_name)){/*check if the macro name is valid*/
-				fprintf(stderr, "Invalid macro name: %s\n", macro_name);
-				fclose(input_file);
-				fclose(output_file);
+				report_error("Invalid macro name: %s\n", macro_name);
+				free_macro_content(macro_content, macro_content_lines, macro_lines);/*free a definition that was never closed*/
 				free_macro_array(&macros);
 				return false;/*macro name is invalid*/
 			}
+			free_macro_content(macro_content, macro_content_lines, macro_lines);/*free a definition that was never closed*/
 
 			in_macro = true;/*set the in_macro flag to true indicating that we are now inside a macro definition*/
 			macro_capacity = 10;/*set the initial capacity for macro lines*/
 			macro_lines = 0; /*initialize the line count to 0*/
-			macro_content = (char **)malloc(sizeof(char *) * macro_capacity);/*allocate memory for macro lines*/
-			if(macro_content == NULL){
-				perror("malloc failed");
-				exit(EXIT_FAILURE);
+			macro_content = (char **)STATS_MALLOC(MEMORY_MACROS, sizeof(char *) * macro_capacity);/*allocate memory for macro lines*/
+			macro_content_lines = map ? (int*)STATS_MALLOC(MEMORY_MACROS, sizeof(int) * macro_capacity) : NULL;/*the source lines are only counted for a map*/
+			if(macro_content == NULL || (map && macro_content_lines == NULL)){
+				print_system_error("malloc failed");
+				free_macro_content(macro_content, macro_content_lines, 0);
+				free_macro_array(&macros);
+				return false;
 			}
 			continue;
 		}
 
 		if(strncmp(start, "endmacr", 7) == false){ /*check if the line starts with "endmacr"*/
-			add_macro(&macros, macro_name, macro_content, macro_lines);/*add the macro to the macro array*/
+			if(!in_macro){/*an editor sends sources that are still being written*/
+				report_error("Error: endmacr without a macro definition\n");
+				free_macro_array(&macros);
+				return false;
+			}
+			if(!add_macro(&macros, macro_name, macro_content, macro_content_lines, macro_lines)){/*add the macro to the macro array*/
+				free_macro_content(macro_content, macro_content_lines, macro_lines);
+				free_macro_array(&macros);
+				return false;
+			}
+			STATS_COUNT(COUNTER_MACROS_DEFINED, 1);
 			in_macro = false;/*set the in_macro flag to false, indicating that we are no longer inside a macro definition*/
 			macro_content = NULL;/*reset macro_content pointer to NULL*/
+			macro_content_lines = NULL;
 			continue;
 		}
 
 		if(in_macro){/*if we are inside a macro definition*/
 			if(macro_lines >= macro_capacity){/*check if the macro content array needs to be resized*/
-				macro_capacity *= 2;/*double the capacity*/
-				macro_content = (char **)realloc(macro_content, sizeof(char *)*macro_capacity);/*reallocate memory for the expanded array*/
-				if(macro_content == NULL){/*ensure realloc succeeds*/
-					perror("realloc failed");
-					exit(EXIT_FAILURE);
+				expanded_content = (char **)STATS_REALLOC(MEMORY_MACROS, macro_content, sizeof(char *)*macro_capacity*2);/*reallocate memory for the expanded array*/
+				if(expanded_content == NULL){/*ensure realloc succeeds*/
+					print_system_error("realloc failed");
+					free_macro_content(macro_content, macro_content_lines, macro_lines);
+					free_macro_array(&macros);
+					return false;
 				}
+				macro_content = expanded_content;
+				if(map){
+					expanded_lines = (int*)STATS_REALLOC(MEMORY_MACROS, macro_content_lines, sizeof(int)*macro_capacity*2);
+					if(expanded_lines == NULL){
+						print_system_error("realloc failed");
+						free_macro_content(macro_content, macro_content_lines, macro_lines);
+						free_macro_array(&macros);
+						return false;
+					}
+					macro_content_lines = expanded_lines;
+				}
+				macro_capacity *= 2;/*double the capacity*/
 			}
-			macro_content[macro_lines++] = allocate_and_copy_string(start);/*copy the line to macro content*/
+			macro_content[macro_lines] = allocate_and_copy_string(start);/*copy the line to macro content*/
+			if(macro_content[macro_lines] == NULL){
+				free_macro_content(macro_content, macro_content_lines, macro_lines);
+				free_macro_array(&macros);
+				return false;
+			}
+			if(map){
+				macro_content_lines[macro_lines] = map->source_line;
+			}
+			macro_lines++;
 			continue;
 		}
 
@@ -294,15 +642,32 @@ bool preprocess_file(const char *input_filename){
 			}
 		}
 
+		output_length = strlen(output_line);
 		while(*start){
-			sscanf(start, "%s", word);/*read a word from the line*/
-			word_len = strlen(word);/*get the length of the word*/
-			macro_def = get_macro_content(&macros, word, &macro_line_count);/*get the content of the macro*/
-
-			if(macro_def){/*if the word matches a macro name*/
-				for(i=0 ; i<macro_line_count ; i++){/*iterate through the macro lines*/
-					strcat(output_line, macro_def[i]);/*append each line of the macro to the output line*/
+			for(word_start = start ; isspace((unsigned char)*word_start) ; word_start++);/*the word starts at the first non-space character like %s reads it*/
+			for(word_len = 0 ; word_start[word_len] && !isspace((unsigned char)word_start[word_len]) ; word_len++){
+				word[word_len] = word_start[word_len];
+			}
+			word[word_len] = '\0';/*only white space left is an empty word (a blank line must not expand the word of the previous line)*/
+			macro = find_macro(&macros, word);/*get the macro the word names*/
+
+			if(macro){/*if the word matches a macro name*/
+				STATS_COUNT(COUNTER_MACROS_EXPANDED, 1);
+				fputs(output_line, output_file);/*write the label before the macro*/
+				if(map && !map_output_lines(map, output_line, map->source_line, &origin, &output_line_start)){
+					free_macro_array(&macros);
+					return false;
+				}
+				macro_origin.macro = (int)(macro - macros.macros);
+				for(i=0 ; i<macro->line_count ; i++){/*iterate through the macro lines*/
+					fputs(macro->content[i], output_file);/*write each line of the macro (together they don't fit in the output line)*/
+					macro_origin.line = macro->lines ? macro->lines[i] : 0;
+					if(map && !map_output_lines(map, macro->content[i], map->source_line, &macro_origin, &output_line_start)){
+						free_macro_array(&macros);
+						return false;
+					}
 				}
+				output_line[0] = '\0';
 				start += word_len;
 				while(*start && (*start==' ' || *start=='\t' || *start=='\n' || *start=='\r')){
 					start++;
@@ -310,16 +675,25 @@ bool preprocess_file(const char *input_filename){
 				break;/*after macro expansion, skip the rest of the line*/
 			}
 			else{
-				strncat(output_line, start, 1);/*preserve spaces and tabs*/
+				output_line[output_length++] = *start;/*preserve spaces and tabs*/
+				output_line[output_length] = '\0';
 				start++;
 			}
 		}
 
 		fputs(output_line, output_file);/*write the output line to the file*/
+		if(map && !map_output_lines(map, output_line, map->source_line, &origin, &output_line_start)){
+			free_macro_array(&macros);
+			return false;
+		}
+	}
+	if(map && map->track_origins && !take_macro_names(map, &macros)){
+		free_macro_content(macro_content, macro_content_lines, macro_lines);
+		free_macro_array(&macros);
+		return false;
 	}
 
-	fclose(input_file);/*close the input file*/
-	fclose(output_file);/*close the output file*/
+	free_macro_content(macro_content, macro_content_lines, macro_lines);/*free a definition that was never closed*/
 	free_macro_array(&macros);/*free the memory allocated for macros*/
 	return true;/*return true to indicate successful preprocessing*/
 }
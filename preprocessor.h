@@ -5,9 +5,11 @@
 #include <stdlib.h>
 #include <string.h>
 #include "definitions.h"
+#include "diagnostics.h"
 
 #define INVALID_NAME_COUNT (sizeof(invalid_names)/sizeof(invalid_names[0]))/*define the list of invalid macro names*/
 #define INITIAL_MACRO_COUNT 10/*initial count for macros in the array*/
+#define INITIAL_MACRO_INDEX_SIZE 32/*initial number of slots of the index of the macros (a power of two)*/
 
 /*** STRUCTURE DEFINITIONS SECTION ***/
 
@@ -15,6 +17,7 @@
 typedef struct {
 	char *name;/*name of the macro*/
 	char **content;/*array of lines in the macro*/
+	int *lines;/*1 based source line of every line in the macro or NULL when the source lines are not counted*/
 	int line_count;/*number of lines in the macro*/
 }Macro;
 
@@ -23,20 +26,47 @@ typedef struct {
 	Macro *macros;/*dynamically allocated array of macros*/
 	int count;/*current number of macros*/
 	int capacity;/*current capacity of the array*/
+	int *index;/*open addressing table of the position of every macro plus one (0 is a free slot)*/
+	int index_size;/*number of slots of the index (a power of two at least twice the count)*/
 }MacroArray;
 
+/*typedef for the macro line a preprocessed line was expanded from*/
+typedef struct {
+	int line;/*1 based source line of the line in the macro definition or 0 when the line was not expanded from a macro*/
+	int macro;/*position of the macro in the macro names of the map or -1*/
+}LineOrigin;
+
+/*typedef for the map from the preprocessed lines back to the source lines*/
+typedef struct {
+	int *lines;/*1 based source line that produced each preprocessed line (the line of the call for an expanded line)*/
+	int count;/*number of preprocessed lines*/
+	int capacity;/*capacity of the lines array*/
+	int source_line;/*source lines read so far (the line that failed when preprocessing fails)*/
+	bool track_origins;/*set by the caller to also fill origins and macro_names*/
+	LineOrigin *origins;/*the macro line every preprocessed line was expanded from (capacity elements) or NULL*/
+	char **macro_names;/*the name of every macro of the source in the order of definition when origins are tracked*/
+	int macro_count;/*number of macro names*/
+}LineMap;
+
 /*** EXTERNAL DECLARATIONS SECTION ***/
 
 /*invalid names that a macro can't have*/
-extern const char *invalid_names[];
+extern const char *const invalid_names[];
 
 /*** FUNCTION PROTOTYPES SECTION ***/
 
-void initialize_macro_array(MacroArray *array);/*function to initialize the MacroArray structure*/
-void add_macro(MacroArray *array,const char *name,char **content,int line_count);/*function to add a macro to the MacroArray*/
+bool initialize_macro_array(MacroArray *array);/*function to initialize the MacroArray structure*/
+bool add_macro(MacroArray *array,const char *name,char **content,int *lines,int line_count);/*function to add a macro to the MacroArray*/
+Macro *find_macro(MacroArray *array,const char *name);/*function to look a macro up by its name*/
 char **get_macro_content(MacroArray *array,const char *name,int *line_count);/*function to retrieve the content of a macro*/
 void free_macro_array(MacroArray *array);/*function to free all macros in the MacroArray*/
+void free_macro_content(char **content,int *lines,int line_count);/*function to free the lines of a macro that was not added*/
 bool preprocess_file(const char *input_filename);/*function to preprocess the file and expand macros*/
+bool preprocess_stream(FILE *input_file,FILE *output_file);/*function to expand the macros of a source stream into another stream*/
+bool preprocess_stream_mapped(FILE *input_file,FILE *output_file,LineMap *map);/*function to expand the macros of a stream and record the source line of every output line*/
+bool map_output_lines(LineMap *map,const char *output,int source_line,const LineOrigin *origin,bool *at_line_start);/*function to record the source line of the lines written to the output*/
+void initialize_line_map(LineMap *map,bool track_origins);/*function to prepare an empty LineMap*/
+void free_line_map(LineMap *map);/*function to free everything a LineMap holds*/
 bool is_valid_macro_name(const char *name);/*function to check if a macro name is valid*/
 char *allocate_and_copy_string(const char *s);/*function to allocate memory and copy a string*/
 
@@ -1,4 +1,6 @@
 #include "second_pass.h"
+#include "file_writer.h"
+#include "stats.h"
 
 
 /*** CODE WORD HANDLING SECTION ***/
@@ -30,10 +32,10 @@ codeWord *create_code_word(opcode curr_opcode,int op_count,char *operands[2]){
 		second_addressing=get_addressing_type(operands[1]);/*determine the addressing type for the second operand*/
 	}
 
-	codeword=(codeWord*)malloc(sizeof(codeWord));/*allocate memory for the new code word*/
+	codeword=(codeWord*)STATS_MALLOC(MEMORY_CODE_WORDS, sizeof(codeWord));/*allocate memory for the new code word*/
 	if(codeword==NULL){/*check if memory allocation failed*/
-		printf("malloc failed");
-		exit(EXIT_FAILURE);
+		print_system_error("malloc failed");
+		return NULL;
 	}
 
 	codeword->opcode=curr_opcode;/*set the opcode in the code word*/
@@ -70,19 +72,20 @@ codeWord *create_code_word(opcode curr_opcode,int op_count,char *operands[2]){
 *   num_of_second_reg: the number of the second register involved in the operation if any
 * 
 * returns:
-*   dataWord*: a pointer to the created dataWord struct which encodes the register numbers into a format suitable for the machine code
+*   dataWord*: a pointer to the created dataWord struct which encodes the register numbers into a format suitable for the machine code or NULL if memory ran out
 */
 dataWord *handle_register_address_word(long num_of_first_reg,long num_of_second_reg){
 	unsigned long ARE=4;/*set ARE value*/
 	unsigned long num_of_src_reg=0, num_of_dest_reg=0;/*initialize source and destination registers*/
-	dataWord *dataword=malloc(sizeof(dataWord));/*allocate memory for data word*/
+	dataWord *dataword=STATS_MALLOC(MEMORY_CODE_WORDS, sizeof(dataWord));/*allocate memory for data word*/
 
 	if(dataword==NULL){/*check if memory allocation failed*/
-		printf("malloc failed");
-		exit(EXIT_FAILURE);
+		print_system_error("malloc failed");
+		return NULL;
 	}
 
 	dataword->ARE=ARE;/*set the ARE field*/
+	dataword->data=0;/*r0 operands leave every register field zero*/
 
 	if(num_of_first_reg&&(num_of_second_reg==0)){/*if only source register is used*/
 		num_of_src_reg=num_of_first_reg<<3;/*shift source register value to correct position*/
@@ -116,15 +119,15 @@ dataWord *handle_register_address_word(long num_of_first_reg,long num_of_second_
 *   is_extern_symbol: a boolean flag that indicates whether the symbol being addressed is external which affects the ARE value
 * 
 * returns:
-*   dataWord*: a pointer to the created dataWord struct which holds the encoded data and addressing information
+*   dataWord*: a pointer to the created dataWord struct which holds the encoded data and addressing information or NULL if memory ran out
 */
 dataWord *handle_non_register_address_word(addressing_type addressing,long data,bool is_extern_symbol){
 	unsigned long ARE=1;/*initialize ARE*/
-	dataWord *dataword=malloc(sizeof(dataWord));/*allocate memory for data word*/
+	dataWord *dataword=STATS_MALLOC(MEMORY_CODE_WORDS, sizeof(dataWord));/*allocate memory for data word*/
 
 	if(dataword==NULL){/*check if memory allocation failed*/
-		printf("malloc failed");
-		exit(EXIT_FAILURE);
+		print_system_error("malloc failed");
+		return NULL;
 	}
 
 	if(addressing==IMMEDIATE_ADDR){/*if addressing is immediate*/
@@ -141,6 +144,44 @@ dataWord *handle_non_register_address_word(addressing_type addressing,long data,
 
 /*** CODEWORD GENERATION SECTION ***/
 
+/* 
+* log_extern_reference
+* --------------------
+* this function appends an extern reference to the terminated array of the references of the program
+* the size of the array is kept next to it so the terminator is never looked for and the array doubles when it is full
+* 
+* parameters:
+*   extern_printing_array: the terminated array of references or NULL when there is none yet
+*   log_size: the number of references and the capacity of the array
+*   name: the name of the extern
+*   address: the address of the word that references the extern
+* 
+* returns:
+*   bool: true if the reference was appended false if memory ran out
+*/
+bool log_extern_reference(ExternEntry **extern_printing_array,ExternLogSize *log_size,const char *name,long address){
+	ExternEntry *extern_references;/*pointer to the expanded extern printing array*/
+	int capacity;
+
+	if(log_size->count + 2 > log_size->capacity){/*the reference and the terminator must fit*/
+		capacity = log_size->capacity < 8 ? 16 : log_size->capacity * 2;
+		extern_references = STATS_REALLOC(MEMORY_OTHER, *extern_printing_array, capacity * sizeof(ExternEntry));/*dynamically allocates memory for the newly found extern*/
+		if(extern_references == NULL){/*and ensures the reallocation passes well*/
+			print_system_error("realloc failed");
+			return false;
+		}
+		*extern_printing_array = extern_references;
+		log_size->capacity = capacity;
+	}
+	/*add the new extern and copies the name into the array ensuring not to exceed the max length*/
+	strncpy((*extern_printing_array)[log_size->count].name, name, MAX_LABEL_LENGTH);
+	(*extern_printing_array)[log_size->count].name[MAX_LABEL_LENGTH] = '\0';
+	(*extern_printing_array)[log_size->count].line_number = address;/*store the line number where the extern is used*/
+	(*extern_printing_array)[log_size->count + 1].name[0] = '\0';/*null terminate the array*/
+	log_size->count++;
+	return true;
+}
+
 /* 
 * generate_non_register_code_word
 * --------------------------------
@@ -156,23 +197,27 @@ dataWord *handle_non_register_address_word(addressing_type addressing,long data,
 *   label_array: an array of labels used in the program which helps in resolving direct addressing
 *   ext_entry_array: an array of external symbols used to track references to external labels
 *   extern_printing_array: an array where information about external labels to be printed is stored
+*   log_size: the number of references in the extern printing array and its capacity
 * 
+* returns:
+*   bool: true if the word was generated false if the label is unknown or memory ran out
 */
-void generate_non_register_code_word(MachineWordsArray **code_img,long *ic,char *operand,LabelArray *label_array,ExternEntryArray *ext_entry_array,ExternEntry **extern_printing_array){
+bool generate_non_register_code_word(MachineWordsArray **code_img,long *ic,char *operand,LabelArray *label_array,ExternEntryArray *ext_entry_array,ExternEntry **extern_printing_array,ExternLogSize *log_size){
 	addressing_type operand_addressing;/*declare operand addressing type*/
 	MachineWordsArray *word_to_write=NULL;/*initialize word_to_write to NULL*/
-	int j,i;/*loop counters*/
-	int extern_count = 0;
+	Label *label;/*the label of a direct operand*/
 
 
 	operand_addressing=get_addressing_type(operand);/*get the addressing type of the operand*/
 
 	if(operand_addressing!=NONE_ADDR){/*if operand addressing is valid*/
-		word_to_write=(MachineWordsArray*)malloc(sizeof(MachineWordsArray));/*allocate memory for word*/
+		word_to_write=(MachineWordsArray*)STATS_MALLOC(MEMORY_CODE_WORDS, sizeof(MachineWordsArray));/*allocate memory for word*/
 		if(word_to_write==NULL){/*check if memory allocation failed*/
-			printf("malloc failed");
-			exit(EXIT_FAILURE);
+			print_system_error("malloc failed");
+			return false;
 		}
+		word_to_write->length=0;/*set word length*/
+		(word_to_write->word).data=NULL;/*no data word was created yet*/
 		if(operand_addressing==IMMEDIATE_ADDR){/*if addressing is immediate*/
 			char *ptr;/*pointer for strtol*/
 			short value=(short)strtol(operand+1, &ptr, 10);/*convert operand to value*/
@@ -181,55 +226,41 @@ void generate_non_register_code_word(MachineWordsArray **code_img,long *ic,char
 		}
 		else if(operand_addressing==DIRECT_ADDR){/*if addressing is direct*/
 			bool label_found = false;/*flag to check if label was found*/
+			ExternEntry *external = find_extern(ext_entry_array, operand);/*the extern the operand names or NULL*/
 
-			for(j=0 ; j<ext_entry_array->extern_count ; j++){/*loop through externs*/
-				if(strcmp(ext_entry_array->externs[j].name, operand)==false){/*if operand matches an extern*/
-					extern_count = 0;
-					while(*extern_printing_array && (*extern_printing_array)[extern_count].name[0] != '\0'){/*looking for an empty space to put the newly found extern*/
-						extern_count++;
-					}
-
-					*extern_printing_array = realloc(*extern_printing_array, (extern_count + 2) * sizeof(ExternEntry));/*dynamically allocates memory for the newly found extern*/
-					if(*extern_printing_array == NULL){/*and ensures the reallocation passes well*/
-						printf("realloc failed");
-						exit(EXIT_FAILURE);
-					}
-					/*add the new extern and copies the name into the array ensuring not to exceed the max length*/
-					strncpy((*extern_printing_array)[extern_count].name, ext_entry_array->externs[j].name, MAX_LABEL_LENGTH - 1);
-					(*extern_printing_array)[extern_count].name[MAX_LABEL_LENGTH - 1] = '\0';
-
-					(*extern_printing_array)[extern_count].line_number = *ic;/*store the line number where the extern is used*/
-
-					(*extern_printing_array)[extern_count + 1].name[0] = '\0';/*null terminate the array*/
+			if(external != NULL){/*if operand matches an extern*/
+				if(!log_extern_reference(extern_printing_array, log_size, external->name, *ic)){/*record the reference for the .ext file*/
+					STATS_FREE(word_to_write);
+					return false;
+				}
 
-					word_to_write->length=0;/*set word length*/
-					(word_to_write->word).data=handle_non_register_address_word(DIRECT_ADDR, 0, true);/*set data word with 0 because its an external label*/
+				word_to_write->length=0;/*set word length*/
+				(word_to_write->word).data=handle_non_register_address_word(DIRECT_ADDR, 0, true);/*set data word with 0 because its an external label*/
 			
-					label_found = true;/*label found in extern array*/
-					break;/*exit loop*/
-				}
+				label_found = true;/*label found in extern array*/
 			}
 
-			if(!label_found){/*if not found in externs, search in labels*/
-				for(i=0 ; i<label_array->count ; i++){/*loop through labels*/
-					if(strcmp(label_array->labels[i].label, operand)==false){/*if operand matches a label*/
-						word_to_write->length=0;/*set word length*/
-						(word_to_write->word).data=handle_non_register_address_word(DIRECT_ADDR, label_array->labels[i].line_number, false);/*set data word with the line of the label*/
-						label_found = true;/*label found in label array*/
-						break;/*exit loop*/
-					}
-				}
+			if(!label_found && (label = find_label(label_array, operand)) != NULL){/*if not found in externs, look it up in labels*/
+				word_to_write->length=0;/*set word length*/
+				(word_to_write->word).data=handle_non_register_address_word(DIRECT_ADDR, label->line_number, false);/*set data word with the line of the label*/
+				label_found = true;/*label found in label array*/
 			}
 
 			if(!label_found){/*if label is not found in either extern or label arrays*/
-				fprintf(stderr, "Error: Label '%s' was not initialized\n", operand);
-				exit(EXIT_FAILURE);/*terminate the program with an error*/
+				report_error("Error: Label '%s' was not initialized\n", operand);
+				STATS_FREE(word_to_write);
+				return false;/*fail the file with an error*/
 			}
 		}
+		if((word_to_write->word).data==NULL){/*check if the data word could not be created*/
+			STATS_FREE(word_to_write);
+			return false;
+		}
 
 		code_img[*ic-IC_INIT_VALUE]=word_to_write;/*store the word in code image*/
 		(*ic)++;/*increment instruction counter*/
 	}
+	return true;
 }
 
 /* 
@@ -248,16 +279,18 @@ void generate_non_register_code_word(MachineWordsArray **code_img,long *ic,char
 *   operand1: the first operand which could be a register or a memory location
 *   operand2: the second operand which could also be a register or a memory location
 * 
+* returns:
+*   bool: true if the word was generated false if memory ran out
 */
-void generate_register_code_word(MachineWordsArray **code_img,long *ic,addressing_type first_operand_addr,addressing_type second_operand_addr,char *operand1,char *operand2){
+bool generate_register_code_word(MachineWordsArray **code_img,long *ic,addressing_type first_operand_addr,addressing_type second_operand_addr,char *operand1,char *operand2){
 	char *ptr;/*pointer for strtol*/
 	short num_of_first_reg=0, num_of_second_reg=0;/*initialize register numbers*/
 	MachineWordsArray *word_to_write;/*pointer for new word*/
 
-	word_to_write=(MachineWordsArray*)malloc(sizeof(MachineWordsArray));/*allocate memory for word*/
+	word_to_write=(MachineWordsArray*)STATS_MALLOC(MEMORY_CODE_WORDS, sizeof(MachineWordsArray));/*allocate memory for word*/
 	if(word_to_write==NULL){/*check if memory allocation failed*/
-		printf("malloc failed");
-		exit(EXIT_FAILURE);
+		print_system_error("malloc failed");
+		return false;
 	}
 
 	if(first_operand_addr==REGISTER_ADDR){/*if first operand is a register*/
@@ -274,8 +307,13 @@ void generate_register_code_word(MachineWordsArray **code_img,long *ic,addressin
 
 	word_to_write->length=0;/*set word length*/
 	(word_to_write->word).data=handle_register_address_word(num_of_first_reg, num_of_second_reg);/*set data word*/
+	if((word_to_write->word).data==NULL){/*check if the data word could not be created*/
+		STATS_FREE(word_to_write);
+		return false;
+	}
 	code_img[*ic-IC_INIT_VALUE]=word_to_write;/*store the word in code image*/
 	(*ic)++;/*increment instruction counter*/
+	return true;
 }
 
 
@@ -297,12 +335,14 @@ void generate_register_code_word(MachineWordsArray **code_img,long *ic,addressin
 *   labels: the array of labels used in the program which helps in resolving direct addressing
 *   ext_entry_array: an array of external symbols used to track references to external labels
 *   extern_printing_array: an array where information about external labels to be printed is stored
+*   log_size: the number of references in the extern printing array and its capacity
 * 
 * returns:
 *   bool: true if the processing was successful and false otherwise this indicates whether the line of code was correctly converted into machine code
 */
-bool process_code(const char *operation,const char *operands_line,long *ic,MachineWordsArray **code_img,LabelArray *labels,ExternEntryArray *ext_entry_array,ExternEntry **extern_printing_array){
-	char *token;/*pointer for strtok*/
+bool process_code(const char *operation,const char *operands_line,long *ic,MachineWordsArray **code_img,LabelArray *labels,ExternEntryArray *ext_entry_array,ExternEntry **extern_printing_array,ExternLogSize *log_size){
+	char *token;/*pointer for strtok_r*/
+	char *save;/*position of strtok_r in the operands*/
 	int i = 0;/*operand counter*/
 	char *operands[2] = {NULL, NULL};/*array for operands*/
 	opcode curr_opcode;/*current opcode*/
@@ -311,30 +351,37 @@ bool process_code(const char *operation,const char *operands_line,long *ic,Machi
 	int operand_count;/*number of operands*/
 	MachineWordsArray *word_to_write;/*pointer for new word*/
 	addressing_type first_operand_addressing = NONE_ADDR, second_operand_addressing = NONE_ADDR;/*initialize addressing types*/
+	bool generated = true;/*true while every operand word was generated*/
 
 	if(operands_line != NULL && *operands_line != '\0'){/*if there are operands*/
-		token = strtok((char*)operands_line, ", \t");/*split operands*/
+		token = strtok_r((char*)operands_line, ", \t", &save);/*split operands*/
 		while(token != NULL && i < 2){/*loop through operands*/
-			operands[i] = malloc(MAX_OPERAND_LENGTH * sizeof(char));/*allocate memory for operand*/
+			if(strlen(token) >= MAX_OPERAND_LENGTH){/*an operand the buffer can't hold would be cut into another label*/
+				report_error("Error: Operand '%s' is longer than %d characters\n", token, MAX_LABEL_LENGTH);
+				STATS_FREE(operands[0]);
+				return false;
+			}
+			operands[i] = STATS_MALLOC(MEMORY_OPERANDS, MAX_OPERAND_LENGTH * sizeof(char));/*allocate memory for operand*/
 			if(operands[i] == NULL){/*check if memory allocation failed*/
-				printf("Error: malloc failed for operand %d\n", i);
+				report_error("Error: malloc failed for operand %d\n", i);
+				STATS_FREE(operands[0]);
 				return false;
 			}
 			strncpy(operands[i], token, MAX_OPERAND_LENGTH);/*copy operand*/
 			operands[i][MAX_OPERAND_LENGTH - 1] = '\0';/*null terminate operand*/
 			i++;/*increment operand counter*/
-			token = strtok(NULL, ", \t");/*get next operand*/
+			token = strtok_r(NULL, ", \t", &save);/*get next operand*/
 		}
 
 		if(i == 0){/*if no operands were extracted*/
-			printf("Error: Operands not extracted correctly.\n");
+			report_error("Error: Operands not extracted correctly.\n");
 			return false;
 		}
 	}
 
 	curr_opcode = get_opcode(operation);/*get opcode from operation*/
 	if(curr_opcode == NONE_OP){/*if operation is unrecognized*/
-		printf("Error: Unrecognized operation: %s\n", operation);
+		report_error("Error: Unrecognized operation: %s\n", operation);
 		return false;
 	}
 
@@ -342,19 +389,20 @@ bool process_code(const char *operation,const char *operands_line,long *ic,Machi
 
 	codeword = create_code_word(curr_opcode, operand_count, operands);/*create code word*/
 	if(codeword == NULL){/*if code word creation failed*/
-		printf("Error: Failed to create code word for operation: %s\n", operation);
+		report_error("Error: Failed to create code word for operation: %s\n", operation);
 		return false;
 	}
 
 	ic_before = *ic;/*save instruction counter state*/
 
-	word_to_write = (MachineWordsArray*)malloc(sizeof(MachineWordsArray));/*allocate memory for new word*/
+	word_to_write = (MachineWordsArray*)STATS_MALLOC(MEMORY_CODE_WORDS, sizeof(MachineWordsArray));/*allocate memory for new word*/
 	if(word_to_write == NULL){/*check if memory allocation failed*/
-		printf("Error: malloc failed for word_to_write\n");
-		free(codeword);/*free code word memory*/
+		report_error("Error: malloc failed for word_to_write\n");
+		STATS_FREE(codeword);/*free code word memory*/
 		return false;
 	}
 
+	word_to_write->length = 1;/*the operand words are added to the length once they are generated*/
 	word_to_write->word.code = codeword;/*set code word*/
 	code_img[(*ic) - IC_INIT_VALUE] = word_to_write;/*store the word in code image*/
 	(*ic)++;/*increment instruction counter*/
@@ -362,14 +410,18 @@ bool process_code(const char *operation,const char *operands_line,long *ic,Machi
 	if(operands[0]){/*if there is a first operand*/
 		first_operand_addressing = get_addressing_type(operands[0]);/*get addressing type*/
 		if(first_operand_addressing == -1){/*if invalid addressing type*/
-			printf("Error: Invalid addressing type for operand 1: %s\n", operands[0]);
+			report_error("Error: Invalid addressing type for operand 1: %s\n", operands[0]);
+			STATS_FREE(operands[0]);
+			STATS_FREE(operands[1]);
 			return false;
 		}
 	}
 	if(operands[1]){/*if there is a second operand*/
 		second_operand_addressing = get_addressing_type(operands[1]);/*get addressing type*/
 		if(second_operand_addressing == -1){/*if invalid addressing type*/
-			printf("Error: Invalid addressing type for operand 2: %s\n", operands[1]);
+			report_error("Error: Invalid addressing type for operand 2: %s\n", operands[1]);
+			STATS_FREE(operands[0]);
+			STATS_FREE(operands[1]);
 			return false;
 		}
 	}
@@ -377,28 +429,28 @@ bool process_code(const char *operation,const char *operands_line,long *ic,Machi
 	if(operand_count--){/*if there are operands to process*/
 		if((first_operand_addressing == REGISTER_ADDR || first_operand_addressing == RELATIVE_ADDR) &&
 			(second_operand_addressing == REGISTER_ADDR || second_operand_addressing == RELATIVE_ADDR)){/*if both operands are registers or relative*/
-			generate_register_code_word(code_img, ic, first_operand_addressing, second_operand_addressing, operands[0], operands[1]);/*generate register code word*/
+			generated = generate_register_code_word(code_img, ic, first_operand_addressing, second_operand_addressing, operands[0], operands[1]);/*generate register code word*/
 			operand_count--;/*decrement operand count*/
 		}
 		else if(first_operand_addressing == REGISTER_ADDR || first_operand_addressing == RELATIVE_ADDR){/*if first operand is register or relative*/
 			if(!operand_count){/*if only one operand*/
-				generate_register_code_word(code_img, ic, NONE_ADDR, first_operand_addressing, NULL, operands[0]);/*generate code word for destination register if the operation takes one operand*/
+				generated = generate_register_code_word(code_img, ic, NONE_ADDR, first_operand_addressing, NULL, operands[0]);/*generate code word for destination register if the operation takes one operand*/
 			}
 			else if(operand_count--){/*if more than one operand*/
-				generate_register_code_word(code_img, ic, first_operand_addressing, second_operand_addressing, operands[0], NULL);/*generate register code word as the source operand*/
-				generate_non_register_code_word(code_img, ic, operands[1], labels, ext_entry_array, extern_printing_array);/*generate code word for second operand*/
+				generated = generate_register_code_word(code_img, ic, first_operand_addressing, second_operand_addressing, operands[0], NULL) &&/*generate register code word as the source operand*/
+					generate_non_register_code_word(code_img, ic, operands[1], labels, ext_entry_array, extern_printing_array, log_size);/*generate code word for second operand*/
 			}
 		}
 		else if(second_operand_addressing == REGISTER_ADDR || second_operand_addressing == RELATIVE_ADDR){/*if second operand is register or relative*/
 			if(operand_count--){/*if more than one operand*/
-				generate_non_register_code_word(code_img, ic, operands[0], labels, ext_entry_array, extern_printing_array);/*generate code word for first operand*/
+				generated = generate_non_register_code_word(code_img, ic, operands[0], labels, ext_entry_array, extern_printing_array, log_size);/*generate code word for first operand*/
 			}
-			generate_register_code_word(code_img, ic, first_operand_addressing, second_operand_addressing, NULL, operands[1]);/*generate register code word as the destination operand*/
+			generated = generated && generate_register_code_word(code_img, ic, first_operand_addressing, second_operand_addressing, NULL, operands[1]);/*generate register code word as the destination operand*/
 		}
 		else{ /*if no register operands*/
-			generate_non_register_code_word(code_img, ic, operands[0], labels, ext_entry_array, extern_printing_array);/*generate code word for first operand*/
-			if(operand_count > 0){/*if more than one operand*/
-				generate_non_register_code_word(code_img, ic, operands[1], labels, ext_entry_array, extern_printing_array);/*generate code word for second operand*/
+			generated = generate_non_register_code_word(code_img, ic, operands[0], labels, ext_entry_array, extern_printing_array, log_size);/*generate code word for first operand*/
+			if(generated && operand_count > 0){/*if more than one operand*/
+				generated = generate_non_register_code_word(code_img, ic, operands[1], labels, ext_entry_array, extern_printing_array, log_size);/*generate code word for second operand*/
 			}
 		}
 	} /*NOTE: the calls for generating the words are made in a specific sequence to maintain the correct order when printing the operands*/
@@ -406,9 +458,9 @@ bool process_code(const char *operation,const char *operands_line,long *ic,Machi
 	/* Set the length of the machine word. This represents the total number of words required for the instruction. */
 	code_img[ic_before - IC_INIT_VALUE]->length = (*ic) - ic_before;/*set length of machine word*/
 
-	free(operands[0]);
-	free(operands[1]);
-	return true;
+	STATS_FREE(operands[0]);
+	STATS_FREE(operands[1]);
+	return generated;
 }
 
 
@@ -424,7 +476,7 @@ bool process_code(const char *operation,const char *operands_line,long *ic,Machi
 * 
 * pparameters:
 *   line: the line containing the .string directive including the string to be processed
-*   data_img: the array where the string's characters will be stored in the program's data segment
+*   data_img: the array where the string's characters will be stored in the program's data segment or NULL to only check the directive
 *   dc: the data counter which tracks the current position in the data image array
 * 
 * returns:
@@ -439,7 +491,7 @@ bool handle_string_directive_SP(const char *line,long *data_img,long *dc){
 	}
 
 	if(*line!='\"'){/*if the string doesn't start with a quote*/
-		printf("Error: .string directive does not start with a quote.\n");
+		report_error("Error: .string directive does not start with a quote.\n");
 		return false;
 	}
 
@@ -447,10 +499,15 @@ bool handle_string_directive_SP(const char *line,long *data_img,long *dc){
 
 	end=strchr(start, '\"');/*find closing quote*/
 	if(end==NULL){/*if there is no closing quote*/
-		printf("Error: .string directive does not have a closing quote.\n");
+		report_error("Error: .string directive does not have a closing quote.\n");
 		return false;
 	}
 
+	if(data_img==NULL){/*if the directive is only checked*/
+		*dc+=end-start+1;/*count the characters and the null terminator*/
+		return true;
+	}
+
 	while(start<end){/*loop through string characters*/
 		data_img[*dc]=(long)(*start);/*store character in data image*/
 		(*dc)++;/*increment data counter*/
@@ -471,50 +528,211 @@ bool handle_string_directive_SP(const char *line,long *data_img,long *dc){
 * 
 * parameters:
 *   line: the line containing the .data directive including the values to be processed
-*   data_img: the array where the numeric values will be stored in the program's data segment
+*   data_img: the array where the numeric values will be stored in the program's data segment or NULL to only check the directive
 *   dc: the data counter which tracks the current position in the data image array
 * 
 * returns:
 *   bool: true if the data was successfully processed and stored and false if there was an error
 */
 bool handle_data_directive_SP(const char *line,long *data_img,long *dc){
-	char *token;/*pointer for strtok*/
+	char *token;/*pointer for strtok_r*/
+	char *save;/*position of strtok_r in the line*/
 	char *endptr;/*pointer for strtol*/
-	char *original_line=(char*)malloc(strlen(line)+1);/*allocate memory for line copy*/
+	char *original_line=(char*)STATS_MALLOC(MEMORY_DATA_COPIES, strlen(line)+1);/*allocate memory for line copy*/
 	char *line_copy;/*copy of line*/
 	long value;/*data value*/
 
 	if(original_line==NULL){/*if memory allocation failed*/
-		fprintf(stderr, "Error: Memory allocation failed for line copy\n");
+		report_error("Error: Memory allocation failed for line copy\n");
 		return false;
 	}
 
 	strcpy(original_line, line);/*copy line to allocated memory*/
 	line_copy=original_line;/*set line copy pointer*/
 
-	token=strtok(line_copy, " \t,");/*split line into tokens*/
+	token=strtok_r(line_copy, " \t,", &save);/*split line into tokens*/
 	while(token){/*loop through tokens*/
 		value=strtol(token, &endptr, 10);/*convert token to long*/
 
 		if(*endptr!='\0'){/*if the token is not a valid number*/
-			fprintf(stderr, "Error: Invalid number '%s' in .data directive\n", token);/*print error message*/
-			free(original_line);/*free memory*/
+			report_error("Error: Invalid number '%s' in .data directive\n", token);/*print error message*/
+			STATS_FREE(original_line);/*free memory*/
 			return false;/*return failure*/
 		}
-		data_img[*dc]=value;/*store value in data image*/
+		if(data_img!=NULL){/*if the data image is populated*/
+			data_img[*dc]=value;/*store value in data image*/
+		}
 		(*dc)++;/*increment data counter*/
-		token=strtok(NULL, " \t,");/*get next token*/
+		token=strtok_r(NULL, " \t,", &save);/*get next token*/
 	}
 
-	free(original_line);/*free memory*/
+	STATS_FREE(original_line);/*free memory*/
 	return true;/*return success*/
 }
 
+/*** RELOCATION SECTION ***/
+
+/* 
+* initialize_relocation_array
+* ---------------------------
+* this function initializes a RelocationArray structure to store the indices of the relocatable words of the code image
+* 
+* parameters:
+*   array: a pointer to the RelocationArray structure to be initialized
+* 
+*/
+void initialize_relocation_array(RelocationArray *array){
+	array->count = 0;/*initialize count*/
+	array->capacity = 0;/*nothing is allocated until the first relocated word is found*/
+	array->indices = NULL;
+}
+
+/* 
+* free_relocation_array
+* ---------------------
+* this function frees the memory allocated for the indices of the RelocationArray
+* 
+* parameters:
+*   array: a pointer to the RelocationArray structure to be freed
+* 
+*/
+void free_relocation_array(RelocationArray *array){
+	STATS_FREE(array->indices);
+	initialize_relocation_array(array);
+}
+
+/* 
+* add_relocation
+* --------------
+* this function adds the index of a relocated word to the RelocationArray
+* if the array is full it reallocates memory to accommodate more indices
+* 
+* parameters:
+*   array: a pointer to the RelocationArray structure where the index will be added
+*   index: the code image index of the relocated word
+* 
+* returns:
+*   bool: true if the index was added false if memory ran out
+*/
+bool add_relocation(RelocationArray *array,long index){
+	long *indices;/*pointer to the expanded array*/
+	int capacity;/*capacity of the expanded array*/
+
+	if(array->count >= array->capacity){/*check if array is full*/
+		capacity = array->capacity ? array->capacity*2 : 16;/*double the capacity*/
+		indices = (long*)STATS_REALLOC(MEMORY_OTHER, array->indices, capacity*sizeof(long));/*reallocate memory*/
+		if(indices == NULL){
+			print_system_error("realloc failed");
+			return false;
+		}
+		array->indices = indices;
+		array->capacity = capacity;
+	}
+	array->indices[array->count++] = index;/*store the index of the word*/
+	return true;
+}
+
+/* 
+* build_relocation_table
+* ----------------------
+* this function collects the code image indices of every word that holds the address of an internal label
+* these are the data words created by handle_non_register_address_word with ARE=2
+* words that reference externs (ARE=1) are left out since their value is resolved by the linker through the .ext references
+* with this table a loader can move the program by touching only the relocated words instead of decoding the whole image
+* 
+* parameters:
+*   code_img: the array where the generated machine words are stored
+*   icf: the final value of the instruction counter after the second pass
+*   relocations: a pointer to the RelocationArray that receives the indices
+* 
+* returns:
+*   bool: true if the table was built false if memory ran out
+*/
+bool build_relocation_table(MachineWordsArray **code_img,long icf,RelocationArray *relocations){
+	long i;/*loop counter*/
+
+	for(i=0 ; i<icf-IC_INIT_VALUE ; i++){/*loop through the code image*/
+		if(code_img[i]->length == 0 && code_img[i]->word.data->ARE == 2){/*if the word holds a relocatable address*/
+			if(!add_relocation(relocations, i)){/*store the index of the word*/
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+/* 
+* relocate_program
+* ----------------
+* this function moves an assembled program by delta addresses
+* only the words listed in the relocation table are changed in the code image
+* the entry addresses and the addresses of the words that reference externs move with the program
+* 
+* parameters:
+*   code_img: the array where the generated machine words are stored
+*   relocations: the relocation table built by build_relocation_table
+*   ext_entry_array: the entries whose addresses are moved
+*   extern_printing_array: the extern references whose addresses are moved or NULL if there are none
+*   delta: the number of addresses to move the program by
+* 
+*/
+void relocate_program(MachineWordsArray **code_img,RelocationArray *relocations,ExternEntryArray *ext_entry_array,ExternEntry *extern_printing_array,long delta){
+	int i;/*loop counter*/
+	dataWord *dataword;/*pointer to the relocated word*/
+
+	for(i=0 ; i<relocations->count ; i++){/*move every relocated address*/
+		dataword = code_img[relocations->indices[i]]->word.data;
+		dataword->data = (unsigned long)((long)dataword->data + delta);
+	}
+	for(i=0 ; i<ext_entry_array->entry_count ; i++){/*move the entry addresses*/
+		ext_entry_array->entries[i].line_number += delta;
+	}
+	for(i=0 ; extern_printing_array != NULL && extern_printing_array[i].name[0] != '\0' ; i++){/*move the addresses of the extern references*/
+		extern_printing_array[i].line_number += delta;
+	}
+}
+
 /*** SECOND PASS MAIN FUNCTION ***/
 
 /* 
 * second_pass
 * -----------
+* this function performs the second pass of the assembler over the input file
+* it opens the file and leaves the processing itself to second_pass_stream
+* 
+* parameters:
+*   filename: the name of the file containing the assembly source code to be processed
+*   label_array: an array of labels used in the program which helps in resolving direct addressing
+*   ext_entry_array: an array of external symbols used to track references to external labels
+*   code_img: the array where the generated machine words are stored representing the programs instructions
+*   data_img: the array where the programs data is stored representing the programs data segment
+*   IC: a pointer to the instruction counter which tracks the current position in the code image
+*   DC: a pointer to the data counter which tracks the current position in the data image
+*   extern_printing_array: an array where information about external labels to be printed is stored allowing the assembler to track and output extern usage
+*   sink: the sink that streams every instruction to the output files as soon as it is encoded or NULL to keep the whole code image
+* 
+* returns:
+*   bool: true if the second pass was successful and false otherwise
+*/
+bool second_pass(const char *filename,LabelArray *label_array,ExternEntryArray *ext_entry_array,MachineWordsArray **code_img,long *data_img,long *IC,long *DC,ExternEntry **extern_printing_array,ObjectSink *sink){
+	FILE *file;/*pointer to file*/
+	bool successful;/*success flag*/
+
+	file=fopen(filename, "r");/*open the input file*/
+	if(!file){/*if file open failed*/
+		print_system_error("Error opening file");/*print error message*/
+		return false;/*return failure*/
+	}
+
+	successful=second_pass_stream(file, label_array, ext_entry_array, code_img, data_img, IC, DC, extern_printing_array, sink);
+
+	fclose(file);/*close the file*/
+	return successful;
+}
+
+/* 
+* second_pass_stream
+* ------------------
 * this function performs the second pass of the assembler where it processes the assembly code to generate the final machine code
 * during this pass it handles the conversion of instructions and directives into their corresponding machine code representations
 * it reads the source file line by line identifying operations and directives and invoking the appropriate functions to process them
@@ -522,7 +740,7 @@ bool handle_data_directive_SP(const char *line,long *data_img,long *dc){
 * this function is the final step in assembling the source code ensuring that all instructions and data are correctly encoded and ready for output
 * 
 * parameters:
-*   filename: the name of the file containing the assembly source code to be processed
+*   file: the stream holding the preprocessed source, which may be a file or a buffer in memory
 *   label_array: an array of labels used in the program which helps in resolving direct addressing
 *   ext_entry_array: an array of external symbols used to track references to external labels
 *   code_img: the array where the generated machine words are stored representing the programs instructions
@@ -530,40 +748,39 @@ bool handle_data_directive_SP(const char *line,long *data_img,long *dc){
 *   IC: a pointer to the instruction counter which tracks the current position in the code image
 *   DC: a pointer to the data counter which tracks the current position in the data image
 *   extern_printing_array: an array where information about external labels to be printed is stored allowing the assembler to track and output extern usage
+*   sink: the sink that streams every instruction to the output files as soon as it is encoded or NULL to keep the whole code image
 * 
 * returns:
 *   bool: true if the second pass was successful and false otherwise this indicates whether the assembly process completed without errors
 */
-bool second_pass(const char *filename,LabelArray *label_array,ExternEntryArray *ext_entry_array,MachineWordsArray **code_img,long *data_img,long *IC,long *DC,ExternEntry **extern_printing_array){
-	FILE *file;/*pointer to file*/
+bool second_pass_stream(FILE *file,LabelArray *label_array,ExternEntryArray *ext_entry_array,MachineWordsArray **code_img,long *data_img,long *IC,long *DC,ExternEntry **extern_printing_array,ObjectSink *sink){
 	char line[MAX_LINE_LENGTH+1];/*buffer for reading lines*/
 	char *operation=NULL;/*pointer for operation*/
 	char *remaining_line=NULL;/*pointer for remaining line*/
+	char *save;/*position of strtok_r in the line*/
 	bool successful=true;/*success flag*/
+	bool failed=false;/*true once a line had an error*/
+	int line_number=0;/*number of the line being read*/
+	ExternLogSize log_size = {0, 0};/*the extern printing array starts empty*/
 	*extern_printing_array = NULL;/*initialize the extern printing array*/
 
-	file=fopen(filename, "r");/*open the input file*/
-	if(!file){/*if file open failed*/
-		perror("Error opening file");/*print error message*/
-		return false;/*return failure*/
-	}
-
-	while(fgets(line, sizeof(line), file)){/*read a line from the input file*/
+	while(!(failed && error_limit_reached()) && fgets(line, sizeof(line), file)){/*read a line from the input file*/
+		set_diagnostic_line(++line_number);
 		line[strcspn(line, "\r\n")]=0;/*trim newline characters*/
 
-		operation=strtok(line, " \t");/*split line to get operation or label*/
+		operation=strtok_r(line, " \t", &save);/*split line to get operation or label*/
 		if(operation&&strchr(operation, ':')!=NULL){/*if a label is present*/
 
-			operation=strtok(NULL, " \t");/*get the operation following the label*/
+			operation=strtok_r(NULL, " \t", &save);/*get the operation following the label*/
 
 			if(operation==NULL){/*if no operation after label*/
 				continue;/*skip this line*/
 			}
 
-			remaining_line=strtok(NULL, "");/*get the rest of the line*/
+			remaining_line=strtok_r(NULL, "", &save);/*get the rest of the line*/
 		}
 		else{
-			remaining_line=strtok(NULL, "");/*get the rest of the line*/
+			remaining_line=strtok_r(NULL, "", &save);/*get the rest of the line*/
 		}
 
 		if(operation==NULL || *operation=='\0'){/*if no operation found*/
@@ -580,34 +797,283 @@ bool second_pass(const char *filename,LabelArray *label_array,ExternEntryArray *
 		else if(strcmp(operation, ".data")==false){/*if the operation is .data*/
 			successful=handle_data_directive_SP(remaining_line, data_img, DC);/*handle the .data directive*/
 			if(!successful){/*if handling failed*/
-				fprintf(stderr, "Error processing .data directive on line %ld\n", *IC);
-				fclose(file);/*close the file*/
-				return false;/*return failure*/
+				report_error("Error processing .data directive\n");
 			}
 		}
 		else if(strcmp(operation, ".string")==false){/*if the operation is .string*/
 			successful=handle_string_directive_SP(remaining_line, data_img, DC);/*handle the .string directive*/
 			if(!successful){/*if handling failed*/
-				fprintf(stderr, "Error processing .string directive on line %ld\n", *IC);
-				fclose(file);/*close the file*/
-				return false;/*return failure*/
+				report_error("Error processing .string directive\n");
 			}
 		}
 		else if(is_operation(operation)){/*if the operation is a valid operation*/
-			successful=process_code(operation, remaining_line, IC, code_img, label_array, ext_entry_array, extern_printing_array);/*process the operation*/
-			if(!successful){/*if processing failed*/
-				fclose(file);/*close the file*/
-				return false;/*return failure*/
+			successful=process_code(operation, remaining_line, IC, code_img, label_array, ext_entry_array, extern_printing_array, &log_size);/*process the operation*/
+			if(successful && sink != NULL){/*if the output is streamed*/
+				successful=sink_code_words(sink, code_img, *IC, *extern_printing_array);/*write the words of the instruction*/
 			}
 		}
 		else{/*if the operation is unrecognized*/
-			fprintf(stderr, "Unrecognized operation or directive: %s\n", operation);/*print error message*/
-			fclose(file);/*close the file*/
-			return false;/*return failure*/
+			report_error("Unrecognized operation or directive: %s\n", operation);/*print error message*/
+			successful=false;
+		}
+		if(!successful){/*resynchronize at the next line*/
+			failed=true;
+			sink=NULL;/*the outputs are abandoned so nothing more is streamed*/
 		}
 	}
+	set_diagnostic_line(0);
 
-	fclose(file);/*close the file*/
-	return true;/*return success*/
+	return !failed;/*return success*/
+}
+
+
+/*** CHECK SECTION ***/
+
+/* 
+* check_operand
+* -------------
+* this function resolves the label of a direct operand against the externs and the labels without encoding it
+* it reports the same error as generate_non_register_code_word when the label is unknown
+* 
+* parameters:
+*   operand: the operand to be checked
+*   label_array: an array of labels used in the program
+*   ext_entry_array: an array of the extern and entry directives of the program
+* 
+* returns:
+*   bool: true if the operand is not a label or its label is known false otherwise
+*/
+bool check_operand(const char *operand,LabelArray *label_array,ExternEntryArray *ext_entry_array){
+	if(get_addressing_type((char*)operand)!=DIRECT_ADDR){/*only direct operands name a label*/
+		return true;
+	}
+	if(find_extern(ext_entry_array, operand)){/*look the extern up*/
+		return true;
+	}
+	if(find_label(label_array, operand)){/*look the label up*/
+		return true;
+	}
+	report_error("Error: Label '%s' was not initialized\n", operand);
+	return false;
+}
+
+/* 
+* check_code
+* ----------
+* this function checks a line of code the way process_code encodes it but without allocating any machine word
+* the operands are split into buffers on the stack and the instruction counter is advanced by the number of words
+* the operation would be encoded into so the errors that follow name the same line as the full second pass
+* 
+* parameters:
+*   operation: the operation or mnemonic to be checked
+*   operands_line: the line containing the operands
+*   ic: the instruction counter which tracks the current position in the code image
+*   labels: the array of labels used in the program
+*   ext_entry_array: an array of the extern and entry directives of the program
+* 
+* returns:
+*   bool: true if the operation and every label it uses are valid false otherwise
+*/
+bool check_code(const char *operation,const char *operands_line,long *ic,LabelArray *labels,ExternEntryArray *ext_entry_array){
+	char operands[2][MAX_OPERAND_LENGTH];/*buffers for the operands*/
+	char *token;/*pointer for strtok_r*/
+	char *save;/*position of strtok_r in the operands*/
+	int i = 0;/*operand counter*/
+	int j;/*loop counter*/
+	int operand_count;/*number of operands the operation takes*/
+	addressing_type addressing[2] = {NONE_ADDR, NONE_ADDR};/*addressing types of the operands*/
+	bool registers[2] = {false, false};/*true for an operand encoded into the shared register word*/
+
+	if(operands_line != NULL && *operands_line != '\0'){/*if there are operands*/
+		token = strtok_r((char*)operands_line, ", \t", &save);/*split operands*/
+		while(token != NULL && i < 2){/*loop through operands*/
+			if(strlen(token) >= MAX_OPERAND_LENGTH){/*an operand the buffer can't hold would be cut into another label*/
+				report_error("Error: Operand '%s' is longer than %d characters\n", token, MAX_LABEL_LENGTH);
+				return false;
+			}
+			strncpy(operands[i], token, MAX_OPERAND_LENGTH);/*copy operand*/
+			operands[i][MAX_OPERAND_LENGTH - 1] = '\0';/*null terminate operand*/
+			i++;/*increment operand counter*/
+			token = strtok_r(NULL, ", \t", &save);/*get next operand*/
+		}
+
+		if(i == 0){/*if no operands were extracted*/
+			report_error("Error: Operands not extracted correctly.\n");
+			return false;
+		}
+	}
+
+	if(get_opcode(operation) == NONE_OP){/*if operation is unrecognized*/
+		report_error("Error: Unrecognized operation: %s\n", operation);
+		return false;
+	}
+	operand_count = get_operand_count(operation);/*get number of operands*/
+	(*ic)++;/*the first word of the operation*/
+
+	for(j=0 ; j<i ; j++){
+		addressing[j] = get_addressing_type(operands[j]);/*get addressing type*/
+		if(addressing[j] == NONE_ADDR){/*if invalid addressing type*/
+			report_error("Error: Invalid addressing type for operand %d: %s\n", j + 1, operands[j]);
+			return false;
+		}
+		registers[j] = addressing[j] == REGISTER_ADDR || addressing[j] == RELATIVE_ADDR;
+	}
+
+	if(operand_count > 0 && i > 0){/*if there are operands to check*/
+		if(operand_count > 1 && i > 1 && registers[0] && registers[1]){/*both registers share a single word*/
+			(*ic)++;
+		}
+		else{
+			for(j=0 ; j<i && j<operand_count ; j++){/*in the order process_code encodes them*/
+				if(!registers[j] && !check_operand(operands[j], labels, ext_entry_array)){
+					return false;
+				}
+				(*ic)++;
+			}
+		}
+	}
+	return true;
 }
 
+/* 
+* check_pass_stream
+* -----------------
+* this function runs the checks of the second pass over a stream without encoding anything
+* every operation has its operands and labels resolved and every directive is validated
+* but no machine word is allocated and the data image is not populated so nothing can be written
+* it is what --check runs after the first pass
+* 
+* parameters:
+*   file: the stream holding the preprocessed source
+*   label_array: an array of labels used in the program
+*   ext_entry_array: an array of the extern and entry directives of the program
+* 
+* returns:
+*   bool: true if every line passed the checks false otherwise
+*/
+bool check_pass_stream(FILE *file,LabelArray *label_array,ExternEntryArray *ext_entry_array){
+	char line[MAX_LINE_LENGTH+1];/*buffer for reading lines*/
+	char *operation=NULL;/*pointer for operation*/
+	char *remaining_line=NULL;/*pointer for remaining line*/
+	char *save;/*position of strtok_r in the line*/
+	long ic=IC_INIT_VALUE;/*the instruction counter*/
+	long dc=0;/*the data counter*/
+	bool successful=true;/*success flag*/
+	bool failed=false;/*true once a line had an error*/
+	int line_number=0;/*number of the line being read*/
+
+	while(!(failed && error_limit_reached()) && fgets(line, sizeof(line), file)){/*read a line from the input file*/
+		set_diagnostic_line(++line_number);
+		line[strcspn(line, "\r\n")]=0;/*trim newline characters*/
+
+		operation=strtok_r(line, " \t", &save);/*split line to get operation or label*/
+		if(operation&&strchr(operation, ':')!=NULL){/*if a label is present*/
+			operation=strtok_r(NULL, " \t", &save);/*get the operation following the label*/
+		}
+		if(operation==NULL || *operation=='\0'){/*if no operation found*/
+			continue;/*skip this line*/
+		}
+		remaining_line=strtok_r(NULL, "", &save);/*get the rest of the line*/
+		if(remaining_line==NULL){/*if there is no remaining line*/
+			remaining_line="";/*set remaining line to empty string*/
+		}
+
+		if(strcmp(operation, ".extern")==false || strcmp(operation, ".entry")==false){/*if the operation is .extern or .entry*/
+			continue;/*checked by the first pass*/
+		}
+		else if(strcmp(operation, ".data")==false){/*if the operation is .data*/
+			successful=handle_data_directive_SP(remaining_line, NULL, &dc);/*check the .data directive*/
+			if(!successful){/*if checking failed*/
+				report_error("Error processing .data directive\n");
+			}
+		}
+		else if(strcmp(operation, ".string")==false){/*if the operation is .string*/
+			successful=handle_string_directive_SP(remaining_line, NULL, &dc);/*check the .string directive*/
+			if(!successful){/*if checking failed*/
+				report_error("Error processing .string directive\n");
+			}
+		}
+		else if(is_operation(operation)){/*if the operation is a valid operation*/
+			successful=check_code(operation, remaining_line, &ic, label_array, ext_entry_array);/*check the operation*/
+		}
+		else{/*if the operation is unrecognized*/
+			report_error("Unrecognized operation or directive: %s\n", operation);/*print error message*/
+			successful=false;
+		}
+		if(!successful){
+			failed=true;
+		}
+	}
+	set_diagnostic_line(0);
+
+	return !failed;/*return success*/
+}
+
+/* 
+* check_references_stream
+* -----------------------
+* this function resolves the labels of every operation against the labels the first pass collected
+* it runs after a first pass that failed so the undefined labels are reported in the same run as the errors of the first pass
+* only the operands of the lines the first pass accepted are looked up (its checks run again with their errors muted)
+* 
+* parameters:
+*   file: the stream holding the preprocessed source
+*   label_array: the labels the first pass collected
+*   ext_entry_array: the extern and entry directives the first pass collected
+* 
+* returns:
+*   bool: true if every label was found false otherwise
+*/
+bool check_references_stream(FILE *file,LabelArray *label_array,ExternEntryArray *ext_entry_array){
+	char line[MAX_LINE_LENGTH+1];/*buffer for reading lines*/
+	char copy[MAX_LINE_LENGTH+1];/*copy of the line or of its operands for the checks of the first pass*/
+	char *operation;/*pointer for operation*/
+	char *operands;/*the rest of the line after the operation*/
+	char *operand;/*pointer for an operand*/
+	char *save;/*position of strtok_r in the line*/
+	bool failed=false;/*true once a label was not found*/
+	bool accepted;/*true if the first pass accepted the line*/
+	int line_number=0;/*number of the line being read*/
+	int i;/*operand counter*/
+
+	while(!(failed && error_limit_reached()) && fgets(line, sizeof(line), file)){/*read a line from the input file*/
+		set_diagnostic_line(++line_number);
+		if(strchr(line, '\n') == NULL && !feof(file)){/*the first pass reported the line as too long*/
+			skip_rest_of_line(file);
+			continue;
+		}
+		line[strcspn(line, "\r\n")]=0;/*trim newline characters*/
+
+		/*check the line the way the first pass did without reporting its errors again*/
+		mute_diagnostics(true);
+		strcpy(copy, line);
+		accepted=validate_commas(copy, line_number, strstr(copy, ".data")!=NULL);
+		operation=strtok_r(line, " \t", &save);/*split line to get operation or label*/
+		if(operation&&strchr(operation, ':')!=NULL){/*if a label is present*/
+			*strchr(operation, ':')='\0';
+			accepted=accepted&&is_valid_label(operation);
+			operation=strtok_r(NULL, " \t", &save);/*get the operation following the label*/
+		}
+		operands=operation ? strtok_r(NULL, "\n", &save) : NULL;
+		if(operation&&is_operation(operation)){
+			strcpy(copy, operands ? operands : "");
+			accepted=accepted&&calculate_instruction_lines(operation, operands ? copy : NULL)>=0;
+		}
+		mute_diagnostics(false);
+		if(!accepted || operation==NULL || !is_operation(operation) || operands==NULL){/*only the operands of the lines the first pass sized name labels*/
+			continue;
+		}
+		for(i=0, operand=strtok_r(operands, ", \t", &save) ; operand && i<2 ; i++, operand=strtok_r(NULL, ", \t", &save)){
+			if(strlen(operand) >= MAX_OPERAND_LENGTH){/*the second pass would reject it the same way*/
+				report_error("Error: Operand '%s' is longer than %d characters\n", operand, MAX_LABEL_LENGTH);
+				failed=true;
+			}
+			else if(is_valid_label(operand) && !check_operand(operand, label_array, ext_entry_array)){
+				failed=true;
+			}
+		}
+	}
+	set_diagnostic_line(0);
+
+	return !failed;
+}
@@ -2,7 +2,7 @@
 #define SECOND_PASS_H
 
 #define MAX_OPERATION_LENGTH 10
-#define MAX_OPERAND_LENGTH 31
+#define MAX_OPERAND_LENGTH (MAX_LABEL_LENGTH + 1)/*size of the buffer of an operand (the longest operand is a label)*/
 
 #include <stdio.h>
 #include <string.h>
@@ -11,8 +11,24 @@
 #include <stdlib.h>
 #include "first_pass.h"
 #include "utils.h"
+#include "diagnostics.h"
 #include "definitions.h"
 
+/*** STRUCTURE DEFINITIONS SECTION ***/
+
+typedef struct{/*array that stores the code image indices of the words that hold a relocatable (ARE=2) address*/
+	long *indices;/*pointer to the array of code image indices*/
+	int count;/*number of relocated words*/
+	int capacity;/*capacity for dynamic allocation*/
+}RelocationArray;
+
+typedef struct{/*size of a terminated array of extern references so a reference is appended without looking for the terminator*/
+	int count;/*number of references before the terminator*/
+	int capacity;/*number of entries allocated including the terminator*/
+}ExternLogSize;
+
+typedef struct object_sink ObjectSink;/*sink that streams the output files while the second pass runs (defined in file_writer.h)*/
+
 /*** CODE WORD HANDLING SECTION ***/
 
 codeWord *create_code_word(opcode curr_opcode,int op_count,char *operands[2]); /* function to create a code word */
@@ -24,21 +40,38 @@ dataWord *handle_non_register_address_word(addressing_type addressing,long data,
 
 /*** CODEWORD GENERATION SECTION ***/
 
-void generate_non_register_code_word(MachineWordsArray **code_img,long *ic,char *operand,LabelArray *labels,ExternEntryArray *ext_entry_array,ExternEntry **extern_printing_array);/*function to generate code word for non-register operands*/
-void generate_register_code_word(MachineWordsArray **code_img,long *ic,addressing_type first_operand_addr,addressing_type second_operand_addr,char *operand1,char *operand2);/* function to generate code word for register operands*/
+bool log_extern_reference(ExternEntry **extern_printing_array,ExternLogSize *log_size,const char *name,long address);/*function to append an extern reference to the terminated array of references*/
+bool generate_non_register_code_word(MachineWordsArray **code_img,long *ic,char *operand,LabelArray *labels,ExternEntryArray *ext_entry_array,ExternEntry **extern_printing_array,ExternLogSize *log_size);/*function to generate code word for non-register operands*/
+bool generate_register_code_word(MachineWordsArray **code_img,long *ic,addressing_type first_operand_addr,addressing_type second_operand_addr,char *operand1,char *operand2);/* function to generate code word for register operands*/
 
 /*** OPERATION PROCESSING SECTION ***/
 
-bool process_code(const char *operation,const char *operands_line,long *ic,MachineWordsArray **code_img,LabelArray *labels,ExternEntryArray *ext_entry_array,ExternEntry **extern_printing_array);/*function to process an operation and generate corresponding machine code*/
+bool process_code(const char *operation,const char *operands_line,long *ic,MachineWordsArray **code_img,LabelArray *labels,ExternEntryArray *ext_entry_array,ExternEntry **extern_printing_array,ExternLogSize *log_size);/*function to process an operation and generate corresponding machine code*/
 
 /*** DIRECTIVE HANDLING SECTION ***/
 
 bool handle_data_directive_SP(const char *line,long *data_img,long *dc);/*function to handle .data directive in the second pass*/
 bool handle_string_directive_SP(const char *line,long *data_img,long *dc);/*function to handle .string directive in the second pass*/
 
+/*** RELOCATION SECTION ***/
+
+void initialize_relocation_array(RelocationArray *array);/*function to initialize the RelocationArray structure*/
+void free_relocation_array(RelocationArray *array);/*function to free the RelocationArray structure*/
+bool add_relocation(RelocationArray *array,long index);/*function to add the index of a relocated word*/
+bool build_relocation_table(MachineWordsArray **code_img,long icf,RelocationArray *relocations);/*function to collect the relocatable words of the code image*/
+void relocate_program(MachineWordsArray **code_img,RelocationArray *relocations,ExternEntryArray *ext_entry_array,ExternEntry *extern_printing_array,long delta);/*function to move the program by delta addresses touching only the relocated words*/
+
 /*** SECOND PASS MAIN FUNCTION ***/
 
-bool second_pass(const char *filename,LabelArray *label_array,ExternEntryArray *ext_entry_array,MachineWordsArray **code_img,long *data_img,long *IC,long *DC,ExternEntry **extern_printing_array);/*main function for the second pass*/
+bool second_pass(const char *filename,LabelArray *label_array,ExternEntryArray *ext_entry_array,MachineWordsArray **code_img,long *data_img,long *IC,long *DC,ExternEntry **extern_printing_array,ObjectSink *sink);/*main function for the second pass*/
+bool second_pass_stream(FILE *file,LabelArray *label_array,ExternEntryArray *ext_entry_array,MachineWordsArray **code_img,long *data_img,long *IC,long *DC,ExternEntry **extern_printing_array,ObjectSink *sink);/*function to run the second pass over a stream*/
+
+/*** CHECK SECTION ***/
+
+bool check_operand(const char *operand,LabelArray *label_array,ExternEntryArray *ext_entry_array);/*function to resolve the label of an operand without encoding it*/
+bool check_code(const char *operation,const char *operands_line,long *ic,LabelArray *labels,ExternEntryArray *ext_entry_array);/*function to check an operation without allocating its words*/
+bool check_pass_stream(FILE *file,LabelArray *label_array,ExternEntryArray *ext_entry_array);/*function to run the checks of the second pass over a stream without encoding*/
+bool check_references_stream(FILE *file,LabelArray *label_array,ExternEntryArray *ext_entry_array);/*function to resolve the labels of every operation after a first pass that failed*/
 
 #endif /* SECOND_PASS_H */
 
@@ -0,0 +1,1071 @@
+#define _GNU_SOURCE/*struct ucred and SO_PEERCRED are not part of ansi c*/
+#include "server.h"
+#include "diagnostics.h"
+#include "work_pool.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+
+/*** FRAMES SECTION ***/
+
+/*
+* write_all
+* ---------
+* this function writes a whole buffer to a descriptor retrying short writes and interrupted calls
+*
+* parameters:
+*   fd: the descriptor to write to
+*   data: the bytes to write
+*   length: the number of bytes
+*
+* returns:
+*   bool: true if every byte was written false otherwise
+*/
+bool write_all(int fd, const char *data, size_t length){
+	ssize_t written;
+
+	while(length > 0){
+		written = write(fd, data, length);
+		if(written < 0 && errno == EINTR){
+			continue;
+		}
+		if(written <= 0){
+			return false;
+		}
+		data += written;
+		length -= written;
+	}
+	return true;
+}
+
+/*
+* read_all
+* --------
+* this function reads exactly length bytes from a descriptor retrying short reads and interrupted calls
+*
+* parameters:
+*   fd: the descriptor to read from
+*   data: the buffer that receives the bytes
+*   length: the number of bytes
+*
+* returns:
+*   bool: true if every byte was read false on an error or at the end of the stream
+*/
+bool read_all(int fd, char *data, size_t length){
+	ssize_t count;
+
+	while(length > 0){
+		count = read(fd, data, length);
+		if(count < 0 && errno == EINTR){
+			continue;
+		}
+		if(count <= 0){
+			return false;
+		}
+		data += count;
+		length -= count;
+	}
+	return true;
+}
+
+/*
+* create_shared_memory
+* --------------------
+* this function creates a shared memory object that holds a payload and unlinks its name right away
+* the object lives only as long as a descriptor or a mapping refers to it so nothing is left behind
+*
+* parameters:
+*   payload: the bytes to store
+*   length: the number of bytes
+*
+* returns:
+*   int: a descriptor of the object or -1 if it couldn't be created
+*/
+int create_shared_memory(const char *payload, size_t length){
+	char name[64];/*name of the object while it is linked*/
+	int fd = -1, attempt;
+
+	for(attempt=0 ; fd < 0 && attempt < 16 ; attempt++){/*find a name no other thread or process is using*/
+		sprintf(name, "/assembler-%ld-%lx-%d", (long)getpid(), (unsigned long)(size_t)name, attempt);
+		fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+	}
+	if(fd < 0){
+		return -1;
+	}
+	shm_unlink(name);
+	if(!write_all(fd, payload, length)){
+		close(fd);
+		return -1;
+	}
+	return fd;
+}
+
+/*
+* send_frame
+* ----------
+* this function sends a payload to the other end of a socket
+* a payload longer than SERVER_INLINE_LIMIT is placed in shared memory and only its descriptor is sent
+*
+* parameters:
+*   socket_fd: the connected socket
+*   payload: the bytes of the payload
+*   length: the number of bytes
+*
+* returns:
+*   bool: true if the frame was sent false otherwise
+*/
+bool send_frame(int socket_fd, const char *payload, size_t length){
+	FrameHeader header;
+	struct msghdr message;
+	struct iovec vector;
+	union{/*room for one descriptor aligned for a control message*/
+		struct cmsghdr align;
+		char buffer[CMSG_SPACE(sizeof(int))];
+	}control;
+	struct cmsghdr *control_message;
+	int shared_fd = -1;
+	ssize_t count;
+	bool success;
+
+	memcpy(header.magic, SERVER_MAGIC, SERVER_MAGIC_LENGTH);
+	header.version = SERVER_PROTOCOL_VERSION;
+	header.shared = length > SERVER_INLINE_LIMIT;
+	header.payload_length = (unsigned int)length;
+	if(header.shared){
+		shared_fd = create_shared_memory(payload, length);
+		if(shared_fd < 0){
+			header.shared = 0;/*fall back to sending the payload through the socket*/
+		}
+	}
+
+	memset(&message, 0, sizeof(message));
+	vector.iov_base = &header;
+	vector.iov_len = sizeof(header);
+	message.msg_iov = &vector;
+	message.msg_iovlen = 1;
+	if(header.shared){/*pass the descriptor of the shared memory with the header*/
+		memset(&control, 0, sizeof(control));
+		message.msg_control = control.buffer;
+		message.msg_controllen = sizeof(control.buffer);
+		control_message = CMSG_FIRSTHDR(&message);
+		control_message->cmsg_level = SOL_SOCKET;
+		control_message->cmsg_type = SCM_RIGHTS;
+		control_message->cmsg_len = CMSG_LEN(sizeof(int));
+		memcpy(CMSG_DATA(control_message), &shared_fd, sizeof(int));
+	}
+	while((count = sendmsg(socket_fd, &message, 0)) < 0 && errno == EINTR);
+	success = count == (ssize_t)sizeof(header);
+	if(shared_fd >= 0){
+		close(shared_fd);/*the receiver holds its own descriptor now*/
+	}
+	return success && (header.shared || write_all(socket_fd, payload, length));
+}
+
+/*
+* receive_frame
+* -------------
+* this function receives the next payload from a socket
+* a payload in shared memory is mapped instead of copied
+*
+* parameters:
+*   socket_fd: the connected socket
+*   frame: the frame that receives the payload (release it with release_frame)
+*
+* returns:
+*   bool: true if a valid frame was received false at the end of the stream or on an invalid frame
+*/
+bool receive_frame(int socket_fd, Frame *frame){
+	FrameHeader header;
+	struct msghdr message;
+	struct iovec vector;
+	union{/*room for one descriptor aligned for a control message*/
+		struct cmsghdr align;
+		char buffer[CMSG_SPACE(sizeof(int))];
+	}control;
+	struct cmsghdr *control_message;
+	struct stat status;
+	int shared_fd = -1;
+	ssize_t count;
+	bool success;
+
+	frame->data = NULL;
+	frame->length = 0;
+	frame->mapped = false;
+
+	memset(&message, 0, sizeof(message));
+	vector.iov_base = &header;
+	vector.iov_len = sizeof(header);
+	message.msg_iov = &vector;
+	message.msg_iovlen = 1;
+	message.msg_control = control.buffer;
+	message.msg_controllen = sizeof(control.buffer);
+	while((count = recvmsg(socket_fd, &message, 0)) < 0 && errno == EINTR);
+	if(count <= 0){
+		return false;
+	}
+	for(control_message = CMSG_FIRSTHDR(&message) ; control_message ; control_message = CMSG_NXTHDR(&message, control_message)){
+		if(control_message->cmsg_level == SOL_SOCKET && control_message->cmsg_type == SCM_RIGHTS){
+			memcpy(&shared_fd, CMSG_DATA(control_message), sizeof(int));
+		}
+	}
+	success = (count == (ssize_t)sizeof(header) || read_all(socket_fd, (char*)&header + count, sizeof(header) - count));
+	success = success && memcmp(header.magic, SERVER_MAGIC, SERVER_MAGIC_LENGTH) == 0 && header.version == SERVER_PROTOCOL_VERSION;
+	success = success && header.payload_length <= SERVER_MAX_PAYLOAD && (header.shared == 0) == (shared_fd < 0);
+	if(success){
+		frame->length = header.payload_length;
+		if(header.shared){/*map the payload in place*/
+			success = fstat(shared_fd, &status) == 0 && status.st_size >= (off_t)frame->length;/*a short object would fault when it is read*/
+			frame->data = success && frame->length > 0 ? (char*)mmap(NULL, frame->length, PROT_READ, MAP_SHARED, shared_fd, 0) : NULL;
+			frame->mapped = frame->data != NULL;
+			success = success && (frame->length == 0 || frame->data != (char*)MAP_FAILED);
+			if(!success){
+				frame->data = NULL;
+				frame->mapped = false;
+			}
+		}
+		else{
+			frame->data = (char*)malloc(frame->length + 1);
+			success = frame->data && read_all(socket_fd, frame->data, frame->length);
+		}
+	}
+	if(shared_fd >= 0){
+		close(shared_fd);/*the mapping keeps the memory alive*/
+	}
+	if(!success){
+		release_frame(frame);
+	}
+	return success;
+}
+
+/*
+* release_frame
+* -------------
+* this function frees or unmaps the payload of a received frame
+*
+* parameters:
+*   frame: the frame to release
+*
+*/
+void release_frame(Frame *frame){
+	if(frame->mapped){
+		munmap(frame->data, frame->length);
+	}
+	else{
+		free(frame->data);
+	}
+	frame->data = NULL;
+	frame->length = 0;
+	frame->mapped = false;
+}
+
+/*
+* connect_to_server
+* -----------------
+* this function connects to the unix socket of a daemon
+*
+* parameters:
+*   path: the path of the socket
+*
+* returns:
+*   int: the connected socket or -1 if no daemon is listening
+*/
+int connect_to_server(const char *path){
+	struct sockaddr_un address;
+	int socket_fd;
+
+	if(strlen(path) >= sizeof(address.sun_path)){
+		return -1;
+	}
+	memset(&address, 0, sizeof(address));
+	address.sun_family = AF_UNIX;
+	strcpy(address.sun_path, path);
+	socket_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+	if(socket_fd < 0){
+		return -1;
+	}
+	if(connect(socket_fd, (struct sockaddr*)&address, sizeof(address)) != 0){
+		close(socket_fd);
+		return -1;
+	}
+	return socket_fd;
+}
+
+/*** DAEMON SECTION ***/
+
+/*
+* handle_request
+* --------------
+* this function assembles the source of a single request with the same pipeline as the command line
+* the outputs are assembled in memory and everything the pipeline prints is collected for the client
+*
+* parameters:
+*   request: the payload of the request
+*   response: a pointer that receives the payload of the response (freed by the caller)
+*   response_length: a pointer that receives the length of the response
+*
+* returns:
+*   bool: true if a response was built false if the request is invalid
+*/
+bool handle_request(const Frame *request, char **response, size_t *response_length){
+	RequestHeader header;
+	ResponseHeader result;
+	AssemblerOptions options;
+	ObjectSink sink;
+	FILE *source = NULL, *messages, *errors, *payload;
+	char *name;
+	char *message_text = NULL, *error_text = NULL;
+	size_t message_size = 0, error_size = 0;
+	const char *body = request->data + sizeof(RequestHeader);
+	bool success;
+	int i;
+
+	if(request->length < sizeof(RequestHeader)){
+		return false;
+	}
+	memcpy(&header, request->data, sizeof(header));
+	if((size_t)header.name_length + header.source_length != request->length - sizeof(RequestHeader)){
+		return false;
+	}
+	name = (char*)malloc(header.name_length + 1);
+	if(!name){
+		return false;
+	}
+	memcpy(name, body, header.name_length);
+	name[header.name_length] = '\0';
+
+	initialize_options(&options);
+	options.format = header.format == BINARY_OBJECT ? BINARY_OBJECT : TEXT_OBJECT;
+	options.load_base = header.load_base;
+	options.write_relocations = header.write_relocations != 0;
+	options.write_map = header.write_map != 0;
+	options.write_report = header.write_report != 0;
+	options.write_report_json = header.write_report_json != 0;
+	for(i=0 ; i<OPERATION_COUNT ; i++){
+		options.cost_table.operation_cycles[i] = (int)header.operation_cycles[i];
+	}
+	for(i=0 ; i<ADDRESSING_MODE_COUNT ; i++){
+		options.cost_table.mode_cycles[i] = (int)header.mode_cycles[i];
+	}
+	options.max_errors = (int)header.max_errors;
+
+	/*collect everything the pipeline prints*/
+	messages = open_memstream(&message_text, &message_size);
+	errors = open_memstream(&error_text, &error_size);
+	redirect_output(messages, errors);
+
+	initialize_object_sink(&sink, name, true);/*assemble the outputs into memory*/
+	source = open_buffer(body + header.name_length, header.source_length);
+	if(!source){
+		print_system_error("Error: couldn't read the source");
+	}
+	success = source && process_file(name, source, &sink, &options);
+	if(source){
+		fclose(source);
+	}
+
+	redirect_output(NULL, NULL);
+	if(messages){
+		fclose(messages);
+	}
+	if(errors){
+		fclose(errors);
+	}
+
+	/*build the response*/
+	result.success = success;
+	result.messages_length = (unsigned int)message_size;
+	result.errors_length = (unsigned int)error_size;
+	for(i=0 ; i<SINK_OUTPUT_COUNT ; i++){
+		result.output_lengths[i] = success && sink.outputs[i].opened ? (unsigned int)sink.outputs[i].size : SERVER_NO_OUTPUT;
+	}
+	*response = NULL;
+	*response_length = 0;
+	payload = open_memstream(response, response_length);
+	if(payload){
+		fwrite(&result, sizeof(result), 1, payload);
+		fwrite(message_text, 1, message_size, payload);
+		fwrite(error_text, 1, error_size, payload);
+		for(i=0 ; i<SINK_OUTPUT_COUNT ; i++){
+			if(result.output_lengths[i] != SERVER_NO_OUTPUT){
+				fwrite(sink.outputs[i].buffer, 1, sink.outputs[i].size, payload);
+			}
+		}
+		fclose(payload);
+	}
+	release_object_sink(&sink);
+	free(message_text);
+	free(error_text);
+	free(name);
+	return payload != NULL;
+}
+
+typedef struct{/*the connections of the daemon shared by its dispatcher and its workers*/
+	int listener;/*the listening socket*/
+	int wake[2];/*pipe a worker writes to when it gives a connection back to the dispatcher*/
+	int *ready;/*connections with a request waiting for a worker*/
+	int ready_count;/*number of ready connections*/
+	int *returned;/*connections the workers answered and gave back*/
+	int returned_count;/*number of returned connections*/
+	int connections;/*number of connections the daemon holds*/
+	int capacity;/*capacity of ready and returned (the most connections the daemon can hold)*/
+	pthread_mutex_t lock;/*protects ready returned and their counts*/
+	pthread_cond_t available;/*signaled when a connection becomes ready*/
+}ServerState;
+
+/*
+* serve_request
+* -------------
+* this function answers a single request of a client
+* a worker answers one request at a time and gives the connection back so a client with many idle connections never holds a worker
+*
+* parameters:
+*   client: the connected socket of the client whose request is waiting
+*
+* returns:
+*   bool: true if the request was answered false if the client closed the connection or failed
+*/
+bool serve_request(int client){
+	Frame request;
+	char *response;
+	size_t response_length;
+	bool success;
+
+	if(!receive_frame(client, &request)){
+		return false;
+	}
+	success = handle_request(&request, &response, &response_length);
+	release_frame(&request);
+	success = success && send_frame(client, response, response_length);
+	free(response);
+	return success;
+}
+
+/*
+* same_user
+* ---------
+* this function checks that the process at the other end of a connection runs as the same user as the daemon
+* the outputs travel back to the client so a daemon must not assemble for other users with its own permissions
+*
+* parameters:
+*   client: the connected socket of the client
+*
+* returns:
+*   bool: true if the client runs as the user of the daemon false otherwise
+*/
+bool same_user(int client){
+	struct ucred credentials;
+	socklen_t length = sizeof(credentials);
+
+	return getsockopt(client, SOL_SOCKET, SO_PEERCRED, &credentials, &length) == 0 && credentials.uid == geteuid();
+}
+
+/*
+* server_worker
+* -------------
+* this function is run by every worker thread of the daemon
+* a worker takes the next connection with a waiting request answers that request and gives the connection back to the dispatcher
+*
+* parameters:
+*   context: a pointer to the ServerState
+*
+* returns:
+*   void*: never returns while the daemon runs
+*/
+void *server_worker(void *context){
+	ServerState *state = (ServerState*)context;
+	int client;
+
+	for(;;){
+		pthread_mutex_lock(&state->lock);
+		while(state->ready_count == 0){
+			pthread_cond_wait(&state->available, &state->lock);
+		}
+		client = state->ready[--state->ready_count];
+		pthread_mutex_unlock(&state->lock);
+
+		if(!serve_request(client)){
+			close(client);
+			pthread_mutex_lock(&state->lock);
+			state->connections--;
+			pthread_mutex_unlock(&state->lock);
+			continue;
+		}
+		pthread_mutex_lock(&state->lock);
+		state->returned[state->returned_count++] = client;
+		pthread_mutex_unlock(&state->lock);
+		while(write(state->wake[1], "", 1) < 0 && errno == EINTR);/*wake the dispatcher to watch the connection again*/
+	}
+	return NULL;
+}
+
+/*
+* grow_connections
+* ----------------
+* this function makes room for one more connection in the arrays of the daemon
+*
+* parameters:
+*   state: the state of the daemon (its lock is held by the caller)
+*   idle: the connections the dispatcher watches (one entry per connection)
+*   fds: the descriptors the dispatcher polls (two more entries than idle)
+*
+* returns:
+*   bool: true if there is room false if memory allocation failed
+*/
+bool grow_connections(ServerState *state, int **idle, struct pollfd **fds){
+	int capacity = state->capacity ? state->capacity * 2 : 16;
+	int *ready, *returned, *grown_idle;
+	struct pollfd *grown_fds;
+
+	ready = (int*)realloc(state->ready, capacity * sizeof(int));
+	if(ready){
+		state->ready = ready;
+	}
+	returned = ready ? (int*)realloc(state->returned, capacity * sizeof(int)) : NULL;
+	if(returned){
+		state->returned = returned;
+	}
+	grown_idle = returned ? (int*)realloc(*idle, capacity * sizeof(int)) : NULL;
+	if(grown_idle){
+		*idle = grown_idle;
+	}
+	grown_fds = grown_idle ? (struct pollfd*)realloc(*fds, (capacity + 2) * sizeof(struct pollfd)) : NULL;
+	if(!grown_fds){
+		return false;
+	}
+	*fds = grown_fds;
+	state->capacity = capacity;
+	return true;
+}
+
+/*
+* server_dispatcher
+* -----------------
+* this function is run by the dispatcher thread of the daemon
+* it polls the listening socket and every idle connection and hands a connection to the workers once a request arrives on it
+* so any number of connections share the workers one request at a time
+*
+* parameters:
+*   context: a pointer to the ServerState
+*
+* returns:
+*   void*: never returns while the daemon runs
+*/
+void *server_dispatcher(void *context){
+	ServerState *state = (ServerState*)context;
+	struct pollfd *fds = (struct pollfd*)malloc(2 * sizeof(struct pollfd));/*the listener the wake pipe and the idle connections*/
+	int *idle = NULL;/*the connections waiting for a request*/
+	int idle_count = 0, client, i;
+	char drained[64];
+
+	if(!fds){
+		perror("Error: memory allocation failed");
+		return NULL;
+	}
+	for(;;){
+		fds[0].fd = state->listener;
+		fds[0].events = POLLIN;
+		fds[1].fd = state->wake[0];
+		fds[1].events = POLLIN;
+		for(i=0 ; i<idle_count ; i++){
+			fds[i + 2].fd = idle[i];
+			fds[i + 2].events = POLLIN;
+		}
+		if(poll(fds, idle_count + 2, -1) < 0){
+			continue;/*interrupted*/
+		}
+
+		/*a connection with a request is handed to the workers (a closed one too so a worker closes it)*/
+		for(i=idle_count - 1 ; i>=0 ; i--){
+			if(fds[i + 2].revents){
+				pthread_mutex_lock(&state->lock);
+				state->ready[state->ready_count++] = idle[i];
+				pthread_cond_signal(&state->available);
+				pthread_mutex_unlock(&state->lock);
+				idle[i] = idle[--idle_count];
+			}
+		}
+
+		/*connections the workers gave back are watched again*/
+		if(fds[1].revents & POLLIN){
+			while(read(state->wake[0], drained, sizeof(drained)) == (ssize_t)sizeof(drained));
+		}
+		pthread_mutex_lock(&state->lock);
+		while(state->returned_count > 0){
+			idle[idle_count++] = state->returned[--state->returned_count];
+		}
+		pthread_mutex_unlock(&state->lock);
+
+		/*a new connection of the user of the daemon is watched for its first request*/
+		if(fds[0].revents & POLLIN){
+			client = accept(state->listener, NULL, NULL);
+			if(client >= 0 && !same_user(client)){/*refuse the connection without reading a request*/
+				close(client);
+			}
+			else if(client >= 0){
+				pthread_mutex_lock(&state->lock);
+				if(state->connections == state->capacity && !grow_connections(state, &idle, &fds)){
+					close(client);
+				}
+				else{
+					idle[idle_count++] = client;
+					state->connections++;
+				}
+				pthread_mutex_unlock(&state->lock);
+			}
+			else if(errno != EINTR && errno != ECONNABORTED && errno != EAGAIN){
+				perror("Error: accept failed");
+				sleep(1);/*don't spin when descriptors run out*/
+			}
+		}
+	}
+	return NULL;
+}
+
+/*
+* run_server
+* ----------
+* this function runs the assembler as a daemon that listens on a unix socket
+* the opcode tables and everything else the pipeline sets up stay loaded between requests
+* so a request costs only the assembling itself instead of a process start
+* a dispatcher thread watches the connections and the workers answer their requests one at a time
+* the daemon runs until it receives SIGINT or SIGTERM and then removes its socket
+*
+* parameters:
+*   path: the path of the socket
+*   options: the command line options (jobs sets the number of worker threads)
+*
+* returns:
+*   int: 0 when the daemon was stopped 1 if it couldn't start
+*/
+int run_server(const char *path, const AssemblerOptions *options){
+	struct sockaddr_un address;
+	struct stat status;
+	sigset_t signals;
+	pthread_t thread;
+	ServerState state;
+	int listener, existing, i, signal_number, started = 0;
+
+	if(strlen(path) >= sizeof(address.sun_path)){
+		fprintf(stderr, "Error: socket path '%s' is too long\n", path);
+		return 1;
+	}
+	existing = connect_to_server(path);
+	if(existing >= 0){
+		close(existing);
+		fprintf(stderr, "Error: a daemon is already listening on '%s'\n", path);
+		return 1;
+	}
+	if(stat(path, &status) == 0){
+		if(!S_ISSOCK(status.st_mode)){
+			fprintf(stderr, "Error: '%s' exists and is not a socket\n", path);
+			return 1;
+		}
+		unlink(path);/*remove the socket a stopped daemon left behind*/
+	}
+
+	memset(&address, 0, sizeof(address));
+	address.sun_family = AF_UNIX;
+	strcpy(address.sun_path, path);
+	listener = socket(AF_UNIX, SOCK_STREAM, 0);
+	if(listener < 0 || bind(listener, (struct sockaddr*)&address, sizeof(address)) != 0 || listen(listener, SOMAXCONN) != 0){
+		perror("Error: couldn't listen on the socket");
+		if(listener >= 0){
+			close(listener);
+		}
+		return 1;
+	}
+
+	/*the workers inherit a mask that leaves the stop signals to the main thread and ignores closed clients*/
+	sigemptyset(&signals);
+	sigaddset(&signals, SIGINT);
+	sigaddset(&signals, SIGTERM);
+	sigaddset(&signals, SIGPIPE);
+	pthread_sigmask(SIG_BLOCK, &signals, NULL);
+
+	memset(&state, 0, sizeof(state));
+	state.listener = listener;
+	if(pipe(state.wake) != 0){
+		perror("Error: couldn't create the wake pipe");
+		close(listener);
+		unlink(path);
+		return 1;
+	}
+	fcntl(state.wake[0], F_SETFL, O_NONBLOCK);
+	fcntl(state.wake[1], F_SETFL, O_NONBLOCK);/*a full pipe already wakes the dispatcher*/
+	pthread_mutex_init(&state.lock, NULL);
+	pthread_cond_init(&state.available, NULL);
+	for(i=0 ; i<options->jobs ; i++){
+		if(pthread_create(&thread, NULL, server_worker, &state) == 0){
+			pthread_detach(thread);
+			started++;
+		}
+	}
+	if(started == 0 || pthread_create(&thread, NULL, server_dispatcher, &state) != 0){
+		fprintf(stderr, "Error: couldn't start the worker threads\n");
+		close(listener);
+		unlink(path);
+		return 1;
+	}
+	pthread_detach(thread);
+	fprintf(stderr, "assembler daemon listening on %s with %d workers\n", path, started);
+
+	sigdelset(&signals, SIGPIPE);
+	do{
+		sigwait(&signals, &signal_number);
+	}while(signal_number != SIGINT && signal_number != SIGTERM);
+
+	unlink(path);
+	fprintf(stderr, "assembler daemon stopped\n");
+	return 0;
+}
+
+/*** CLIENT SECTION ***/
+
+typedef struct{/*everything a forwarded file printed and whether the daemon handled it*/
+	char *messages;/*progress messages meant for stdout*/
+	size_t messages_size;/*length of the progress messages*/
+	char *errors;/*warnings and errors meant for stderr*/
+	size_t errors_size;/*length of the warnings and errors*/
+	bool handled;/*true if the daemon answered for the file*/
+}RemoteReport;
+
+typedef struct{/*the state shared by the tasks of a parallel forward*/
+	const char *path;/*the path of the socket of the daemon*/
+	char **files;/*the file arguments*/
+	char **outputs;/*base names of the output files of every file argument*/
+	const AssemblerOptions *options;/*the command line options*/
+	RemoteReport *reports;/*one report per file argument*/
+	int *connections;/*the idle connections (-1 for one that is not open yet)*/
+	int idle;/*number of idle connections*/
+	pthread_mutex_t lock;/*protects connections and idle*/
+}RemoteRun;
+
+/*
+* read_source
+* -----------
+* this function reads a whole source file into memory
+*
+* parameters:
+*   file: the open source file
+*   length: a pointer that receives the length of the source
+*
+* returns:
+*   char*: the source (freed by the caller) or NULL if memory allocation failed
+*/
+char *read_source(FILE *file, size_t *length){
+	char *buffer = NULL, *grown;
+	size_t capacity = 0, count;
+
+	*length = 0;
+	do{
+		if(*length == capacity){
+			capacity = capacity ? capacity * 2 : 16384;
+			grown = (char*)realloc(buffer, capacity);
+			if(!grown){
+				free(buffer);
+				return NULL;
+			}
+			buffer = grown;
+		}
+		count = fread(buffer + *length, 1, capacity - *length, file);
+		*length += count;
+	}while(count > 0);
+	return buffer;
+}
+
+/*
+* forward_file
+* ------------
+* this function sends a single file argument to the daemon and writes the outputs it returns
+* the outputs go through a disk sink so they appear all at once like when the file is assembled locally
+*
+* parameters:
+*   socket_fd: the connection to the daemon
+*   basename: the file argument (base name without the .as suffix)
+*   output_name: the base name of the output files
+*   options: the command line options
+*
+* returns:
+*   bool: true if the daemon answered false if the connection failed
+*/
+bool forward_file(int socket_fd, const char *basename, const char *output_name, const AssemblerOptions *options){
+	RequestHeader header;
+	ResponseHeader result;
+	ObjectSink sink;
+	Frame response;
+	FILE *file, *payload, *output;
+	char *input_filename, *source, *request = NULL;
+	const char *body, *data;
+	size_t source_length, request_length = 0, expected;
+	bool success;
+	int i;
+
+	input_filename = (char*)malloc(strlen(basename) + 4);
+	if(!input_filename){
+		return false;
+	}
+	sprintf(input_filename, "%s.as", basename);
+	file = fopen(input_filename, "r");
+	free(input_filename);
+	if(!file){
+		fprintf(error_output(), "Warning: file %s.as does not exist skipping it\n", basename);
+		return true;
+	}
+	source = read_source(file, &source_length);
+	fclose(file);
+	if(!source){
+		return false;
+	}
+
+	/*build and send the request*/
+	header.format = options->format;
+	header.write_relocations = options->write_relocations;
+	header.write_map = options->write_map;
+	header.write_report = options->write_report;
+	header.write_report_json = options->write_report_json;
+	for(i=0 ; i<OPERATION_COUNT ; i++){
+		header.operation_cycles[i] = (unsigned int)options->cost_table.operation_cycles[i];
+	}
+	for(i=0 ; i<ADDRESSING_MODE_COUNT ; i++){
+		header.mode_cycles[i] = (unsigned int)options->cost_table.mode_cycles[i];
+	}
+	header.load_base = (unsigned int)options->load_base;
+	header.max_errors = (unsigned int)options->max_errors;
+	header.name_length = (unsigned int)strlen(basename);
+	header.source_length = (unsigned int)source_length;
+	payload = open_memstream(&request, &request_length);
+	if(!payload){
+		free(source);
+		return false;
+	}
+	fwrite(&header, sizeof(header), 1, payload);
+	fwrite(basename, 1, header.name_length, payload);
+	fwrite(source, 1, source_length, payload);
+	fclose(payload);
+	free(source);
+	success = send_frame(socket_fd, request, request_length) && receive_frame(socket_fd, &response);
+	free(request);
+	if(!success){
+		return false;
+	}
+
+	/*check the response*/
+	success = response.length >= sizeof(result);
+	if(success){
+		memcpy(&result, response.data, sizeof(result));
+		expected = sizeof(result) + (size_t)result.messages_length + result.errors_length;
+		for(i=0 ; i<SINK_OUTPUT_COUNT ; i++){
+			expected += result.output_lengths[i] != SERVER_NO_OUTPUT ? result.output_lengths[i] : 0;
+		}
+		success = expected == response.length;
+	}
+	if(!success){
+		release_frame(&response);
+		return false;
+	}
+
+	/*write the outputs then print what the file printed on the daemon*/
+	body = response.data + sizeof(result);
+	data = body + result.messages_length + result.errors_length;/*the outputs follow the messages*/
+	if(result.success){
+		initialize_object_sink(&sink, output_name, false);
+		success = true;
+		for(i=0 ; success && i<SINK_OUTPUT_COUNT ; i++){
+			if(result.output_lengths[i] == SERVER_NO_OUTPUT){
+				continue;
+			}
+			output = open_sink_output(&sink, (sink_output)i);
+			success = output != NULL;
+			if(success){
+				fwrite(data, 1, result.output_lengths[i], output);
+				data += result.output_lengths[i];
+			}
+		}
+		if(success){
+			commit_object_sink(&sink);
+		}
+		else{
+			abort_object_sink(&sink);
+		}
+	}
+	fwrite(body, 1, result.messages_length, message_output());
+	fwrite(body + result.messages_length, 1, result.errors_length, error_output());
+	release_frame(&response);
+	return true;
+}
+
+/*
+* forward_file_job
+* ----------------
+* this function is the task a worker of forward_files_parallel runs for a single file
+* the worker takes an idle connection (opening it on first use) so every worker talks to its own daemon thread
+* everything the file prints is collected in its RemoteReport so the main thread can print it in argv order
+*
+* parameters:
+*   task: the index of the file argument
+*   context: the RemoteRun shared by all the tasks
+*
+*/
+void forward_file_job(int task, void *context){
+	RemoteRun *run = (RemoteRun*)context;
+	RemoteReport *report = &run->reports[task];
+	FILE *messages, *errors;/*streams collecting the output of the file*/
+	int socket_fd;
+
+	pthread_mutex_lock(&run->lock);
+	socket_fd = run->connections[--run->idle];/*there are as many connections as workers*/
+	pthread_mutex_unlock(&run->lock);
+	if(socket_fd < 0){
+		socket_fd = connect_to_server(run->path);
+	}
+
+	messages = open_memstream(&report->messages, &report->messages_size);
+	errors = open_memstream(&report->errors, &report->errors_size);
+	redirect_output(messages, errors);
+	report->handled = socket_fd >= 0 && forward_file(socket_fd, run->files[task], run->outputs[task], run->options);
+	redirect_output(NULL, NULL);
+	if(messages){
+		fclose(messages);
+	}
+	if(errors){
+		fclose(errors);
+	}
+
+	if(!report->handled && socket_fd >= 0){/*a broken connection is opened again by the next task*/
+		close(socket_fd);
+		socket_fd = -1;
+	}
+	pthread_mutex_lock(&run->lock);
+	run->connections[run->idle++] = socket_fd;
+	pthread_mutex_unlock(&run->lock);
+}
+
+/*
+* forward_files_parallel
+* ----------------------
+* this function forwards the file arguments to a daemon over options->jobs connections at a time
+* the daemon serves every connection on its own worker so the files are assembled concurrently
+* the output of every file is printed in argv order like assemble_files_parallel does
+*
+* parameters:
+*   path: the path of the socket of the daemon
+*   socket_fd: a connection that is already open (closed by this function unless it returns -1)
+*   files: the file arguments (base names without the .as suffix)
+*   outputs: the base names of the output files of every file argument
+*   file_count: the number of file arguments
+*   options: the command line options
+*
+* returns:
+*   int: the number of leading files the daemon handled or -1 if the forward couldn't start
+*/
+int forward_files_parallel(const char *path, int socket_fd, char *files[], char *outputs[], int file_count, const AssemblerOptions *options){
+	RemoteRun run;
+	WorkPool pool;
+	long *costs;/*size of every source*/
+	struct stat status;
+	char *input_filename;
+	int i, done = file_count;
+
+	costs = (long*)calloc(file_count, sizeof(long));
+	run.reports = (RemoteReport*)calloc(file_count, sizeof(RemoteReport));
+	run.connections = (int*)malloc(options->jobs*sizeof(int));
+	if(!costs || !run.reports || !run.connections){
+		free(costs);
+		free(run.reports);
+		free(run.connections);
+		return -1;
+	}
+	run.path = path;
+	run.files = files;
+	run.outputs = outputs;
+	run.options = options;
+	run.connections[0] = socket_fd;
+	for(i=1 ; i<options->jobs ; i++){
+		run.connections[i] = -1;
+	}
+	run.idle = options->jobs;
+	pthread_mutex_init(&run.lock, NULL);
+	for(i=0 ; i<file_count ; i++){/*the size of a source estimates the time it takes*/
+		input_filename = make_path(files[i], ".as", NULL);
+		costs[i] = input_filename && stat(input_filename, &status) == 0 ? (long)status.st_size : 0;
+		free(input_filename);
+	}
+
+	if(!work_pool_start(&pool, options->jobs, file_count, costs, forward_file_job, &run)){
+		pthread_mutex_destroy(&run.lock);
+		free(costs);
+		free(run.reports);
+		free(run.connections);
+		return -1;
+	}
+	for(i=0 ; i<file_count ; i++){/*print the output of the files in argv order up to the first one the daemon dropped*/
+		work_pool_wait(&pool, i);
+		if(!run.reports[i].handled && done == file_count){/*this file and every later one are assembled locally*/
+			done = i;
+		}
+		if(i < done){
+			fwrite(run.reports[i].errors, 1, run.reports[i].errors_size, stderr);
+			fflush(stderr);
+			fwrite(run.reports[i].messages, 1, run.reports[i].messages_size, stdout);
+			fflush(stdout);
+		}
+		free(run.reports[i].messages);
+		free(run.reports[i].errors);
+	}
+	work_pool_join(&pool);
+
+	for(i=0 ; i<run.idle ; i++){
+		if(run.connections[i] >= 0){
+			close(run.connections[i]);
+		}
+	}
+	pthread_mutex_destroy(&run.lock);
+	free(costs);
+	free(run.reports);
+	free(run.connections);
+	return done;
+}
+
+/*
+* assemble_files_remote
+* ---------------------
+* this function forwards the file arguments to a running daemon
+* with -j the files are spread over options->jobs connections and otherwise they go one after the other over a single connection
+* the console output and the output files are the same as when the files are assembled locally
+*
+* parameters:
+*   path: the path of the socket of the daemon
+*   files: the file arguments (base names without the .as suffix)
+*   outputs: the base names of the output files of every file argument
+*   file_count: the number of file arguments
+*   options: the command line options
+*
+* returns:
+*   int: the number of files the daemon handled (the caller assembles the rest locally)
+*/
+int assemble_files_remote(const char *path, char *files[], char *outputs[], int file_count, const AssemblerOptions *options){
+	int socket_fd, i;
+	struct sigaction ignore, previous;
+
+	socket_fd = connect_to_server(path);
+	if(socket_fd < 0){/*no daemon is running*/
+		return 0;
+	}
+	memset(&ignore, 0, sizeof(ignore));
+	ignore.sa_handler = SIG_IGN;
+	sigaction(SIGPIPE, &ignore, &previous);/*a daemon that stops makes the send fail instead of killing the client*/
+	i = options->jobs > 1 && file_count > 1 ? forward_files_parallel(path, socket_fd, files, outputs, file_count, options) : -1;
+	if(i < 0){
+		for(i=0 ; i<file_count && forward_file(socket_fd, files[i], outputs[i], options) ; i++);
+		close(socket_fd);
+	}
+	sigaction(SIGPIPE, &previous, NULL);
+	return i;
+}
@@ -0,0 +1,77 @@
+#ifndef SERVER_H
+#define SERVER_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "definitions.h"
+#include "options.h"
+#include "libassembler.h"
+
+#define SERVER_MAGIC "ASRV"/*first four bytes of every frame*/
+#define SERVER_MAGIC_LENGTH 4/*length of the magic*/
+#define SERVER_PROTOCOL_VERSION 5/*version of the frames described below*/
+#define SERVER_INLINE_LIMIT 65536/*payloads longer than this are passed through shared memory*/
+#define SERVER_MAX_PAYLOAD 0x10000000/*longest payload a frame may announce*/
+#define SERVER_NO_OUTPUT 0xFFFFFFFFu/*length of an output that was not written*/
+
+/*
+* protocol
+* --------
+* a client connects to the unix socket of the daemon and sends any number of requests one after the other
+* the daemon only answers clients of the user it runs as and never opens a file on behalf of a client
+* every request and every response is a frame made of a FrameHeader followed by its payload
+* a payload up to SERVER_INLINE_LIMIT bytes follows the header on the socket
+* a longer payload is written to an unlinked shared memory object whose descriptor travels with the header (SCM_RIGHTS)
+* so the receiver maps it instead of copying it through the socket
+*
+* request payload:  RequestHeader  name  source
+* response payload: ResponseHeader  messages  errors  every written output in sink_output order
+*/
+
+/*** STRUCTURE DEFINITIONS SECTION ***/
+
+typedef struct{/*header of every frame*/
+	char magic[SERVER_MAGIC_LENGTH];/*always SERVER_MAGIC*/
+	unsigned int version;/*always SERVER_PROTOCOL_VERSION*/
+	unsigned int shared;/*1 when the payload is in the shared memory passed with the header*/
+	unsigned int payload_length;/*number of bytes of the payload*/
+}FrameHeader;
+
+typedef struct{/*fixed part of a request payload*/
+	unsigned int format;/*object_format of the outputs*/
+	unsigned int write_relocations;/*1 to produce the .rel output*/
+	unsigned int write_map;/*1 to produce the .map output*/
+	unsigned int write_report;/*1 to produce the .report output*/
+	unsigned int write_report_json;/*1 to produce the .report.json output*/
+	unsigned int operation_cycles[OPERATION_COUNT];/*cycles the reports charge to every operation*/
+	unsigned int mode_cycles[ADDRESSING_MODE_COUNT];/*cycles the reports charge to every addressing mode*/
+	unsigned int load_base;/*address of the first code word*/
+	unsigned int max_errors;/*errors after which the source is abandoned (0 for no limit)*/
+	unsigned int name_length;/*length of the base name used in the messages*/
+	unsigned int source_length;/*length of the source in the payload*/
+}RequestHeader;
+
+typedef struct{/*fixed part of a response payload*/
+	unsigned int success;/*1 if the source was assembled*/
+	unsigned int messages_length;/*length of the progress messages*/
+	unsigned int errors_length;/*length of the warnings and errors*/
+	unsigned int output_lengths[SINK_OUTPUT_COUNT];/*length of every output or SERVER_NO_OUTPUT*/
+}ResponseHeader;
+
+typedef struct{/*a payload received from a socket*/
+	char *data;/*the bytes of the payload*/
+	size_t length;/*number of bytes*/
+	bool mapped;/*true if data is a mapping of shared memory*/
+}Frame;
+
+/*** FUNCTION PROTOTYPES SECTION ***/
+
+bool send_frame(int socket_fd,const char *payload,size_t length);/*function to send a payload inline or through shared memory*/
+bool receive_frame(int socket_fd,Frame *frame);/*function to receive the next payload*/
+void release_frame(Frame *frame);/*function to free or unmap a received payload*/
+int connect_to_server(const char *path);/*function to connect to a running daemon*/
+int run_server(const char *path,const AssemblerOptions *options);/*function to serve requests until the daemon is stopped*/
+int assemble_files_remote(const char *path,char *files[],char *outputs[],int file_count,const AssemblerOptions *options);/*function to forward the file arguments to a running daemon*/
+
+#endif /*SERVER_H*/
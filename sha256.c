@@ -0,0 +1,174 @@
+#include "sha256.h"
+
+/*** SHA-256 SECTION ***/
+
+/*the words are kept in unsigned long which holds at least 32 bits so every result is masked back to 32 bits*/
+#define SHA256_MASK 0xFFFFFFFFUL
+#define ROTATE_RIGHT(x, n) ((((x) >> (n)) | ((x) << (32 - (n)))) & SHA256_MASK)
+
+/*
+* sha256_constants
+* ----------------
+* the first 32 bits of the fractional parts of the cube roots of the first 64 primes
+*/
+const unsigned long sha256_constants[64] = {
+	0x428a2f98UL, 0x71374491UL, 0xb5c0fbcfUL, 0xe9b5dba5UL, 0x3956c25bUL, 0x59f111f1UL, 0x923f82a4UL, 0xab1c5ed5UL,
+	0xd807aa98UL, 0x12835b01UL, 0x243185beUL, 0x550c7dc3UL, 0x72be5d74UL, 0x80deb1feUL, 0x9bdc06a7UL, 0xc19bf174UL,
+	0xe49b69c1UL, 0xefbe4786UL, 0x0fc19dc6UL, 0x240ca1ccUL, 0x2de92c6fUL, 0x4a7484aaUL, 0x5cb0a9dcUL, 0x76f988daUL,
+	0x983e5152UL, 0xa831c66dUL, 0xb00327c8UL, 0xbf597fc7UL, 0xc6e00bf3UL, 0xd5a79147UL, 0x06ca6351UL, 0x14292967UL,
+	0x27b70a85UL, 0x2e1b2138UL, 0x4d2c6dfcUL, 0x53380d13UL, 0x650a7354UL, 0x766a0abbUL, 0x81c2c92eUL, 0x92722c85UL,
+	0xa2bfe8a1UL, 0xa81a664bUL, 0xc24b8b70UL, 0xc76c51a3UL, 0xd192e819UL, 0xd6990624UL, 0xf40e3585UL, 0x106aa070UL,
+	0x19a4c116UL, 0x1e376c08UL, 0x2748774cUL, 0x34b0bcb5UL, 0x391c0cb3UL, 0x4ed8aa4aUL, 0x5b9cca4fUL, 0x682e6ff3UL,
+	0x748f82eeUL, 0x78a5636fUL, 0x84c87814UL, 0x8cc70208UL, 0x90befffaUL, 0xa4506cebUL, 0xbef9a3f7UL, 0xc67178f2UL
+};
+
+/*
+* sha256_compress
+* ---------------
+* this function mixes a single 64 byte block into the state of the digest
+*
+* parameters:
+*   hash: the digest
+*   block: the block
+*
+*/
+void sha256_compress(Sha256 *hash, const unsigned char *block){
+	unsigned long w[64], a, b, c, d, e, f, g, h, t1, t2;
+	int i;
+
+	for(i=0 ; i<16 ; i++){/*the block holds 16 big endian words*/
+		w[i] = ((unsigned long)block[4*i] << 24) | ((unsigned long)block[4*i + 1] << 16) | ((unsigned long)block[4*i + 2] << 8) | block[4*i + 3];
+	}
+	for(i=16 ; i<64 ; i++){/*extend them to 64 words*/
+		t1 = ROTATE_RIGHT(w[i - 2], 17) ^ ROTATE_RIGHT(w[i - 2], 19) ^ (w[i - 2] >> 10);
+		t2 = ROTATE_RIGHT(w[i - 15], 7) ^ ROTATE_RIGHT(w[i - 15], 18) ^ (w[i - 15] >> 3);
+		w[i] = (t1 + w[i - 7] + t2 + w[i - 16]) & SHA256_MASK;
+	}
+
+	a = hash->state[0]; b = hash->state[1]; c = hash->state[2]; d = hash->state[3];
+	e = hash->state[4]; f = hash->state[5]; g = hash->state[6]; h = hash->state[7];
+	for(i=0 ; i<64 ; i++){
+		t1 = (h + (ROTATE_RIGHT(e, 6) ^ ROTATE_RIGHT(e, 11) ^ ROTATE_RIGHT(e, 25)) + ((e & f) ^ (~e & g)) + sha256_constants[i] + w[i]) & SHA256_MASK;
+		t2 = ((ROTATE_RIGHT(a, 2) ^ ROTATE_RIGHT(a, 13) ^ ROTATE_RIGHT(a, 22)) + ((a & b) ^ (a & c) ^ (b & c))) & SHA256_MASK;
+		h = g; g = f; f = e;
+		e = (d + t1) & SHA256_MASK;
+		d = c; c = b; b = a;
+		a = (t1 + t2) & SHA256_MASK;
+	}
+	hash->state[0] = (hash->state[0] + a) & SHA256_MASK;
+	hash->state[1] = (hash->state[1] + b) & SHA256_MASK;
+	hash->state[2] = (hash->state[2] + c) & SHA256_MASK;
+	hash->state[3] = (hash->state[3] + d) & SHA256_MASK;
+	hash->state[4] = (hash->state[4] + e) & SHA256_MASK;
+	hash->state[5] = (hash->state[5] + f) & SHA256_MASK;
+	hash->state[6] = (hash->state[6] + g) & SHA256_MASK;
+	hash->state[7] = (hash->state[7] + h) & SHA256_MASK;
+}
+
+/*
+* sha256_start
+* ------------
+* this function starts a new digest with the initial state of SHA-256
+*
+* parameters:
+*   hash: the digest to start
+*
+*/
+void sha256_start(Sha256 *hash){
+	hash->state[0] = 0x6a09e667UL; hash->state[1] = 0xbb67ae85UL;
+	hash->state[2] = 0x3c6ef372UL; hash->state[3] = 0xa54ff53aUL;
+	hash->state[4] = 0x510e527fUL; hash->state[5] = 0x9b05688cUL;
+	hash->state[6] = 0x1f83d9abUL; hash->state[7] = 0x5be0cd19UL;
+	hash->length_high = 0;
+	hash->length_low = 0;
+	hash->used = 0;
+}
+
+/*
+* sha256_update
+* -------------
+* this function adds bytes to a digest compressing every block as soon as it is full
+*
+* parameters:
+*   hash: the digest
+*   data: the bytes to add
+*   length: the number of bytes
+*
+*/
+void sha256_update(Sha256 *hash, const void *data, size_t length){
+	const unsigned char *bytes = (const unsigned char*)data;
+	size_t count;
+
+	while(length > 0){
+		if(hash->used == 0 && length >= SHA256_BLOCK_LENGTH){/*compress whole blocks straight from the input*/
+			sha256_compress(hash, bytes);
+			count = SHA256_BLOCK_LENGTH;
+		}
+		else{
+			count = SHA256_BLOCK_LENGTH - hash->used < length ? SHA256_BLOCK_LENGTH - hash->used : length;
+			memcpy(hash->block + hash->used, bytes, count);
+			hash->used += count;
+			if(hash->used == SHA256_BLOCK_LENGTH){
+				sha256_compress(hash, hash->block);
+				hash->used = 0;
+			}
+		}
+		hash->length_low = (hash->length_low + count) & SHA256_MASK;
+		if(hash->length_low < count){/*carry into the high word*/
+			hash->length_high = (hash->length_high + 1) & SHA256_MASK;
+		}
+		bytes += count;
+		length -= count;
+	}
+}
+
+/*
+* sha256_finish
+* -------------
+* this function pads the message with its length in bits and writes the final digest
+*
+* parameters:
+*   hash: the digest
+*   digest: the 32 bytes that receive the digest
+*
+*/
+void sha256_finish(Sha256 *hash, unsigned char digest[SHA256_DIGEST_LENGTH]){
+	unsigned long bits_high = ((hash->length_high << 3) | (hash->length_low >> 29)) & SHA256_MASK;
+	unsigned long bits_low = (hash->length_low << 3) & SHA256_MASK;
+	unsigned char padding[SHA256_BLOCK_LENGTH + 8];
+	size_t padding_length;
+	int i;
+
+	padding_length = (hash->used < 56 ? 56 : 120) - hash->used;/*leave 8 bytes for the length in the last block*/
+	memset(padding, 0, sizeof(padding));
+	padding[0] = 0x80;
+	for(i=0 ; i<4 ; i++){
+		padding[padding_length + i] = (unsigned char)(bits_high >> (24 - 8*i));
+		padding[padding_length + 4 + i] = (unsigned char)(bits_low >> (24 - 8*i));
+	}
+	sha256_update(hash, padding, padding_length + 8);
+	for(i=0 ; i<32 ; i++){
+		digest[i] = (unsigned char)(hash->state[i/4] >> (24 - 8*(i%4)));
+	}
+}
+
+/*
+* sha256_hex
+* ----------
+* this function writes a digest as 64 lowercase hexadecimal digits followed by a null terminator
+*
+* parameters:
+*   digest: the digest
+*   text: a buffer of at least 65 characters
+*
+*/
+void sha256_hex(const unsigned char digest[SHA256_DIGEST_LENGTH], char *text){
+	const char *digits = "0123456789abcdef";
+	int i;
+
+	for(i=0 ; i<SHA256_DIGEST_LENGTH ; i++){
+		text[2*i] = digits[digest[i] >> 4];
+		text[2*i + 1] = digits[digest[i] & 0xF];
+	}
+	text[2*SHA256_DIGEST_LENGTH] = '\0';
+}
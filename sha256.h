@@ -0,0 +1,28 @@
+#ifndef SHA256_H
+#define SHA256_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SHA256_DIGEST_LENGTH 32/*number of bytes of a digest*/
+#define SHA256_BLOCK_LENGTH 64/*number of bytes the compression function consumes at a time*/
+
+/*** STRUCTURE DEFINITIONS SECTION ***/
+
+typedef struct{/*state of a SHA-256 computation (FIPS 180-4)*/
+	unsigned long state[8];/*the eight 32-bit working words*/
+	unsigned long length_high;/*high 32 bits of the number of bytes hashed*/
+	unsigned long length_low;/*low 32 bits of the number of bytes hashed*/
+	unsigned char block[SHA256_BLOCK_LENGTH];/*bytes waiting for a full block*/
+	size_t used;/*number of bytes in block*/
+}Sha256;
+
+/*** FUNCTION PROTOTYPES SECTION ***/
+
+void sha256_start(Sha256 *hash);/*function to start a new digest*/
+void sha256_update(Sha256 *hash,const void *data,size_t length);/*function to add bytes to a digest*/
+void sha256_finish(Sha256 *hash,unsigned char digest[SHA256_DIGEST_LENGTH]);/*function to finish a digest*/
+void sha256_hex(const unsigned char digest[SHA256_DIGEST_LENGTH],char *text);/*function to write a digest as 64 hexadecimal digits*/
+
+#endif /*SHA256_H*/
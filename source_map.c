@@ -0,0 +1,80 @@
+#include "source_map.h"
+
+/*** SOURCE MAP SECTION ***/
+
+/*
+* write_map_ranges
+* ----------------
+* this function writes the range of every line of the preprocessed source that adds words to one of the images
+*
+* parameters:
+*   file: the .map stream
+*   preprocessed: the preprocessed source
+*   size: the length of the preprocessed source
+*   map: the source line and the macro line of every preprocessed line
+*   address: the address of the first word of the image
+*   data: true to write the ranges of the data image false for the code image
+*
+*/
+void write_map_ranges(FILE *file, const char *preprocessed, size_t size, const LineMap *map, long address, bool data){
+	char line[MAX_LINE_LENGTH + 2];/*copy of the line count_line_words may change*/
+	const char *start = preprocessed, *end;
+	size_t length;
+	int index = 0;/*position of the line in the preprocessed source*/
+	int code_words, data_words, words;
+
+	while(start < preprocessed + size){
+		end = (const char*)memchr(start, '\n', preprocessed + size - start);
+		end = end ? end : preprocessed + size;
+		length = (size_t)(end - start) < sizeof(line) - 1 ? (size_t)(end - start) : sizeof(line) - 1;/*a longer line was rejected by the first pass*/
+		memcpy(line, start, length);
+		line[length] = '\0';
+		count_line_words(line, &code_words, &data_words);
+		words = data ? data_words : code_words;
+		if(words > 0){
+			if(map->origins && index < map->count && map->origins[index].macro >= 0){/*the line of the body then the macro and its call*/
+				fprintf(file, "%04ld %04ld %d %s %d\n", address, address + words - 1, map->origins[index].line, map->macro_names[map->origins[index].macro], map->lines[index]);
+			}
+			else{
+				fprintf(file, "%04ld %04ld %d\n", address, address + words - 1, index < map->count ? map->lines[index] : 0);
+			}
+			address += words;
+		}
+		start = end + 1;
+		index++;
+	}
+}
+
+/*
+* sink_source_map
+* ---------------
+* this function writes the .map file of the sink when the sink was given the line map of the source
+* the preprocessed source is sized again line by line the way the first pass sized it to find the range of every line
+* the line and macro fields of the ranges are described in source_map.h
+*
+* parameters:
+*   sink: the sink that writes the file
+*   name: the name of the source the map names
+*   preprocessed: the preprocessed source the first pass accepted
+*   size: the length of the preprocessed source
+*   load_base: the address of the first code word
+*   code_length: the number of code words found by the first pass (the data follows them)
+*
+* returns:
+*   bool: true if the map was written or no map was asked for false otherwise
+*/
+bool sink_source_map(ObjectSink *sink, const char *name, const char *preprocessed, size_t size, long load_base, long code_length){
+	FILE *file;
+
+	if(!sink->line_map){
+		return true;
+	}
+	file = open_sink_output(sink, SINK_MAP);
+	if(!file){
+		return false;
+	}
+	fprintf(file, "%s.as\n", name);
+	write_map_ranges(file, preprocessed, size, sink->line_map, load_base, false);
+	write_map_ranges(file, preprocessed, size, sink->line_map, load_base + code_length, true);
+	return true;
+}
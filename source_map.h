@@ -0,0 +1,28 @@
+#ifndef SOURCE_MAP_H
+#define SOURCE_MAP_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "definitions.h"
+#include "preprocessor.h"
+#include "file_writer.h"
+
+/*
+* source map
+* ----------
+* -m (--map) writes NAME.map next to the object file that tells which source line every word of the program came from
+* so a profile or a fault taken at an address can be charged to the line and the macro that produced it
+* the first line names the source and every other line is a range of addresses:
+*   START LAST LINE                  a range produced by line LINE of the source
+*   START LAST LINE MACRO CALL       a range expanded from line LINE of the body of MACRO at the call on line CALL
+* START and LAST are the first and the last address of the range (inclusive) written like the addresses of the .ob file
+* the ranges are sorted by address and never overlap, the code comes first and the data follows it like in the .ob file
+* so the range of an address is found by a binary search on START
+*/
+
+/*** FUNCTION PROTOTYPES SECTION ***/
+
+bool sink_source_map(ObjectSink *sink,const char *name,const char *preprocessed,size_t size,long load_base,long code_length);/*function to write the .map file of a preprocessed source*/
+
+#endif /*SOURCE_MAP_H*/
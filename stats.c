@@ -0,0 +1,792 @@
+#include "stats.h"
+#include "utils.h"
+#include "trace.h"
+#include <pthread.h>
+#include <sys/resource.h>
+
+/*** NAMES SECTION ***/
+
+/*
+* phase_names
+* -----------
+* the name of every phase in the reports indexed by stats_phase
+*/
+const char *phase_names[PHASE_COUNT] = {"other", "preprocess", "first_pass", "entries", "second_pass", "write"};
+
+/*
+* counter_names
+* -------------
+* the name of every counter in the reports indexed by stats_counter
+*/
+const char *counter_names[COUNTER_COUNT] = {"lines", "macros_defined", "macros_expanded", "labels", "externs", "entries",
+	"extern_references", "code_words", "data_words", "bytes_read", "bytes_written", "allocations"};
+
+/*
+* memory_names
+* ------------
+* the name of every subsystem in the reports indexed by memory_category
+*/
+const char *memory_names[MEMORY_CATEGORY_COUNT] = {"macros", "labels", "operands", "code_words", "data_copies", "other"};
+
+/*** MEASUREMENT SECTION ***/
+
+/*
+* stats_key
+* ---------
+* the FileStats of the file the calling thread is assembling or NULL when it is not measured
+*/
+pthread_key_t stats_key;
+pthread_once_t stats_key_once = PTHREAD_ONCE_INIT;
+
+/*
+* create_stats_key
+* ----------------
+* this function creates the thread specific key that holds the measured file of each thread
+* it runs exactly once through pthread_once
+*
+*/
+void create_stats_key(void){
+	pthread_key_create(&stats_key, NULL);
+}
+
+/*
+* current_stats
+* -------------
+* this function returns the file the calling thread is measuring
+*
+* returns:
+*   FileStats*: the file or NULL when the thread is not measuring one
+*/
+FileStats *current_stats(void){
+	pthread_once(&stats_key_once, create_stats_key);
+	return (FileStats*)pthread_getspecific(stats_key);
+}
+
+/*
+* charge_time
+* -----------
+* this function adds the time since the last charge to the phase the file is in
+* and with --perf-counters the counters of the processor since the last charge too
+*
+* parameters:
+*   stats: the measured file
+*
+*/
+void charge_time(FileStats *stats){
+	struct timespec now;
+	unsigned long counters[PERF_COUNTER_COUNT];
+	stats_phase phase = stats->depth > 0 ? stats->stack[stats->depth - 1] : PHASE_OTHER;
+	int i;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	stats->phases[phase] += (now.tv_sec - stats->mark.tv_sec) * 1000.0 + (now.tv_nsec - stats->mark.tv_nsec) / 1000000.0;
+	stats->mark = now;
+	if(stats->perf && read_perf_counters(counters)){
+		for(i=0 ; i<PERF_COUNTER_COUNT ; i++){
+			stats->perf_counters[phase][i] += counters[i] > stats->perf_mark[i] ? counters[i] - stats->perf_mark[i] : 0;/*a scaled counter may step back*/
+			stats->perf_mark[i] = counters[i];
+		}
+	}
+}
+
+/*
+* start_file_stats
+* ----------------
+* this function empties the statistics of a file and measures it on the calling thread until stop_file_stats
+* the counters of the processor are read too once start_perf_counters found some
+*
+* parameters:
+*   stats: the statistics to fill
+*   name: the file argument (only referenced until the statistics are added to a report)
+*
+*/
+void start_file_stats(FileStats *stats, const char *name){
+	memset(stats, 0, sizeof(FileStats));
+	stats->name = (char*)name;
+	clock_gettime(CLOCK_MONOTONIC, &stats->start);
+	stats->mark = stats->start;
+	stats->perf = read_perf_counters(stats->perf_mark);/*only with --perf-counters*/
+	pthread_once(&stats_key_once, create_stats_key);
+	pthread_setspecific(stats_key, stats);
+}
+
+/*
+* stop_file_stats
+* ---------------
+* this function stops measuring the file of the calling thread and notes the peak resident set size the process reached so far
+*
+* parameters:
+*   success: true if the file was assembled
+*
+*/
+void stop_file_stats(bool success){
+	FileStats *stats = current_stats();
+	struct rusage usage;
+
+	if(!stats){
+		return;
+	}
+	charge_time(stats);
+	if(getrusage(RUSAGE_SELF, &usage) == 0){
+		stats->max_rss = usage.ru_maxrss;/*kilobytes on linux*/
+	}
+	stats->depth = 0;
+	stats->success = success;
+	stats->total = (stats->mark.tv_sec - stats->start.tv_sec) * 1000.0 + (stats->mark.tv_nsec - stats->start.tv_nsec) / 1000000.0;
+	pthread_setspecific(stats_key, NULL);
+}
+
+/*
+* enter_phase
+* -----------
+* this function charges the time until the next phase change to a phase
+* a phase entered deeper than STATS_MAX_DEPTH is charged to the phase around it
+* the phase is also a span of the trace when --trace records one
+*
+* parameters:
+*   phase: the phase
+*
+*/
+void enter_phase(stats_phase phase){
+	FileStats *stats = current_stats();
+
+	trace_begin("phase", phase_names[phase], NULL, -1);
+	if(!stats){
+		return;
+	}
+	charge_time(stats);
+	if(stats->depth < STATS_MAX_DEPTH){
+		stats->stack[stats->depth] = phase;
+	}
+	stats->depth++;
+}
+
+/*
+* leave_phase
+* -----------
+* this function goes back to the phase that was entered before the current one and ends the span of the current one
+*
+*/
+void leave_phase(void){
+	FileStats *stats = current_stats();
+
+	trace_end();
+	if(!stats || stats->depth == 0){
+		return;
+	}
+	if(stats->depth <= STATS_MAX_DEPTH){
+		charge_time(stats);
+	}
+	stats->depth--;
+}
+
+/*
+* count_stat
+* ----------
+* this function adds to a counter of the file the calling thread is measuring
+*
+* parameters:
+*   counter: the counter
+*   amount: the amount to add
+*
+*/
+void count_stat(stats_counter counter, unsigned long amount){
+	FileStats *stats = current_stats();
+
+	if(stats){
+		stats->counters[counter] += amount;
+	}
+}
+
+/*
+* count_tables
+* ------------
+* this function counts the labels directives extern references and words of an assembled file
+* the tables are counted once they are complete so the chunked passes and the sequential passes count the same
+*
+* parameters:
+*   labels: the labels of the file
+*   directives: the extern and entry directives of the file
+*   references: the terminated extern references or NULL
+*   code_length: the number of code words
+*   data_length: the number of data words
+*
+*/
+void count_tables(const LabelArray *labels, const ExternEntryArray *directives, const ExternEntry *references, long code_length, long data_length){
+	FileStats *stats = current_stats();
+	int i;
+
+	if(!stats){
+		return;
+	}
+	stats->counters[COUNTER_LABELS] += labels->count;
+	stats->counters[COUNTER_EXTERNS] += directives->extern_count;
+	stats->counters[COUNTER_ENTRIES] += directives->entry_count;
+	for(i=0 ; references && references[i].name[0] != '\0' ; i++){
+		stats->counters[COUNTER_EXTERN_REFERENCES]++;
+	}
+	stats->counters[COUNTER_CODE_WORDS] += code_length;
+	stats->counters[COUNTER_DATA_WORDS] += data_length;
+}
+
+#ifdef MEMORY_STATS
+
+/*** ALLOCATION SECTION ***/
+
+/*
+* MemoryHeader
+* ------------
+* the header in front of every counted allocation, a union so the memory after it is aligned for any type
+*/
+typedef union{
+	struct{
+		size_t size;/*bytes asked for*/
+		memory_category category;/*the subsystem the bytes are charged to*/
+		bool counted;/*true if the bytes were charged to a file (a thread that measures no file charges nothing)*/
+	}allocation;
+	long double alignment;
+	void *pointer_alignment;
+}MemoryHeader;
+
+/*
+* charge_memory
+* -------------
+* this function charges allocated or freed bytes to a subsystem of the file the calling thread is measuring
+*
+* parameters:
+*   category: the subsystem
+*   size: the bytes allocated or minus the bytes freed
+*   allocation: true if the bytes were allocated
+*
+* returns:
+*   bool: true if a file was charged
+*/
+bool charge_memory(memory_category category, long size, bool allocation){
+	FileStats *stats = current_stats();
+	MemoryUsage *usage[2];
+	int i;
+
+	if(!stats){
+		return false;
+	}
+	usage[0] = &stats->memory[category];
+	usage[1] = &stats->memory_total;
+	for(i=0 ; i<2 ; i++){
+		if(allocation){
+			usage[i]->allocations++;
+			usage[i]->bytes += size;
+		}
+		usage[i]->live += size;
+		usage[i]->peak = usage[i]->live > usage[i]->peak ? usage[i]->live : usage[i]->peak;
+	}
+	stats->counters[COUNTER_ALLOCATIONS] += allocation;
+	return true;
+}
+
+/*
+* counted_malloc
+* --------------
+* this function allocates memory behind a header that remembers its size and charges it to a subsystem of the measured file
+*
+* parameters:
+*   category: the subsystem
+*   size: the bytes to allocate
+*
+* returns:
+*   void*: the memory (freed only by counted_free) or NULL if memory ran out
+*/
+void *counted_malloc(memory_category category, size_t size){
+	MemoryHeader *header;
+
+	if(size > (size_t)-1 - sizeof(MemoryHeader)){
+		return NULL;
+	}
+	header = (MemoryHeader*)malloc(sizeof(MemoryHeader) + size);
+	if(!header){
+		return NULL;
+	}
+	header->allocation.size = size;
+	header->allocation.category = category;
+	header->allocation.counted = charge_memory(category, (long)size, true);
+	return header + 1;
+}
+
+/*
+* counted_calloc
+* --------------
+* this function allocates zeroed memory for an array and charges it to a subsystem of the measured file
+*
+* parameters:
+*   category: the subsystem
+*   count: the number of elements
+*   size: the size of an element
+*
+* returns:
+*   void*: the memory (freed only by counted_free) or NULL if memory ran out
+*/
+void *counted_calloc(memory_category category, size_t count, size_t size){
+	void *memory;
+
+	if(size && count > (size_t)-1 / size){
+		return NULL;
+	}
+	memory = counted_malloc(category, count * size);
+	if(memory){
+		memset(memory, 0, count * size);
+	}
+	return memory;
+}
+
+/*
+* counted_realloc
+* ---------------
+* this function resizes a counted allocation like realloc
+* the new size is charged before the old one is released so the peak holds both like the copy realloc may make
+*
+* parameters:
+*   category: the subsystem
+*   pointer: the counted allocation or NULL to allocate
+*   size: the new size
+*
+* returns:
+*   void*: the resized memory or NULL if memory ran out (the old memory is left as it was)
+*/
+void *counted_realloc(memory_category category, void *pointer, size_t size){
+	MemoryHeader *header;
+	size_t old_size;
+	bool counted;
+
+	if(!pointer){
+		return counted_malloc(category, size);
+	}
+	if(size > (size_t)-1 - sizeof(MemoryHeader)){
+		return NULL;
+	}
+	header = (MemoryHeader*)pointer - 1;
+	old_size = header->allocation.size;
+	counted = header->allocation.counted;
+	header = (MemoryHeader*)realloc(header, sizeof(MemoryHeader) + size);
+	if(!header){
+		return NULL;
+	}
+	header->allocation.size = size;
+	header->allocation.counted = charge_memory(category, (long)size, true);
+	if(counted){
+		charge_memory(header->allocation.category, -(long)old_size, false);
+	}
+	header->allocation.category = category;
+	return header + 1;
+}
+
+/*
+* counted_free
+* ------------
+* this function frees a counted allocation and takes its bytes off the live bytes of the measured file
+*
+* parameters:
+*   pointer: the counted allocation or NULL
+*
+*/
+void counted_free(void *pointer){
+	MemoryHeader *header;
+
+	if(!pointer){
+		return;
+	}
+	header = (MemoryHeader*)pointer - 1;
+	if(header->allocation.counted){
+		charge_memory(header->allocation.category, -(long)header->allocation.size, false);
+	}
+	free(header);
+}
+
+#endif
+
+/*** REPORT SECTION ***/
+
+/*
+* add_file_stats
+* --------------
+* this function keeps the statistics of a file in a report with its own copy of the name
+*
+* parameters:
+*   report: the report
+*   stats: the statistics of the file
+*
+* returns:
+*   bool: true if the statistics were added false if memory ran out
+*/
+bool add_file_stats(StatsReport *report, const FileStats *stats){
+	FileStats *files;
+	char *name;
+
+	if(report->count == report->capacity){
+		files = (FileStats*)realloc(report->files, (report->capacity ? report->capacity * 2 : 16) * sizeof(FileStats));
+		if(!files){
+			return false;
+		}
+		report->files = files;
+		report->capacity = report->capacity ? report->capacity * 2 : 16;
+	}
+	name = make_path(stats->name, NULL, NULL);
+	if(!name){
+		return false;
+	}
+	report->files[report->count] = *stats;
+	report->files[report->count++].name = name;
+	return true;
+}
+
+/*
+* add_memory_usage
+* ----------------
+* this function adds the heap use of a file to a sum of files
+* the peak of the sum is the largest peak of a file since the files are freed between them
+*
+* parameters:
+*   sum: the sum
+*   usage: the heap use of the file
+*
+*/
+void add_memory_usage(MemoryUsage *sum, const MemoryUsage *usage){
+	sum->allocations += usage->allocations;
+	sum->bytes += usage->bytes;
+	sum->live += usage->live;
+	sum->peak = usage->peak > sum->peak ? usage->peak : sum->peak;
+}
+
+/*
+* sum_stats
+* ---------
+* this function adds up the statistics of every file of a report
+* the peak resident set size and the peak heap use of the total are the largest of a file
+*
+* parameters:
+*   report: the report
+*   total: the FileStats that receives the sums (its success is true only if every file succeeded)
+*
+* returns:
+*   int: the number of files that were assembled
+*/
+int sum_stats(const StatsReport *report, FileStats *total){
+	int i, j, k, succeeded = 0;
+
+	memset(total, 0, sizeof(FileStats));
+	for(i=0 ; i<report->count ; i++){
+		total->total += report->files[i].total;
+		for(j=0 ; j<PHASE_COUNT ; j++){
+			total->phases[j] += report->files[i].phases[j];
+			for(k=0 ; k<PERF_COUNTER_COUNT ; k++){
+				total->perf_counters[j][k] += report->files[i].perf_counters[j][k];
+			}
+		}
+		for(j=0 ; j<COUNTER_COUNT ; j++){
+			total->counters[j] += report->files[i].counters[j];
+		}
+		for(j=0 ; j<=MEMORY_CATEGORY_COUNT ; j++){
+			add_memory_usage(j < MEMORY_CATEGORY_COUNT ? &total->memory[j] : &total->memory_total,
+				j < MEMORY_CATEGORY_COUNT ? &report->files[i].memory[j] : &report->files[i].memory_total);
+		}
+		total->max_rss = report->files[i].max_rss > total->max_rss ? report->files[i].max_rss : total->max_rss;
+		succeeded += report->files[i].success;
+	}
+	total->success = succeeded == report->count;
+	return succeeded;
+}
+
+/*
+* print_stats_row
+* ---------------
+* this function prints the times of a single file or of the total as a row of the table
+*
+* parameters:
+*   file: the stream to print to
+*   name: the first column
+*   result: the second column
+*   stats: the statistics
+*
+*/
+void print_stats_row(FILE *file, const char *name, const char *result, const FileStats *stats){
+	int i;
+
+	fprintf(file, "%-24.24s %-8s %10.3f", name, result, stats->total);
+	for(i=PHASE_PREPROCESS ; i<PHASE_COUNT ; i++){
+		fprintf(file, " %11.3f", stats->phases[i]);
+	}
+	fprintf(file, " %11.3f\n", stats->phases[PHASE_OTHER]);
+}
+
+/*
+* print_perf_row
+* --------------
+* this function prints the time and the counters of the processor of a phase as a row of the table
+*
+* parameters:
+*   file: the stream to print to
+*   available: the mask of the counters that were measured
+*   name: the first column
+*   time: the time of the phase in milliseconds
+*   counters: the counters of the phase
+*
+*/
+void print_perf_row(FILE *file, unsigned int available, const char *name, double time, const unsigned long *counters){
+	int i;
+
+	fprintf(file, "%-24s %10.3f", name, time);
+	for(i=0 ; i<PERF_COUNTER_COUNT ; i++){
+		if(available & (1u << i)){
+			fprintf(file, " %*lu", (int)strlen(perf_counter_names[i]) > 13 ? (int)strlen(perf_counter_names[i]) : 13, counters[i]);
+		}
+	}
+	if((available & (1u << PERF_CYCLES)) && (available & (1u << PERF_INSTRUCTIONS))){
+		fprintf(file, " %6.2f", counters[PERF_CYCLES] ? (double)counters[PERF_INSTRUCTIONS] / counters[PERF_CYCLES] : 0.0);
+	}
+	fputc('\n', file);
+}
+
+/*
+* print_perf_table
+* ----------------
+* this function prints the counters of the processor of every phase of all the files next to the time of the phase
+* only the counters that were measured get a column and the instructions per cycle follow when both were measured
+*
+* parameters:
+*   file: the stream to print to
+*   available: the mask of the counters that were measured
+*   total: the sums of every file
+*
+*/
+void print_perf_table(FILE *file, unsigned int available, const FileStats *total){
+	unsigned long sums[PERF_COUNTER_COUNT];
+	int i, j;
+
+	fprintf(file, "\n%-24s %10s", "phase (all files)", "ms");
+	for(i=0 ; i<PERF_COUNTER_COUNT ; i++){
+		if(available & (1u << i)){
+			fprintf(file, " %13s", perf_counter_names[i]);
+		}
+	}
+	if((available & (1u << PERF_CYCLES)) && (available & (1u << PERF_INSTRUCTIONS))){
+		fprintf(file, " %6s", "ipc");
+	}
+	fputc('\n', file);
+	memset(sums, 0, sizeof(sums));
+	for(j=0 ; j<PHASE_COUNT ; j++){
+		for(i=0 ; i<PERF_COUNTER_COUNT ; i++){
+			sums[i] += total->perf_counters[j][i];
+		}
+	}
+	for(j=PHASE_PREPROCESS ; j<PHASE_COUNT ; j++){
+		print_perf_row(file, available, phase_names[j], total->phases[j], total->perf_counters[j]);
+	}
+	print_perf_row(file, available, phase_names[PHASE_OTHER], total->phases[PHASE_OTHER], total->perf_counters[PHASE_OTHER]);
+	print_perf_row(file, available, "total", total->total, sums);
+}
+
+/*
+* print_memory_row
+* ----------------
+* this function prints the heap use of a file a subsystem or the total as the columns of a row of a table
+*
+* parameters:
+*   file: the stream to print to
+*   usage: the heap use
+*
+*/
+void print_memory_row(FILE *file, const MemoryUsage *usage){
+	fprintf(file, " %11lu %12lu %12ld %12ld", usage->allocations, usage->bytes, usage->live, usage->peak);
+}
+
+/*
+* print_memory_tables
+* -------------------
+* this function prints the peak resident set size of the process after every file
+* and when built with MEMORY_STATS the heap use of every file and of every subsystem of all the files
+*
+* parameters:
+*   file: the stream to print to
+*   report: the report
+*   total: the sums of every file
+*
+*/
+void print_memory_tables(FILE *file, const StatsReport *report, const FileStats *total){
+	int i;
+
+	fprintf(file, "\n%-24s %11s", "file", "max_rss_kb");
+#ifdef MEMORY_STATS
+	fprintf(file, " %11s %12s %12s %12s", "allocations", "bytes", "live", "peak");
+#endif
+	fputc('\n', file);
+	for(i=0 ; i<=report->count ; i++){
+		fprintf(file, "%-24.24s %11ld", i < report->count ? report->files[i].name : "total", i < report->count ? report->files[i].max_rss : total->max_rss);
+#ifdef MEMORY_STATS
+		print_memory_row(file, i < report->count ? &report->files[i].memory_total : &total->memory_total);
+#endif
+		fputc('\n', file);
+	}
+#ifdef MEMORY_STATS
+	fprintf(file, "\n%-24s %11s %12s %12s %12s\n", "subsystem (all files)", "allocations", "bytes", "live", "peak");
+	for(i=0 ; i<=MEMORY_CATEGORY_COUNT ; i++){
+		fprintf(file, "%-24s", i < MEMORY_CATEGORY_COUNT ? memory_names[i] : "total");
+		print_memory_row(file, i < MEMORY_CATEGORY_COUNT ? &total->memory[i] : &total->memory_total);
+		fputc('\n', file);
+	}
+#endif
+}
+
+/*
+* print_stats_text
+* ----------------
+* this function prints a report as tables for people: the times in milliseconds the counters and the memory
+* every table has a row per file followed by the total
+* when built with MEMORY_STATS another table holds the heap use of every subsystem of all the files
+* with --perf-counters a third table holds the counters of the processor of every phase of all the files
+*
+* parameters:
+*   file: the stream to print to
+*   report: the report
+*
+*/
+void print_stats_text(FILE *file, const StatsReport *report){
+	FileStats total;
+	char result[32];
+	int i, j, succeeded;
+
+	succeeded = sum_stats(report, &total);
+	fprintf(file, "%-24s %-8s %10s", "file", "result", "total ms");
+	for(i=PHASE_PREPROCESS ; i<PHASE_COUNT ; i++){
+		fprintf(file, " %11.11s", phase_names[i]);
+	}
+	fprintf(file, " %11s\n", phase_names[PHASE_OTHER]);
+	for(i=0 ; i<report->count ; i++){
+		print_stats_row(file, report->files[i].name, report->files[i].success ? "ok" : "failed", &report->files[i]);
+	}
+	sprintf(result, "%d/%d", succeeded, report->count);
+	print_stats_row(file, "total", result, &total);
+	fprintf(file, "wall time of the run: %.3f ms\n\n", report->wall);
+
+	fprintf(file, "%-24s", "file");
+	for(j=0 ; j<COUNTER_COUNT ; j++){
+		fprintf(file, " %*s", (int)strlen(counter_names[j]) > 10 ? (int)strlen(counter_names[j]) : 10, counter_names[j]);
+	}
+	fputc('\n', file);
+	for(i=0 ; i<=report->count ; i++){
+		fprintf(file, "%-24.24s", i < report->count ? report->files[i].name : "total");
+		for(j=0 ; j<COUNTER_COUNT ; j++){
+			fprintf(file, " %*lu", (int)strlen(counter_names[j]) > 10 ? (int)strlen(counter_names[j]) : 10,
+				i < report->count ? report->files[i].counters[j] : total.counters[j]);
+		}
+		fputc('\n', file);
+	}
+	print_memory_tables(file, report, &total);
+	if(report->perf_available){
+		print_perf_table(file, report->perf_available, &total);
+	}
+}
+
+/*
+* print_stats_object
+* ------------------
+* this function prints the times counters and memory of a single file or of the total as JSON members
+* the counters of the processor that were measured follow for every phase and for the whole file
+*
+* parameters:
+*   file: the stream to print to
+*   stats: the statistics
+*   available: the mask of the counters of the processor that were measured
+*
+*/
+void print_stats_object(FILE *file, const FileStats *stats, unsigned int available){
+	unsigned long sums[PERF_COUNTER_COUNT];
+#ifdef MEMORY_STATS
+	const MemoryUsage *usage;
+#endif
+	int i, j;
+
+	fprintf(file, "\"success\":%s,\"total_ms\":%.3f,\"phases_ms\":{", stats->success ? "true" : "false", stats->total);
+	for(i=0 ; i<PHASE_COUNT ; i++){
+		fprintf(file, "%s\"%s\":%.3f", i ? "," : "", phase_names[i], stats->phases[i]);
+	}
+	fputs("},\"counters\":{", file);
+	for(i=0 ; i<COUNTER_COUNT ; i++){
+		fprintf(file, "%s\"%s\":%lu", i ? "," : "", counter_names[i], stats->counters[i]);
+	}
+	fprintf(file, "},\"memory\":{\"max_rss_kb\":%ld", stats->max_rss);
+#ifdef MEMORY_STATS
+	for(i=0 ; i<=MEMORY_CATEGORY_COUNT ; i++){
+		usage = i < MEMORY_CATEGORY_COUNT ? &stats->memory[i] : &stats->memory_total;
+		fprintf(file, ",\"%s\":{\"allocations\":%lu,\"bytes\":%lu,\"live\":%ld,\"peak\":%ld}",
+			i < MEMORY_CATEGORY_COUNT ? memory_names[i] : "total", usage->allocations, usage->bytes, usage->live, usage->peak);
+	}
+#endif
+	fputc('}', file);
+	if(!available){
+		return;
+	}
+	fputs(",\"perf\":{", file);
+	memset(sums, 0, sizeof(sums));
+	for(j=0 ; j<=PHASE_COUNT ; j++){
+		fprintf(file, "%s\"%s\":{", j ? "," : "", j < PHASE_COUNT ? phase_names[j] : "total");
+		for(i=0 ; i<PERF_COUNTER_COUNT ; i++){
+			if(available & (1u << i)){
+				sums[i] += j < PHASE_COUNT ? stats->perf_counters[j][i] : 0;
+				fprintf(file, "%s\"%s\":%lu", (available & ((1u << i) - 1)) ? "," : "", perf_counter_names[i],
+					j < PHASE_COUNT ? stats->perf_counters[j][i] : sums[i]);
+			}
+		}
+		fputc('}', file);
+	}
+	fputc('}', file);
+}
+
+/*
+* print_stats_json
+* ----------------
+* this function prints a report as a single JSON object for tools:
+*   {"files":[{"name":..., "success":..., "total_ms":..., "phases_ms":{...}, "counters":{...}, "memory":{...}}, ...],
+*    "total":{"files":N, "succeeded":N, "wall_ms":..., "success":..., "total_ms":..., "phases_ms":{...}, "counters":{...}}}
+* every file and the total also hold "memory":{"max_rss_kb":N} and when built with MEMORY_STATS
+* the heap use of every subsystem and of the whole file in it: "macros":{"allocations":N, "bytes":N, "live":N, "peak":N}, ..., "total":{...}
+* with --perf-counters every file and the total also hold "perf":{"preprocess":{"cycles":...}, ..., "total":{...}}
+*
+* parameters:
+*   file: the stream to print to
+*   report: the report
+*
+*/
+void print_stats_json(FILE *file, const StatsReport *report){
+	FileStats total;
+	int i, succeeded;
+
+	succeeded = sum_stats(report, &total);
+	fputs("{\"files\":[", file);
+	for(i=0 ; i<report->count ; i++){
+		fputs(i ? ",{\"name\":" : "{\"name\":", file);
+		json_write_string(file, report->files[i].name, strlen(report->files[i].name));
+		fputc(',', file);
+		print_stats_object(file, &report->files[i], report->perf_available);
+		fputc('}', file);
+	}
+	fprintf(file, "],\"total\":{\"files\":%d,\"succeeded\":%d,\"wall_ms\":%.3f,", report->count, succeeded, report->wall);
+	print_stats_object(file, &total, report->perf_available);
+	fputs("}}\n", file);
+}
+
+/*
+* free_stats_report
+* -----------------
+* this function frees the files of a report and empties it
+*
+* parameters:
+*   report: the report
+*
+*/
+void free_stats_report(StatsReport *report){
+	int i;
+
+	for(i=0 ; i<report->count ; i++){
+		free(report->files[i].name);
+	}
+	free(report->files);
+	memset(report, 0, sizeof(StatsReport));
+}
@@ -0,0 +1,152 @@
+#ifndef STATS_H
+#define STATS_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "definitions.h"
+#include "first_pass.h"
+#include "perf_counters.h"
+
+#define STATS_MAX_DEPTH 8/*deepest nesting of phases*/
+
+/*
+* statistics
+* ----------
+* --stats measures every file while it is assembled:
+*   the wall time of every phase on the monotonic clock (a nested phase is not counted in the phase around it)
+*   counters of what the file held and of the work it caused
+*   with --perf-counters the counters of the processor of every phase (see perf_counters.h)
+*   the peak resident set size of the process once the file is done (getrusage)
+*   built with MEMORY_STATS (make MEMSTATS=1) the heap use of every subsystem of the passes:
+*   every allocation carries a header with its size so the bytes still live when the file is done (its leaks) and the peak are known
+* the file being measured belongs to the calling thread like its error stream so the files of -j are measured separately
+* the STATS_ macros are the only way the passes reach the statistics so building with NO_STATS (make STATS=0)
+* removes every trace of them from the passes and every allocation of the passes goes through STATS_MALLOC and friends
+* so that a pointer they return is only ever freed by STATS_FREE
+*/
+
+/*** STRUCTURE DEFINITIONS SECTION ***/
+
+/*phases a file goes through*/
+typedef enum stats_phases{
+	PHASE_OTHER = 0,/*everything outside the other phases (opening the source hashing restoring from the cache)*/
+	PHASE_PREPROCESS = 1,/*expanding the macros*/
+	PHASE_FIRST_PASS = 2,/*sizing the program and collecting the labels*/
+	PHASE_ENTRIES = 3,/*giving every entry the address of its label*/
+	PHASE_SECOND_PASS = 4,/*encoding the program*/
+	PHASE_WRITE = 5,/*opening writing and committing the outputs (the words the second pass streams are part of that pass)*/
+	PHASE_COUNT = 6/*number of phases*/
+}stats_phase;
+
+/*counters of a file*/
+typedef enum stats_counters{
+	COUNTER_LINES = 0,/*source lines read*/
+	COUNTER_MACROS_DEFINED = 1,/*macros defined*/
+	COUNTER_MACROS_EXPANDED = 2,/*macro uses expanded*/
+	COUNTER_LABELS = 3,/*labels defined*/
+	COUNTER_EXTERNS = 4,/*names declared .extern*/
+	COUNTER_ENTRIES = 5,/*names declared .entry*/
+	COUNTER_EXTERN_REFERENCES = 6,/*words that reference an extern*/
+	COUNTER_CODE_WORDS = 7,/*words of the code image*/
+	COUNTER_DATA_WORDS = 8,/*words of the data image*/
+	COUNTER_BYTES_READ = 9,/*bytes of source read*/
+	COUNTER_BYTES_WRITTEN = 10,/*bytes of output written*/
+	COUNTER_ALLOCATIONS = 11,/*heap allocations made by the preprocessor and the passes*/
+	COUNTER_COUNT = 12/*number of counters*/
+}stats_counter;
+
+/*subsystems the allocations of the passes are charged to*/
+typedef enum memory_categories{
+	MEMORY_MACROS = 0,/*the macro table and the names and lines of the macros*/
+	MEMORY_LABELS = 1,/*the label table and its index*/
+	MEMORY_OPERANDS = 2,/*the operands of the instructions the second pass encodes*/
+	MEMORY_CODE_WORDS = 3,/*the words of the code image*/
+	MEMORY_DATA_COPIES = 4,/*the copies of the lines the passes split*/
+	MEMORY_OTHER = 5,/*the extern references the relocations and the line map*/
+	MEMORY_CATEGORY_COUNT = 6/*number of categories*/
+}memory_category;
+
+typedef struct{/*the heap use of a subsystem or of a whole file (counted only when built with MEMORY_STATS)*/
+	unsigned long allocations;/*allocations and reallocations*/
+	unsigned long bytes;/*bytes they asked for*/
+	long live;/*bytes allocated and not freed yet (once the file is done the bytes it leaked)*/
+	long peak;/*most bytes live at once*/
+}MemoryUsage;
+
+typedef struct{/*the statistics of a single file*/
+	char *name;/*the file argument (owned by a StatsReport)*/
+	bool success;/*true if the file was assembled*/
+	double total;/*wall time of the whole file in milliseconds*/
+	double phases[PHASE_COUNT];/*wall time of every phase in milliseconds*/
+	unsigned long counters[COUNTER_COUNT];/*the counters*/
+	bool perf;/*true when the counters of the processor are read*/
+	unsigned long perf_counters[PHASE_COUNT][PERF_COUNTER_COUNT];/*counters of the processor charged to every phase*/
+	unsigned long perf_mark[PERF_COUNTER_COUNT];/*the counters of the processor when they were last charged*/
+	MemoryUsage memory[MEMORY_CATEGORY_COUNT];/*heap use of every subsystem*/
+	MemoryUsage memory_total;/*heap use of the whole file (its peak is the peak of the sum of the subsystems)*/
+	long max_rss;/*peak resident set size of the process in kilobytes when the file was done*/
+	stats_phase stack[STATS_MAX_DEPTH];/*the phases entered and not yet left*/
+	int depth;/*number of phases on the stack*/
+	struct timespec start;/*when the file started*/
+	struct timespec mark;/*when the time of the current phase was last charged*/
+}FileStats;
+
+typedef struct{/*the statistics of every file of a run*/
+	FileStats *files;/*the files in the order they were given*/
+	int count;/*number of files*/
+	int capacity;/*capacity of the files array*/
+	double wall;/*wall time of the whole run in milliseconds (the sum of the files with -j is larger)*/
+	unsigned int perf_available;/*mask of the counters of the processor the files were measured with (0 without --perf-counters)*/
+}StatsReport;
+
+/*** INSTRUMENTATION SECTION ***/
+
+#ifdef NO_STATS
+#define STATS_ENTER(phase)
+#define STATS_LEAVE()
+#define STATS_COUNT(counter,amount)
+#define STATS_TABLES(labels,directives,references,code_length,data_length)
+#define STATS_MALLOC(category,size) malloc(size)
+#define STATS_CALLOC(category,count,size) calloc(count, size)
+#define STATS_REALLOC(category,pointer,size) realloc(pointer, size)
+#define STATS_FREE(pointer) free(pointer)
+#else
+#define STATS_ENTER(phase) enter_phase(phase)/*charge the time from here on to a phase*/
+#define STATS_LEAVE() leave_phase()/*go back to the phase that was entered before*/
+#define STATS_COUNT(counter,amount) count_stat(counter, (unsigned long)(amount))/*add to a counter*/
+#define STATS_TABLES(labels,directives,references,code_length,data_length) count_tables(labels, directives, references, code_length, data_length)/*count the tables of an assembled file*/
+#ifdef MEMORY_STATS
+#define STATS_MALLOC(category,size) counted_malloc(category, size)/*allocate and charge the bytes to a subsystem*/
+#define STATS_CALLOC(category,count,size) counted_calloc(category, count, size)
+#define STATS_REALLOC(category,pointer,size) counted_realloc(category, pointer, size)
+#define STATS_FREE(pointer) counted_free(pointer)/*free what STATS_MALLOC STATS_CALLOC or STATS_REALLOC returned*/
+#else
+#define STATS_MALLOC(category,size) (count_stat(COUNTER_ALLOCATIONS, 1), malloc(size))/*allocate and count the allocation*/
+#define STATS_CALLOC(category,count,size) (count_stat(COUNTER_ALLOCATIONS, 1), calloc(count, size))
+#define STATS_REALLOC(category,pointer,size) (count_stat(COUNTER_ALLOCATIONS, 1), realloc(pointer, size))
+#define STATS_FREE(pointer) free(pointer)
+#endif
+#endif
+
+/*** FUNCTION PROTOTYPES SECTION ***/
+
+void start_file_stats(FileStats *stats,const char *name);/*function to start measuring a file on the calling thread*/
+void stop_file_stats(bool success);/*function to stop measuring the file of the calling thread*/
+void enter_phase(stats_phase phase);/*function to charge the time from now on to a phase*/
+void leave_phase(void);/*function to go back to the phase entered before the current one*/
+void count_stat(stats_counter counter,unsigned long amount);/*function to add to a counter of the file of the calling thread*/
+void count_tables(const LabelArray *labels,const ExternEntryArray *directives,const ExternEntry *references,long code_length,long data_length);/*function to count the tables of an assembled file*/
+bool add_file_stats(StatsReport *report,const FileStats *stats);/*function to keep the statistics of a file in a report*/
+void print_stats_text(FILE *file,const StatsReport *report);/*function to print a report as a table*/
+void print_stats_json(FILE *file,const StatsReport *report);/*function to print a report as JSON*/
+void free_stats_report(StatsReport *report);/*function to free everything a report holds*/
+#ifdef MEMORY_STATS
+void *counted_malloc(memory_category category,size_t size);/*function to allocate memory and charge it to a subsystem of the measured file*/
+void *counted_calloc(memory_category category,size_t count,size_t size);/*function to allocate zeroed memory and charge it to a subsystem of the measured file*/
+void *counted_realloc(memory_category category,void *pointer,size_t size);/*function to resize a counted allocation*/
+void counted_free(void *pointer);/*function to free a counted allocation*/
+#endif
+
+#endif /*STATS_H*/
@@ -0,0 +1,63 @@
+#!/bin/sh
+#
+# test_cache.sh
+# -------------
+# checks the content cache of --cache against the assembler without a cache
+# every program is assembled next to an identical copy under another name, once to fill the cache and once to restore from it,
+# with no options then with -m and then with --report and --report-json so each output that names its source is covered on its own,
+# every output of both runs has to match the output of assembling the programs without the cache,
+# then a data word is appended to every program and the next cached run has to match the edited programs and not restore the old outputs
+#
+# usage: test_cache.sh ASSEMBLER CASEDIR
+#   the exit status is 1 when an output differs
+#
+
+if [ $# -ne 2 ]; then
+	echo "usage: $0 ASSEMBLER CASEDIR" >&2
+	exit 1
+fi
+ASSEMBLER=$(cd "$(dirname "$1")" && pwd)/$(basename "$1")
+DIR=$(mktemp -d) || exit 1
+FAILED=0
+
+mkdir "$DIR/plain" "$DIR/cached"
+for SOURCE in "$2"/*.as; do
+	NAME=$(basename "$SOURCE" .as)
+	cp "$SOURCE" "$DIR/plain/$NAME.as" && cp "$SOURCE" "$DIR/plain/copy_of_$NAME.as" || exit 1
+done
+NAMES=$(cd "$DIR/plain" && ls *.as | sed 's/\.as$//')
+cp "$DIR"/plain/*.as "$DIR/cached/"
+
+# compare_outputs
+# compares the outputs of the cached run named by $1 with the outputs of the run without the cache
+compare_outputs(){
+	for FILE in $(cd "$DIR/plain" && ls) $(cd "$DIR/cached" && ls); do
+		if ! cmp -s "$DIR/plain/$FILE" "$DIR/cached/$FILE"; then
+			echo "test_cache: $FILE of the $1 run differs from the output without the cache" >&2
+			FAILED=1
+		fi
+	done
+	if ! cmp -s "$DIR/plain.out" "$DIR/cached.out" || ! cmp -s "$DIR/plain.err" "$DIR/cached.err"; then
+		echo "test_cache: the $1 run printed other messages than the run without the cache" >&2
+		FAILED=1
+	fi
+}
+
+for OPTIONS in "" "-m" "--report --report-json"; do
+	(cd "$DIR/plain" && find . -type f ! -name '*.as' -exec rm {} + && "$ASSEMBLER" $OPTIONS $NAMES > ../plain.out 2> ../plain.err)
+	for RUN in cold warm; do
+		(cd "$DIR/cached" && find . -type f ! -name '*.as' -exec rm {} + && "$ASSEMBLER" --cache ../cache $OPTIONS $NAMES > ../cached.out 2> ../cached.err)
+		compare_outputs "$RUN ${OPTIONS:-plain}"
+	done
+done
+
+for SOURCE in "$DIR"/plain/*.as "$DIR"/cached/*.as; do
+	printf '\t.data 7\n' >> "$SOURCE"
+done
+(cd "$DIR/plain" && find . -type f ! -name '*.as' -exec rm {} + && "$ASSEMBLER" $NAMES > ../plain.out 2> ../plain.err)
+(cd "$DIR/cached" && find . -type f ! -name '*.as' -exec rm {} + && "$ASSEMBLER" --cache ../cache $NAMES > ../cached.out 2> ../cached.err)
+compare_outputs "edited"
+
+rm -rf "$DIR"
+[ $FAILED -eq 0 ] && echo "test_cache: passed"
+exit $FAILED
@@ -0,0 +1,50 @@
+#!/bin/sh
+#
+# test_chunked.sh
+# ---------------
+# checks the chunked passes of --chunked against the sequential passes
+# every program is assembled one at a time with -j 4 --chunked and without, with no options then with -m -r and --base
+# then with --report and --report-json and then with -b, so every output the chunks stream is covered,
+# the outputs and the messages of both runs have to match, the largest program is also assembled with an error on its last line
+# and with an .entry of one of its externs so a source that goes back to the sequential passes is covered too
+#
+# usage: test_chunked.sh ASSEMBLER CASEDIR
+#   the exit status is 1 when an output differs
+#
+
+if [ $# -ne 2 ]; then
+	echo "usage: $0 ASSEMBLER CASEDIR" >&2
+	exit 1
+fi
+ASSEMBLER=$(cd "$(dirname "$1")" && pwd)/$(basename "$1")
+DIR=$(mktemp -d) || exit 1
+FAILED=0
+
+mkdir "$DIR/sequential" "$DIR/chunked"
+LARGEST=$(ls -S "$2"/*.as | head -n 1)
+cp "$2"/*.as "$DIR/sequential/" || exit 1
+(cat "$LARGEST" && echo "mov r1") > "$DIR/sequential/late_error.as"
+(cat "$LARGEST" && sed -n 's/^\.extern /.entry /p' "$LARGEST" | head -n 1) > "$DIR/sequential/entry_of_extern.as"
+cp "$DIR"/sequential/*.as "$DIR/chunked/"
+NAMES=$(cd "$DIR/sequential" && ls *.as | sed 's/\.as$//')
+
+for OPTIONS in "" "-m -r --base 200" "--report --report-json" "-b"; do
+	for NAME in $NAMES; do
+		(cd "$DIR/sequential" && find . -type f ! -name '*.as' -exec rm {} + && "$ASSEMBLER" $OPTIONS $NAME > ../sequential.out 2>&1)
+		(cd "$DIR/chunked" && find . -type f ! -name '*.as' -exec rm {} + && "$ASSEMBLER" -j 4 --chunked $OPTIONS $NAME > ../chunked.out 2>&1)
+		for FILE in $(cd "$DIR/sequential" && ls) $(cd "$DIR/chunked" && ls); do
+			if ! cmp -s "$DIR/sequential/$FILE" "$DIR/chunked/$FILE"; then
+				echo "test_chunked: $FILE differs with '${OPTIONS:-no options}'" >&2
+				FAILED=1
+			fi
+		done
+		if ! cmp -s "$DIR/sequential.out" "$DIR/chunked.out"; then
+			echo "test_chunked: $NAME printed other messages with '${OPTIONS:-no options}'" >&2
+			FAILED=1
+		fi
+	done
+done
+
+rm -rf "$DIR"
+[ $FAILED -eq 0 ] && echo "test_chunked: passed"
+exit $FAILED
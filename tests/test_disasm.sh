@@ -0,0 +1,54 @@
+#!/bin/sh
+#
+# test_disasm.sh
+# --------------
+# checks that disasm reads back what the assembler writes in both object formats
+# every program that assembles is written as .ob .ent .ext and as .obb at the default base and at --base 150,
+# disasm -q has to verify both silently, the listing of the .obb has to match the listing of the text files line by line
+# after the first line (which names the file), and the address and word of every listed word have to be the lines of the .ob
+# a .obb cut short by a byte and a .ob missing its last line have to be rejected
+#
+# usage: test_disasm.sh ASSEMBLER CASEDIR
+#   DISASM is read from the directory of ASSEMBLER, the exit status is 1 when a check fails
+#
+
+if [ $# -ne 2 ]; then
+	echo "usage: $0 ASSEMBLER CASEDIR" >&2
+	exit 1
+fi
+ASSEMBLER=$(cd "$(dirname "$1")" && pwd)/$(basename "$1")
+DISASM=$(dirname "$ASSEMBLER")/disasm
+DIR=$(mktemp -d) || exit 1
+FAILED=0
+
+# fail
+# prints the message $1 about the current program and base and fails the test
+fail(){
+	echo "test_disasm: $NAME at base ${BASE:-100}: $1" >&2
+	FAILED=1
+}
+
+for SOURCE in "$2"/*.as; do
+	NAME=$(basename "$SOURCE" .as)
+	for BASE in "" 150; do
+		rm -f "$DIR"/*
+		cp "$SOURCE" "$DIR/$NAME.as"
+		(cd "$DIR" && "$ASSEMBLER" ${BASE:+--base $BASE} "$NAME" > /dev/null 2>&1 && "$ASSEMBLER" -b ${BASE:+--base $BASE} "$NAME" > /dev/null 2>&1) || continue
+		[ -z "$(cd "$DIR" && "$DISASM" -q "$NAME" "$NAME.obb" 2>&1)" ] || fail "disasm -q did not verify the outputs silently"
+		(cd "$DIR" && "$DISASM" "$NAME" > text.list 2>&1 && "$DISASM" "$NAME.obb" > binary.list 2>&1) || fail "disasm rejected the outputs"
+		tail -n +2 "$DIR/text.list" > "$DIR/text.body"
+		tail -n +2 "$DIR/binary.list" > "$DIR/binary.body"
+		cmp -s "$DIR/text.body" "$DIR/binary.body" || fail "the listings of the .ob and the .obb differ"
+		grep '^[0-9]' "$DIR/text.list" | cut -c1-10 > "$DIR/words"
+		tail -n +2 "$DIR/$NAME.ob" > "$DIR/ob.words"
+		cmp -s "$DIR/words" "$DIR/ob.words" || fail "the listed words are not the words of the .ob"
+		head -c -1 "$DIR/$NAME.obb" > "$DIR/short.obb"
+		(cd "$DIR" && "$DISASM" -q short.obb > /dev/null 2>&1) && fail "disasm accepted a .obb cut short"
+		head -n -1 "$DIR/$NAME.ob" > "$DIR/short.ob"
+		(cd "$DIR" && "$DISASM" -q short.ob > /dev/null 2>&1) && fail "disasm accepted a .ob missing its last line"
+	done
+done
+
+rm -rf "$DIR"
+[ $FAILED -eq 0 ] && echo "test_disasm: passed"
+exit $FAILED
@@ -0,0 +1,261 @@
+#include "../libassembler.h"
+#include "../lsp.h"
+
+/*
+* test_incremental
+* ----------------
+* checks that a document kept assembled across ranged edits (make test)
+* has after every edit the words and the diagnostics of a full process_file of the same text
+* every check prints the failed condition and the program exits with the number of failed checks
+*/
+
+#define CHECK(condition) check((condition), #condition, __LINE__)
+#define MAX_DIAGNOSTICS 64/*most diagnostics a step of the test compares*/
+
+int failures = 0;/*number of failed checks*/
+
+typedef struct{/*the diagnostics of a step as "line: message" strings*/
+	char *texts[MAX_DIAGNOSTICS];
+	int count;
+}DiagnosticTexts;
+
+/*
+* check
+* -----
+* this function counts and prints a failed condition
+*
+* parameters:
+*   condition: the value of the condition
+*   text: the text of the condition
+*   line: the line of the check
+*
+*/
+void check(bool condition, const char *text, int line){
+	if(!condition){
+		fprintf(stderr, "test_incremental.c:%d: check failed: %s\n", line, text);
+		failures++;
+	}
+}
+
+/*
+* add_text
+* --------
+* this function adds a diagnostic to the texts of a step
+*
+* parameters:
+*   texts: the texts
+*   line: the 1 based source line
+*   message: a single message
+*   length: the length of the message
+*
+*/
+void add_text(DiagnosticTexts *texts, int line, const char *message, size_t length){
+	if(texts->count == MAX_DIAGNOSTICS || length == 0){
+		return;
+	}
+	texts->texts[texts->count] = (char*)malloc(length + 16);
+	if(texts->texts[texts->count]){
+		sprintf(texts->texts[texts->count], "%d: %.*s", line, (int)length, message);
+		texts->count++;
+	}
+}
+
+/*
+* add_document_diagnostic
+* -----------------------
+* this function is the visitor that splits a diagnostic of the document into its messages
+*
+* parameters:
+*   context: the DiagnosticTexts
+*   line: the 1 based source line
+*   message: the messages one per line
+*
+*/
+void add_document_diagnostic(void *context, int line, const char *message){
+	size_t length;
+
+	while(*message){
+		length = strcspn(message, "\n");
+		add_text((DiagnosticTexts*)context, line, message, length);
+		message += length;
+		if(*message == '\n'){
+			message++;
+		}
+	}
+}
+
+/*
+* add_printed_diagnostics
+* -----------------------
+* this function collects the messages process_file printed that name a line (the lines of "error: ..." only sum the file up)
+*
+* parameters:
+*   texts: the texts
+*   printed: the error stream of process_file
+*
+*/
+void add_printed_diagnostics(DiagnosticTexts *texts, const char *printed){
+	const char *suffix, *end;
+	size_t length;
+
+	while(*printed){
+		length = strcspn(printed, "\n");
+		end = printed + length;
+		for(suffix = end ; suffix > printed && strncmp(suffix, " on line ", 9) != 0 ; suffix--);
+		if(strncmp(printed, "error: ", 7) != 0){
+			add_text(texts, suffix > printed ? atoi(suffix + 9) : 0, printed, suffix > printed ? (size_t)(suffix - printed) : length);
+		}
+		printed = *end ? end + 1 : end;
+	}
+}
+
+/*
+* compare_texts
+* -------------
+* this function orders a string array for qsort
+*
+*/
+int compare_texts(const void *first, const void *second){
+	return strcmp(*(char* const*)first, *(char* const*)second);
+}
+
+/*
+* compare_document
+* ----------------
+* this function assembles the text of a source with process_file and compares the result with its document
+*
+* parameters:
+*   open: the source after an edit
+*   step: the name of the edit for the messages
+*
+*/
+void compare_document(OpenDocument *open, const char *step){
+	AssemblerOptions options;
+	ObjectSink sink;
+	DiagnosticTexts full, incremental;
+	IncrementalDocument *document = &open->document;
+	FILE *source, *messages, *errors;
+	char *message_text = NULL, *error_text = NULL, *ob;
+	size_t message_size = 0, error_size = 0;
+	long code_length = -1, data_length = -1, *words = NULL, address;
+	unsigned long word;
+	int consumed, i, j;
+	bool success;
+
+	initialize_options(&options);
+	initialize_object_sink(&sink, "incremental", true);
+	messages = open_memstream(&message_text, &message_size);
+	errors = open_memstream(&error_text, &error_size);
+	source = open_buffer(open->text, open->length);
+	CHECK(messages && errors && source);
+	if(!messages || !errors || !source){
+		return;
+	}
+	redirect_output(messages, errors);
+	success = process_file("incremental", source, &sink, &options);
+	redirect_output(NULL, NULL);
+	fclose(source);
+	fclose(messages);
+	fclose(errors);
+
+	/*the words of the .ob file against the words of the lines*/
+	ob = sink.outputs[SINK_OB].buffer;
+	if(success && ob && sscanf(ob, "%ld %ld%n", &code_length, &data_length, &consumed) == 2){
+		CHECK(code_length == document->code_length && data_length == document->data_length);
+		words = (long*)calloc(code_length + data_length + 1, sizeof(long));
+		for(i=0 ; words && i<code_length + data_length ; i++){
+			ob += consumed;
+			if(sscanf(ob, "%ld %lo%n", &address, &word, &consumed) != 2){
+				break;
+			}
+			words[i] = (long)word;
+		}
+		for(i=0 ; words && i<document->count && code_length == document->code_length && data_length == document->data_length ; i++){
+			for(j=0 ; document->lines[i]->words && j<document->lines[i]->code_size ; j++){
+				if(words[document->lines[i]->code_offset + j] != (long)document->lines[i]->words[j]){
+					fprintf(stderr, "%s: code word %ld is %lo in the document and %lo in the .ob file\n", step, document->lines[i]->code_offset + j,
+						(unsigned long)document->lines[i]->words[j], (unsigned long)words[document->lines[i]->code_offset + j]);
+					failures++;
+				}
+			}
+			for(j=0 ; document->lines[i]->words && j<document->lines[i]->data_size ; j++){
+				if(words[code_length + document->lines[i]->data_offset + j] != (long)document->lines[i]->words[document->lines[i]->code_size + j]){
+					fprintf(stderr, "%s: data word %ld differs from the .ob file\n", step, document->lines[i]->data_offset + j);
+					failures++;
+				}
+			}
+		}
+		free(words);
+	}
+	else{
+		CHECK(!success);
+	}
+	release_object_sink(&sink);
+
+	/*the diagnostics in the order of their text*/
+	full.count = incremental.count = 0;
+	add_printed_diagnostics(&full, error_text ? error_text : "");
+	visit_diagnostics(document, add_document_diagnostic, &incremental);
+	qsort(full.texts, full.count, sizeof(char*), compare_texts);
+	qsort(incremental.texts, incremental.count, sizeof(char*), compare_texts);
+	for(i=0 ; i<full.count || i<incremental.count ; i++){
+		if(i >= full.count || i >= incremental.count || strcmp(full.texts[i], incremental.texts[i]) != 0){
+			fprintf(stderr, "%s: the document reports \"%s\" where process_file reports \"%s\"\n", step,
+				i < incremental.count ? incremental.texts[i] : "", i < full.count ? full.texts[i] : "");
+			failures++;
+		}
+	}
+	for(i=0 ; i<full.count ; i++){
+		free(full.texts[i]);
+	}
+	for(i=0 ; i<incremental.count ; i++){
+		free(incremental.texts[i]);
+	}
+	free(message_text);
+	free(error_text);
+}
+
+/*the edits of the test in the order they are applied each a didChange content change*/
+const char *const edits[][2] = {
+	{"open", "{\"text\":\"; incremental test\\n.extern OUT\\n.entry MAIN\\nMAIN:\\tmov r1, r2\\nLOOP:\\tadd #5, COUNT\\n\\tjmp OUT\\n\\tbne LOOP\\n\\tstop\\nCOUNT:\\t.data 3, -4\\nTEXT:\\t.string \\\"ab\\\"\\n\"}"},
+	{"insert a line", "{\"range\":{\"start\":{\"line\":4,\"character\":0},\"end\":{\"line\":4,\"character\":0}},\"text\":\"\\tinc COUNT\\n\"}"},
+	{"change an operand", "{\"range\":{\"start\":{\"line\":5,\"character\":10},\"end\":{\"line\":5,\"character\":12}},\"text\":\"r3\"}"},
+	{"refer to an undefined label", "{\"range\":{\"start\":{\"line\":6,\"character\":5},\"end\":{\"line\":6,\"character\":8}},\"text\":\"NOWHERE\"}"},
+	{"define the label", "{\"range\":{\"start\":{\"line\":9,\"character\":0},\"end\":{\"line\":9,\"character\":0}},\"text\":\"NOWHERE:\\t.data 7\\n\"}"},
+	{"define a label twice", "{\"range\":{\"start\":{\"line\":8,\"character\":0},\"end\":{\"line\":8,\"character\":0}},\"text\":\"LOOP:\\tstop\\n\"}"},
+	{"add an unknown operation", "{\"range\":{\"start\":{\"line\":3,\"character\":0},\"end\":{\"line\":3,\"character\":0}},\"text\":\"\\tfoo r1\\n\"}"},
+	{"delete across lines", "{\"range\":{\"start\":{\"line\":3,\"character\":0},\"end\":{\"line\":4,\"character\":0}},\"text\":\"\"}"},
+	{"delete the second definition", "{\"range\":{\"start\":{\"line\":8,\"character\":0},\"end\":{\"line\":9,\"character\":0}},\"text\":\"\"}"},
+	{"add a macro", "{\"range\":{\"start\":{\"line\":1,\"character\":0},\"end\":{\"line\":1,\"character\":0}},\"text\":\"macr twice\\n\\tinc r4\\n\\tinc r4\\nendmacr\\n\"}"},
+	{"call the macro", "{\"range\":{\"start\":{\"line\":8,\"character\":0},\"end\":{\"line\":8,\"character\":0}},\"text\":\"twice\\n\"}"},
+	{"label an extern", "{\"range\":{\"start\":{\"line\":5,\"character\":0},\"end\":{\"line\":5,\"character\":0}},\"text\":\"EXT: \"}"},
+	{"label an entry", "{\"range\":{\"start\":{\"line\":6,\"character\":0},\"end\":{\"line\":6,\"character\":0}},\"text\":\"ENT: \"}"},
+	{"define an extern", "{\"range\":{\"start\":{\"line\":0,\"character\":0},\"end\":{\"line\":0,\"character\":0}},\"text\":\"OUT:\\tstop\\n\"}"},
+	{"delete the definition of the extern", "{\"range\":{\"start\":{\"line\":0,\"character\":0},\"end\":{\"line\":1,\"character\":0}},\"text\":\"\"}"},
+	{"export an extern", "{\"range\":{\"start\":{\"line\":0,\"character\":0},\"end\":{\"line\":0,\"character\":0}},\"text\":\".entry OUT\\n\"}"},
+	{"delete the entry of the extern", "{\"range\":{\"start\":{\"line\":0,\"character\":0},\"end\":{\"line\":1,\"character\":0}},\"text\":\"\"}"},
+	{"break the data", "{\"range\":{\"start\":{\"line\":14,\"character\":8},\"end\":{\"line\":14,\"character\":8}},\"text\":\",\"}"},
+	{"join two lines", "{\"range\":{\"start\":{\"line\":11,\"character\":5},\"end\":{\"line\":12,\"character\":0}},\"text\":\"\"}"},
+	{"replace the text", "{\"text\":\"\\tstop\\n\"}"},
+	{"empty the text", "{\"text\":\"\"}"}
+};
+
+int main(void){
+	OpenDocument open;
+	int i;
+
+	memset(&open, 0, sizeof(open));
+	open.text = (char*)calloc(1, 1);
+	CHECK(open.text && initialize_incremental_document(&open.document));
+	for(i=0 ; i<(int)(sizeof(edits) / sizeof(edits[0])) ; i++){
+		CHECK(apply_change(&open, edits[i][1]));
+		CHECK(update_incremental_document(&open.document, open.text, open.length));
+		compare_document(&open, edits[i][0]);
+	}
+	free_incremental_document(&open.document);
+	free(open.text);
+	if(failures == 0){
+		printf("test_incremental: all checks passed\n");
+	}
+	return failures;
+}
@@ -0,0 +1,125 @@
+#include "../libassembler.h"
+
+/*
+* test_libassembler
+* -----------------
+* checks of the in-memory assembler API (make test)
+* every check prints the failed condition and the program exits with the number of failed checks
+*/
+
+#define CHECK(condition) check((condition), #condition, __LINE__)
+
+int failures = 0;/*number of failed checks*/
+
+/*
+* check
+* -----
+* this function counts and prints a failed condition
+*
+* parameters:
+*   condition: the value of the condition
+*   text: the text of the condition
+*   line: the line of the check
+*
+*/
+void check(bool condition, const char *text, int line){
+	if(!condition){
+		fprintf(stderr, "test_libassembler.c:%d: check failed: %s\n", line, text);
+		failures++;
+	}
+}
+
+/*
+* test_clean_source
+* -----------------
+* a source without errors gives its images its tables and no diagnostics
+*
+*/
+void test_clean_source(void){
+	const char *source = "; a clean program\n.extern OUT\n.entry MAIN\nMAIN:\tmov r1, r2\n\tjmp OUT\n\tstop\nNUMS:\t.data 7, -1\n";
+	AssemblerOptions options;
+	AssemblyResult result;
+
+	initialize_options(&options);
+	initialize_assembly_result(&result);
+	CHECK(assemble_buffer("clean", source, strlen(source), &options, &result));
+	CHECK(result.success);
+	CHECK(result.diagnostic_count == 0);
+	CHECK(result.code_length == 5);/*mov with two registers takes 2 words jmp 2 and stop 1*/
+	CHECK(result.data_length == 2);
+	CHECK(result.data_length == 2 && result.data[0] == 7 && result.data[1] == 0x7fff);
+	CHECK(result.entry_count == 1 && strcmp(result.entries[0].name, "MAIN") == 0 && result.entries[0].address == 100);
+	CHECK(result.extern_count == 1 && strcmp(result.externs[0].name, "OUT") == 0 && result.externs[0].address == 103);
+	free_assembly_result(&result);
+}
+
+/*
+* test_error_source
+* -----------------
+* every error of a source is a diagnostic that names its file line and column
+* and a label on an .extern directive is a warning that does not fail the source on its own
+*
+*/
+void test_error_source(void){
+	const char *source = "; errors\nMAIN:\tmov r1, r2\nMAIN:\tstop\n\tfoo r1\n\tjmp NOWHERE\n";
+	const char *warning = "X:\t.extern OUT\n\tjmp OUT\n\tstop\n";
+	AssemblerOptions options;
+	AssemblyResult result;
+	int i;
+
+	initialize_options(&options);
+	initialize_assembly_result(&result);
+	CHECK(!assemble_buffer("broken", source, strlen(source), &options, &result));
+	CHECK(!result.success);
+	CHECK(result.diagnostic_count == 3);
+	for(i=0 ; i<result.diagnostic_count ; i++){
+		CHECK(result.diagnostics[i].severity == DIAGNOSTIC_ERROR);
+		CHECK(strcmp(result.diagnostics[i].file, "broken") == 0);
+		CHECK(strchr(result.diagnostics[i].message, '\n') == NULL);
+	}
+	if(result.diagnostic_count == 3){
+		CHECK(strcmp(result.diagnostics[0].message, "Error: Duplicate label 'MAIN'") == 0);
+		CHECK(result.diagnostics[0].line == 3 && result.diagnostics[0].column == 1);
+		CHECK(strcmp(result.diagnostics[1].message, "Error: Unknown directive or operation 'foo'") == 0);
+		CHECK(result.diagnostics[1].line == 4 && result.diagnostics[1].column == 2);
+		CHECK(strcmp(result.diagnostics[2].message, "Error: Label 'NOWHERE' was not initialized") == 0);
+		CHECK(result.diagnostics[2].line == 5 && result.diagnostics[2].column == 6);
+	}
+
+	CHECK(assemble_buffer("warning", warning, strlen(warning), &options, &result));/*the result is reused*/
+	CHECK(result.diagnostic_count == 1);
+	if(result.diagnostic_count == 1){
+		CHECK(result.diagnostics[0].severity == DIAGNOSTIC_WARNING);
+		CHECK(result.diagnostics[0].line == 1 && result.diagnostics[0].column == 1);
+	}
+	free_assembly_result(&result);
+}
+
+/*
+* test_empty_source
+* -----------------
+* an empty source is an empty program (its buffer is never handed to fmemopen)
+*
+*/
+void test_empty_source(void){
+	AssemblerOptions options;
+	AssemblyResult result;
+
+	initialize_options(&options);
+	initialize_assembly_result(&result);
+	CHECK(assemble_buffer("empty", "", 0, &options, &result));
+	CHECK(result.success);
+	CHECK(result.code_length == 0 && result.data_length == 0);
+	CHECK(result.diagnostic_count == 0);
+	free_assembly_result(&result);
+}
+
+int main(void){
+	test_clean_source();
+	test_error_source();
+	test_empty_source();
+	if(failures == 0){
+		printf("test_libassembler: all checks passed\n");
+	}
+	return failures;
+}
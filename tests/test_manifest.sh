@@ -0,0 +1,54 @@
+#!/bin/sh
+#
+# test_manifest.sh
+# ----------------
+# checks that the files of a manifest are assembled like the same files given as arguments
+# the manifest lists every program with a blank line, a line ending with \r\n and a first line that sends its outputs
+# to another directory after a tab, it is read as @F, as --files-from F, as --files-from - and as @F with -j 4,
+# every run has to write the outputs and print the messages of the run over the file arguments
+#
+# usage: test_manifest.sh ASSEMBLER CASEDIR
+#   the exit status is 1 when a run differs
+#
+
+if [ $# -ne 2 ]; then
+	echo "usage: $0 ASSEMBLER CASEDIR" >&2
+	exit 1
+fi
+ASSEMBLER=$(cd "$(dirname "$1")" && pwd)/$(basename "$1")
+DIR=$(mktemp -d) || exit 1
+FAILED=0
+
+mkdir "$DIR/arguments" "$DIR/manifest"
+cp "$2"/*.as "$DIR/arguments/" && cp "$2"/*.as "$DIR/manifest/" || exit 1
+NAMES=$(cd "$DIR/arguments" && ls *.as | sed 's/\.as$//')
+(cd "$DIR/arguments" && "$ASSEMBLER" $NAMES > ../arguments.out 2> ../arguments.err)
+
+FIRST=1
+for NAME in $NAMES; do
+	if [ $FIRST -eq 1 ]; then
+		printf '%s\tout\n\n' "$NAME"
+		FIRST=0
+	else
+		printf '%s\r\n' "$NAME"
+	fi
+done > "$DIR/manifest/list"
+
+for RUN in "@list" "--files-from list" "--files-from -" "-j 4 @list"; do
+	(cd "$DIR/manifest" && find . -type f ! -name '*.as' ! -name list -exec rm {} + && mkdir -p out &&
+		"$ASSEMBLER" $RUN < list > ../manifest.out 2> ../manifest.err; mv out/* . && rmdir out)
+	for FILE in $(cd "$DIR/arguments" && ls) $(cd "$DIR/manifest" && ls | grep -vx list); do
+		if ! cmp -s "$DIR/arguments/$FILE" "$DIR/manifest/$FILE"; then
+			echo "test_manifest: $FILE differs with '$RUN'" >&2
+			FAILED=1
+		fi
+	done
+	if ! cmp -s "$DIR/arguments.out" "$DIR/manifest.out" || ! cmp -s "$DIR/arguments.err" "$DIR/manifest.err"; then
+		echo "test_manifest: '$RUN' printed other messages than the file arguments" >&2
+		FAILED=1
+	fi
+done
+
+rm -rf "$DIR"
+[ $FAILED -eq 0 ] && echo "test_manifest: passed"
+exit $FAILED
@@ -0,0 +1,45 @@
+#!/bin/sh
+#
+# test_parallel.sh
+# ----------------
+# checks -j against assembling the files one after the other
+# all the programs and a file that does not exist are assembled in a single run without -j and with -j 4,
+# with no options and then with -m -r and both reports, both runs have to write the same outputs,
+# print the same messages in the same order and exit with the same status
+#
+# usage: test_parallel.sh ASSEMBLER CASEDIR
+#   the exit status is 1 when the runs differ
+#
+
+if [ $# -ne 2 ]; then
+	echo "usage: $0 ASSEMBLER CASEDIR" >&2
+	exit 1
+fi
+ASSEMBLER=$(cd "$(dirname "$1")" && pwd)/$(basename "$1")
+DIR=$(mktemp -d) || exit 1
+FAILED=0
+
+mkdir "$DIR/sequential" "$DIR/parallel"
+cp "$2"/*.as "$DIR/sequential/" && cp "$2"/*.as "$DIR/parallel/" || exit 1
+NAMES="$(cd "$DIR/sequential" && ls *.as | sed 's/\.as$//') missing"
+
+for OPTIONS in "" "-m -r --report --report-json"; do
+	(cd "$DIR/sequential" && find . -type f ! -name '*.as' -exec rm {} + ; "$ASSEMBLER" $OPTIONS $NAMES > ../sequential.out 2> ../sequential.err; echo $? > ../sequential.status)
+	(cd "$DIR/parallel" && find . -type f ! -name '*.as' -exec rm {} + ; "$ASSEMBLER" -j 4 $OPTIONS $NAMES > ../parallel.out 2> ../parallel.err; echo $? > ../parallel.status)
+	for FILE in $(cd "$DIR/sequential" && ls) $(cd "$DIR/parallel" && ls); do
+		if ! cmp -s "$DIR/sequential/$FILE" "$DIR/parallel/$FILE"; then
+			echo "test_parallel: $FILE differs with '${OPTIONS:-no options}'" >&2
+			FAILED=1
+		fi
+	done
+	for STREAM in out err status; do
+		if ! cmp -s "$DIR/sequential.$STREAM" "$DIR/parallel.$STREAM"; then
+			echo "test_parallel: the $STREAM of -j 4 differs with '${OPTIONS:-no options}'" >&2
+			FAILED=1
+		fi
+	done
+done
+
+rm -rf "$DIR"
+[ $FAILED -eq 0 ] && echo "test_parallel: passed"
+exit $FAILED
@@ -0,0 +1,68 @@
+#!/bin/sh
+#
+# test_relocation.sh
+# ------------------
+# checks --base and the relocation table of -r against the same program at the default base
+# every program that assembles is assembled with -r at 100 and at 150, at 150 every address of the .ob .ent .ext and .rel
+# has to be the address at 100 plus 50, a word the .rel lists has to hold an internal address 50 higher (50 << 3 with its ARE bits)
+# and every other word has to stay the same, so the table names exactly the words a loader has to patch
+#
+# usage: test_relocation.sh ASSEMBLER CASEDIR
+#   the exit status is 1 when a check fails
+#
+
+if [ $# -ne 2 ]; then
+	echo "usage: $0 ASSEMBLER CASEDIR" >&2
+	exit 1
+fi
+ASSEMBLER=$(cd "$(dirname "$1")" && pwd)/$(basename "$1")
+DIR=$(mktemp -d) || exit 1
+SHIFT=50
+FAILED=0
+
+# fail
+# prints the message $1 about the current program and fails the test
+fail(){
+	echo "test_relocation: $NAME: $1" >&2
+	FAILED=1
+}
+
+# shift_addresses
+# prints the file $1 with the address in the field $2 of every line moved by SHIFT
+shift_addresses(){
+	awk -v field="$2" -v shift=$SHIFT '{ $field = sprintf("%04d", $field + shift); print }' "$1"
+}
+
+mkdir "$DIR/low" "$DIR/high"
+for SOURCE in "$2"/*.as; do
+	NAME=$(basename "$SOURCE" .as)
+	rm -f "$DIR"/low/* "$DIR"/high/*
+	cp "$SOURCE" "$DIR/low/" && cp "$SOURCE" "$DIR/high/" || exit 1
+	(cd "$DIR/low" && "$ASSEMBLER" -r "$NAME" > /dev/null 2>&1) || continue
+	(cd "$DIR/high" && "$ASSEMBLER" -r --base $((100 + SHIFT)) "$NAME" > /dev/null 2>&1) || { fail "it does not assemble at base $((100 + SHIFT))"; continue; }
+	for SUFFIX in ent ext rel; do
+		if [ -f "$DIR/low/$NAME.$SUFFIX" ] || [ -f "$DIR/high/$NAME.$SUFFIX" ]; then
+			FIELD=2
+			[ $SUFFIX != rel ] || FIELD=1
+			shift_addresses "$DIR/low/$NAME.$SUFFIX" $FIELD 2> /dev/null | cmp -s - "$DIR/high/$NAME.$SUFFIX" || fail "the .$SUFFIX does not move by $SHIFT"
+		fi
+	done
+	# every word is compared with the word at the same index: listed words move by SHIFT << 3 and the others stay
+	tail -n +2 "$DIR/high/$NAME.ob" > "$DIR/high/body"
+	[ "$(head -n 1 "$DIR/low/$NAME.ob")" = "$(head -n 1 "$DIR/high/$NAME.ob")" ] || fail "the .ob header changed with the base"
+	tail -n +2 "$DIR/low/$NAME.ob" | paste -d' ' - "$DIR/high/body" | awk -v shift=$SHIFT -v rel="$DIR/low/$NAME.rel" '
+		function octal(text,    value, i){
+			value = 0
+			for(i=1 ; i<=length(text) ; i++) value = value * 8 + substr(text, i, 1)
+			return value
+		}
+		BEGIN { while((getline line < rel) > 0) listed[line + 0] = 1 }
+		$3 + 0 != $1 + shift { print "address " $1 " moved to " $3; bad = 1; next }
+		listed[$1 + 0] && octal($4) - octal($2) != shift * 8 { print "the listed word at " $1 " did not move by " shift; bad = 1 }
+		!listed[$1 + 0] && $4 != $2 { print "the word at " $1 " changed but the .rel does not list it"; bad = 1 }
+		END { exit bad }' > "$DIR/problems" || fail "$(head -n 1 "$DIR/problems")"
+done
+
+rm -rf "$DIR"
+[ $FAILED -eq 0 ] && echo "test_relocation: passed"
+exit $FAILED
@@ -0,0 +1,60 @@
+#!/bin/sh
+#
+# test_server.sh
+# --------------
+# checks the daemon of --serve against the local assembler
+# a daemon with a single worker is started and a client forwards the programs over more connections than it has workers,
+# every output the client writes has to match the output of assembling the program locally
+# the client runs under a timeout so a daemon whose workers are held by idle connections fails instead of hanging
+#
+# usage: test_server.sh ASSEMBLER CASEDIR
+#   the exit status is 1 when the client timed out or an output differs
+#
+
+if [ $# -ne 2 ]; then
+	echo "usage: $0 ASSEMBLER CASEDIR" >&2
+	exit 1
+fi
+ASSEMBLER=$(cd "$(dirname "$1")" && pwd)/$(basename "$1")
+DIR=$(mktemp -d) || exit 1
+FAILED=0
+
+mkdir "$DIR/local" "$DIR/remote"
+cp "$2"/*.as "$DIR/local/" && cp "$2"/*.as "$DIR/remote/" || exit 1
+NAMES=$(cd "$DIR/local" && ls *.as | sed 's/\.as$//')
+
+"$ASSEMBLER" --serve "$DIR/socket" -j 1 2> "$DIR/daemon.log" &
+DAEMON=$!
+for WAIT in 1 2 3 4 5 6 7 8 9 10; do
+	[ -S "$DIR/socket" ] && break
+	sleep 0.2
+done
+
+(cd "$DIR/local" && "$ASSEMBLER" $NAMES > ../local.out 2> ../local.err)
+(cd "$DIR/remote" && timeout 20 "$ASSEMBLER" --connect "$DIR/socket" -j 3 $NAMES > ../remote.out 2> ../remote.err)
+STATUS=$?
+if ! kill $DAEMON 2> /dev/null; then
+	echo "test_server: the daemon did not keep running" >&2
+	FAILED=1
+fi
+wait $DAEMON 2> /dev/null
+
+if [ $STATUS -eq 124 ]; then
+	echo "test_server: the client timed out with more connections than the daemon has workers" >&2
+	FAILED=1
+fi
+if ! sort "$DIR/local.out" > "$DIR/local.sorted" || ! sort "$DIR/remote.out" | cmp -s - "$DIR/local.sorted"; then
+	echo "test_server: the client printed other messages than the local assembler" >&2
+	FAILED=1
+fi
+for FILE in $(cd "$DIR/local" && ls); do
+	if ! cmp -s "$DIR/local/$FILE" "$DIR/remote/$FILE"; then
+		echo "test_server: $FILE differs from the local output" >&2
+		FAILED=1
+	fi
+done
+[ $(ls "$DIR/remote" | wc -l) -eq $(ls "$DIR/local" | wc -l) ] || { echo "test_server: the client wrote other files than the local assembler" >&2; FAILED=1; }
+
+rm -rf "$DIR"
+[ $FAILED -eq 0 ] && echo "test_server: passed"
+exit $FAILED
@@ -0,0 +1,94 @@
+#!/bin/sh
+#
+# test_stdio.sh
+# -------------
+# checks the framed sections --stdio writes against the files the same options write
+# every program is piped through --stdio with no options then with -m -r --base and both reports and then with -b,
+# the stream has to be "section EXTENSION LENGTH" headers each followed by exactly LENGTH bytes and end with the line "end",
+# the sections have to come in the documented order and hold exactly the files a run on the file writes
+# (the file is named stdin.as because that is the name --stdio gives its source in the .map and the reports),
+# and a program that fails has to write nothing to stdout and exit with a non-zero status like the run on the file
+#
+# usage: test_stdio.sh ASSEMBLER CASEDIR
+#   the exit status is 1 when a stream is malformed or differs from the files
+#
+
+if [ $# -ne 2 ]; then
+	echo "usage: $0 ASSEMBLER CASEDIR" >&2
+	exit 1
+fi
+ASSEMBLER=$(cd "$(dirname "$1")" && pwd)/$(basename "$1")
+DIR=$(mktemp -d) || exit 1
+ORDER=".ob .ent .ext .rel .obb .map .report .report.json"
+FAILED=0
+
+# fail
+# prints the message $1 about the current program and options and fails the test
+fail(){
+	echo "test_stdio: $NAME with '${OPTIONS:-no options}': $1" >&2
+	FAILED=1
+}
+
+# split_stream
+# splits $DIR/stream into the files of $DIR/sections named after their extensions and lists the extensions in $DIR/order
+# returns 1 when the stream is malformed
+split_stream(){
+	POSITION=1
+	: > "$DIR/order"
+	while :; do
+		HEADER=$(tail -c +$POSITION "$DIR/stream" | head -n 1)
+		POSITION=$((POSITION + ${#HEADER} + 1))
+		case $HEADER in
+			end)
+				[ $((POSITION - 1)) -eq "$(wc -c < "$DIR/stream")" ] || return 1
+				return 0
+				;;
+			"section "*)
+				set -- $HEADER
+				[ $# -eq 3 ] || return 1
+				tail -c +$POSITION "$DIR/stream" | head -c "$3" > "$DIR/sections/stdin$2"
+				[ "$(wc -c < "$DIR/sections/stdin$2")" -eq "$3" ] || return 1
+				echo "$2" >> "$DIR/order"
+				POSITION=$((POSITION + $3))
+				;;
+			*)
+				return 1
+				;;
+		esac
+	done
+}
+
+mkdir "$DIR/files" "$DIR/sections"
+for SOURCE in "$2"/*.as; do
+	NAME=$(basename "$SOURCE" .as)
+	for OPTIONS in "" "-m -r --base 150 --report --report-json" "-b"; do
+		rm -f "$DIR"/files/* "$DIR"/sections/*
+		cp "$SOURCE" "$DIR/files/stdin.as"
+		(cd "$DIR/files" && "$ASSEMBLER" $OPTIONS stdin > /dev/null 2>&1)
+		FILE_STATUS=$?
+		"$ASSEMBLER" --stdio $OPTIONS < "$SOURCE" > "$DIR/stream" 2> /dev/null
+		STDIO_STATUS=$?
+		rm "$DIR/files/stdin.as"
+		if [ $FILE_STATUS -ne 0 ]; then
+			[ $STDIO_STATUS -ne 0 ] || fail "the file failed but --stdio exited with 0"
+			[ ! -s "$DIR/stream" ] || fail "the source failed but --stdio wrote to stdout"
+			continue
+		fi
+		[ $STDIO_STATUS -eq 0 ] || fail "the file was assembled but --stdio exited with $STDIO_STATUS"
+		if ! split_stream; then
+			fail "the stream is not a list of sections ending with end"
+			continue
+		fi
+		for EXTENSION in $ORDER; do
+			[ ! -f "$DIR/files/stdin$EXTENSION" ] || echo "$EXTENSION"
+		done > "$DIR/expected_order"
+		cmp -s "$DIR/order" "$DIR/expected_order" || fail "the sections are $(echo $(cat "$DIR/order")) instead of $(echo $(cat "$DIR/expected_order"))"
+		for EXTENSION in $(cat "$DIR/expected_order"); do
+			cmp -s "$DIR/files/stdin$EXTENSION" "$DIR/sections/stdin$EXTENSION" || fail "section $EXTENSION differs from the file"
+		done
+	done
+done
+
+rm -rf "$DIR"
+[ $FAILED -eq 0 ] && echo "test_stdio: passed"
+exit $FAILED
@@ -0,0 +1,285 @@
+#include "trace.h"
+#include "utils.h"
+#include <errno.h>
+
+/*** RECORDING SECTION ***/
+
+/*
+* trace_state
+* -----------
+* tracing is true between start_trace and stop_trace and is only changed while no other thread runs
+* every thread that records finds its buffer through trace_key and every buffer is linked into trace_buffers
+* so stop_trace can write the events of the threads that already exited
+*/
+bool tracing = false;
+struct timespec trace_start;
+pthread_key_t trace_key;
+pthread_once_t trace_key_once = PTHREAD_ONCE_INIT;
+pthread_mutex_t trace_mutex = PTHREAD_MUTEX_INITIALIZER;
+TraceBuffer *trace_buffers = NULL;
+int trace_threads = 0;
+
+/*
+* create_trace_key
+* ----------------
+* this function creates the thread specific key that holds the buffer of each thread
+* it runs exactly once through pthread_once
+*
+*/
+void create_trace_key(void){
+	pthread_key_create(&trace_key, NULL);
+}
+
+/*
+* trace_time
+* ----------
+* this function returns the time since the trace started
+*
+* returns:
+*   double: the time in microseconds
+*/
+double trace_time(void){
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (now.tv_sec - trace_start.tv_sec) * 1000000.0 + (now.tv_nsec - trace_start.tv_nsec) / 1000.0;
+}
+
+/*
+* thread_buffer
+* -------------
+* this function returns the buffer of the calling thread and makes it the first time the thread records
+*
+* returns:
+*   TraceBuffer*: the buffer or NULL when memory ran out (the thread then records nothing)
+*/
+TraceBuffer *thread_buffer(void){
+	TraceBuffer *buffer;
+
+	pthread_once(&trace_key_once, create_trace_key);
+	buffer = (TraceBuffer*)pthread_getspecific(trace_key);
+	if(buffer){
+		return buffer;
+	}
+	buffer = (TraceBuffer*)calloc(1, sizeof(TraceBuffer));
+	if(!buffer){
+		return NULL;
+	}
+	buffer->events = (TraceEvent*)malloc(TRACE_RING_EVENTS * sizeof(TraceEvent));
+	if(!buffer->events){
+		free(buffer);
+		return NULL;
+	}
+	pthread_mutex_lock(&trace_mutex);
+	buffer->thread = ++trace_threads;
+	buffer->next = trace_buffers;
+	trace_buffers = buffer;
+	pthread_mutex_unlock(&trace_mutex);
+	sprintf(buffer->thread_name, "thread %d", buffer->thread);
+	pthread_setspecific(trace_key, buffer);
+	return buffer;
+}
+
+/*
+* start_trace
+* -----------
+* this function starts recording the spans of every thread
+* it must be called before the threads that record are started and the calling thread is named main
+*
+* returns:
+*   bool: true if the trace started false if memory ran out
+*/
+bool start_trace(void){
+	clock_gettime(CLOCK_MONOTONIC, &trace_start);
+	tracing = true;
+	if(!thread_buffer()){
+		tracing = false;
+		return false;
+	}
+	trace_name_thread("main", 0);
+	return true;
+}
+
+/*
+* trace_begin
+* -----------
+* this function begins a span on the calling thread
+* a span that begins deeper than TRACE_MAX_DEPTH is not recorded
+*
+* parameters:
+*   category: the category of the span
+*   name: the static name of the span
+*   file: the file the span belongs to (copied and used as the name of the span) or NULL
+*   task: the number of the task of the work pool or -1
+*
+*/
+void trace_begin(const char *category, const char *name, const char *file, int task){
+	TraceBuffer *buffer;
+	OpenSpan *span;
+
+	if(!tracing || !(buffer = thread_buffer())){
+		return;
+	}
+	if(buffer->depth < TRACE_MAX_DEPTH){
+		span = &buffer->stack[buffer->depth];
+		span->category = category;
+		span->name = name;
+		span->file = file ? make_path(file, NULL, NULL) : NULL;
+		span->task = task;
+		span->start = trace_time();
+	}
+	buffer->depth++;
+}
+
+/*
+* trace_end
+* ---------
+* this function ends the latest span of the calling thread and records it in the ring of the thread
+* the oldest event is overwritten once the ring is full
+*
+*/
+void trace_end(void){
+	TraceBuffer *buffer;
+	TraceEvent *event;
+	OpenSpan *span;
+
+	if(!tracing || !(buffer = thread_buffer()) || buffer->depth == 0){
+		return;
+	}
+	if(--buffer->depth >= TRACE_MAX_DEPTH){
+		return;
+	}
+	span = &buffer->stack[buffer->depth];
+	event = &buffer->events[buffer->recorded % TRACE_RING_EVENTS];
+	if(buffer->recorded >= TRACE_RING_EVENTS){
+		free(event->file);
+	}
+	event->category = span->category;
+	event->name = span->name;
+	event->file = span->file;
+	event->task = span->task;
+	event->start = span->start;
+	event->duration = trace_time() - span->start;
+	buffer->recorded++;
+}
+
+/*
+* trace_name_thread
+* -----------------
+* this function names the calling thread in the trace
+*
+* parameters:
+*   format: a printf format with at most one %d
+*   number: the number the format prints
+*
+*/
+void trace_name_thread(const char *format, int number){
+	TraceBuffer *buffer;
+	char name[TRACE_THREAD_NAME_LENGTH + 16];
+
+	if(!tracing || !(buffer = thread_buffer())){
+		return;
+	}
+	sprintf(name, format, number);
+	strncpy(buffer->thread_name, name, TRACE_THREAD_NAME_LENGTH - 1);
+	buffer->thread_name[TRACE_THREAD_NAME_LENGTH - 1] = '\0';
+}
+
+/*** OUTPUT SECTION ***/
+
+/*
+* write_trace_event
+* -----------------
+* this function writes a recorded span as a complete event
+*
+* parameters:
+*   file: the trace file
+*   buffer: the buffer of the thread that recorded the span
+*   event: the span
+*
+*/
+void write_trace_event(FILE *file, const TraceBuffer *buffer, const TraceEvent *event){
+	fputs(",\n{\"name\":", file);
+	if(event->file){
+		json_write_string(file, event->file, strlen(event->file));
+	}
+	else{
+		fprintf(file, "\"%s\"", event->name);
+	}
+	fprintf(file, ",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%d",
+		event->category, event->start, event->duration, buffer->thread);
+	if(event->task >= 0){
+		fprintf(file, ",\"args\":{\"task\":%d}", event->task);
+	}
+	fputc('}', file);
+}
+
+/*
+* stop_trace
+* ----------
+* this function writes the spans of every thread to a trace file and stops recording
+* it must be called once every thread that recorded has exited or stopped recording
+* the file is a JSON object with a traceEvents array (thread names first) and the number of dropped events
+*
+* parameters:
+*   path: the trace file
+*
+* returns:
+*   bool: true if the trace file was written false otherwise
+*/
+bool stop_trace(const char *path){
+	TraceBuffer *buffer, *next;
+	unsigned long i, first, dropped = 0;
+	FILE *file;
+	bool success;
+
+	if(!tracing){
+		return false;
+	}
+	tracing = false;
+	file = fopen(path, "w");
+	if(!file){
+		fprintf(stderr, "Error: can't write the trace to %s: %s\n", path, strerror(errno));
+	}
+	else{
+		fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"assembler\"}}", file);
+		for(buffer=trace_buffers ; buffer ; buffer=buffer->next){
+			fprintf(file, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":", buffer->thread);
+			json_write_string(file, buffer->thread_name, strlen(buffer->thread_name));
+			fputs("}}", file);
+			fprintf(file, ",\n{\"name\":\"thread_sort_index\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"sort_index\":%d}}", buffer->thread, buffer->thread);
+		}
+		for(buffer=trace_buffers ; buffer ; buffer=buffer->next){
+			first = buffer->recorded > TRACE_RING_EVENTS ? buffer->recorded - TRACE_RING_EVENTS : 0;
+			dropped += first;
+			for(i=first ; i<buffer->recorded ; i++){
+				write_trace_event(file, buffer, &buffer->events[i % TRACE_RING_EVENTS]);
+			}
+		}
+		fprintf(file, "\n],\"otherData\":{\"dropped_events\":%lu}}\n", dropped);
+	}
+	success = file && !ferror(file);
+	if(file && fclose(file) != 0){
+		success = false;
+	}
+	if(file && !success){
+		fprintf(stderr, "Error: failed writing the trace to %s\n", path);
+	}
+
+	for(buffer=trace_buffers ; buffer ; buffer=next){
+		next = buffer->next;
+		for(i=0 ; i<buffer->recorded && i<TRACE_RING_EVENTS ; i++){
+			free(buffer->events[i].file);
+		}
+		while(buffer->depth > 0){
+			if(--buffer->depth < TRACE_MAX_DEPTH){
+				free(buffer->stack[buffer->depth].file);
+			}
+		}
+		free(buffer->events);
+		free(buffer);
+	}
+	trace_buffers = NULL;
+	pthread_setspecific(trace_key, NULL);
+	return success;
+}
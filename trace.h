@@ -0,0 +1,78 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include "definitions.h"
+
+#define TRACE_RING_EVENTS (1 << 16)/*events every thread keeps before it overwrites its oldest ones*/
+#define TRACE_MAX_DEPTH 16/*deepest nesting of spans*/
+#define TRACE_THREAD_NAME_LENGTH 32/*longest thread name in the trace*/
+
+/*
+* trace
+* -----
+* --trace FILE records a timeline of the run in the Chrome trace event format that Perfetto and chrome://tracing load
+* every span is a complete ("X") event: a file, a phase of a file, an I/O wait, a task of the work pool or a wait for a task
+* every thread records into its own ring buffer without locks and the buffers are only read once the run is over
+* so a thread that records more than TRACE_RING_EVENTS events keeps its latest ones and the trace counts the dropped ones
+* the TRACE_ macros are compiled out with the STATS_ macros when building with NO_STATS (make STATS=0)
+*/
+
+/*** STRUCTURE DEFINITIONS SECTION ***/
+
+typedef struct{/*a span that ended*/
+	const char *category;/*category of the span ("file" "phase" "io" or "pool")*/
+	const char *name;/*static name of the span*/
+	char *file;/*copy of the file the span belongs to (its name in the trace) or NULL*/
+	int task;/*number of the task of the work pool or -1*/
+	double start;/*start in microseconds since the trace started*/
+	double duration;/*duration in microseconds*/
+}TraceEvent;
+
+typedef struct{/*a span that began and did not end yet*/
+	const char *category;/*category of the span*/
+	const char *name;/*static name of the span*/
+	char *file;/*copy of the file or NULL*/
+	int task;/*number of the task or -1*/
+	double start;/*start in microseconds since the trace started*/
+}OpenSpan;
+
+typedef struct trace_buffer{/*the events of a single thread*/
+	TraceEvent *events;/*ring of TRACE_RING_EVENTS events*/
+	unsigned long recorded;/*number of events ever recorded (the ring holds the latest ones)*/
+	int thread;/*number of the thread in the trace*/
+	char thread_name[TRACE_THREAD_NAME_LENGTH];/*name of the thread in the trace*/
+	OpenSpan stack[TRACE_MAX_DEPTH];/*the spans that began and did not end*/
+	int depth;/*number of spans that began and did not end*/
+	struct trace_buffer *next;/*the buffer of the thread that started tracing before*/
+}TraceBuffer;
+
+/*** INSTRUMENTATION SECTION ***/
+
+#ifdef NO_STATS
+#define TRACE_BEGIN(category,name)
+#define TRACE_FILE(file)
+#define TRACE_TASK(name,task)
+#define TRACE_END()
+#define TRACE_THREAD(format,number)
+#else
+#define TRACE_BEGIN(category,name) trace_begin(category, name, NULL, -1)/*begin a span with a static name*/
+#define TRACE_FILE(file) trace_begin("file", "file", file, -1)/*begin the span of a file named after it*/
+#define TRACE_TASK(name,task) trace_begin("pool", name, NULL, task)/*begin a span of a task of the work pool*/
+#define TRACE_END() trace_end()/*end the latest span of the calling thread*/
+#define TRACE_THREAD(format,number) trace_name_thread(format, number)/*name the calling thread in the trace*/
+#endif
+
+/*** FUNCTION PROTOTYPES SECTION ***/
+
+bool start_trace(void);/*function to start recording the spans of every thread*/
+bool stop_trace(const char *path);/*function to write the recorded spans to a file and stop recording*/
+void trace_begin(const char *category,const char *name,const char *file,int task);/*function to begin a span on the calling thread*/
+void trace_end(void);/*function to end the latest span of the calling thread*/
+void trace_name_thread(const char *format,int number);/*function to name the calling thread in the trace*/
+
+#endif /*TRACE_H*/
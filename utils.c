@@ -1,4 +1,6 @@
 #include "utils.h"
+#include <stdio.h>
+#include <stdlib.h>
 
 /* 
 * is_alpha
@@ -175,3 +177,98 @@ opcode get_opcode(const char *operation){
     if (strcmp(operation, "stop") == 0) return STOP_OP;
     return NONE_OP;
 }
+
+/*
+* make_path
+* ---------
+* this function joins up to three parts of a path into a new string
+*
+* parameters:
+*   first: the first part
+*   second: the second part or NULL
+*   third: the third part or NULL
+*
+* returns:
+*   char*: the joined path (freed by the caller) or NULL if memory allocation failed
+*/
+char *make_path(const char *first, const char *second, const char *third){
+	size_t length = strlen(first) + (second ? strlen(second) : 0) + (third ? strlen(third) : 0) + 1;
+	char *path = (char*)malloc(length);
+
+	if(path){
+		sprintf(path, "%s%s%s", first, second ? second : "", third ? third : "");
+	}
+	return path;
+}
+
+/*
+* json_write_string
+* -----------------
+* this function writes text as a JSON string
+*
+* parameters:
+*   file: the stream to write to
+*   text: the text
+*   length: the length of the text
+*
+*/
+void json_write_string(FILE *file, const char *text, size_t length){
+	size_t i;
+
+	fputc('"', file);
+	for(i=0 ; i<length ; i++){
+		if(text[i] == '"' || text[i] == '\\'){
+			fprintf(file, "\\%c", text[i]);
+		}
+		else if(text[i] == '\n'){
+			fputs("\\n", file);
+		}
+		else if((unsigned char)text[i] < 0x20){
+			fprintf(file, "\\u%04x", (unsigned char)text[i]);
+		}
+		else{
+			fputc(text[i], file);
+		}
+	}
+	fputc('"', file);
+}
+
+/*
+* hash_label
+* ----------
+* this function hashes the name of a label or a macro for the tables that look names up
+*
+* parameters:
+*   name: the name
+*
+* returns:
+*   unsigned long: the hash of the name
+*/
+unsigned long hash_label(const char *name){
+	unsigned long hash = 5381;
+
+	while(*name){
+		hash = hash * 33 + (unsigned char)*name++;
+	}
+	return hash;
+}
+
+/*
+* open_buffer
+* -----------
+* this function opens a stream that reads a buffer held in memory
+* fmemopen may reject an empty buffer so an empty source is read from a stream over a buffer of its own that holds nothing yet
+*
+* parameters:
+*   buffer: the buffer which must stay valid until the stream is closed
+*   size: the length of the buffer
+*
+* returns:
+*   FILE*: the stream or NULL if it could not be opened
+*/
+FILE *open_buffer(const char *buffer, size_t size){
+	if(size == 0){/*w+ starts the stream empty and a null buffer is allocated and freed by the stream*/
+		return fmemopen(NULL, 1, "w+");
+	}
+	return fmemopen((void*)buffer, size, "r");
+}
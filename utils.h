@@ -2,6 +2,7 @@
 #define UTILS_H
 
 #include "definitions.h"
+#include <stdio.h>
 #include <string.h>
 
 /*** UTILITY FUNCTIONS SECTION ***/
@@ -12,6 +13,10 @@ bool is_digit(char c);/*check if a character is a digit*/
 bool is_valid_operand(const char *operand);/*check if an operand is valid*/
 addressing_type get_addressing_type(char *operand);/*get the addressing type for an operand*/
 opcode get_opcode(const char *operation);/*get the opcode corresponding to an operation*/
+char *make_path(const char *first,const char *second,const char *third);/*join up to three parts of a path into a new string*/
+void json_write_string(FILE *file,const char *text,size_t length);/*write text as a JSON string*/
+unsigned long hash_label(const char *name);/*hash the name of a label or a macro*/
+FILE *open_buffer(const char *buffer,size_t size);/*open a stream that reads a buffer held in memory*/
 
 
 #endif /* UTILS_H */
@@ -0,0 +1,284 @@
+#include "watch.h"
+#include "libassembler.h"
+#include "diagnostics.h"
+#include <errno.h>
+#include <poll.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/inotify.h>
+
+/*** WATCHED FILES SECTION ***/
+
+/*
+* elapsed_milliseconds
+* --------------------
+* this function measures the time since a starting point of the monotonic clock
+*
+* parameters:
+*   start: the starting point
+*
+* returns:
+*   double: the elapsed time in milliseconds
+*/
+double elapsed_milliseconds(const struct timespec *start){
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (now.tv_sec - start->tv_sec) * 1000.0 + (now.tv_nsec - start->tv_nsec) / 1000000.0;
+}
+
+/*
+* add_watched_file
+* ----------------
+* this function watches the directory that holds the source of a file argument
+* the directory is watched instead of the file because editors often save by writing a new file and renaming it over the old one
+* inotify returns the same watch for every file of a directory
+*
+* parameters:
+*   inotify_fd: the inotify instance
+*   file: the WatchedFile to fill
+*   basename: the file argument
+*   output: the base name of the output files
+*
+* returns:
+*   bool: true if the directory is watched false otherwise
+*/
+bool add_watched_file(int inotify_fd, WatchedFile *file, const char *basename, const char *output){
+	const char *slash = strrchr(basename, '/');
+	char *directory;
+
+	file->basename = basename;
+	file->output = output;
+	file->changed = true;/*every file is assembled once at the start*/
+	file->assembled = false;
+	file->key[0] = '\0';
+	file->source_name = (char*)malloc(strlen(slash ? slash + 1 : basename) + 4);
+	directory = (char*)malloc(slash ? (size_t)(slash - basename) + 2 : 2);
+	if(!file->source_name || !directory){
+		free(file->source_name);
+		free(directory);
+		file->source_name = NULL;
+		return false;
+	}
+	sprintf(file->source_name, "%s.as", slash ? slash + 1 : basename);
+	if(slash){
+		memcpy(directory, basename, slash - basename + (slash == basename));/*keep the slash of the root directory*/
+		directory[slash - basename + (slash == basename)] = '\0';
+	}
+	else{
+		strcpy(directory, ".");
+	}
+	file->watch = inotify_add_watch(inotify_fd, directory, IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+	if(file->watch < 0){
+		fprintf(stderr, "Error: can't watch directory %s: %s\n", directory, strerror(errno));
+	}
+	free(directory);
+	return file->watch >= 0;
+}
+
+/*
+* rebuild_file
+* ------------
+* this function assembles a file argument again after its source changed
+* the source is preprocessed and hashed first so a save that did not change the preprocessed source
+* (a touch or an edit of a comment) does not run the passes or rewrite the outputs
+*
+* parameters:
+*   file: the WatchedFile to assemble
+*   options: the command line options
+*
+* returns:
+*   bool: true if the passes ran (or the file failed) false if the source was unchanged
+*/
+bool rebuild_file(WatchedFile *file, const AssemblerOptions *options){
+	char key[CACHE_KEY_LENGTH + 1];
+	char *input_filename, *preprocessed;
+	size_t preprocessed_size;
+	ObjectSink sink;
+	LineMap map;/*source lines for the error messages and the .map file*/
+	FILE *source;
+	bool success;
+
+	file->changed = false;
+	input_filename = (char*)malloc(strlen(file->basename) + 4);
+	if(!input_filename){
+		return false;
+	}
+	sprintf(input_filename, "%s.as", file->basename);
+	source = fopen(input_filename, "r");
+	free(input_filename);
+	if(!source){
+		fprintf(error_output(), "Warning: file %s.as does not exist skipping it\n", file->basename);
+		file->assembled = false;
+		return true;
+	}
+	initialize_line_map(&map, options->write_map);
+	preprocessed = preprocess_source(file->basename, source, &preprocessed_size, &map);
+	fclose(source);
+	if(!preprocessed){
+		free_line_map(&map);
+		file->assembled = false;
+		return true;
+	}
+
+	cache_key(file->basename, preprocessed, preprocessed_size, options->write_map ? &map : NULL, options, key);
+	if(file->assembled && strcmp(key, file->key) == 0){/*the outputs are already up to date*/
+		free_line_map(&map);
+		free(preprocessed);
+		return false;
+	}
+	if(options->cache_directory){
+		success = process_preprocessed_cached(file->basename, file->output, preprocessed, preprocessed_size, &map, key, options);
+	}
+	else{
+		initialize_object_sink(&sink, file->output, false);
+		sink.line_map = &map;
+		success = process_preprocessed(file->basename, preprocessed, preprocessed_size, &sink, options);
+	}
+	free_line_map(&map);
+	free(preprocessed);
+	file->assembled = success;/*a file that failed is assembled again on its next save*/
+	if(success){
+		strcpy(file->key, key);
+	}
+	return true;
+}
+
+/*
+* read_events
+* -----------
+* this function reads the pending inotify events and marks the files whose source was written
+*
+* parameters:
+*   inotify_fd: the inotify instance
+*   files: the watched files
+*   file_count: the number of watched files
+*
+* returns:
+*   bool: true if the events were read false if inotify failed
+*/
+bool read_events(int inotify_fd, WatchedFile *files, int file_count){
+	union{/*inotify events are aligned like struct inotify_event*/
+		struct inotify_event align;
+		char bytes[WATCH_EVENT_BUFFER];
+	}buffer;
+	struct inotify_event *event;
+	ssize_t length;
+	char *position;
+	int i;
+
+	length = read(inotify_fd, buffer.bytes, sizeof(buffer.bytes));
+	if(length < 0){
+		return errno == EINTR || errno == EAGAIN;
+	}
+	for(position = buffer.bytes ; position < buffer.bytes + length ; position += sizeof(struct inotify_event) + event->len){
+		event = (struct inotify_event*)position;
+		if(event->mask & IN_Q_OVERFLOW){/*events were dropped so any file may have changed*/
+			for(i=0 ; i<file_count ; i++){
+				files[i].changed = true;/*the unchanged ones are skipped by their key*/
+			}
+			continue;
+		}
+		if(event->len == 0){
+			continue;
+		}
+		for(i=0 ; i<file_count ; i++){
+			if(files[i].watch == event->wd && strcmp(files[i].source_name, event->name) == 0){
+				files[i].changed = true;
+			}
+		}
+	}
+	return true;
+}
+
+/*
+* free_watched_files
+* ------------------
+* this function frees the watched files and closes the inotify instance
+*
+* parameters:
+*   inotify_fd: the inotify instance
+*   files: the watched files
+*   file_count: the number of watched files
+*
+*/
+void free_watched_files(int inotify_fd, WatchedFile *files, int file_count){
+	int i;
+
+	for(i=0 ; i<file_count ; i++){
+		free(files[i].source_name);
+	}
+	free(files);
+	close(inotify_fd);/*removes every watch*/
+}
+
+/*
+* watch_files
+* -----------
+* this function assembles the file arguments and then stays resident reassembling every file whose source is saved
+* the events of a burst of saves are collected until WATCH_QUIET_TIME milliseconds pass without a new one
+* so an editor that writes a file in several steps triggers a single rebuild
+* the process runs until it is interrupted
+*
+* parameters:
+*   files: the file arguments (base names without the .as suffix)
+*   outputs: the base names of the output files of every file argument
+*   file_count: the number of file arguments
+*   options: the command line options
+*
+* returns:
+*   int: 1 if the files couldn't be watched (otherwise it does not return)
+*/
+int watch_files(char *files[], char *outputs[], int file_count, const AssemblerOptions *options){
+	WatchedFile *watched;
+	struct pollfd waiting;
+	struct timespec start;
+	int inotify_fd, i, rebuilt;
+
+	inotify_fd = inotify_init();
+	watched = (WatchedFile*)calloc(file_count, sizeof(WatchedFile));
+	if(inotify_fd < 0 || !watched){
+		perror("Error: can't start watching the files");
+		free(watched);
+		if(inotify_fd >= 0){
+			close(inotify_fd);
+		}
+		return 1;
+	}
+	for(i=0 ; i<file_count ; i++){
+		if(!add_watched_file(inotify_fd, &watched[i], files[i], outputs[i])){
+			free_watched_files(inotify_fd, watched, file_count);/*the entries not reached yet are still zeroed*/
+			return 1;
+		}
+	}
+
+	waiting.fd = inotify_fd;
+	waiting.events = POLLIN;
+	for(;;){
+		clock_gettime(CLOCK_MONOTONIC, &start);
+		for(i=0, rebuilt=0 ; i<file_count ; i++){/*assemble the files that changed*/
+			if(watched[i].changed){
+				rebuilt += rebuild_file(&watched[i], options);
+			}
+		}
+		if(rebuilt > 0){
+			fprintf(stderr, "watch: assembled %d file%s in %.1f ms\n", rebuilt, rebuilt == 1 ? "" : "s", elapsed_milliseconds(&start));
+		}
+		fflush(stdout);
+
+		/*wait for a save then keep collecting events until the burst is over*/
+		if(poll(&waiting, 1, -1) < 0 && errno != EINTR){
+			perror("Error: waiting for changes failed");
+			free_watched_files(inotify_fd, watched, file_count);
+			return 1;
+		}
+		do{
+			if(!read_events(inotify_fd, watched, file_count)){
+				perror("Error: reading the changes failed");
+				free_watched_files(inotify_fd, watched, file_count);
+				return 1;
+			}
+		}while(poll(&waiting, 1, WATCH_QUIET_TIME) > 0);
+	}
+	return 0;
+}
@@ -0,0 +1,32 @@
+#ifndef WATCH_H
+#define WATCH_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "definitions.h"
+#include "options.h"
+#include "cache.h"
+
+#define WATCH_QUIET_TIME 40/*milliseconds without events that end a burst of saves*/
+#define WATCH_EVENT_BUFFER 8192/*bytes of inotify events read at a time*/
+
+/*** STRUCTURE DEFINITIONS SECTION ***/
+
+typedef struct{/*a file argument kept up to date by --watch*/
+	const char *basename;/*the file argument (base name without the .as suffix)*/
+	const char *output;/*base name of the output files*/
+	char *source_name;/*name of the .as file inside its directory*/
+	int watch;/*inotify watch of the directory that holds the source*/
+	bool changed;/*true when the source changed since it was last assembled*/
+	bool assembled;/*true once key holds the key of the last assembled source*/
+	char key[CACHE_KEY_LENGTH + 1];/*key of the preprocessed source that was last assembled*/
+}WatchedFile;
+
+/*** FUNCTION PROTOTYPES SECTION ***/
+
+double elapsed_milliseconds(const struct timespec *start);/*function to measure the time since a point of the monotonic clock*/
+int watch_files(char *files[],char *outputs[],int file_count,const AssemblerOptions *options);/*function to assemble the files and reassemble them whenever they change*/
+
+#endif /*WATCH_H*/
@@ -0,0 +1,256 @@
+#include "work_pool.h"
+#include "trace.h"
+
+/*** SCHEDULING SECTION ***/
+
+typedef struct{/*a task together with its cost while the tasks are sorted*/
+	long cost;/*estimated cost of the task*/
+	int task;/*number of the task*/
+}CostedTask;
+
+/* 
+* compare_costs
+* -------------
+* this function orders tasks from the most to the least expensive for qsort
+* tasks of equal cost keep their original order so the schedule is the same on every run
+* 
+* parameters:
+*   first: the first CostedTask
+*   second: the second CostedTask
+* 
+* returns:
+*   int: a negative value if first runs before second and a positive value otherwise
+*/
+int compare_costs(const void *first,const void *second){
+	const CostedTask *a = (const CostedTask*)first;
+	const CostedTask *b = (const CostedTask*)second;
+
+	if(a->cost != b->cost){
+		return a->cost > b->cost ? -1 : 1;
+	}
+	return a->task - b->task;
+}
+
+/* 
+* take_from_queue
+* ---------------
+* this function takes the most expensive task left in a queue
+* 
+* parameters:
+*   queue: the queue to take from
+* 
+* returns:
+*   int: the number of the task or -1 if the queue is empty
+*/
+int take_from_queue(WorkQueue *queue){
+	int task = -1;
+
+	pthread_mutex_lock(&queue->lock);
+	if(queue->head < queue->tail){
+		task = queue->tasks[queue->head++];
+	}
+	pthread_mutex_unlock(&queue->lock);
+	return task;
+}
+
+/* 
+* take_task
+* ---------
+* this function picks the next task of a worker
+* a worker first empties its own queue and then steals the most expensive task left in the other queues
+* starting from its neighbour so idle workers spread over the busy ones
+* 
+* parameters:
+*   pool: the pool
+*   worker: the number of the worker
+* 
+* returns:
+*   int: the number of the task or -1 when every queue is empty
+*/
+int take_task(WorkPool *pool,int worker){
+	int i;
+	int task = take_from_queue(&pool->queues[worker]);/*try the own queue first*/
+
+	for(i=1 ; task < 0 && i<pool->worker_count ; i++){/*steal from the other queues*/
+		task = take_from_queue(&pool->queues[(worker + i) % pool->worker_count]);
+	}
+	return task;
+}
+
+/* 
+* run_worker
+* ----------
+* this function is the body of every worker thread
+* it runs tasks until there is nothing left to take or steal
+* 
+* parameters:
+*   argument: the WorkerSlot of the worker
+* 
+* returns:
+*   void*: always NULL
+*/
+void *run_worker(void *argument){
+	WorkerSlot *slot = (WorkerSlot*)argument;
+	WorkPool *pool = slot->pool;
+	int task;
+
+	TRACE_THREAD("worker %d", slot->worker);
+	while((task = take_task(pool, slot->worker)) >= 0){
+		TRACE_TASK("task", task);
+		pool->run(task, pool->context);/*run the task*/
+		TRACE_END();
+
+		pthread_mutex_lock(&pool->finished_lock);/*announce the completion*/
+		pool->finished[task] = true;
+		pthread_cond_broadcast(&pool->finished_changed);
+		pthread_mutex_unlock(&pool->finished_lock);
+	}
+	return NULL;
+}
+
+/*** WORK POOL SECTION ***/
+
+/* 
+* work_pool_start
+* ---------------
+* this function starts running a fixed set of tasks on worker threads
+* the tasks are sorted from the most to the least expensive and dealt to the workers in turn
+* so the expensive tasks start first and the cheap ones fill the gaps at the end
+* 
+* parameters:
+*   pool: the pool to start
+*   worker_count: the number of worker threads
+*   task_count: the number of tasks
+*   costs: the estimated cost of every task
+*   run: the function that runs a task
+*   context: the context passed to every call of run
+* 
+* returns:
+*   bool: true if at least one worker started false if the tasks have to be run without the pool
+*/
+bool work_pool_start(WorkPool *pool,int worker_count,int task_count,const long *costs,work_function run,void *context){
+	CostedTask *sorted;
+	int i;
+
+	if(worker_count > task_count){/*a worker without any task is useless*/
+		worker_count = task_count;
+	}
+	if(worker_count < 1){
+		return false;
+	}
+
+	pool->run = run;
+	pool->context = context;
+	pool->task_count = task_count;
+	pool->worker_count = worker_count;
+	pool->started = 0;
+	pool->queues = (WorkQueue*)malloc(worker_count*sizeof(WorkQueue));
+	pool->slots = (WorkerSlot*)malloc(worker_count*sizeof(WorkerSlot));
+	pool->threads = (pthread_t*)malloc(worker_count*sizeof(pthread_t));
+	pool->finished = (bool*)calloc(task_count, sizeof(bool));
+	sorted = (CostedTask*)malloc(task_count*sizeof(CostedTask));
+	if(!pool->queues || !pool->slots || !pool->threads || !pool->finished || !sorted){
+		free(pool->queues);
+		free(pool->slots);
+		free(pool->threads);
+		free(pool->finished);
+		free(sorted);
+		return false;
+	}
+
+	for(i=0 ; i<task_count ; i++){/*sort the tasks from the most expensive*/
+		sorted[i].cost = costs[i];
+		sorted[i].task = i;
+	}
+	qsort(sorted, task_count, sizeof(CostedTask), compare_costs);
+
+	for(i=0 ; i<worker_count ; i++){/*prepare the queues*/
+		pool->queues[i].tasks = (int*)malloc((task_count / worker_count + 1)*sizeof(int));
+		pool->queues[i].head = 0;
+		pool->queues[i].tail = 0;
+		pool->slots[i].pool = pool;
+		pool->slots[i].worker = i;
+		if(pool->queues[i].tasks == NULL){/*the tasks are run without the pool*/
+			while(i-- > 0){
+				pthread_mutex_destroy(&pool->queues[i].lock);
+				free(pool->queues[i].tasks);
+			}
+			free(pool->queues);
+			free(pool->slots);
+			free(pool->threads);
+			free(pool->finished);
+			free(sorted);
+			return false;
+		}
+		pthread_mutex_init(&pool->queues[i].lock, NULL);
+	}
+	for(i=0 ; i<task_count ; i++){/*deal the sorted tasks in turn*/
+		WorkQueue *queue = &pool->queues[i % worker_count];
+		queue->tasks[queue->tail++] = sorted[i].task;
+	}
+	free(sorted);
+
+	pthread_mutex_init(&pool->finished_lock, NULL);
+	pthread_cond_init(&pool->finished_changed, NULL);
+
+	for(i=0 ; i<worker_count ; i++){/*start the workers*/
+		if(pthread_create(&pool->threads[pool->started], NULL, run_worker, &pool->slots[i]) != 0){
+			break;/*the started workers steal the tasks of the missing ones*/
+		}
+		pool->started++;
+	}
+	if(pool->started == 0){
+		work_pool_join(pool);
+		return false;
+	}
+	return true;
+}
+
+/* 
+* work_pool_wait
+* --------------
+* this function waits until a task completed
+* 
+* parameters:
+*   pool: the pool running the task
+*   task: the number of the task
+* 
+*/
+void work_pool_wait(WorkPool *pool,int task){
+	pthread_mutex_lock(&pool->finished_lock);
+	if(!pool->finished[task]){/*only a wait that blocks is a span of the trace*/
+		TRACE_TASK("wait", task);
+		while(!pool->finished[task]){
+			pthread_cond_wait(&pool->finished_changed, &pool->finished_lock);
+		}
+		TRACE_END();
+	}
+	pthread_mutex_unlock(&pool->finished_lock);
+}
+
+/* 
+* work_pool_join
+* --------------
+* this function waits for every worker to finish and frees everything the pool holds
+* 
+* parameters:
+*   pool: the pool to join
+* 
+*/
+void work_pool_join(WorkPool *pool){
+	int i;
+
+	for(i=0 ; i<pool->started ; i++){
+		pthread_join(pool->threads[i], NULL);
+	}
+	for(i=0 ; i<pool->worker_count ; i++){
+		pthread_mutex_destroy(&pool->queues[i].lock);
+		free(pool->queues[i].tasks);
+	}
+	pthread_mutex_destroy(&pool->finished_lock);
+	pthread_cond_destroy(&pool->finished_changed);
+	free(pool->queues);
+	free(pool->slots);
+	free(pool->threads);
+	free(pool->finished);
+}
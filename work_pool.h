@@ -0,0 +1,45 @@
+#ifndef WORK_POOL_H
+#define WORK_POOL_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include "definitions.h"
+
+/*** STRUCTURE DEFINITIONS SECTION ***/
+
+typedef void (*work_function)(int task,void *context);/*function a worker calls to run a single task*/
+
+typedef struct{/*the tasks dealt to a single worker ordered from the most to the least expensive*/
+	int *tasks;/*task numbers*/
+	int head;/*index of the next task to take*/
+	int tail;/*number of tasks dealt to the worker*/
+	pthread_mutex_t lock;/*protects head against the owner and thieves*/
+}WorkQueue;
+
+typedef struct{/*what a worker thread needs to find its queue*/
+	struct work_pool *pool;/*the pool the worker belongs to*/
+	int worker;/*number of the worker and of its queue*/
+}WorkerSlot;
+
+typedef struct work_pool{/*a fixed set of tasks run by a fixed set of threads that steal from each other*/
+	work_function run;/*function that runs a task*/
+	void *context;/*context passed to every call of run*/
+	int task_count;/*number of tasks*/
+	int worker_count;/*number of queues (and of workers that were asked for)*/
+	int started;/*number of threads that were actually started*/
+	WorkQueue *queues;/*one queue per worker*/
+	WorkerSlot *slots;/*one slot per worker*/
+	pthread_t *threads;/*the started threads*/
+	bool *finished;/*true for every task that completed*/
+	pthread_mutex_t finished_lock;/*protects finished*/
+	pthread_cond_t finished_changed;/*signaled whenever a task completes*/
+}WorkPool;
+
+/*** FUNCTION PROTOTYPES SECTION ***/
+
+bool work_pool_start(WorkPool *pool,int worker_count,int task_count,const long *costs,work_function run,void *context);/*function to start running the tasks from the most expensive one*/
+void work_pool_wait(WorkPool *pool,int task);/*function to wait until a task completed*/
+void work_pool_join(WorkPool *pool);/*function to wait for every task and release the pool*/
+
+#endif /*WORK_POOL_H*/